@@ -0,0 +1,194 @@
+######################################################################
+#  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+#  All rights reserved.
+#  
+#  This library is free software; you can redistribute it and/or
+#  modify it under the terms of the GNU Lesser General Public
+#  License as published by the Free Software Foundation; either
+#  version 2.1 of the License, or (at your option) any later version.
+#  
+#  This library is distributed in the hope that it will be useful,
+#  but WITHOUT ANY WARRANTY; without even the implied warranty of
+#  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+#  Lesser General Public License for more details.
+#  
+#  You should have received a copy of the GNU Lesser General Public
+#  License along with this library; if not, write to the Free Software
+#  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+######################################################################
+
+# Long lived ruby process used by the RunManager ruby worker pool, see
+# runmanager/lib/RubyWorkerPool.hpp.
+#
+# usage: ruby [-I dir]... rubyworker.rb [library to preload]...
+#
+# Requests are read from stdin, one per line, as tab separated fields in which
+# '%', tab, carriage return and newline are percent encoded:
+#
+#   run <id> <working dir> <stdout file> <stderr file> <include dirs> <script> [arg]...
+#   kill <id>
+#   quit
+#
+# The include dirs field holds newline separated directories, relative to the
+# working dir, that are added to the load path for that script only.
+#
+# Replies are written to the original stdout:
+#
+#   OSRUBYWORKER ready <pid> <fork|inprocess>
+#   OSRUBYWORKER done <id> <exit code> <resident set size in kB, 0 if unknown>
+#
+# Where fork is available each script runs in a forked child of the worker,
+# so the preloaded libraries are shared and nothing a script does survives it.
+# Otherwise scripts run inside the worker itself, wrapped in an anonymous
+# module, and the pool relies on recycling the worker to contain leaks.
+
+$control = STDOUT.dup
+$control.sync = true
+
+def decode(field)
+  field.gsub(/%([0-9A-Fa-f]{2})/) { $1.hex.chr }
+end
+
+def reply(*fields)
+  $control.write("OSRUBYWORKER " + fields.join(" ") + "\n")
+end
+
+def resident_kb
+  # second field of statm is the resident set size in pages
+  File.open("/proc/self/statm") { |f| f.read.split[1].to_i * 4 }
+rescue Exception
+  0
+end
+
+def can_fork?
+  return false if RUBY_PLATFORM =~ /mswin|mingw|cygwin/
+  Process.respond_to?(:fork)
+end
+
+# io.reopen duplicates the descriptor, so the file itself can be closed again
+def redirect(io, path, mode)
+  File.open(path, mode) { |f| io.reopen(f) }
+end
+
+def run_script(dir, includes, script, args, wrap)
+  Dir.chdir(dir)
+  $LOAD_PATH.unshift(*includes.map { |d| File.expand_path(d, dir) })
+  $0 = script
+  ARGV.replace(args)
+  load(script, wrap)
+end
+
+def run_forked(id, dir, out, err, includes, script, args)
+  pid = fork do
+    # own process group, so that kill also reaches anything the script starts
+    begin
+      Process.setpgid(0, 0)
+    rescue Exception
+    end
+    $control.close
+    redirect(STDIN, File.exist?("/dev/null") ? "/dev/null" : "NUL", "r")
+    redirect(STDOUT, out, "w")
+    redirect(STDERR, err, "w")
+    STDOUT.sync = true
+    STDERR.sync = true
+    run_script(dir, includes, script, args, false)
+  end
+
+  $children[id] = pid
+
+  Thread.new do
+    Process.wait(pid)
+    $children.delete(id)
+    status = $?
+    code = status.exited? ? status.exitstatus : -1
+    reply("done", id, code, resident_kb)
+  end
+end
+
+def run_inprocess(id, dir, out, err, includes, script, args)
+  code = 0
+  saved_out = STDOUT.dup
+  saved_err = STDERR.dup
+  saved_dir = Dir.pwd
+  saved_args = ARGV.dup
+  saved_name = $0
+  saved_load_path = $LOAD_PATH.dup
+
+  begin
+    redirect(STDOUT, out, "w")
+    redirect(STDERR, err, "w")
+    run_script(dir, includes, script, args, true)
+  rescue SystemExit => e
+    code = e.status
+  rescue Exception => e
+    trace = e.backtrace || []
+    STDERR.puts "#{trace.first}: #{e.message} (#{e.class})"
+    trace[1..-1].to_a.each { |line| STDERR.puts "\tfrom #{line}" }
+    code = 1
+  ensure
+    STDOUT.flush
+    STDERR.flush
+    STDOUT.reopen(saved_out)
+    STDERR.reopen(saved_err)
+    saved_out.close
+    saved_err.close
+    Dir.chdir(saved_dir)
+    ARGV.replace(saved_args)
+    $0 = saved_name
+    $LOAD_PATH.replace(saved_load_path)
+  end
+
+  reply("done", id, code, resident_kb)
+end
+
+
+ARGV.each do |lib|
+  begin
+    require lib
+  rescue LoadError => e
+    STDERR.puts "rubyworker: unable to preload #{lib}: #{e.message}"
+  end
+end
+ARGV.clear
+
+$children = {}
+forking = can_fork?
+
+reply("ready", Process.pid, forking ? "fork" : "inprocess")
+
+while line = STDIN.gets
+  fields = line.chomp.split("\t", -1).map { |f| decode(f) }
+
+  case fields[0]
+  when "run"
+    id, dir, out, err, includes, script = fields[1..6]
+    includes = includes.to_s.split("\n")
+    args = fields[7..-1] || []
+    if forking
+      run_forked(id, dir, out, err, includes, script, args)
+    else
+      run_inprocess(id, dir, out, err, includes, script, args)
+    end
+  when "kill"
+    pid = $children[fields[1]]
+    if pid
+      begin
+        Process.kill("KILL", -pid)
+      rescue Exception
+        begin
+          Process.kill("KILL", pid)
+        rescue Exception
+        end
+      end
+    end
+  when "quit"
+    break
+  end
+end
+
+$children.values.each do |pid|
+  begin
+    Process.kill("KILL", pid)
+  rescue Exception
+  end
+end
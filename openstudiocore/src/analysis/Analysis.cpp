@@ -33,9 +33,15 @@
 #include <runmanager/lib/Job.hpp>
 
 #include <utilities/document/Table.hpp>
+#include <utilities/data/Tag.hpp>
 
 #include <boost/foreach.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
 namespace openstudio {
 namespace analysis {
 
@@ -48,7 +54,8 @@ namespace detail {
       m_problem(problem),
       m_seed(FileReference(toPath("*." + seedType.valueDescription()))),
       m_resultsAreInvalid(false),
-      m_dataPointsAreInvalid(false)
+      m_dataPointsAreInvalid(false),
+      m_nextDataPointIndex(0)
   {
     m_seed.makePathRelative();
     if (problem.inputFileType() && (seedType != problem.inputFileType())) {
@@ -67,7 +74,8 @@ namespace detail {
       m_problem(problem),
       m_seed(seed),
       m_resultsAreInvalid(false),
-      m_dataPointsAreInvalid(false)
+      m_dataPointsAreInvalid(false),
+      m_nextDataPointIndex(0)
   {
     if (problem.inputFileType() && (seed.fileType() != problem.inputFileType())) {
       LOG_AND_THROW("Unable to construct Analysis '" << name << "', because the seed file is of "
@@ -87,7 +95,8 @@ namespace detail {
       m_seed(seed),
       m_weatherFile(weatherFile),
       m_resultsAreInvalid(false),
-      m_dataPointsAreInvalid(false)
+      m_dataPointsAreInvalid(false),
+      m_nextDataPointIndex(0)
   {
     if (problem.inputFileType() && (seed.fileType() != problem.inputFileType())) {
       LOG_AND_THROW("Unable to construct Analysis '" << name << "', because the seed file is of "
@@ -110,7 +119,8 @@ namespace detail {
       m_algorithm(algorithm),
       m_seed(seed),
       m_resultsAreInvalid(false),
-      m_dataPointsAreInvalid(false)
+      m_dataPointsAreInvalid(false),
+      m_nextDataPointIndex(0)
   {
     if (!m_algorithm->isCompatibleProblemType(m_problem)) {
       LOG_AND_THROW("Unable to construct Analysis '" << name << "', because Problem '"
@@ -137,7 +147,8 @@ namespace detail {
       m_seed(seed),
       m_weatherFile(weatherFile),
       m_resultsAreInvalid(false),
-      m_dataPointsAreInvalid(false)
+      m_dataPointsAreInvalid(false),
+      m_nextDataPointIndex(0)
   {
     if (!m_algorithm->isCompatibleProblemType(m_problem)) {
       LOG_AND_THROW("Unable to construct Analysis '" << name << "', because Problem '"
@@ -175,7 +186,8 @@ namespace detail {
       m_weatherFile(weatherFile),
       m_dataPoints(dataPoints),
       m_resultsAreInvalid(resultsAreInvalid),
-      m_dataPointsAreInvalid(dataPointsAreInvalid)
+      m_dataPointsAreInvalid(dataPointsAreInvalid),
+      m_nextDataPointIndex(0)
   {
     // override default of objects not being dirty when they are de-serialized
     if (resultsAreInvalid || dataPointsAreInvalid) {
@@ -186,6 +198,7 @@ namespace detail {
       connectChild(*m_algorithm,false);
     }
     BOOST_FOREACH(DataPoint& dataPoint,m_dataPoints) {
+      indexDataPoint(dataPoint);
       connectChild(dataPoint,false);
     }
   }
@@ -195,7 +208,8 @@ namespace detail {
       m_problem(other.problem().clone().cast<Problem>()),
       m_seed(other.seed().clone()),
       m_resultsAreInvalid(other.resultsAreInvalid()),
-      m_dataPointsAreInvalid(other.dataPointsAreInvalid())
+      m_dataPointsAreInvalid(other.dataPointsAreInvalid()),
+      m_nextDataPointIndex(0)
   {
     connectChild(m_problem,false);
     if (other.algorithm()) {
@@ -208,6 +222,7 @@ namespace detail {
     BOOST_FOREACH(const DataPoint& dataPoint,other.dataPoints()) {
       m_dataPoints.push_back(dataPoint.clone().cast<DataPoint>());
       m_dataPoints.back().setProblem(m_problem);
+      indexDataPoint(m_dataPoints.back());
       connectChild(m_dataPoints.back(),false);
     }
   }
@@ -249,49 +264,48 @@ namespace detail {
   }
 
   std::vector<DataPoint> Analysis_Impl::dataPointsToQueue() const {
-    DataPointVector result;
-    BOOST_FOREACH(const DataPoint& dataPoint,m_dataPoints) {
-      if (!dataPoint.isComplete()) {
-        result.push_back(dataPoint);
-      }
-    }
-    return result;
+    return bucketDataPoints(m_incompleteDataPoints);
   }
 
   std::vector<DataPoint> Analysis_Impl::completeDataPoints() const {
-    DataPointVector result;
-    BOOST_FOREACH(const DataPoint& dataPoint,m_dataPoints) {
-      if (dataPoint.isComplete()) {
-        result.push_back(dataPoint);
-      }
-    }
-    return result;
+    // merge successful and failed in insertion order
+    DataPointBucket complete(m_successfulDataPoints);
+    complete.insert(m_failedDataPoints.begin(),m_failedDataPoints.end());
+    return bucketDataPoints(complete);
   }
 
   std::vector<DataPoint> Analysis_Impl::successfulDataPoints() const {
-    DataPointVector result;
-    BOOST_FOREACH(const DataPoint& dataPoint,m_dataPoints) {
-      if (dataPoint.isComplete() && !dataPoint.failed()) {
-        result.push_back(dataPoint);
-      }
-    }
-    return result;
+    return bucketDataPoints(m_successfulDataPoints);
   }
 
   std::vector<DataPoint> Analysis_Impl::failedDataPoints() const {
-    DataPointVector result;
-    BOOST_FOREACH(const DataPoint& dataPoint,m_dataPoints) {
-      if (dataPoint.isComplete() && dataPoint.failed()) {
-        result.push_back(dataPoint);
-      }
-    }
-    return result;
+    return bucketDataPoints(m_failedDataPoints);
   }
 
   std::vector<DataPoint> Analysis_Impl::getDataPoints(
       const std::vector<QVariant>& variableValues) const
   {
     DataPointVector result;
+
+    std::vector<std::string> keys;
+    if ((static_cast<int>(variableValues.size()) == m_problem.numVariables()) &&
+        variableValuesKeys(variableValues,keys))
+    {
+      typedef boost::unordered_multimap<std::string,unsigned>::const_iterator IndexIterator;
+      DataPointBucket matches;
+      BOOST_FOREACH(const std::string& key,keys) {
+        std::pair<IndexIterator,IndexIterator> range = m_variableValuesIndex.equal_range(key);
+        for (IndexIterator it = range.first; it != range.second; ++it) {
+          DataPointBucket::const_iterator dataPointIt = m_indexedDataPoints.find(it->second);
+          BOOST_ASSERT(dataPointIt != m_indexedDataPoints.end());
+          if (dataPointIt->second.matches(variableValues)) {
+            matches.insert(*dataPointIt);
+          }
+        }
+      }
+      return bucketDataPoints(matches);
+    }
+
     BOOST_FOREACH(const DataPoint& dataPoint, m_dataPoints) {
       if (dataPoint.matches(variableValues)) {
         result.push_back(dataPoint);
@@ -313,13 +327,11 @@ namespace detail {
   }
 
   std::vector<DataPoint> Analysis_Impl::getDataPoints(const std::string& tag) const {
-    DataPointVector result;
-    BOOST_FOREACH(const DataPoint& dataPoint,m_dataPoints) {
-      if (dataPoint.isTag(tag)) {
-        result.push_back(dataPoint);
-      }
+    std::map<std::string,DataPointBucket>::const_iterator it = m_taggedDataPoints.find(tag);
+    if (it == m_taggedDataPoints.end()) {
+      return DataPointVector();
     }
-    return result;
+    return bucketDataPoints(it->second);
   }
 
   boost::optional<DataPoint> Analysis_Impl::getDataPoint(
@@ -340,24 +352,17 @@ namespace detail {
 
   boost::optional<DataPoint> Analysis_Impl::getDataPointByUUID(const UUID& uuid) const {
     OptionalDataPoint result;
-    BOOST_FOREACH(const DataPoint& myDataPoint,dataPoints()) {
-      if (myDataPoint.uuid() == uuid) {
-        result = myDataPoint;
-        break;
-      }
+    std::map<UUID,unsigned>::const_iterator it = m_dataPointIndices.find(uuid);
+    if (it != m_dataPointIndices.end()) {
+      DataPointBucket::const_iterator dataPointIt = m_indexedDataPoints.find(it->second);
+      BOOST_ASSERT(dataPointIt != m_indexedDataPoints.end());
+      result = dataPointIt->second;
     }
     return result;
   }
 
   boost::optional<DataPoint> Analysis_Impl::getDataPointByUUID(const DataPoint& dataPoint) const {
-    OptionalDataPoint result;
-    BOOST_FOREACH(const DataPoint& myDataPoint,dataPoints()) {
-      if (dataPoint.uuidEqual(myDataPoint)) {
-        result = myDataPoint;
-        break;
-      }
-    }
-    return result;
+    return getDataPointByUUID(dataPoint.uuid());
   }
 
   bool Analysis_Impl::resultsAreInvalid() const {
@@ -461,6 +466,14 @@ namespace detail {
   }
 
   bool Analysis_Impl::addDataPoint(const DataPoint& dataPoint) {
+    if (addDataPointNoSignal(dataPoint)) {
+      onChange(AnalysisObject_Impl::Benign);
+      return true;
+    }
+    return false;
+  }
+
+  bool Analysis_Impl::addDataPointNoSignal(const DataPoint& dataPoint) {
     if (m_dataPointsAreInvalid) {
       LOG(Info,"Current data points are invalid. Call removeAllDataPoints before adding new ones.");
       return false;
@@ -477,11 +490,25 @@ namespace detail {
       return false;
     }
     m_dataPoints.push_back(dataPoint);
+    indexDataPoint(m_dataPoints.back());
     connectChild(m_dataPoints.back(),true);
-    onChange(AnalysisObject_Impl::Benign);
     return true;
   }
 
+  unsigned Analysis_Impl::addDataPoints(const std::vector<DataPoint>& dataPoints) {
+    unsigned result(0);
+    m_dataPoints.reserve(m_dataPoints.size() + dataPoints.size());
+    BOOST_FOREACH(const DataPoint& dataPoint,dataPoints) {
+      if (addDataPointNoSignal(dataPoint)) {
+        ++result;
+      }
+    }
+    if (result > 0) {
+      onChange(AnalysisObject_Impl::Benign);
+    }
+    return result;
+  }
+
   bool Analysis_Impl::addDataPoint(const std::vector<DiscretePerturbation>& perturbations) {
     OptionalDataPoint dataPoint = problem().createDataPoint(perturbations);
     if (dataPoint) {
@@ -509,6 +536,7 @@ namespace detail {
       DataPointVector::iterator it = std::find(m_dataPoints.begin(),m_dataPoints.end(),*exactDataPoint);
       BOOST_ASSERT(it != m_dataPoints.end());
       disconnectChild(*it);
+      unindexDataPoint(*it);
       m_dataPoints.erase(it);
       // TODO: It may be that the algorithm should be reset, or at least marked not-complete.
       if (m_dataPoints.empty()) {
@@ -524,8 +552,10 @@ namespace detail {
   void Analysis_Impl::removeAllDataPoints() {
     BOOST_FOREACH(DataPoint& dataPoint, m_dataPoints) {
       disconnectChild(dataPoint);
+      unindexDataPoint(dataPoint);
     }
     m_dataPoints.clear();
+    clearDataPointIndex();
     if (m_algorithm) {
       m_algorithm->reset();
     }
@@ -695,6 +725,219 @@ namespace detail {
     }
   }
 
+  void Analysis_Impl::onDataPointChanged(ChangeType changeType) {
+    AnalysisObject_Impl* impl = qobject_cast<AnalysisObject_Impl*>(sender());
+    if (!impl) {
+      return;
+    }
+    std::map<UUID,unsigned>::const_iterator it = m_dataPointIndices.find(impl->uuid());
+    if (it == m_dataPointIndices.end()) {
+      return;
+    }
+    unsigned index = it->second;
+    DataPoint dataPoint = m_indexedDataPoints.find(index)->second;
+    unbucketDataPoint(index);
+    bucketDataPoint(index,dataPoint);
+  }
+
+  // DataPoint::matches compares continuous values with equal and its default tolerance, so values
+  // a and b match if |a-b| < eps or |a-b| <= max(|a|,|b|)*eps. Continuous values are quantised to
+  // buckets of width 2^-32 below magnitude 1 and of relative width 2^-32 of the binary exponent
+  // above it. Every bucket is far wider than the tolerance, so the values matching a given value
+  // lie in at most two adjacent buckets.
+  static std::string continuousValueToken(double value) {
+    // -0 compares equal to 0 and must share its bucket
+    if (value == 0.0) {
+      value = 0.0;
+    }
+    std::stringstream ss;
+    if (std::fabs(value) < 1.0) {
+      ss << "d" << static_cast<long long>(std::floor(std::ldexp(value,32))) << ",";
+    }
+    else {
+      int exponent;
+      double mantissa = std::frexp(value,&exponent);
+      ss << "d" << exponent << "e" << static_cast<long long>(std::floor(std::ldexp(mantissa,32))) << ",";
+    }
+    return ss.str();
+  }
+
+  // token of value, with includeNeighbors also the tokens of the other buckets continuous values
+  // matching value can lie in
+  static bool variableValueTokens(const QVariant& value, bool includeNeighbors, std::vector<std::string>& tokens) {
+    tokens.clear();
+    if (value.isNull()) {
+      return false;
+    }
+    if ((value.type() == QVariant::Int) || (value.type() == QVariant::UInt)) {
+      std::stringstream ss;
+      ss << "i" << value.toInt() << ",";
+      tokens.push_back(ss.str());
+      return true;
+    }
+    double d = value.toDouble();
+    if (!(std::fabs(d) <= std::numeric_limits<double>::max())) {
+      // infinity or NaN
+      return false;
+    }
+    tokens.push_back(continuousValueToken(d));
+    if (includeNeighbors) {
+      double tol = 2.0 * std::numeric_limits<double>::epsilon() * std::max(1.0,std::fabs(d));
+      std::string lower = continuousValueToken(d - tol);
+      std::string upper = continuousValueToken(d + tol);
+      if (lower != tokens[0]) {
+        tokens.push_back(lower);
+      }
+      if (upper != tokens[0]) {
+        tokens.push_back(upper);
+      }
+    }
+    return true;
+  }
+
+  bool Analysis_Impl::variableValuesKey(const std::vector<QVariant>& variableValues,
+                                        std::string& key)
+  {
+    key.clear();
+    std::vector<std::string> tokens;
+    BOOST_FOREACH(const QVariant& value,variableValues) {
+      if (!variableValueTokens(value,false,tokens)) {
+        return false;
+      }
+      key += tokens[0];
+    }
+    return true;
+  }
+
+  bool Analysis_Impl::variableValuesKeys(const std::vector<QVariant>& variableValues,
+                                         std::vector<std::string>& keys)
+  {
+    keys.assign(1u,std::string());
+    std::vector<std::string> tokens;
+    BOOST_FOREACH(const QVariant& value,variableValues) {
+      if (!variableValueTokens(value,true,tokens)) {
+        return false;
+      }
+      std::vector<std::string> extended;
+      BOOST_FOREACH(const std::string& key,keys) {
+        BOOST_FOREACH(const std::string& token,tokens) {
+          extended.push_back(key + token);
+        }
+      }
+      keys.swap(extended);
+      // values sitting on several bucket boundaries at once, search all data points instead
+      if (keys.size() > 64u) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void Analysis_Impl::indexDataPoint(DataPoint& dataPoint) {
+    unsigned index = m_nextDataPointIndex++;
+    m_dataPointIndices[dataPoint.uuid()] = index;
+    m_indexedDataPoints.insert(DataPointBucket::value_type(index,dataPoint));
+    std::string key;
+    if (variableValuesKey(dataPoint.variableValues(),key)) {
+      m_variableValuesIndex.insert(std::make_pair(key,index));
+    }
+    bucketDataPoint(index,dataPoint);
+    bool connected = dataPoint.connect(SIGNAL(changed(ChangeType)),
+                                       this,
+                                       SLOT(onDataPointChanged(ChangeType)));
+    BOOST_ASSERT(connected);
+  }
+
+  void Analysis_Impl::unindexDataPoint(DataPoint& dataPoint) {
+    std::map<UUID,unsigned>::iterator it = m_dataPointIndices.find(dataPoint.uuid());
+    if (it == m_dataPointIndices.end()) {
+      return;
+    }
+    unsigned index = it->second;
+    dataPoint.disconnect(SIGNAL(changed(ChangeType)),this,SLOT(onDataPointChanged(ChangeType)));
+    unbucketDataPoint(index);
+    std::string key;
+    if (variableValuesKey(dataPoint.variableValues(),key)) {
+      typedef boost::unordered_multimap<std::string,unsigned>::iterator IndexIterator;
+      std::pair<IndexIterator,IndexIterator> range = m_variableValuesIndex.equal_range(key);
+      for (IndexIterator keyIt = range.first; keyIt != range.second; ++keyIt) {
+        if (keyIt->second == index) {
+          m_variableValuesIndex.erase(keyIt);
+          break;
+        }
+      }
+    }
+    m_indexedDataPoints.erase(index);
+    m_dataPointIndices.erase(it);
+  }
+
+  void Analysis_Impl::clearDataPointIndex() {
+    m_dataPointIndices.clear();
+    m_indexedDataPoints.clear();
+    m_dataPointStatuses.clear();
+    m_variableValuesIndex.clear();
+    m_incompleteDataPoints.clear();
+    m_successfulDataPoints.clear();
+    m_failedDataPoints.clear();
+    m_taggedDataPoints.clear();
+  }
+
+  void Analysis_Impl::bucketDataPoint(unsigned index, const DataPoint& dataPoint) {
+    DataPointStatus status;
+    status.complete = dataPoint.isComplete();
+    status.failed = dataPoint.failed();
+    if (!status.complete) {
+      m_incompleteDataPoints.insert(DataPointBucket::value_type(index,dataPoint));
+    }
+    else if (status.failed) {
+      m_failedDataPoints.insert(DataPointBucket::value_type(index,dataPoint));
+    }
+    else {
+      m_successfulDataPoints.insert(DataPointBucket::value_type(index,dataPoint));
+    }
+    BOOST_FOREACH(const Tag& tag,dataPoint.tags()) {
+      status.tags.push_back(tag.name());
+      m_taggedDataPoints[tag.name()].insert(DataPointBucket::value_type(index,dataPoint));
+    }
+    m_dataPointStatuses[index] = status;
+  }
+
+  void Analysis_Impl::unbucketDataPoint(unsigned index) {
+    std::map<unsigned,DataPointStatus>::iterator it = m_dataPointStatuses.find(index);
+    if (it == m_dataPointStatuses.end()) {
+      return;
+    }
+    const DataPointStatus& status = it->second;
+    if (!status.complete) {
+      m_incompleteDataPoints.erase(index);
+    }
+    else if (status.failed) {
+      m_failedDataPoints.erase(index);
+    }
+    else {
+      m_successfulDataPoints.erase(index);
+    }
+    BOOST_FOREACH(const std::string& tag,status.tags) {
+      std::map<std::string,DataPointBucket>::iterator tagIt = m_taggedDataPoints.find(tag);
+      if (tagIt != m_taggedDataPoints.end()) {
+        tagIt->second.erase(index);
+        if (tagIt->second.empty()) {
+          m_taggedDataPoints.erase(tagIt);
+        }
+      }
+    }
+    m_dataPointStatuses.erase(it);
+  }
+
+  std::vector<DataPoint> Analysis_Impl::bucketDataPoints(const DataPointBucket& bucket) {
+    DataPointVector result;
+    result.reserve(bucket.size());
+    for (DataPointBucket::const_iterator it = bucket.begin(), itEnd = bucket.end(); it != itEnd; ++it) {
+      result.push_back(it->second);
+    }
+    return result;
+  }
+
 } // detail
 
 Analysis::Analysis(const std::string& name,
@@ -889,6 +1132,10 @@ bool Analysis::addDataPoint(const std::vector<DiscretePerturbation>& perturbatio
   return getImpl<detail::Analysis_Impl>()->addDataPoint(perturbations);
 }
 
+unsigned Analysis::addDataPoints(const std::vector<DataPoint>& dataPoints) {
+  return getImpl<detail::Analysis_Impl>()->addDataPoints(dataPoints);
+}
+
 bool Analysis::setDataPointRunInformation(DataPoint& dataPoint, const runmanager::Job& topLevelJob, const std::vector<openstudio::path>& dakotaParametersFiles)
 {
   return getImpl<detail::Analysis_Impl>()->setDataPointRunInformation(dataPoint, topLevelJob, dakotaParametersFiles);
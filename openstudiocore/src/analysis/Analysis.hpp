@@ -206,6 +206,11 @@ class ANALYSIS_API Analysis : public AnalysisObject {
    *  the resulting DataPoint is not yet in this Analysis, and if not dataPointsAreInvalid. */
   bool addDataPoint(const std::vector<DiscretePerturbation>& perturbations);
 
+  /** Adds each of dataPoints as addDataPoint would, but signals a single change to this
+   *  analysis. Prefer this method when adding large designs. Returns the number of data points
+   *  added. */
+  unsigned addDataPoints(const std::vector<DataPoint>& dataPoints);
+
   /** Removes dataPoint from this analysis. Returns false if dataPoint is not in this analysis by
    *  UUID. */
   bool removeDataPoint(const DataPoint& dataPoint);
@@ -29,6 +29,9 @@
 
 #include <utilities/core/FileReference.hpp>
 
+#include <boost/unordered_map.hpp>
+
+#include <map>
 #include <vector>
 
 namespace openstudio {
@@ -132,7 +135,8 @@ namespace detail {
     std::vector<DataPoint> failedDataPoints() const;
 
     /** Get the DataPoints with matching variableValues. VariableValues may contain Null QVariants of
-     *  the correct type, which means that any value at that position should be returned. */
+     *  the correct type, which means that any value at that position should be returned. Fully
+     *  specified variableValues are looked up in a hash index; others require a scan. */
     std::vector<DataPoint> getDataPoints(const std::vector<QVariant>& variableValues) const;
 
     /** Get the DataPoints defined by perturbations. Perturbations must be translatable into a valid set
@@ -192,6 +196,10 @@ namespace detail {
      *  the resulting DataPoint is not yet in this Analysis, and if not dataPointsAreInvalid. */
     bool addDataPoint(const std::vector<DiscretePerturbation>& perturbations);
 
+    /** Adds each of dataPoints as addDataPoint would, but signals a single change to this
+     *  analysis. Returns the number of data points added. */
+    unsigned addDataPoints(const std::vector<DataPoint>& dataPoints);
+
     /** Sets run information on a DataPoint. Returns false if dataPoint is not in this analysis by
      *  UUID. */
     bool setDataPointRunInformation(DataPoint& dataPoint, const runmanager::Job& topLevelJob, const std::vector<openstudio::path>& dakotaParametersFiles);
@@ -256,8 +264,55 @@ namespace detail {
     /** Calls AnalysisObject_Impl version and invalidates data points if appropriate. */
     virtual void onChange(ChangeType changeType);
 
+   private slots:
+    /** Moves the sending DataPoint between status buckets. */
+    void onDataPointChanged(ChangeType changeType);
+
    private:
     REGISTER_LOGGER("openstudio.analysis.Analysis");
+
+    // status of an indexed DataPoint when it was last bucketed
+    struct DataPointStatus {
+      bool complete;
+      bool failed;
+      std::vector<std::string> tags;
+    };
+
+    // DataPoints keyed by insertion order, so buckets list in the order of m_dataPoints
+    typedef std::map<unsigned,DataPoint> DataPointBucket;
+
+    unsigned m_nextDataPointIndex;
+    std::map<UUID,unsigned> m_dataPointIndices;
+    DataPointBucket m_indexedDataPoints;
+    std::map<unsigned,DataPointStatus> m_dataPointStatuses;
+    boost::unordered_multimap<std::string,unsigned> m_variableValuesIndex;
+    DataPointBucket m_incompleteDataPoints;
+    DataPointBucket m_successfulDataPoints;
+    DataPointBucket m_failedDataPoints;
+    std::map<std::string,DataPointBucket> m_taggedDataPoints;
+
+    /** Canonical hash key for fully specified variableValues. Returns false if any value is null
+     *  or not finite. */
+    static bool variableValuesKey(const std::vector<QVariant>& variableValues, std::string& key);
+
+    /** Keys of every index entry that can hold data points matching variableValues. Returns false
+     *  if the index cannot be used, in which case all data points must be searched. */
+    static bool variableValuesKeys(const std::vector<QVariant>& variableValues,
+                                   std::vector<std::string>& keys);
+
+    bool addDataPointNoSignal(const DataPoint& dataPoint);
+
+    void indexDataPoint(DataPoint& dataPoint);
+
+    void unindexDataPoint(DataPoint& dataPoint);
+
+    void clearDataPointIndex();
+
+    void bucketDataPoint(unsigned index, const DataPoint& dataPoint);
+
+    void unbucketDataPoint(unsigned index);
+
+    static std::vector<DataPoint> bucketDataPoints(const DataPointBucket& bucket);
   };
 
 } // detail
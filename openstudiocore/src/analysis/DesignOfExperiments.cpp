@@ -28,7 +28,10 @@
 #include <analysis/DataPoint.hpp>
 #include <analysis/DiscreteVariable.hpp>
 #include <analysis/DiscreteVariable_Impl.hpp>
+#include <analysis/ContinuousVariable.hpp>
+#include <analysis/ContinuousVariable_Impl.hpp>
 
+#include <utilities/math/SampleDesigns.hpp>
 #include <utilities/core/Optional.hpp>
 
 #include <boost/foreach.hpp>
@@ -71,8 +74,34 @@ namespace detail {
   }
 
   bool DesignOfExperiments_Impl::isCompatibleProblemType(const Problem& problem) const {
-    if (!problem.allVariablesAreDiscrete()) {
-      LOG(Info,"DesignOfExperiments only operates on Problems composed of DiscreteVariables.");
+    DesignOfExperimentsType designType = designOfExperimentsOptions().designType();
+    BOOST_FOREACH(const InputVariable& variable, problem.variables()) {
+      if (variable.optionalCast<DiscreteVariable>()) {
+        continue;
+      }
+      OptionalContinuousVariable continuousVariable = variable.optionalCast<ContinuousVariable>();
+      if (!continuousVariable) {
+        LOG(Info,"DesignOfExperiments only operates on Problems composed of DiscreteVariables "
+            << "and ContinuousVariables.");
+        return false;
+      }
+      if (!(continuousVariable->minimum() && continuousVariable->maximum())) {
+        LOG(Info,"DesignOfExperiments requires ContinuousVariable '" << continuousVariable->name()
+            << "' to have a minimum and a maximum.");
+        return false;
+      }
+      if ((designType == DesignOfExperimentsType::FullFactorial) &&
+          continuousVariable->incrementalValues().empty())
+      {
+        LOG(Info,"Full factorial DesignOfExperiments requires ContinuousVariable '" 
+            << continuousVariable->name() << "' to have an increment or a number of steps.");
+        return false;
+      }
+    }
+    if ((designType == DesignOfExperimentsType::Sobol) &&
+        (problem.numVariables() > static_cast<int>(maxSobolDimensions())))
+    {
+      LOG(Info,"Sobol DesignOfExperiments supports at most " << maxSobolDimensions() << " variables.");
       return false;
     }
     return true;
@@ -83,9 +112,7 @@ namespace detail {
 
     // to make sure problem type check has already occured. this is stated usage in header.
     BOOST_ASSERT(analysis.algorithm().get() == getPublicObject<DesignOfExperiments>());
-    // nothing else is supported yet
     DesignOfExperimentsOptions options = designOfExperimentsOptions();
-    BOOST_ASSERT(options.designType() == DesignOfExperimentsType::FullFactorial);
 
     if (isComplete()) {
       LOG(Info,"Algorithm is already marked as complete. Returning without creating new points.");
@@ -111,48 +138,59 @@ namespace detail {
       return result;
     } 
 
+    // design type may have changed since the problem was checked
+    Problem problem = analysis.problem();
+    if (!isCompatibleProblemType(problem)) {
+      LOG(Error,"The " << options.designType().valueDescription() << " design cannot be applied "
+          << "to the Problem of Analysis '" << analysis.name() << "'. No DataPoints will be added, "
+          << "and the Algorithm will be marked as failed.");
+      markFailed();
+      return result;
+    }
+
     m_iter = 1;
 
-    // determine all combinations
-    std::vector< std::vector<QVariant> > variableValues;
-    BOOST_FOREACH(const Variable variable, analysis.problem().variables()) {
-      // variable must be DiscreteVariable, otherwise !isCompatibleProblemType(analysis.problem())
-      DiscreteVariable discreteVariable = variable.cast<DiscreteVariable>();
-      DiscretePerturbationVector discretePerturbations = discreteVariable.perturbations(false);
-      std::vector< std::vector<QVariant> > currentValues = variableValues;
-      for (unsigned i = 0, n = discreteVariable.numPerturbations(false); i < n; ++i) {
-        if (discretePerturbations[i].isSelected()) {
-          std::vector< std::vector<QVariant> > nextSet = currentValues;
-          if (currentValues.empty()) {
-            variableValues.push_back(std::vector<QVariant>(1u,QVariant(i)));
-          }
-          else {
-            BOOST_FOREACH(std::vector<QVariant>& point,nextSet) {
-              point.push_back(i);
-            }
-            if (i == 0) {
-              variableValues = nextSet;
-            }
-            else {
-              variableValues.insert(variableValues.end(),nextSet.begin(),nextSet.end());
-            }
+    if (options.designType() == DesignOfExperimentsType::FullFactorial) {
+      // create data points and add to analysis
+      BOOST_FOREACH(const std::vector<QVariant>& value,fullFactorialVariableValues(problem)) {
+        DataPoint dataPoint = problem.createDataPoint(value).get();
+        dataPoint.addTag("DOE");
+        bool added = analysis.addDataPoint(dataPoint);
+        if (added) {
+          ++result;
+          ++totPoints;
+          if (mxSim && (totPoints == mxSim.get())) {
+            break;
           }
         }
       }
     }
+    else {
+      int numSamples = options.samples();
+      if (mxSim) {
+        numSamples = std::min(numSamples,*mxSim - totPoints);
+      }
+      // make sure the design can be reproduced
+      if (!options.seed()) {
+        if (options.designType() != DesignOfExperimentsType::Sobol) {
+          options.setSeed(randomSeed());
+        }
+      }
 
-    // create data points and add to analysis
-    BOOST_FOREACH(const std::vector<QVariant>& value,variableValues) {
-      DataPoint dataPoint = analysis.problem().createDataPoint(value).get();
-      dataPoint.addTag("DOE");
-      bool added = analysis.addDataPoint(dataPoint);
-      if (added) {
-        ++result;
-        ++totPoints;
-        if (mxSim && (totPoints == mxSim.get())) {
-          break;
+      // create all data points, then add them to the analysis in one batch
+      DataPointVector newDataPoints;
+      BOOST_FOREACH(const std::vector<QVariant>& value,
+                    sampledVariableValues(problem,options,static_cast<unsigned>(numSamples)))
+      {
+        OptionalDataPoint dataPoint = problem.createDataPoint(value);
+        if (!dataPoint) {
+          LOG(Warn,"Unable to create DataPoint from sampled variable values.");
+          continue;
         }
+        dataPoint->addTag("DOE");
+        newDataPoints.push_back(*dataPoint);
       }
+      result = analysis.addDataPoints(newDataPoints);
     }
 
     if (result == 0) {
@@ -167,6 +205,122 @@ namespace detail {
     return m_options.cast<DesignOfExperimentsOptions>();
   }
 
+  std::vector< std::vector<QVariant> > DesignOfExperiments_Impl::fullFactorialVariableValues(
+      const Problem& problem) const
+  {
+    std::vector< std::vector<QVariant> > result;
+    BOOST_FOREACH(const InputVariable& variable, problem.variables()) {
+      // variable levels
+      std::vector<QVariant> levels;
+      if (OptionalDiscreteVariable discreteVariable = variable.optionalCast<DiscreteVariable>()) {
+        DiscretePerturbationVector discretePerturbations = discreteVariable->perturbations(false);
+        for (unsigned i = 0, n = discretePerturbations.size(); i < n; ++i) {
+          if (discretePerturbations[i].isSelected()) {
+            levels.push_back(QVariant(i));
+          }
+        }
+      }
+      else {
+        // otherwise !isCompatibleProblemType(problem)
+        BOOST_FOREACH(double value, variable.cast<ContinuousVariable>().incrementalValues()) {
+          levels.push_back(QVariant(value));
+        }
+      }
+
+      // combine with previous variables, which vary faster
+      if (result.empty()) {
+        BOOST_FOREACH(const QVariant& level, levels) {
+          result.push_back(std::vector<QVariant>(1u,level));
+        }
+        continue;
+      }
+      std::vector< std::vector<QVariant> > combinations;
+      combinations.reserve(result.size() * levels.size());
+      BOOST_FOREACH(const QVariant& level, levels) {
+        BOOST_FOREACH(const std::vector<QVariant>& point, result) {
+          combinations.push_back(point);
+          combinations.back().push_back(level);
+        }
+      }
+      result.swap(combinations);
+    }
+    return result;
+  }
+
+  std::vector< std::vector<QVariant> > DesignOfExperiments_Impl::sampledVariableValues(
+      const Problem& problem,
+      const DesignOfExperimentsOptions& options,
+      unsigned numSamples) const
+  {
+    std::vector< std::vector<QVariant> > result;
+    InputVariableVector variables = problem.variables();
+    unsigned numVariables = variables.size();
+    unsigned seed = options.seed() ? static_cast<unsigned>(*options.seed()) : 0u;
+
+    // points in the unit hypercube
+    std::vector< std::vector<double> > design;
+    switch (options.designType().value()) {
+      case DesignOfExperimentsType::LatinHypercube :
+        design = latinHypercubeDesign(numSamples,numVariables,seed);
+        break;
+      case DesignOfExperimentsType::Sobol :
+        if (options.seed()) {
+          design = sobolDesign(numSamples,numVariables,seed);
+        }
+        else {
+          design = sobolDesign(numSamples,numVariables);
+        }
+        break;
+      case DesignOfExperimentsType::Random :
+        design = randomDesign(numSamples,numVariables,seed);
+        break;
+      default :
+        BOOST_ASSERT(false);
+    }
+
+    // map each coordinate onto its variable
+    std::vector< std::vector<QVariant> > discreteLevels(numVariables);
+    std::vector<std::pair<double,double> > continuousRanges(numVariables);
+    for (unsigned j = 0; j < numVariables; ++j) {
+      if (OptionalDiscreteVariable discreteVariable = variables[j].optionalCast<DiscreteVariable>()) {
+        DiscretePerturbationVector discretePerturbations = discreteVariable->perturbations(false);
+        for (unsigned i = 0, n = discretePerturbations.size(); i < n; ++i) {
+          if (discretePerturbations[i].isSelected()) {
+            discreteLevels[j].push_back(QVariant(i));
+          }
+        }
+        if (discreteLevels[j].empty()) {
+          LOG(Warn,"DiscreteVariable '" << discreteVariable->name() << "' has no selected "
+              << "perturbations, so no DataPoints can be sampled.");
+          return result;
+        }
+      }
+      else {
+        ContinuousVariable continuousVariable = variables[j].cast<ContinuousVariable>();
+        continuousRanges[j] = std::make_pair(*continuousVariable.minimum(),*continuousVariable.maximum());
+      }
+    }
+
+    result.reserve(numSamples);
+    BOOST_FOREACH(const std::vector<double>& point, design) {
+      std::vector<QVariant> values(numVariables);
+      for (unsigned j = 0; j < numVariables; ++j) {
+        if (!discreteLevels[j].empty()) {
+          unsigned n = discreteLevels[j].size();
+          unsigned index = std::min(static_cast<unsigned>(point[j] * n),n - 1u);
+          values[j] = discreteLevels[j][index];
+        }
+        else {
+          const std::pair<double,double>& range = continuousRanges[j];
+          values[j] = QVariant(range.first + point[j] * (range.second - range.first));
+        }
+      }
+      result.push_back(values);
+    }
+
+    return result;
+  }
+
 } // detail
 
 DesignOfExperiments::DesignOfExperiments(const DesignOfExperimentsOptions& options)
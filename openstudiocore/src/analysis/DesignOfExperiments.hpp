@@ -34,10 +34,13 @@ namespace detail {
 
 } // detail
 
-/** DesignOfExperiments is an OpenStudioAlgorithm. Currently, DesignOfExperiments may be used to 
- *  perform full mesh parametric analyses on \link Problem Problems \endlink for which 
- *  Problem::allVariablesAreDiscrete. DesignOfExperiments::createNextIteration adds all \link 
- *  DataPoint DataPoints \endlink at once, in one batch. */
+/** DesignOfExperiments is an OpenStudioAlgorithm. DesignOfExperiments may be used to perform 
+ *  full mesh parametric analyses, and Latin hypercube, Sobol, and random sampling studies, on 
+ *  \link Problem Problems \endlink composed of \link DiscreteVariable DiscreteVariables 
+ *  \endlink and bounded \link ContinuousVariable ContinuousVariables \endlink. The designs are 
+ *  generated in-process, without running DAKOTA. DesignOfExperiments::createNextIteration adds 
+ *  all \link DataPoint DataPoints \endlink at once, in one batch. See DesignOfExperimentsType 
+ *  for details. */
 class ANALYSIS_API DesignOfExperiments : public OpenStudioAlgorithm {
  public:
   /** @name Constructors and Destructors */
@@ -20,6 +20,9 @@
 #include <analysis/DesignOfExperimentsOptions.hpp>
 #include <analysis/DesignOfExperimentsOptions_Impl.hpp>
 
+#include <utilities/math/SampleDesigns.hpp>
+#include <utilities/core/Optional.hpp>
+
 namespace openstudio {
 namespace analysis {
 
@@ -28,7 +31,12 @@ namespace detail {
   DesignOfExperimentsOptions_Impl::DesignOfExperimentsOptions_Impl(
       const DesignOfExperimentsType& designType)
     : AlgorithmOptions_Impl(), m_designType(designType)
-  {}
+  {
+    // full factorial designs are not random
+    if (m_designType != DesignOfExperimentsType::FullFactorial) {
+      setSeed(randomSeed());
+    }
+  }
 
   DesignOfExperimentsOptions_Impl::DesignOfExperimentsOptions_Impl(
       const DesignOfExperimentsType& designType,
@@ -45,10 +53,60 @@ namespace detail {
     return m_designType;
   }
 
+  int DesignOfExperimentsOptions_Impl::samples() const {
+    // not saved by older versions
+    if (OptionalAttribute option = getOption("samples")) {
+      return option->valueAsInteger();
+    }
+    return 10;
+  }
+
+  boost::optional<int> DesignOfExperimentsOptions_Impl::seed() const {
+    OptionalInt result;
+    if (OptionalAttribute option = getOption("seed")) {
+      result = option->valueAsInteger();
+    }
+    return result;
+  }
+
   void DesignOfExperimentsOptions_Impl::setDesignType(const DesignOfExperimentsType& designType) {
     m_designType = designType;
   }
 
+  bool DesignOfExperimentsOptions_Impl::setSamples(int value) {
+    if (value < 1) {
+      LOG(Warn,"Cannot set DesignOfExperimentsOptions samples to a value less than one.");
+      return false;
+    }
+    OptionalAttribute option;
+    if (option = getOption("samples")) {
+      option->setValue(value);
+    }
+    else {
+      saveOption(Attribute("samples",value));
+    }
+    return true;
+  }
+
+  bool DesignOfExperimentsOptions_Impl::setSeed(int value) {
+    if (value < 1) {
+      LOG(Warn,"Cannot set DesignOfExperimentsOptions seed to a value less than one.");
+      return false;
+    }
+    OptionalAttribute option;
+    if (option = getOption("seed")) {
+      option->setValue(value);
+    }
+    else {
+      saveOption(Attribute("seed",value));
+    }
+    return true;
+  }
+
+  void DesignOfExperimentsOptions_Impl::clearSeed() {
+    clearOption("seed");
+  }
+
 } // detail
 
 DesignOfExperimentsOptions::DesignOfExperimentsOptions(const DesignOfExperimentsType& designType)
@@ -66,10 +124,30 @@ DesignOfExperimentsType DesignOfExperimentsOptions::designType() const {
   return getImpl<detail::DesignOfExperimentsOptions_Impl>()->designType();
 }
 
+int DesignOfExperimentsOptions::samples() const {
+  return getImpl<detail::DesignOfExperimentsOptions_Impl>()->samples();
+}
+
+boost::optional<int> DesignOfExperimentsOptions::seed() const {
+  return getImpl<detail::DesignOfExperimentsOptions_Impl>()->seed();
+}
+
 void DesignOfExperimentsOptions::setDesignType(const DesignOfExperimentsType& designType) {
   getImpl<detail::DesignOfExperimentsOptions_Impl>()->setDesignType(designType);
 }
 
+bool DesignOfExperimentsOptions::setSamples(int value) {
+  return getImpl<detail::DesignOfExperimentsOptions_Impl>()->setSamples(value);
+}
+
+bool DesignOfExperimentsOptions::setSeed(int value) {
+  return getImpl<detail::DesignOfExperimentsOptions_Impl>()->setSeed(value);
+}
+
+void DesignOfExperimentsOptions::clearSeed() {
+  getImpl<detail::DesignOfExperimentsOptions_Impl>()->clearSeed();
+}
+
 /// @cond
 DesignOfExperimentsOptions::DesignOfExperimentsOptions(boost::shared_ptr<detail::DesignOfExperimentsOptions_Impl> impl)
   : AlgorithmOptions(impl)
@@ -36,9 +36,18 @@ namespace detail {
 
 /** \class DesignOfExperimentsType 
  *
- *  \relates DesignOfExperimentsOptions */
+ *  \relates DesignOfExperimentsOptions 
+ *
+ *  FullFactorial runs every combination of the selected perturbations of each DiscreteVariable 
+ *  and the ContinuousVariable::incrementalValues of each ContinuousVariable. LatinHypercube, 
+ *  Sobol, and Random draw DesignOfExperimentsOptions::samples points, seeded by 
+ *  DesignOfExperimentsOptions::seed, from the selected perturbations of each DiscreteVariable 
+ *  and the [minimum,maximum] range of each ContinuousVariable. */
 OPENSTUDIO_ENUM( DesignOfExperimentsType,
   ((FullFactorial)(full factorial))
+  ((LatinHypercube)(latin hypercube))
+  ((Sobol)(sobol))
+  ((Random)(random))
 );
 
 /** DesignOfExperimentsOptions is an AlgorithmOptions class for use with DesignOfExperiments.
@@ -62,12 +71,29 @@ class ANALYSIS_API DesignOfExperimentsOptions : public AlgorithmOptions {
 
   DesignOfExperimentsType designType() const;
 
+  /** Returns the number of samples to be drawn by sampling design types. Not used by 
+   *  FullFactorial. The default is 10. */
+  int samples() const;
+
+  /** Returns the random number seed used by sampling design types. Set to a random value on 
+   *  construction of a sampling design type, so that the design can be reproduced. For Sobol designs, the seed 
+   *  determines a scrambling of the sequence, which is not applied if the seed is cleared. */
+  boost::optional<int> seed() const;
+
   //@}
   /** @name Setters */
   //@{
 
   void setDesignType(const DesignOfExperimentsType& designType);
 
+  /** Sets the number of samples. Returns false if value < 1. */
+  bool setSamples(int value);
+
+  /** Sets the seed. Returns false if value < 1. */
+  bool setSeed(int value);
+
+  void clearSeed();
+
   //@}
  protected:
   /// @cond
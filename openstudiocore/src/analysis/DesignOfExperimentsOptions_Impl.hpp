@@ -50,12 +50,22 @@ namespace detail {
 
     DesignOfExperimentsType designType() const;
 
+    int samples() const;
+
+    boost::optional<int> seed() const;
+
     //@}
     /** @name Setters */
     //@{
 
     void setDesignType(const DesignOfExperimentsType& designType);
 
+    bool setSamples(int value);
+
+    bool setSeed(int value);
+
+    void clearSeed();
+
     //@}
    protected:
     DesignOfExperimentsType m_designType;
@@ -80,6 +80,14 @@ namespace detail {
     //@}
    private:
     REGISTER_LOGGER("openstudio.analysis.DesignOfExperiments");
+
+    // all combinations of the levels of each variable, first variable varying fastest
+    std::vector< std::vector<QVariant> > fullFactorialVariableValues(const Problem& problem) const;
+
+    // numSamples points from the design type in options, mapped onto each variable's range
+    std::vector< std::vector<QVariant> > sampledVariableValues(const Problem& problem,
+                                                               const DesignOfExperimentsOptions& options,
+                                                               unsigned numSamples) const;
   };
 
 } // detail
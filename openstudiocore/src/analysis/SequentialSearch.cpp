@@ -34,6 +34,7 @@
 
 #include <utilities/document/Table.hpp>
 #include <utilities/math/FloatCompare.hpp>
+#include <utilities/math/NondominatedSort.hpp>
 #include <utilities/core/Assert.hpp>
 #include <utilities/core/Containers.hpp>
 
@@ -219,17 +220,29 @@ namespace detail {
     OptimizationDataPointVector successfulPoints = castVector<OptimizationDataPoint>(
         analysis.successfulDataPoints());
 
+    // get objective values once, successfulValues[j] goes with successfulPoints[j]
+    std::vector<DoubleVector> successfulValues;
+    successfulValues.reserve(successfulPoints.size());
+    BOOST_FOREACH(const OptimizationDataPoint& point, successfulPoints) {
+      successfulValues.push_back(point.objectiveValues());
+    }
+
     // construct curve
     OptionalOptimizationDataPoint current;
+    DoubleVector currentValues;
     if (!result.empty()) {
       current = result.back();
       if (!current->isTag(curveTag)) {
         current->addTag(curveTag);
       }
+      currentValues = current->objectiveValues();
       OptimizationDataPointVector::iterator it = std::find(successfulPoints.begin(),
                                                            successfulPoints.end(),
                                                            result.back());
-      successfulPoints.erase(it);
+      if (it != successfulPoints.end()) {
+        successfulValues.erase(successfulValues.begin() + (it - successfulPoints.begin()));
+        successfulPoints.erase(it);
+      }
     }
     int otherIndex(0);
     if (i == 0) {
@@ -240,15 +253,14 @@ namespace detail {
     }
     while (current) {
       OptionalOptimizationDataPoint candidate;
+      DoubleVector candidateValues;
       if (current->isTag("explored") && current->isComplete() && !current->failed()) {
         // candidates have objective function at otherIndex < current's
-        DoubleVector currentValues = current->objectiveValues();
         OptionalDouble candidateSlope;
-        DoubleVector candidateValues;
-        for (OptimizationDataPointVector::iterator it = successfulPoints.begin();
-             it != successfulPoints.end(); )
-        {
-          DoubleVector values = it->objectiveValues();
+        // points kept for consideration are compacted to the front of successfulPoints
+        unsigned numKept(0);
+        for (unsigned j = 0, n = successfulPoints.size(); j < n; ++j) {
+          const DoubleVector& values = successfulValues[j];
           if (lessThanOrEqual(values[otherIndex],currentValues[otherIndex])) {
             // take maximum slope as calculated on graph i vs. otherIndex
             double slope = (values[i] - currentValues[i])/
@@ -268,21 +280,24 @@ namespace detail {
                  ((!candidateSlope) || (slope > *candidateSlope) ||
                   (equal(slope,*candidateSlope) && (values[i] < candidateValues[i])))))
             {
-              candidate = *it;
+              candidate = successfulPoints[j];
               candidateSlope = slope;
               candidateValues = values;
               if (infiniteSlopeException) {
                 candidateSlope = std::numeric_limits<double>::max();
               }
             }
-            ++it;
-          }
-          else {
-            // erase it from consideration--with other objective function > current,
-            // will never be candidate.
-            it = successfulPoints.erase(it);
+            if (numKept != j) {
+              successfulPoints[numKept] = successfulPoints[j];
+              successfulValues[numKept].swap(successfulValues[j]);
+            }
+            ++numKept;
           }
+          // else drop it from consideration--with other objective function > current,
+          // will never be candidate.
         }
+        successfulPoints.erase(successfulPoints.begin() + numKept,successfulPoints.end());
+        successfulValues.erase(successfulValues.begin() + numKept,successfulValues.end());
       }
       if (candidate) {
         result.push_back(*candidate);
@@ -292,9 +307,11 @@ namespace detail {
         OptimizationDataPointVector::iterator it = std::find(successfulPoints.begin(),
                                                              successfulPoints.end(),
                                                              result.back());
+        successfulValues.erase(successfulValues.begin() + (it - successfulPoints.begin()));
         successfulPoints.erase(it);
       }
       current = candidate;
+      currentValues = candidateValues;
     }
 
     // remove outdated tags
@@ -328,7 +345,13 @@ namespace detail {
     temp = analysis.successfulDataPoints();
     OptimizationDataPointVector successfulPoints = castVector<OptimizationDataPoint>(temp);
 
-    // sort by objective function options().objectiveToMinimizeFirst()
+    // non-dominated means that you cannot improve one objective without harming the other
+    NondominatedSort sort(2u);
+    BOOST_FOREACH(const OptimizationDataPoint& point, successfulPoints) {
+      sort.addPoint(point.objectiveValues());
+    }
+
+    // order by objective function options().objectiveToMinimizeFirst()
     int i = sequentialSearchOptions().objectiveToMinimizeFirst();
     int otherIndex(0);
     if (i == 0) {
@@ -337,48 +360,39 @@ namespace detail {
     else {
       BOOST_ASSERT(i == 1);
     }
-    OptimizationDataPointObjectiveFunctionLess predicate(i);
-    std::sort(successfulPoints.begin(),successfulPoints.end(),predicate);
+    std::vector<std::pair<double,unsigned> > front;
+    BOOST_FOREACH(unsigned index, sort.paretoFront()) {
+      front.push_back(std::make_pair(sort.values(index)[i],index));
+    }
+    std::sort(front.begin(),front.end());
 
-    // non-dominated means that you cannot improve one objective without harming the other
-    OptimizationDataPointVector::iterator it = successfulPoints.begin();
+    // the sort compares exactly, drop points that only differ from another by round-off
     DoubleVector currentValues;
-    while (it != successfulPoints.end()) {
-      // it has next-worst objective i
-      DoubleVector candidateValues = it->objectiveValues();
-      if (!currentValues.empty()) {
-        BOOST_ASSERT(greaterThanOrEqual(candidateValues[i],currentValues[i]));
-      }
+    for (std::vector<std::pair<double,unsigned> >::const_iterator it = front.begin(); 
+         it != front.end(); ++it)
+    {
+      const DoubleVector& candidateValues = sort.values(it->second);
       // is Pareto if improves objective otherIndex, and
       if (!currentValues.empty() &&
           greaterThanOrEqual(candidateValues[otherIndex],currentValues[otherIndex]))
       {
-        it = successfulPoints.erase(it);
         continue;
       }
       // is Pareto if there is no other point with same objective i and better objective otherIndex
-      OptimizationDataPointVector::const_iterator jt = it; ++jt;
-      bool erasedIt(false);
-      while (jt != successfulPoints.end()) {
-        DoubleVector nextValues = jt->objectiveValues();
-        if (equal(candidateValues[i],nextValues[i])) {
-          if (nextValues[otherIndex] < candidateValues[otherIndex]) {
-            it = successfulPoints.erase(it);
-            erasedIt = true;
-            break;
-          }
-          ++jt;
-        }
-        else {
+      bool dominated(false);
+      for (std::vector<std::pair<double,unsigned> >::const_iterator jt = it + 1; 
+           (jt != front.end()) && equal(candidateValues[i],sort.values(jt->second)[i]); ++jt)
+      {
+        if (sort.values(jt->second)[otherIndex] < candidateValues[otherIndex]) {
+          dominated = true;
           break;
         }
       }
-      if (erasedIt) {
+      if (dominated) {
         continue;
       }
-      result.push_back(*it);
-      it = successfulPoints.erase(it);
-      currentValues = result.back().objectiveValues();
+      currentValues = candidateValues;
+      result.push_back(successfulPoints[it->second]);
       if (!result.back().isTag("pareto")) {
         result.back().addTag("pareto");
       }
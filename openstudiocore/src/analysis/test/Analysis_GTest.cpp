@@ -43,6 +43,8 @@
 #include <utilities/core/Containers.hpp>
 #include <utilities/data/Tag.hpp>
 
+#include <limits>
+
 using namespace openstudio;
 using namespace openstudio::analysis;
 using namespace openstudio::ruleset;
@@ -321,3 +323,142 @@ TEST_F(AnalysisFixture, Analysis_ClearAllResults) {
   EXPECT_FALSE(analysis.algorithm()->cast<DakotaAlgorithm>().restartFileReference());
   EXPECT_FALSE(analysis.algorithm()->cast<DakotaAlgorithm>().outFileReference());
 }
+
+TEST_F(AnalysisFixture, Analysis_DataPointIndex) {
+  // problem with two discrete variables of five perturbations each
+  Problem problem("Problem",VariableVector(),runmanager::Workflow());
+  for (int i = 0; i < 2; ++i) {
+    DiscretePerturbationVector perturbations;
+    perturbations.push_back(NullPerturbation());
+    for (int j = 0; j < 4; ++j) {
+      std::stringstream ss;
+      ss << "measure" << i << j << ".rb";
+      perturbations.push_back(RubyPerturbation(toPath(ss.str()),
+                                               FileReferenceType::OSM,
+                                               FileReferenceType::OSM,true));
+    }
+    std::stringstream ss;
+    ss << "Variable " << i + 1;
+    problem.push(DiscreteVariable(ss.str(),perturbations));
+  }
+  Analysis analysis("Analysis",problem,FileReferenceType::OSM);
+
+  // full factorial design, with a duplicate of each point
+  DataPointVector design;
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      std::vector<QVariant> values;
+      values.push_back(i);
+      values.push_back(j);
+      OptionalDataPoint dataPoint = problem.createDataPoint(values);
+      ASSERT_TRUE(dataPoint);
+      design.push_back(*dataPoint);
+      design.push_back(problem.createDataPoint(values).get());
+    }
+  }
+  EXPECT_EQ(25u,analysis.addDataPoints(design));
+  EXPECT_EQ(25u,analysis.dataPoints().size());
+  EXPECT_EQ(0u,analysis.addDataPoints(design));
+  EXPECT_FALSE(analysis.addDataPoint(design[0]));
+  EXPECT_EQ(25u,analysis.dataPointsToQueue().size());
+  EXPECT_TRUE(analysis.completeDataPoints().empty());
+
+  // exact and wildcard lookups
+  std::vector<QVariant> values;
+  values.push_back(3);
+  values.push_back(2);
+  DataPointVector found = analysis.getDataPoints(values);
+  ASSERT_EQ(1u,found.size());
+  EXPECT_TRUE(found[0] == analysis.dataPoints()[17]);
+  values[1] = QVariant(QVariant::Int);
+  EXPECT_EQ(5u,analysis.getDataPoints(values).size());
+  values[1] = 2.0;
+  EXPECT_TRUE(analysis.getDataPoints(values).empty());
+
+  OptionalDataPoint byUUID = analysis.getDataPointByUUID(design[10].uuid());
+  ASSERT_TRUE(byUUID);
+  EXPECT_TRUE(byUUID.get() == design[10]);
+  EXPECT_FALSE(analysis.getDataPointByUUID(design[11].uuid()));
+
+  // status buckets follow the data points
+  DataPointVector dataPoints = analysis.dataPoints();
+  dataPoints[4].markComplete();
+  dataPoints[2].markComplete();
+  dataPoints[2].markFailed();
+  dataPoints[7].markComplete();
+  dataPoints[7].addTag("baseline");
+  dataPoints[1].addTag("baseline");
+  EXPECT_EQ(22u,analysis.dataPointsToQueue().size());
+  DataPointVector complete = analysis.completeDataPoints();
+  ASSERT_EQ(3u,complete.size());
+  EXPECT_TRUE(complete[0] == dataPoints[2]);
+  EXPECT_TRUE(complete[1] == dataPoints[4]);
+  EXPECT_TRUE(complete[2] == dataPoints[7]);
+  EXPECT_EQ(2u,analysis.successfulDataPoints().size());
+  ASSERT_EQ(1u,analysis.failedDataPoints().size());
+  EXPECT_TRUE(analysis.failedDataPoints()[0] == dataPoints[2]);
+  DataPointVector tagged = analysis.getDataPoints("baseline");
+  ASSERT_EQ(2u,tagged.size());
+  EXPECT_TRUE(tagged[0] == dataPoints[1]);
+  EXPECT_TRUE(tagged[1] == dataPoints[7]);
+
+  dataPoints[7].deleteTag("baseline");
+  EXPECT_EQ(1u,analysis.getDataPoints("baseline").size());
+  EXPECT_TRUE(analysis.clearResults(dataPoints[2]));
+  EXPECT_TRUE(analysis.failedDataPoints().empty());
+  EXPECT_EQ(23u,analysis.dataPointsToQueue().size());
+
+  // removal
+  EXPECT_TRUE(analysis.removeDataPoint(dataPoints[4]));
+  EXPECT_EQ(24u,analysis.dataPoints().size());
+  EXPECT_EQ(1u,analysis.completeDataPoints().size());
+  values[0] = 0;
+  values[1] = 4;
+  EXPECT_TRUE(analysis.getDataPoints(values).empty());
+  EXPECT_TRUE(analysis.addDataPoint(dataPoints[4]));
+  EXPECT_EQ(1u,analysis.getDataPoints(values).size());
+
+  // clones are indexed too
+  Analysis copy = analysis.clone().cast<Analysis>();
+  EXPECT_EQ(2u,copy.completeDataPoints().size());
+  EXPECT_EQ(1u,copy.getDataPoints(values).size());
+  EXPECT_EQ(1u,copy.getDataPoints("baseline").size());
+
+  analysis.removeAllDataPoints();
+  EXPECT_TRUE(analysis.dataPointsToQueue().empty());
+  EXPECT_TRUE(analysis.getDataPoints(values).empty());
+  EXPECT_TRUE(analysis.getDataPoints("baseline").empty());
+}
+
+TEST_F(AnalysisFixture, Analysis_DataPointIndex_Continuous) {
+  ModelObjectFilterType buildingType(IddObjectType::OS_Building);
+  ModelRulesetContinuousVariable var("Building Rotation",
+                                     ModelObjectFilterClauseVector(1u,buildingType),
+                                     "northAxis");
+  Problem problem("Problem",VariableVector(1u,var),runmanager::Workflow());
+  Analysis analysis("Analysis",problem,FileReferenceType::OSM);
+
+  DataPointVector design;
+  design.push_back(problem.createDataPoint(std::vector<QVariant>(1u,0.0)).get());
+  design.push_back(problem.createDataPoint(std::vector<QVariant>(1u,1.0)).get());
+  design.push_back(problem.createDataPoint(std::vector<QVariant>(1u,90.0)).get());
+  EXPECT_EQ(3u,analysis.addDataPoints(design));
+
+  // -0 matches 0
+  DataPointVector found = analysis.getDataPoints(std::vector<QVariant>(1u,-0.0));
+  ASSERT_EQ(1u,found.size());
+  EXPECT_TRUE(found[0] == design[0]);
+
+  // the double just below 1 is within tolerance of 1 but quantised on the other side of 1
+  double belowOne = 1.0 - std::numeric_limits<double>::epsilon() / 2.0;
+  found = analysis.getDataPoints(std::vector<QVariant>(1u,belowOne));
+  ASSERT_EQ(1u,found.size());
+  EXPECT_TRUE(found[0] == design[1]);
+
+  found = analysis.getDataPoints(std::vector<QVariant>(1u,90.0));
+  ASSERT_EQ(1u,found.size());
+  EXPECT_TRUE(found[0] == design[2]);
+
+  EXPECT_TRUE(analysis.getDataPoints(std::vector<QVariant>(1u,90.001)).empty());
+  EXPECT_TRUE(analysis.getDataPoints(std::vector<QVariant>(1u,1.0e-3)).empty());
+}
@@ -22,14 +22,129 @@
 
 #include <analysis/DesignOfExperiments.hpp>
 #include <analysis/DesignOfExperimentsOptions.hpp>
+#include <analysis/Analysis.hpp>
+#include <analysis/Problem.hpp>
+#include <analysis/DataPoint.hpp>
+#include <analysis/DiscreteVariable.hpp>
+#include <analysis/NullPerturbation.hpp>
+#include <analysis/ModelRulesetContinuousVariable.hpp>
+
+#include <runmanager/lib/Workflow.hpp>
+
+#include <ruleset/ModelObjectFilterType.hpp>
+
+#include <boost/foreach.hpp>
 
 using namespace openstudio;
 using namespace openstudio::analysis;
+using namespace openstudio::ruleset;
+
+namespace {
+
+  Problem createSamplingProblem() {
+    VariableVector variables;
+    ModelObjectFilterType buildingType(IddObjectType::OS_Building);
+    ModelRulesetContinuousVariable rotation("Building Rotation",
+                                            ModelObjectFilterClauseVector(1u,buildingType),
+                                            "northAxis");
+    rotation.setMinimum(0.0);
+    rotation.setMaximum(360.0);
+    variables.push_back(rotation);
+    DiscretePerturbationVector perturbations;
+    for (int i = 0; i < 3; ++i) {
+      perturbations.push_back(NullPerturbation());
+    }
+    variables.push_back(DiscreteVariable("Discrete",perturbations));
+    return Problem("Problem",variables,runmanager::Workflow());
+  }
+
+}
 
 TEST_F(AnalysisFixture, DesignOfExperiments_Construction) {
   DesignOfExperimentsOptions options(DesignOfExperimentsType::FullFactorial);
+  EXPECT_FALSE(options.seed());
   DesignOfExperiments algorithm(options);
   EXPECT_EQ(DesignOfExperiments::standardName(),algorithm.name());
   EXPECT_EQ(DesignOfExperimentsType(DesignOfExperimentsType::FullFactorial),
             algorithm.designOfExperimentsOptions().designType());
 }
+
+TEST_F(AnalysisFixture, DesignOfExperiments_Options) {
+  DesignOfExperimentsOptions options(DesignOfExperimentsType::LatinHypercube);
+  EXPECT_EQ(10,options.samples());
+  ASSERT_TRUE(options.seed());
+  EXPECT_GE(*options.seed(),1);
+  DesignOfExperimentsOptions otherOptions(DesignOfExperimentsType::LatinHypercube);
+  ASSERT_TRUE(otherOptions.seed());
+  EXPECT_NE(*options.seed(),*otherOptions.seed());
+
+  EXPECT_FALSE(options.setSamples(0));
+  EXPECT_TRUE(options.setSamples(20));
+  EXPECT_EQ(20,options.samples());
+  EXPECT_FALSE(options.setSeed(0));
+  EXPECT_TRUE(options.setSeed(3));
+  EXPECT_EQ(3,options.seed().get());
+  options.clearSeed();
+  EXPECT_FALSE(options.seed());
+
+  // deserialized from older versions
+  DesignOfExperimentsOptions oldOptions(DesignOfExperimentsType::FullFactorial,AttributeVector());
+  EXPECT_EQ(10,oldOptions.samples());
+  EXPECT_FALSE(oldOptions.seed());
+}
+
+TEST_F(AnalysisFixture, DesignOfExperiments_LatinHypercube) {
+  std::vector< std::vector<QVariant> > firstValues;
+  for (int run = 0; run < 2; ++run) {
+    Problem problem = createSamplingProblem();
+    DesignOfExperimentsOptions options(DesignOfExperimentsType::LatinHypercube);
+    options.setSamples(12);
+    options.setSeed(42);
+    DesignOfExperiments algorithm(options);
+    Analysis analysis("Analysis",problem,algorithm,FileReference(toPath("./in.osm")));
+
+    EXPECT_EQ(12,algorithm.createNextIteration(analysis));
+    DataPointVector dataPoints = analysis.dataPoints();
+    ASSERT_EQ(12u,dataPoints.size());
+
+    std::vector<int> levelCounts(3,0);
+    std::vector< std::vector<QVariant> > values;
+    BOOST_FOREACH(const DataPoint& dataPoint, dataPoints) {
+      EXPECT_TRUE(dataPoint.isTag("DOE"));
+      std::vector<QVariant> variableValues = dataPoint.variableValues();
+      ASSERT_EQ(2u,variableValues.size());
+      EXPECT_GE(variableValues[0].toDouble(),0.0);
+      EXPECT_LE(variableValues[0].toDouble(),360.0);
+      ++levelCounts[variableValues[1].toInt()];
+      values.push_back(variableValues);
+    }
+    // each discrete level gets an equal share of the strata
+    EXPECT_EQ(4,levelCounts[0]);
+    EXPECT_EQ(4,levelCounts[1]);
+    EXPECT_EQ(4,levelCounts[2]);
+
+    // same seed, same design
+    if (run == 0) {
+      firstValues = values;
+    }
+    else {
+      EXPECT_TRUE(firstValues == values);
+    }
+
+    // all points were added in one batch, so the next iteration only produces duplicates
+    EXPECT_EQ(0,algorithm.createNextIteration(analysis));
+    EXPECT_TRUE(algorithm.isComplete());
+  }
+}
+
+TEST_F(AnalysisFixture, DesignOfExperiments_FullFactorialContinuous) {
+  Problem problem = createSamplingProblem();
+  problem.variables()[0].cast<ModelRulesetContinuousVariable>().setNSteps(4);
+
+  DesignOfExperimentsOptions options(DesignOfExperimentsType::FullFactorial);
+  DesignOfExperiments algorithm(options);
+  Analysis analysis("Analysis",problem,algorithm,FileReference(toPath("./in.osm")));
+
+  EXPECT_EQ(15,algorithm.createNextIteration(analysis));
+  EXPECT_EQ(15u,analysis.dataPoints().size());
+}
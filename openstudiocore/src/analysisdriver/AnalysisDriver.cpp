@@ -509,17 +509,22 @@ namespace detail {
 
     // Check to see if there is any work to do.
     Analysis analysis = currentAnalysis->analysis();
-    DataPointVector dataPoints = analysis.dataPointsToQueue();
-    DataPointVector::iterator dpit = dataPoints.begin();
-    // Analysis does not know what is already running, so remove any points that already are.
-    while (dpit != dataPoints.end()) {
-      if (currentAnalysis->getImpl()->isQueuedDataPoint(*dpit)) {
-        dpit = dataPoints.erase(dpit);
-      } else {
-        ++dpit;
+    // Analysis does not know what is already running, so skip any points that already are. If
+    // runOptions().queueSize() is set, only the points that fit in the in-flight window are
+    // kept; the rest get their workflows created as queued jobs complete and free up slots.
+    OptionalInt numSlots = currentAnalysis->getImpl()->numAvailableQueueSlots();
+    DataPointVector dataPoints;
+    int numToQueue(0);
+    BOOST_FOREACH(const DataPoint& dataPoint,analysis.dataPointsToQueue()) {
+      if (currentAnalysis->getImpl()->isQueuedDataPoint(dataPoint)) {
+        continue;
+      }
+      ++numToQueue;
+      if (!numSlots || (int(dataPoints.size()) < *numSlots)) {
+        dataPoints.push_back(dataPoint);
       }
     }
-    if (dataPoints.empty()) {
+    if (numToQueue == 0) {
       // Declare analysis complete if possible
       bool analysisCompleteFlag(false);
       if (!analysis.algorithm() || !getDakotaAlgorithm(analysis))
@@ -546,6 +551,16 @@ namespace detail {
       return;
     }
 
+    // Set size of iteration if needed
+    if (currentAnalysis->numCompletedJobsInOSIteration() == currentAnalysis->totalNumJobsInOSIteration()) {
+      currentAnalysis->getImpl()->setNumOSJobsInIteration(numToQueue);
+    }
+
+    if (dataPoints.empty()) {
+      // window is full--wait for a queued job to finish
+      return;
+    }
+
     // Handle queue pausing behavior.
     AnalysisRunOptions runOptions = currentAnalysis->runOptions();
     QueuePausingBehavior queuePausingBehavior = runOptions.queuePausingBehavior();
@@ -554,11 +569,6 @@ namespace detail {
       database().runManager().setPaused(true);
     }
 
-    // Set size of iteration if needed
-    if (currentAnalysis->numCompletedJobsInOSIteration() == currentAnalysis->totalNumJobsInOSIteration()) {
-      currentAnalysis->getImpl()->setNumOSJobsInIteration(dataPoints.size());
-    }
-
     {
       // Prepare to create workflows and queue jobs.
       DataPointVector nextBatch;
@@ -571,15 +581,10 @@ namespace detail {
       openstudio::path rubyIncludeDirectory = runOptions.rubyIncludeDirectory();
       std::vector<URLSearchPath> urlSearchPaths = runOptions.urlSearchPaths();
       bool force = runOptions.force();
-      OptionalInt queueSize = runOptions.queueSize();
 
       // Loop through DataPoints and queue jobs.
       BOOST_FOREACH(DataPoint& dataPoint, dataPoints) {
 
-        if (queueSize && (currentAnalysis->numQueuedJobs() + int(nextBatch.size()) >= *queueSize)) {
-          break;
-        }
-
         // create workflow
         runmanager::Workflow workflow = problem.createWorkflow(dataPoint,rubyIncludeDirectory);
         openstudio::runmanager::JobParams params;
@@ -105,7 +105,10 @@ class ANALYSISDRIVER_API AnalysisRunOptions {
 
   /** Returns the number of data points to queue at a time. This options is passed to Dakota as
    *  evaluation_concurrency  when using DakotaAlgorithms. Otherwise the queueSize() is directly
-   *  enforced by AnalysisDriver. */
+   *  enforced by AnalysisDriver as a window of in-flight data points: workflows and
+   *  runmanager::Jobs are only created for the data points that fit in the window, and more
+   *  are created as queued data points complete. Setting a queueSize is recommended for large
+   *  analyses, since it keeps the RunManager queue and database small. */
   boost::optional<int> queueSize() const;
 
   std::vector<openstudio::URLSearchPath> urlSearchPaths() const;
@@ -160,6 +160,9 @@ namespace detail {
   boost::optional<analysis::DataPoint> CurrentAnalysis_Impl::isQueuedOSDataPoint(
       const analysis::DataPoint& dataPoint) const
   {
+    if (m_queuedOSDataPointUUIDs.find(dataPoint.uuid()) == m_queuedOSDataPointUUIDs.end()) {
+      return boost::none;
+    }
     analysis::DataPointVector::const_iterator it = std::find_if(m_queuedOSDataPoints.begin(),
                                                                 m_queuedOSDataPoints.end(),
                                                                 boost::bind(dataPointsEqual,_1,dataPoint));
@@ -172,6 +175,9 @@ namespace detail {
   boost::optional<analysis::DataPoint> CurrentAnalysis_Impl::isQueuedDakotaDataPoint(
       const analysis::DataPoint& dataPoint) const
   {
+    if (m_queuedDakotaDataPointUUIDs.find(dataPoint.uuid()) == m_queuedDakotaDataPointUUIDs.end()) {
+      return boost::none;
+    }
     analysis::DataPointVector::const_iterator it = std::find_if(m_queuedDakotaDataPoints.begin(),
                                                                 m_queuedDakotaDataPoints.end(),
                                                                 boost::bind(dataPointsEqual,_1,dataPoint));
@@ -181,14 +187,24 @@ namespace detail {
     return boost::none;
   }
 
+  boost::optional<int> CurrentAnalysis_Impl::numAvailableQueueSlots() const {
+    boost::optional<int> queueSize = m_runOptions.queueSize();
+    if (!queueSize) {
+      return boost::none;
+    }
+    return std::max(*queueSize - numQueuedJobs(),0);
+  }
+
   void CurrentAnalysis_Impl::addNextBatchOSDataPoints(const std::vector<analysis::DataPoint>& nextBatchJobs) {
     BOOST_FOREACH(const analysis::DataPoint& nextJob,nextBatchJobs) {
       m_queuedOSDataPoints.push_back(nextJob);
+      m_queuedOSDataPointUUIDs.insert(nextJob.uuid());
     }
   }
 
   void CurrentAnalysis_Impl::addDakotaDataPoint(const analysis::DataPoint& newJob) {
     m_queuedDakotaDataPoints.push_back(newJob);
+    m_queuedDakotaDataPointUUIDs.insert(newJob.uuid());
   }
 
   void CurrentAnalysis_Impl::augmentQueuedDakotaDataPoint(const analysis::DataPoint& dataPoint,
@@ -211,6 +227,7 @@ namespace detail {
     BOOST_ASSERT(it != m_queuedOSDataPoints.end());
     analysis::DataPoint result = *it;
     m_queuedOSDataPoints.erase(it);
+    m_queuedOSDataPointUUIDs.erase(result.uuid());
     ++m_numOSJobsComplete;
     emit iterationProgress(numCompletedJobsInOSIteration(),totalNumJobsInOSIteration());
     return result;
@@ -223,6 +240,7 @@ namespace detail {
     BOOST_ASSERT(it != m_queuedDakotaDataPoints.end());
     analysis::DataPoint result = *it;
     m_queuedDakotaDataPoints.erase(it);
+    m_queuedDakotaDataPointUUIDs.erase(result.uuid());
     return result;
   }
 
@@ -265,6 +283,7 @@ namespace detail {
       }
     }
     m_queuedOSDataPoints.clear();
+    m_queuedOSDataPointUUIDs.clear();
 
     analysis::DataPointVector queuedDakotaDataPoints = m_queuedDakotaDataPoints;
     BOOST_FOREACH(const analysis::DataPoint& queuedDakotaDataPoint, queuedDakotaDataPoints) {
@@ -274,6 +293,7 @@ namespace detail {
       }
     }
     m_queuedDakotaDataPoints.clear();
+    m_queuedDakotaDataPointUUIDs.clear();
 
     cancelAllJobs(jobs);
 
@@ -299,6 +319,7 @@ namespace detail {
       }
       it = m_queuedDakotaDataPoints.erase(it);
     }
+    m_queuedDakotaDataPointUUIDs.clear();
 
     cancelAllJobs(jobs);
   }
@@ -321,6 +342,7 @@ namespace detail {
           recursivelyAddJobAndChildren(jobs, *job);
         }
         m_queuedOSDataPoints.erase(it);
+        m_queuedOSDataPointUUIDs.erase(exactDataPoint->uuid());
       }
 
       it = std::find_if(m_queuedDakotaDataPoints.begin(),
@@ -332,6 +354,7 @@ namespace detail {
           recursivelyAddJobAndChildren(jobs, *job);
         }
         m_queuedDakotaDataPoints.erase(it);
+        m_queuedDakotaDataPointUUIDs.erase(exactDataPoint->uuid());
       }
 
       cancelAllJobs(jobs);
@@ -32,6 +32,8 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
 
+#include <set>
+
 namespace openstudio {
 
 namespace runmanager {
@@ -141,6 +143,10 @@ namespace detail {
 
     boost::optional<analysis::DataPoint> isQueuedDakotaDataPoint(const analysis::DataPoint& dataPoint) const;
 
+    /** Returns the number of additional data points that may be queued before the
+     *  runOptions().queueSize() window is full. Returns boost::none if there is no window. */
+    boost::optional<int> numAvailableQueueSlots() const;
+
     void addNextBatchOSDataPoints(const std::vector<analysis::DataPoint>& nextBatchJobs);
 
     void addDakotaDataPoint(const analysis::DataPoint& newJob);
@@ -174,11 +180,13 @@ namespace detail {
     int m_numOSJobsInIteration;
     int m_numOSJobsComplete;
     std::vector<analysis::DataPoint> m_queuedOSDataPoints;
+    std::set<openstudio::UUID> m_queuedOSDataPointUUIDs;
 
     bool m_dakotaStarted;
     boost::optional<openstudio::UUID> m_dakotaJob;
     boost::optional<runmanager::JobErrors> m_dakotaJobErrors;
     std::vector<analysis::DataPoint> m_queuedDakotaDataPoints;
+    std::set<openstudio::UUID> m_queuedDakotaDataPointUUIDs;
   };
 
 } // detail
@@ -178,6 +178,57 @@ TEST_F(AnalysisDriverFixture,RuntimeBehavior_StopOpenStudioAnalysis) {
   EXPECT_EQ(0u,analysisDriver.currentAnalyses().size());
 }
 
+TEST_F(AnalysisDriverFixture,RuntimeBehavior_QueueSizeWindow) {
+  // RETRIEVE PROBLEM
+  Problem problem = retrieveProblem("UserScriptContinuous",true,false);
+
+  // DEFINE SEED
+  Model model = model::exampleModel();
+  openstudio::path p = toPath("./example.osm");
+  model.save(p,true);
+  FileReference seedModel(p);
+
+  // CREATE ANALYSIS
+  Analysis analysis("Queue Size Window",
+                    problem,
+                    seedModel);
+  InputVariableVector variables = problem.variables();
+  for (int i = 0, n = 20; i < n; ++i) {
+    std::vector<QVariant> values;
+    BOOST_FOREACH(const InputVariable& variable,variables) {
+      ContinuousVariable cvar = variable.cast<ContinuousVariable>();
+      double value = cvar.minimum().get() + (cvar.maximum().get() - cvar.minimum().get()) * double(i) / double(n);
+      values.push_back(value);
+    }
+    OptionalDataPoint dataPoint = problem.createDataPoint(values);
+    ASSERT_TRUE(dataPoint);
+    ASSERT_TRUE(analysis.addDataPoint(*dataPoint));
+  }
+
+  // RUN ANALYSIS
+  ProjectDatabase database = getCleanDatabase("QueueSizeWindow");
+  AnalysisDriver analysisDriver(database);
+  AnalysisRunOptions runOptions = standardRunOptions(analysisDriver.database().path().parent_path());
+  runOptions.setQueueSize(3);
+  CurrentAnalysis currentAnalysis = analysisDriver.run(analysis,runOptions);
+  EXPECT_EQ(3,currentAnalysis.numQueuedJobs());
+  EXPECT_EQ(20,currentAnalysis.totalNumJobsInOSIteration());
+
+  // workflows are only created for the data points in the window
+  unsigned numWithDirectory(0);
+  BOOST_FOREACH(const DataPoint& dataPoint,currentAnalysis.analysis().dataPoints()) {
+    if (!dataPoint.directory().empty()) {
+      ++numWithDirectory;
+    }
+  }
+  EXPECT_EQ(3u,numWithDirectory);
+
+  analysisDriver.waitForFinished();
+  EXPECT_FALSE(analysisDriver.isRunning());
+  EXPECT_EQ(20,currentAnalysis.numCompletedJobsInOSIteration());
+  EXPECT_TRUE(currentAnalysis.analysis().dataPointsToQueue().empty());
+}
+
 TEST_F(AnalysisDriverFixture,RuntimeBehavior_StopAndRestartCustomAnalysis) {
 }
 
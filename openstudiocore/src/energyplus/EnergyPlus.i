@@ -29,6 +29,7 @@
   #include <energyplus/ForwardTranslator.hpp>
   #include <energyplus/ReverseTranslator.hpp>
   #include <energyplus/ErrorFile.hpp>
+  #include <energyplus/EsoFile.hpp>
   
   using namespace openstudio;
   using namespace openstudio::model;
@@ -47,6 +48,10 @@
 %ignore openstudio::energyplus::detail::ForwardTranslatorInitializer;
 
 %include <energyplus/ErrorFile.hpp>
+// streams are not wrapped
+%ignore openstudio::energyplus::EsoFile::EsoFile(std::istream&);
+%ignore openstudio::energyplus::EsoFile::EsoFile(std::istream&, const std::vector<std::string>&);
+%include <energyplus/EsoFile.hpp>
 %include <energyplus/ForwardTranslator.hpp>
 %include <energyplus/ReverseTranslator.hpp>
 
@@ -25,15 +25,78 @@
 namespace openstudio {
 namespace energyplus {
 
+  namespace {
+
+    // matches[1], warning/error type
+    // matches[2], rest of line
+    const boost::regex warningOrError("^\\s*\\*\\*\\s*([^\\s\\*]+)\\s*\\*\\*(.*)$");
+
+    // matches[1], rest of line
+    const boost::regex warningOrErrorContinue("^\\s*\\*\\*\\s*~~~\\s*\\*\\*(.*)$");
+
+    // completed successfully
+    const boost::regex completedSuccessful("^\\s*\\*+ EnergyPlus Completed Successfully.*");
+
+    // ground temp completed successfully
+    const boost::regex groundTempCompletedSuccessful("^\\s*\\*+ GroundTempCalc\\S* Completed Successfully.*");
+
+    // completed unsuccessfully
+    const boost::regex completedUnsuccessful("^\\s*\\*+ EnergyPlus Terminated.*");
+
+  }
+
   /// constructor
   ErrorFile::ErrorFile(const openstudio::path& errPath)
-    : m_completed(false), m_completedSuccessfully(false)
+    : m_completed(false), m_completedSuccessfully(false), m_bytesRead(0), m_continuing(false)
   {
     boost::filesystem::ifstream ifs(errPath);
     parse(ifs);
     ifs.close();
   }
 
+  ErrorFile::ErrorFile()
+    : m_completed(false), m_completedSuccessfully(false), m_bytesRead(0), m_continuing(false)
+  {
+  }
+
+  bool ErrorFile::tail(const openstudio::path& errPath)
+  {
+    if (m_completed){
+      return false;
+    }
+
+    // binary so that the offset counts bytes on every platform
+    boost::filesystem::ifstream ifs(errPath, std::ios_base::in | std::ios_base::binary);
+    if (!ifs.is_open()){
+      return false;
+    }
+
+    ifs.seekg(m_bytesRead);
+    if (!ifs.good()){
+      return false;
+    }
+
+    bool result = false;
+    std::string line;
+    while (!m_completed && std::getline(ifs, line)){
+      if (ifs.eof()){
+        // no newline yet, EnergyPlus is still writing this line
+        break;
+      }
+
+      m_bytesRead += line.size() + 1;
+
+      if (!line.empty() && line[line.size() - 1] == '\r'){
+        line.erase(line.size() - 1);
+      }
+
+      parseLine(line);
+      result = true;
+    }
+
+    return result;
+  }
+
   /// get warnings
   std::vector<std::string> ErrorFile::warnings() const
   {
@@ -64,88 +127,82 @@ namespace energyplus {
     return m_completedSuccessfully;
   }
 
-  void ErrorFile::parse(boost::filesystem::ifstream& is)
+  void ErrorFile::parse(std::istream& is)
   {
     std::string line;
 
+    // read the file line by line using regexes
+    while(!m_completed && std::getline(is, line)){
+      parseLine(line);
+    }
+  }
 
-    // matches[1], warning/error type
-    // matches[2], rest of line
-    boost::regex warningOrError("^\\s*\\*\\*\\s*([^\\s\\*]+)\\s*\\*\\*(.*)$");
-
-    // matches[1], rest of line
-    boost::regex warningOrErrorContinue("^\\s*\\*\\*\\s*~~~\\s*\\*\\*(.*)$");
+  std::vector<std::string>* ErrorFile::messages(const ErrorLevel& level)
+  {
+    switch(level.value()){
+      case ErrorLevel::Warning:
+        return &m_warnings;
+      case ErrorLevel::Severe:
+        return &m_severeErrors;
+      case ErrorLevel::Fatal:
+        return &m_fatalErrors;
+    }
+    return 0;
+  }
 
-    // completed successfully
-    boost::regex completedSuccessful("^\\s*\\*+ EnergyPlus Completed Successfully.*");
+  void ErrorFile::parseLine(const std::string& line)
+  {
+    if (m_completed){
+      return;
+    }
 
-    // ground temp completed successfully
-    boost::regex groundTempCompletedSuccessful("^\\s*\\*+ GroundTempCalc\\S* Completed Successfully.*");
+    // every line of interest starts with '*', most lines can skip the regexes
+    std::string::size_type first = line.find_first_not_of(" \t");
+    if (first == std::string::npos || line[first] != '*'){
+      m_continuing = false;
+      return;
+    }
 
-    // completed unsuccessfully
-    boost::regex completedUnsuccessful("^\\s*\\*+ EnergyPlus Terminated.*");
+    boost::smatch matches;
 
+//    LOG(Debug, "Parsing ErrorFile Line: " << line);
 
-    // read the file line by line using regexes
-    while(std::getline(is, line)){
-
-      boost::smatch matches;
-
-//      LOG(Debug, "Parsing ErrorFile Line: " << line);
-
-
-      // parse the file
-      if (boost::regex_search(line, matches, warningOrError)){
-        std::string warningOrErrorType = std::string(matches[1].first, matches[1].second); boost::trim(warningOrErrorType);
-        std::string warningOrErrorString = std::string(matches[2].first, matches[2].second); boost::trim(warningOrErrorString);
-
-        // read the rest of the multi line warning or error
-        while(true){
-          std::streampos pos = is.tellg();
-          if (!std::getline(is, line)){
-            break;
-          }
-          if (boost::regex_search(line, matches, warningOrErrorContinue)){
-            std::string temp = std::string(matches[1].first, matches[1].second); boost::trim(temp);
-            warningOrErrorString += " " + temp;
-          }else{
-            // unget the line
-            is.seekg(pos);
-            break;
-          }
-        }
-
-        // correctly sort warnings and errors
-        try{
-          ErrorLevel level(warningOrErrorType);
-          switch(level.value()){
-            case ErrorLevel::Warning:
-              m_warnings.push_back(warningOrErrorString);
-              break;
-            case ErrorLevel::Severe:
-              m_severeErrors.push_back(warningOrErrorString);
-              break;
-            case ErrorLevel::Fatal:
-              m_fatalErrors.push_back(warningOrErrorString);
-              break;
-          }
-
-        }catch(...){
-          LOG(Error, "Unknown warning or error level '" << warningOrErrorType << "'");
-        }
-
-      }else if (boost::regex_match(line, completedSuccessful) 
-                || boost::regex_match(line, groundTempCompletedSuccessful)) {
-        m_completed = true;
-        m_completedSuccessfully = true;
-        break;
-      }else if (boost::regex_match(line, completedUnsuccessful)){
-        m_completed = true;
-        m_completedSuccessfully = false;
-        break;
+    // the rest of a multi line warning or error
+    if (m_continuing && boost::regex_search(line, matches, warningOrErrorContinue)){
+      if (m_lastLevel){
+        std::string temp = std::string(matches[1].first, matches[1].second); boost::trim(temp);
+        messages(*m_lastLevel)->back() += " " + temp;
       }
+      return;
     }
 
+    m_continuing = false;
+    m_lastLevel.reset();
+
+    // parse the file
+    if (boost::regex_search(line, matches, warningOrError)){
+      std::string warningOrErrorType = std::string(matches[1].first, matches[1].second); boost::trim(warningOrErrorType);
+      std::string warningOrErrorString = std::string(matches[2].first, matches[2].second); boost::trim(warningOrErrorString);
+
+      m_continuing = true;
+
+      // correctly sort warnings and errors
+      try{
+        ErrorLevel level(warningOrErrorType);
+        messages(level)->push_back(warningOrErrorString);
+        m_lastLevel = level;
+      }catch(...){
+        LOG(Error, "Unknown warning or error level '" << warningOrErrorType << "'");
+      }
+
+    }else if (boost::regex_match(line, completedSuccessful) 
+              || boost::regex_match(line, groundTempCompletedSuccessful)) {
+      m_completed = true;
+      m_completedSuccessfully = true;
+    }else if (boost::regex_match(line, completedUnsuccessful)){
+      m_completed = true;
+      m_completedSuccessfully = false;
+    }
   }
 
 } // energyplus
@@ -27,6 +27,8 @@
 #include <utilities/core/Logger.hpp>
 
 #include <boost/filesystem/fstream.hpp>
+#include <boost/optional.hpp>
+#include <istream>
 #include <string>
 #include <vector>
 
@@ -46,6 +48,13 @@ namespace energyplus {
     /// constructor
     ErrorFile(const openstudio::path& errPath);
 
+    /// constructs an empty ErrorFile to be filled by tail
+    ErrorFile();
+
+    /// parse the complete lines appended to errPath since the last call, used to follow the 
+    /// error file of a running simulation. Returns true if any new line was read.
+    bool tail(const openstudio::path& errPath);
+
     /// get warnings
     std::vector<std::string> warnings() const;
 
@@ -65,7 +74,11 @@ namespace energyplus {
 
     REGISTER_LOGGER("energyplus.ErrorFile");
 
-    void parse(boost::filesystem::ifstream& is);
+    void parse(std::istream& is);
+
+    void parseLine(const std::string& line);
+
+    std::vector<std::string>* messages(const ErrorLevel& level);
 
     std::vector<std::string> m_warnings;
     std::vector<std::string> m_severeErrors;
@@ -73,6 +86,11 @@ namespace energyplus {
     bool m_completed;
     bool m_completedSuccessfully;
 
+    // state kept between calls to tail
+    std::streamoff m_bytesRead;
+    bool m_continuing;
+    boost::optional<ErrorLevel> m_lastLevel;
+
   };
 
 } // energyplus
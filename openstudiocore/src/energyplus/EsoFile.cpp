@@ -0,0 +1,565 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <energyplus/EsoFile.hpp>
+
+#include <utilities/core/Assert.hpp>
+#include <utilities/core/Compare.hpp>
+#include <utilities/time/Date.hpp>
+#include <utilities/time/Time.hpp>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <set>
+
+namespace openstudio {
+namespace energyplus {
+
+  namespace {
+
+    const char columnFileMagic[] = "OSESOCOL";
+    const boost::uint32_t columnFileVersion = 1;
+
+    // returns the field after the next comma, or 0 if there is none
+    const char* nextField(const char* p)
+    {
+      p = std::strchr(p, ',');
+      return p ? p + 1 : 0;
+    }
+
+    boost::optional<ReportingFrequency> reportingFrequency(const std::string& text)
+    {
+      std::string frequency = boost::trim_copy(text.substr(0, text.find('[')));
+      boost::erase_all(frequency, " ");
+      if (istringEqual(frequency, "EachCall")){
+        return ReportingFrequency(ReportingFrequency::Detailed);
+      }else if (istringEqual(frequency, "TimeStep")){
+        return ReportingFrequency(ReportingFrequency::Timestep);
+      }else if (istringEqual(frequency, "Hourly")){
+        return ReportingFrequency(ReportingFrequency::Hourly);
+      }else if (istringEqual(frequency, "Daily")){
+        return ReportingFrequency(ReportingFrequency::Daily);
+      }else if (istringEqual(frequency, "Monthly")){
+        return ReportingFrequency(ReportingFrequency::Monthly);
+      }else if (istringEqual(frequency, "RunPeriod") || istringEqual(frequency, "Environment")){
+        return ReportingFrequency(ReportingFrequency::RunPeriod);
+      }
+      return boost::none;
+    }
+
+    template <typename T>
+    void writeValue(std::ostream& os, const T& value)
+    {
+      os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(std::istream& is, T& value)
+    {
+      is.read(reinterpret_cast<char*>(&value), sizeof(T));
+      return is.good();
+    }
+
+    void writeString(std::ostream& os, const std::string& value)
+    {
+      writeValue(os, static_cast<boost::uint32_t>(value.size()));
+      os.write(value.data(), value.size());
+    }
+
+    bool readString(std::istream& is, std::string& value)
+    {
+      boost::uint32_t size;
+      if (!readValue(is, size)){
+        return false;
+      }
+      value.resize(size);
+      if (size > 0){
+        is.read(&value[0], size);
+      }
+      return is.good();
+    }
+
+    void writeDoubles(std::ostream& os, const std::vector<double>& values)
+    {
+      if (!values.empty()){
+        os.write(reinterpret_cast<const char*>(&values[0]), values.size()*sizeof(double));
+      }
+    }
+
+    bool readDoubles(std::istream& is, std::vector<double>& values, boost::uint32_t size)
+    {
+      values.resize(size);
+      if (size > 0){
+        is.read(reinterpret_cast<char*>(&values[0]), size*sizeof(double));
+      }
+      return is.good();
+    }
+
+  }
+
+  EsoVariable::EsoVariable(int t_id, const std::string& t_keyValue, const std::string& t_name, 
+                           const std::string& t_units, const ReportingFrequency& t_reportingFrequency)
+    : id(t_id), keyValue(t_keyValue), name(t_name), units(t_units), reportingFrequency(t_reportingFrequency)
+  {}
+
+  EsoFile::EsoFile()
+    : m_completed(false)
+  {}
+
+  EsoFile::EsoFile(const openstudio::path& esoPath)
+    : m_completed(false)
+  {
+    boost::filesystem::ifstream ifs(esoPath);
+    parse(ifs, std::vector<std::string>());
+    ifs.close();
+  }
+
+  EsoFile::EsoFile(const openstudio::path& esoPath, const std::vector<std::string>& variableNames)
+    : m_completed(false)
+  {
+    boost::filesystem::ifstream ifs(esoPath);
+    parse(ifs, variableNames);
+    ifs.close();
+  }
+
+  EsoFile::EsoFile(std::istream& is, const std::vector<std::string>& variableNames)
+    : m_completed(false)
+  {
+    parse(is, variableNames);
+  }
+
+  bool EsoFile::completed() const
+  {
+    return m_completed;
+  }
+
+  std::vector<EsoVariable> EsoFile::variables() const
+  {
+    return m_variables;
+  }
+
+  std::vector<std::string> EsoFile::environments() const
+  {
+    std::vector<std::string> result;
+    for (std::vector<Environment>::const_iterator it = m_environments.begin(); it != m_environments.end(); ++it){
+      result.push_back(it->name);
+    }
+    return result;
+  }
+
+  boost::optional<TimeSeries> EsoFile::timeSeries(const std::string& environment, int id) const
+  {
+    const EsoVariable* esoVariable = variable(id);
+    if (!esoVariable){
+      return boost::none;
+    }
+
+    for (std::vector<Environment>::const_iterator it = m_environments.begin(); it != m_environments.end(); ++it){
+      if (istringEqual(it->name, environment)){
+        std::map<int, Column>::const_iterator columnIt = it->columns.find(id);
+        if (columnIt != it->columns.end() && !columnIt->second.values.empty()){
+          return TimeSeries(columnIt->second.firstReportDateTime, columnIt->second.daysFromFirstReport, 
+                            columnIt->second.values, esoVariable->units);
+        }
+      }
+    }
+
+    return boost::none;
+  }
+
+  boost::optional<TimeSeries> EsoFile::timeSeries(const std::string& environment, const std::string& keyValue, const std::string& name) const
+  {
+    for (std::vector<EsoVariable>::const_iterator it = m_variables.begin(); it != m_variables.end(); ++it){
+      if (istringEqual(it->keyValue, keyValue) && istringEqual(it->name, name)){
+        boost::optional<TimeSeries> result = timeSeries(environment, it->id);
+        if (result){
+          return result;
+        }
+      }
+    }
+    return boost::none;
+  }
+
+  bool EsoFile::saveColumns(const openstudio::path& columnPath) const
+  {
+    boost::filesystem::ofstream ofs(columnPath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!ofs.good()){
+      LOG(Error, "Unable to open column file '" << toString(columnPath) << "' for writing");
+      return false;
+    }
+
+    ofs.write(columnFileMagic, sizeof(columnFileMagic) - 1);
+    writeValue(ofs, columnFileVersion);
+    writeValue(ofs, static_cast<boost::uint32_t>(m_completed ? 1 : 0));
+
+    writeValue(ofs, static_cast<boost::uint32_t>(m_variables.size()));
+    for (std::vector<EsoVariable>::const_iterator it = m_variables.begin(); it != m_variables.end(); ++it){
+      writeValue(ofs, static_cast<boost::int32_t>(it->id));
+      writeString(ofs, it->keyValue);
+      writeString(ofs, it->name);
+      writeString(ofs, it->units);
+      writeValue(ofs, static_cast<boost::int32_t>(it->reportingFrequency.value()));
+    }
+
+    writeValue(ofs, static_cast<boost::uint32_t>(m_environments.size()));
+    for (std::vector<Environment>::const_iterator it = m_environments.begin(); it != m_environments.end(); ++it){
+      writeString(ofs, it->name);
+      writeValue(ofs, static_cast<boost::uint32_t>(it->columns.size()));
+      for (std::map<int, Column>::const_iterator columnIt = it->columns.begin(); columnIt != it->columns.end(); ++columnIt){
+        const Column& column = columnIt->second;
+        Date date = column.firstReportDateTime.date();
+        writeValue(ofs, static_cast<boost::int32_t>(columnIt->first));
+        writeValue(ofs, static_cast<boost::int32_t>(date.year()));
+        writeValue(ofs, static_cast<boost::int32_t>(month(date.monthOfYear())));
+        writeValue(ofs, static_cast<boost::int32_t>(date.dayOfMonth()));
+        writeValue(ofs, column.firstReportDateTime.time().totalDays());
+        writeValue(ofs, static_cast<boost::uint32_t>(column.values.size()));
+        writeDoubles(ofs, column.daysFromFirstReport);
+        writeDoubles(ofs, column.values);
+      }
+    }
+
+    bool result = ofs.good();
+    ofs.close();
+    return result;
+  }
+
+  boost::optional<EsoFile> EsoFile::loadColumns(const openstudio::path& columnPath)
+  {
+    boost::filesystem::ifstream ifs(columnPath, std::ios_base::in | std::ios_base::binary);
+
+    char magic[sizeof(columnFileMagic) - 1];
+    ifs.read(magic, sizeof(magic));
+    boost::uint32_t version;
+    if (!ifs.good() || std::memcmp(magic, columnFileMagic, sizeof(magic)) != 0 || 
+        !readValue(ifs, version) || version != columnFileVersion)
+    {
+      LOG(Error, "'" << toString(columnPath) << "' is not an ESO column file");
+      return boost::none;
+    }
+
+    EsoFile result;
+
+    boost::uint32_t completed, numVariables;
+    if (!readValue(ifs, completed) || !readValue(ifs, numVariables)){
+      return boost::none;
+    }
+    result.m_completed = (completed != 0);
+
+    for (boost::uint32_t i = 0; i < numVariables; ++i){
+      boost::int32_t id, frequency;
+      std::string keyValue, name, units;
+      if (!readValue(ifs, id) || !readString(ifs, keyValue) || !readString(ifs, name) || 
+          !readString(ifs, units) || !readValue(ifs, frequency))
+      {
+        LOG(Error, "Column file '" << toString(columnPath) << "' is truncated");
+        return boost::none;
+      }
+      result.m_variableIndices[id] = result.m_variables.size();
+      result.m_variables.push_back(EsoVariable(id, keyValue, name, units, ReportingFrequency(frequency)));
+    }
+
+    boost::uint32_t numEnvironments;
+    if (!readValue(ifs, numEnvironments)){
+      return boost::none;
+    }
+
+    for (boost::uint32_t i = 0; i < numEnvironments; ++i){
+      result.m_environments.push_back(Environment());
+      Environment& environment = result.m_environments.back();
+
+      boost::uint32_t numColumns;
+      if (!readString(ifs, environment.name) || !readValue(ifs, numColumns)){
+        LOG(Error, "Column file '" << toString(columnPath) << "' is truncated");
+        return boost::none;
+      }
+
+      for (boost::uint32_t j = 0; j < numColumns; ++j){
+        boost::int32_t id, year, monthNumber, day;
+        double time;
+        boost::uint32_t size;
+        if (!readValue(ifs, id) || !readValue(ifs, year) || !readValue(ifs, monthNumber) || 
+            !readValue(ifs, day) || !readValue(ifs, time) || !readValue(ifs, size))
+        {
+          LOG(Error, "Column file '" << toString(columnPath) << "' is truncated");
+          return boost::none;
+        }
+
+        Column& column = environment.columns[id];
+        column.firstReportDateTime = DateTime(Date(monthOfYear(monthNumber), day, year), Time(time));
+        if (!readDoubles(ifs, column.daysFromFirstReport, size) || !readDoubles(ifs, column.values, size)){
+          LOG(Error, "Column file '" << toString(columnPath) << "' is truncated");
+          return boost::none;
+        }
+      }
+    }
+
+    return result;
+  }
+
+  const EsoVariable* EsoFile::variable(int id) const
+  {
+    std::map<int, unsigned>::const_iterator it = m_variableIndices.find(id);
+    if (it == m_variableIndices.end()){
+      return 0;
+    }
+    return &m_variables[it->second];
+  }
+
+  void EsoFile::parse(std::istream& is, const std::vector<std::string>& variableNames)
+  {
+    std::set<std::string> filter;
+    for (std::vector<std::string>::const_iterator it = variableNames.begin(); it != variableNames.end(); ++it){
+      filter.insert(boost::to_lower_copy(boost::trim_copy(*it)));
+    }
+
+    // kept[id] is true if values of report variable id are stored
+    std::vector<bool> kept;
+
+    std::string line;
+
+    // program version
+    std::getline(is, line);
+    if (!boost::starts_with(line, "Program Version")){
+      LOG(Error, "Stream is not an EnergyPlus ESO or MTR file");
+      return;
+    }
+
+    // data dictionary, ids 1 through 6 are record formats written by every run
+    bool dictionaryEnd = false;
+    while (std::getline(is, line)){
+      boost::trim_right(line);
+      if (boost::starts_with(line, "End of Data Dictionary")){
+        dictionaryEnd = true;
+        break;
+      }
+
+      const char* p = line.c_str();
+      char* end;
+      int id = static_cast<int>(std::strtol(p, &end, 10));
+      if (end == p || id <= 6){
+        continue;
+      }
+
+      // skip the number of values written per record
+      p = nextField(end);
+      p = p ? nextField(p) : 0;
+      if (!p){
+        LOG(Warn, "Skipping malformed data dictionary line '" << line << "'");
+        continue;
+      }
+
+      std::string text(p);
+      std::string::size_type bang = text.find('!');
+      if (bang == std::string::npos){
+        LOG(Warn, "Skipping data dictionary line without reporting frequency '" << line << "'");
+        continue;
+      }
+
+      boost::optional<ReportingFrequency> frequency = reportingFrequency(text.substr(bang + 1));
+      if (!frequency){
+        LOG(Warn, "Unknown reporting frequency in data dictionary line '" << line << "'");
+        continue;
+      }
+
+      std::string keyValue;
+      std::string nameAndUnits = text.substr(0, bang);
+      std::string::size_type comma = nameAndUnits.rfind(',');
+      if (comma != std::string::npos){
+        keyValue = boost::trim_copy(nameAndUnits.substr(0, comma));
+        nameAndUnits = nameAndUnits.substr(comma + 1);
+      }
+
+      std::string name = nameAndUnits;
+      std::string units;
+      std::string::size_type open = nameAndUnits.rfind('[');
+      if (open != std::string::npos){
+        std::string::size_type close = nameAndUnits.find(']', open);
+        name = nameAndUnits.substr(0, open);
+        units = nameAndUnits.substr(open + 1, close == std::string::npos ? std::string::npos : close - open - 1);
+      }
+      boost::trim(name);
+      boost::trim(units);
+
+      if (!filter.empty() && filter.find(boost::to_lower_copy(name)) == filter.end()){
+        continue;
+      }
+
+      if (kept.size() <= static_cast<unsigned>(id)){
+        kept.resize(id + 1, false);
+      }
+      kept[id] = true;
+      m_variableIndices[id] = m_variables.size();
+      m_variables.push_back(EsoVariable(id, keyValue, name, units, *frequency));
+    }
+
+    if (!dictionaryEnd){
+      LOG(Error, "ESO or MTR file ended inside the data dictionary");
+      return;
+    }
+
+    // columns of the current environment indexed by id, map nodes are stable
+    std::vector<Column*> columns;
+    // days from reference of the first report of each column
+    std::vector<double> columnStarts;
+    // start of the current environment, report times are kept as days from this
+    boost::optional<DateTime> reference;
+    // days from reference of the current record
+    double currentDays = 0.0;
+    // EnergyPlus dates carry no year, use the same assumed year as Date
+    const int assumedYear = YearDescription().assumedYear();
+    int year = assumedYear;
+    unsigned lastMonth = 0;
+
+    while (std::getline(is, line)){
+      const char* p = line.c_str();
+      char* end;
+      int id = static_cast<int>(std::strtol(p, &end, 10));
+      if (end == p){
+        if (boost::starts_with(line, "End of Data")){
+          m_completed = true;
+          break;
+        }
+        continue;
+      }
+
+      if (id > 6){
+        if (static_cast<unsigned>(id) < kept.size() && kept[id] && reference){
+          p = nextField(end);
+          if (!p){
+            continue;
+          }
+          double value = std::strtod(p, &end);
+
+          Column*& column = columns[id];
+          if (!column){
+            column = &m_environments.back().columns[id];
+            column->firstReportDateTime = *reference + Time(currentDays);
+            columnStarts[id] = currentDays;
+          }
+          column->daysFromFirstReport.push_back(currentDays - columnStarts[id]);
+          column->values.push_back(value);
+        }
+        continue;
+      }
+
+      std::vector<long> fields;
+      for (p = nextField(end); p; p = nextField(p)){
+        fields.push_back(std::strtol(p, &end, 10));
+      }
+
+      if (id == 1){
+        std::string name;
+        std::string::size_type begin = line.find(',');
+        if (begin != std::string::npos){
+          std::string::size_type finish = line.find(',', begin + 1);
+          name = boost::trim_copy(line.substr(begin + 1, finish == std::string::npos ? std::string::npos : finish - begin - 1));
+        }
+        m_environments.push_back(Environment());
+        m_environments.back().name = name;
+        columns.assign(kept.size(), 0);
+        columnStarts.assign(kept.size(), 0.0);
+        reference = boost::none;
+        currentDays = 0.0;
+        year = assumedYear;
+        lastMonth = 0;
+        continue;
+      }
+
+      // time stamps and values are only valid within an environment
+      if (m_environments.empty() && id >= 2 && id <= 5){
+        LOG_AND_THROW("Time stamp before the first environment in ESO or MTR file '" << line << "'");
+      }
+
+      // time stamps, fields are [cumulative day, month, ...]
+      unsigned monthNumber = 0;
+      unsigned day = 1;
+      double fracDays = 0.0;
+      if (id == 2 && fields.size() >= 7){
+        // day, month, day of month, dst, hour, start minute, end minute
+        monthNumber = fields[1];
+        day = fields[2];
+        p = line.c_str();
+        for (unsigned i = 0; i < 7 && p; ++i){
+          p = nextField(p);
+        }
+        double endMinute = p ? std::strtod(p, 0) : 60.0;
+        fracDays = (fields[4] - 1) / 24.0 + endMinute / 1440.0;
+      }else if (id == 3 && fields.size() >= 3){
+        // values cover the whole day
+        monthNumber = fields[1];
+        day = fields[2];
+        fracDays = 1.0;
+      }else if (id == 4 && fields.size() >= 2){
+        // values cover the whole month, ending at midnight of its last day
+        monthNumber = fields[1];
+        day = 1;
+        fracDays = 0.0;
+        if (monthNumber >= 1 && monthNumber <= 12){
+          if (monthNumber < lastMonth){
+            ++year;
+          }
+          lastMonth = monthNumber;
+          DateTime endOfMonth = (monthNumber == 12) ? 
+            DateTime(Date(monthOfYear(12), 31, year), Time(1.0)) : 
+            DateTime(Date(monthOfYear(monthNumber + 1), 1, year));
+          if (!reference){
+            reference = DateTime(Date(monthOfYear(monthNumber), 1, year));
+          }
+          currentDays = (endOfMonth - *reference).totalDays();
+        }
+        continue;
+      }else if (id == 5){
+        // run period values are reported with the last time stamp, or the cumulative days if there is none
+        if (!reference && !fields.empty()){
+          reference = DateTime(Date(monthOfYear(1), 1, year));
+          currentDays = static_cast<double>(fields[0]);
+        }
+        continue;
+      }else{
+        continue;
+      }
+
+      if (monthNumber < 1 || monthNumber > 12){
+        LOG(Warn, "Skipping time stamp with invalid month '" << line << "'");
+        continue;
+      }
+      if (monthNumber < lastMonth){
+        ++year;
+      }
+      lastMonth = monthNumber;
+
+      DateTime date(Date(monthOfYear(monthNumber), day, year));
+      if (!reference){
+        reference = date;
+      }
+      currentDays = (date - *reference).totalDays() + fracDays;
+    }
+
+    if (!m_completed){
+      LOG(Warn, "ESO or MTR file did not end with 'End of Data'");
+    }
+  }
+
+} // energyplus
+} // openstudio
@@ -0,0 +1,123 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef ENERGYPLUS_ESOFILE_HPP
+#define ENERGYPLUS_ESOFILE_HPP
+
+#include "EnergyPlusAPI.hpp"
+
+#include <utilities/core/Path.hpp>
+#include <utilities/core/Logger.hpp>
+#include <utilities/data/TimeSeries.hpp>
+#include <utilities/sql/SqlFileEnums.hpp>
+#include <utilities/time/DateTime.hpp>
+
+#include <boost/optional.hpp>
+
+#include <istream>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace openstudio {
+namespace energyplus {
+
+  /** EsoVariable is one entry of the data dictionary of an EnergyPlus ESO or MTR file. Meters 
+   *  have an empty keyValue. */
+  struct ENERGYPLUS_API EsoVariable {
+
+    EsoVariable(int t_id, const std::string& t_keyValue, const std::string& t_name, 
+                const std::string& t_units, const ReportingFrequency& t_reportingFrequency);
+
+    int id;
+    std::string keyValue;
+    std::string name;
+    std::string units;
+    ReportingFrequency reportingFrequency;
+  };
+
+  /** EsoFile reads an EnergyPlus ESO or MTR file in a single pass, without ReadVarsESO or an 
+   *  intermediate CSV file. Values are appended to one column per variable and environment as 
+   *  the records are read, so only the variables that are kept are held in memory. Columns can 
+   *  be returned as TimeSeries or saved to and loaded from a compact binary column file. */
+  class ENERGYPLUS_API EsoFile {
+   public:
+
+    /// parse esoPath keeping all variables, throws if a time stamp precedes the first environment
+    EsoFile(const openstudio::path& esoPath);
+
+    /// parse esoPath keeping only variables (or meters) named in variableNames, compared case 
+    /// insensitively; all variables are kept if variableNames is empty, throws like the above
+    EsoFile(const openstudio::path& esoPath, const std::vector<std::string>& variableNames);
+
+    /// parse an ESO or MTR stream, throws if a time stamp precedes the first environment
+    EsoFile(std::istream& is, const std::vector<std::string>& variableNames = std::vector<std::string>());
+
+    /// load a file written by saveColumns, returns none if it can not be read
+    static boost::optional<EsoFile> loadColumns(const openstudio::path& columnPath);
+
+    /// did the file end with "End of Data"
+    bool completed() const;
+
+    /// variables that were kept, in data dictionary order
+    std::vector<EsoVariable> variables() const;
+
+    /// environment titles in the order they were simulated
+    std::vector<std::string> environments() const;
+
+    /// values of variable id in environment
+    boost::optional<TimeSeries> timeSeries(const std::string& environment, int id) const;
+
+    /// values of the variable with keyValue and name in environment, keyValue is empty for meters
+    boost::optional<TimeSeries> timeSeries(const std::string& environment, const std::string& keyValue, const std::string& name) const;
+
+    /// write kept variables and their values to a binary column file
+    bool saveColumns(const openstudio::path& columnPath) const;
+
+   private:
+
+    REGISTER_LOGGER("energyplus.EsoFile");
+
+    EsoFile();
+
+    struct Column {
+      DateTime firstReportDateTime;
+      std::vector<double> daysFromFirstReport;
+      std::vector<double> values;
+    };
+
+    struct Environment {
+      std::string name;
+      std::map<int, Column> columns;
+    };
+
+    void parse(std::istream& is, const std::vector<std::string>& variableNames);
+
+    const EsoVariable* variable(int id) const;
+
+    std::vector<EsoVariable> m_variables;
+    std::map<int, unsigned> m_variableIndices;
+    std::vector<Environment> m_environments;
+    bool m_completed;
+  };
+
+} // energyplus
+} // openstudio
+
+#endif // ENERGYPLUS_ESOFILE_HPP
@@ -34,6 +34,7 @@
 #include <model/Building.hpp>
 #include <model/Building_Impl.hpp>
 #include <model/ConcreteModelObjects.hpp>
+#include <model/InheritedDefaults.hpp>
 
 #include <utilities/idf/Workspace.hpp>
 #include <utilities/idf/IdfExtensibleGroup.hpp>
@@ -1716,6 +1717,9 @@ void ForwardTranslator::resolveMatchedSurfaceConstructionConflicts(model::Model&
 
   std::set<Handle> processedSurfaces;
 
+  // resolve defaults against the model as it is before any constructions are hard set below
+  model::InheritedDefaults inheritedDefaults(model);
+
   model::SurfaceVector surfaces = model.getModelObjects<model::Surface>();
   BOOST_FOREACH(model::Surface surface, surfaces){
 
@@ -1729,8 +1733,8 @@ void ForwardTranslator::resolveMatchedSurfaceConstructionConflicts(model::Model&
       continue;
     }
 
-    boost::optional<std::pair<model::ConstructionBase, int> > constructionWithSearchDistance = surface.constructionWithSearchDistance();
-    boost::optional<std::pair<model::ConstructionBase, int> > adjacentConstructionWithSearchDistance = adjacentSurface->constructionWithSearchDistance();
+    boost::optional<std::pair<model::ConstructionBase, int> > constructionWithSearchDistance = inheritedDefaults.constructionWithSearchDistance(surface);
+    boost::optional<std::pair<model::ConstructionBase, int> > adjacentConstructionWithSearchDistance = inheritedDefaults.constructionWithSearchDistance(*adjacentSurface);
 
     if (constructionWithSearchDistance && !adjacentConstructionWithSearchDistance){
 
@@ -1857,6 +1861,9 @@ void ForwardTranslator::resolveMatchedSubSurfaceConstructionConflicts(model::Mod
 
   std::set<Handle> processedSubSurfaces;
 
+  // resolve defaults against the model as it is before any constructions are hard set below
+  model::InheritedDefaults inheritedDefaults(model);
+
   model::SubSurfaceVector subSurfaces = model.getModelObjects<model::SubSurface>();
   BOOST_FOREACH(model::SubSurface subSurface, subSurfaces){
 
@@ -1870,8 +1877,8 @@ void ForwardTranslator::resolveMatchedSubSurfaceConstructionConflicts(model::Mod
       continue;
     }
 
-    boost::optional<std::pair<model::ConstructionBase, int> > constructionWithSearchDistance = subSurface.constructionWithSearchDistance();
-    boost::optional<std::pair<model::ConstructionBase, int> > adjacentConstructionWithSearchDistance = adjacentSubSurface->constructionWithSearchDistance();
+    boost::optional<std::pair<model::ConstructionBase, int> > constructionWithSearchDistance = inheritedDefaults.constructionWithSearchDistance(subSurface);
+    boost::optional<std::pair<model::ConstructionBase, int> > adjacentConstructionWithSearchDistance = inheritedDefaults.constructionWithSearchDistance(*adjacentSubSurface);
 
     if (constructionWithSearchDistance && !adjacentConstructionWithSearchDistance){
 
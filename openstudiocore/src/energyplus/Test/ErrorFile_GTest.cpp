@@ -26,6 +26,8 @@
 
 #include <resources.hxx>
 
+#include <boost/filesystem/fstream.hpp>
+
 #include <sstream>
 
 using openstudio::energyplus::ErrorFile;
@@ -103,3 +105,48 @@ TEST_F(EnergyPlusFixture,ErrorFile_WarningsAndCrash)
   EXPECT_FALSE(errorFile.completed());
   EXPECT_FALSE(errorFile.completedSuccessfully());
 }
+
+TEST_F(EnergyPlusFixture,ErrorFile_Tail)
+{
+  openstudio::path path = openstudio::toPath("ErrorFile_Tail.err");
+
+  {
+    boost::filesystem::ofstream ofs(path, std::ios_base::out | std::ios_base::trunc);
+    ofs << "Program Version,EnergyPlus-Windows-32 8.0.0.008, YMD=2013.06.13 10:12,IDD_Version 8.0.0.008\n"
+        << "   ** Warning ** Weather file location will be used rather than entered Location object.\n"
+        << "   **   ~~~   ** ..Location object=USA CO-BOULDER\n"
+        << "   ** Severe  ** Node connection er";
+  }
+
+  ErrorFile errorFile;
+  EXPECT_TRUE(errorFile.tail(path));
+  ASSERT_EQ(static_cast<unsigned>(1), errorFile.warnings().size());
+  EXPECT_EQ("Weather file location will be used rather than entered Location object. ..Location object=USA CO-BOULDER",
+            errorFile.warnings()[0]);
+  // the severe error is not complete yet
+  EXPECT_EQ(static_cast<unsigned>(0), errorFile.severeErrors().size());
+  EXPECT_FALSE(errorFile.completed());
+  EXPECT_FALSE(errorFile.tail(path));
+
+  {
+    boost::filesystem::ofstream ofs(path, std::ios_base::out | std::ios_base::app);
+    ofs << "ror\n"
+        << "   **   ~~~   ** Node=AIR LOOP OUTLET\n"
+        << "   **  Fatal  ** Preceding conditions cause termination.\n"
+        << "   ************* EnergyPlus Terminated--Fatal Error Detected. 1 Warning; 1 Severe Errors; Elapsed Time=00hr 00min  1.00sec\n";
+  }
+
+  EXPECT_TRUE(errorFile.tail(path));
+  ASSERT_EQ(static_cast<unsigned>(1), errorFile.severeErrors().size());
+  EXPECT_EQ("Node connection error Node=AIR LOOP OUTLET", errorFile.severeErrors()[0]);
+  ASSERT_EQ(static_cast<unsigned>(1), errorFile.fatalErrors().size());
+  EXPECT_TRUE(errorFile.completed());
+  EXPECT_FALSE(errorFile.completedSuccessfully());
+
+  // a complete parse gives the same result
+  ErrorFile complete(path);
+  EXPECT_EQ(errorFile.warnings(), complete.warnings());
+  EXPECT_EQ(errorFile.severeErrors(), complete.severeErrors());
+  EXPECT_EQ(errorFile.fatalErrors(), complete.fatalErrors());
+  EXPECT_EQ(errorFile.completed(), complete.completed());
+}
@@ -0,0 +1,181 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+#include <energyplus/Test/EnergyPlusFixture.hpp>
+
+#include <energyplus/EsoFile.hpp>
+
+#include <utilities/core/Path.hpp>
+#include <utilities/data/TimeSeries.hpp>
+#include <utilities/time/Date.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <sstream>
+
+using openstudio::energyplus::EsoFile;
+using openstudio::energyplus::EsoVariable;
+
+namespace {
+
+  std::string esoText()
+  {
+    std::stringstream ss;
+    ss << "Program Version,EnergyPlus-Windows-32 7.2.0.006, YMD=2013.01.14 10:12\n"
+       << "1,5,Environment Title[],Latitude[deg],Longitude[deg],Time Zone[],Elevation[m]\n"
+       << "2,8,Day of Simulation[],Month[],Day of Month[],DST Indicator[1=yes 0=no],Hour[],StartMinute[],EndMinute[],DayType\n"
+       << "3,5,Cumulative Day of Simulation[],Month[],Day of Month[],DST Indicator[1=yes 0=no],DayType  ! When Daily Report Variables Requested\n"
+       << "4,2,Cumulative Days of Simulation[],Month[]  ! When Monthly Report Variables Requested\n"
+       << "5,1,Cumulative Days of Simulation[] ! When Run Period Report Variables Requested\n"
+       << "7,1,Environment,Site Outdoor Air Drybulb Temperature [C] !Hourly\n"
+       << "8,1,ZONE ONE,Zone Mean Air Temperature [C] !Hourly\n"
+       << "9,7,ZONE ONE,Zone Air System Sensible Heating Energy [J] !Daily [Value,Min,Hour,Minute,Max,Hour,Minute]\n"
+       << "End of Data Dictionary\n"
+       << "1,CHICAGO ANN HTG 99% CONDNS DB,  41.98, -87.92,  -6.00, 190.00\n"
+       << "2,1, 1,21, 0, 1, 0.00,60.00,WinterDesignDay\n"
+       << "7,-17.3\n"
+       << "8,21.5\n"
+       << "2,1, 1,21, 0, 2, 0.00,60.00,WinterDesignDay\n"
+       << "7,-17.3\n"
+       << "8,21.0\n"
+       << "3,1, 1,21, 0,WinterDesignDay\n"
+       << "9,1000.0,10.0, 1,60,100.0, 2,60\n"
+       << "1,CHICAGO ANN CLG 1% CONDNS DB=>MWB,  41.98, -87.92,  -6.00, 190.00\n"
+       << "2,2, 7,21, 0, 1, 0.00,60.00,SummerDesignDay\n"
+       << "7,22.8\n"
+       << "8,23.0\n"
+       << "End of Data\n"
+       << "Number of Records Written=    12\n";
+    return ss.str();
+  }
+
+}
+
+TEST_F(EnergyPlusFixture,EsoFile_Parse)
+{
+  std::stringstream ss(esoText());
+  EsoFile esoFile(ss);
+
+  EXPECT_TRUE(esoFile.completed());
+
+  std::vector<EsoVariable> variables = esoFile.variables();
+  ASSERT_EQ(3u, variables.size());
+  EXPECT_EQ(7, variables[0].id);
+  EXPECT_EQ("Environment", variables[0].keyValue);
+  EXPECT_EQ("Site Outdoor Air Drybulb Temperature", variables[0].name);
+  EXPECT_EQ("C", variables[0].units);
+  EXPECT_EQ(openstudio::ReportingFrequency::Hourly, variables[0].reportingFrequency.value());
+  EXPECT_EQ(openstudio::ReportingFrequency::Daily, variables[2].reportingFrequency.value());
+
+  std::vector<std::string> environments = esoFile.environments();
+  ASSERT_EQ(2u, environments.size());
+  EXPECT_EQ("CHICAGO ANN HTG 99% CONDNS DB", environments[0]);
+
+  boost::optional<openstudio::TimeSeries> ts = esoFile.timeSeries(environments[0], "ZONE ONE", "Zone Mean Air Temperature");
+  ASSERT_TRUE(ts);
+  ASSERT_EQ(2u, ts->values().size());
+  EXPECT_DOUBLE_EQ(21.5, ts->values()[0]);
+  EXPECT_DOUBLE_EQ(21.0, ts->values()[1]);
+  EXPECT_EQ("C", ts->units());
+  EXPECT_EQ(openstudio::DateTime(openstudio::Date(openstudio::MonthOfYear::Jan, 21), openstudio::Time(0, 1)), ts->firstReportDateTime());
+  EXPECT_NEAR(1.0/24.0, ts->daysFromFirstReport()[1], 1.0e-8);
+
+  ts = esoFile.timeSeries(environments[0], "ZONE ONE", "Zone Air System Sensible Heating Energy");
+  ASSERT_TRUE(ts);
+  ASSERT_EQ(1u, ts->values().size());
+  EXPECT_DOUBLE_EQ(1000.0, ts->values()[0]);
+  EXPECT_EQ(openstudio::DateTime(openstudio::Date(openstudio::MonthOfYear::Jan, 22)), ts->firstReportDateTime());
+
+  ts = esoFile.timeSeries(environments[1], "Environment", "Site Outdoor Air Drybulb Temperature");
+  ASSERT_TRUE(ts);
+  ASSERT_EQ(1u, ts->values().size());
+  EXPECT_DOUBLE_EQ(22.8, ts->values()[0]);
+
+  EXPECT_FALSE(esoFile.timeSeries(environments[1], "ZONE ONE", "Zone Air System Sensible Heating Energy"));
+}
+
+TEST_F(EnergyPlusFixture,EsoFile_Filter)
+{
+  std::vector<std::string> variableNames;
+  variableNames.push_back("zone mean air temperature");
+
+  std::stringstream ss(esoText());
+  EsoFile esoFile(ss, variableNames);
+
+  EXPECT_TRUE(esoFile.completed());
+  ASSERT_EQ(1u, esoFile.variables().size());
+  EXPECT_EQ(8, esoFile.variables()[0].id);
+  EXPECT_TRUE(esoFile.timeSeries("CHICAGO ANN HTG 99% CONDNS DB", 8));
+  EXPECT_FALSE(esoFile.timeSeries("CHICAGO ANN HTG 99% CONDNS DB", 7));
+}
+
+TEST_F(EnergyPlusFixture,EsoFile_Incomplete)
+{
+  std::string text = esoText();
+  text = text.substr(0, text.find("End of Data\n"));
+
+  std::stringstream ss(text);
+  EsoFile esoFile(ss);
+  EXPECT_FALSE(esoFile.completed());
+  EXPECT_EQ(2u, esoFile.environments().size());
+}
+
+TEST_F(EnergyPlusFixture,EsoFile_TimeStampBeforeEnvironment)
+{
+  std::string text = esoText();
+  std::string environment = "1,CHICAGO ANN HTG 99% CONDNS DB,  41.98, -87.92,  -6.00, 190.00\n";
+  text.erase(text.find(environment), environment.size());
+
+  std::stringstream ss(text);
+  EXPECT_THROW(EsoFile esoFile(ss), std::exception);
+}
+
+TEST_F(EnergyPlusFixture,EsoFile_Columns)
+{
+  std::stringstream ss(esoText());
+  EsoFile esoFile(ss);
+
+  openstudio::path columnDir = openstudio::tempDir() / openstudio::toPath("EsoFile_Columns");
+  boost::filesystem::remove_all(columnDir);
+  boost::filesystem::create_directories(columnDir);
+  openstudio::path columnPath = columnDir / openstudio::toPath("EsoFile_Columns.esocol");
+  ASSERT_TRUE(esoFile.saveColumns(columnPath));
+
+  boost::optional<EsoFile> loaded = EsoFile::loadColumns(columnPath);
+  ASSERT_TRUE(loaded);
+  EXPECT_TRUE(loaded->completed());
+  EXPECT_EQ(esoFile.variables().size(), loaded->variables().size());
+  EXPECT_EQ(esoFile.environments(), loaded->environments());
+
+  boost::optional<openstudio::TimeSeries> expected = esoFile.timeSeries("CHICAGO ANN HTG 99% CONDNS DB", 8);
+  boost::optional<openstudio::TimeSeries> actual = loaded->timeSeries("CHICAGO ANN HTG 99% CONDNS DB", 8);
+  ASSERT_TRUE(expected);
+  ASSERT_TRUE(actual);
+  EXPECT_EQ(expected->firstReportDateTime(), actual->firstReportDateTime());
+  ASSERT_EQ(expected->values().size(), actual->values().size());
+  for (unsigned i = 0; i < expected->values().size(); ++i){
+    EXPECT_DOUBLE_EQ(expected->values()[i], actual->values()[i]);
+    EXPECT_DOUBLE_EQ(expected->daysFromFirstReport()[i], actual->daysFromFirstReport()[i]);
+  }
+
+  EXPECT_FALSE(EsoFile::loadColumns(columnDir / openstudio::toPath("EsoFile_Missing.esocol")));
+
+  boost::filesystem::remove_all(columnDir);
+}
@@ -40,6 +40,7 @@
 #include <model/ShadingSurfaceGroup_Impl.hpp>
 
 #include <utilities/core/Assert.hpp>
+#include <utilities/core/XMLFragmentReader.hpp>
 #include <utilities/units/UnitFactory.hpp>
 #include <utilities/units/QuantityConverter.hpp>
 #include <utilities/plot/ProgressBar.hpp>
@@ -47,6 +48,7 @@
 #include <QFile>
 #include <QDomDocument>
 #include <QDomElement>
+#include <QStringList>
 #include <QThread>
 
 namespace openstudio {
@@ -84,15 +86,7 @@ namespace gbxml {
     boost::optional<openstudio::model::Model> result;
 
     if (boost::filesystem::exists(path)){
-
-      QFile file(toQString(path));
-      if (file.open(QFile::ReadOnly)){
-        QDomDocument doc;
-        doc.setContent(&file);
-        file.close();
-
-        result = this->convert(doc);
-      }
+      result = this->convert(path);
     }
 
     return result;
@@ -130,16 +124,163 @@ namespace gbxml {
     return name.replace(',', '-').replace(';', '-').toStdString();
   }
 
-  boost::optional<model::Model> ReverseTranslator::convert(const QDomDocument& doc)
+  boost::optional<model::Model> ReverseTranslator::convert(const openstudio::path& path)
   {
-    return translateGBXML(doc.documentElement(), doc);
-  }
+    XMLFragmentReader reader(path);
+
+    QDomDocument rootDoc = reader.readNextElement(QStringList(), QStringList() << "gbXML");
+    if (rootDoc.isNull()){
+      LOG(Error, "Could not read gbXML element from '" << toString(path) << "'.");
+      return boost::none;
+    }
 
-  boost::optional<model::Model> ReverseTranslator::translateGBXML(const QDomElement& element, const QDomDocument& doc)
-  {
     openstudio::model::Model model;
     model.setFastNaming(true);
 
+    translateUnits(rootDoc.documentElement());
+
+    // library elements are only referenced by id, collect them into one document and translate them 
+    // once the file has been read, geometry is translated as it is read
+    QDomDocument libraryDoc;
+    QDomElement libraryElement = libraryDoc.createElement("gbXML");
+    libraryDoc.appendChild(libraryElement);
+
+    std::vector<QDomElement> materialElements;
+    std::vector<QDomElement> constructionElements;
+    std::vector<QDomElement> scheduleElements;
+    ElementMap layerElements;
+    ElementMap weekScheduleElements;
+    ElementMap dayScheduleElements;
+
+    QStringList elementNames;
+    elementNames << "Surface" << "Material" << "Layer" << "Construction" << "Schedule" << "WeekSchedule" << "DaySchedule";
+
+    QStringList startElementNames;
+    startElementNames << "Campus" << "Building" << "Space";
+
+    if (m_progressBar){
+      m_progressBar->setWindowTitle(toString("Translating Geometry"));
+      m_progressBar->setMinimum(0);
+      m_progressBar->setMaximum(100); 
+      m_progressBar->setValue(0);
+    }
+
+    unsigned numCampuses = 0;
+    unsigned numBuildings = 0;
+    while (true){
+      QDomDocument doc = reader.readNextElement(elementNames, startElementNames);
+      if (doc.isNull()){
+        break;
+      }
+
+      QDomElement element = doc.documentElement();
+      QString tagName = element.tagName();
+
+      if (tagName == "Surface"){
+        try {
+          boost::optional<model::ModelObject> surface = translateSurface(element, doc, model);
+        }catch(const std::exception&){
+          LOG(Error, "Could not translate surface " << element);
+        }
+      }else if (tagName == "Space"){
+        boost::optional<model::ModelObject> space = translateSpace(element, doc, model);
+        BOOST_ASSERT(space);
+      }else if (tagName == "Building"){
+        ++numBuildings;
+        boost::optional<model::ModelObject> building = translateBuilding(element, doc, model);
+        BOOST_ASSERT(building);
+      }else if (tagName == "Campus"){
+        ++numCampuses;
+        boost::optional<model::ModelObject> facility = translateCampus(element, doc, model);
+        BOOST_ASSERT(facility); // Krishnan, what type of error handling do you want?
+      }else{
+        QDomElement libraryChild = libraryDoc.importNode(element, true).toElement();
+        libraryElement.appendChild(libraryChild);
+
+        if (tagName == "Material"){
+          materialElements.push_back(libraryChild);
+        }else if (tagName == "Construction"){
+          constructionElements.push_back(libraryChild);
+        }else if (tagName == "Schedule"){
+          scheduleElements.push_back(libraryChild);
+        }else if (tagName == "Layer"){
+          layerElements.insert(ElementMap::value_type(libraryChild.attribute("id"), libraryChild));
+        }else if (tagName == "WeekSchedule"){
+          weekScheduleElements.insert(ElementMap::value_type(libraryChild.attribute("id"), libraryChild));
+        }else if (tagName == "DaySchedule"){
+          dayScheduleElements.insert(ElementMap::value_type(libraryChild.attribute("id"), libraryChild));
+        }
+      }
+
+      if (m_progressBar){
+        m_progressBar->setValue(reader.percentComplete());
+      }
+    }
+
+    if (!reader.isValid()){
+      LOG(Error, "Error reading '" << toString(path) << "': " << reader.errorString());
+    }
+
+    BOOST_ASSERT(numCampuses == 1);
+    BOOST_ASSERT(numBuildings == 1);
+
+    // do materials before constructions 
+    if (m_progressBar){
+      m_progressBar->setWindowTitle(toString("Translating Materials"));
+      m_progressBar->setMinimum(0);
+      m_progressBar->setMaximum(materialElements.size()); 
+      m_progressBar->setValue(0);
+    }
+
+    BOOST_FOREACH(const QDomElement& materialElement, materialElements){
+      boost::optional<model::ModelObject> material = translateMaterial(materialElement, libraryDoc, model);
+      BOOST_ASSERT(material); // Krishnan, what type of error handling do you want?
+      
+      if (m_progressBar){
+        m_progressBar->setValue(m_progressBar->value() + 1);
+      }
+    }
+
+    // do constructions after materials
+    if (m_progressBar){
+      m_progressBar->setWindowTitle(toString("Translating Constructions"));
+      m_progressBar->setMinimum(0);
+      m_progressBar->setMaximum(constructionElements.size()); 
+      m_progressBar->setValue(0);
+    }
+
+    BOOST_FOREACH(const QDomElement& constructionElement, constructionElements){
+      boost::optional<model::ModelObject> construction = translateConstruction(constructionElement, layerElements, libraryDoc, model);
+      BOOST_ASSERT(construction); // Krishnan, what type of error handling do you want?
+      
+      if (m_progressBar){
+        m_progressBar->setValue(m_progressBar->value() + 1);
+      }
+    }
+
+    if (m_progressBar){
+      m_progressBar->setWindowTitle(toString("Translating Schedules"));
+      m_progressBar->setMinimum(0);
+      m_progressBar->setMaximum(scheduleElements.size()); 
+      m_progressBar->setValue(0);
+    }
+
+    BOOST_FOREACH(const QDomElement& scheduleElement, scheduleElements){
+      boost::optional<model::ModelObject> schedule = translateSchedule(scheduleElement, weekScheduleElements, dayScheduleElements, libraryDoc, model);
+      BOOST_ASSERT(schedule); // Krishnan, what type of error handling do you want?
+      
+      if (m_progressBar){
+        m_progressBar->setValue(m_progressBar->value() + 1);
+      }
+    }
+
+    model.setFastNaming(false);
+
+    return model;
+  }
+
+  void ReverseTranslator::translateUnits(const QDomElement& element)
+  {
     // gbXML attributes not mapped directly to IDF, but needed to map
 
     // {F, C, K, R}
@@ -200,107 +341,12 @@ namespace gbxml {
     }else{
       m_useSIUnitsForResults = true;
     }
-
-    // do materials before constructions 
-    QDomNodeList materialElements = element.elementsByTagName("Material");
-    if (m_progressBar){
-      m_progressBar->setWindowTitle(toString("Translating Materials"));
-      m_progressBar->setMinimum(0);
-      m_progressBar->setMaximum(materialElements.count()); 
-      m_progressBar->setValue(0);
-    }
-
-    for (int i = 0; i < materialElements.count(); i++){
-      QDomElement materialElement = materialElements.at(i).toElement();
-      boost::optional<model::ModelObject> material = translateMaterial(materialElement, doc, model);
-      BOOST_ASSERT(material); // Krishnan, what type of error handling do you want?
-      
-      if (m_progressBar){
-        m_progressBar->setValue(m_progressBar->value() + 1);
-      }
-    }
-
-    // do constructions before surfaces
-    QDomNodeList layerElements = element.elementsByTagName("Layer");
-    QDomNodeList constructionElements = element.elementsByTagName("Construction");
-    if (m_progressBar){
-      m_progressBar->setWindowTitle(toString("Translating Constructions"));
-      m_progressBar->setMinimum(0);
-      m_progressBar->setMaximum(constructionElements.count()); 
-      m_progressBar->setValue(0);
-    }
-
-    for (int i = 0; i < constructionElements.count(); i++){
-      QDomElement constructionElement = constructionElements.at(i).toElement();
-      boost::optional<model::ModelObject> construction = translateConstruction(constructionElement, layerElements, doc, model);
-      BOOST_ASSERT(construction); // Krishnan, what type of error handling do you want?
-      
-      if (m_progressBar){
-        m_progressBar->setValue(m_progressBar->value() + 1);
-      }
-    }
-
-    // do schedules before loads
-    QDomNodeList scheduleElements = element.elementsByTagName("Schedule");
-    if (m_progressBar){
-      m_progressBar->setWindowTitle(toString("Translating Schedules"));
-      m_progressBar->setMinimum(0);
-      m_progressBar->setMaximum(scheduleElements.count()); 
-      m_progressBar->setValue(0);
-    }
-
-    for (int i = 0; i < scheduleElements.count(); i++){
-      QDomElement scheduleElement = scheduleElements.at(i).toElement();
-      boost::optional<model::ModelObject> schedule = translateSchedule(scheduleElement, doc, model);
-      BOOST_ASSERT(schedule); // Krishnan, what type of error handling do you want?
-      
-      if (m_progressBar){
-        m_progressBar->setValue(m_progressBar->value() + 1);
-      }
-    }
-
-    QDomNodeList campusElements = element.elementsByTagName("Campus");
-    BOOST_ASSERT(campusElements.count() == 1);
-    QDomElement campusElement = campusElements.at(0).toElement();
-    boost::optional<model::ModelObject> facility = translateCampus(campusElement, doc, model);
-    BOOST_ASSERT(facility); // Krishnan, what type of error handling do you want?
-
-    model.setFastNaming(false);
-
-    return model;
   }
 
   boost::optional<model::ModelObject> ReverseTranslator::translateCampus(const QDomElement& element, const QDomDocument& doc, openstudio::model::Model& model)
   {
     openstudio::model::Facility facility = model.getUniqueModelObject<openstudio::model::Facility>();
 
-    QDomNodeList buildingElements = element.elementsByTagName("Building");
-    BOOST_ASSERT(buildingElements.count() == 1);
-
-    boost::optional<model::ModelObject> building = translateBuilding(buildingElements.at(0).toElement(), doc, model);
-    BOOST_ASSERT(building);
-
-    QDomNodeList surfaceElements = element.elementsByTagName("Surface");
-    if (m_progressBar){
-      m_progressBar->setWindowTitle(toString("Translating Surfaces"));
-      m_progressBar->setMinimum(0);
-      m_progressBar->setMaximum(surfaceElements.count()); 
-      m_progressBar->setValue(0);
-    }
-
-    for (int i = 0; i < surfaceElements.count(); ++i){
-
-      try {
-        boost::optional<model::ModelObject> surface = translateSurface(surfaceElements.at(i).toElement(), doc, model);
-      }catch(const std::exception&){
-        LOG(Error, "Could not translate surface " << surfaceElements.at(i).toElement());
-      }
-      
-      if (m_progressBar){
-        m_progressBar->setValue(m_progressBar->value() + 1);
-      }
-    }
-
     return facility;
   }
 
@@ -311,23 +357,6 @@ namespace gbxml {
     QString id = element.attribute("id");
     building.setName(escapeName(id));
 
-    QDomNodeList spaceElements = element.elementsByTagName("Space");
-    if (m_progressBar){
-      m_progressBar->setWindowTitle(toString("Translating Spaces"));
-      m_progressBar->setMinimum(0);
-      m_progressBar->setMaximum(spaceElements.count()); 
-      m_progressBar->setValue(0);
-    }
-
-    for (int i = 0; i < spaceElements.count(); ++i){
-      boost::optional<model::ModelObject> space = translateSpace(spaceElements.at(i).toElement(), doc, model);
-      BOOST_ASSERT(space);
-
-      if (m_progressBar){
-        m_progressBar->setValue(m_progressBar->value() + 1);
-      }
-    }
-
     return building;
   }
 
@@ -31,9 +31,11 @@
 
 #include <utilities/units/Unit.hpp>
 
+#include <map>
+
+class QString;
 class QDomDocument;
 class QDomElement;
-class QDomNodeList;
 
 namespace openstudio {
 
@@ -72,17 +74,21 @@ namespace gbxml {
   
   private:
 
+    // library elements referenced by other elements, keyed by id
+    typedef std::map<QString, QDomElement> ElementMap;
+
     std::string escapeName(QString name);
 
-    boost::optional<openstudio::model::Model> convert(const QDomDocument& doc);
-    boost::optional<openstudio::model::Model> translateGBXML(const QDomElement& element, const QDomDocument& doc);
+    // streams the file, only library elements and the current surface are held in memory
+    boost::optional<openstudio::model::Model> convert(const openstudio::path& path);
+    void translateUnits(const QDomElement& element);
     boost::optional<openstudio::model::ModelObject> translateCampus(const QDomElement& element, const QDomDocument& doc, openstudio::model::Model& model);
     boost::optional<openstudio::model::ModelObject> translateBuilding(const QDomElement& element, const QDomDocument& doc, openstudio::model::Model& model);
-    boost::optional<openstudio::model::ModelObject> translateConstruction(const QDomElement& element, const QDomNodeList& layerElements, const QDomDocument& doc, openstudio::model::Model& model);
+    boost::optional<openstudio::model::ModelObject> translateConstruction(const QDomElement& element, const ElementMap& layerElements, const QDomDocument& doc, openstudio::model::Model& model);
     boost::optional<openstudio::model::ModelObject> translateMaterial(const QDomElement& element, const QDomDocument& doc, openstudio::model::Model& model);
     boost::optional<openstudio::model::ModelObject> translateScheduleDay(const QDomElement& element, const QDomDocument& doc, openstudio::model::Model& model);
-    boost::optional<openstudio::model::ModelObject> translateScheduleWeek(const QDomElement& element, const QDomDocument& doc, openstudio::model::Model& model);
-    boost::optional<openstudio::model::ModelObject> translateSchedule(const QDomElement& element, const QDomDocument& doc, openstudio::model::Model& model);
+    boost::optional<openstudio::model::ModelObject> translateScheduleWeek(const QDomElement& element, const ElementMap& dayScheduleElements, const QDomDocument& doc, openstudio::model::Model& model);
+    boost::optional<openstudio::model::ModelObject> translateSchedule(const QDomElement& element, const ElementMap& weekScheduleElements, const ElementMap& dayScheduleElements, const QDomDocument& doc, openstudio::model::Model& model);
     boost::optional<openstudio::model::ModelObject> translateSpace(const QDomElement& element, const QDomDocument& doc, openstudio::model::Model& model);
     boost::optional<openstudio::model::ModelObject> translateSurface(const QDomElement& element, const QDomDocument& doc, openstudio::model::Model& model);
     boost::optional<openstudio::model::ModelObject> translateSubSurface(const QDomElement& element, const QDomDocument& doc, openstudio::model::Surface& surface);
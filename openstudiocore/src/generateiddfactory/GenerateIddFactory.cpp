@@ -217,6 +217,7 @@ void initializeOutFiles(GenerateIddFactoryOutFiles& outFiles,
     << "  IddObjectSourceFileMap m_sourceFileMap;" << std::endl
     << std::endl
     << "  mutable std::map<VersionString,IddFile> m_osIddFiles;" << std::endl
+    << "  mutable QMutex m_osIddFilesMutex;" << std::endl
     << "};" << std::endl
     << std::endl
     << "#if _WIN32 || _MSC_VER" << std::endl
@@ -273,6 +274,7 @@ void initializeOutFiles(GenerateIddFactoryOutFiles& outFiles,
   BOOST_FOREACH(boost::shared_ptr<IddFactoryOutFile>& cxxFile,outFiles.iddFactoryIddFileCxxs) {
     cxxFile->tempFile
       << "#include <utilities/idd/IddFactory.hxx>" << std::endl
+      << "#include <utilities/idd/IddTables.hpp>" << std::endl
       << std::endl
       << "#include <utilities/core/Assert.hpp>" << std::endl
       << "#include <utilities/core/Compare.hpp>" << std::endl
@@ -852,6 +854,9 @@ void completeOutFiles(const IddFileFactoryDataVector& iddFiles,
     << "    return getIddFile(fileType);" << std::endl
     << "  }" << std::endl
     << "  else {" << std::endl
+    << "    // Hold the lock while loading so concurrent callers (e.g. parallel version translation)" << std::endl
+    << "    // share one copy of each previous-version IddFile." << std::endl
+    << "    QMutexLocker l(&m_osIddFilesMutex);" << std::endl
     << "    std::map<VersionString, IddFile>::const_iterator it = m_osIddFiles.find(version);" << std::endl
     << "    if (it != m_osIddFiles.end()) {" << std::endl
     << "      return it->second;" << std::endl
@@ -864,7 +869,6 @@ void completeOutFiles(const IddFileFactoryDataVector& iddFiles,
     << "      result = IddFile::load(iddPath);" << std::endl
     << "    }" << std::endl
     << "    if (result) {" << std::endl
-    << "      QMutexLocker l(&m_callbackmutex);" << std::endl
     << "      m_osIddFiles[version] = *result;" << std::endl
     << "    }" << std::endl
     << "  }" << std::endl
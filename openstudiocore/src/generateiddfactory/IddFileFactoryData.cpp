@@ -18,6 +18,7 @@
 **********************************************************************/
 
 #include <generateiddfactory/IddFileFactoryData.hpp>
+#include <generateiddfactory/IddObjectTableData.hpp>
 
 #include <utilities/idd/IddRegex.hpp>
 
@@ -180,16 +181,10 @@ void IddFileFactoryData::parseFile(const path& outPath,
     objectName.first = m_convertName(objectName.second);
     m_objectNames.push_back(objectName);    
 
-    // start writing create function
-    cxxFile->tempFile
-      << std::endl
-      << "IddObject create" << objectName.first << "IddObject() {" << std::endl
-      << std::endl
-      << "  static IddObject object;" << std::endl
-      << std::endl
-      << "  if (object.type() == IddObjectType::Catchall) {" << std::endl
-      << "    std::stringstream ss;" << std::endl
-      << "    ss << \"" << m_readyLineForOutput(line) << "\\n\";";
+    // start collecting object text, which is parsed into static tables once the object is 
+    // complete, so the IddFactory does not have to parse it at runtime
+    std::stringstream objectText;
+    objectText << trimLine << "\n";
 
     // start collecting field names
     // (requires \field tag, which is expected to occur one per line)
@@ -200,17 +195,28 @@ void IddFileFactoryData::parseFile(const path& outPath,
     while (std::getline(iddFile,line)) {
       ++lineNum; trimLine = line; boost::trim(trimLine);
       if (trimLine.empty()) { 
-        // finish writing create function
+        // write object tables
+        IddObjectTableData tableData(objectName.second,group,objectText.str());
+        std::string tableName = objectName.first + "_IddObjectTable";
+        cxxFile->tempFile
+          << std::endl
+          << "namespace {" << std::endl
+          << std::endl;
+        tableData.writeTables(cxxFile->tempFile,tableName);
         cxxFile->tempFile
           << std::endl
+          << "} // anonymous namespace" << std::endl;
+
+        // write create function
+        cxxFile->tempFile
+          << std::endl
+          << "IddObject create" << objectName.first << "IddObject() {" << std::endl
+          << std::endl
+          << "  static IddObject object;" << std::endl
           << std::endl
+          << "  if (object.type() == IddObjectType::Catchall) {" << std::endl
           << "    IddObjectType objType(IddObjectType::" << objectName.first << ");" << std::endl
-          << "    OptionalIddObject oObj = IddObject::load(\"" << objectName.second << "\"," << std::endl
-          << "                                             \"" << group << "\"," << std::endl
-          << "                                             ss.str()," << std::endl
-          << "                                             objType);" << std::endl
-          << "    BOOST_ASSERT(oObj);" << std::endl
-          << "    object = *oObj;" << std::endl
+          << "    object = IddObject::load(" << tableName << ",objType);" << std::endl
           << "  }" << std::endl
           << std::endl
           << "  BOOST_ASSERT(object.type() == IddObjectType::" << objectName.first << ");" << std::endl
@@ -305,10 +311,8 @@ void IddFileFactoryData::parseFile(const path& outPath,
         break; 
       }
 
-      // continue writing create function
-      cxxFile->tempFile
-        << std::endl
-        << "    ss << \"" << m_readyLineForOutput(line) << "\\n\";";
+      // continue collecting object text
+      objectText << trimLine << "\n";
 
       // look for field name
       std::string fieldName;
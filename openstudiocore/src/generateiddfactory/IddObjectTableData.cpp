@@ -0,0 +1,646 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <generateiddfactory/IddObjectTableData.hpp>
+
+#include <utilities/idd/IddRegex.hpp>
+
+#include <boost/foreach.hpp>
+#include <boost/regex.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <exception>
+
+namespace openstudio {
+
+namespace {
+
+  // same as commentRegex::whitespaceOnlyBlock, which is not linked into the generator
+  const boost::regex& whitespaceOnlyBlock() {
+    const static boost::regex result("[\\s]*");
+    return result;
+  }
+
+  double toDouble(const std::string& str, const std::string& context) {
+    try {
+      return boost::lexical_cast<double>(str);
+    }
+    catch (...) {
+      std::stringstream ss;
+      ss << "Unable to convert '" << str << "' to a number in " << context << ".";
+      throw std::runtime_error(ss.str().c_str());
+    }
+  }
+
+  unsigned toUnsigned(const std::string& str, const std::string& context) {
+    try {
+      return boost::lexical_cast<unsigned>(str);
+    }
+    catch (...) {
+      std::stringstream ss;
+      ss << "Unable to convert '" << str << "' to an unsigned integer in " << context << ".";
+      throw std::runtime_error(ss.str().c_str());
+    }
+  }
+
+  /** Maps \\type values onto IddFieldType value names. */
+  std::string fieldTypeName(const std::string& typeText) {
+    std::string lowerText = boost::algorithm::to_lower_copy(typeText);
+    if (lowerText == "integer") { return "IntegerType"; }
+    if (lowerText == "real") { return "RealType"; }
+    if (lowerText == "alpha") { return "AlphaType"; }
+    if (lowerText == "choice") { return "ChoiceType"; }
+    if (lowerText == "node") { return "NodeType"; }
+    if (lowerText == "object-list") { return "ObjectListType"; }
+    if (lowerText == "external-list") { return "ExternalListType"; }
+    if (lowerText == "url") { return "URLType"; }
+    if (lowerText == "handle") { return "HandleType"; }
+    throw std::runtime_error(("Unknown field type '" + typeText + "'.").c_str());
+  }
+
+  /** Returns str as a C string literal. Non-printable characters are written as octal escapes,
+   *  and question marks are escaped to avoid accidental trigraphs. */
+  std::string literal(const std::string& str) {
+    std::stringstream ss;
+    ss << "\"";
+    BOOST_FOREACH(char c, str) {
+      unsigned char uc = static_cast<unsigned char>(c);
+      switch (c) {
+        case '\\' : ss << "\\\\"; break;
+        case '"' : ss << "\\\""; break;
+        case '?' : ss << "\\?"; break;
+        case '\n' : ss << "\\n"; break;
+        case '\t' : ss << "\\t"; break;
+        default :
+          if ((uc < 0x20) || (uc >= 0x7f)) {
+            ss << "\\" << std::oct << std::setw(3) << std::setfill('0') << unsigned(uc) 
+               << std::dec << std::setfill(' ');
+          }
+          else {
+            ss << c;
+          }
+      }
+    }
+    ss << "\"";
+    return ss.str();
+  }
+
+  std::string literal(const boost::optional<std::string>& str) {
+    if (str) { return literal(*str); }
+    return "0";
+  }
+
+  std::string literal(bool value) {
+    return value ? "true" : "false";
+  }
+
+  std::string literal(double value) {
+    std::stringstream ss;
+    ss << std::setprecision(17) << value;
+    return ss.str();
+  }
+
+  std::string literal(const boost::optional<double>& value) {
+    if (value) { return literal(*value); }
+    return "0.0";
+  }
+
+  void writeStringArray(std::ostream& os, 
+                        const std::vector<std::string>& strs, 
+                        const std::string& arrayName) 
+  {
+    if (strs.empty()) { return; }
+    os << "const char* const " << arrayName << "[] = {";
+    for (unsigned i = 0, n = strs.size(); i < n; ++i) {
+      if (i > 0) { os << ","; }
+      os << std::endl << "  " << literal(strs[i]);
+    }
+    os << " };" << std::endl;
+  }
+
+  std::string arrayRef(bool isEmpty, const std::string& arrayName, unsigned n) {
+    std::stringstream ss;
+    if (isEmpty) { ss << "0, 0"; }
+    else { ss << arrayName << ", " << n; }
+    return ss.str();
+  }
+
+}
+
+IddObjectTableData::FieldData::FieldData(const std::string& t_name)
+  : name(t_name),
+    required(false),
+    autosizable(false),
+    autocalculatable(false),
+    retaincase(false),
+    deprecated(false),
+    beginExtensible(false),
+    minBoundType("Unbounded"),
+    maxBoundType("Unbounded")
+{}
+
+IddObjectTableData::IddObjectTableData(const std::string& name, 
+                                       const std::string& group, 
+                                       const std::string& text)
+  : m_name(name),
+    m_group(group),
+    m_unique(false),
+    m_required(false),
+    m_obsolete(false),
+    m_hasURL(false),
+    m_extensible(false),
+    m_numExtensible(0),
+    m_numExtensibleGroupsRequired(0),
+    m_minFields(0)
+{
+  // same logic as IddObject_Impl::parse
+  boost::smatch matches;
+  if (boost::regex_search(text, matches, iddRegex::objectAndFields())) {
+    parseObject(std::string(matches[1].first, matches[1].second));
+    parseFields(std::string(matches[2].first, matches[2].second));
+  }
+  else if (boost::regex_match(text, iddRegex::objectNoFields())) {
+    parseObject(text);
+  }
+  else {
+    throw std::runtime_error(("Unexpected pattern '" + text + "' found in object '" + m_name + "'.").c_str());
+  }
+
+  if (m_extensible) {
+    makeExtensible();
+  }
+}
+
+void IddObjectTableData::writeTables(std::ostream& os, const std::string& tableName) const {
+  std::string fieldsName = tableName + "_Fields";
+  std::string extensibleFieldsName = tableName + "_ExtensibleFields";
+  writeFieldTables(os, m_fields, fieldsName);
+  writeFieldTables(os, m_extensibleFields, extensibleFieldsName);
+
+  os << "const detail::IddObjectTable " << tableName << " = {" << std::endl
+     << "  " << literal(m_name) << "," << std::endl
+     << "  " << literal(m_group) << "," << std::endl
+     << "  " << literal(m_memo) << "," << std::endl
+     << "  " << literal(m_unique) << ", " << literal(m_required) << ", " << literal(m_obsolete) << ", "
+     << literal(m_hasURL) << ", " << literal(m_extensible) << "," << std::endl
+     << "  " << m_numExtensible << ", " << m_numExtensibleGroupsRequired << "," << std::endl
+     << "  " << literal(m_format) << "," << std::endl
+     << "  " << m_minFields << ", " << literal(bool(m_maxFields)) << ", " 
+     << (m_maxFields ? *m_maxFields : 0u) << "," << std::endl
+     << "  " << arrayRef(m_fields.empty(), fieldsName, m_fields.size()) << "," << std::endl
+     << "  " << arrayRef(m_extensibleFields.empty(), extensibleFieldsName, m_extensibleFields.size()) << " };" 
+     << std::endl;
+}
+
+void IddObjectTableData::parseObject(const std::string& text) {
+  // same logic as IddObject_Impl::parseObject
+  boost::smatch matches;
+  std::string propertiesText;
+  if (boost::regex_search(text, matches, iddRegex::line())) {
+    std::string objectName(matches[1].first, matches[1].second); boost::trim(objectName);
+    if (!boost::equals(m_name, objectName)) {
+      throw std::runtime_error(("Object name '" + objectName + "' does not match expected '" + m_name + "'.").c_str());
+    }
+    propertiesText = std::string(matches[2].first, matches[2].second); boost::trim(propertiesText);
+  }
+  else {
+    throw std::runtime_error(("Could not determine object name from text '" + text + "'.").c_str());
+  }
+
+  while (boost::regex_search(propertiesText, matches, iddRegex::metaDataComment())) {
+    std::string thisProperty(matches[1].first, matches[1].second); boost::trim(thisProperty);
+    parseObjectProperty(thisProperty);
+    propertiesText = std::string(matches[2].first, matches[2].second); boost::trim(propertiesText);
+  }
+  if (!(boost::regex_match(propertiesText, whitespaceOnlyBlock()) ||
+        boost::regex_match(propertiesText, iddRegex::commentOnlyLine())))
+  {
+    throw std::runtime_error(("Could not process properties text '" + propertiesText + 
+                              "' in object '" + m_name + "'.").c_str());
+  }
+}
+
+void IddObjectTableData::parseObjectProperty(const std::string& text) {
+  // same logic as IddObject_Impl::parseProperty
+  boost::smatch matches;
+  std::string context = "object '" + m_name + "'";
+  if (boost::regex_search(text, matches, iddRegex::memoProperty())) {
+    std::string memo(matches[1].first, matches[1].second); boost::trim(memo);
+    if (m_memo.empty()) { m_memo = memo; }
+    else { m_memo += "\n" + memo; }
+  }
+  else if (boost::regex_match(text, iddRegex::uniqueProperty())) {
+    m_unique = true;
+  }
+  else if (boost::regex_match(text, iddRegex::requiredObjectProperty())) {
+    m_required = true;
+  }
+  else if (boost::regex_match(text, iddRegex::obsoleteProperty())) {
+    m_obsolete = true;
+  }
+  else if (boost::regex_match(text, iddRegex::hasurlProperty())) {
+    m_hasURL = true;
+  }
+  else if (boost::regex_search(text, matches, iddRegex::extensibleProperty())) {
+    m_extensible = true;
+    m_numExtensible = toUnsigned(std::string(matches[1].first, matches[1].second), context);
+  }
+  else if (boost::regex_search(text, matches, iddRegex::formatProperty())) {
+    std::string format(matches[1].first, matches[1].second); boost::trim(format);
+    m_format = format;
+  }
+  else if (boost::regex_search(text, matches, iddRegex::minFieldsProperty())) {
+    m_minFields = toUnsigned(std::string(matches[1].first, matches[1].second), context);
+  }
+  else if (boost::regex_search(text, matches, iddRegex::maxFieldsProperty())) {
+    m_maxFields = toUnsigned(std::string(matches[1].first, matches[1].second), context);
+  }
+  else {
+    throw std::runtime_error(("Unknown property text '" + text + "' in object '" + m_name + "'.").c_str());
+  }
+}
+
+void IddObjectTableData::parseFields(const std::string& text) {
+  // same logic as IddObject_Impl::parseFields
+  std::string copyText(text);
+
+  boost::smatch matches;
+  while (boost::regex_search(copyText, matches, iddRegex::lastField())) {
+    std::string fieldText(matches[2].first, matches[2].second);
+    std::string fieldName;
+
+    boost::smatch nameMatches;
+    if (boost::regex_search(fieldText, nameMatches, iddRegex::name())) {
+      fieldName = std::string(nameMatches[1].first, nameMatches[1].second); boost::trim(fieldName);
+    }
+    else if (boost::regex_search(fieldText, nameMatches, iddRegex::field())) {
+      std::string fieldTypeChar(nameMatches[1].first, nameMatches[1].second); boost::trim(fieldTypeChar);
+      std::string fieldTypeNumber(nameMatches[2].first, nameMatches[2].second); boost::trim(fieldTypeNumber);
+      fieldName = fieldTypeChar + fieldTypeNumber;
+    }
+    else {
+      throw std::runtime_error(("Cannot determine field name from text '" + fieldText + "'.").c_str());
+    }
+
+    FieldData field(fieldName);
+    parseField(field, fieldText);
+    m_fields.push_back(field);
+
+    copyText = std::string(matches[1].first, matches[1].second);
+  }
+
+  if (!copyText.empty()) {
+    throw std::runtime_error(("Could not process remaining field text '" + copyText + 
+                              "' in object '" + m_name + "'.").c_str());
+  }
+
+  std::reverse(m_fields.begin(), m_fields.end());
+}
+
+void IddObjectTableData::parseField(FieldData& field, const std::string& text) const {
+  // same logic as IddField_Impl::parse
+  boost::smatch matches;
+  if (boost::regex_search(text, matches, iddRegex::field())) {
+    std::string fieldTypeChar(matches[1].first, matches[1].second);
+    std::string fieldTypeNumber(matches[2].first, matches[2].second);
+    std::string fieldProperties(matches[3].first, matches[3].second);
+
+    field.fieldId = fieldTypeChar + fieldTypeNumber;
+
+    if (boost::iequals(fieldTypeChar, "A")) {
+      field.type = "AlphaType";
+    }
+    else if (boost::iequals(fieldTypeChar, "N")) {
+      field.type = "RealType";
+    }
+    else {
+      throw std::runtime_error(("Unknown field type identifier found: '" + fieldTypeChar + "'.").c_str());
+    }
+
+    while (boost::regex_search(fieldProperties, matches, iddRegex::metaDataComment())) {
+      std::string thisProperty(matches[1].first, matches[1].second); boost::trim(thisProperty);
+      parseFieldProperty(field, thisProperty);
+      fieldProperties = std::string(matches[2].first, matches[2].second); boost::trim(fieldProperties);
+    }
+
+    if (!(boost::regex_match(fieldProperties, whitespaceOnlyBlock()) ||
+          boost::regex_match(fieldProperties, iddRegex::commentOnlyLine())))
+    {
+      throw std::runtime_error(("Unable to parse remaining fields: '" + fieldProperties + "'.").c_str());
+    }
+  }
+  else {
+    throw std::runtime_error(("Field text does not match expected pattern: '" + text + "'.").c_str());
+  }
+
+  if (field.type == "ChoiceType") {
+    if (field.keys.empty()) {
+      std::cerr << "Field is of type choice but keys are empty: '" << field.name << "' in object '" 
+                << m_name << "'." << std::endl;
+    }
+  }
+  else if (!field.keys.empty()) {
+    std::cerr << "Field is not of type choice but has non-empty keys: '" << field.name 
+              << "' in object '" << m_name << "'." << std::endl;
+  }
+
+  // if the field has a default then it is not required
+  if (field.stringDefault) {
+    field.required = false;
+  }
+}
+
+void IddObjectTableData::parseFieldProperty(FieldData& field, const std::string& text) const {
+  // same logic as IddField_Impl::parseProperty
+  if (text.empty()) { 
+    return; 
+  }
+
+  std::string context = "field '" + field.name + "' of object '" + m_name + "'";
+  bool notHandled = true;
+  boost::smatch matches;
+  std::string lowerText = boost::algorithm::to_lower_copy(text);
+
+  if (boost::algorithm::starts_with(lowerText, "autosizable")) {
+    field.autosizable = true;
+    notHandled = false;
+  }
+  else if (boost::algorithm::starts_with(lowerText, "autocalculatable")) {
+    field.autocalculatable = true;
+    notHandled = false;
+  }
+  else if (boost::algorithm::starts_with(lowerText, "begin-extensible")) {
+    field.beginExtensible = true;
+    notHandled = false;
+  }
+  else if (boost::algorithm::starts_with(lowerText, "default")) {
+    notHandled = false;
+    if (!boost::regex_search(text, matches, iddRegex::defaultProperty())) {
+      throw std::runtime_error(("Unable to parse default in " + context + ".").c_str());
+    }
+    std::string stringDefault(matches[1].first, matches[1].second); boost::trim(stringDefault);
+    field.stringDefault = stringDefault;
+    if ((field.type == "RealType") || (field.type == "IntegerType")) {
+      if (!boost::regex_match(text, iddRegex::automaticDefault())) {
+        field.numericDefault = toDouble(stringDefault, context);
+      }
+      else {
+        field.numericDefault = -9999;
+      }
+    }
+  }
+  else if (boost::algorithm::starts_with(lowerText, "deprecated")) {
+    field.deprecated = true;
+    notHandled = false;
+  }
+  else if (boost::algorithm::starts_with(lowerText, "external-list")) {
+    notHandled = false;
+    if (!boost::regex_search(text, matches, iddRegex::externalListProperty())) {
+      throw std::runtime_error(("Unable to parse external-list in " + context + ".").c_str());
+    }
+    std::string externalList(matches[1].first, matches[1].second); boost::trim(externalList);
+    field.externalLists.push_back(externalList);
+  }
+  else if (boost::algorithm::starts_with(lowerText, "field")) {
+    notHandled = false;
+    if (!boost::regex_search(text, matches, iddRegex::nameProperty())) {
+      throw std::runtime_error(("Unable to parse field name in " + context + ".").c_str());
+    }
+    std::string fieldName(matches[1].first, matches[1].second); boost::trim(fieldName);
+    if (!boost::equals(field.name, fieldName)) {
+      throw std::runtime_error(("Field name '" + fieldName + "' does not match expected '" + 
+                                field.name + "' in object '" + m_name + "'.").c_str());
+    }
+  }
+  else if (boost::algorithm::starts_with(lowerText, "ip-units")) {
+    notHandled = false;
+    if (!boost::regex_search(text, matches, iddRegex::ipUnitsProperty())) {
+      throw std::runtime_error(("Unable to parse ip-units in " + context + ".").c_str());
+    }
+    std::string ipUnits(matches[1].first, matches[1].second); boost::trim(ipUnits);
+    field.ipUnits = ipUnits;
+  }
+  else if (boost::algorithm::starts_with(lowerText, "key")) {
+    notHandled = false;
+    if (!boost::regex_search(text, matches, iddRegex::keyProperty())) {
+      throw std::runtime_error(("Unable to parse key in " + context + ".").c_str());
+    }
+    std::string keyText(matches[1].first, matches[1].second);
+    boost::smatch keyMatches;
+    if (boost::regex_search(keyText, keyMatches, iddRegex::contentAndCommentLine())) {
+      // same logic as IddKey_Impl::parse, note is not trimmed
+      std::string keyName(keyMatches[1].first, keyMatches[1].second); boost::trim(keyName);
+      std::string keyNote(keyMatches[2].first, keyMatches[2].second);
+      field.keys.push_back(KeyData(keyName, keyNote));
+    }
+    else {
+      throw std::runtime_error(("Key name could not be determined from text '" + keyText + "'.").c_str());
+    }
+  }
+  else if (boost::algorithm::starts_with(lowerText, "minimum")) {
+    if (boost::regex_search(text, matches, iddRegex::minExclusiveProperty())) {
+      field.minBoundType = "ExclusiveBound";
+      notHandled = false;
+    }
+    else if (boost::regex_search(text, matches, iddRegex::minInclusiveProperty())) {
+      field.minBoundType = "InclusiveBound";
+      notHandled = false;
+    }
+    if (!notHandled) {
+      std::string minBound(matches[1].first, matches[1].second); boost::trim(minBound);
+      field.minBoundValue = toDouble(minBound, context);
+      field.minBoundText = minBound;
+    }
+  }
+  else if (boost::algorithm::starts_with(lowerText, "maximum")) {
+    if (boost::regex_search(text, matches, iddRegex::maxExclusiveProperty())) {
+      field.maxBoundType = "ExclusiveBound";
+      notHandled = false;
+    }
+    else if (boost::regex_search(text, matches, iddRegex::maxInclusiveProperty())) {
+      field.maxBoundType = "InclusiveBound";
+      notHandled = false;
+    }
+    if (!notHandled) {
+      std::string maxBound(matches[1].first, matches[1].second); boost::trim(maxBound);
+      field.maxBoundValue = toDouble(maxBound, context);
+      field.maxBoundText = maxBound;
+    }
+  }
+  else if (boost::algorithm::starts_with(lowerText, "memo") || 
+           boost::algorithm::starts_with(lowerText, "note")) 
+  {
+    notHandled = false;
+    bool ok = boost::algorithm::starts_with(lowerText, "memo") ?
+              boost::regex_search(text, matches, iddRegex::memoProperty()) :
+              boost::regex_search(text, matches, iddRegex::noteProperty());
+    if (!ok) {
+      throw std::runtime_error(("Unable to parse note in " + context + ".").c_str());
+    }
+    std::string note(matches[1].first, matches[1].second); boost::trim(note);
+    if (field.note.empty()) { field.note = note; }
+    else { field.note += "\n" + note; }
+  }
+  else if (boost::algorithm::starts_with(lowerText, "object-list")) {
+    notHandled = false;
+    if (!boost::regex_search(text, matches, iddRegex::objectListProperty())) {
+      throw std::runtime_error(("Unable to parse object-list in " + context + ".").c_str());
+    }
+    std::string objectList(matches[1].first, matches[1].second); boost::trim(objectList);
+    field.objectLists.push_back(objectList);
+  }
+  else if (boost::algorithm::starts_with(lowerText, "required-field")) {
+    field.required = true;
+    notHandled = false;
+  }
+  else if (boost::algorithm::starts_with(lowerText, "reference")) {
+    notHandled = false;
+    if (!boost::regex_search(text, matches, iddRegex::referenceProperty())) {
+      throw std::runtime_error(("Unable to parse reference in " + context + ".").c_str());
+    }
+    std::string reference(matches[1].first, matches[1].second); boost::trim(reference);
+    field.references.push_back(reference);
+  }
+  else if (boost::algorithm::starts_with(lowerText, "retaincase")) {
+    field.retaincase = true;
+    notHandled = false;
+  }
+  else if (boost::algorithm::starts_with(lowerText, "type")) {
+    notHandled = false;
+    if (!boost::regex_search(text, matches, iddRegex::typeProperty())) {
+      throw std::runtime_error(("Unable to parse type in " + context + ".").c_str());
+    }
+    std::string fieldType(matches[1].first, matches[1].second); boost::trim(fieldType);
+    field.type = fieldTypeName(fieldType);
+  }
+  else if (boost::algorithm::starts_with(lowerText, "units")) {
+    // IddField_Impl::parseProperty does not distinguish \unitsBasedOnField from \units
+    notHandled = false;
+    if (!boost::regex_search(text, matches, iddRegex::unitsProperty())) {
+      throw std::runtime_error(("Unable to parse units in " + context + ".").c_str());
+    }
+    std::string units(matches[1].first, matches[1].second); boost::trim(units);
+    field.units = units;
+  }
+
+  if (notHandled) {
+    throw std::runtime_error(("Unknown field property text '" + text + "' detected in " + context + ".").c_str());
+  }
+}
+
+void IddObjectTableData::makeExtensible() {
+  // same logic as IddObject_Impl::makeExtensible
+  if (m_numExtensible == 0) {
+    std::cerr << "Extensible length 0 in object '" << m_name << "'." << std::endl;
+    return;
+  }
+
+  std::vector<FieldData>::iterator extensibleBegin = m_fields.end();
+  for (std::vector<FieldData>::iterator it = m_fields.begin(), itend = m_fields.end(); it != itend; ++it) {
+    if (it->beginExtensible) {
+      extensibleBegin = it;
+      break;
+    }
+  }
+
+  if (extensibleBegin == m_fields.end()) {
+    std::cerr << "No begin-extensible field detected in object '" << m_name << "'." << std::endl;
+    return;
+  }
+
+  if ((extensibleBegin + m_numExtensible) > m_fields.end()) {
+    std::cerr << "Extensible fields begin too close to end of fields in object '" << m_name << "'." << std::endl;
+    return;
+  }
+
+  m_extensibleFields = std::vector<FieldData>(extensibleBegin, extensibleBegin + m_numExtensible);
+  m_fields.erase(extensibleBegin, m_fields.end());
+
+  boost::regex find("\\s?[0-9]+");
+  BOOST_FOREACH(FieldData& extensibleField, m_extensibleFields) {
+    std::string extensibleFieldName = boost::regex_replace(extensibleField.name, find, std::string());
+    boost::trim(extensibleFieldName);
+    extensibleField.name = extensibleFieldName;
+  }
+
+  if (m_minFields > m_fields.size()) {
+    m_numExtensibleGroupsRequired = unsigned(std::ceil(double(m_minFields - m_fields.size()) / 
+                                                       double(m_numExtensible)));
+  }
+}
+
+void IddObjectTableData::writeFieldTables(std::ostream& os,
+                                          const std::vector<FieldData>& fields,
+                                          const std::string& arrayName) const
+{
+  if (fields.empty()) { return; }
+
+  // helper arrays
+  for (unsigned i = 0, n = fields.size(); i < n; ++i) {
+    std::stringstream prefix;
+    prefix << arrayName << "_" << i;
+    const FieldData& field = fields[i];
+    writeStringArray(os, field.objectLists, prefix.str() + "_ObjectLists");
+    writeStringArray(os, field.references, prefix.str() + "_References");
+    writeStringArray(os, field.externalLists, prefix.str() + "_ExternalLists");
+    if (!field.keys.empty()) {
+      os << "const detail::IddKeyTable " << prefix.str() << "_Keys[] = {";
+      for (unsigned j = 0, nk = field.keys.size(); j < nk; ++j) {
+        if (j > 0) { os << ","; }
+        os << std::endl << "  { " << literal(field.keys[j].first) << ", " << literal(field.keys[j].second) << " }";
+      }
+      os << " };" << std::endl;
+    }
+  }
+
+  // field array
+  os << "const detail::IddFieldTable " << arrayName << "[] = {";
+  for (unsigned i = 0, n = fields.size(); i < n; ++i) {
+    std::stringstream prefix;
+    prefix << arrayName << "_" << i;
+    const FieldData& field = fields[i];
+    if (i > 0) { os << ","; }
+    os << std::endl
+       << "  { " << literal(field.name) << ", " << literal(field.fieldId) << ", IddFieldType::" << field.type << "," << std::endl
+       << "    " << literal(field.note) << "," << std::endl
+       << "    " << literal(field.required) << ", " << literal(field.autosizable) << ", " 
+       << literal(field.autocalculatable) << ", " << literal(field.retaincase) << ", " 
+       << literal(field.deprecated) << ", " << literal(field.beginExtensible) << "," << std::endl
+       << "    " << literal(field.units) << ", " << literal(field.ipUnits) << "," << std::endl
+       << "    IddFieldProperties::" << field.minBoundType << ", " << literal(field.minBoundValue) << ", " 
+       << literal(field.minBoundText) << "," << std::endl
+       << "    IddFieldProperties::" << field.maxBoundType << ", " << literal(field.maxBoundValue) << ", " 
+       << literal(field.maxBoundText) << "," << std::endl
+       << "    " << literal(field.stringDefault) << ", " << literal(bool(field.numericDefault)) << ", " 
+       << literal(field.numericDefault) << "," << std::endl
+       << "    " << arrayRef(field.objectLists.empty(), prefix.str() + "_ObjectLists", field.objectLists.size()) << ", "
+       << arrayRef(field.references.empty(), prefix.str() + "_References", field.references.size()) << ", "
+       << arrayRef(field.externalLists.empty(), prefix.str() + "_ExternalLists", field.externalLists.size()) << "," << std::endl
+       << "    " << arrayRef(field.keys.empty(), prefix.str() + "_Keys", field.keys.size()) << " }";
+  }
+  os << " };" << std::endl;
+}
+
+} // openstudio
@@ -0,0 +1,106 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef GENERATEIDDFACTORY_IDDOBJECTTABLEDATA_HPP
+#define GENERATEIDDFACTORY_IDDOBJECTTABLEDATA_HPP
+
+#include <boost/optional.hpp>
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace openstudio {
+
+/** Parses the text of a single IddObject at generation time, following the same rules as 
+ *  IddObject::load, and writes the result out as the static tables declared in 
+ *  utilities/idd/IddTables.hpp. Throws std::runtime_error if the text cannot be parsed. */
+class IddObjectTableData {
+ public:
+  IddObjectTableData(const std::string& name, 
+                     const std::string& group, 
+                     const std::string& text);
+
+  /** Writes the table definitions for this object to os. The IddObjectTable itself is given the 
+   *  name tableName; all helper arrays are prefixed by tableName. */
+  void writeTables(std::ostream& os, const std::string& tableName) const;
+
+ private:
+  typedef std::pair<std::string,std::string> KeyData; // name, note
+
+  struct FieldData {
+    std::string name;
+    std::string fieldId;
+    std::string type; // IddFieldType value name
+    std::string note;
+    bool required;
+    bool autosizable;
+    bool autocalculatable;
+    bool retaincase;
+    bool deprecated;
+    bool beginExtensible;
+    boost::optional<std::string> units;
+    boost::optional<std::string> ipUnits;
+    std::string minBoundType; // IddFieldProperties::BoundTypes value name
+    boost::optional<double> minBoundValue;
+    boost::optional<std::string> minBoundText;
+    std::string maxBoundType; // IddFieldProperties::BoundTypes value name
+    boost::optional<double> maxBoundValue;
+    boost::optional<std::string> maxBoundText;
+    boost::optional<std::string> stringDefault;
+    boost::optional<double> numericDefault;
+    std::vector<std::string> objectLists;
+    std::vector<std::string> references;
+    std::vector<std::string> externalLists;
+    std::vector<KeyData> keys;
+
+    FieldData(const std::string& t_name);
+  };
+
+  std::string m_name;
+  std::string m_group;
+  std::string m_memo;
+  bool m_unique;
+  bool m_required;
+  bool m_obsolete;
+  bool m_hasURL;
+  bool m_extensible;
+  unsigned m_numExtensible;
+  unsigned m_numExtensibleGroupsRequired;
+  std::string m_format;
+  unsigned m_minFields;
+  boost::optional<unsigned> m_maxFields;
+  std::vector<FieldData> m_fields;
+  std::vector<FieldData> m_extensibleFields;
+
+  void parseObject(const std::string& text);
+  void parseObjectProperty(const std::string& text);
+  void parseFields(const std::string& text);
+  void parseField(FieldData& field, const std::string& text) const;
+  void parseFieldProperty(FieldData& field, const std::string& text) const;
+  void makeExtensible();
+
+  void writeFieldTables(std::ostream& os,
+                        const std::vector<FieldData>& fields,
+                        const std::string& arrayName) const;
+};
+
+}
+
+#endif // GENERATEIDDFACTORY_IDDOBJECTTABLEDATA_HPP
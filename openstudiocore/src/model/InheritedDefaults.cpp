@@ -0,0 +1,286 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <model/InheritedDefaults.hpp>
+
+#include <model/Model.hpp>
+#include <model/Building.hpp>
+#include <model/BuildingStory.hpp>
+#include <model/Space.hpp>
+#include <model/SpaceType.hpp>
+#include <model/PlanarSurface.hpp>
+#include <model/Surface.hpp>
+#include <model/SubSurface.hpp>
+#include <model/InteriorPartitionSurface.hpp>
+#include <model/InteriorPartitionSurfaceGroup.hpp>
+#include <model/People.hpp>
+#include <model/Lights.hpp>
+#include <model/Luminaire.hpp>
+#include <model/ElectricEquipment.hpp>
+#include <model/GasEquipment.hpp>
+
+#include <utilities/core/Compare.hpp>
+
+#include <boost/foreach.hpp>
+
+namespace openstudio {
+namespace model {
+
+SpaceLoadTotals::SpaceLoadTotals()
+  : floorArea(0.0), numberOfPeople(0.0), lightingPower(0.0), electricEquipmentPower(0.0), gasEquipmentPower(0.0)
+{}
+
+InheritedDefaults::InheritedDefaults(const Model& model)
+{
+  boost::optional<Building> building = model.building();
+  if (building){
+    boost::optional<DefaultConstructionSet> defaultConstructionSet = building->defaultConstructionSet();
+    if (defaultConstructionSet){
+      m_buildingConstructionSets.push_back(std::make_pair(*defaultConstructionSet, 4));
+    }
+    boost::optional<DefaultScheduleSet> defaultScheduleSet = building->defaultScheduleSet();
+    if (defaultScheduleSet){
+      m_buildingScheduleSets.push_back(*defaultScheduleSet);
+    }
+
+    boost::optional<SpaceType> spaceType = building->spaceType();
+    if (spaceType){
+      defaultConstructionSet = spaceType->defaultConstructionSet();
+      if (defaultConstructionSet){
+        m_buildingConstructionSets.push_back(std::make_pair(*defaultConstructionSet, 5));
+      }
+      defaultScheduleSet = spaceType->defaultScheduleSet();
+      if (defaultScheduleSet){
+        m_buildingScheduleSets.push_back(*defaultScheduleSet);
+      }
+    }
+  }
+}
+
+boost::optional<std::pair<ConstructionBase, int> > InheritedDefaults::getDefaultConstructionWithSearchDistance(
+    const Space& space, const PlanarSurface& planarSurface) const
+{
+  std::pair<Handle, Handle> key(space.handle(), planarSurface.handle());
+  std::map<std::pair<Handle, Handle>, boost::optional<std::pair<ConstructionBase, int> > >::const_iterator it = m_defaultConstructions.find(key);
+  if (it != m_defaultConstructions.end()){
+    return it->second;
+  }
+
+  boost::optional<std::pair<ConstructionBase, int> > result;
+  typedef std::pair<DefaultConstructionSet, int> SetAndDistance;
+  BOOST_FOREACH(const SetAndDistance& setAndDistance, constructionSetChain(space)){
+    boost::optional<ConstructionBase> construction = setAndDistance.first.getDefaultConstruction(planarSurface);
+    if (construction){
+      result = std::make_pair(*construction, setAndDistance.second);
+      break;
+    }
+  }
+
+  m_defaultConstructions.insert(std::make_pair(key, result));
+  return result;
+}
+
+boost::optional<std::pair<ConstructionBase, int> > InheritedDefaults::constructionWithSearchDistance(
+    const PlanarSurface& planarSurface) const
+{
+  if (planarSurface.isConstructionDefaulted()){
+    // shading surfaces also search the building and site, leave those to the surface
+    boost::optional<Space> space;
+    if (boost::optional<Surface> surface = planarSurface.optionalCast<Surface>()){
+      space = surface->space();
+    }else if (boost::optional<SubSurface> subSurface = planarSurface.optionalCast<SubSurface>()){
+      if (boost::optional<Surface> surface = subSurface->surface()){
+        space = surface->space();
+      }
+    }else if (boost::optional<InteriorPartitionSurface> interiorPartitionSurface = planarSurface.optionalCast<InteriorPartitionSurface>()){
+      if (boost::optional<InteriorPartitionSurfaceGroup> group = interiorPartitionSurface->interiorPartitionSurfaceGroup()){
+        space = group->space();
+      }
+    }else{
+      return planarSurface.constructionWithSearchDistance();
+    }
+
+    if (space){
+      return getDefaultConstructionWithSearchDistance(*space, planarSurface);
+    }
+    return boost::none;
+  }
+
+  return planarSurface.constructionWithSearchDistance();
+}
+
+boost::optional<Schedule> InheritedDefaults::getDefaultSchedule(const Space& space,
+                                                                const DefaultScheduleType& defaultScheduleType) const
+{
+  BOOST_FOREACH(const DefaultScheduleSet& defaultScheduleSet, scheduleSetChain(space)){
+    boost::optional<Schedule> result = defaultScheduleSet.getDefaultSchedule(defaultScheduleType);
+    if (result){
+      return result;
+    }
+  }
+  return boost::none;
+}
+
+SpaceLoadTotals InheritedDefaults::spaceLoadTotals(const Space& space) const
+{
+  std::map<Handle, SpaceLoadTotals>::const_iterator it = m_spaceLoadTotals.find(space.handle());
+  if (it != m_spaceLoadTotals.end()){
+    return it->second;
+  }
+
+  // same order of summation as the Space accessors
+  boost::optional<SpaceType> spaceType = space.spaceType();
+
+  SpaceLoadTotals result;
+
+  // Space::floorArea and the load accessors are answered from here, so compute it directly
+  BOOST_FOREACH(const Surface& surface, space.surfaces()){
+    if (istringEqual(surface.surfaceType(), "Floor")){
+      result.floorArea += surface.grossArea();
+    }
+  }
+  double area = result.floorArea;
+
+  BOOST_FOREACH(const People& person, space.people()){
+    result.numberOfPeople += person.getNumberOfPeople(area);
+  }
+  if (spaceType){
+    BOOST_FOREACH(const People& person, spaceType->people()){
+      result.numberOfPeople += person.getNumberOfPeople(area);
+    }
+  }
+  double numPeople = result.numberOfPeople;
+
+  BOOST_FOREACH(const Lights& light, space.lights()){
+    result.lightingPower += light.getLightingPower(area, numPeople);
+  }
+  BOOST_FOREACH(const Luminaire& luminaire, space.luminaires()){
+    result.lightingPower += luminaire.lightingPower();
+  }
+  if (spaceType){
+    BOOST_FOREACH(const Lights& light, spaceType->lights()){
+      result.lightingPower += light.getLightingPower(area, numPeople);
+    }
+    BOOST_FOREACH(const Luminaire& luminaire, spaceType->luminaires()){
+      result.lightingPower += luminaire.lightingPower();
+    }
+  }
+
+  BOOST_FOREACH(const ElectricEquipment& equipment, space.electricEquipment()){
+    result.electricEquipmentPower += equipment.getDesignLevel(area, numPeople);
+  }
+  if (spaceType){
+    BOOST_FOREACH(const ElectricEquipment& equipment, spaceType->electricEquipment()){
+      result.electricEquipmentPower += equipment.getDesignLevel(area, numPeople);
+    }
+  }
+
+  BOOST_FOREACH(const GasEquipment& equipment, space.gasEquipment()){
+    result.gasEquipmentPower += equipment.getDesignLevel(area, numPeople);
+  }
+  if (spaceType){
+    BOOST_FOREACH(const GasEquipment& equipment, spaceType->gasEquipment()){
+      result.gasEquipmentPower += equipment.getDesignLevel(area, numPeople);
+    }
+  }
+
+  m_spaceLoadTotals.insert(std::make_pair(space.handle(), result));
+  return result;
+}
+
+const InheritedDefaults::ConstructionSetChain& InheritedDefaults::constructionSetChain(const Space& space) const
+{
+  std::map<Handle, ConstructionSetChain>::const_iterator it = m_constructionSetChains.find(space.handle());
+  if (it != m_constructionSetChains.end()){
+    return it->second;
+  }
+
+  ConstructionSetChain chain;
+
+  // first check the space
+  boost::optional<DefaultConstructionSet> defaultConstructionSet = space.defaultConstructionSet();
+  if (defaultConstructionSet){
+    chain.push_back(std::make_pair(*defaultConstructionSet, 1));
+  }
+
+  // then check the space type, unless it is inherited from the building
+  boost::optional<SpaceType> spaceType = space.spaceType();
+  if (spaceType && !space.isSpaceTypeDefaulted()){
+    defaultConstructionSet = spaceType->defaultConstructionSet();
+    if (defaultConstructionSet){
+      chain.push_back(std::make_pair(*defaultConstructionSet, 2));
+    }
+  }
+
+  // then check the building story
+  boost::optional<BuildingStory> buildingStory = space.buildingStory();
+  if (buildingStory){
+    defaultConstructionSet = buildingStory->defaultConstructionSet();
+    if (defaultConstructionSet){
+      chain.push_back(std::make_pair(*defaultConstructionSet, 3));
+    }
+  }
+
+  // then the building and the building's space type
+  chain.insert(chain.end(), m_buildingConstructionSets.begin(), m_buildingConstructionSets.end());
+
+  return m_constructionSetChains.insert(std::make_pair(space.handle(), chain)).first->second;
+}
+
+const InheritedDefaults::ScheduleSetChain& InheritedDefaults::scheduleSetChain(const Space& space) const
+{
+  std::map<Handle, ScheduleSetChain>::const_iterator it = m_scheduleSetChains.find(space.handle());
+  if (it != m_scheduleSetChains.end()){
+    return it->second;
+  }
+
+  ScheduleSetChain chain;
+
+  // first check the space
+  boost::optional<DefaultScheduleSet> defaultScheduleSet = space.defaultScheduleSet();
+  if (defaultScheduleSet){
+    chain.push_back(*defaultScheduleSet);
+  }
+
+  // then check the space type
+  boost::optional<SpaceType> spaceType = space.spaceType();
+  if (spaceType){
+    defaultScheduleSet = spaceType->defaultScheduleSet();
+    if (defaultScheduleSet){
+      chain.push_back(*defaultScheduleSet);
+    }
+  }
+
+  // then check the building story
+  boost::optional<BuildingStory> buildingStory = space.buildingStory();
+  if (buildingStory){
+    defaultScheduleSet = buildingStory->defaultScheduleSet();
+    if (defaultScheduleSet){
+      chain.push_back(*defaultScheduleSet);
+    }
+  }
+
+  // then the building and the building's space type
+  chain.insert(chain.end(), m_buildingScheduleSets.begin(), m_buildingScheduleSets.end());
+
+  return m_scheduleSetChains.insert(std::make_pair(space.handle(), chain)).first->second;
+}
+
+} // model
+} // openstudio
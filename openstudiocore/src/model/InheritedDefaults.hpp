@@ -0,0 +1,119 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef MODEL_INHERITEDDEFAULTS_HPP
+#define MODEL_INHERITEDDEFAULTS_HPP
+
+#include <model/ModelAPI.hpp>
+#include <model/ConstructionBase.hpp>
+#include <model/DefaultConstructionSet.hpp>
+#include <model/DefaultScheduleSet.hpp>
+#include <model/Schedule.hpp>
+
+#include <utilities/core/UUID.hpp>
+#include <utilities/core/Logger.hpp>
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace openstudio {
+namespace model {
+
+class Model;
+class Space;
+class PlanarSurface;
+
+/** Effective totals of the loads in a Space, including the loads inherited from its SpaceType. */
+struct MODEL_API SpaceLoadTotals {
+  /** Same as Space::floorArea. */
+  double floorArea;
+  /** Same as Space::numberOfPeople. */
+  double numberOfPeople;
+  /** Same as Space::lightingPower. */
+  double lightingPower;
+  /** Same as Space::electricEquipmentPower. */
+  double electricEquipmentPower;
+  /** Same as Space::gasEquipmentPower. */
+  double gasEquipmentPower;
+
+  SpaceLoadTotals();
+};
+
+/** InheritedDefaults resolves the constructions, schedules and loads that surfaces and spaces
+ *  inherit through the Space, SpaceType, BuildingStory, Building and Building SpaceType
+ *  hierarchy. The Building level of the hierarchy is resolved once on construction, each Space's
+ *  default construction set and default schedule set search chain is resolved once on first use,
+ *  and all results are remembered. 
+ *
+ *  InheritedDefaults is a snapshot, it is not updated when the model changes. Model keeps a 
+ *  cached instance that is cleared on any change to the model, which is used by 
+ *  Space::getDefaultConstructionWithSearchDistance, Space::getDefaultSchedule and the Space 
+ *  floor area and load accessors. Code that 
+ *  resolves every surface or space in a model and changes the model as it goes (e.g. the 
+ *  EnergyPlus ForwardTranslator) should construct its own instance before making changes. */
+class MODEL_API InheritedDefaults {
+ public:
+
+  /** Resolves the Building level of the hierarchy in model. */
+  explicit InheritedDefaults(const Model& model);
+
+  /** Same as Space::getDefaultConstructionWithSearchDistance. */
+  boost::optional<std::pair<ConstructionBase, int> > getDefaultConstructionWithSearchDistance(
+      const Space& space, const PlanarSurface& planarSurface) const;
+
+  /** Same as PlanarSurface::constructionWithSearchDistance, a construction set directly on 
+   *  planarSurface has a search distance of 0. */
+  boost::optional<std::pair<ConstructionBase, int> > constructionWithSearchDistance(
+      const PlanarSurface& planarSurface) const;
+
+  /** Same as Space::getDefaultSchedule. */
+  boost::optional<Schedule> getDefaultSchedule(const Space& space,
+                                               const DefaultScheduleType& defaultScheduleType) const;
+
+  /** Returns the effective load totals for space, computing floor area and number of people once
+   *  for all of them. Space::floorArea, Space::numberOfPeople and the Space load power accessors 
+   *  return these totals from the Model's cached instance. */
+  SpaceLoadTotals spaceLoadTotals(const Space& space) const;
+
+ private:
+  REGISTER_LOGGER("openstudio.model.InheritedDefaults");
+
+  typedef std::vector<std::pair<DefaultConstructionSet, int> > ConstructionSetChain;
+  typedef std::vector<DefaultScheduleSet> ScheduleSetChain;
+
+  const ConstructionSetChain& constructionSetChain(const Space& space) const;
+  const ScheduleSetChain& scheduleSetChain(const Space& space) const;
+
+  // building and building space type sets, shared by every space
+  ConstructionSetChain m_buildingConstructionSets;
+  ScheduleSetChain m_buildingScheduleSets;
+
+  mutable std::map<Handle, ConstructionSetChain> m_constructionSetChains;
+  mutable std::map<Handle, ScheduleSetChain> m_scheduleSetChains;
+  mutable std::map<std::pair<Handle, Handle>, boost::optional<std::pair<ConstructionBase, int> > > m_defaultConstructions;
+  mutable std::map<Handle, SpaceLoadTotals> m_spaceLoadTotals;
+};
+
+} // model
+} // openstudio
+
+#endif // MODEL_INHERITEDDEFAULTS_HPP
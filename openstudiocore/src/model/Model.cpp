@@ -26,6 +26,7 @@
 #include <model/ResourceObject.hpp>
 #include <model/ResourceObject_Impl.hpp>
 #include <model/Connection.hpp>
+#include <model/InheritedDefaults.hpp>
 
 // central list of all concrete ModelObject header files (_Impl and non-_Impl)
 // needed here for ::createObject
@@ -159,6 +160,10 @@ namespace detail {
     OptionalLifeCycleCostParameters tclccp = m_cachedLifeCycleCostParameters;
     m_cachedLifeCycleCostParameters = otherImpl->m_cachedLifeCycleCostParameters;
     otherImpl->m_cachedLifeCycleCostParameters = tclccp;
+
+    // inherited defaults are resolved against the model's objects, do not swap
+    clearCachedInheritedDefaults();
+    otherImpl->clearCachedInheritedDefaults();
   }
 
   void Model_Impl::createComponentWatchers() {
@@ -711,6 +716,20 @@ if (_className::iddObjectType() == typeToCreate) { \
     return m_cachedLifeCycleCostParameters;
   }
 
+  const InheritedDefaults& Model_Impl::inheritedDefaults() const
+  {
+    if (!m_cachedInheritedDefaults){
+      m_cachedInheritedDefaults = boost::shared_ptr<InheritedDefaults>(new InheritedDefaults(this->model()));
+      bool connected = QObject::connect(this,
+                                        SIGNAL(onChange()),
+                                        this,
+                                        SLOT(clearCachedInheritedDefaults()));
+      BOOST_ASSERT(connected);
+    }
+
+    return *m_cachedInheritedDefaults;
+  }
+
   Schedule Model_Impl::alwaysOnDiscreteSchedule() const
   {
     std::string alwaysOnName("Always On Discrete");
@@ -1005,6 +1024,17 @@ if (_className::iddObjectType() == typeToCreate) { \
     m_cachedLifeCycleCostParameters.reset();
   }
 
+  void Model_Impl::clearCachedInheritedDefaults()
+  {
+    m_cachedInheritedDefaults.reset();
+
+    // reconnected when the cache is rebuilt
+    QObject::disconnect(this,
+                        SIGNAL(onChange()),
+                        this,
+                        SLOT(clearCachedInheritedDefaults()));
+  }
+
 } // detail
 
 Model::Model()
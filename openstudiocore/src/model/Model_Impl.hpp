@@ -52,6 +52,7 @@ class ModelObject;
 class Component;
 class ComponentData;
 class Schedule;
+class InheritedDefaults;
 
 namespace detail {
 
@@ -123,6 +124,10 @@ namespace detail {
      *  object which can be significantly faster than calling getOptionalUniqueModelObject<LifeCycleCostParameters>(). */
     boost::optional<LifeCycleCostParameters> lifeCycleCostParameters() const;
 
+    /** Get the InheritedDefaults for this model, this implementation uses a cached InheritedDefaults 
+     *  which is cleared on any change to the model. */
+    const InheritedDefaults& inheritedDefaults() const;
+
     Schedule alwaysOnDiscreteSchedule() const;
 
     //@}
@@ -181,6 +186,9 @@ namespace detail {
 
     virtual void reportInitialModelObjects();
 
+    /** Clears the cached InheritedDefaults, for changes made while signals are blocked. */
+    void clearCachedInheritedDefaults();
+
    signals:
 
     void initialModelObject(openstudio::model::detail::ModelObject_Impl* modelObject, IddObjectType iddObjectType, const openstudio::UUID& handle);
@@ -210,6 +218,7 @@ namespace detail {
 
     mutable boost::optional<Building> m_cachedBuilding;
     mutable boost::optional<LifeCycleCostParameters> m_cachedLifeCycleCostParameters;
+    mutable boost::shared_ptr<InheritedDefaults> m_cachedInheritedDefaults;
 
   private slots:
 
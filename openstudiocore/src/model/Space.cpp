@@ -22,6 +22,7 @@
 
 #include <model/Model.hpp>
 #include <model/Model_Impl.hpp>
+#include <model/InheritedDefaults.hpp>
 #include <model/Building.hpp>
 #include <model/Building_Impl.hpp>
 #include <model/SpaceType.hpp>
@@ -524,70 +525,8 @@ namespace detail {
 
   boost::optional<std::pair<ConstructionBase, int> > Space_Impl::getDefaultConstructionWithSearchDistance(const PlanarSurface& planarSurface) const
   {
-    boost::optional<ConstructionBase> result;
-    boost::optional<DefaultConstructionSet> defaultConstructionSet;
-    boost::optional<SpaceType> spaceType;
-    boost::optional<BuildingStory> buildingStory;
-    boost::optional<Building> building;
-
-    // first check this object
-    defaultConstructionSet = this->defaultConstructionSet();
-    if (defaultConstructionSet){
-      result = defaultConstructionSet->getDefaultConstruction(planarSurface);
-      if (result){
-        return std::make_pair<ConstructionBase, int>(*result, 1);
-      }
-    }
-
-    // then check space type
-    spaceType = this->spaceType();
-    if (spaceType && !this->isSpaceTypeDefaulted()){
-      defaultConstructionSet = spaceType->defaultConstructionSet();
-      if (defaultConstructionSet){
-        result = defaultConstructionSet->getDefaultConstruction(planarSurface);
-        if (result){
-          return std::make_pair<ConstructionBase, int>(*result, 2);
-        }
-      }
-    }
-
-    // then check building story
-    buildingStory = this->buildingStory();
-    if (buildingStory){
-      defaultConstructionSet = buildingStory->defaultConstructionSet();
-      if (defaultConstructionSet){
-        result = defaultConstructionSet->getDefaultConstruction(planarSurface);
-        if (result){
-          return std::make_pair<ConstructionBase, int>(*result, 3);
-        }
-      }
-    }
-
-    // then check building
-    building = this->model().building();
-    if (building){
-      defaultConstructionSet = building->defaultConstructionSet();
-      if (defaultConstructionSet){
-        result = defaultConstructionSet->getDefaultConstruction(planarSurface);
-        if (result){
-          return std::make_pair<ConstructionBase, int>(*result, 4);
-        }
-      }
-
-      // then check building's space type
-      spaceType = building->spaceType();
-      if (spaceType){
-        defaultConstructionSet = spaceType->defaultConstructionSet();
-        if (defaultConstructionSet){
-          result = defaultConstructionSet->getDefaultConstruction(planarSurface);
-          if (result){
-            return std::make_pair<ConstructionBase, int>(*result, 5);
-          }
-        }
-      }
-    }
-
-    return boost::none;
+    // the model caches the search chain through the space type, building story and building
+    return this->model().getImpl<detail::Model_Impl>()->inheritedDefaults().getDefaultConstructionWithSearchDistance(getObject<Space>(), planarSurface);
   }
 
   bool Space_Impl::setDefaultConstructionSet(const DefaultConstructionSet& defaultConstructionSet)
@@ -607,70 +546,8 @@ namespace detail {
 
   boost::optional<Schedule> Space_Impl::getDefaultSchedule(const DefaultScheduleType& defaultScheduleType) const
   {
-    boost::optional<Schedule> result;
-    boost::optional<DefaultScheduleSet> defaultScheduleSet;
-    boost::optional<SpaceType> spaceType;
-    boost::optional<BuildingStory> buildingStory;
-    boost::optional<Building> building;
-
-    // first check this object
-    defaultScheduleSet = this->defaultScheduleSet();
-    if (defaultScheduleSet){
-      result = defaultScheduleSet->getDefaultSchedule(defaultScheduleType);
-      if (result){
-        return result;
-      }
-    }
-
-    // then check space type
-    spaceType = this->spaceType();
-    if (spaceType){
-      defaultScheduleSet = spaceType->defaultScheduleSet();
-      if (defaultScheduleSet){
-        result = defaultScheduleSet->getDefaultSchedule(defaultScheduleType);
-        if (result){
-          return result;
-        }
-      }
-    }
-
-    // then check building story
-    buildingStory = this->buildingStory();
-    if (buildingStory){
-      defaultScheduleSet = buildingStory->defaultScheduleSet();
-      if (defaultScheduleSet){
-        result = defaultScheduleSet->getDefaultSchedule(defaultScheduleType);
-        if (result){
-          return result;
-        }
-      }
-    }
-
-    // then check building
-    building = this->model().building();
-    if (building){
-      defaultScheduleSet = building->defaultScheduleSet();
-      if (defaultScheduleSet){
-        result = defaultScheduleSet->getDefaultSchedule(defaultScheduleType);
-        if (result){
-          return result;
-        }
-      }
-
-      // then check building's space type
-      spaceType = building->spaceType();
-      if (spaceType){
-        defaultScheduleSet = spaceType->defaultScheduleSet();
-        if (defaultScheduleSet){
-          result = defaultScheduleSet->getDefaultSchedule(defaultScheduleType);
-          if (result){
-            return result;
-          }
-        }
-      }
-    }
-
-    return boost::none;
+    // the model caches the search chain through the space type, building story and building
+    return this->model().getImpl<detail::Model_Impl>()->inheritedDefaults().getDefaultSchedule(getObject<Space>(), defaultScheduleType);
   }
 
   bool Space_Impl::setDefaultScheduleSet(const DefaultScheduleSet& defaultScheduleSet)
@@ -857,14 +734,7 @@ namespace detail {
 
   double Space_Impl::floorArea() const
   {
-    double result = 0;
-    BOOST_FOREACH(const Surface& surface, this->surfaces()) {
-      if (istringEqual(surface.surfaceType(), "Floor"))
-      {
-        result += surface.grossArea();
-      }
-    }
-    return result;
+    return this->model().getImpl<detail::Model_Impl>()->inheritedDefaults().spaceLoadTotals(getObject<Space>()).floorArea;
   }
 
   double Space_Impl::exteriorArea() const {
@@ -910,20 +780,7 @@ namespace detail {
   }
 
   double Space_Impl::numberOfPeople() const {
-    double result = 0.0;
-    double area = floorArea();
-
-    BOOST_FOREACH(const People& person, this->people()) {
-      result += person.getNumberOfPeople(area);
-    }
-
-    if (OptionalSpaceType st = spaceType()){
-      BOOST_FOREACH(const People& person, st->people()) {
-        result += person.getNumberOfPeople(area);
-      }
-    }
-
-    return result;
+    return this->model().getImpl<detail::Model_Impl>()->inheritedDefaults().spaceLoadTotals(getObject<Space>()).numberOfPeople;
   }
 
   bool Space_Impl::setNumberOfPeople(double numberOfPeople) {
@@ -1131,27 +988,7 @@ namespace detail {
   }
 
   double Space_Impl::lightingPower() const {
-    double result(0.0);
-    double area = floorArea();
-    double numPeople = numberOfPeople();
-
-    BOOST_FOREACH(const Lights& light,lights()) {
-      result += light.getLightingPower(area,numPeople);
-    }
-    BOOST_FOREACH(const Luminaire& luminaire, luminaires()) {
-      result += luminaire.lightingPower();
-    }
-
-    if (OptionalSpaceType spaceType = this->spaceType()) {
-      BOOST_FOREACH(const Lights& light, spaceType->lights()) {
-        result += light.getLightingPower(area,numPeople);
-      }
-      BOOST_FOREACH(const Luminaire& luminaire, spaceType->luminaires()) {
-        result += luminaire.lightingPower();
-      }
-    }
-
-    return result;
+    return this->model().getImpl<detail::Model_Impl>()->inheritedDefaults().spaceLoadTotals(getObject<Space>()).lightingPower;
   }
 
   bool Space_Impl::setLightingPower(double lightingPower) {
@@ -1412,21 +1249,7 @@ namespace detail {
   }
 
   double Space_Impl::electricEquipmentPower() const {
-    double result(0.0);
-    double area = floorArea();
-    double numPeople = numberOfPeople();
-
-    BOOST_FOREACH(const ElectricEquipment& equipment,electricEquipment()) {
-      result += equipment.getDesignLevel(area,numPeople);
-    }
-
-    if (OptionalSpaceType spaceType = this->spaceType()) {
-      BOOST_FOREACH(const ElectricEquipment& equipment,spaceType->electricEquipment()) {
-        result += equipment.getDesignLevel(area,numPeople);
-      }
-    }
-
-    return result;
+    return this->model().getImpl<detail::Model_Impl>()->inheritedDefaults().spaceLoadTotals(getObject<Space>()).electricEquipmentPower;
   }
 
   bool Space_Impl::setElectricEquipmentPower(double electricEquipmentPower) {
@@ -1657,21 +1480,7 @@ namespace detail {
   }
 
   double Space_Impl::gasEquipmentPower() const {
-    double result(0.0);
-    double area = floorArea();
-    double numPeople = numberOfPeople();
-
-    BOOST_FOREACH(const GasEquipment& equipment,gasEquipment()) {
-      result += equipment.getDesignLevel(area,numPeople);
-    }
-
-    if (OptionalSpaceType spaceType = this->spaceType()) {
-      BOOST_FOREACH(const GasEquipment& equipment,spaceType->gasEquipment()) {
-        result += equipment.getDesignLevel(area,numPeople);
-      }
-    }
-
-    return result;
+    return this->model().getImpl<detail::Model_Impl>()->inheritedDefaults().spaceLoadTotals(getObject<Space>()).gasEquipmentPower;
   }
 
   bool Space_Impl::setGasEquipmentPower(double gasEquipmentPower) {
@@ -2104,6 +1913,66 @@ namespace detail {
     }
   }
 
+  // bounding box of surface in building coordinates
+  static BoundingBox surfaceBounds(const Surface& surface, const Transformation& transformation)
+  {
+    BoundingBox result;
+    result.addPoints(transformation*surface.vertices());
+    return result;
+  }
+
+  // appends the surfaces not yet in handles along with their bounding boxes in building coordinates
+  static void appendNewSurfaces(const std::vector<Surface>& allSurfaces,
+                                const Transformation& transformation,
+                                std::vector<Surface>& surfaces,
+                                std::vector<BoundingBox>& bounds,
+                                HandleSet& handles)
+  {
+    BOOST_FOREACH(const Surface& surface, allSurfaces){
+      if (handles.insert(surface.handle()).second){
+        surfaces.push_back(surface);
+        bounds.push_back(surfaceBounds(surface, transformation));
+      }
+    }
+  }
+
+  void Space_Impl::intersectSurfaces(Space& other)
+  {
+    if (this->handle() == other.handle()){
+      return;
+    }
+
+    Transformation transformation = this->transformation();
+    Transformation otherTransformation = other.transformation();
+
+    std::vector<Surface> surfaces;
+    std::vector<BoundingBox> bounds;
+    HandleSet handles;
+    appendNewSurfaces(this->surfaces(), transformation, surfaces, bounds, handles);
+
+    std::vector<Surface> otherSurfaces;
+    std::vector<BoundingBox> otherBounds;
+    HandleSet otherHandles;
+    appendNewSurfaces(other.surfaces(), otherTransformation, otherSurfaces, otherBounds, otherHandles);
+
+    // an intersection only shrinks the two surfaces involved and adds new pieces that lie within them,
+    // so pairs that have already been checked never need to be checked again; new pieces are appended
+    // to the end of each list and are reached later in the same scan
+    for (unsigned i = 0; i < surfaces.size(); ++i){
+      for (unsigned j = 0; j < otherSurfaces.size(); ++j){
+        if (!bounds[i].intersects(otherBounds[j])){
+          continue;
+        }
+        if (surfaces[i].intersect(otherSurfaces[j])){
+          bounds[i] = surfaceBounds(surfaces[i], transformation);
+          otherBounds[j] = surfaceBounds(otherSurfaces[j], otherTransformation);
+          appendNewSurfaces(this->surfaces(), transformation, surfaces, bounds, handles);
+          appendNewSurfaces(other.surfaces(), otherTransformation, otherSurfaces, otherBounds, otherHandles);
+        }
+      }
+    }
+  }
+
   std::vector<Surface> Space_Impl::findSurfaces(boost::optional<double> minDegreesFromNorth,
                                                 boost::optional<double> maxDegreesFromNorth,
                                                 boost::optional<double> minDegreesTilt,
@@ -3098,6 +2967,10 @@ void Space::matchSurfaces(Space& space) {
   getImpl<detail::Space_Impl>()->matchSurfaces(space);
 }
 
+void Space::intersectSurfaces(Space& space) {
+  getImpl<detail::Space_Impl>()->intersectSurfaces(space);
+}
+
 std::vector <Surface> Space::findSurfaces(boost::optional<double> minDegreesFromNorth,
                                           boost::optional<double> maxDegreesFromNorth,
                                           boost::optional<double> minDegreesTilt,
@@ -3142,6 +3015,23 @@ void unmatchSurfaces(std::vector<Space>& spaces)
   }
 }
 
+void intersectSurfaces(std::vector<Space>& spaces)
+{
+  std::vector<BoundingBox> bounds;
+  BOOST_FOREACH(const Space& space, spaces){
+    bounds.push_back(space.transformation()*space.boundingBox());
+  }
+
+  for (unsigned i = 0; i < spaces.size(); ++i){
+    for (unsigned j = i+1; j < spaces.size(); ++j){
+      if (!bounds[i].intersects(bounds[j])){
+        continue;
+      }
+      spaces[i].intersectSurfaces(spaces[j]);
+    }
+  }
+}
+
 } // model
 } // openstudio
 
@@ -496,6 +496,11 @@ class MODEL_API Space : public PlanarSurfaceGroup {
   /** Match surfaces and sub surfaces in this space with those in the other. */
   void matchSurfaces(Space& other);
 
+  /** Intersect each surface in this space with each surface in the other, splitting them so
+   *  that overlapping parts can be matched. Surfaces with sub surfaces or adjacent surfaces are
+   *  not intersected. */
+  void intersectSurfaces(Space& other);
+
   /** Find surfaces within angular range, specified in degrees and in the site coordinate system, an unset optional means no limit.
       Values for degrees from North are between 0 and 360 and for degrees tilt they are between 0 and 180.
       Note that maxDegreesFromNorth may be less than minDegreesFromNorth,
@@ -537,6 +542,9 @@ MODEL_API void matchSurfaces(std::vector<Space>& spaces);
 /** Un-match surfaces and sub surfaces within spaces. */
 MODEL_API void unmatchSurfaces(std::vector<Space>& spaces);
 
+/** Intersect surfaces within spaces. */
+MODEL_API void intersectSurfaces(std::vector<Space>& spaces);
+
 /** \relates Space*/
 typedef boost::optional<Space> OptionalSpace;
 
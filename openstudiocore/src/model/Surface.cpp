@@ -37,6 +37,7 @@
 
 #include <utilities/geometry/Transformation.hpp>
 #include <utilities/geometry/Geometry.hpp>
+#include <utilities/geometry/Intersection.hpp>
 #include <utilities/core/Assert.hpp>
 
 #include <utilities/sql/SqlFile.hpp>
@@ -789,6 +790,68 @@ namespace detail {
     }
   }
 
+  // transforms face vertices to the local system of a surface, keeping the surface's outward normal
+  static std::vector<Point3d> fromFaceVertices(const std::vector<Point3d>& faceVertices,
+                                               const Transformation& faceTransformation,
+                                               const Transformation& spaceTransformationInverse,
+                                               const Vector3d& outwardNormal)
+  {
+    std::vector<Point3d> buildingVertices = faceTransformation * faceVertices;
+    std::vector<Point3d> result = spaceTransformationInverse * buildingVertices;
+    boost::optional<Vector3d> newOutwardNormal = getOutwardNormal(result);
+    BOOST_ASSERT(newOutwardNormal);
+    if (outwardNormal.dot(*newOutwardNormal) < 0){
+      std::reverse(result.begin(), result.end());
+    }
+    return result;
+  }
+
+  // replaces surface by the remaining pieces and intersections given in face coordinates,
+  // returns the surfaces covering each intersection in order
+  static std::vector<Surface> splitSurface(Surface& surface,
+                                           const Space& space,
+                                           const std::vector<std::vector<Point3d> >& remainingFaceVertices,
+                                           const std::vector<std::vector<Point3d> >& intersectionFaceVertices,
+                                           const Transformation& faceTransformation,
+                                           const Transformation& spaceTransformationInverse)
+  {
+    // get surface's previous outward normal
+    Vector3d outwardNormal = surface.outwardNormal();
+    Model model = surface.model();
+
+    // surface keeps the first remaining piece, new surfaces are created for the others
+    for (unsigned i = 0; i < remainingFaceVertices.size(); ++i){
+      std::vector<Point3d> newVertices = fromFaceVertices(remainingFaceVertices[i], faceTransformation,
+                                                          spaceTransformationInverse, outwardNormal);
+      if (i == 0){
+        surface.setVertices(newVertices);
+      }else{
+        Surface newSurface(newVertices, model);
+        newSurface.setSpace(space);
+      }
+    }
+
+    std::vector<Surface> result;
+    for (unsigned i = 0; i < intersectionFaceVertices.size(); ++i){
+      if (remainingFaceVertices.empty() && (i == 0)){
+        // surface lies entirely within the other surface, no need to change its vertices
+        // unless the other surface splits it
+        if (intersectionFaceVertices.size() > 1){
+          surface.setVertices(fromFaceVertices(intersectionFaceVertices[i], faceTransformation,
+                                               spaceTransformationInverse, outwardNormal));
+        }
+        result.push_back(surface);
+      }else{
+        std::vector<Point3d> newVertices = fromFaceVertices(intersectionFaceVertices[i], faceTransformation,
+                                                            spaceTransformationInverse, outwardNormal);
+        Surface newSurface(newVertices, model);
+        newSurface.setSpace(space);
+        result.push_back(newSurface);
+      }
+    }
+    return result;
+  }
+
   bool Surface_Impl::intersect(Surface& otherSurface)
   {
     boost::optional<Space> space = this->space();
@@ -832,20 +895,16 @@ namespace detail {
     std::vector<Point3d> otherFaceVerticesReversed(otherFaceVertices);
     std::reverse(otherFaceVerticesReversed.begin(), otherFaceVerticesReversed.end());
 
-    QPolygonF facePolygon;
     BOOST_FOREACH(const Point3d& faceVertex, faceVertices){
       // should all have zero z coordinate now
-      facePolygon.push_back(QPointF(faceVertex.x(), faceVertex.y()));
       double z = faceVertex.z();
       if (abs(z) > 0.001){
         LOG(Warn, "Not all points on common plane");
       }
     }
 
-    QPolygonF otherFacePolygon;
     BOOST_FOREACH(const Point3d& otherFaceVertex, otherFaceVertices){
       // should all have zero z coordinate now
-      otherFacePolygon.push_back(QPointF(otherFaceVertex.x(), otherFaceVertex.y()));
       double z = otherFaceVertex.z();
       if (abs(z) > 0.001){
         LOG(Warn, "Not all points on common plane");
@@ -853,184 +912,44 @@ namespace detail {
     }
 
     // intersect the points in face coordinates, treats input polygon as implicitly closed just like E+
-    // the output polygon will be explicitly closed (e.g. last point == first point)
-    QPolygonF intersection = facePolygon.intersected(otherFacePolygon);
+    // uses the same tolerance as matchSurfaces so that the resulting surfaces can be matched
+    boost::optional<IntersectionResult> intersection = openstudio::intersect(faceVertices, otherFaceVertices, 0.001);
 
     // check if intersection is empty
-    if (intersection.empty()){
+    if (!intersection){
       return false;
     }
-    BOOST_ASSERT(intersection.size() >= 4);
 
     // non-zero intersection
-
-    // goes from building coordinates to local system 
-    Transformation spaceTransformationInverse = spaceTransformation.inverse();
-    Transformation otherSpaceTransformationInverse =  otherSpaceTransformation.inverse();
-
-    // calculate new face polygons
-    QPolygonF newFacePolygon = facePolygon.subtracted(intersection);
-    QPolygonF newOtherFacePolygon = otherFacePolygon.subtracted(intersection);
-
-    // calculate new vertices in face coordinates, do not add last point
-    std::vector<Point3d> intersectionVertices;
-    for (int i = 0; i < intersection.size() - 1; ++i){
-      intersectionVertices.push_back(Point3d(intersection[i].x(), intersection[i].y(), 0.0));
-    }
-
-    std::vector<Point3d> newFaceVertices;
-    for (int i = 0; i < newFacePolygon.size() - 1; ++i){
-      newFaceVertices.push_back(Point3d(newFacePolygon[i].x(), newFacePolygon[i].y(), 0.0));
-    }
-
-    std::vector<Point3d> newOtherFaceVertices;
-    for (int i = 0; i < newOtherFacePolygon.size() - 1; ++i){
-      newOtherFaceVertices.push_back(Point3d(newOtherFacePolygon[i].x(), newOtherFacePolygon[i].y(), 0.0));
-    }
+    std::vector<std::vector<Point3d> > intersectionVertices = intersection->intersections();
+    std::vector<std::vector<Point3d> > newFaceVertices = intersection->newPolygons1();
+    std::vector<std::vector<Point3d> > newOtherFaceVertices = intersection->newPolygons2();
 
     // check the different intersection possibilities
-    if (newFaceVertices.empty() && newOtherFaceVertices.empty()){
+    if (newFaceVertices.empty() && newOtherFaceVertices.empty() && (intersectionVertices.size() == 1)){
       // surfaces were the same
       this->setAdjacentSurface(otherSurface);
       return false;
+    }
 
-    }else if(newFaceVertices.empty()){
-      // one new surface created
-      BOOST_ASSERT(newOtherFaceVertices.size() >= 3);
-
-      // get other surface's previous outward normal
-      Vector3d otherOutwardNormal = otherSurface.outwardNormal();
-
-      // no need to change this surface's vertices
-
-      // change other surface's vertices
-      {
-        std::vector<Point3d> newOtherBuildingVertices = faceTransformation * newOtherFaceVertices;
-        std::vector<Point3d> newOtherVertices = otherSpaceTransformationInverse * newOtherBuildingVertices;
-        boost::optional<Vector3d> newOtherOutwardNormal = getOutwardNormal(newOtherVertices);
-        BOOST_ASSERT(newOtherOutwardNormal);
-        if (otherOutwardNormal.dot(*newOtherOutwardNormal) < 0){
-          std::reverse(newOtherVertices.begin(), newOtherVertices.end());
-        }
-        otherSurface.setVertices(newOtherVertices);
-      }
-
-      // create new surface in other space
-      {
-        std::vector<Point3d> newBuildingVertices = faceTransformation * intersectionVertices;
-        std::vector<Point3d> newVertices = otherSpaceTransformationInverse * newBuildingVertices;
-        boost::optional<Vector3d> newOutwardNormal = getOutwardNormal(newVertices);
-        BOOST_ASSERT(newOutwardNormal);
-        if (otherOutwardNormal.dot(*newOutwardNormal) < 0){
-          std::reverse(newVertices.begin(), newVertices.end());
-        }
-        Surface newSurface(newVertices, this->model());
-        newSurface.setSpace(*otherSpace);
-        
-        // match this surface to new surface in other space
-        this->setAdjacentSurface(newSurface);
-      }
-
-    }else if (newOtherFaceVertices.empty()){
-      // one new surface created
-      BOOST_ASSERT(newFaceVertices.size() >= 3);
-
-      // get this surface's previous outward normal
-      Vector3d outwardNormal = this->outwardNormal();
-
-      // no need to change other surface's vertices
-
-      // change this surface's vertices
-      {
-        std::vector<Point3d> newBuildingVertices = faceTransformation * newFaceVertices;
-        std::vector<Point3d> newVertices = spaceTransformationInverse * newBuildingVertices;
-        boost::optional<Vector3d> newOutwardNormal = getOutwardNormal(newVertices);
-        BOOST_ASSERT(newOutwardNormal);
-        if (outwardNormal.dot(*newOutwardNormal) < 0){
-          std::reverse(newVertices.begin(), newVertices.end());
-        }
-        this->setVertices(newVertices);
-      }
-
-      // create new surface in this space
-      {
-        std::vector<Point3d> newBuildingVertices = faceTransformation * intersectionVertices;
-        std::vector<Point3d> newVertices = spaceTransformationInverse * newBuildingVertices;
-        boost::optional<Vector3d> newOutwardNormal = getOutwardNormal(newVertices);
-        BOOST_ASSERT(newOutwardNormal);
-        if (outwardNormal.dot(*newOutwardNormal) < 0){
-          std::reverse(newVertices.begin(), newVertices.end());
-        }
-        Surface newSurface(newVertices, this->model());
-        newSurface.setSpace(*space);
-
-        // match other surface to new surface in this space
-        otherSurface.setAdjacentSurface(newSurface);
-      }
-
-    }else{
-      // two new surfaces created
-      BOOST_ASSERT(newFaceVertices.size() >= 3);
-      BOOST_ASSERT(newOtherFaceVertices.size() >= 3);
-
-      // get this surface's previous outward normal
-      Vector3d outwardNormal = this->outwardNormal();
-
-      // get other surface's previous outward normal
-      Vector3d otherOutwardNormal = otherSurface.outwardNormal();
-
-      // change this surface's vertices
-      {
-        std::vector<Point3d> newBuildingVertices = faceTransformation * newFaceVertices;
-        std::vector<Point3d> newVertices = spaceTransformationInverse * newBuildingVertices;
-        boost::optional<Vector3d> newOutwardNormal = getOutwardNormal(newVertices);
-        BOOST_ASSERT(newOutwardNormal);
-        if (outwardNormal.dot(*newOutwardNormal) < 0){
-          std::reverse(newVertices.begin(), newVertices.end());
-        }
-        this->setVertices(newVertices);
-      }
-
-      // change other surface's vertices
-      {
-        std::vector<Point3d> newOtherBuildingVertices = faceTransformation * newOtherFaceVertices;
-        std::vector<Point3d> newOtherVertices = otherSpaceTransformationInverse * newOtherBuildingVertices;
-        boost::optional<Vector3d> newOtherOutwardNormal = getOutwardNormal(newOtherVertices);
-        BOOST_ASSERT(newOtherOutwardNormal);
-        if (otherOutwardNormal.dot(*newOtherOutwardNormal) < 0){
-          std::reverse(newOtherVertices.begin(), newOtherVertices.end());
-        }
-        otherSurface.setVertices(newOtherVertices);
-      }
-
-      // create intersecting surfaces
-      {
-        // new surface in this space
-        std::vector<Point3d> newBuildingVertices = faceTransformation * intersectionVertices;
-        std::vector<Point3d> newVertices = spaceTransformationInverse * newBuildingVertices;
-        boost::optional<Vector3d> newOutwardNormal = getOutwardNormal(newVertices);
-        BOOST_ASSERT(newOutwardNormal);
-        if (outwardNormal.dot(*newOutwardNormal) < 0){
-          std::reverse(newVertices.begin(), newVertices.end());
-        }
-        Surface newSurface(newVertices, this->model());
-        newSurface.setSpace(*space);
-
-        // new surface in other space
-        std::vector<Point3d> newOtherBuildingVertices = faceTransformation * intersectionVertices;
-        std::vector<Point3d> newOtherVertices = otherSpaceTransformationInverse * newOtherBuildingVertices;
-        boost::optional<Vector3d> newOtherOutwardNormal = getOutwardNormal(newOtherVertices);
-        BOOST_ASSERT(newOtherOutwardNormal);
-        if (otherOutwardNormal.dot(*newOtherOutwardNormal) < 0){
-          std::reverse(newOtherVertices.begin(), newOtherVertices.end());
-        }
-        Surface newOtherSurface(newOtherVertices, this->model());
-        newOtherSurface.setSpace(*otherSpace);
-        
-        // match new surface in this space to new surface in other space
-        newSurface.setAdjacentSurface(newOtherSurface);
-      }
+    // goes from building coordinates to local system 
+    Transformation spaceTransformationInverse = spaceTransformation.inverse();
+    Transformation otherSpaceTransformationInverse =  otherSpaceTransformation.inverse();
 
+    // split both surfaces, each keeps either its first remaining piece or, if it lies entirely
+    // within the other surface, the intersection
+    Surface surface = getObject<Surface>();
+    std::vector<Surface> intersectionSurfaces = splitSurface(surface, *space,
+                                                             newFaceVertices, intersectionVertices,
+                                                             faceTransformation, spaceTransformationInverse);
+    std::vector<Surface> otherIntersectionSurfaces = splitSurface(otherSurface, *otherSpace,
+                                                                  newOtherFaceVertices, intersectionVertices,
+                                                                  faceTransformation, otherSpaceTransformationInverse);
+    BOOST_ASSERT(intersectionSurfaces.size() == otherIntersectionSurfaces.size());
+
+    // match the intersecting surfaces together
+    for (unsigned i = 0; i < intersectionSurfaces.size(); ++i){
+      intersectionSurfaces[i].setAdjacentSurface(otherIntersectionSurfaces[i]);
     }
 
     return true;
@@ -1254,6 +1254,9 @@ namespace detail {
 
     m.getImpl<QObject>()->blockSignals(false);
 
+    // the model did not signal the changes above
+    m.getImpl<detail::Model_Impl>()->clearCachedInheritedDefaults();
+
     return HVACComponent_Impl::remove();
   }
 
@@ -0,0 +1,190 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <model/test/ModelFixture.hpp>
+
+#include <model/Model.hpp>
+#include <model/Model_Impl.hpp>
+#include <model/InheritedDefaults.hpp>
+#include <model/Building.hpp>
+#include <model/Space.hpp>
+#include <model/SpaceType.hpp>
+#include <model/Surface.hpp>
+#include <model/DefaultConstructionSet.hpp>
+#include <model/DefaultSurfaceConstructions.hpp>
+#include <model/DefaultScheduleSet.hpp>
+#include <model/Construction.hpp>
+#include <model/ScheduleConstant.hpp>
+
+#include <utilities/geometry/Point3d.hpp>
+
+using namespace openstudio;
+using namespace openstudio::model;
+
+TEST_F(ModelFixture, InheritedDefaults_Constructions)
+{
+  Model model;
+  Building building = model.getUniqueModelObject<Building>();
+  Space space(model);
+  SpaceType spaceType(model);
+
+  Point3dVector points;
+  points.push_back(Point3d(0, 0, 0));
+  points.push_back(Point3d(0, 10, 0));
+  points.push_back(Point3d(10, 10, 0));
+  points.push_back(Point3d(10, 0, 0));
+  Surface surface(points, model);
+  EXPECT_TRUE(surface.setSpace(space));
+  EXPECT_EQ("Floor", surface.surfaceType());
+  EXPECT_EQ("Ground", surface.outsideBoundaryCondition());
+
+  Construction buildingConstruction(model);
+  DefaultSurfaceConstructions buildingSurfaceConstructions(model);
+  EXPECT_TRUE(buildingSurfaceConstructions.setFloorConstruction(buildingConstruction));
+  DefaultConstructionSet buildingConstructionSet(model);
+  EXPECT_TRUE(buildingConstructionSet.setDefaultGroundContactSurfaceConstructions(buildingSurfaceConstructions));
+
+  Construction spaceTypeConstruction(model);
+  DefaultSurfaceConstructions spaceTypeSurfaceConstructions(model);
+  DefaultConstructionSet spaceTypeConstructionSet(model);
+  EXPECT_TRUE(spaceTypeConstructionSet.setDefaultGroundContactSurfaceConstructions(spaceTypeSurfaceConstructions));
+  EXPECT_TRUE(spaceType.setDefaultConstructionSet(spaceTypeConstructionSet));
+
+  EXPECT_FALSE(surface.constructionWithSearchDistance());
+
+  EXPECT_TRUE(building.setDefaultConstructionSet(buildingConstructionSet));
+  ASSERT_TRUE(surface.constructionWithSearchDistance());
+  EXPECT_EQ(buildingConstruction.handle(), surface.constructionWithSearchDistance()->first.handle());
+  EXPECT_EQ(4, surface.constructionWithSearchDistance()->second);
+
+  // space type set has no floor construction yet
+  EXPECT_TRUE(space.setSpaceType(spaceType));
+  ASSERT_TRUE(surface.constructionWithSearchDistance());
+  EXPECT_EQ(4, surface.constructionWithSearchDistance()->second);
+
+  // changes below the space type are seen as well
+  EXPECT_TRUE(spaceTypeSurfaceConstructions.setFloorConstruction(spaceTypeConstruction));
+  ASSERT_TRUE(surface.constructionWithSearchDistance());
+  EXPECT_EQ(spaceTypeConstruction.handle(), surface.constructionWithSearchDistance()->first.handle());
+  EXPECT_EQ(2, surface.constructionWithSearchDistance()->second);
+
+  // a snapshot does not change with the model
+  InheritedDefaults inheritedDefaults(model);
+  ASSERT_TRUE(inheritedDefaults.constructionWithSearchDistance(surface));
+  EXPECT_EQ(2, inheritedDefaults.constructionWithSearchDistance(surface)->second);
+
+  space.resetSpaceType();
+  ASSERT_TRUE(surface.constructionWithSearchDistance());
+  EXPECT_EQ(buildingConstruction.handle(), surface.constructionWithSearchDistance()->first.handle());
+  EXPECT_EQ(4, surface.constructionWithSearchDistance()->second);
+  ASSERT_TRUE(inheritedDefaults.constructionWithSearchDistance(surface));
+  EXPECT_EQ(spaceTypeConstruction.handle(), inheritedDefaults.constructionWithSearchDistance(surface)->first.handle());
+  EXPECT_EQ(2, inheritedDefaults.constructionWithSearchDistance(surface)->second);
+
+  // building space type is searched after the building
+  EXPECT_TRUE(building.setSpaceType(spaceType));
+  EXPECT_TRUE(space.isSpaceTypeDefaulted());
+  building.resetDefaultConstructionSet();
+  ASSERT_TRUE(surface.constructionWithSearchDistance());
+  EXPECT_EQ(spaceTypeConstruction.handle(), surface.constructionWithSearchDistance()->first.handle());
+  EXPECT_EQ(5, surface.constructionWithSearchDistance()->second);
+
+  EXPECT_TRUE(surface.setConstruction(buildingConstruction));
+  ASSERT_TRUE(surface.constructionWithSearchDistance());
+  EXPECT_EQ(0, surface.constructionWithSearchDistance()->second);
+  ASSERT_TRUE(InheritedDefaults(model).constructionWithSearchDistance(surface));
+  EXPECT_EQ(0, InheritedDefaults(model).constructionWithSearchDistance(surface)->second);
+}
+
+TEST_F(ModelFixture, InheritedDefaults_Schedules)
+{
+  Model model;
+  Building building = model.getUniqueModelObject<Building>();
+  Space space(model);
+
+  ScheduleConstant buildingSchedule(model);
+  DefaultScheduleSet buildingScheduleSet(model);
+  EXPECT_TRUE(buildingScheduleSet.setHoursofOperationSchedule(buildingSchedule));
+
+  ScheduleConstant spaceSchedule(model);
+  DefaultScheduleSet spaceScheduleSet(model);
+
+  EXPECT_FALSE(space.getDefaultSchedule(DefaultScheduleType::HoursofOperationSchedule));
+
+  EXPECT_TRUE(building.setDefaultScheduleSet(buildingScheduleSet));
+  ASSERT_TRUE(space.getDefaultSchedule(DefaultScheduleType::HoursofOperationSchedule));
+  EXPECT_EQ(buildingSchedule.handle(), space.getDefaultSchedule(DefaultScheduleType::HoursofOperationSchedule)->handle());
+
+  EXPECT_TRUE(space.setDefaultScheduleSet(spaceScheduleSet));
+  ASSERT_TRUE(space.getDefaultSchedule(DefaultScheduleType::HoursofOperationSchedule));
+  EXPECT_EQ(buildingSchedule.handle(), space.getDefaultSchedule(DefaultScheduleType::HoursofOperationSchedule)->handle());
+
+  EXPECT_TRUE(spaceScheduleSet.setHoursofOperationSchedule(spaceSchedule));
+  ASSERT_TRUE(space.getDefaultSchedule(DefaultScheduleType::HoursofOperationSchedule));
+  EXPECT_EQ(spaceSchedule.handle(), space.getDefaultSchedule(DefaultScheduleType::HoursofOperationSchedule)->handle());
+
+  spaceSchedule.remove();
+  ASSERT_TRUE(space.getDefaultSchedule(DefaultScheduleType::HoursofOperationSchedule));
+  EXPECT_EQ(buildingSchedule.handle(), space.getDefaultSchedule(DefaultScheduleType::HoursofOperationSchedule)->handle());
+}
+
+TEST_F(ModelFixture, InheritedDefaults_SpaceLoadTotals)
+{
+  Model model;
+  Space space(model);
+  SpaceType spaceType(model);
+
+  Point3dVector points;
+  points.push_back(Point3d(0, 0, 0));
+  points.push_back(Point3d(0, 10, 0));
+  points.push_back(Point3d(10, 10, 0));
+  points.push_back(Point3d(10, 0, 0));
+  Surface surface(points, model);
+  EXPECT_TRUE(surface.setSpace(space));
+
+  EXPECT_TRUE(space.setPeoplePerFloorArea(0.05));
+  EXPECT_TRUE(spaceType.setLightingPowerPerFloorArea(10.0));
+  EXPECT_TRUE(space.setSpaceType(spaceType));
+  EXPECT_TRUE(space.setElectricEquipmentPowerPerFloorArea(5.0));
+  EXPECT_TRUE(space.setGasEquipmentPower(100.0));
+
+  SpaceLoadTotals totals = InheritedDefaults(model).spaceLoadTotals(space);
+  EXPECT_DOUBLE_EQ(space.floorArea(), totals.floorArea);
+  EXPECT_DOUBLE_EQ(space.numberOfPeople(), totals.numberOfPeople);
+  EXPECT_DOUBLE_EQ(space.lightingPower(), totals.lightingPower);
+  EXPECT_DOUBLE_EQ(space.electricEquipmentPower(), totals.electricEquipmentPower);
+  EXPECT_DOUBLE_EQ(space.gasEquipmentPower(), totals.gasEquipmentPower);
+
+  EXPECT_DOUBLE_EQ(100.0, totals.floorArea);
+  EXPECT_DOUBLE_EQ(5.0, totals.numberOfPeople);
+  EXPECT_DOUBLE_EQ(1000.0, totals.lightingPower);
+  EXPECT_DOUBLE_EQ(500.0, totals.electricEquipmentPower);
+  EXPECT_DOUBLE_EQ(100.0, totals.gasEquipmentPower);
+
+  // the Space accessors answer from the model's cache, which is cleared by changes
+  EXPECT_DOUBLE_EQ(1000.0, space.lightingPower());
+  EXPECT_TRUE(spaceType.setLightingPowerPerFloorArea(20.0));
+  EXPECT_DOUBLE_EQ(2000.0, space.lightingPower());
+  EXPECT_DOUBLE_EQ(20.0, space.lightingPowerPerFloorArea());
+  surface.remove();
+  EXPECT_DOUBLE_EQ(0.0, space.floorArea());
+  EXPECT_DOUBLE_EQ(0.0, space.lightingPower());
+}
@@ -758,6 +758,84 @@ TEST_F(ModelFixture, Space_SurfaceMatch_LargeTest)
   model.save(toPath("./Space_SurfaceMatch_LargeTest.osm"), true);
 }
 
+TEST_F(ModelFixture, Space_IntersectSurfaces_2Spaces)
+{
+  Model model;
+
+  Point3dVector floorPrint;
+  floorPrint.push_back(Point3d(0, 10, 0));
+  floorPrint.push_back(Point3d(10, 10, 0));
+  floorPrint.push_back(Point3d(10, 0, 0));
+  floorPrint.push_back(Point3d(0, 0, 0));
+  boost::optional<Space> space1 = Space::fromFloorPrint(floorPrint, 3, model);
+  ASSERT_TRUE(space1);
+  EXPECT_EQ(6u, space1->surfaces().size());
+
+  // smaller space in the middle of space1's east wall, splits that wall into three pieces
+  floorPrint.clear();
+  floorPrint.push_back(Point3d(10, 5, 0));
+  floorPrint.push_back(Point3d(15, 5, 0));
+  floorPrint.push_back(Point3d(15, 2, 0));
+  floorPrint.push_back(Point3d(10, 2, 0));
+  boost::optional<Space> space2 = Space::fromFloorPrint(floorPrint, 3, model);
+  ASSERT_TRUE(space2);
+  EXPECT_EQ(6u, space2->surfaces().size());
+
+  std::vector<Space> spaces;
+  spaces.push_back(*space1);
+  spaces.push_back(*space2);
+  intersectSurfaces(spaces);
+  matchSurfaces(spaces);
+
+  EXPECT_EQ(8u, space1->surfaces().size());
+  EXPECT_EQ(6u, space2->surfaces().size());
+
+  boost::optional<Surface> wall1;
+  BOOST_FOREACH(const Surface& surface, space1->surfaces()){
+    if (surface.adjacentSurface()){
+      EXPECT_FALSE(wall1);
+      wall1 = surface;
+    }else{
+      EXPECT_NE("Surface", surface.outsideBoundaryCondition()) << surface.surfaceType();
+    }
+  }
+  ASSERT_TRUE(wall1);
+  EXPECT_EQ("Wall", wall1->surfaceType());
+  EXPECT_EQ("Surface", wall1->outsideBoundaryCondition());
+  EXPECT_NEAR(9.0, wall1->grossArea(), 0.001);
+
+  boost::optional<Surface> wall2 = wall1->adjacentSurface();
+  ASSERT_TRUE(wall2);
+  ASSERT_TRUE(wall2->space());
+  EXPECT_EQ(space2->handle(), wall2->space()->handle());
+  ASSERT_TRUE(wall2->adjacentSurface());
+  EXPECT_EQ(wall1->handle(), wall2->adjacentSurface()->handle());
+  EXPECT_NEAR(9.0, wall2->grossArea(), 0.001);
+
+  // windows added to the intersected walls are matched too
+  Point3dVector points;
+  points.push_back(Point3d(10, 3, 2));
+  points.push_back(Point3d(10, 3, 1));
+  points.push_back(Point3d(10, 4, 1));
+  points.push_back(Point3d(10, 4, 2));
+  SubSurface window1(points, model);
+  EXPECT_TRUE(window1.setSurface(*wall1));
+
+  std::reverse(points.begin(), points.end());
+  SubSurface window2(points, model);
+  EXPECT_TRUE(window2.setSurface(*wall2));
+
+  EXPECT_FALSE(window1.adjacentSubSurface());
+  EXPECT_FALSE(window2.adjacentSubSurface());
+
+  matchSurfaces(spaces);
+
+  ASSERT_TRUE(window1.adjacentSubSurface());
+  EXPECT_EQ(window2.handle(), window1.adjacentSubSurface()->handle());
+  ASSERT_TRUE(window2.adjacentSubSurface());
+  EXPECT_EQ(window1.handle(), window2.adjacentSubSurface()->handle());
+}
+
 TEST_F(ModelFixture, Space_FindSurfaces)
 {
   Model model;
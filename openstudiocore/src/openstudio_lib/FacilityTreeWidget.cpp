@@ -18,7 +18,7 @@
 **********************************************************************/
 
 #include <openstudio_lib/FacilityTreeWidget.hpp>
-#include <openstudio_lib/ModelObjectTreeItems.hpp>
+#include <openstudio_lib/ModelObjectTreeModel.hpp>
 #include <openstudio_lib/ModelObjectItem.hpp>
 
 #include <model/Model.hpp>
@@ -57,13 +57,15 @@
 #include <QRadioButton>
 #include <QHeaderView>
 #include <QComboBox>
+#include <QTreeView>
+#include <QItemSelectionModel>
 
 #include <iostream>
 
 namespace openstudio {
 
 FacilityTreeWidget::FacilityTreeWidget(const model::Model& model, QWidget* parent )
-  : ModelObjectTreeWidget(model, parent), m_sortByType(IddObjectType::OS_BuildingStory)
+  : ModelObjectTreeWidget(model, parent), m_sortByType(IddObjectType::OS_BuildingStory), m_selectedItem(NULL)
 { 
   this->setObjectName("GrayWidget"); 
 
@@ -92,16 +94,15 @@ FacilityTreeWidget::FacilityTreeWidget(const model::Model& model, QWidget* paren
   BOOST_ASSERT(isConnected);
 
   this->vLayout()->insertLayout(0, vLayout);
-  this->treeWidget()->header()->close();
-  this->treeWidget()->setMinimumWidth(320);
-  this->treeWidget()->setIndentation(10);
-  this->treeWidget()->setSelectionBehavior(QAbstractItemView::SelectRows);
-  this->treeWidget()->setSelectionMode(QAbstractItemView::SingleSelection);
-  this->treeWidget()->setAlternatingRowColors(true);
-  this->treeWidget()->setColumnCount(1);
-
-  isConnected = connect(this->treeWidget(), SIGNAL(currentItemChanged(QTreeWidgetItem*, QTreeWidgetItem*)),
-                        this, SLOT(currentItemChanged(QTreeWidgetItem*, QTreeWidgetItem*)));
+  this->setTreeModel(new ModelObjectTreeModel(model, m_sortByType));
+  this->treeView()->setMinimumWidth(320);
+  this->treeView()->setIndentation(10);
+  this->treeView()->setSelectionBehavior(QAbstractItemView::SelectRows);
+  this->treeView()->setSelectionMode(QAbstractItemView::SingleSelection);
+  this->treeView()->setAlternatingRowColors(true);
+
+  isConnected = connect(this->treeView()->selectionModel(), SIGNAL(currentChanged(const QModelIndex&, const QModelIndex&)),
+                        this, SLOT(currentChanged(const QModelIndex&, const QModelIndex&)));
   BOOST_ASSERT(isConnected);
 
   // allow time for signals to be connected between this and inspector
@@ -118,64 +119,9 @@ boost::optional<openstudio::model::ModelObject> FacilityTreeWidget::selectedMode
   return m_selectedObject;
 }
 
-void FacilityTreeWidget::onObjectAdded(const openstudio::model::ModelObject& modelObject, const openstudio::IddObjectType& iddObjectType, const openstudio::Handle& handle)
+OSItem* FacilityTreeWidget::selectedItem() const
 {
-  if ((iddObjectType == IddObjectType::OS_Facility) ||
-      (iddObjectType == IddObjectType::OS_ShadingSurfaceGroup) ||
-      (iddObjectType == IddObjectType::OS_ShadingSurface) ||
-      (iddObjectType == IddObjectType::OS_Building) ||
-      (iddObjectType == IddObjectType::OS_BuildingStory) ||
-      (iddObjectType == IddObjectType::OS_ThermalZone) ||
-      (iddObjectType == IddObjectType::OS_SpaceType) ||
-      (iddObjectType == IddObjectType::OS_Space) ||
-      (iddObjectType == IddObjectType::OS_InteriorPartitionSurfaceGroup) ||
-      (iddObjectType == IddObjectType::OS_InteriorPartitionSurface) ||
-      (iddObjectType == IddObjectType::OS_Daylighting_Control) ||
-      (iddObjectType == IddObjectType::OS_IlluminanceMap) ||
-      (iddObjectType == IddObjectType::OS_InternalMass) ||
-      (iddObjectType == IddObjectType::OS_People) ||
-      (iddObjectType == IddObjectType::OS_Lights) ||
-      (iddObjectType == IddObjectType::OS_Luminaire) ||
-      (iddObjectType == IddObjectType::OS_ElectricEquipment) ||
-      (iddObjectType == IddObjectType::OS_GasEquipment) ||
-      (iddObjectType == IddObjectType::OS_SteamEquipment) ||
-      (iddObjectType == IddObjectType::OS_OtherEquipment) ||
-      (iddObjectType == IddObjectType::OS_SpaceInfiltration_DesignFlowRate) ||
-      (iddObjectType == IddObjectType::OS_SpaceInfiltration_EffectiveLeakageArea) ||
-      (iddObjectType == IddObjectType::OS_DesignSpecification_OutdoorAir)){
-
-    refresh();
-  }
-}
-
-void FacilityTreeWidget::onObjectRemoved(const openstudio::model::ModelObject& modelObject, const openstudio::IddObjectType& iddObjectType, const openstudio::Handle& handle)
-{
-  if ((iddObjectType == IddObjectType::OS_Facility) ||
-      (iddObjectType == IddObjectType::OS_ShadingSurfaceGroup) ||
-      (iddObjectType == IddObjectType::OS_ShadingSurface) ||
-      (iddObjectType == IddObjectType::OS_Building) ||
-      (iddObjectType == IddObjectType::OS_BuildingStory) ||
-      (iddObjectType == IddObjectType::OS_ThermalZone) ||
-      (iddObjectType == IddObjectType::OS_SpaceType) ||
-      (iddObjectType == IddObjectType::OS_Space) ||
-      (iddObjectType == IddObjectType::OS_InteriorPartitionSurfaceGroup) ||
-      (iddObjectType == IddObjectType::OS_InteriorPartitionSurface) ||
-      (iddObjectType == IddObjectType::OS_Daylighting_Control) ||
-      (iddObjectType == IddObjectType::OS_IlluminanceMap) ||
-      (iddObjectType == IddObjectType::OS_InternalMass) ||
-      (iddObjectType == IddObjectType::OS_People) ||
-      (iddObjectType == IddObjectType::OS_Lights) ||
-      (iddObjectType == IddObjectType::OS_Luminaire) ||
-      (iddObjectType == IddObjectType::OS_ElectricEquipment) ||
-      (iddObjectType == IddObjectType::OS_GasEquipment) ||
-      (iddObjectType == IddObjectType::OS_SteamEquipment) ||
-      (iddObjectType == IddObjectType::OS_OtherEquipment) ||
-      (iddObjectType == IddObjectType::OS_SpaceInfiltration_DesignFlowRate) ||
-      (iddObjectType == IddObjectType::OS_SpaceInfiltration_EffectiveLeakageArea) ||
-      (iddObjectType == IddObjectType::OS_DesignSpecification_OutdoorAir)){
-
-    refresh();
-  }
+  return m_selectedItem;
 }
 
 void FacilityTreeWidget::paintEvent ( QPaintEvent * event )
@@ -188,53 +134,57 @@ void FacilityTreeWidget::paintEvent ( QPaintEvent * event )
 
 void FacilityTreeWidget::onSortByChanged(const QString& text)
 {
+  IddObjectType sortByType = m_sortByType;
   if (text == "Building Story"){
-    if (m_sortByType != IddObjectType::OS_BuildingStory){
-      m_sortByType = IddObjectType::OS_BuildingStory;
-      this->treeWidget()->clear();
-      QTimer::singleShot(0, this, SLOT(initialize()));
-    }
+    sortByType = IddObjectType::OS_BuildingStory;
   }else if (text == "Thermal Zone"){
-    if (m_sortByType != IddObjectType::OS_ThermalZone){
-      m_sortByType = IddObjectType::OS_ThermalZone;
-      this->treeWidget()->clear();
-      QTimer::singleShot(0, this, SLOT(initialize()));
-    }
+    sortByType = IddObjectType::OS_ThermalZone;
   }else if (text == "Space Type"){
-    if (m_sortByType != IddObjectType::OS_SpaceType){
-      m_sortByType = IddObjectType::OS_SpaceType;
-      this->treeWidget()->clear();
-      QTimer::singleShot(0, this, SLOT(initialize()));
-    }
+    sortByType = IddObjectType::OS_SpaceType;
   }else{
     BOOST_ASSERT(false);
   }
+
+  if (m_sortByType != sortByType){
+    m_sortByType = sortByType;
+    this->treeModel()->setSortByType(m_sortByType);
+    QTimer::singleShot(0, this, SLOT(initialize()));
+  }
 }
 
-void FacilityTreeWidget::currentItemChanged(QTreeWidgetItem* current, QTreeWidgetItem* previous)
+void FacilityTreeWidget::currentChanged(const QModelIndex& current, const QModelIndex& previous)
 {
-  QTreeWidget* treeWidget = this->treeWidget();
+  ModelObjectTreeModel* treeModel = this->treeModel();
 
-  ModelObjectTreeItem* modelObjectTreeItem = dynamic_cast<ModelObjectTreeItem*>(current);
-  if(modelObjectTreeItem){
-    boost::optional<model::ModelObject> modelObject = modelObjectTreeItem->modelObject();
-    if (modelObject){
-      if (!modelObject->handle().isNull()){
-        if (m_selectedObjectHandle != modelObject->handle()){
-          m_selectedObject = modelObject;
-          m_selectedObjectHandle = modelObject->handle();
-          emit itemSelected(modelObjectTreeItem->item());
-        }
+  if (!current.isValid()){
+    return;
+  }
+
+  boost::optional<model::ModelObject> modelObject = treeModel->modelObject(current);
+  if (modelObject){
+    if (m_selectedObjectHandle != modelObject->handle()){
+      m_selectedObject = modelObject;
+      m_selectedObjectHandle = modelObject->handle();
+
+      OSItem* previousItem = m_selectedItem;
+      m_selectedItem = new ModelObjectItem(*modelObject, treeModel->isDefaulted(current), OSItem::LIST_ITEM, this);
+      m_selectedItem->setVisible(false);
+      if (previousItem){
+        previousItem->deleteLater();
       }
+
+      emit itemSelected(m_selectedItem);
+    }
+  }else{
+    // containers can not be selected, go back to the previous selection
+    QItemSelectionModel* selectionModel = this->treeView()->selectionModel();
+    bool wasBlocked = selectionModel->blockSignals(true);
+    if (previous.isValid()){
+      selectionModel->setCurrentIndex(previous, QItemSelectionModel::ClearAndSelect);
     }else{
-      current->setSelected(false);
-      if (previous){
-        bool wasBlocked = treeWidget->blockSignals(true);
-        treeWidget->setCurrentItem(previous);
-        previous->setSelected(true);
-        treeWidget->blockSignals(wasBlocked);
-      }
+      selectionModel->clear();
     }
+    selectionModel->blockSignals(wasBlocked);
   }
 }
 
@@ -242,22 +192,17 @@ void FacilityTreeWidget::initialize()
 {
   openstudio::model::Model model = this->model();
   model::Building building = model.getUniqueModelObject<model::Building>();
-  QTreeWidget* treeWidget = this->treeWidget();
+  ModelObjectTreeModel* treeModel = this->treeModel();
+  QTreeView* treeView = this->treeView();
 
-  // add site shading
-  SiteShadingTreeItem* siteShadingTreeItem = new SiteShadingTreeItem(model);
-  treeWidget->addTopLevelItem(siteShadingTreeItem);
+  // the building may have just been created, bring the tree up to date before selecting it
+  treeModel->refresh();
+  QModelIndex buildingIndex = treeModel->buildingIndex();
+  BOOST_ASSERT(buildingIndex.isValid());
 
-  // add building
-  BuildingTreeItem* buildingTreeItem = new BuildingTreeItem(building, m_sortByType);
-  treeWidget->addTopLevelItem(buildingTreeItem);
-
-  // set the selected object
-  treeWidget->setCurrentItem(buildingTreeItem);
-  m_selectedObject = building;
-  m_selectedObjectHandle = building.handle();
-  emit itemSelected(buildingTreeItem->item());
+  // set the selected object, this emits itemSelected
+  m_selectedObjectHandle.reset();
+  treeView->selectionModel()->setCurrentIndex(buildingIndex, QItemSelectionModel::ClearAndSelect);
 }
 
 } // openstudio
-
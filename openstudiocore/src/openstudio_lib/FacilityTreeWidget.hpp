@@ -23,7 +23,7 @@
 #include <openstudio_lib/ModelObjectTreeWidget.hpp>
 
 class QString;
-class QTreeWidgetItem;
+class QModelIndex;
 class QPaintEvent;
 
 namespace openstudio {
@@ -41,11 +41,9 @@ class FacilityTreeWidget : public ModelObjectTreeWidget
 
     boost::optional<openstudio::model::ModelObject> selectedModelObject() const;
 
-  protected:
-
-    virtual void onObjectAdded(const openstudio::model::ModelObject& modelObject, const openstudio::IddObjectType& iddObjectType, const openstudio::UUID& handle);
+    virtual OSItem* selectedItem() const;
 
-    virtual void onObjectRemoved(const openstudio::model::ModelObject& modelObject, const openstudio::IddObjectType& iddObjectType, const openstudio::UUID& handle);
+  protected:
 
     void paintEvent(QPaintEvent* event);
 
@@ -53,7 +51,7 @@ class FacilityTreeWidget : public ModelObjectTreeWidget
   
     void onSortByChanged(const QString& text);
 
-    void currentItemChanged(QTreeWidgetItem* current, QTreeWidgetItem* previous);
+    void currentChanged(const QModelIndex& current, const QModelIndex& previous);
 
     void initialize();
 
@@ -66,6 +64,8 @@ class FacilityTreeWidget : public ModelObjectTreeWidget
     boost::optional<openstudio::model::ModelObject> m_selectedObject;
 
     boost::optional<openstudio::Handle> m_selectedObjectHandle;
+
+    OSItem* m_selectedItem;
 };  
 
 } // openstudio
@@ -0,0 +1,777 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <openstudio_lib/ModelObjectTreeModel.hpp>
+#include <openstudio_lib/IconLibrary.hpp>
+
+#include <model/Model.hpp>
+#include <model/Model_Impl.hpp>
+#include <model/Building.hpp>
+#include <model/BuildingStory.hpp>
+#include <model/ThermalZone.hpp>
+#include <model/SpaceType.hpp>
+#include <model/Space.hpp>
+#include <model/ShadingSurfaceGroup.hpp>
+#include <model/ShadingSurface.hpp>
+#include <model/InteriorPartitionSurfaceGroup.hpp>
+#include <model/InteriorPartitionSurface.hpp>
+#include <model/Surface.hpp>
+#include <model/SubSurface.hpp>
+#include <model/DaylightingControl.hpp>
+#include <model/GlareSensor.hpp>
+#include <model/IlluminanceMap.hpp>
+#include <model/InternalMass.hpp>
+#include <model/People.hpp>
+#include <model/Lights.hpp>
+#include <model/Luminaire.hpp>
+#include <model/ElectricEquipment.hpp>
+#include <model/GasEquipment.hpp>
+#include <model/SteamEquipment.hpp>
+#include <model/OtherEquipment.hpp>
+#include <model/SpaceInfiltrationDesignFlowRate.hpp>
+#include <model/SpaceInfiltrationEffectiveLeakageArea.hpp>
+#include <model/DesignSpecificationOutdoorAir.hpp>
+
+#include <utilities/core/Assert.hpp>
+#include <utilities/core/Compare.hpp>
+#include <utilities/core/String.hpp>
+
+#include <QBrush>
+#include <QFont>
+#include <QIcon>
+#include <QPixmap>
+#include <QTimer>
+
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+namespace openstudio {
+
+namespace {
+
+  // appends objects to result sorted by name
+  template <class T>
+  void appendSorted(std::vector<model::ModelObject>& result, std::vector<T> objects)
+  {
+    std::sort(objects.begin(), objects.end(), WorkspaceObjectNameLess());
+    result.insert(result.end(), objects.begin(), objects.end());
+  }
+
+  std::vector<model::ModelObject> sorted(std::vector<model::ModelObject> objects)
+  {
+    std::sort(objects.begin(), objects.end(), WorkspaceObjectNameLess());
+    return objects;
+  }
+
+  // headers are drawn larger and bold, this matches the original tree widget
+  int headerLevel(ModelObjectTreeModel::NodeType type, ModelObjectTreeModel::NodeType parentType)
+  {
+    switch (type){
+      case ModelObjectTreeModel::SiteShadingNode:
+      case ModelObjectTreeModel::BuildingNode:
+        return 1;
+      case ModelObjectTreeModel::BuildingShadingNode:
+      case ModelObjectTreeModel::BuildingStoryNode:
+      case ModelObjectTreeModel::NoBuildingStoryNode:
+      case ModelObjectTreeModel::ThermalZoneNode:
+      case ModelObjectTreeModel::NoThermalZoneNode:
+      case ModelObjectTreeModel::SpaceTypeNode:
+      case ModelObjectTreeModel::NoSpaceTypeNode:
+        return 2;
+      case ModelObjectTreeModel::ShadingSurfaceGroupNode:
+        return (parentType == ModelObjectTreeModel::SiteShadingNode) ? 2 : 0;
+      default:
+        return 0;
+    }
+  }
+
+  bool isUnassignedNode(ModelObjectTreeModel::NodeType type)
+  {
+    return ((type == ModelObjectTreeModel::NoBuildingStoryNode) ||
+            (type == ModelObjectTreeModel::NoThermalZoneNode) ||
+            (type == ModelObjectTreeModel::NoSpaceTypeNode));
+  }
+
+  typedef std::pair<int, std::pair<Handle, std::string> > NodeKey;
+
+} // anonymous namespace
+
+struct ModelObjectTreeModel::ChildSpec
+{
+  ChildSpec(NodeType t_type, const std::string& t_name)
+    : type(t_type), name(t_name), isDefaulted(false)
+  {}
+
+  ChildSpec(NodeType t_type, const model::ModelObject& t_modelObject, bool t_isDefaulted)
+    : type(t_type), modelObject(t_modelObject), handle(t_modelObject.handle()), isDefaulted(t_isDefaulted)
+  {}
+
+  NodeKey key() const
+  {
+    return NodeKey(type, std::make_pair(handle, name));
+  }
+
+  NodeType type;
+  std::string name;
+  boost::optional<model::ModelObject> modelObject;
+  Handle handle;
+  bool isDefaulted;
+};
+
+struct ModelObjectTreeModel::Node
+{
+  Node(const ChildSpec& spec, Node* t_parent)
+    : type(spec.type), name(spec.name), modelObject(spec.modelObject), handle(spec.handle), isDefaulted(spec.isDefaulted),
+      parent(t_parent), row(0), fetched(false), hasChildren(-1)
+  {}
+
+  NodeKey key() const
+  {
+    return NodeKey(type, std::make_pair(handle, name));
+  }
+
+  NodeType type;
+  std::string name;
+  boost::optional<model::ModelObject> modelObject;
+  Handle handle;
+  bool isDefaulted;
+  Node* parent;
+  std::vector<Node*> children;
+  int row;
+  bool fetched;
+  // -1 if not known, cleared on refresh
+  int hasChildren;
+};
+
+ModelObjectTreeModel::ModelObjectTreeModel(const model::Model& model, const IddObjectType& sortByType, QObject* parent)
+  : QAbstractItemModel(parent), m_model(model), m_sortByType(sortByType), m_numNodes(0), m_refreshPending(false)
+{
+  m_root = new Node(ChildSpec(RootNode, std::string()), NULL);
+  fetchMore(QModelIndex());
+
+  // one connection to the workspace rather than several per object
+  bool isConnected = connect(m_model.getImpl<model::detail::Model_Impl>().get(),
+                             SIGNAL(onChange()),
+                             this,
+                             SLOT(onWorkspaceChange()));
+  BOOST_ASSERT(isConnected);
+}
+
+ModelObjectTreeModel::~ModelObjectTreeModel()
+{
+  deleteNode(m_root);
+}
+
+model::Model ModelObjectTreeModel::model() const
+{
+  return m_model;
+}
+
+IddObjectType ModelObjectTreeModel::sortByType() const
+{
+  return m_sortByType;
+}
+
+void ModelObjectTreeModel::setSortByType(const IddObjectType& sortByType)
+{
+  beginResetModel();
+
+  m_sortByType = sortByType;
+
+  BOOST_FOREACH(Node* child, m_root->children){
+    deleteNode(child);
+  }
+  m_root->children.clear();
+  m_root->fetched = true;
+
+  BOOST_FOREACH(const ChildSpec& spec, childSpecs(*m_root)){
+    m_root->children.push_back(new Node(spec, m_root));
+    ++m_numNodes;
+  }
+  updateRows(m_root);
+
+  endResetModel();
+}
+
+boost::optional<model::ModelObject> ModelObjectTreeModel::modelObject(const QModelIndex& index) const
+{
+  Node* n = node(index);
+  if (n->modelObject && !n->modelObject->handle().isNull()){
+    return n->modelObject;
+  }
+  return boost::none;
+}
+
+bool ModelObjectTreeModel::isDefaulted(const QModelIndex& index) const
+{
+  return node(index)->isDefaulted;
+}
+
+ModelObjectTreeModel::NodeType ModelObjectTreeModel::nodeType(const QModelIndex& index) const
+{
+  return node(index)->type;
+}
+
+QModelIndex ModelObjectTreeModel::buildingIndex() const
+{
+  BOOST_FOREACH(Node* child, m_root->children){
+    if (child->type == BuildingNode){
+      return indexOf(child);
+    }
+  }
+  return QModelIndex();
+}
+
+QModelIndex ModelObjectTreeModel::findIndex(const Handle& handle, const QModelIndex& parent) const
+{
+  if (handle.isNull()){
+    return QModelIndex();
+  }
+
+  Node* parentNode = node(parent);
+  BOOST_FOREACH(Node* child, parentNode->children){
+    if (child->handle == handle){
+      return indexOf(child);
+    }
+    QModelIndex result = findIndex(handle, indexOf(child));
+    if (result.isValid()){
+      return result;
+    }
+  }
+  return QModelIndex();
+}
+
+unsigned ModelObjectTreeModel::numNodes() const
+{
+  return m_numNodes;
+}
+
+QModelIndex ModelObjectTreeModel::index(int row, int column, const QModelIndex& parent) const
+{
+  if (!hasIndex(row, column, parent)){
+    return QModelIndex();
+  }
+  Node* parentNode = node(parent);
+  return createIndex(row, column, parentNode->children[row]);
+}
+
+QModelIndex ModelObjectTreeModel::parent(const QModelIndex& index) const
+{
+  if (!index.isValid()){
+    return QModelIndex();
+  }
+  return indexOf(node(index)->parent);
+}
+
+int ModelObjectTreeModel::rowCount(const QModelIndex& parent) const
+{
+  if (parent.column() > 0){
+    return 0;
+  }
+  return node(parent)->children.size();
+}
+
+int ModelObjectTreeModel::columnCount(const QModelIndex& parent) const
+{
+  return 1;
+}
+
+QVariant ModelObjectTreeModel::data(const QModelIndex& index, int role) const
+{
+  if (!index.isValid()){
+    return QVariant();
+  }
+
+  Node* n = node(index);
+  bool hasModelObject = (n->modelObject && !n->modelObject->handle().isNull());
+
+  if (role == Qt::DisplayRole){
+    if (n->modelObject){
+      if (hasModelObject){
+        return toQString(n->modelObject->name().get());
+      }
+      return QVariant();
+    }
+    return toQString(n->name);
+
+  }else if (role == Qt::DecorationRole){
+    if (n->modelObject){
+      static QIcon defaultIcon(":images/bug.png");
+      if (hasModelObject){
+        const QPixmap* pixMap = IconLibrary::Instance().findMiniIcon(n->modelObject->iddObjectType().value());
+        if (pixMap){
+          return QIcon(*pixMap);
+        }
+      }
+      return defaultIcon;
+    }
+    static QIcon folderIcon(":images/mini_icons/folder.png");
+    return folderIcon;
+
+  }else if (role == Qt::FontRole){
+    QFont font;
+    int level = headerLevel(n->type, n->parent->type);
+    if (level == 1){
+      font.setBold(true);
+      font.setPixelSize(14);
+    }else if (level == 2){
+      font.setBold(true);
+      font.setPixelSize(12);
+    }else{
+      font.setPixelSize(12);
+    }
+    return font;
+
+  }else if (role == Qt::ForegroundRole){
+    if (n->isDefaulted){
+      return QBrush(QColor("#006837"), Qt::SolidPattern);
+    }
+    if (isUnassignedNode(n->type) && nodeHasChildren(*n)){
+      return QBrush(QColor("#F15A24"), Qt::SolidPattern);
+    }
+    return QBrush(Qt::black, Qt::SolidPattern);
+  }
+
+  return QVariant();
+}
+
+Qt::ItemFlags ModelObjectTreeModel::flags(const QModelIndex& index) const
+{
+  if (!index.isValid()){
+    return Qt::NoItemFlags;
+  }
+
+  Node* n = node(index);
+  if (n->modelObject){
+    return Qt::ItemIsSelectable | Qt::ItemIsEnabled;
+  }
+  if (isUnassignedNode(n->type) && !nodeHasChildren(*n)){
+    return Qt::NoItemFlags;
+  }
+  return Qt::ItemIsEnabled;
+}
+
+bool ModelObjectTreeModel::hasChildren(const QModelIndex& parent) const
+{
+  if (parent.column() > 0){
+    return false;
+  }
+  return nodeHasChildren(*node(parent));
+}
+
+bool ModelObjectTreeModel::canFetchMore(const QModelIndex& parent) const
+{
+  Node* n = node(parent);
+  return (!n->fetched && (n->type != LeafNode));
+}
+
+void ModelObjectTreeModel::fetchMore(const QModelIndex& parent)
+{
+  Node* n = node(parent);
+  if (n->fetched){
+    return;
+  }
+  n->fetched = true;
+
+  std::vector<ChildSpec> specs = childSpecs(*n);
+  if (specs.empty()){
+    return;
+  }
+
+  beginInsertRows(parent, 0, specs.size() - 1);
+  BOOST_FOREACH(const ChildSpec& spec, specs){
+    n->children.push_back(new Node(spec, n));
+    ++m_numNodes;
+  }
+  updateRows(n);
+  endInsertRows();
+}
+
+void ModelObjectTreeModel::refresh()
+{
+  m_refreshPending = false;
+  refreshNode(m_root);
+}
+
+void ModelObjectTreeModel::onWorkspaceChange()
+{
+  // coalesce all changes made before control returns to the event loop
+  if (!m_refreshPending){
+    m_refreshPending = true;
+    QTimer::singleShot(0, this, SLOT(refresh()));
+  }
+}
+
+ModelObjectTreeModel::Node* ModelObjectTreeModel::node(const QModelIndex& index) const
+{
+  if (index.isValid()){
+    return static_cast<Node*>(index.internalPointer());
+  }
+  return m_root;
+}
+
+QModelIndex ModelObjectTreeModel::indexOf(Node* node) const
+{
+  if (!node || (node == m_root)){
+    return QModelIndex();
+  }
+  return createIndex(node->row, 0, node);
+}
+
+std::vector<ModelObjectTreeModel::ChildSpec> ModelObjectTreeModel::childSpecs(const Node& node) const
+{
+  std::vector<ChildSpec> result;
+  model::Model model = m_model;
+
+  switch (node.type){
+    case RootNode:
+      {
+        result.push_back(ChildSpec(SiteShadingNode, "Site Shading"));
+        boost::optional<model::Building> building = model.building();
+        if (building){
+          result.push_back(ChildSpec(BuildingNode, *building, false));
+        }
+      }
+      break;
+    case SiteShadingNode:
+    case BuildingShadingNode:
+      {
+        std::string shadingSurfaceType = (node.type == SiteShadingNode) ? "Site" : "Building";
+        std::vector<model::ModelObject> shadingSurfaceGroups;
+        BOOST_FOREACH(const model::ShadingSurfaceGroup& shadingSurfaceGroup, model.getModelObjects<model::ShadingSurfaceGroup>()){
+          if (istringEqual(shadingSurfaceType, shadingSurfaceGroup.shadingSurfaceType())){
+            shadingSurfaceGroups.push_back(shadingSurfaceGroup);
+          }
+        }
+        appendChildSpecs(result, sorted(shadingSurfaceGroups), ShadingSurfaceGroupNode, false);
+      }
+      break;
+    case ShadingSurfaceGroupNode:
+      {
+        std::vector<model::ModelObject> shadingSurfaces;
+        appendSorted(shadingSurfaces, node.modelObject->cast<model::ShadingSurfaceGroup>().shadingSurfaces());
+        appendChildSpecs(result, shadingSurfaces, LeafNode, false);
+      }
+      break;
+    case BuildingNode:
+      {
+        result.push_back(ChildSpec(BuildingShadingNode, "Building Shading"));
+
+        std::vector<model::ModelObject> children;
+        if (m_sortByType == IddObjectType::OS_BuildingStory){
+          result.push_back(ChildSpec(NoBuildingStoryNode, "Unassigned Building Story"));
+          appendSorted(children, model.getModelObjects<model::BuildingStory>());
+          appendChildSpecs(result, children, BuildingStoryNode, false);
+        }else if (m_sortByType == IddObjectType::OS_ThermalZone){
+          result.push_back(ChildSpec(NoThermalZoneNode, "Unassigned Thermal Zone"));
+          appendSorted(children, model.getModelObjects<model::ThermalZone>());
+          appendChildSpecs(result, children, ThermalZoneNode, false);
+        }else if (m_sortByType == IddObjectType::OS_SpaceType){
+          result.push_back(ChildSpec(NoSpaceTypeNode, "Unassigned Space Type"));
+          appendSorted(children, model.getModelObjects<model::SpaceType>());
+          appendChildSpecs(result, children, SpaceTypeNode, false);
+        }
+      }
+      break;
+    case BuildingStoryNode:
+    case ThermalZoneNode:
+      {
+        std::vector<model::ModelObject> spaces;
+        appendSorted(spaces, node.modelObject->getModelObjectSources<model::Space>());
+        appendChildSpecs(result, spaces, SpaceNode, false);
+      }
+      break;
+    case SpaceTypeNode:
+      {
+        // spaces that inherit this space type from the building come first
+        model::SpaceType spaceType = node.modelObject->cast<model::SpaceType>();
+        std::vector<model::ModelObject> defaultedSpaces;
+        BOOST_FOREACH(const model::Space& space, spaceType.spaces()){
+          if (space.isSpaceTypeDefaulted()){
+            defaultedSpaces.push_back(space);
+          }
+        }
+        appendChildSpecs(result, sorted(defaultedSpaces), SpaceNode, true);
+
+        std::vector<model::ModelObject> spaces;
+        appendSorted(spaces, spaceType.getModelObjectSources<model::Space>());
+        appendChildSpecs(result, spaces, SpaceNode, false);
+      }
+      break;
+    case NoBuildingStoryNode:
+    case NoThermalZoneNode:
+    case NoSpaceTypeNode:
+      {
+        std::vector<model::ModelObject> spaces;
+        BOOST_FOREACH(const model::Space& space, model.getModelObjects<model::Space>()){
+          if (((node.type == NoBuildingStoryNode) && !space.buildingStory()) ||
+              ((node.type == NoThermalZoneNode) && !space.thermalZone()) ||
+              ((node.type == NoSpaceTypeNode) && !space.spaceType())){
+            spaces.push_back(space);
+          }
+        }
+        appendChildSpecs(result, sorted(spaces), SpaceNode, false);
+      }
+      break;
+    case SpaceNode:
+      result.push_back(ChildSpec(RoofsNode, "Roof/Ceilings"));
+      result.push_back(ChildSpec(WallsNode, "Walls"));
+      result.push_back(ChildSpec(FloorsNode, "Floors"));
+      result.push_back(ChildSpec(SpaceShadingNode, "Space Shading"));
+      result.push_back(ChildSpec(InteriorPartitionsNode, "Interior Partitions"));
+      result.push_back(ChildSpec(DaylightingObjectsNode, "Daylighting Objects"));
+      result.push_back(ChildSpec(LoadsNode, "Loads"));
+      break;
+    case RoofsNode:
+    case WallsNode:
+    case FloorsNode:
+      {
+        std::string surfaceType = "RoofCeiling";
+        if (node.type == WallsNode){
+          surfaceType = "Wall";
+        }else if (node.type == FloorsNode){
+          surfaceType = "Floor";
+        }
+
+        std::vector<model::ModelObject> surfaces;
+        BOOST_FOREACH(const model::Surface& surface, node.parent->modelObject->cast<model::Space>().surfaces()){
+          if (istringEqual(surfaceType, surface.surfaceType())){
+            surfaces.push_back(surface);
+          }
+        }
+        appendChildSpecs(result, sorted(surfaces), SurfaceNode, false);
+      }
+      break;
+    case SurfaceNode:
+      {
+        std::vector<model::ModelObject> subSurfaces;
+        appendSorted(subSurfaces, node.modelObject->cast<model::Surface>().subSurfaces());
+        appendChildSpecs(result, subSurfaces, LeafNode, false);
+      }
+      break;
+    case SpaceShadingNode:
+      {
+        std::vector<model::ModelObject> shadingSurfaceGroups;
+        appendSorted(shadingSurfaceGroups, node.parent->modelObject->cast<model::Space>().shadingSurfaceGroups());
+        appendChildSpecs(result, shadingSurfaceGroups, ShadingSurfaceGroupNode, false);
+      }
+      break;
+    case InteriorPartitionsNode:
+      {
+        std::vector<model::ModelObject> interiorPartitionSurfaceGroups;
+        appendSorted(interiorPartitionSurfaceGroups, node.parent->modelObject->cast<model::Space>().interiorPartitionSurfaceGroups());
+        appendChildSpecs(result, interiorPartitionSurfaceGroups, InteriorPartitionSurfaceGroupNode, false);
+      }
+      break;
+    case InteriorPartitionSurfaceGroupNode:
+      {
+        std::vector<model::ModelObject> interiorPartitionSurfaces;
+        appendSorted(interiorPartitionSurfaces, node.modelObject->cast<model::InteriorPartitionSurfaceGroup>().interiorPartitionSurfaces());
+        appendChildSpecs(result, interiorPartitionSurfaces, LeafNode, false);
+      }
+      break;
+    case DaylightingObjectsNode:
+      {
+        model::Space space = node.parent->modelObject->cast<model::Space>();
+        std::vector<model::ModelObject> daylightingObjects;
+        appendSorted(daylightingObjects, space.daylightingControls());
+        std::vector<model::GlareSensor> glareSensors = space.glareSensors();
+        daylightingObjects.insert(daylightingObjects.end(), glareSensors.begin(), glareSensors.end());
+        appendSorted(daylightingObjects, space.illuminanceMaps());
+        appendChildSpecs(result, daylightingObjects, LeafNode, false);
+      }
+      break;
+    case LoadsNode:
+      {
+        model::Space space = node.parent->modelObject->cast<model::Space>();
+        boost::optional<model::DesignSpecificationOutdoorAir> designSpecificationOutdoorAir = space.designSpecificationOutdoorAir();
+
+        // loads inherited from the space type come first
+        boost::optional<model::SpaceType> spaceType = space.spaceType();
+        if (spaceType){
+          std::vector<model::ModelObject> loads;
+          if (designSpecificationOutdoorAir && space.isDesignSpecificationOutdoorAirDefaulted()){
+            loads.push_back(*designSpecificationOutdoorAir);
+          }
+          appendSorted(loads, spaceType->spaceInfiltrationDesignFlowRates());
+          appendSorted(loads, spaceType->spaceInfiltrationEffectiveLeakageAreas());
+          appendSorted(loads, spaceType->people());
+          appendSorted(loads, spaceType->lights());
+          appendSorted(loads, spaceType->luminaires());
+          appendSorted(loads, spaceType->electricEquipment());
+          appendSorted(loads, spaceType->gasEquipment());
+          appendSorted(loads, spaceType->steamEquipment());
+          appendSorted(loads, spaceType->otherEquipment());
+          appendSorted(loads, spaceType->internalMass());
+          appendChildSpecs(result, loads, LeafNode, true);
+        }
+
+        std::vector<model::ModelObject> loads;
+        if (designSpecificationOutdoorAir && !space.isDesignSpecificationOutdoorAirDefaulted()){
+          loads.push_back(*designSpecificationOutdoorAir);
+        }
+        appendSorted(loads, space.spaceInfiltrationDesignFlowRates());
+        appendSorted(loads, space.spaceInfiltrationEffectiveLeakageAreas());
+        appendSorted(loads, space.people());
+        appendSorted(loads, space.lights());
+        appendSorted(loads, space.luminaires());
+        appendSorted(loads, space.electricEquipment());
+        appendSorted(loads, space.gasEquipment());
+        appendSorted(loads, space.steamEquipment());
+        appendSorted(loads, space.otherEquipment());
+        appendSorted(loads, space.internalMass());
+        appendChildSpecs(result, loads, LeafNode, false);
+      }
+      break;
+    case LeafNode:
+      break;
+    default:
+      BOOST_ASSERT(false);
+  }
+
+  return result;
+}
+
+void ModelObjectTreeModel::appendChildSpecs(std::vector<ChildSpec>& result, 
+                                            const std::vector<model::ModelObject>& modelObjects, 
+                                            NodeType type, 
+                                            bool isDefaulted)
+{
+  BOOST_FOREACH(const model::ModelObject& modelObject, modelObjects){
+    result.push_back(ChildSpec(type, modelObject, isDefaulted));
+  }
+}
+
+bool ModelObjectTreeModel::nodeHasChildren(const Node& node) const
+{
+  if (node.fetched){
+    return !node.children.empty();
+  }
+  if (node.type == LeafNode){
+    return false;
+  }
+  if (!node.modelObject && !isUnassignedNode(node.type)){
+    // other containers always show an expansion indicator
+    return true;
+  }
+  if (node.hasChildren < 0){
+    const_cast<Node&>(node).hasChildren = childSpecs(node).empty() ? 0 : 1;
+  }
+  return (node.hasChildren == 1);
+}
+
+void ModelObjectTreeModel::refreshNode(Node* node)
+{
+  node->hasChildren = -1;
+  if (!node->fetched){
+    return;
+  }
+
+  // a removed parent has no children, it is about to be removed itself
+  std::vector<ChildSpec> specs;
+  if (!node->modelObject || !node->modelObject->handle().isNull()){
+    if (!node->parent || !node->parent->modelObject || !node->parent->modelObject->handle().isNull()){
+      specs = childSpecs(*node);
+    }
+  }
+
+  QModelIndex parentIndex = indexOf(node);
+
+  // remove children that are no longer wanted
+  std::set<NodeKey> wanted;
+  BOOST_FOREACH(const ChildSpec& spec, specs){
+    wanted.insert(spec.key());
+  }
+  for (int i = static_cast<int>(node->children.size()) - 1; i >= 0; --i){
+    if (wanted.find(node->children[i]->key()) == wanted.end()){
+      beginRemoveRows(parentIndex, i, i);
+      deleteNode(node->children[i]);
+      node->children.erase(node->children.begin() + i);
+      updateRows(node);
+      endRemoveRows();
+    }
+  }
+
+  // insert new children and move existing ones so the order matches
+  for (unsigned i = 0; i < specs.size(); ++i){
+    NodeKey key = specs[i].key();
+    if ((i < node->children.size()) && (node->children[i]->key() == key)){
+      node->children[i]->isDefaulted = specs[i].isDefaulted;
+      continue;
+    }
+
+    int j = -1;
+    for (unsigned k = i + 1; k < node->children.size(); ++k){
+      if (node->children[k]->key() == key){
+        j = k;
+        break;
+      }
+    }
+
+    if (j >= 0){
+      beginMoveRows(parentIndex, j, j, parentIndex, i);
+      Node* moved = node->children[j];
+      node->children.erase(node->children.begin() + j);
+      node->children.insert(node->children.begin() + i, moved);
+      moved->isDefaulted = specs[i].isDefaulted;
+      updateRows(node);
+      endMoveRows();
+    }else{
+      beginInsertRows(parentIndex, i, i);
+      node->children.insert(node->children.begin() + i, new Node(specs[i], node));
+      ++m_numNodes;
+      updateRows(node);
+      endInsertRows();
+    }
+  }
+
+  BOOST_ASSERT(node->children.size() == specs.size());
+
+  if (!node->children.empty()){
+    // names, inheritance and unassigned highlighting may all have changed
+    emit dataChanged(indexOf(node->children.front()), indexOf(node->children.back()));
+  }
+
+  BOOST_FOREACH(Node* child, node->children){
+    refreshNode(child);
+  }
+}
+
+void ModelObjectTreeModel::deleteNode(Node* node)
+{
+  BOOST_FOREACH(Node* child, node->children){
+    deleteNode(child);
+  }
+  if (node != m_root){
+    --m_numNodes;
+  }
+  delete node;
+}
+
+void ModelObjectTreeModel::updateRows(Node* node)
+{
+  for (unsigned i = 0; i < node->children.size(); ++i){
+    node->children[i]->row = i;
+  }
+}
+
+} // openstudio
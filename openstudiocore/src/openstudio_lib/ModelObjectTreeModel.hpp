@@ -0,0 +1,174 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef OPENSTUDIO_MODELOBJECTTREEMODEL_H
+#define OPENSTUDIO_MODELOBJECTTREEMODEL_H
+
+#include <model/Model.hpp>
+#include <model/ModelObject.hpp>
+
+#include <utilities/idd/IddEnums.hxx>
+
+#include <QAbstractItemModel>
+
+#include <boost/optional.hpp>
+
+#include <string>
+#include <vector>
+
+namespace openstudio {
+
+/** ModelObjectTreeModel presents the site shading, building, building stories (or thermal zones, 
+ *  or space types), spaces, surfaces and space loads of a Model as a tree for a QTreeView. 
+ *
+ *  Children of a node are only created when a view fetches them, i.e. when the node is expanded, 
+ *  and the model holds no widgets and makes no per object connections. Instead it listens to the
+ *  Workspace onChange signal and refreshes the fetched part of the tree once per pass of the 
+ *  event loop, no matter how many objects changed. */
+class ModelObjectTreeModel : public QAbstractItemModel
+{
+  Q_OBJECT
+
+  public:
+
+    enum NodeType {
+      RootNode,
+      SiteShadingNode,
+      BuildingNode,
+      BuildingShadingNode,
+      BuildingStoryNode,
+      NoBuildingStoryNode,
+      ThermalZoneNode,
+      NoThermalZoneNode,
+      SpaceTypeNode,
+      NoSpaceTypeNode,
+      SpaceNode,
+      RoofsNode,
+      WallsNode,
+      FloorsNode,
+      SurfaceNode,
+      SpaceShadingNode,
+      ShadingSurfaceGroupNode,
+      InteriorPartitionsNode,
+      InteriorPartitionSurfaceGroupNode,
+      DaylightingObjectsNode,
+      LoadsNode,
+      LeafNode
+    };
+
+    /// sortByType is one of OS_BuildingStory, OS_ThermalZone or OS_SpaceType
+    ModelObjectTreeModel(const model::Model& model, const IddObjectType& sortByType, QObject* parent = 0);
+
+    virtual ~ModelObjectTreeModel();
+
+    model::Model model() const;
+
+    IddObjectType sortByType() const;
+
+    /// rebuilds the tree, collapsing all nodes
+    void setSortByType(const IddObjectType& sortByType);
+
+    /// returns the model object at index, if any
+    boost::optional<model::ModelObject> modelObject(const QModelIndex& index) const;
+
+    /// returns true if the model object at index is inherited rather than directly assigned
+    bool isDefaulted(const QModelIndex& index) const;
+
+    NodeType nodeType(const QModelIndex& index) const;
+
+    /// returns the index of the building node
+    QModelIndex buildingIndex() const;
+
+    /// returns the index of the node for the model object with handle under parent, 
+    /// only nodes that have already been fetched are searched
+    QModelIndex findIndex(const Handle& handle, const QModelIndex& parent = QModelIndex()) const;
+
+    /// returns the number of nodes that have been created, not counting the root
+    unsigned numNodes() const;
+
+    /** @name QAbstractItemModel */
+    //@{
+
+    virtual QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const;
+
+    virtual QModelIndex parent(const QModelIndex& index) const;
+
+    virtual int rowCount(const QModelIndex& parent = QModelIndex()) const;
+
+    virtual int columnCount(const QModelIndex& parent = QModelIndex()) const;
+
+    virtual QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
+
+    virtual Qt::ItemFlags flags(const QModelIndex& index) const;
+
+    virtual bool hasChildren(const QModelIndex& parent = QModelIndex()) const;
+
+    virtual bool canFetchMore(const QModelIndex& parent) const;
+
+    virtual void fetchMore(const QModelIndex& parent);
+
+    //@}
+
+  public slots:
+
+    /// brings the fetched part of the tree up to date with the model
+    void refresh();
+
+  private slots:
+
+    void onWorkspaceChange();
+
+  private:
+
+    struct Node;
+    struct ChildSpec;
+
+    Node* node(const QModelIndex& index) const;
+
+    QModelIndex indexOf(Node* node) const;
+
+    std::vector<ChildSpec> childSpecs(const Node& node) const;
+
+    static void appendChildSpecs(std::vector<ChildSpec>& result, 
+                                 const std::vector<model::ModelObject>& modelObjects, 
+                                 NodeType type, 
+                                 bool isDefaulted);
+
+    bool nodeHasChildren(const Node& node) const;
+
+    void refreshNode(Node* node);
+
+    void deleteNode(Node* node);
+
+    static void updateRows(Node* node);
+
+    model::Model m_model;
+
+    IddObjectType m_sortByType;
+
+    Node* m_root;
+
+    unsigned m_numNodes;
+
+    bool m_refreshPending;
+};
+
+} // openstudio
+
+#endif // OPENSTUDIO_MODELOBJECTTREEMODEL_H
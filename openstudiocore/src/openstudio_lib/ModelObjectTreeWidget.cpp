@@ -18,48 +18,30 @@
 **********************************************************************/
 
 #include <openstudio_lib/ModelObjectTreeWidget.hpp>
-#include <openstudio_lib/ModelObjectTreeItems.hpp>
+#include <openstudio_lib/ModelObjectTreeModel.hpp>
 
 #include <model/Model.hpp>
-#include <model/Model_Impl.hpp>
-#include <model/ModelObject.hpp>
-#include <model/ModelObject_Impl.hpp>
 
 #include <QVBoxLayout>
-#include <QTreeWidget>
-#include <QPainter>
-#include <QTimer>
+#include <QTreeView>
 
 namespace openstudio {
 
 ModelObjectTreeWidget::ModelObjectTreeWidget(const model::Model& model, QWidget* parent )
-  : OSItemSelector(parent), m_model(model)
+  : OSItemSelector(parent), m_treeModel(NULL), m_model(model)
 { 
   m_vLayout = new QVBoxLayout();
   m_vLayout->setContentsMargins(0,7,0,0);
   m_vLayout->setSpacing(7);
   setLayout(m_vLayout);
 
-  m_treeWidget = new QTreeWidget(parent);
-  m_treeWidget->setStyleSheet("QTreeWidget { border: none; border-top: 1px solid black; }");
-  m_treeWidget->setAttribute(Qt::WA_MacShowFocusRect,0);
+  m_treeView = new QTreeView(parent);
+  m_treeView->setStyleSheet("QTreeView { border: none; border-top: 1px solid black; }");
+  m_treeView->setAttribute(Qt::WA_MacShowFocusRect,0);
+  m_treeView->setHeaderHidden(true);
+  m_treeView->setUniformRowHeights(true);
   
-  m_vLayout->addWidget(m_treeWidget);
-
-  bool isConnected = false;
-  isConnected = connect(model.getImpl<model::detail::Model_Impl>().get(), 
-                        SIGNAL(addWorkspaceObject(boost::shared_ptr<openstudio::detail::WorkspaceObject_Impl>, const openstudio::IddObjectType&, const openstudio::UUID&)),
-                        this,
-                        SLOT(objectAdded(boost::shared_ptr<openstudio::detail::WorkspaceObject_Impl>, const openstudio::IddObjectType&, const openstudio::UUID&)),
-                        Qt::QueuedConnection);
-  BOOST_ASSERT(isConnected);
-
-  isConnected = connect(model.getImpl<model::detail::Model_Impl>().get(), 
-                        SIGNAL(removeWorkspaceObject(boost::shared_ptr<openstudio::detail::WorkspaceObject_Impl>, const openstudio::IddObjectType&, const openstudio::UUID&)),
-                        this,
-                        SLOT(objectRemoved(boost::shared_ptr<openstudio::detail::WorkspaceObject_Impl>, const openstudio::IddObjectType&, const openstudio::UUID&)),
-                        Qt::QueuedConnection);
-  BOOST_ASSERT(isConnected);
+  m_vLayout->addWidget(m_treeView);
 }
 
 OSItem* ModelObjectTreeWidget::selectedItem() const
@@ -68,9 +50,14 @@ OSItem* ModelObjectTreeWidget::selectedItem() const
   return NULL;
 }
 
-QTreeWidget* ModelObjectTreeWidget::treeWidget() const
+QTreeView* ModelObjectTreeWidget::treeView() const
+{
+  return m_treeView;
+}
+
+ModelObjectTreeModel* ModelObjectTreeWidget::treeModel() const
 {
-  return m_treeWidget;
+  return m_treeModel;
 }
 
 QVBoxLayout* ModelObjectTreeWidget::vLayout() const
@@ -83,30 +70,17 @@ openstudio::model::Model ModelObjectTreeWidget::model() const
   return m_model;
 }
 
-void ModelObjectTreeWidget::objectAdded(boost::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl, const openstudio::IddObjectType& iddObjectType, const openstudio::UUID& handle)
+void ModelObjectTreeWidget::setTreeModel(ModelObjectTreeModel* treeModel)
 {
-  onObjectAdded(impl->getObject<model::ModelObject>(), iddObjectType, handle);
-}
+  ModelObjectTreeModel* oldTreeModel = m_treeModel;
 
-void ModelObjectTreeWidget::objectRemoved(boost::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl, const openstudio::IddObjectType& iddObjectType, const openstudio::UUID& handle)
-{
-  onObjectRemoved(impl->getObject<model::ModelObject>(), iddObjectType, handle);
-}
+  m_treeModel = treeModel;
+  m_treeModel->setParent(this);
+  m_treeView->setModel(m_treeModel);
 
-void ModelObjectTreeWidget::refresh()
-{
-  int N = m_treeWidget->topLevelItemCount();
-  for (int i = 0; i < N; ++i){
-    QTreeWidgetItem* treeItem = m_treeWidget->topLevelItem(i);
-    ModelObjectTreeItem* modelObjectTreeItem = dynamic_cast<ModelObjectTreeItem*>(treeItem);
-    if(modelObjectTreeItem){
-      if (!modelObjectTreeItem->isDirty()){
-        modelObjectTreeItem->makeDirty();
-        QTimer::singleShot(0, modelObjectTreeItem, SLOT(refresh()));
-      }
-    }
+  if (oldTreeModel){
+    oldTreeModel->deleteLater();
   }
 }
 
 } // openstudio
-
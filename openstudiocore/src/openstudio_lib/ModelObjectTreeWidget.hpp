@@ -24,12 +24,14 @@
 
 #include <model/Model.hpp>
 
-class QTreeWidget;
+class QTreeView;
 
 class QVBoxLayout;
 
 namespace openstudio {
 
+class ModelObjectTreeModel;
+
 class ModelObjectTreeWidget : public OSItemSelector
 {
   Q_OBJECT
@@ -42,7 +44,10 @@ class ModelObjectTreeWidget : public OSItemSelector
 
     virtual OSItem* selectedItem() const;
 
-    QTreeWidget* treeWidget() const;
+    QTreeView* treeView() const;
+
+    /// the tree model shown in treeView, owned by this widget
+    ModelObjectTreeModel* treeModel() const;
 
     QVBoxLayout* vLayout() const;
 
@@ -50,21 +55,14 @@ class ModelObjectTreeWidget : public OSItemSelector
 
   protected:
 
-    virtual void onObjectAdded(const openstudio::model::ModelObject& modelObject, const openstudio::IddObjectType& iddObjectType, const openstudio::UUID& handle) = 0;
-
-    virtual void onObjectRemoved(const openstudio::model::ModelObject& modelObject, const openstudio::IddObjectType& iddObjectType, const openstudio::UUID& handle) = 0;
-
-    void refresh();
-
-  private slots:
-
-    void objectAdded(boost::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl, const openstudio::IddObjectType& iddObjectType, const openstudio::UUID& handle);
-
-    void objectRemoved(boost::shared_ptr<openstudio::detail::WorkspaceObject_Impl> impl, const openstudio::IddObjectType& iddObjectType, const openstudio::UUID& handle);
+    /// takes ownership of treeModel and shows it in treeView
+    void setTreeModel(ModelObjectTreeModel* treeModel);
 
   private:
 
-    QTreeWidget* m_treeWidget;
+    QTreeView* m_treeView;
+
+    ModelObjectTreeModel* m_treeModel;
 
     QVBoxLayout* m_vLayout;
 
@@ -74,4 +72,3 @@ class ModelObjectTreeWidget : public OSItemSelector
 } // openstudio
 
 #endif // OPENSTUDIO_MODELOBJECTTREEWIDGET_H
-
@@ -0,0 +1,158 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <openstudio_lib/test/OpenStudioLibFixture.hpp>
+
+#include <openstudio_lib/ModelObjectTreeModel.hpp>
+
+#include <model/Model.hpp>
+#include <model/Building.hpp>
+#include <model/BuildingStory.hpp>
+#include <model/Space.hpp>
+
+#include <QCoreApplication>
+
+using namespace openstudio;
+using namespace openstudio::model;
+
+TEST_F(OpenStudioLibFixture, ModelObjectTreeModel_LazyFetch)
+{
+  Model model;
+  Building building = model.getUniqueModelObject<Building>();
+  std::vector<BuildingStory> stories;
+  for (unsigned i = 0; i < 10; ++i){
+    BuildingStory story(model);
+    stories.push_back(story);
+    for (unsigned j = 0; j < 10; ++j){
+      Space space(model);
+      EXPECT_TRUE(space.setBuildingStory(story));
+    }
+  }
+
+  ModelObjectTreeModel treeModel(model, IddObjectType::OS_BuildingStory);
+
+  // only site shading and building are created up front
+  EXPECT_EQ(2, treeModel.rowCount());
+  EXPECT_EQ(2u, treeModel.numNodes());
+
+  QModelIndex buildingIndex = treeModel.buildingIndex();
+  ASSERT_TRUE(buildingIndex.isValid());
+  EXPECT_EQ(ModelObjectTreeModel::BuildingNode, treeModel.nodeType(buildingIndex));
+  ASSERT_TRUE(treeModel.modelObject(buildingIndex));
+  EXPECT_EQ(building.handle(), treeModel.modelObject(buildingIndex)->handle());
+  EXPECT_TRUE(treeModel.hasChildren(buildingIndex));
+  EXPECT_TRUE(treeModel.canFetchMore(buildingIndex));
+  EXPECT_EQ(0, treeModel.rowCount(buildingIndex));
+
+  // building shading, unassigned stories and ten stories
+  treeModel.fetchMore(buildingIndex);
+  EXPECT_FALSE(treeModel.canFetchMore(buildingIndex));
+  ASSERT_EQ(12, treeModel.rowCount(buildingIndex));
+  EXPECT_EQ(14u, treeModel.numNodes());
+
+  // no space is unassigned so that node has no children and is disabled
+  QModelIndex noStoryIndex = treeModel.index(1, 0, buildingIndex);
+  EXPECT_EQ(ModelObjectTreeModel::NoBuildingStoryNode, treeModel.nodeType(noStoryIndex));
+  EXPECT_FALSE(treeModel.hasChildren(noStoryIndex));
+  EXPECT_EQ(Qt::NoItemFlags, treeModel.flags(noStoryIndex));
+
+  QModelIndex storyIndex = treeModel.findIndex(stories[0].handle());
+  ASSERT_TRUE(storyIndex.isValid());
+  EXPECT_EQ(ModelObjectTreeModel::BuildingStoryNode, treeModel.nodeType(storyIndex));
+  EXPECT_TRUE(treeModel.hasChildren(storyIndex));
+  treeModel.fetchMore(storyIndex);
+  EXPECT_EQ(10, treeModel.rowCount(storyIndex));
+  EXPECT_EQ(24u, treeModel.numNodes());
+
+  // collapsing the building by resorting throws away all fetched nodes
+  treeModel.setSortByType(IddObjectType::OS_SpaceType);
+  EXPECT_EQ(2u, treeModel.numNodes());
+}
+
+TEST_F(OpenStudioLibFixture, ModelObjectTreeModel_Refresh)
+{
+  Model model;
+  model.getUniqueModelObject<Building>();
+  BuildingStory story(model);
+  Space space1(model);
+  EXPECT_TRUE(space1.setBuildingStory(story));
+
+  ModelObjectTreeModel treeModel(model, IddObjectType::OS_BuildingStory);
+  QModelIndex buildingIndex = treeModel.buildingIndex();
+  treeModel.fetchMore(buildingIndex);
+  QModelIndex storyIndex = treeModel.findIndex(story.handle());
+  ASSERT_TRUE(storyIndex.isValid());
+  treeModel.fetchMore(storyIndex);
+  EXPECT_EQ(1, treeModel.rowCount(storyIndex));
+
+  // a space added to the story shows up on refresh
+  Space space2(model);
+  EXPECT_TRUE(space2.setBuildingStory(story));
+  treeModel.refresh();
+  EXPECT_EQ(2, treeModel.rowCount(storyIndex));
+
+  // an unassigned space makes the unassigned node available
+  Space space3(model);
+  treeModel.refresh();
+  QModelIndex noStoryIndex = treeModel.index(1, 0, buildingIndex);
+  EXPECT_TRUE(treeModel.hasChildren(noStoryIndex));
+  EXPECT_NE(Qt::NoItemFlags, treeModel.flags(noStoryIndex));
+
+  // renames are reflected in the data
+  EXPECT_TRUE(space1.setName("Space A"));
+  treeModel.refresh();
+  QModelIndex space1Index = treeModel.findIndex(space1.handle(), storyIndex);
+  ASSERT_TRUE(space1Index.isValid());
+  EXPECT_EQ("Space A", treeModel.data(space1Index).toString().toStdString());
+
+  // removed spaces go away
+  Handle space2Handle = space2.handle();
+  space1.remove();
+  space2.remove();
+  treeModel.refresh();
+  EXPECT_EQ(0, treeModel.rowCount(storyIndex));
+  EXPECT_FALSE(treeModel.findIndex(space2Handle).isValid());
+}
+
+TEST_F(OpenStudioLibFixture, ModelObjectTreeModel_CoalescedRefresh)
+{
+  Model model;
+  model.getUniqueModelObject<Building>();
+  BuildingStory story(model);
+
+  ModelObjectTreeModel treeModel(model, IddObjectType::OS_BuildingStory);
+  QModelIndex buildingIndex = treeModel.buildingIndex();
+  treeModel.fetchMore(buildingIndex);
+  QModelIndex storyIndex = treeModel.findIndex(story.handle());
+  ASSERT_TRUE(storyIndex.isValid());
+  treeModel.fetchMore(storyIndex);
+  EXPECT_EQ(0, treeModel.rowCount(storyIndex));
+
+  // many changes are applied in a single refresh once the event loop runs
+  for (unsigned i = 0; i < 20; ++i){
+    Space space(model);
+    EXPECT_TRUE(space.setBuildingStory(story));
+  }
+  EXPECT_EQ(0, treeModel.rowCount(storyIndex));
+
+  QCoreApplication::processEvents();
+  EXPECT_EQ(20, treeModel.rowCount(storyIndex));
+}
@@ -58,12 +58,14 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/bind.hpp>
 #include <boost/filesystem/fstream.hpp>
+#include <boost/thread.hpp>
 
 namespace openstudio {
 namespace osversion {
 
 VersionTranslator::VersionTranslator()
-  : m_originalVersion("0.0.0")
+  : m_originalVersion("0.0.0"),
+    m_allowInMemoryUpdates(true)
 {
   m_logSink.setLogLevel(Warn);
   m_logSink.setChannelRegex(boost::regex("openstudio\\.osversion\\.VersionTranslator"));
@@ -73,21 +75,34 @@ VersionTranslator::VersionTranslator()
   // target version).
   //   - For all but latest version, these are non-trivial transformations between two subsequent
   //     versions.
-  //   - For the latest version, start with the defaultUpdate method, and then switch it out for a
-  //     non-trivial transformation if necessary. If the previous update was also trivial, just
-  //     replace that version number with the new one. (At most there should only be one occurance
-  //     of defaultUpdate in this list.)
+  //   - For the latest version, start with the defaultInMemoryUpdate method, and then switch it 
+  //     out for a non-trivial transformation if necessary. If the previous update was also 
+  //     trivial, just replace that version number with the new one. (At most there should only 
+  //     be one occurance of defaultInMemoryUpdate in these lists.)
+  //   - Transformations that edit field values, or add and drop whole objects, go in 
+  //     m_inMemoryUpdateMethods. These clone the objects into the new IDD (see cloneObjectsToIdd)
+  //     rather than printing and reparsing the file, and return boost::none if any object's 
+  //     structure changed. In that case update falls back on the text method registered in 
+  //     m_updateMethods for the same target version, or on defaultUpdate if there is none, so 
+  //     each in-memory method must leave no side effects behind when it returns boost::none.
+  //   - Transformations that add, remove or reorder fields within an object only go in 
+  //     m_updateMethods.
+  m_inMemoryUpdateMethods[VersionString("0.7.2")] = &VersionTranslator::updateInMemory_0_7_1_to_0_7_2;
   m_updateMethods[VersionString("0.7.2")] = &VersionTranslator::update_0_7_1_to_0_7_2;
-  m_updateMethods[VersionString("0.7.3")] = &VersionTranslator::update_0_7_2_to_0_7_3;
+  m_inMemoryUpdateMethods[VersionString("0.7.3")] = &VersionTranslator::update_0_7_2_to_0_7_3;
   m_updateMethods[VersionString("0.7.4")] = &VersionTranslator::update_0_7_3_to_0_7_4;
   m_updateMethods[VersionString("0.9.2")] = &VersionTranslator::update_0_9_1_to_0_9_2;
+  m_inMemoryUpdateMethods[VersionString("0.9.6")] = &VersionTranslator::updateInMemory_0_9_5_to_0_9_6;
   m_updateMethods[VersionString("0.9.6")] = &VersionTranslator::update_0_9_5_to_0_9_6;
+  m_inMemoryUpdateMethods[VersionString("0.11.1")] = &VersionTranslator::updateInMemory_0_11_0_to_0_11_1;
   m_updateMethods[VersionString("0.11.1")] = &VersionTranslator::update_0_11_0_to_0_11_1;
   m_updateMethods[VersionString("0.11.2")] = &VersionTranslator::update_0_11_1_to_0_11_2;
+  m_inMemoryUpdateMethods[VersionString("0.11.5")] = &VersionTranslator::updateInMemory_0_11_4_to_0_11_5;
   m_updateMethods[VersionString("0.11.5")] = &VersionTranslator::update_0_11_4_to_0_11_5;
   m_updateMethods[VersionString("0.11.6")] = &VersionTranslator::update_0_11_5_to_0_11_6;
+  m_inMemoryUpdateMethods[VersionString("1.0.2")] = &VersionTranslator::updateInMemory_1_0_1_to_1_0_2;
   m_updateMethods[VersionString("1.0.2")] = &VersionTranslator::update_1_0_1_to_1_0_2;
-  m_updateMethods[VersionString("1.0.3")] = &VersionTranslator::defaultUpdate;
+  m_inMemoryUpdateMethods[VersionString("1.0.3")] = &VersionTranslator::defaultInMemoryUpdate;
 
   // List of previous versions that may be updated to this one.
   //   - To increment the translator, add an entry for the version just released (branched for
@@ -184,6 +199,94 @@ boost::optional<model::Component> VersionTranslator::loadComponent(std::istream&
   return boost::none;
 }
 
+namespace {
+
+  // Pulls indices off of the shared work list until it is empty. Each thread has its own 
+  // VersionTranslator, and so its own log sink.
+  void updateFilesWorker(const std::vector<openstudio::path>& inputPaths,
+                         const std::vector<openstudio::path>& outputPaths,
+                         std::vector<bool>& results,
+                         unsigned& next,
+                         boost::mutex& mutex)
+  {
+    VersionTranslator translator;
+    while (true) {
+      unsigned i(0);
+      {
+        boost::mutex::scoped_lock lock(mutex);
+        if (next >= inputPaths.size()) {
+          break;
+        }
+        i = next++;
+      }
+
+      bool ok(false);
+      try {
+        if (getFileExtension(inputPaths[i]) == componentFileExtension()) {
+          if (model::OptionalComponent component = translator.loadComponent(inputPaths[i])) {
+            ok = component->save(outputPaths[i],true);
+          }
+        }
+        else if (model::OptionalModel model = translator.loadModel(inputPaths[i])) {
+          ok = model->save(outputPaths[i],true);
+        }
+      }
+      catch (std::exception&) {}
+
+      // std::vector<bool> packs its elements, so writes must be serialized
+      boost::mutex::scoped_lock lock(mutex);
+      results[i] = ok;
+    }
+  }
+
+}
+
+std::vector<bool> VersionTranslator::updateFiles(const std::vector<openstudio::path>& inputPaths,
+                                                 const std::vector<openstudio::path>& outputPaths,
+                                                 unsigned numThreads)
+{
+  std::vector<bool> result(inputPaths.size(),false);
+  if (outputPaths.size() != inputPaths.size()) {
+    LOG(Error,"Cannot update files because " << inputPaths.size() << " input paths were paired "
+        << "with " << outputPaths.size() << " output paths.");
+    return result;
+  }
+  if (inputPaths.empty()) {
+    return result;
+  }
+
+  if (numThreads == 0u) {
+    numThreads = std::max(1u,boost::thread::hardware_concurrency());
+  }
+  numThreads = std::min(numThreads,unsigned(inputPaths.size()));
+
+  // make sure the singleton is constructed before the workers start using it
+  IddFactory::instance();
+
+  unsigned next(0);
+  boost::mutex mutex;
+  boost::thread_group threads;
+  for (unsigned i = 0; i < numThreads; ++i) {
+    threads.create_thread(boost::bind(updateFilesWorker,
+                                      boost::cref(inputPaths),
+                                      boost::cref(outputPaths),
+                                      boost::ref(result),
+                                      boost::ref(next),
+                                      boost::ref(mutex)));
+  }
+  threads.join_all();
+
+  return result;
+}
+
+bool VersionTranslator::allowInMemoryUpdates() const {
+  return m_allowInMemoryUpdates;
+}
+
+void VersionTranslator::setAllowInMemoryUpdates(bool allowInMemoryUpdates) {
+  m_allowInMemoryUpdates = allowInMemoryUpdates;
+}
+
 VersionString VersionTranslator::originalVersion() const {
   return m_originalVersion;
 }
@@ -382,48 +485,154 @@ void VersionTranslator::update(const VersionString& startVersion) {
   std::map<VersionString, IdfFile>::const_iterator start = m_map.find(startVersion);
   if (start != m_map.end()) {
 
-    std::string translatedIdf;
-    VersionString lastVersion("0.0.0");
-    boost::optional<IddFileAndFactoryWrapper> oIddFile;
+    // find the first update method (text or in-memory) that targets a later version
+    boost::optional<VersionString> targetVersion;
     for (std::map<VersionString, OSVersionUpdater>::const_iterator it = m_updateMethods.begin(),
          itEnd = m_updateMethods.end(); it != itEnd; ++it)
     {
-      // make sure map iteration is behaving as expected
-      BOOST_ASSERT(lastVersion < it->first);
-      lastVersion = it->first;
       if (startVersion < it->first) {
-        oIddFile = getIddFile(it->first);
-        translatedIdf = it->second(this,start->second,*oIddFile);
+        targetVersion = it->first;
+        break;
+      }
+    }
+    for (std::map<VersionString, OSVersionInMemoryUpdater>::const_iterator it = m_inMemoryUpdateMethods.begin(),
+         itEnd = m_inMemoryUpdateMethods.end(); it != itEnd; ++it)
+    {
+      if (startVersion < it->first) {
+        if (!targetVersion || (it->first < *targetVersion)) {
+          targetVersion = it->first;
+        }
         break;
       }
     }
+    if (!targetVersion) {
+      LOG(Error,"Unable to complete translation from " << startVersion.str() << ". Unable to "
+          << "find and execute the appropriate update method.");
+      return;
+    }
+
+    IddFileAndFactoryWrapper iddFile = getIddFile(*targetVersion);
+    std::map<VersionString, OSVersionInMemoryUpdater>::const_iterator inMemoryIt = 
+        m_inMemoryUpdateMethods.find(*targetVersion);
+    if (inMemoryIt != m_inMemoryUpdateMethods.end()) {
+      // the affected objects keep their structure, so there is no need to print and reparse 
+      // the file
+      if (OptionalIdfFile oIdfFile = inMemoryIt->second(this,start->second,iddFile)) {
+        m_map[oIdfFile->version()] = *oIdfFile;
+        LOG(Debug,"Translation to " << targetVersion->str() << " model has " 
+            << oIdfFile->numObjects() << " objects.");
+        return;
+      }
+      LOG(Debug,"Unable to translate from " << startVersion.str() << " to " 
+          << targetVersion->str() << " in memory. Falling back on text translation.");
+    }
+
+    // the text method for this version, if any, replays the in-memory one
+    std::string translatedIdf;
+    std::map<VersionString, OSVersionUpdater>::const_iterator textIt = 
+        m_updateMethods.find(*targetVersion);
+    if (textIt != m_updateMethods.end()) {
+      translatedIdf = textIt->second(this,start->second,iddFile);
+    }
+    else {
+      translatedIdf = defaultUpdate(start->second,iddFile);
+    }
 
     if (translatedIdf.empty()) {
       LOG(Error,"Unable to complete translation from " << startVersion.str() << " to "
-          << lastVersion.str() << ". Unable to find and execute the appropriate update method.");
+          << targetVersion->str() << ". Unable to find and execute the appropriate update method.");
       return;
     }
     std::stringstream ss(translatedIdf);
     OptionalIdfFile oIdfFile;
-    if (oIddFile->iddFileType() == IddFileType::UserCustom) {
-      oIdfFile = IdfFile::load(ss,oIddFile->iddFile());
+    if (iddFile.iddFileType() == IddFileType::UserCustom) {
+      oIdfFile = IdfFile::load(ss,iddFile.iddFile());
     }
     else {
-      oIdfFile = IdfFile::load(ss,oIddFile->iddFileType());
+      oIdfFile = IdfFile::load(ss,iddFile.iddFileType());
     }
     if (!oIdfFile) {
       LOG(Error,"Unable to complete translation from " << startVersion.str()
-          << " to " << lastVersion.str() << ". Could not load translated IDF using the "
+          << " to " << targetVersion->str() << ". Could not load translated IDF using the "
           << "latter version's IddFile. Translated text: " << std::endl << translatedIdf);
       return;
     }
     IdfFile idfFile = *oIdfFile;
     m_map[oIdfFile->version()] = idfFile;
-    LOG(Debug,"Translation to " << lastVersion.str() << " model has " << oIdfFile->numObjects()
+    LOG(Debug,"Translation to " << targetVersion->str() << " model has " << oIdfFile->numObjects()
         << " objects.");
   }
 }
 
+IdfFile VersionTranslator::emptyIdfFile(const IdfFile& idf,
+                                        const IddFileAndFactoryWrapper& targetIdd)
+{
+  IdfFile result = (targetIdd.iddFileType() == IddFileType::UserCustom) ? 
+                   IdfFile(targetIdd.iddFile()) : 
+                   IdfFile(targetIdd.iddFileType());
+  result.setHeader(idf.header());
+  return result;
+}
+
+boost::optional<std::vector<IdfObject> > VersionTranslator::cloneObjectsToIdd(
+    const IdfFile& idf,
+    const IddFileAndFactoryWrapper& targetIdd)
+{
+  if (!m_allowInMemoryUpdates) {
+    return boost::none;
+  }
+
+  std::vector<IdfObject> result;
+
+  // look up each IddObject once, rather than once per object
+  std::map<std::string, OptionalIddObject> targetObjects;
+  BOOST_FOREACH(const IdfObject& object,idf.objects()) {
+    IddObject iddObject = object.iddObject();
+    if (iddObject.type() == IddObjectType::CommentOnly) {
+      result.push_back(object);
+      continue;
+    }
+    if (iddObject.type() == IddObjectType::Catchall) {
+      // let the text parser try to resolve the type
+      return boost::none;
+    }
+
+    std::map<std::string, OptionalIddObject>::iterator it = targetObjects.find(iddObject.name());
+    if (it == targetObjects.end()) {
+      OptionalIddObject candidate = targetIdd.getObject(iddObject.name());
+      if (candidate && 
+          ((candidate->nonextensibleFields().size() != iddObject.nonextensibleFields().size()) ||
+           (candidate->extensibleGroup().size() != iddObject.extensibleGroup().size())))
+      {
+        candidate.reset();
+      }
+      it = targetObjects.insert(std::make_pair(iddObject.name(),candidate)).first;
+    }
+    if (!it->second) {
+      LOG(Debug,"Cannot clone " << object.briefDescription() << " into IDD version " 
+          << targetIdd.version() << ", because the object's structure has changed.");
+      return boost::none;
+    }
+
+    result.push_back(object.clone(*(it->second)));
+  }
+
+  return result;
+}
+
+boost::optional<IdfFile> VersionTranslator::cloneToIdd(const IdfFile& idf,
+                                                      const IddFileAndFactoryWrapper& targetIdd)
+{
+  boost::optional<std::vector<IdfObject> > objects = cloneObjectsToIdd(idf,targetIdd);
+  if (!objects) {
+    return boost::none;
+  }
+
+  IdfFile result = emptyIdfFile(idf,targetIdd);
+  result.addObjects(*objects);
+  return result;
+}
+
 std::string VersionTranslator::defaultUpdate(const IdfFile& idf,
                                              const IddFileAndFactoryWrapper& targetIdd)
 {
@@ -444,6 +653,14 @@ std::string VersionTranslator::defaultUpdate(const IdfFile& idf,
   return ss.str();
 }
 
+boost::optional<IdfFile> VersionTranslator::defaultInMemoryUpdate(
+    const IdfFile& idf,
+    const IddFileAndFactoryWrapper& targetIdd)
+{
+  // use for version increments with no IDD changes
+  return cloneToIdd(idf,targetIdd);
+}
+
 std::string VersionTranslator::update_0_7_1_to_0_7_2(const IdfFile& idf_0_7_1, const IddFileAndFactoryWrapper& idd_0_7_2) {
   // Url field refinements
   std::stringstream ss;
@@ -473,6 +690,32 @@ std::string VersionTranslator::update_0_7_1_to_0_7_2(const IdfFile& idf_0_7_1, c
   return ss.str();
 }
 
+boost::optional<IdfFile> VersionTranslator::updateInMemory_0_7_1_to_0_7_2(const IdfFile& idf_0_7_1, const IddFileAndFactoryWrapper& idd_0_7_2) {
+  // Url field refinements
+  boost::optional<std::vector<IdfObject> > objects = cloneObjectsToIdd(idf_0_7_1,idd_0_7_2);
+  if (!objects) {
+    return boost::none;
+  }
+
+  IdfFile result = emptyIdfFile(idf_0_7_1,idd_0_7_2);
+  BOOST_FOREACH(const IdfObject& object,*objects) {
+    IdfObject toAdd = object;
+    if (object.iddObject().name() == "OS:WeatherFile") {
+      toAdd = updateUrlField_0_7_1_to_0_7_2(object,9);
+    }
+    else if (object.iddObject().name() == "OS:Construction:WindowDataFile") {
+      toAdd = updateUrlField_0_7_1_to_0_7_2(object,1);
+    }
+    else if (object.iddObject().name() == "OS:Luminaire:Definition") {
+      toAdd = updateUrlField_0_7_1_to_0_7_2(object,1);
+    }
+
+    result.addObject(toAdd);
+  }
+
+  return result;
+}
+
 IdfObject VersionTranslator::updateUrlField_0_7_1_to_0_7_2(const IdfObject& object, unsigned index) {
   IdfObject result = object;
   if (OptionalString os = object.getString(index)) {
@@ -494,27 +737,17 @@ IdfObject VersionTranslator::updateUrlField_0_7_1_to_0_7_2(const IdfObject& obje
   return result;
 }
 
-std::string VersionTranslator::update_0_7_2_to_0_7_3(const IdfFile& idf_0_7_2, const IddFileAndFactoryWrapper& idd_0_7_3) {
-  // use for version increments with no IDD changes
-  std::stringstream ss;
-
-  ss << idf_0_7_2.header() << std::endl << std::endl;
-
-  // new version object
-  IdfFile targetIdf(idd_0_7_3.iddFile());
-  ss << targetIdf.versionObject().get();
-
-  // all other objects
+boost::optional<IdfFile> VersionTranslator::update_0_7_2_to_0_7_3(const IdfFile& idf_0_7_2, const IddFileAndFactoryWrapper& idd_0_7_3) {
+  // no IDD changes, just log warnings
   BOOST_FOREACH(const IdfObject& object,idf_0_7_2.objects()) {
     if (istringEqual(object.iddObject().name(),"OS:PlantLoop")) {
       // ETH@20120514 Kyle - Please refine/completely rework this as appropriate.
       LOG(Warn,"This model contains an out-of-date " << object.iddObject().name() << " object. "
           << "In particular, it needs a bypass branch added in order to run properly in EnergyPlus.");
     }
-    ss << object;
   }
 
-  return ss.str();
+  return cloneToIdd(idf_0_7_2,idd_0_7_3);
 }
 
 std::string VersionTranslator::update_0_7_3_to_0_7_4(const IdfFile& idf_0_7_3, const IddFileAndFactoryWrapper& idd_0_7_4) {
@@ -1450,6 +1683,91 @@ std::string VersionTranslator::update_0_9_5_to_0_9_6(const IdfFile& idf_0_9_5, c
   return ss.str();
 }
 
+boost::optional<IdfFile> VersionTranslator::updateInMemory_0_9_5_to_0_9_6(const IdfFile& idf_0_9_5, const IddFileAndFactoryWrapper& idd_0_9_6)
+{
+  boost::optional<std::vector<IdfObject> > objects = cloneObjectsToIdd(idf_0_9_5,idd_0_9_6);
+  if (!objects) {
+    return boost::none;
+  }
+  std::vector<IdfObject> originals = idf_0_9_5.objects();
+  BOOST_ASSERT(originals.size() == objects->size());
+
+  // if multiple OS:RunPeriod objects remove them all
+  bool skipRunPeriods = false;
+  unsigned numRunPeriods = 0;
+  BOOST_FOREACH(const IdfObject& object,*objects) 
+  {
+    if( object.iddObject().name() == "OS:RunPeriod" )
+    {
+      ++numRunPeriods;
+    
+      if (numRunPeriods > 1)
+      {
+        LOG(Warn, "Multiple OS:RunPeriod objects are no longer supported, these have been removed");
+        skipRunPeriods = true;
+        break;
+      }
+    }
+  }
+
+  IdfFile result = emptyIdfFile(idf_0_9_5,idd_0_9_6);
+  for (unsigned i = 0, n = objects->size(); i < n; ++i) {
+    IdfObject& object = (*objects)[i];
+    if( object.iddObject().name() == "OS:PlantLoop" )
+    {
+      IdfObject newSizingPlant(idd_0_9_6.getObject("OS:Sizing:Plant").get());
+
+      newSizingPlant.setString(0,createUUID().toString().toStdString());
+
+      newSizingPlant.setString(1,object.getString(0).get());
+
+      newSizingPlant.setString(2,"Heating");
+
+      newSizingPlant.setDouble(3,0.001);
+
+      newSizingPlant.setDouble(4,0.001);
+
+      result.addObject(newSizingPlant);
+
+      m_new.push_back(newSizingPlant);
+
+      result.addObject(object);
+    }
+    else if( object.iddObject().name() == "OS:Sizing:Parameters" )
+    {
+      // object is already a copy, so edit it directly
+      if( ! object.getDouble(1) )
+      {
+        object.setDouble(1,1.25);
+      }
+
+      if( ! object.getDouble(2) )
+      {
+        object.setDouble(2,1.15);
+      }
+
+      result.addObject(object);
+    }
+    else if( object.iddObject().name() == "OS:RunPeriod" )
+    {
+      if (skipRunPeriods){
+        // put the original object in the untranslated list
+        m_untranslated.push_back(originals[i]);
+      }
+      else
+      {
+        result.addObject(object);
+      }
+    }
+    else
+    {
+      result.addObject(object);
+    }
+  }
+
+  return result;
+}
+
 std::string VersionTranslator::update_0_11_0_to_0_11_1(const IdfFile& idf_0_11_0, const IddFileAndFactoryWrapper& idd_0_11_1)
 {
   // use for version increments with no IDD changes
@@ -1533,6 +1851,51 @@ std::string VersionTranslator::update_0_11_0_to_0_11_1(const IdfFile& idf_0_11_0
   return ss.str();
 }
 
+boost::optional<IdfFile> VersionTranslator::updateInMemory_0_11_0_to_0_11_1(const IdfFile& idf_0_11_0, const IddFileAndFactoryWrapper& idd_0_11_1)
+{
+  std::vector<std::string> removedItemTypes;
+  removedItemTypes.push_back("OS:ComponentCost:LineItem");
+  if (!canKeepComponentDataInMemory(idf_0_11_0,removedItemTypes)) {
+    return boost::none;
+  }
+
+  boost::optional<std::vector<IdfObject> > objects = cloneObjectsToIdd(idf_0_11_0,idd_0_11_1);
+  if (!objects) {
+    return boost::none;
+  }
+  std::vector<IdfObject> originals = idf_0_11_0.objects();
+  BOOST_ASSERT(originals.size() == objects->size());
+
+  // OS:ComponentData objects go at the end, as in the text translation
+  std::vector<IdfObject> componentDataObjects;
+  unsigned numRemoved = 0;
+
+  IdfFile result = emptyIdfFile(idf_0_11_0,idd_0_11_1);
+  for (unsigned i = 0, n = objects->size(); i < n; ++i) {
+    const IdfObject& object = (*objects)[i];
+    if( object.iddObject().name() == "OS:ComponentCost:LineItem" )
+    {
+      ++numRemoved;
+      m_untranslated.push_back(originals[i]);
+    }
+    else if( object.iddObject().name() == "OS:ComponentData" )
+    {
+      componentDataObjects.push_back(object);
+    }
+    else
+    {
+      result.addObject(object);
+    }
+  }
+  result.addObjects(componentDataObjects);
+
+  if (numRemoved > 0){
+    LOG(Warn, "OS:ComponentCost:LineItem objects created before 0.11.1 are no longer supported, " << numRemoved << " objects have been removed.");
+  }
+
+  return result;
+}
+
 std::string VersionTranslator::update_0_11_1_to_0_11_2(const IdfFile& idf_0_11_1, const IddFileAndFactoryWrapper& idd_0_11_2)
 {
   // This version update has two things to do.  
@@ -1907,6 +2270,86 @@ std::string VersionTranslator::update_0_11_4_to_0_11_5(const IdfFile& idf_0_11_4
   return ss.str();
 }
 
+boost::optional<IdfFile> VersionTranslator::updateInMemory_0_11_4_to_0_11_5(const IdfFile& idf_0_11_4, const IddFileAndFactoryWrapper& idd_0_11_5)
+{
+  std::vector<std::string> removedItemTypes;
+  removedItemTypes.push_back("OS:ComponentCost:LineItem");
+  removedItemTypes.push_back("OS:LifeCycleCost:NonrecurringCost");
+  removedItemTypes.push_back("OS:LifeCycleCost:RecurringCosts");
+  if (!canKeepComponentDataInMemory(idf_0_11_4,removedItemTypes)) {
+    return boost::none;
+  }
+
+  boost::optional<std::vector<IdfObject> > objects = cloneObjectsToIdd(idf_0_11_4,idd_0_11_5);
+  if (!objects) {
+    return boost::none;
+  }
+  std::vector<IdfObject> originals = idf_0_11_4.objects();
+  BOOST_ASSERT(originals.size() == objects->size());
+
+  // OS:ComponentData objects go at the end, as in the text translation
+  std::vector<IdfObject> componentDataObjects;
+  std::vector<unsigned> numRemoved(removedItemTypes.size(),0u);
+
+  IdfFile result = emptyIdfFile(idf_0_11_4,idd_0_11_5);
+  for (unsigned i = 0, n = objects->size(); i < n; ++i) {
+    const IdfObject& object = (*objects)[i];
+    std::vector<std::string>::const_iterator typeIt = std::find(removedItemTypes.begin(),
+                                                                removedItemTypes.end(),
+                                                                object.iddObject().name());
+    if (typeIt != removedItemTypes.end())
+    {
+      ++numRemoved[typeIt - removedItemTypes.begin()];
+      m_untranslated.push_back(originals[i]);
+    }
+    else if( object.iddObject().name() == "OS:ComponentData" )
+    {
+      componentDataObjects.push_back(object);
+    }
+    else
+    {
+      result.addObject(object);
+    }
+  }
+  result.addObjects(componentDataObjects);
+
+  for (unsigned i = 0, n = removedItemTypes.size(); i < n; ++i) {
+    if (numRemoved[i] > 0){
+      LOG(Warn, removedItemTypes[i] << " objects created before 0.11.5 are no longer supported, " << numRemoved[i] << " objects have been removed.");
+    }
+  }
+
+  return result;
+}
+
+bool VersionTranslator::canKeepComponentDataInMemory(const IdfFile& idf,
+                                                     const std::vector<std::string>& removedItemTypes)
+{
+  std::set<std::string> removedItemHandles;
+  std::vector<IdfObject> componentDataObjects;
+  BOOST_FOREACH(const IdfObject& object,idf.objects()) {
+    if (std::find(removedItemTypes.begin(),removedItemTypes.end(),object.iddObject().name()) != removedItemTypes.end()) {
+      removedItemHandles.insert(toString(object.handle()));
+    }
+    else if (object.iddObject().name() == "OS:ComponentData") {
+      componentDataObjects.push_back(object);
+    }
+  }
+
+  // the text translation rewrites the contents list of any OS:ComponentData that is left with 
+  // empty or removed entries
+  BOOST_FOREACH(const IdfObject& componentDataObject,componentDataObjects) {
+    for (unsigned i = 6, imax = componentDataObject.numFields(); i < imax; ++i) {
+      boost::optional<std::string> objectHandle = componentDataObject.getString(i);
+      if (!objectHandle || (removedItemHandles.find(*objectHandle) != removedItemHandles.end())) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 std::string VersionTranslator::update_0_11_5_to_0_11_6(const IdfFile& idf_0_11_5, const IddFileAndFactoryWrapper& idd_0_11_6)
 {
   // Update the OS:PortList object to point back to the OS:ThermalZone
@@ -2049,6 +2492,37 @@ std::string VersionTranslator::update_1_0_1_to_1_0_2(const IdfFile& idf_1_0_1, c
   return ss.str();
 }
 
+boost::optional<IdfFile> VersionTranslator::updateInMemory_1_0_1_to_1_0_2(const IdfFile& idf_1_0_1, const IddFileAndFactoryWrapper& idd_1_0_2)
+{
+  boost::optional<std::vector<IdfObject> > objects = cloneObjectsToIdd(idf_1_0_1,idd_1_0_2);
+  if (!objects) {
+    return boost::none;
+  }
+  std::vector<IdfObject> originals = idf_1_0_1.objects();
+  BOOST_ASSERT(originals.size() == objects->size());
+
+  IdfFile result = emptyIdfFile(idf_1_0_1,idd_1_0_2);
+  for (unsigned i = 0, n = objects->size(); i < n; ++i) {
+    IdfObject& object = (*objects)[i];
+
+    if( object.iddObject().name() == "OS:Boiler:HotWater" ) {
+
+      if(object.getString(15) && istringEqual(object.getString(15).get(),"VariableFlow")) {
+        // Update Boiler Flow Mode; object is already a copy, so edit it directly
+
+        object.setString(15,"LeavingSetpointModulated");
+
+        m_refactored.push_back( std::pair<IdfObject,IdfObject>(originals[i],object) );
+
+      }
+    }
+
+    result.addObject(object);
+  }
+
+  return result;
+}
+
 } // osversion
 } // openstudio
 
@@ -102,6 +102,29 @@ class OSVERSION_API VersionTranslator {
   boost::optional<model::Component> loadComponent(std::istream& is,
                                                   ProgressBar* progressBar = NULL);
 
+  /** Updates each osm or osc in inputPaths (which must be of version 0.7.0 or later) to the 
+   *  current version of OpenStudio, and saves the result to the path with the same index in 
+   *  outputPaths. The files are distributed over numThreads translators running in parallel 
+   *  (numThreads == 0 uses one thread per processor), all of which share the \link 
+   *  IddFactorySingleton IddFactory\endlink's cache of previous-version \link IddFile 
+   *  IddFiles\endlink. Returns one success flag per input file. Warnings and errors for 
+   *  individual files are available through the log. */
+  static std::vector<bool> updateFiles(const std::vector<openstudio::path>& inputPaths,
+                                       const std::vector<openstudio::path>& outputPaths,
+                                       unsigned numThreads = 0);
+
+  //@}
+  /** @name Getters and Setters */
+  //@{
+
+  /** Returns true if version steps that keep the structure of every affected object are applied 
+   *  to the objects in memory. Defaults to true. */
+  bool allowInMemoryUpdates() const;
+
+  /** If false, every version step prints the file and reparses it against the next IDD. The 
+   *  translated model is the same either way; the text path is only slower. */
+  void setAllowInMemoryUpdates(bool allowInMemoryUpdates);
+
   //@}
   /** @name Queries 
    *
@@ -141,6 +164,13 @@ class OSVERSION_API VersionTranslator {
 
   typedef boost::function<std::string (VersionTranslator*, const IdfFile&, const IddFileAndFactoryWrapper& )> OSVersionUpdater;
   std::map<VersionString, OSVersionUpdater> m_updateMethods;
+
+  // Update methods for version increments that do not change the structure of the affected 
+  // objects. These hand the objects to the next IDD directly, rather than printing and reparsing
+  // the file, and may return boost::none to fall back on the text method for the same version 
+  // (or defaultUpdate).
+  typedef boost::function<boost::optional<IdfFile> (VersionTranslator*, const IdfFile&, const IddFileAndFactoryWrapper& )> OSVersionInMemoryUpdater;
+  std::map<VersionString, OSVersionInMemoryUpdater> m_inMemoryUpdateMethods;
   std::vector<VersionString> m_startVersions;
 
   VersionString m_originalVersion;
@@ -152,6 +182,7 @@ class OSVERSION_API VersionTranslator {
   int m_nObjectsFinalIdf;
   int m_nObjectsFinalModel;
   bool m_isComponent;
+  bool m_allowInMemoryUpdates;
 
   boost::optional<model::Model> updateVersion(std::istream& is, 
                                               bool isComponent,
@@ -163,17 +194,28 @@ class OSVERSION_API VersionTranslator {
   
   void update(const VersionString& startVersion);
 
+  IdfFile emptyIdfFile(const IdfFile& idf, const IddFileAndFactoryWrapper& targetIdd);
+  boost::optional<std::vector<IdfObject> > cloneObjectsToIdd(const IdfFile& idf, const IddFileAndFactoryWrapper& targetIdd);
+  boost::optional<IdfFile> cloneToIdd(const IdfFile& idf, const IddFileAndFactoryWrapper& targetIdd);
+  bool canKeepComponentDataInMemory(const IdfFile& idf, const std::vector<std::string>& removedItemTypes);
+
   std::string defaultUpdate(const IdfFile& idf, const IddFileAndFactoryWrapper& targetIdd);
+  boost::optional<IdfFile> defaultInMemoryUpdate(const IdfFile& idf, const IddFileAndFactoryWrapper& targetIdd);
   std::string update_0_7_1_to_0_7_2(const IdfFile& idf_0_7_1, const IddFileAndFactoryWrapper& idd_0_7_2);
-  std::string update_0_7_2_to_0_7_3(const IdfFile& idf_0_7_2, const IddFileAndFactoryWrapper& idd_0_7_3);
+  boost::optional<IdfFile> updateInMemory_0_7_1_to_0_7_2(const IdfFile& idf_0_7_1, const IddFileAndFactoryWrapper& idd_0_7_2);
+  boost::optional<IdfFile> update_0_7_2_to_0_7_3(const IdfFile& idf_0_7_2, const IddFileAndFactoryWrapper& idd_0_7_3);
   std::string update_0_7_3_to_0_7_4(const IdfFile& idf_0_7_3, const IddFileAndFactoryWrapper& idd_0_7_4);
   std::string update_0_9_1_to_0_9_2(const IdfFile& idf_0_9_1, const IddFileAndFactoryWrapper& idd_0_9_2);
   std::string update_0_9_5_to_0_9_6(const IdfFile& idf_0_9_5, const IddFileAndFactoryWrapper& idd_0_9_6);
+  boost::optional<IdfFile> updateInMemory_0_9_5_to_0_9_6(const IdfFile& idf_0_9_5, const IddFileAndFactoryWrapper& idd_0_9_6);
   std::string update_0_11_0_to_0_11_1(const IdfFile& idf_0_11_0, const IddFileAndFactoryWrapper& idd_0_11_1);
+  boost::optional<IdfFile> updateInMemory_0_11_0_to_0_11_1(const IdfFile& idf_0_11_0, const IddFileAndFactoryWrapper& idd_0_11_1);
   std::string update_0_11_1_to_0_11_2(const IdfFile& idf_0_11_1, const IddFileAndFactoryWrapper& idd_0_11_2);
   std::string update_0_11_4_to_0_11_5(const IdfFile& idf_0_11_4, const IddFileAndFactoryWrapper& idd_0_11_5);
+  boost::optional<IdfFile> updateInMemory_0_11_4_to_0_11_5(const IdfFile& idf_0_11_4, const IddFileAndFactoryWrapper& idd_0_11_5);
   std::string update_0_11_5_to_0_11_6(const IdfFile& idf_0_11_5, const IddFileAndFactoryWrapper& idd_0_11_6);
   std::string update_1_0_1_to_1_0_2(const IdfFile& idf_1_0_1, const IddFileAndFactoryWrapper& idd_1_0_2);
+  boost::optional<IdfFile> updateInMemory_1_0_1_to_1_0_2(const IdfFile& idf_1_0_1, const IddFileAndFactoryWrapper& idd_1_0_2);
 
   IdfObject updateUrlField_0_7_1_to_0_7_2(const IdfObject& object, unsigned index);
 
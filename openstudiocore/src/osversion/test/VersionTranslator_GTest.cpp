@@ -42,9 +42,15 @@
 #include <utilities/idf/IdfObject.hpp>
 
 #include <utilities/core/Compare.hpp>
+#include <utilities/core/PathHelpers.hpp>
 
 #include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
 #include <boost/foreach.hpp>
+#include <boost/regex.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <sstream>
 
 #include <resources.hxx>
 #include <OpenStudio.hxx>
@@ -273,6 +279,135 @@ TEST_F(OSVersionFixture,ModelLoading_PreserveHandles) {
   EXPECT_TRUE(buildingHandle1 == buildingHandle2);
 }
 
+TEST_F(OSVersionFixture,UpdateFiles) {
+  // gather example models and components from all versions
+  // updated files go to a temporary directory, resources are not written to
+  std::vector<openstudio::path> inputPaths, outputPaths;
+  openstudio::path resources = resourcesPath() / toPath("osversion");
+  openstudio::path outputDir = tempDir() / toPath("VersionTranslator_UpdateFiles");
+  boost::filesystem::remove_all(outputDir);
+  for (openstudio::directory_iterator it(resources); it != openstudio::directory_iterator(); ++it) {
+    if (boost::filesystem::is_directory(it->status())) {
+      openstudio::path versionDir = outputDir / it->path().filename();
+      boost::filesystem::create_directories(versionDir);
+      inputPaths.push_back(it->path() / toPath("example.osm"));
+      outputPaths.push_back(versionDir / toPath("example_batch_updated.osm"));
+      inputPaths.push_back(it->path() / toPath("example.osc"));
+      outputPaths.push_back(versionDir / toPath("example_batch_updated.osc"));
+    }
+  }
+  ASSERT_FALSE(inputPaths.empty());
+
+  std::vector<bool> results = VersionTranslator::updateFiles(inputPaths,outputPaths,4);
+  ASSERT_EQ(inputPaths.size(),results.size());
+  for (unsigned i = 0, n = results.size(); i < n; ++i) {
+    EXPECT_TRUE(results[i]) << toString(inputPaths[i]);
+    if (results[i]) {
+      // serial translation should give the same number of objects
+      VersionTranslator translator;
+      if (getFileExtension(inputPaths[i]) == componentFileExtension()) {
+        model::OptionalComponent serial = translator.loadComponent(inputPaths[i]);
+        model::OptionalComponent batch = model::Component::load(outputPaths[i]);
+        ASSERT_TRUE(serial);
+        ASSERT_TRUE(batch);
+        EXPECT_EQ(serial->numObjects(),batch->numObjects());
+      }
+      else {
+        model::OptionalModel serial = translator.loadModel(inputPaths[i]);
+        model::OptionalModel batch = model::Model::load(outputPaths[i]);
+        ASSERT_TRUE(serial);
+        ASSERT_TRUE(batch);
+        EXPECT_EQ(serial->numObjects(),batch->numObjects());
+      }
+    }
+  }
+
+  // mismatched inputs are rejected
+  outputPaths.pop_back();
+  results = VersionTranslator::updateFiles(inputPaths,outputPaths);
+  ASSERT_EQ(inputPaths.size(),results.size());
+  EXPECT_TRUE(std::find(results.begin(),results.end(),true) == results.end());
+
+  boost::filesystem::remove_all(outputDir);
+}
+
+// Replaces each UUID that does not appear in original with a placeholder numbered in order of 
+// appearance, so that two translations that only differ in freshly created handles compare equal.
+static std::string replaceNewUUIDs(const std::string& text, const std::string& original) {
+  boost::regex uuidRegex("\\{[0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{12}\\}");
+  std::map<std::string,std::string> placeholders;
+  std::string result;
+  std::string::const_iterator start = text.begin(), end = text.end();
+  boost::smatch match;
+  while (boost::regex_search(start,end,match,uuidRegex)) {
+    result.append(start,match[0].first);
+    std::string uuid = match[0].str();
+    if (original.find(uuid) == std::string::npos) {
+      std::map<std::string,std::string>::const_iterator it = placeholders.find(uuid);
+      if (it == placeholders.end()) {
+        std::string placeholder = "{new-" + boost::lexical_cast<std::string>(placeholders.size()) + "}";
+        it = placeholders.insert(std::make_pair(uuid,placeholder)).first;
+      }
+      result += it->second;
+    }
+    else {
+      result += uuid;
+    }
+    start = match[0].second;
+  }
+  result.append(start,end);
+  return result;
+}
+
+TEST_F(OSVersionFixture,InMemoryUpdatesMatchTextUpdates) {
+  // every example file goes through several version steps, some of which are done in memory
+  openstudio::path resources = resourcesPath() / toPath("osversion");
+  for (openstudio::directory_iterator it(resources); it != openstudio::directory_iterator(); ++it) {
+    if (!boost::filesystem::is_directory(it->status())) {
+      continue;
+    }
+    openstudio::path paths[] = { it->path() / toPath("example.osm"),
+                                 it->path() / toPath("example.osc") };
+    BOOST_FOREACH(const openstudio::path& p, paths) {
+      std::stringstream original;
+      boost::filesystem::ifstream file(p);
+      original << file.rdbuf();
+      file.close();
+
+      VersionTranslator inMemoryTranslator;
+      EXPECT_TRUE(inMemoryTranslator.allowInMemoryUpdates());
+      VersionTranslator textTranslator;
+      textTranslator.setAllowInMemoryUpdates(false);
+      EXPECT_FALSE(textTranslator.allowInMemoryUpdates());
+
+      std::stringstream inMemoryText, textText;
+      if (getFileExtension(p) == componentFileExtension()) {
+        model::OptionalComponent inMemory = inMemoryTranslator.loadComponent(p);
+        model::OptionalComponent text = textTranslator.loadComponent(p);
+        ASSERT_TRUE(inMemory) << toString(p);
+        ASSERT_TRUE(text) << toString(p);
+        inMemoryText << inMemory->toIdfFile();
+        textText << text->toIdfFile();
+      }
+      else {
+        model::OptionalModel inMemory = inMemoryTranslator.loadModel(p);
+        model::OptionalModel text = textTranslator.loadModel(p);
+        ASSERT_TRUE(inMemory) << toString(p);
+        ASSERT_TRUE(text) << toString(p);
+        inMemoryText << inMemory->toIdfFile();
+        textText << text->toIdfFile();
+      }
+
+      EXPECT_EQ(replaceNewUUIDs(textText.str(),original.str()),
+                replaceNewUUIDs(inMemoryText.str(),original.str())) << toString(p);
+      EXPECT_EQ(textTranslator.warnings().size(),inMemoryTranslator.warnings().size()) << toString(p);
+      EXPECT_EQ(textTranslator.untranslatedObjects().size(),inMemoryTranslator.untranslatedObjects().size()) << toString(p);
+      EXPECT_EQ(textTranslator.newObjects().size(),inMemoryTranslator.newObjects().size()) << toString(p);
+      EXPECT_EQ(textTranslator.refactoredObjects().size(),inMemoryTranslator.refactoredObjects().size()) << toString(p);
+    }
+  }
+}
+
 TEST_F(OSVersionFixture,Profile_ComponentLoading_LatestVersion) {
   VersionString thisVersion(openStudioVersion());
   openstudio::path componentPath = exampleComponentPath(thisVersion);
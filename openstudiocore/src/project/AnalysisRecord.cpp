@@ -25,6 +25,8 @@
 #include <project/AlgorithmRecord.hpp>
 #include <project/DataPointRecord.hpp>
 #include <project/DataPointRecord_Impl.hpp>
+#include <project/DataPointValueRecord.hpp>
+#include <project/FunctionRecord.hpp>
 #include <project/FileReferenceRecord.hpp>
 #include <project/VariableRecord.hpp>
 #include <project/DiscretePerturbationRecord.hpp>
@@ -186,6 +188,103 @@ namespace detail {
     return result;
   }
 
+  std::vector<DataPointRecord> AnalysisRecord_Impl::dataPointRecords(int afterId,
+                                                                     unsigned maxRecords) const
+  {
+    DataPointRecordVector result;
+    if (maxRecords == 0) {
+      return result;
+    }
+
+    ProjectDatabase database = projectDatabase();
+    QSqlQuery query(*(database.qSqlDatabase()));
+    query.prepare(toQString("SELECT * FROM " + DataPointRecord::databaseTableName() +
+        " WHERE analysisRecordId=:analysisRecordId AND id>:afterId ORDER BY id LIMIT :maxRecords"));
+    query.bindValue(":analysisRecordId",id());
+    query.bindValue(":afterId",afterId);
+    query.bindValue(":maxRecords",maxRecords);
+    assertExec(query);
+    while (query.next()) {
+      result.push_back(DataPointRecord::factoryFromQuery(query, database).get());
+    }
+
+    return result;
+  }
+
+  std::vector<DataPointSummary> AnalysisRecord_Impl::dataPointSummaries(int afterId,
+                                                                        unsigned maxRecords) const
+  {
+    DataPointSummaryVector result;
+    if (maxRecords == 0) {
+      return result;
+    }
+
+    ProjectDatabase database = projectDatabase();
+    QSqlQuery query(*(database.qSqlDatabase()));
+    query.prepare(toQString("SELECT id, handle, name, displayName, complete, failed FROM " +
+        DataPointRecord::databaseTableName() +
+        " WHERE analysisRecordId=:analysisRecordId AND id>:afterId ORDER BY id LIMIT :maxRecords"));
+    query.bindValue(":analysisRecordId",id());
+    query.bindValue(":afterId",afterId);
+    query.bindValue(":maxRecords",maxRecords);
+    assertExec(query);
+
+    std::vector<int> ids;
+    std::vector<UUID> handles;
+    StringVector names, displayNames;
+    std::vector<bool> completes, faileds;
+    std::map<int,unsigned> indices;
+    while (query.next()) {
+      indices[query.value(0).toInt()] = ids.size();
+      ids.push_back(query.value(0).toInt());
+      handles.push_back(toUUID(query.value(1).toString()));
+      names.push_back(toString(query.value(2).toString()));
+      displayNames.push_back(toString(query.value(3).toString()));
+      completes.push_back(query.value(4).toBool());
+      faileds.push_back(query.value(5).toBool());
+    }
+    if (ids.empty()) {
+      return result;
+    }
+
+    // response and objective values for the whole page at once
+    std::vector<DoubleVector> responseValues(ids.size()), objectiveValues(ids.size());
+    query.prepare(toQString("SELECT v.dataPointRecordId, f.functionType, v.dataPointValue FROM " +
+        DataPointValueRecord::databaseTableName() + " v, " +
+        FunctionRecord::databaseTableName() + " f " +
+        " WHERE v.functionRecordId=f.id AND v.dataPointRecordId>=:firstId AND " +
+        "v.dataPointRecordId<=:lastId ORDER BY v.dataPointRecordId, f.functionVectorIndex"));
+    query.bindValue(":firstId",ids.front());
+    query.bindValue(":lastId",ids.back());
+    assertExec(query);
+    while (query.next()) {
+      std::map<int,unsigned>::const_iterator it = indices.find(query.value(0).toInt());
+      if (it == indices.end()) {
+        // data point of another analysis
+        continue;
+      }
+      if (query.value(1).toInt() == FunctionType::Objective) {
+        objectiveValues[it->second].push_back(query.value(2).toDouble());
+      }
+      else {
+        responseValues[it->second].push_back(query.value(2).toDouble());
+      }
+    }
+
+    for (unsigned i = 0, n = ids.size(); i < n; ++i) {
+      result.push_back(DataPointSummary(ids[i],
+                                        handles[i],
+                                        names[i],
+                                        displayNames[i],
+                                        completes[i],
+                                        faileds[i],
+                                        responseValues[i],
+                                        objectiveValues[i]));
+    }
+
+    return result;
+  }
+
   std::vector<DataPointRecord> AnalysisRecord_Impl::incompleteDataPointRecords() const {
     DataPointRecordVector result;
 
@@ -377,9 +476,11 @@ namespace detail {
       oWeatherFileReference = oWeatherFileReferenceRecord->fileReference();
     }
 
+    // deserialize the problem once rather than once per data point
+    analysis::Problem problem = problemRecord().problem();
     analysis::DataPointVector dataPoints;
     BOOST_FOREACH(const DataPointRecord& dataPointRecord,dataPointRecords()) {
-      dataPoints.push_back(dataPointRecord.dataPoint());
+      dataPoints.push_back(dataPointRecord.dataPoint(problem));
     }
 
     return analysis::Analysis(handle(),
@@ -387,7 +488,7 @@ namespace detail {
                               name(),
                               displayName(),
                               description(),
-                              problemRecord().problem(),
+                              problem,
                               oAlgorithm,
                               seedFileReferenceRecord().fileReference(),
                               oWeatherFileReference,
@@ -830,6 +931,18 @@ std::vector<DataPointRecord> AnalysisRecord::dataPointRecords() const {
   return getImpl<detail::AnalysisRecord_Impl>()->dataPointRecords();
 }
 
+std::vector<DataPointRecord> AnalysisRecord::dataPointRecords(int afterId,
+                                                              unsigned maxRecords) const
+{
+  return getImpl<detail::AnalysisRecord_Impl>()->dataPointRecords(afterId,maxRecords);
+}
+
+std::vector<DataPointSummary> AnalysisRecord::dataPointSummaries(int afterId,
+                                                                 unsigned maxRecords) const
+{
+  return getImpl<detail::AnalysisRecord_Impl>()->dataPointSummaries(afterId,maxRecords);
+}
+
 std::vector<DataPointRecord> AnalysisRecord::incompleteDataPointRecords() const {
   return getImpl<detail::AnalysisRecord_Impl>()->incompleteDataPointRecords();
 }
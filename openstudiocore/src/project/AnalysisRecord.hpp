@@ -33,6 +33,7 @@ class ProblemRecord;
 class AlgorithmRecord;
 class FileReferenceRecord;
 class DataPointRecord;
+class DataPointSummary;
 
 namespace detail {
 
@@ -132,6 +133,16 @@ class PROJECT_API AnalysisRecord : public ObjectRecord {
    *  AnalysisRecord. */
   std::vector<DataPointRecord> dataPointRecords() const;
 
+  /** Returns up to maxRecords of this AnalysisRecord's DataPointRecords with id > afterId, in
+   *  order of increasing id. Pass the id of the last record of one page as afterId to get the
+   *  next page. */
+  std::vector<DataPointRecord> dataPointRecords(int afterId, unsigned maxRecords) const;
+
+  /** Returns DataPointSummaries for the same page as dataPointRecords(afterId,maxRecords),
+   *  using two queries and without constructing any DataPointRecords. Reads the database
+   *  directly, so changes that have not been saved are not reflected. */
+  std::vector<DataPointSummary> dataPointSummaries(int afterId, unsigned maxRecords) const;
+
   /** Returns the DataPointRecords with complete == false. */
   std::vector<DataPointRecord> incompleteDataPointRecords() const;
 
@@ -43,6 +43,7 @@ class ProblemRecord;
 class AlgorithmRecord;
 class FileReferenceRecord;
 class DataPointRecord;
+class DataPointSummary;
 
 namespace detail {
 
@@ -105,6 +106,10 @@ namespace detail {
      *  AnalysisRecord. */
     std::vector<DataPointRecord> dataPointRecords() const;
 
+    std::vector<DataPointRecord> dataPointRecords(int afterId, unsigned maxRecords) const;
+
+    std::vector<DataPointSummary> dataPointSummaries(int afterId, unsigned maxRecords) const;
+
     /** Return the DataPointRecords with complete == false. */
     std::vector<DataPointRecord> incompleteDataPointRecords() const;
 
@@ -36,9 +36,11 @@
 #include <project/FunctionRecord.hpp>
 #include <project/FileReferenceRecord.hpp>
 #include <project/AttributeRecord.hpp>
+#include <project/DataPointResultsTable.hpp>
 #include <project/TagRecord.hpp>
 
 #include <analysis/DataPoint.hpp>
+#include <analysis/Problem.hpp>
 #include <analysis/OptimizationDataPoint.hpp>
 #include <analysis/OptimizationDataPoint_Impl.hpp>
 
@@ -361,6 +363,10 @@ namespace detail {
   }
 
   analysis::DataPoint DataPointRecord_Impl::dataPoint() const {
+    return dataPoint(problemRecord().problem());
+  }
+
+  analysis::DataPoint DataPointRecord_Impl::dataPoint(const analysis::Problem& problem) const {
     ProblemRecord problemRecord = this->problemRecord();
 
     // get variable values
@@ -449,7 +455,7 @@ namespace detail {
                                description(),
                                m_complete,
                                m_failed,
-                               problemRecord.problem(),
+                               problem,
                                variableValues,
                                responseValues(),
                                m_directory,
@@ -488,6 +494,7 @@ namespace detail {
     if (ofrr) {
       database.removeRecord(*ofrr);
     }
+    DataPointResultsTable(database).removeResults(id());
     DataPointValueRecordVector rvrs = responseValueRecords();
     BOOST_FOREACH(DataPointValueRecord& rvr,rvrs) {
       database.removeRecord(rvr);
@@ -969,6 +976,31 @@ std::vector<DataPointRecord> DataPointRecord::getDataPointRecords(ProjectDatabas
   return result;
 }
 
+std::vector<DataPointRecord> DataPointRecord::getDataPointRecords(ProjectDatabase& database,
+                                                                 int afterId,
+                                                                 unsigned maxRecords)
+{
+  std::vector<DataPointRecord> result;
+  if (maxRecords == 0) {
+    return result;
+  }
+
+  QSqlQuery query(*(database.qSqlDatabase()));
+  query.prepare(toQString("SELECT * FROM " + DataPointRecord::databaseTableName() +
+      " WHERE id>:afterId ORDER BY id LIMIT :maxRecords"));
+  query.bindValue(":afterId",afterId);
+  query.bindValue(":maxRecords",maxRecords);
+  assertExec(query);
+  while (query.next()) {
+    OptionalDataPointRecord dataPointRecord = DataPointRecord::factoryFromQuery(query, database);
+    if (dataPointRecord) {
+      result.push_back(*dataPointRecord);
+    }
+  }
+
+  return result;
+}
+
 boost::optional<DataPointRecord> DataPointRecord::getDataPointRecord(
     int id, ProjectDatabase& database)
 {
@@ -1045,6 +1077,10 @@ analysis::DataPoint DataPointRecord::dataPoint() const {
   return getImpl<detail::DataPointRecord_Impl>()->dataPoint();
 }
 
+analysis::DataPoint DataPointRecord::dataPoint(const analysis::Problem& problem) const {
+  return getImpl<detail::DataPointRecord_Impl>()->dataPoint(problem);
+}
+
 void DataPointRecord::setDirectory(const openstudio::path& directory) {
   getImpl<detail::DataPointRecord_Impl>()->setDirectory(directory);
 }
@@ -1187,10 +1223,15 @@ void DataPointRecord::constructRelatedRecords(const analysis::DataPoint& dataPoi
     BOOST_FOREACH(const Attribute& attribute,attributes) {
       AttributeRecord attributeRecord(attribute,*newXmlOutputDataRecord);
     }
+    // and in columnar form for queries across data points
+    DataPointResultsTable(database).setResults(copyOfThis.id(),attributes);
   }
   if (!xmlOutputData) {
     BOOST_ASSERT(!newXmlOutputDataRecord);
     getImpl<detail::DataPointRecord_Impl>()->clearXmlOutputDataRecordId();
+    if (!isNew) {
+      DataPointResultsTable(database).removeResults(copyOfThis.id());
+    }
   }
 
   // Remove old response function values
@@ -1262,6 +1303,60 @@ boost::optional<FileReferenceRecord> DataPointRecord::saveChildFileReference(
   return result;
 }
 
+DataPointSummary::DataPointSummary(int id,
+                                   const UUID& handle,
+                                   const std::string& name,
+                                   const std::string& displayName,
+                                   bool complete,
+                                   bool failed,
+                                   const std::vector<double>& responseValues,
+                                   const std::vector<double>& objectiveValues)
+  : m_id(id),
+    m_handle(handle),
+    m_name(name),
+    m_displayName(displayName),
+    m_complete(complete),
+    m_failed(failed),
+    m_responseValues(responseValues),
+    m_objectiveValues(objectiveValues)
+{}
+
+int DataPointSummary::id() const {
+  return m_id;
+}
+
+UUID DataPointSummary::handle() const {
+  return m_handle;
+}
+
+std::string DataPointSummary::name() const {
+  return m_name;
+}
+
+std::string DataPointSummary::displayName() const {
+  return m_displayName;
+}
+
+bool DataPointSummary::isComplete() const {
+  return m_complete;
+}
+
+bool DataPointSummary::failed() const {
+  return m_failed;
+}
+
+std::vector<double> DataPointSummary::responseValues() const {
+  return m_responseValues;
+}
+
+std::vector<double> DataPointSummary::objectiveValues() const {
+  return m_objectiveValues;
+}
+
+boost::optional<DataPointRecord> DataPointSummary::dataPointRecord(ProjectDatabase& database) const {
+  return DataPointRecord::getDataPointRecord(m_id,database);
+}
+
 } // project
 } // openstudio
 
@@ -29,6 +29,7 @@ class FileReference;
 
 namespace analysis {
   class DataPoint;
+  class Problem;
 } // analysis
 namespace project {
 
@@ -119,6 +120,12 @@ class PROJECT_API DataPointRecord : public ObjectRecord {
 
   static std::vector<DataPointRecord> getDataPointRecords(ProjectDatabase& database);
 
+  /** Returns up to maxRecords DataPointRecords with id > afterId, in order of increasing id.
+   *  Pass the id of the last record of one page as afterId to get the next page. */
+  static std::vector<DataPointRecord> getDataPointRecords(ProjectDatabase& database,
+                                                          int afterId,
+                                                          unsigned maxRecords);
+
   static boost::optional<DataPointRecord> getDataPointRecord(int id, ProjectDatabase& database);
 
   /** @name Getters */
@@ -163,6 +170,11 @@ class PROJECT_API DataPointRecord : public ObjectRecord {
 
   analysis::DataPoint dataPoint() const;
 
+  /** Returns the DataPoint, using problem rather than deserializing problemRecord().problem()
+   *  again. problem must be equivalent to problemRecord().problem(). Use this when loading
+   *  many DataPoints of the same analysis. */
+  analysis::DataPoint dataPoint(const analysis::Problem& problem) const;
+
   //@}
   /** @name Setters */
   //@{
@@ -218,6 +230,60 @@ typedef boost::optional<DataPointRecord> OptionalDataPointRecord;
 /** \relates DataPointRecord*/
 typedef std::vector<DataPointRecord> DataPointRecordVector;
 
+/** DataPointSummary is a lightweight, read-only projection of a DataPointRecord, for listing
+ *  analyses with many data points without constructing full records or DataPoints. It holds
+ *  only the status columns and response and objective values, and can load the full
+ *  DataPointRecord on demand. \sa AnalysisRecord::dataPointSummaries */
+class PROJECT_API DataPointSummary {
+ public:
+  DataPointSummary(int id,
+                   const UUID& handle,
+                   const std::string& name,
+                   const std::string& displayName,
+                   bool complete,
+                   bool failed,
+                   const std::vector<double>& responseValues,
+                   const std::vector<double>& objectiveValues);
+
+  /** Returns the id of the DataPointRecord. */
+  int id() const;
+
+  /** Returns the handle of the DataPointRecord. */
+  UUID handle() const;
+
+  std::string name() const;
+
+  std::string displayName() const;
+
+  bool isComplete() const;
+
+  bool failed() const;
+
+  /** Response values, in function vector index order. Empty if there are no results. */
+  std::vector<double> responseValues() const;
+
+  /** Objective values, in function vector index order. Empty if there are no results or the
+   *  data point is not an OptimizationDataPointRecord. */
+  std::vector<double> objectiveValues() const;
+
+  /** Loads the full DataPointRecord from database. Returns boost::none if it has been
+   *  removed since this summary was created. */
+  boost::optional<DataPointRecord> dataPointRecord(ProjectDatabase& database) const;
+
+ private:
+  int m_id;
+  UUID m_handle;
+  std::string m_name;
+  std::string m_displayName;
+  bool m_complete;
+  bool m_failed;
+  std::vector<double> m_responseValues;
+  std::vector<double> m_objectiveValues;
+};
+
+/** \relates DataPointSummary*/
+typedef std::vector<DataPointSummary> DataPointSummaryVector;
+
 } // project
 } // openstudio
 
@@ -28,6 +28,7 @@
 namespace openstudio {
 namespace analysis {
   class DataPoint;
+  class Problem;
 } // analysis
 namespace project {
 
@@ -125,6 +126,9 @@ namespace detail {
 
     virtual analysis::DataPoint dataPoint() const;
 
+    /** Returns the DataPoint, using problem in place of problemRecord().problem(). */
+    virtual analysis::DataPoint dataPoint(const analysis::Problem& problem) const;
+
     //}
     /** @name Setters */
     //@{
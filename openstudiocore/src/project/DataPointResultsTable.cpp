@@ -0,0 +1,495 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <project/DataPointResultsTable.hpp>
+#include <project/AnalysisRecord.hpp>
+#include <project/DataPointRecord.hpp>
+#include <project/ProjectDatabase_Impl.hpp>
+#include <project/Record.hpp>
+
+#include <utilities/data/Attribute.hpp>
+#include <utilities/units/Quantity.hpp>
+#include <utilities/core/Assert.hpp>
+#include <utilities/core/String.hpp>
+
+#include <QSqlQuery>
+#include <QSqlDatabase>
+
+#include <boost/algorithm/string/case_conv.hpp>
+#include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+namespace openstudio {
+namespace project {
+
+namespace {
+
+  void flattenAttribute(const Attribute& attribute,
+                        const std::string& prefix,
+                        std::vector<std::pair<std::string,QVariant> >& result)
+  {
+    std::string path = prefix.empty() ? attribute.name() : prefix + "." + attribute.name();
+    switch (attribute.valueType().value()) {
+      case AttributeValueType::Boolean :
+        result.push_back(std::make_pair(path,QVariant(attribute.valueAsBoolean() ? 1 : 0)));
+        break;
+      case AttributeValueType::Integer :
+        result.push_back(std::make_pair(path,QVariant(attribute.valueAsInteger())));
+        break;
+      case AttributeValueType::Unsigned :
+        result.push_back(std::make_pair(path,QVariant(attribute.valueAsUnsigned())));
+        break;
+      case AttributeValueType::Double :
+        result.push_back(std::make_pair(path,QVariant(attribute.valueAsDouble())));
+        break;
+      case AttributeValueType::Quantity :
+        result.push_back(std::make_pair(path,QVariant(attribute.valueAsQuantity().value())));
+        break;
+      case AttributeValueType::String :
+        result.push_back(std::make_pair(path,QVariant(toQString(attribute.valueAsString()))));
+        break;
+      case AttributeValueType::AttributeVector :
+        BOOST_FOREACH(const Attribute& child,attribute.valueAsAttributeVector()) {
+          flattenAttribute(child,path,result);
+        }
+        break;
+      default :
+        break;
+    }
+  }
+
+  std::string sqlType(const QVariant& value) {
+    switch (value.type()) {
+      case QVariant::Bool :
+      case QVariant::Int :
+      case QVariant::UInt :
+      case QVariant::LongLong :
+      case QVariant::ULongLong :
+        return "INTEGER";
+      case QVariant::Double :
+        return "REAL";
+      default :
+        return "TEXT";
+    }
+  }
+
+  std::string sqlOperator(const DataPointResultComparison& comparison) {
+    switch (comparison.value()) {
+      case DataPointResultComparison::Equal : return "=";
+      case DataPointResultComparison::NotEqual : return "!=";
+      case DataPointResultComparison::LessThan : return "<";
+      case DataPointResultComparison::LessThanOrEqual : return "<=";
+      case DataPointResultComparison::GreaterThan : return ">";
+      case DataPointResultComparison::GreaterThanOrEqual : return ">=";
+      default :
+        BOOST_ASSERT(false);
+    }
+    return "=";
+  }
+
+  std::string sqlFunction(const DataPointResultAggregate& aggregate) {
+    switch (aggregate.value()) {
+      case DataPointResultAggregate::Count : return "COUNT";
+      case DataPointResultAggregate::Minimum : return "MIN";
+      case DataPointResultAggregate::Maximum : return "MAX";
+      case DataPointResultAggregate::Sum : return "SUM";
+      case DataPointResultAggregate::Mean : return "AVG";
+      default :
+        BOOST_ASSERT(false);
+    }
+    return "COUNT";
+  }
+
+  // SQLite refuses statements with more than 999 bound parameters by default, so results with 
+  // many columns are written in several statements
+  const unsigned maxColumnsPerStatement = 500;
+
+  struct ParetoPoint {
+    int id;
+    std::vector<double> objectives;
+
+    bool operator<(const ParetoPoint& other) const {
+      return objectives < other.objectives;
+    }
+
+    bool dominatedBy(const ParetoPoint& other) const {
+      bool strictlyBetter = false;
+      for (unsigned i = 0, n = objectives.size(); i < n; ++i) {
+        if (other.objectives[i] > objectives[i]) {
+          return false;
+        }
+        if (other.objectives[i] < objectives[i]) {
+          strictlyBetter = true;
+        }
+      }
+      return strictlyBetter;
+    }
+  };
+
+}
+
+DataPointResultsTable::DataPointResultsTable(const ProjectDatabase& database)
+  : m_database(database)
+{
+  // reads the columns the first time the database's results table is used
+  m_database.m_impl->dataPointResultsColumns();
+}
+
+DataPointResultsTable::DataPointResultsTable(const AnalysisRecord& analysisRecord)
+  : m_database(analysisRecord.projectDatabase()), m_analysisRecordId(analysisRecord.id())
+{
+  m_database.m_impl->dataPointResultsColumns();
+}
+
+std::string DataPointResultsTable::databaseTableName() {
+  return "DataPointResults";
+}
+
+std::vector<std::pair<std::string,QVariant> > DataPointResultsTable::flatten(
+    const std::vector<Attribute>& attributes)
+{
+  std::vector<std::pair<std::string,QVariant> > result;
+  BOOST_FOREACH(const Attribute& attribute,attributes) {
+    flattenAttribute(attribute,std::string(),result);
+  }
+  return result;
+}
+
+bool DataPointResultsTable::setResults(int dataPointRecordId, const std::vector<Attribute>& attributes) {
+  return setResults(dataPointRecordId,flatten(attributes));
+}
+
+bool DataPointResultsTable::setResults(int dataPointRecordId,
+                                       const std::vector<std::pair<std::string,QVariant> >& values)
+{
+  // last value wins for repeated paths, column order follows first appearance. paths that 
+  // only differ in case share a column
+  std::vector<std::string> columns;
+  std::map<std::string,QVariant> valueMap;
+  typedef std::pair<std::string,QVariant> PathValuePair;
+  BOOST_FOREACH(const PathValuePair& value,values) {
+    std::string key = columnKey(value.first);
+    if (valueMap.find(key) == valueMap.end()) {
+      columns.push_back(value.first);
+    }
+    valueMap[key] = value.second;
+  }
+
+  try {
+    BOOST_FOREACH(const std::string& column,columns) {
+      if (!hasColumn(column)) {
+        addColumn(column,valueMap[columnKey(column)]);
+      }
+    }
+
+    // replacing the row clears any previous results
+    QSqlQuery query(*(m_database.qSqlDatabase()));
+    query.prepare(toQString("INSERT OR REPLACE INTO " + databaseTableName() + 
+                            " (dataPointRecordId) VALUES (?)"));
+    query.addBindValue(dataPointRecordId);
+    assertExec(query);
+
+    for (unsigned begin = 0, n = columns.size(); begin < n; begin += maxColumnsPerStatement) {
+      unsigned end = std::min(begin + maxColumnsPerStatement,n);
+
+      std::stringstream assignments;
+      for (unsigned i = begin; i < end; ++i) {
+        if (i > begin) {
+          assignments << ", ";
+        }
+        assignments << quoteName(columns[i]) << "=?";
+      }
+
+      QSqlQuery update(*(m_database.qSqlDatabase()));
+      update.prepare(toQString("UPDATE " + databaseTableName() + " SET " + assignments.str() +
+                               " WHERE dataPointRecordId=?"));
+      for (unsigned i = begin; i < end; ++i) {
+        update.addBindValue(valueMap[columnKey(columns[i])]);
+      }
+      update.addBindValue(dataPointRecordId);
+      assertExec(update);
+    }
+  }
+  catch (const std::exception& e) {
+    // a rolled back transaction may have taken added columns with it
+    m_database.m_impl->resetDataPointResultsColumns();
+    LOG(Error,"Unable to save results for DataPointRecord " << dataPointRecordId << ", because '"
+        << e.what() << "'.");
+    return false;
+  }
+  return true;
+}
+
+bool DataPointResultsTable::removeResults(int dataPointRecordId) {
+  QSqlQuery query(*(m_database.qSqlDatabase()));
+  query.prepare(toQString("DELETE FROM " + databaseTableName() + " WHERE dataPointRecordId=:id"));
+  query.bindValue(":id",dataPointRecordId);
+  try {
+    assertExec(query);
+  }
+  catch (const std::exception& e) {
+    LOG(Error,"Unable to remove results for DataPointRecord " << dataPointRecordId << ", because '"
+        << e.what() << "'.");
+    return false;
+  }
+  return true;
+}
+
+std::vector<std::string> DataPointResultsTable::columnNames() const {
+  return m_database.m_impl->dataPointResultsColumns();
+}
+
+std::vector<int> DataPointResultsTable::dataPointRecordIds() const {
+  std::vector<int> result;
+  QSqlQuery query(*(m_database.qSqlDatabase()));
+  query.prepare(toQString("SELECT dataPointRecordId FROM " + databaseTableName() + " WHERE " +
+                          rowCondition() + " ORDER BY dataPointRecordId"));
+  assertExec(query);
+  while (query.next()) {
+    result.push_back(query.value(0).toInt());
+  }
+  return result;
+}
+
+std::vector<QVariant> DataPointResultsTable::values(const std::string& column) const {
+  std::vector<QVariant> result;
+  if (!hasColumn(column)) {
+    LOG(Debug,"No results column named '" << column << "'.");
+    result.resize(dataPointRecordIds().size());
+    return result;
+  }
+
+  QSqlQuery query(*(m_database.qSqlDatabase()));
+  query.prepare(toQString("SELECT " + quoteName(column) + " FROM " + databaseTableName() +
+                          " WHERE " + rowCondition() + " ORDER BY dataPointRecordId"));
+  assertExec(query);
+  while (query.next()) {
+    result.push_back(query.value(0));
+  }
+  return result;
+}
+
+std::vector<OptionalDouble> DataPointResultsTable::doubleValues(const std::string& column) const {
+  std::vector<OptionalDouble> result;
+  BOOST_FOREACH(const QVariant& value,values(column)) {
+    bool ok(false);
+    double d = value.toDouble(&ok);
+    if (!value.isNull() && ok) {
+      result.push_back(d);
+    }
+    else {
+      result.push_back(boost::none);
+    }
+  }
+  return result;
+}
+
+std::vector<int> DataPointResultsTable::filter(const std::string& column,
+                                               const DataPointResultComparison& comparison,
+                                               const QVariant& value) const
+{
+  std::vector<int> result;
+  if (!hasColumn(column)) {
+    return result;
+  }
+
+  QSqlQuery query(*(m_database.qSqlDatabase()));
+  query.prepare(toQString("SELECT dataPointRecordId FROM " + databaseTableName() + " WHERE " +
+                          rowCondition() + " AND " + quoteName(column) + sqlOperator(comparison) +
+                          ":value ORDER BY dataPointRecordId"));
+  query.bindValue(":value",value);
+  assertExec(query);
+  while (query.next()) {
+    result.push_back(query.value(0).toInt());
+  }
+  return result;
+}
+
+std::vector<int> DataPointResultsTable::sort(const std::string& column, bool ascending) const {
+  if (!hasColumn(column)) {
+    return dataPointRecordIds();
+  }
+
+  std::vector<int> result;
+  QSqlQuery query(*(m_database.qSqlDatabase()));
+  query.prepare(toQString("SELECT dataPointRecordId FROM " + databaseTableName() + " WHERE " +
+                          rowCondition() + " ORDER BY " + quoteName(column) + " IS NULL, " +
+                          quoteName(column) + (ascending ? " ASC" : " DESC") + ", dataPointRecordId"));
+  assertExec(query);
+  while (query.next()) {
+    result.push_back(query.value(0).toInt());
+  }
+  return result;
+}
+
+OptionalDouble DataPointResultsTable::aggregate(const std::string& column,
+                                                const DataPointResultAggregate& aggregate) const
+{
+  OptionalDouble result;
+  if (!hasColumn(column)) {
+    if (aggregate == DataPointResultAggregate::Count) {
+      result = 0.0;
+    }
+    return result;
+  }
+
+  QSqlQuery query(*(m_database.qSqlDatabase()));
+  query.prepare(toQString("SELECT " + sqlFunction(aggregate) + "(" + quoteName(column) + ") FROM " +
+                          databaseTableName() + " WHERE " + rowCondition()));
+  assertExec(query);
+  if (query.first() && !query.value(0).isNull()) {
+    result = query.value(0).toDouble();
+  }
+  return result;
+}
+
+std::vector<int> DataPointResultsTable::paretoFront(const std::vector<std::string>& columns,
+                                                    const std::vector<bool>& maximize) const
+{
+  std::vector<int> result;
+  if (columns.empty()) {
+    return result;
+  }
+  if (!maximize.empty() && (maximize.size() != columns.size())) {
+    LOG(Error,"Expected " << columns.size() << " maximize flags, but received " << maximize.size() << ".");
+    return result;
+  }
+
+  std::stringstream select, notNull;
+  select << "SELECT dataPointRecordId";
+  BOOST_FOREACH(const std::string& column,columns) {
+    if (!hasColumn(column)) {
+      return result;
+    }
+    select << ", " << quoteName(column);
+    notNull << " AND " << quoteName(column) << " IS NOT NULL";
+  }
+
+  std::vector<ParetoPoint> points;
+  QSqlQuery query(*(m_database.qSqlDatabase()));
+  query.prepare(toQString(select.str() + " FROM " + databaseTableName() + " WHERE " +
+                          rowCondition() + notNull.str()));
+  assertExec(query);
+  unsigned n = columns.size();
+  while (query.next()) {
+    ParetoPoint point;
+    point.id = query.value(0).toInt();
+    for (unsigned i = 0; i < n; ++i) {
+      double value = query.value(i + 1).toDouble();
+      point.objectives.push_back((!maximize.empty() && maximize[i]) ? -value : value);
+    }
+    points.push_back(point);
+  }
+
+  // after a lexicographic sort a point can only be dominated by points before it, and
+  // any dominated point before it is itself dominated by a point already in the front
+  std::sort(points.begin(),points.end());
+  std::vector<ParetoPoint> front;
+  BOOST_FOREACH(const ParetoPoint& point,points) {
+    bool dominated = false;
+    BOOST_FOREACH(const ParetoPoint& frontPoint,front) {
+      if (point.dominatedBy(frontPoint)) {
+        dominated = true;
+        break;
+      }
+    }
+    if (!dominated) {
+      front.push_back(point);
+    }
+  }
+
+  BOOST_FOREACH(const ParetoPoint& point,front) {
+    result.push_back(point.id);
+  }
+  std::sort(result.begin(),result.end());
+  return result;
+}
+
+void DataPointResultsTable::createTable(QSqlDatabase& database) {
+  QSqlQuery query(database);
+  query.prepare(toQString("CREATE TABLE IF NOT EXISTS " + databaseTableName() +
+                          " (dataPointRecordId INTEGER PRIMARY KEY)"));
+  assertExec(query);
+}
+
+std::vector<std::string> DataPointResultsTable::loadColumnNames(QSqlDatabase& database) {
+  std::vector<std::string> result;
+
+  // databases written by development builds of 1.0.3 may not have the table yet
+  createTable(database);
+
+  QSqlQuery query(database);
+  query.prepare(toQString("PRAGMA table_info(" + databaseTableName() + ")"));
+  assertExec(query);
+  while (query.next()) {
+    // columns are cid, name, type, notnull, dflt_value, pk
+    std::string name = toString(query.value(1).toString());
+    if (columnKey(name) != columnKey("dataPointRecordId")) {
+      result.push_back(name);
+    }
+  }
+  return result;
+}
+
+std::string DataPointResultsTable::columnKey(const std::string& column) {
+  return boost::algorithm::to_lower_copy(column);
+}
+
+bool DataPointResultsTable::addColumn(const std::string& column, const QVariant& value) {
+  QSqlQuery query(*(m_database.qSqlDatabase()));
+  query.prepare(toQString("ALTER TABLE " + databaseTableName() + " ADD COLUMN " +
+                          quoteName(column) + " " + sqlType(value)));
+  assertExec(query);
+  m_database.m_impl->addDataPointResultsColumn(column);
+  return true;
+}
+
+bool DataPointResultsTable::hasColumn(const std::string& column) const {
+  return m_database.m_impl->hasDataPointResultsColumn(column);
+}
+
+std::string DataPointResultsTable::rowCondition() const {
+  std::string result = "dataPointRecordId IN (SELECT id FROM " + DataPointRecord::databaseTableName();
+  if (m_analysisRecordId) {
+    result += " WHERE analysisRecordId=" + boost::lexical_cast<std::string>(*m_analysisRecordId);
+  }
+  result += ")";
+  return result;
+}
+
+std::string DataPointResultsTable::quoteName(const std::string& name) {
+  std::string result("\"");
+  BOOST_FOREACH(char c,name) {
+    if (c == '"') {
+      result += "\"\"";
+    }
+    else {
+      result += c;
+    }
+  }
+  result += "\"";
+  return result;
+}
+
+} // project
+} // openstudio
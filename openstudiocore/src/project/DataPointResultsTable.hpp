@@ -0,0 +1,182 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef PROJECT_DATAPOINTRESULTSTABLE_HPP
+#define PROJECT_DATAPOINTRESULTSTABLE_HPP
+
+#include <project/ProjectAPI.hpp>
+#include <project/ProjectDatabase.hpp>
+
+#include <utilities/core/Enum.hpp>
+#include <utilities/core/Logger.hpp>
+#include <utilities/core/Optional.hpp>
+
+#include <QVariant>
+
+class QSqlDatabase;
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace openstudio {
+
+class Attribute;
+
+namespace project {
+
+class AnalysisRecord;
+
+/** \class DataPointResultComparison
+ *  \brief Comparison operators for DataPointResultsTable::filter.
+ *
+ *  \relates DataPointResultsTable */
+OPENSTUDIO_ENUM(DataPointResultComparison,
+  ((Equal)(Equal)(0))
+  ((NotEqual)(NotEqual)(1))
+  ((LessThan)(LessThan)(2))
+  ((LessThanOrEqual)(LessThanOrEqual)(3))
+  ((GreaterThan)(GreaterThan)(4))
+  ((GreaterThanOrEqual)(GreaterThanOrEqual)(5))
+);
+
+/** \class DataPointResultAggregate
+ *  \brief Aggregate functions for DataPointResultsTable::aggregate.
+ *
+ *  \relates DataPointResultsTable */
+OPENSTUDIO_ENUM(DataPointResultAggregate,
+  ((Count)(Count)(0))
+  ((Minimum)(Minimum)(1))
+  ((Maximum)(Maximum)(2))
+  ((Sum)(Sum)(3))
+  ((Mean)(Mean)(4))
+);
+
+/** DataPointResultsTable is a columnar view of data point output attributes. The 
+ *  DataPointResults table holds one row per DataPointRecord, keyed by its id, and one typed 
+ *  column per attribute path. Attribute paths are the names of nested attributes joined with 
+ *  '.', e.g. "EnergyPlus.NetSiteEnergy". Columns are added as new paths are seen.
+ *
+ *  DataPointRecord writes a data point's output attributes here when it saves them, so summary 
+ *  tables over many data points can be filtered, sorted and aggregated in SQL without loading 
+ *  or parsing any Attribute. Rows whose DataPointRecord is no longer in the database are 
+ *  ignored by all queries.
+ *
+ *  Like SQLite column names, attribute paths are compared case insensitively. The table is 
+ *  part of the project database schema since version 1.0.3, older databases get it when they 
+ *  are updated. */
+class PROJECT_API DataPointResultsTable {
+ public:
+  /** @name Constructors and Destructors */
+  //@{
+
+  /** Results table for all data points in database. */
+  explicit DataPointResultsTable(const ProjectDatabase& database);
+
+  /** Results table restricted to the data points of analysisRecord. */
+  explicit DataPointResultsTable(const AnalysisRecord& analysisRecord);
+
+  virtual ~DataPointResultsTable() {}
+
+  //@}
+
+  static std::string databaseTableName();
+
+  /** Flattens attributes into (path, value) pairs. Boolean, Integer and Unsigned attributes map 
+   *  to integers, Double and Quantity attributes to doubles (Quantity in its own units) and 
+   *  String attributes to strings. AttributeVector attributes contribute their children, and 
+   *  Unit attributes are skipped. */
+  static std::vector<std::pair<std::string,QVariant> > flatten(const std::vector<Attribute>& attributes);
+
+  /** @name Setters */
+  //@{
+
+  /** Replaces the results of the data point with id dataPointRecordId by the flattened 
+   *  attributes. */
+  bool setResults(int dataPointRecordId, const std::vector<Attribute>& attributes);
+
+  /** Replaces the results of the data point with id dataPointRecordId by values, which are 
+   *  (path, value) pairs as returned by flatten. */
+  bool setResults(int dataPointRecordId, const std::vector<std::pair<std::string,QVariant> >& values);
+
+  bool removeResults(int dataPointRecordId);
+
+  //@}
+  /** @name Queries */
+  //@{
+
+  /** Attribute paths with a column in the table, in column order. */
+  std::vector<std::string> columnNames() const;
+
+  /** Ids of the data points with results, in ascending order. */
+  std::vector<int> dataPointRecordIds() const;
+
+  /** Values of column for each id in dataPointRecordIds(). Missing values are null. */
+  std::vector<QVariant> values(const std::string& column) const;
+
+  /** Numeric values of column for each id in dataPointRecordIds(). */
+  std::vector<OptionalDouble> doubleValues(const std::string& column) const;
+
+  /** Ids of the data points whose value in column compares to value as requested. */
+  std::vector<int> filter(const std::string& column,
+                          const DataPointResultComparison& comparison,
+                          const QVariant& value) const;
+
+  /** Ids of the data points with results, ordered by column. Missing values come last. */
+  std::vector<int> sort(const std::string& column, bool ascending = true) const;
+
+  /** Aggregate of the non-null values in column. Returns the count for DataPointResultAggregate::Count,
+   *  and an empty optional if there are no values to aggregate. */
+  OptionalDouble aggregate(const std::string& column, const DataPointResultAggregate& aggregate) const;
+
+  /** Ids of the data points that are not dominated in columns. Columns are minimized unless the 
+   *  corresponding entry of maximize is true. Data points missing any value are ignored. */
+  std::vector<int> paretoFront(const std::vector<std::string>& columns,
+                               const std::vector<bool>& maximize = std::vector<bool>()) const;
+
+  //@}
+ private:
+  REGISTER_LOGGER("openstudio.project.DataPointResultsTable");
+
+  friend class detail::ProjectDatabase_Impl;
+
+  static void createTable(QSqlDatabase& database);
+
+  static std::vector<std::string> loadColumnNames(QSqlDatabase& database);
+
+  /** Key used to compare column names, SQLite ignores the case of ASCII letters. */
+  static std::string columnKey(const std::string& column);
+
+  bool addColumn(const std::string& column, const QVariant& value);
+
+  bool hasColumn(const std::string& column) const;
+
+  // restricts queries to existing data points
+  std::string rowCondition() const;
+
+  static std::string quoteName(const std::string& name);
+
+  ProjectDatabase m_database;
+  OptionalInt m_analysisRecordId;
+};
+
+} // project
+} // openstudio
+
+#endif // PROJECT_DATAPOINTRESULTSTABLE_HPP
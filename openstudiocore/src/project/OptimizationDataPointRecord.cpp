@@ -85,6 +85,12 @@ namespace detail {
     return optimizationDataPoint().cast<analysis::DataPoint>();
   }
 
+  analysis::DataPoint OptimizationDataPointRecord_Impl::dataPoint(
+      const analysis::Problem& problem) const
+  {
+    return optimizationDataPoint(problem.cast<analysis::OptimizationProblem>()).cast<analysis::DataPoint>();
+  }
+
   void OptimizationDataPointRecord_Impl::clearResults() {
     ProjectDatabase database = projectDatabase();
     DataPointValueRecordVector ovrs = objectiveValueRecords();
@@ -125,7 +131,13 @@ namespace detail {
   }
 
   analysis::OptimizationDataPoint OptimizationDataPointRecord_Impl::optimizationDataPoint() const {
-    analysis::DataPoint prelim = DataPointRecord_Impl::dataPoint();
+    return optimizationDataPoint(problemRecord().problem().cast<analysis::OptimizationProblem>());
+  }
+
+  analysis::OptimizationDataPoint OptimizationDataPointRecord_Impl::optimizationDataPoint(
+      const analysis::OptimizationProblem& problem) const
+  {
+    analysis::DataPoint prelim = DataPointRecord_Impl::dataPoint(problem);
     return analysis::OptimizationDataPoint(prelim.uuid(),
                                            prelim.versionUUID(),
                                            prelim.name(),
@@ -26,6 +26,7 @@
 namespace openstudio {
 namespace analysis {
   class OptimizationDataPoint;
+  class OptimizationProblem;
 }
 namespace project {
 
@@ -64,6 +65,8 @@ namespace detail {
 
     virtual analysis::DataPoint dataPoint() const;
 
+    virtual analysis::DataPoint dataPoint(const analysis::Problem& problem) const;
+
     /** Provided for callers operating directly on the database, not holding a copy of this
      *  analysis in memory. Use with caution. Does not do file system cleanup. */
     virtual void clearResults();
@@ -78,6 +81,9 @@ namespace detail {
 
     analysis::OptimizationDataPoint optimizationDataPoint() const;
 
+    analysis::OptimizationDataPoint optimizationDataPoint(
+        const analysis::OptimizationProblem& problem) const;
+
     //@}
    protected:
     /** Bind data member values to a query for saving. */
@@ -256,6 +256,7 @@ OBJECTRECORD_WRAP(DakotaAlgorithmRecord);
 OBJECTRECORD_WRAP(DDACEAlgorithmRecord);
 OBJECTRECORD_WRAP(DataPointRecord);
 OBJECTRECORD_WRAP(OptimizationDataPointRecord);
+%template(DataPointSummaryVector) std::vector<openstudio::project::DataPointSummary>;
 OBJECTRECORD_WRAP(DataPointValueRecord);
 OBJECTRECORD_WRAP(AnalysisRecord);
 OBJECTRECORD_WRAP(PSUADEDaceAlgorithmRecord);
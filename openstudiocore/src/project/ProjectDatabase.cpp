@@ -38,6 +38,7 @@
 #include <project/ContinuousVariableRecord.hpp>
 #include <project/DataPointRecord.hpp>
 #include <project/DataPointRecord_Impl.hpp>
+#include <project/DataPointResultsTable.hpp>
 #include <project/DataPointValueRecord.hpp>
 #include <project/DataPointValueRecord_Impl.hpp>
 #include <project/DiscretePerturbationRecord.hpp>
@@ -104,7 +105,8 @@ namespace detail {
     : m_runManager(runManager),
       m_path(path),
       m_reloaded(true),
-      m_ignoreSignals(false)
+      m_ignoreSignals(false),
+      m_dataPointResultsColumnsLoaded(false)
   {
     // do we need to create tables?
     bool needsInitialize = false;
@@ -181,6 +183,9 @@ namespace detail {
       // any uncommitted transactions will now be lost
     }
 
+    // finalize cached statements before closing the connection
+    m_preparedQueries.clear();
+
     // make sure we are the last one using database connection
     BOOST_ASSERT(m_qSqlDatabase.use_count() == 1);
 
@@ -661,6 +666,10 @@ namespace detail {
   }
 
   void ProjectDatabase_Impl::updateDatabase(const std::string& dbVersion) {
+    // schema changes invalidate cached statements
+    m_preparedQueries.clear();
+    resetDataPointResultsColumns();
+
     VersionString osv(openStudioVersion());
     VersionString dbv(dbVersion);
 
@@ -715,6 +724,10 @@ namespace detail {
       update_1_0_0_to_1_0_1(dbv);
 	}
 
+    if (dbv < VersionString("1.0.3")) {
+      update_1_0_2_to_1_0_3(dbv);
+    }
+
     if ((dbv != osv) || (!dbv.fidelityEqual(osv))) {
       LOG(Info,"Updating database version to " << osv << ".");
       bool didStartTransaction = startTransaction();
@@ -826,6 +839,99 @@ namespace detail {
     return m_qSqlDatabase;
   }
 
+  QSqlQuery ProjectDatabase_Impl::preparedQuery(const std::string& queryString) const
+  {
+    std::map<std::string, QSqlQuery>::iterator it = m_preparedQueries.find(queryString);
+    if (it == m_preparedQueries.end()){
+      QSqlQuery query(*m_qSqlDatabase);
+      bool test = query.prepare(QString::fromStdString(queryString));
+      if (!test){
+        // do not cache, let the caller report the error on exec
+        return query;
+      }
+      it = m_preparedQueries.insert(std::make_pair(queryString, query)).first;
+    }
+
+    // copies of a QSqlQuery share the prepared statement
+    return it->second;
+  }
+
+  unsigned ProjectDatabase_Impl::numPreparedQueries() const
+  {
+    return m_preparedQueries.size();
+  }
+
+  std::vector<std::string> ProjectDatabase_Impl::dataPointResultsColumns() const
+  {
+    loadDataPointResultsColumns();
+    return m_dataPointResultsColumns;
+  }
+
+  bool ProjectDatabase_Impl::hasDataPointResultsColumn(const std::string& column) const
+  {
+    loadDataPointResultsColumns();
+    return (m_dataPointResultsColumnKeys.find(DataPointResultsTable::columnKey(column)) != m_dataPointResultsColumnKeys.end());
+  }
+
+  void ProjectDatabase_Impl::addDataPointResultsColumn(const std::string& column)
+  {
+    loadDataPointResultsColumns();
+    if (m_dataPointResultsColumnKeys.insert(DataPointResultsTable::columnKey(column)).second){
+      m_dataPointResultsColumns.push_back(column);
+    }
+  }
+
+  void ProjectDatabase_Impl::resetDataPointResultsColumns()
+  {
+    m_dataPointResultsColumnsLoaded = false;
+    m_dataPointResultsColumns.clear();
+    m_dataPointResultsColumnKeys.clear();
+  }
+
+  void ProjectDatabase_Impl::loadDataPointResultsColumns() const
+  {
+    if (m_dataPointResultsColumnsLoaded){
+      return;
+    }
+
+    m_dataPointResultsColumns = DataPointResultsTable::loadColumnNames(*m_qSqlDatabase);
+    m_dataPointResultsColumnKeys.clear();
+    BOOST_FOREACH(const std::string& column, m_dataPointResultsColumns){
+      m_dataPointResultsColumnKeys.insert(DataPointResultsTable::columnKey(column));
+    }
+    m_dataPointResultsColumnsLoaded = true;
+  }
+
+  bool ProjectDatabase_Impl::writeAheadLogging() const
+  {
+    QSqlQuery query(*m_qSqlDatabase);
+    query.prepare("PRAGMA journal_mode");
+    if (!query.exec() || !query.first()){
+      return false;
+    }
+    return istringEqual(toString(query.value(0).toString()), "wal");
+  }
+
+  bool ProjectDatabase_Impl::setWriteAheadLogging(bool writeAheadLogging)
+  {
+    std::string mode = writeAheadLogging ? "wal" : "delete";
+
+    QSqlQuery query(*m_qSqlDatabase);
+    query.prepare(toQString("PRAGMA journal_mode=" + mode));
+    if (!query.exec() || !query.first()){
+      LOG(Warn, "Unable to set journal mode of " << toString(m_path) << " to " << mode << ".");
+      return false;
+    }
+
+    // sqlite returns the journal mode actually in effect
+    std::string result = toString(query.value(0).toString());
+    if (!istringEqual(result, mode)){
+      LOG(Warn, "Journal mode of " << toString(m_path) << " is " << result << ", not " << mode << ".");
+      return false;
+    }
+    return true;
+  }
+
   boost::optional<Record> ProjectDatabase_Impl::findLoadedRecord(const UUID& handle) const
   {
     boost::optional<Record> result;
@@ -929,6 +1035,9 @@ namespace detail {
     createTable<Rule_Clause_JoinRecord>();
     createTable<Ruleset_Rule_JoinRecord>();
 
+    // create results table, its columns are added as results are saved
+    DataPointResultsTable::createTable(*m_qSqlDatabase);
+
     bool test = this->commitTransaction();
     BOOST_ASSERT(test);
   }
@@ -1858,6 +1967,33 @@ namespace detail {
     BOOST_ASSERT(test);
   }
 
+  void ProjectDatabase_Impl::update_1_0_2_to_1_0_3(const VersionString& startVersion) {
+    bool didStartTransaction = startTransaction();
+    BOOST_ASSERT(didStartTransaction);
+
+    LOG(Info,"Adding table " << DataPointResultsTable::databaseTableName() << ".");
+
+    DataPointResultsTable::createTable(*m_qSqlDatabase);
+
+    // fill it from the output attributes already saved
+    ProjectDatabase database(this->shared_from_this());
+    DataPointResultsTable resultsTable(database);
+    BOOST_FOREACH(const DataPointRecord& dataPointRecord, DataPointRecord::getDataPointRecords(database)){
+      OptionalFileReferenceRecord xmlOutputDataRecord = dataPointRecord.xmlOutputDataRecord();
+      if (xmlOutputDataRecord){
+        std::vector<Attribute> attributes;
+        BOOST_FOREACH(const AttributeRecord& attributeRecord, xmlOutputDataRecord->attributeRecords()){
+          attributes.push_back(attributeRecord.attribute());
+        }
+        resultsTable.setResults(dataPointRecord.id(),attributes);
+      }
+    }
+
+    save();
+    bool test = this->commitTransaction();
+    BOOST_ASSERT(test);
+  }
+
   void ProjectDatabase_Impl::setProjectDatabaseRecord(const ProjectDatabaseRecord& projectDatabaseRecord)
   {
     m_projectDatabaseRecord = projectDatabaseRecord;
@@ -2210,6 +2346,21 @@ boost::shared_ptr<QSqlDatabase> ProjectDatabase::qSqlDatabase() const
   return m_impl->qSqlDatabase();
 }
 
+unsigned ProjectDatabase::numPreparedQueries() const
+{
+  return m_impl->numPreparedQueries();
+}
+
+bool ProjectDatabase::writeAheadLogging() const
+{
+  return m_impl->writeAheadLogging();
+}
+
+bool ProjectDatabase::setWriteAheadLogging(bool writeAheadLogging)
+{
+  return m_impl->setWriteAheadLogging(writeAheadLogging);
+}
+
 boost::optional<Record> ProjectDatabase::findLoadedRecord(const UUID& handle) const
 {
   return m_impl->findLoadedRecord(handle);
@@ -305,6 +305,19 @@ class PROJECT_API ProjectDatabase {
   /// Returns the QSqlDatabase.
   boost::shared_ptr<QSqlDatabase> qSqlDatabase() const;
 
+  /// Returns the number of SQL statements prepared and cached for this connection. Saving more
+  /// Records of the types already saved reuses these statements rather than adding to them.
+  unsigned numPreparedQueries() const;
+
+  /// Returns true if SQLite's write-ahead log is used instead of the default rollback journal.
+  bool writeAheadLogging() const;
+
+  /// Switches between SQLite's write-ahead log and the default rollback journal. The write-ahead
+  /// log makes saving large numbers of Records faster, but keeps -wal and -shm files next to the
+  /// database while it is open, and the database cannot be used from a network drive. Must be
+  /// called outside of a transaction. Returns false if the journal mode could not be changed.
+  bool setWriteAheadLogging(bool writeAheadLogging);
+
   /// Finds Record by handle, will check all maps but does not query database.
   boost::optional<Record> findLoadedRecord(const UUID& handle) const;
 
@@ -339,6 +352,7 @@ class PROJECT_API ProjectDatabase {
   /// @cond
 
   friend class Record;
+  friend class DataPointResultsTable;
   friend class detail::ProjectDatabase_Impl;
   friend class detail::Record_Impl;
 
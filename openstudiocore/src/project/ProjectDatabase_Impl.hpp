@@ -163,6 +163,32 @@ namespace project {
         /// get the qSql database
         boost::shared_ptr<QSqlDatabase> qSqlDatabase() const;
 
+        /// get a query prepared from queryString. statements are prepared once per connection
+        /// and cached, the returned query shares the cached statement
+        QSqlQuery preparedQuery(const std::string& queryString) const;
+
+        /// number of statements currently cached by preparedQuery
+        unsigned numPreparedQueries() const;
+
+        /// names of the DataPointResults columns in column order, read from the database the
+        /// first time they are needed
+        std::vector<std::string> dataPointResultsColumns() const;
+
+        /// does the DataPointResults table have column, compared case insensitively like SQLite
+        bool hasDataPointResultsColumn(const std::string& column) const;
+
+        /// record a column added to the DataPointResults table
+        void addDataPointResultsColumn(const std::string& column);
+
+        /// forget the DataPointResults columns, they are read again when next needed
+        void resetDataPointResultsColumns();
+
+        /// is SQLite's write-ahead log used instead of the rollback journal
+        bool writeAheadLogging() const;
+
+        /// switch between SQLite's write-ahead log and the rollback journal
+        bool setWriteAheadLogging(bool writeAheadLogging);
+
         // find record by handle, will check all maps
         boost::optional<Record> findLoadedRecord(const UUID& handle) const;
 
@@ -251,6 +277,9 @@ namespace project {
         void update_0_10_4_to_0_10_5(const VersionString& startVersion);
         void update_0_11_5_to_0_11_6(const VersionString& startVersion);
         void update_1_0_0_to_1_0_1(const VersionString& startVersion);
+        void update_1_0_2_to_1_0_3(const VersionString& startVersion);
+
+        void loadDataPointResultsColumns() const;
 
         void setProjectDatabaseRecord(const ProjectDatabaseRecord& projectDatabaseRecord);
 
@@ -271,6 +300,14 @@ namespace project {
         std::map<UUID, Record> m_handleRemovedRecordMap;
 
         std::vector<RemoveUndo> m_removeUndos;
+
+        // prepared statements by query string
+        mutable std::map<std::string, QSqlQuery> m_preparedQueries;
+
+        // DataPointResults columns in column order, and their case insensitive keys
+        mutable bool m_dataPointResultsColumnsLoaded;
+        mutable std::vector<std::string> m_dataPointResultsColumns;
+        mutable std::set<std::string> m_dataPointResultsColumnKeys;
     };
 
   } // detail
@@ -194,13 +194,14 @@ namespace project {
       boost::optional<int> result;
 
       QSqlQuery query(*(projectDatabase.qSqlDatabase()));
-      query.prepare(toQString("SELECT id FROM " + this->databaseTableName() + " WHERE handle=:handle"));
+      this->prepareQuery(query, "SELECT id FROM " + this->databaseTableName() + " WHERE handle=:handle");
       query.bindValue(":handle", toQString(toString(this->handle())));
 
       assertExec(query);
       if(query.first()){
         result = query.value(0).toInt();
       }
+      query.finish();
 
       return result;
    }
@@ -210,13 +211,14 @@ namespace project {
       QSqlQuery query(*database);
 
       // check there is not already an entry
-      query.prepare(QString::fromStdString("SELECT id FROM " + this->databaseTableName() + " WHERE handle=:handle"));
+      this->prepareQuery(query, "SELECT id FROM " + this->databaseTableName() + " WHERE handle=:handle");
       query.bindValue(":handle", toQString(toString(this->handle())));
       assertExec(query);
       BOOST_ASSERT(!query.first());
+      query.finish();
 
       // do the insert
-      query.prepare(QString::fromStdString("INSERT INTO " + this->databaseTableName() + " (id) VALUES (:id)"));
+      this->prepareQuery(query, "INSERT INTO " + this->databaseTableName() + " (id) VALUES (:id)");
       query.bindValue(":id", QVariant(QVariant::Int));
       assertExec(query);
 
@@ -258,6 +260,17 @@ namespace project {
       return this->compareValues(query);
     }
 
+    void Record_Impl::prepareQuery(QSqlQuery& query, const std::string& queryString) const
+    {
+      boost::shared_ptr<detail::ProjectDatabase_Impl> impl = m_projectDatabaseWeakImpl.lock();
+      if (impl){
+        query = impl->preparedQuery(queryString);
+      }else{
+        // database is being destructed
+        query.prepare(QString::fromStdString(queryString));
+      }
+    }
+
     void Record_Impl::makeSelectAllQuery(QSqlQuery& query) const
     {
       std::stringstream ss;
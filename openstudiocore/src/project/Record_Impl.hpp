@@ -179,11 +179,15 @@ namespace project {
         /// do we have values to revert to
         bool haveLastValues() const;
 
+        /// prepare query from queryString, reusing the statement cached by the ProjectDatabase
+        /// if it is still available
+        void prepareQuery(QSqlQuery& query, const std::string& queryString) const;
+
         /// get the query to update by id
         template<typename T>
         void makeUpdateByIdQuery(QSqlQuery& query) const {
           UpdateByIdQueryData queryData = T::updateByIdQueryData();
-          query.prepare(QString::fromStdString(queryData.queryString));
+          this->prepareQuery(query, queryData.queryString);
           std::set<int>::const_iterator colIndexIt = queryData.columnValues.begin();
           std::set<int>::const_iterator colIndexItEnd = queryData.columnValues.end();
           std::vector<QVariant>::const_iterator nullIt = queryData.nulls.begin();
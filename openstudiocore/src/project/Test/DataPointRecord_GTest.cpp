@@ -24,11 +24,14 @@
 #include <analysis/DataPoint_Impl.hpp>
 #include <analysis/DesignOfExperiments.hpp>
 #include <analysis/DesignOfExperimentsOptions.hpp>
+#include <analysis/DiscreteVariable.hpp>
+#include <analysis/NullPerturbation.hpp>
 #include <analysis/Problem.hpp>
 #include <analysis/Variable.hpp>
 
 #include <project/AnalysisRecord.hpp>
 #include <project/DataPointRecord.hpp>
+#include <project/ProblemRecord.hpp>
 #include <project/ProjectDatabase.hpp>
 #include <project/Test/ProjectFixture.hpp>
 
@@ -108,3 +111,185 @@ TEST_F(ProjectFixture,DataPoint_DataPointRecord_Synchronization) {
   }
 
 }
+
+TEST_F(ProjectFixture,DataPointRecord_BulkSave) {
+  ProjectDatabase database = getCleanDatabase("DataPointRecord_BulkSave");
+  EXPECT_TRUE(database.setWriteAheadLogging(true));
+  EXPECT_TRUE(database.writeAheadLogging());
+
+  // one discrete variable with many levels gives many data points
+  analysis::DiscretePerturbationVector perturbations;
+  for (int i = 0; i < 50; ++i) {
+    perturbations.push_back(analysis::NullPerturbation());
+  }
+  analysis::VariableVector variables;
+  variables.push_back(analysis::DiscreteVariable("Discrete",perturbations));
+  analysis::DesignOfExperiments algorithm(analysis::DesignOfExperimentsOptions(
+      analysis::DesignOfExperimentsType::FullFactorial));
+  analysis::Analysis analysis(
+      "Test Analysis",
+      analysis::Problem("Test Problem",variables,runmanager::Workflow()),
+      algorithm,
+      FileReference(toPath("in.osm")));
+  EXPECT_EQ(50,algorithm.createNextIteration(analysis));
+  ASSERT_EQ(50u,analysis.dataPoints().size());
+
+  // a second analysis of the same shape with twice the data points
+  analysis::DiscretePerturbationVector morePerturbations;
+  for (int i = 0; i < 100; ++i) {
+    morePerturbations.push_back(analysis::NullPerturbation());
+  }
+  analysis::VariableVector moreVariables;
+  moreVariables.push_back(analysis::DiscreteVariable("Discrete",morePerturbations));
+  analysis::DesignOfExperiments moreAlgorithm(analysis::DesignOfExperimentsOptions(
+      analysis::DesignOfExperimentsType::FullFactorial));
+  analysis::Analysis moreAnalysis(
+      "Larger Test Analysis",
+      analysis::Problem("Larger Test Problem",moreVariables,runmanager::Workflow()),
+      moreAlgorithm,
+      FileReference(toPath("in.osm")));
+  EXPECT_EQ(100,moreAlgorithm.createNextIteration(moreAnalysis));
+  ASSERT_EQ(100u,moreAnalysis.dataPoints().size());
+
+  {
+    bool didStartTransaction = database.startTransaction();
+    AnalysisRecord analysisRecord(analysis,database);
+    database.save();
+    if (didStartTransaction) {
+      database.commitTransaction();
+    }
+  }
+  unsigned numPreparedQueries = database.numPreparedQueries();
+  EXPECT_LT(0u,numPreparedQueries);
+
+  // inserting twice as many records of the same types prepares no new statements
+  {
+    bool didStartTransaction = database.startTransaction();
+    AnalysisRecord analysisRecord(moreAnalysis,database);
+    database.save();
+    if (didStartTransaction) {
+      database.commitTransaction();
+    }
+  }
+  EXPECT_EQ(numPreparedQueries,database.numPreparedQueries());
+  EXPECT_EQ(150u,DataPointRecord::getDataPointRecords(database).size());
+
+  // saving again reuses the prepared statements
+  {
+    bool didStartTransaction = database.startTransaction();
+    database.unloadUnusedCleanRecords();
+    AnalysisRecord analysisRecord(analysis,database);
+    database.save();
+    if (didStartTransaction) {
+      database.commitTransaction();
+    }
+  }
+
+  boost::optional<AnalysisRecord> analysisRecord;
+  BOOST_FOREACH(const AnalysisRecord& candidate, AnalysisRecord::getAnalysisRecords(database)) {
+    if (candidate.name() == "Test Analysis") {
+      analysisRecord = candidate;
+    }
+  }
+  ASSERT_TRUE(analysisRecord);
+  analysis::Analysis loadedAnalysis = analysisRecord->analysis();
+  analysis::DataPointVector loadedDataPoints = loadedAnalysis.dataPoints();
+  ASSERT_EQ(50u,loadedDataPoints.size());
+  std::vector<int> levelCounts(50,0);
+  BOOST_FOREACH(const analysis::DataPoint& dataPoint, loadedDataPoints) {
+    std::vector<QVariant> variableValues = dataPoint.variableValues();
+    ASSERT_EQ(1u,variableValues.size());
+    ++levelCounts[variableValues[0].toInt()];
+  }
+  BOOST_FOREACH(int count, levelCounts) {
+    EXPECT_EQ(1,count);
+  }
+  EXPECT_EQ(2u,AnalysisRecord::getAnalysisRecords(database).size());
+  EXPECT_EQ(150u,DataPointRecord::getDataPointRecords(database).size());
+
+  EXPECT_TRUE(database.setWriteAheadLogging(false));
+  EXPECT_FALSE(database.writeAheadLogging());
+}
+
+TEST_F(ProjectFixture,DataPointRecord_Paging) {
+  ProjectDatabase database = getCleanDatabase("DataPointRecord_Paging");
+
+  analysis::DiscretePerturbationVector perturbations;
+  for (int i = 0; i < 50; ++i) {
+    perturbations.push_back(analysis::NullPerturbation());
+  }
+  analysis::VariableVector variables;
+  variables.push_back(analysis::DiscreteVariable("Discrete",perturbations));
+  analysis::DesignOfExperiments algorithm(analysis::DesignOfExperimentsOptions(
+      analysis::DesignOfExperimentsType::FullFactorial));
+  analysis::Analysis analysis(
+      "Test Analysis",
+      analysis::Problem("Test Problem",variables,runmanager::Workflow()),
+      algorithm,
+      FileReference(toPath("in.osm")));
+  EXPECT_EQ(50,algorithm.createNextIteration(analysis));
+  analysis.dataPoints()[3].getImpl<analysis::detail::DataPoint_Impl>()->markComplete();
+
+  {
+    bool didStartTransaction = database.startTransaction();
+    AnalysisRecord analysisRecord(analysis,database);
+    database.save();
+    if (didStartTransaction) {
+      database.commitTransaction();
+    }
+  }
+
+  AnalysisRecordVector analysisRecords = AnalysisRecord::getAnalysisRecords(database);
+  ASSERT_EQ(1u,analysisRecords.size());
+  AnalysisRecord analysisRecord = analysisRecords[0];
+
+  // page through records
+  std::vector<unsigned> pageSizes;
+  std::set<UUID> handles;
+  int afterId = 0;
+  while (true) {
+    DataPointRecordVector page = analysisRecord.dataPointRecords(afterId,20u);
+    if (page.empty()) {
+      break;
+    }
+    pageSizes.push_back(page.size());
+    BOOST_FOREACH(const DataPointRecord& dataPointRecord, page) {
+      EXPECT_GT(dataPointRecord.id(),afterId);
+      afterId = dataPointRecord.id();
+      handles.insert(dataPointRecord.handle());
+    }
+  }
+  ASSERT_EQ(3u,pageSizes.size());
+  EXPECT_EQ(20u,pageSizes[0]);
+  EXPECT_EQ(20u,pageSizes[1]);
+  EXPECT_EQ(10u,pageSizes[2]);
+  EXPECT_EQ(50u,handles.size());
+  EXPECT_EQ(20u,DataPointRecord::getDataPointRecords(database,0,20u).size());
+  EXPECT_TRUE(analysisRecord.dataPointRecords(0,0u).empty());
+
+  // summaries cover the same page
+  DataPointRecordVector firstPage = analysisRecord.dataPointRecords(0,20u);
+  DataPointSummaryVector summaries = analysisRecord.dataPointSummaries(0,20u);
+  ASSERT_EQ(firstPage.size(),summaries.size());
+  unsigned nComplete(0);
+  for (unsigned i = 0, n = summaries.size(); i < n; ++i) {
+    EXPECT_EQ(firstPage[i].id(),summaries[i].id());
+    EXPECT_EQ(firstPage[i].handle(),summaries[i].handle());
+    EXPECT_EQ(firstPage[i].name(),summaries[i].name());
+    EXPECT_EQ(firstPage[i].isComplete(),summaries[i].isComplete());
+    EXPECT_FALSE(summaries[i].failed());
+    EXPECT_TRUE(summaries[i].responseValues().empty());
+    EXPECT_TRUE(summaries[i].objectiveValues().empty());
+    if (summaries[i].isComplete()) {
+      ++nComplete;
+    }
+  }
+  EXPECT_EQ(1u,nComplete);
+
+  // full record on demand
+  OptionalDataPointRecord loaded = summaries[5].dataPointRecord(database);
+  ASSERT_TRUE(loaded);
+  EXPECT_EQ(summaries[5].handle(),loaded->handle());
+  analysis::DataPoint dataPoint = loaded->dataPoint(analysisRecord.problemRecord().problem());
+  EXPECT_EQ(summaries[5].handle(),dataPoint.uuid());
+}
@@ -0,0 +1,263 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <project/DataPointResultsTable.hpp>
+#include <project/AnalysisRecord.hpp>
+#include <project/DataPointRecord.hpp>
+#include <project/Test/ProjectFixture.hpp>
+
+#include <analysis/Analysis.hpp>
+#include <analysis/Problem.hpp>
+#include <analysis/DataPoint.hpp>
+#include <analysis/DiscreteVariable.hpp>
+#include <analysis/NullPerturbation.hpp>
+#include <analysis/RubyPerturbation.hpp>
+
+#include <runmanager/lib/Workflow.hpp>
+
+#include <utilities/core/FileReference.hpp>
+#include <utilities/data/Attribute.hpp>
+
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+
+using namespace openstudio;
+using namespace openstudio::analysis;
+using namespace openstudio::project;
+
+namespace {
+
+  AttributeVector testResults(double energy, double cost, bool converged) {
+    AttributeVector annual;
+    annual.push_back(Attribute("NetSiteEnergy",energy,std::string("GJ")));
+    annual.push_back(Attribute("Cost",cost,std::string("$")));
+    AttributeVector result;
+    result.push_back(Attribute("EnergyPlus",annual));
+    result.push_back(Attribute("Converged",converged));
+    result.push_back(Attribute("Weather \"File\"",std::string("Golden.epw")));
+    return result;
+  }
+
+}
+
+TEST_F(ProjectFixture,DataPointResultsTable) {
+  Analysis analysis("My Analysis",
+                    Problem("My Problem",VariableVector(),runmanager::Workflow()),
+                    FileReferenceType::OSM);
+  Problem problem = analysis.problem();
+
+  DiscretePerturbationVector perturbations;
+  perturbations.push_back(NullPerturbation());
+  for (int j = 0; j < 4; ++j) {
+    std::stringstream ss;
+    ss << "measure" << j << ".rb";
+    perturbations.push_back(RubyPerturbation(toPath(ss.str()),
+                                             FileReferenceType::OSM,
+                                             FileReferenceType::OSM,true));
+  }
+  problem.push(DiscreteVariable("Variable",perturbations));
+
+  for (int i = 0; i < 5; ++i) {
+    std::vector<QVariant> values(1u,i);
+    OptionalDataPoint dataPoint = problem.createDataPoint(values);
+    ASSERT_TRUE(dataPoint);
+    EXPECT_TRUE(analysis.addDataPoint(*dataPoint));
+  }
+
+  ProjectDatabase database = getCleanDatabase("DataPointResultsTable");
+  database.startTransaction();
+  AnalysisRecord analysisRecord(analysis,database);
+  database.save();
+  database.commitTransaction();
+
+  std::vector<int> ids;
+  BOOST_FOREACH(const DataPointRecord& dataPointRecord,analysisRecord.dataPointRecords()) {
+    ids.push_back(dataPointRecord.id());
+  }
+  std::sort(ids.begin(),ids.end());
+  ASSERT_EQ(5u,ids.size());
+
+  std::vector<std::pair<std::string,QVariant> > flat = DataPointResultsTable::flatten(testResults(1.0,2.0,true));
+  ASSERT_EQ(4u,flat.size());
+  EXPECT_EQ("EnergyPlus.NetSiteEnergy",flat[0].first);
+  EXPECT_DOUBLE_EQ(1.0,flat[0].second.toDouble());
+  EXPECT_EQ("Converged",flat[2].first);
+  EXPECT_EQ(1,flat[2].second.toInt());
+
+  // (energy, cost): front is {ids[0], ids[1], ids[3]}, ids[2] is dominated by ids[1],
+  // ids[4] has no results
+  DataPointResultsTable table(analysisRecord);
+  EXPECT_TRUE(table.setResults(ids[0],testResults(100.0,30.0,true)));
+  EXPECT_TRUE(table.setResults(ids[1],testResults(80.0,40.0,true)));
+  EXPECT_TRUE(table.setResults(ids[2],testResults(90.0,45.0,false)));
+  EXPECT_TRUE(table.setResults(ids[3],testResults(60.0,70.0,true)));
+
+  std::vector<std::string> columns = table.columnNames();
+  ASSERT_EQ(4u,columns.size());
+  EXPECT_EQ("EnergyPlus.NetSiteEnergy",columns[0]);
+  EXPECT_EQ("Weather \"File\"",columns[3]);
+
+  std::vector<int> resultIds = table.dataPointRecordIds();
+  ASSERT_EQ(4u,resultIds.size());
+  EXPECT_EQ(ids[3],resultIds[3]);
+
+  std::vector<OptionalDouble> energy = table.doubleValues("EnergyPlus.NetSiteEnergy");
+  ASSERT_EQ(4u,energy.size());
+  ASSERT_TRUE(energy[2]);
+  EXPECT_DOUBLE_EQ(90.0,*energy[2]);
+  std::vector<QVariant> weather = table.values("Weather \"File\"");
+  ASSERT_EQ(4u,weather.size());
+  EXPECT_EQ("Golden.epw",toString(weather[0].toString()));
+
+  std::vector<int> filtered = table.filter("EnergyPlus.Cost",DataPointResultComparison::LessThan,QVariant(45.0));
+  ASSERT_EQ(2u,filtered.size());
+  EXPECT_EQ(ids[0],filtered[0]);
+  EXPECT_EQ(ids[1],filtered[1]);
+  filtered = table.filter("Converged",DataPointResultComparison::Equal,QVariant(0));
+  ASSERT_EQ(1u,filtered.size());
+  EXPECT_EQ(ids[2],filtered[0]);
+
+  std::vector<int> sorted = table.sort("EnergyPlus.NetSiteEnergy");
+  ASSERT_EQ(4u,sorted.size());
+  EXPECT_EQ(ids[3],sorted[0]);
+  EXPECT_EQ(ids[1],sorted[1]);
+  EXPECT_EQ(ids[2],sorted[2]);
+  EXPECT_EQ(ids[0],sorted[3]);
+  sorted = table.sort("EnergyPlus.NetSiteEnergy",false);
+  EXPECT_EQ(ids[0],sorted[0]);
+
+  OptionalDouble value = table.aggregate("EnergyPlus.NetSiteEnergy",DataPointResultAggregate::Mean);
+  ASSERT_TRUE(value);
+  EXPECT_DOUBLE_EQ(82.5,*value);
+  value = table.aggregate("EnergyPlus.Cost",DataPointResultAggregate::Maximum);
+  ASSERT_TRUE(value);
+  EXPECT_DOUBLE_EQ(70.0,*value);
+  value = table.aggregate("EnergyPlus.Cost",DataPointResultAggregate::Count);
+  ASSERT_TRUE(value);
+  EXPECT_DOUBLE_EQ(4.0,*value);
+  EXPECT_FALSE(table.aggregate("Missing",DataPointResultAggregate::Sum));
+
+  std::vector<std::string> objectives;
+  objectives.push_back("EnergyPlus.NetSiteEnergy");
+  objectives.push_back("EnergyPlus.Cost");
+  std::vector<int> front = table.paretoFront(objectives);
+  ASSERT_EQ(3u,front.size());
+  EXPECT_EQ(ids[0],front[0]);
+  EXPECT_EQ(ids[1],front[1]);
+  EXPECT_EQ(ids[3],front[2]);
+
+  // maximizing cost, only the most expensive point is non-dominated
+  std::vector<bool> maximize(2u,false);
+  maximize[1] = true;
+  front = table.paretoFront(objectives,maximize);
+  ASSERT_EQ(1u,front.size());
+  EXPECT_EQ(ids[3],front[0]);
+
+  // replacing results replaces the whole row
+  std::vector<std::pair<std::string,QVariant> > partial;
+  partial.push_back(std::make_pair(std::string("EnergyPlus.Cost"),QVariant(10.0)));
+  EXPECT_TRUE(table.setResults(ids[2],partial));
+  energy = table.doubleValues("EnergyPlus.NetSiteEnergy");
+  ASSERT_EQ(4u,energy.size());
+  EXPECT_FALSE(energy[2]);
+
+  EXPECT_TRUE(table.removeResults(ids[2]));
+  EXPECT_EQ(3u,table.dataPointRecordIds().size());
+
+  // a second table on the same database sees the same data
+  DataPointResultsTable databaseTable(database);
+  EXPECT_EQ(3u,databaseTable.dataPointRecordIds().size());
+  EXPECT_EQ(4u,databaseTable.columnNames().size());
+
+  // column names are case insensitive, like SQLite's
+  partial.clear();
+  partial.push_back(std::make_pair(std::string("energyplus.cost"),QVariant(20.0)));
+  partial.push_back(std::make_pair(std::string("ENERGYPLUS.COST"),QVariant(25.0)));
+  EXPECT_TRUE(databaseTable.setResults(ids[2],partial));
+  EXPECT_EQ(4u,databaseTable.columnNames().size());
+  EXPECT_EQ(4u,table.columnNames().size());
+  std::vector<OptionalDouble> cost = table.doubleValues("EnergyPlus.COST");
+  ASSERT_EQ(4u,cost.size());
+  ASSERT_TRUE(cost[2]);
+  EXPECT_DOUBLE_EQ(25.0,*cost[2]);
+}
+
+TEST_F(ProjectFixture,DataPointResultsTable_ManyAttributes) {
+  Analysis analysis("My Analysis",
+                    Problem("My Problem",VariableVector(),runmanager::Workflow()),
+                    FileReferenceType::OSM);
+  Problem problem = analysis.problem();
+
+  DiscretePerturbationVector perturbations;
+  perturbations.push_back(NullPerturbation());
+  problem.push(DiscreteVariable("Variable",perturbations));
+
+  std::vector<QVariant> values(1u,0);
+  OptionalDataPoint dataPoint = problem.createDataPoint(values);
+  ASSERT_TRUE(dataPoint);
+  EXPECT_TRUE(analysis.addDataPoint(*dataPoint));
+
+  ProjectDatabase database = getCleanDatabase("DataPointResultsTable_ManyAttributes");
+  database.startTransaction();
+  AnalysisRecord analysisRecord(analysis,database);
+  database.save();
+  database.commitTransaction();
+
+  DataPointRecordVector dataPointRecords = analysisRecord.dataPointRecords();
+  ASSERT_EQ(1u,dataPointRecords.size());
+  int id = dataPointRecords[0].id();
+
+  // more values than SQLite will bind in one statement
+  AttributeVector results;
+  for (int i = 0; i < 1200; ++i) {
+    std::stringstream ss;
+    ss << "Result" << i;
+    results.push_back(Attribute(ss.str(),static_cast<double>(i)));
+  }
+
+  DataPointResultsTable table(analysisRecord);
+  EXPECT_TRUE(table.setResults(id,results));
+  EXPECT_EQ(1200u,table.columnNames().size());
+  ASSERT_EQ(1u,table.dataPointRecordIds().size());
+
+  std::vector<OptionalDouble> first = table.doubleValues("Result0");
+  ASSERT_EQ(1u,first.size());
+  ASSERT_TRUE(first[0]);
+  EXPECT_DOUBLE_EQ(0.0,*first[0]);
+  std::vector<OptionalDouble> middle = table.doubleValues("Result600");
+  ASSERT_EQ(1u,middle.size());
+  ASSERT_TRUE(middle[0]);
+  EXPECT_DOUBLE_EQ(600.0,*middle[0]);
+  std::vector<OptionalDouble> last = table.doubleValues("Result1199");
+  ASSERT_EQ(1u,last.size());
+  ASSERT_TRUE(last[0]);
+  EXPECT_DOUBLE_EQ(1199.0,*last[0]);
+
+  // replacing the results still clears the columns that are not set again
+  std::vector<std::pair<std::string,QVariant> > partial;
+  partial.push_back(std::make_pair(std::string("Result1"),QVariant(10.0)));
+  EXPECT_TRUE(table.setResults(id,partial));
+  last = table.doubleValues("Result1199");
+  ASSERT_EQ(1u,last.size());
+  EXPECT_FALSE(last[0]);
+  ASSERT_EQ(1u,table.dataPointRecordIds().size());
+}
@@ -0,0 +1,214 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <radiance/AnnualDaylightMetrics.hpp>
+#include <radiance/AnnualIlluminanceMap.hpp>
+#include <radiance/BinaryAnnualIlluminanceMap.hpp>
+
+#include <boost/bind.hpp>
+
+namespace openstudio{
+namespace radiance{
+
+  namespace {
+
+    // creates the metrics once the map size is known and feeds it the accepted time steps
+    struct MetricsAccumulator
+    {
+      MetricsAccumulator(const boost::function<bool (const DateTime&)>& filter,
+                         double daThreshold, double udiLower, double udiUpper)
+        : filter(filter), daThreshold(daThreshold), udiLower(udiLower), udiUpper(udiUpper)
+      {}
+
+      void operator()(const Vector& xVector, const Vector& yVector, const DateTime& dateTime, const double* values)
+      {
+        if (!metrics){
+          metrics = AnnualDaylightMetrics(xVector.size()*yVector.size(), daThreshold, udiLower, udiUpper);
+        }
+        if (filter.empty() || filter(dateTime)){
+          metrics->add(values);
+        }
+      }
+
+      boost::function<bool (const DateTime&)> filter;
+      double daThreshold;
+      double udiLower;
+      double udiUpper;
+      boost::optional<AnnualDaylightMetrics> metrics;
+    };
+
+  }
+
+  AnnualDaylightMetrics::AnnualDaylightMetrics(unsigned numPoints, 
+                                               double daThreshold, 
+                                               double udiLower, 
+                                               double udiUpper)
+    : m_numTimeSteps(0), m_daThreshold(daThreshold), m_udiLower(udiLower), m_udiUpper(udiUpper),
+      m_daCounts(numPoints, 0), m_fellShortCounts(numPoints, 0), m_exceededCounts(numPoints, 0), 
+      m_sums(numPoints, 0.0)
+  {}
+
+  boost::optional<AnnualDaylightMetrics> AnnualDaylightMetrics::compute(const openstudio::path& path,
+                                                                        const boost::function<bool (const openstudio::DateTime&)>& filter,
+                                                                        double daThreshold, 
+                                                                        double udiLower, 
+                                                                        double udiUpper)
+  {
+    // binary slices are added as float, without the conversion forEachTimeStep makes
+    if (BinaryAnnualIlluminanceMap::isBinary(path)){
+      BinaryAnnualIlluminanceMap binaryMap(path);
+      if (!binaryMap.isValid()){
+        return boost::none;
+      }
+      AnnualDaylightMetrics result(binaryMap.numPoints(), daThreshold, udiLower, udiUpper);
+      for (unsigned t = 0, n = binaryMap.numTimeSteps(); t < n; ++t){
+        if (filter.empty() || filter(binaryMap.dateTime(t))){
+          result.add(binaryMap.illuminance(t));
+        }
+      }
+      return result;
+    }
+
+    Vector xVector;
+    Vector yVector;
+    MetricsAccumulator accumulator(filter, daThreshold, udiLower, udiUpper);
+
+    bool ok = AnnualIlluminanceMap::forEachTimeStep(path, 
+                                                    boost::bind<void>(boost::ref(accumulator), 
+                                                                      boost::cref(xVector), boost::cref(yVector), _1, _2),
+                                                    xVector, yVector);
+    if (!ok){
+      return boost::none;
+    }
+
+    if (!accumulator.metrics){
+      // file has no time steps
+      return AnnualDaylightMetrics(xVector.size()*yVector.size(), daThreshold, udiLower, udiUpper);
+    }
+
+    return accumulator.metrics;
+  }
+
+  template<typename T>
+  void AnnualDaylightMetrics::addValues(const T* illuminance)
+  {
+    unsigned n = m_sums.size();
+    for (unsigned i = 0; i < n; ++i){
+      double value = illuminance[i];
+      m_sums[i] += value;
+      if (value >= m_daThreshold){
+        ++m_daCounts[i];
+      }
+      if (value < m_udiLower){
+        ++m_fellShortCounts[i];
+      }else if (value > m_udiUpper){
+        ++m_exceededCounts[i];
+      }
+    }
+    ++m_numTimeSteps;
+  }
+
+  void AnnualDaylightMetrics::add(const float* illuminance)
+  {
+    addValues(illuminance);
+  }
+
+  void AnnualDaylightMetrics::add(const double* illuminance)
+  {
+    addValues(illuminance);
+  }
+
+  unsigned AnnualDaylightMetrics::numPoints() const
+  {
+    return m_sums.size();
+  }
+
+  unsigned AnnualDaylightMetrics::numTimeSteps() const
+  {
+    return m_numTimeSteps;
+  }
+
+  double AnnualDaylightMetrics::daThreshold() const
+  {
+    return m_daThreshold;
+  }
+
+  double AnnualDaylightMetrics::udiLower() const
+  {
+    return m_udiLower;
+  }
+
+  double AnnualDaylightMetrics::udiUpper() const
+  {
+    return m_udiUpper;
+  }
+
+  openstudio::Vector AnnualDaylightMetrics::daylightAutonomy() const
+  {
+    return fraction(m_daCounts);
+  }
+
+  openstudio::Vector AnnualDaylightMetrics::udiFellShort() const
+  {
+    return fraction(m_fellShortCounts);
+  }
+
+  openstudio::Vector AnnualDaylightMetrics::udiUseful() const
+  {
+    unsigned n = m_sums.size();
+    Vector result(n, 0.0);
+    if (m_numTimeSteps > 0){
+      for (unsigned i = 0; i < n; ++i){
+        result[i] = static_cast<double>(m_numTimeSteps - m_fellShortCounts[i] - m_exceededCounts[i]) / m_numTimeSteps;
+      }
+    }
+    return result;
+  }
+
+  openstudio::Vector AnnualDaylightMetrics::udiExceeded() const
+  {
+    return fraction(m_exceededCounts);
+  }
+
+  openstudio::Vector AnnualDaylightMetrics::meanIlluminance() const
+  {
+    unsigned n = m_sums.size();
+    Vector result(n, 0.0);
+    if (m_numTimeSteps > 0){
+      for (unsigned i = 0; i < n; ++i){
+        result[i] = m_sums[i] / m_numTimeSteps;
+      }
+    }
+    return result;
+  }
+
+  openstudio::Vector AnnualDaylightMetrics::fraction(const std::vector<unsigned>& counts) const
+  {
+    unsigned n = counts.size();
+    Vector result(n, 0.0);
+    if (m_numTimeSteps > 0){
+      for (unsigned i = 0; i < n; ++i){
+        result[i] = static_cast<double>(counts[i]) / m_numTimeSteps;
+      }
+    }
+    return result;
+  }
+
+} // radiance
+} // openstudio
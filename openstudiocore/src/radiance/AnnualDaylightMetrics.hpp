@@ -0,0 +1,119 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef RADIANCE_ANNUALDAYLIGHTMETRICS_HPP
+#define RADIANCE_ANNUALDAYLIGHTMETRICS_HPP
+
+#include "RadianceAPI.hpp"
+
+#include <utilities/data/Vector.hpp>
+#include <utilities/time/DateTime.hpp>
+#include <utilities/core/Logger.hpp>
+#include <utilities/core/Path.hpp>
+
+#include <boost/optional.hpp>
+#include <boost/function.hpp>
+
+#include <vector>
+
+namespace openstudio{
+namespace radiance{
+
+  /** AnnualDaylightMetrics accumulates daylight autonomy and useful daylight illuminance (UDI) 
+   *  for each point of an illuminance map one time step at a time, so a full year of results 
+   *  never has to be held in memory. All results are fractions of the time steps added, except
+   *  meanIlluminance which is in lux. */
+  class RADIANCE_API AnnualDaylightMetrics
+  {
+    public:
+
+      /** Accumulate metrics for numPoints points. Daylight autonomy counts time steps at or above 
+       *  daThreshold lux; UDI splits time steps into below udiLower, between udiLower and 
+       *  udiUpper inclusive, and above udiUpper. */
+      AnnualDaylightMetrics(unsigned numPoints, 
+                            double daThreshold = 300.0, 
+                            double udiLower = 100.0, 
+                            double udiUpper = 2000.0);
+
+      /// virtual destructor
+      virtual ~AnnualDaylightMetrics() {}
+
+      /** Stream the annual illuminance map at path, text or binary, and compute metrics over the 
+       *  time steps accepted by filter, or all time steps if filter is empty. Returns an empty 
+       *  optional if the file cannot be read. */
+      static boost::optional<AnnualDaylightMetrics> compute(const openstudio::path& path,
+                                                            const boost::function<bool (const openstudio::DateTime&)>& filter = boost::function<bool (const openstudio::DateTime&)>(),
+                                                            double daThreshold = 300.0, 
+                                                            double udiLower = 100.0, 
+                                                            double udiUpper = 2000.0);
+
+      /// add one time step of numPoints illuminance values in lux, e.g. a BinaryAnnualIlluminanceMap slice
+      void add(const float* illuminance);
+
+      /// add one time step of numPoints illuminance values in lux
+      void add(const double* illuminance);
+
+      unsigned numPoints() const;
+
+      unsigned numTimeSteps() const;
+
+      double daThreshold() const;
+
+      double udiLower() const;
+
+      double udiUpper() const;
+
+      /// fraction of time steps at or above daThreshold, per point
+      openstudio::Vector daylightAutonomy() const;
+
+      /// fraction of time steps below udiLower, per point
+      openstudio::Vector udiFellShort() const;
+
+      /// fraction of time steps between udiLower and udiUpper, per point
+      openstudio::Vector udiUseful() const;
+
+      /// fraction of time steps above udiUpper, per point
+      openstudio::Vector udiExceeded() const;
+
+      /// mean illuminance in lux, per point
+      openstudio::Vector meanIlluminance() const;
+
+    private:
+
+      REGISTER_LOGGER("radiance.AnnualDaylightMetrics");
+
+      openstudio::Vector fraction(const std::vector<unsigned>& counts) const;
+
+      template<typename T>
+      void addValues(const T* illuminance);
+
+      unsigned m_numTimeSteps;
+      double m_daThreshold;
+      double m_udiLower;
+      double m_udiUpper;
+      std::vector<unsigned> m_daCounts;
+      std::vector<unsigned> m_fellShortCounts;
+      std::vector<unsigned> m_exceededCounts;
+      std::vector<double> m_sums;
+  };
+
+} // radiance
+} // openstudio
+
+#endif //RADIANCE_ANNUALDAYLIGHTMETRICS_HPP
@@ -19,16 +19,20 @@
 
 #include <radiance/AnnualIlluminanceMap.hpp>
 #include <radiance/HeaderInfo.hpp>
+#include <radiance/BinaryAnnualIlluminanceMap.hpp>
 
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <cstdlib>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/regex.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <boost/algorithm/string.hpp>
-#include <boost/tokenizer.hpp>
+#include <boost/foreach.hpp>
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
 
 using namespace std;
 using namespace boost;
@@ -47,6 +51,47 @@ namespace radiance{
     init(path);
   }
 
+  namespace {
+
+    // pass text values on as read
+    void forwardTextTimeStep(const AnnualIlluminanceMap::TimeStepCallback& callback,
+                             const DateTime& dateTime,
+                             const std::vector<double>& values)
+    {
+      callback(dateTime, values.empty() ? 0 : &values[0]);
+    }
+
+    // convert one binary time step from float for a TimeStepCallback, buffer is reused between time steps
+    const double* binaryTimeStep(const BinaryAnnualIlluminanceMap& binaryMap, unsigned t, std::vector<double>& buffer)
+    {
+      const float* values = binaryMap.illuminance(t);
+      buffer.assign(values, values + binaryMap.numPoints());
+      return buffer.empty() ? 0 : &buffer[0];
+    }
+
+    // parse numbers separated by spaces or tabs, returns false on any other content
+    bool parseNumbers(const std::string& line, std::vector<double>& values)
+    {
+      values.clear();
+      const char* p = line.c_str();
+      while (*p != '\0'){
+        if ((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == '\n')){
+          ++p;
+          continue;
+        }
+        char* end = 0;
+        double value = std::strtod(p, &end);
+        if (end == p){
+          return false;
+        }
+        values.push_back(value);
+        p = end;
+      }
+      return true;
+    }
+
+  }
+
   void AnnualIlluminanceMap::init(const openstudio::path& path)
   {
     // file must exist
@@ -55,8 +100,55 @@ namespace radiance{
       return;
     }
 
+    if (BinaryAnnualIlluminanceMap::isBinary(path)){
+      BinaryAnnualIlluminanceMap binaryMap(path);
+      if (!binaryMap.isValid()){
+        LOG(Fatal, "Unable to read binary illuminance map '" << toString(path) << "'");
+        return;
+      }
+      m_xVector = binaryMap.xVector();
+      m_yVector = binaryMap.yVector();
+      for (unsigned t = 0, n = binaryMap.numTimeSteps(); t < n; ++t){
+        addTimeStep(binaryMap.dateTime(t), binaryMap.illuminance(t));
+      }
+      return;
+    }
+
+    TimeStepCallback callback = boost::bind(&AnnualIlluminanceMap::addTimeStep<double>, this, _1, _2);
+    readText(path, boost::bind(forwardTextTimeStep, boost::cref(callback), _1, _2), 
+             m_xVector, m_yVector);
+  }
+
+  template<typename T>
+  void AnnualIlluminanceMap::addTimeStep(const openstudio::DateTime& dateTime, const T* values)
+  {
+    unsigned M = m_xVector.size();
+    unsigned N = m_yVector.size();
+
+    // matrix we are going to read in
+    Matrix illuminanceMap(M,N);
+    for (unsigned j = 0; j < N; ++j){
+      for (unsigned i = 0; i < M; ++i){
+        illuminanceMap(i,j) = *values;
+        ++values;
+      }
+    }
+
+    m_dateTimes.push_back(dateTime);
+    m_dateTimeIlluminanceMap[dateTime] = illuminanceMap;
+  }
+
+  bool AnnualIlluminanceMap::readText(const openstudio::path& path,
+                                      const TextCallback& callback,
+                                      openstudio::Vector& xVector,
+                                      openstudio::Vector& yVector)
+  {
     // open file
     boost::filesystem::ifstream file(path);
+    if (!file){
+      LOG(Error, "Unable to open '" << toString(path) << "'");
+      return false;
+    }
 
     // keep track of line number
     unsigned lineNum = 0;
@@ -71,15 +163,13 @@ namespace radiance{
     // lines 1 and 2 are the header lines
     string line1, line2;
 
-    // this will contain matches to regular expressions
-    smatch matches;
-
-    // matches a single number followed by either tabs or spaces
-    const regex singleNumber("([-+]?[0-9]*\\.?[0-9]+)[\\s\\t]*");
-
     // conversion from footcandles to lux
     const double footcandlesToLux(10.76);
 
+    // reused for every line
+    std::vector<double> lineValues;
+    std::vector<double> values;
+
     // read the rest of the file line by line
     while(getline(file, line)){
       ++lineNum;
@@ -89,7 +179,6 @@ namespace radiance{
         // save line 1
         line1 = line;
 
-
       }else if (lineNum == 2){
 
         // save line 2
@@ -99,63 +188,79 @@ namespace radiance{
         HeaderInfo headerInfo(line1, line2);
 
         // we can now initialize x and y vectors
-        m_xVector = headerInfo.xVector();
-        m_yVector = headerInfo.yVector();
+        xVector = headerInfo.xVector();
+        yVector = headerInfo.yVector();
 
-        M = m_xVector.size();
-        N = m_yVector.size();
+        M = xVector.size();
+        N = yVector.size();
 
       }else{
 
         // each line contains the month, day, time (in hours),
         // Solar Azimuth(degrees from south), Solar Altitude(degrees), Global Horizontal Illuminance (fc)
         // followed by M*N illuminance points
-
-        // break the line up by spaces
-        vector<string> lineVector;
-        tokenizer<char_separator<char>, std::string::const_iterator, std::string > tk(line, char_separator<char>(" "));
-        for (tokenizer<char_separator<char>, std::string::const_iterator, std::string >::iterator it(tk.begin()); it!=tk.end(); ++it)
-        {
-           lineVector.push_back(*it);
+        if (!parseNumbers(line, lineValues) || (lineValues.size() < 6)){
+          LOG(Fatal, "Unable to parse line " << lineNum << " of '" << toString(path) << "'.");
+          return false;
         }
 
         // total number minus 6 standard header items
-        unsigned numValues = lineVector.size() - 6;
+        unsigned numValues = lineValues.size() - 6;
 
         if (numValues != M*N){
           LOG(Fatal,  "Incorrect number of illuminance values read " << numValues << ", expecting " << M*N << ".");
-          return;
-        }else{
-
-          MonthOfYear month = monthOfYear(lexical_cast<unsigned>(lineVector[0]));
-          unsigned day = lexical_cast<unsigned>(lineVector[1]);
-          double fracDays = lexical_cast<double>(lineVector[2]) / 24.0;
-
-          // ignore solar angles and global horizontal for now
+          return false;
+        }
 
-          // make the date time
-          DateTime dateTime(Date(month, day), Time(fracDays));
+        MonthOfYear month = monthOfYear(static_cast<unsigned>(lineValues[0]));
+        unsigned day = static_cast<unsigned>(lineValues[1]);
+        double fracDays = lineValues[2] / 24.0;
 
-          // matrix we are going to read in
-          Matrix illuminanceMap(M,N);
+        // ignore solar angles and global horizontal for now
 
-          // read in the values
-          unsigned index = 6;
-          for (unsigned j = 0; j < N; ++j){
-            for (unsigned i = 0; i < M; ++i){
-              illuminanceMap(i,j) = footcandlesToLux*lexical_cast<double>(lineVector[index]);
-              ++index;
-            }
-          }
+        // make the date time
+        DateTime dateTime(Date(month, day), Time(fracDays));
 
-          m_dateTimes.push_back(dateTime);
-          m_dateTimeIlluminanceMap[dateTime] = illuminanceMap;
+        values.resize(numValues);
+        for (unsigned index = 0; index < numValues; ++index){
+          values[index] = footcandlesToLux*lineValues[index + 6];
         }
+
+        callback(dateTime, values);
       }
     }
 
     // close file
     file.close();
+    return true;
+  }
+
+  bool AnnualIlluminanceMap::forEachTimeStep(const openstudio::path& path,
+                                             const TimeStepCallback& callback,
+                                             openstudio::Vector& xVector,
+                                             openstudio::Vector& yVector)
+  {
+    if (!exists(path)){
+      LOG(Error, "File does not exist: '" << toString(path) << "'");
+      return false;
+    }
+
+    if (BinaryAnnualIlluminanceMap::isBinary(path)){
+      BinaryAnnualIlluminanceMap binaryMap(path);
+      if (!binaryMap.isValid()){
+        return false;
+      }
+      xVector = binaryMap.xVector();
+      yVector = binaryMap.yVector();
+      std::vector<double> buffer;
+      for (unsigned t = 0, n = binaryMap.numTimeSteps(); t < n; ++t){
+        callback(binaryMap.dateTime(t), binaryTimeStep(binaryMap, t, buffer));
+      }
+      return true;
+    }
+
+    return readText(path, boost::bind(forwardTextTimeStep, boost::cref(callback), _1, _2),
+                    xVector, yVector);
   }
 
   /// get the illuminance map in lux corresponding to date and time
@@ -169,6 +274,72 @@ namespace radiance{
     return m_nullIlluminanceMap;
   }
 
+  bool AnnualIlluminanceMap::saveBinary(const openstudio::path& path,
+                                        const openstudio::Vector& xVector,
+                                        const openstudio::Vector& yVector,
+                                        const openstudio::DateTimeVector& dateTimes,
+                                        const std::vector<float>& illuminance)
+  {
+    boost::uint32_t M = xVector.size();
+    boost::uint32_t N = yVector.size();
+    boost::uint32_t T = dateTimes.size();
+    if (illuminance.size() != static_cast<size_t>(M)*N*T){
+      LOG(Error, "Expected " << static_cast<size_t>(M)*N*T << " illuminance values, but received " 
+          << illuminance.size() << ".");
+      return false;
+    }
+
+    boost::filesystem::ofstream file(path, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!file){
+      LOG(Error, "Unable to open '" << toString(path) << "' for writing.");
+      return false;
+    }
+
+    // header
+    file.write(binaryMagic(), 8);
+    boost::uint32_t reserved = 0;
+    file.write(reinterpret_cast<const char*>(&M), sizeof(M));
+    file.write(reinterpret_cast<const char*>(&N), sizeof(N));
+    file.write(reinterpret_cast<const char*>(&T), sizeof(T));
+    file.write(reinterpret_cast<const char*>(&reserved), sizeof(reserved));
+
+    // axes
+    for (unsigned i = 0; i < M; ++i){
+      double x = xVector[i];
+      file.write(reinterpret_cast<const char*>(&x), sizeof(x));
+    }
+    for (unsigned j = 0; j < N; ++j){
+      double y = yVector[j];
+      file.write(reinterpret_cast<const char*>(&y), sizeof(y));
+    }
+
+    // date times
+    BOOST_FOREACH(const DateTime& dateTime, dateTimes){
+      boost::int32_t month = dateTime.date().monthOfYear().value();
+      boost::int32_t day = dateTime.date().dayOfMonth();
+      double hours = dateTime.time().totalHours();
+      file.write(reinterpret_cast<const char*>(&month), sizeof(month));
+      file.write(reinterpret_cast<const char*>(&day), sizeof(day));
+      file.write(reinterpret_cast<const char*>(&hours), sizeof(hours));
+    }
+
+    // values
+    if (!illuminance.empty()){
+      file.write(reinterpret_cast<const char*>(&illuminance[0]), illuminance.size()*sizeof(float));
+    }
+
+    bool result = file.good();
+    file.close();
+    if (!result){
+      LOG(Error, "Error writing annual illuminance map to '" << toString(path) << "'.");
+    }
+    return result;
+  }
+
+  const char* AnnualIlluminanceMap::binaryMagic()
+  {
+    return "OSAIMAP1";
+  }
 
 } // radiance
 } // openstudio
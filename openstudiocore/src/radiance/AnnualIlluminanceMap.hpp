@@ -28,12 +28,17 @@
 #include <utilities/core/Logger.hpp>
 #include <utilities/core/Path.hpp>
 
+#include <boost/function.hpp>
+
 namespace openstudio{
 namespace radiance{
 
   /** AnnualIlluminanceMap represents illuminance map for an entire year.
   *   We assume that the output files is from SPOT, with length in meters and illuminance 
-  *   values in footcandles.  All illuminance values are converted to lux.
+  *   values in footcandles.  All illuminance values are converted to lux. Files in the binary
+  *   format written by saveBinary (illuminance already in lux) are also accepted. For large maps
+  *   prefer BinaryAnnualIlluminanceMap or forEachTimeStep, which do not create a Matrix per 
+  *   time step.
   */ 
   class RADIANCE_API AnnualIlluminanceMap
   {
@@ -44,6 +49,10 @@ namespace radiance{
 
     public:
 
+      /// callback receiving the illuminance values in lux for one date and time, ordered with the
+      /// x index varying fastest
+      typedef boost::function<void (const openstudio::DateTime&, const double*)> TimeStepCallback;
+
       /// default constructor
       AnnualIlluminanceMap();
 
@@ -66,12 +75,60 @@ namespace radiance{
       /// get the illuminance map in lux corresponding to date and time
       const openstudio::Matrix& illuminanceMap(const openstudio::DateTime& dateTime) const;
 
+      /** Stream a text or binary annual illuminance map, calling callback once per date and time
+       *  without storing the whole map. xVector and yVector are set from the file header before the
+       *  first call. Returns false if the file cannot be read. */
+      static bool forEachTimeStep(const openstudio::path& path,
+                                  const TimeStepCallback& callback,
+                                  openstudio::Vector& xVector,
+                                  openstudio::Vector& yVector);
+
+      /** Save an annual illuminance map in the native binary format. illuminance holds one 
+       *  block of xVector.size()*yVector.size() values (lux) per date and time, ordered with the 
+       *  x index varying fastest, the same ordering as the text format. 
+       *
+       *  The binary format is, in native byte order:
+       *  \code
+       *  char[8]  magic, "OSAIMAP1"
+       *  uint32   M, number of x points
+       *  uint32   N, number of y points
+       *  uint32   T, number of date times
+       *  uint32   reserved, 0
+       *  double   x[M], in meters
+       *  double   y[N], in meters
+       *  T records of { int32 month, int32 day, double hours }
+       *  float    illuminance[T][N][M], in lux
+       *  \endcode */
+      static bool saveBinary(const openstudio::path& path,
+                             const openstudio::Vector& xVector,
+                             const openstudio::Vector& yVector,
+                             const openstudio::DateTimeVector& dateTimes,
+                             const std::vector<float>& illuminance);
+
     private:
 
       REGISTER_LOGGER("radiance.AnnualIlluminanceMap");
 
       void init(const openstudio::path& path);
 
+      // values are double when read from text and float when read from a binary map
+      template<typename T>
+      void addTimeStep(const openstudio::DateTime& dateTime, const T* values);
+
+      // callback receiving values in lux as parsed from a text file
+      typedef boost::function<void (const openstudio::DateTime&, const std::vector<double>&)> TextCallback;
+
+      // read a text file line by line, calling callback once per date and time
+      static bool readText(const openstudio::path& path, 
+                           const TextCallback& callback,
+                           openstudio::Vector& xVector,
+                           openstudio::Vector& yVector);
+
+      friend class BinaryAnnualIlluminanceMap;
+
+      // first eight bytes of the binary format
+      static const char* binaryMagic();
+
       openstudio::DateTimeVector m_dateTimes;
       openstudio::Vector m_xVector;
       openstudio::Vector m_yVector;
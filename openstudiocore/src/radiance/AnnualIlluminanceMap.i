@@ -21,6 +21,7 @@
 %template(AnnualIlluminanceMapVector) std::vector< boost::shared_ptr<openstudio::radiance::AnnualIlluminanceMap> >;
 
 %ignore openstudio::radiance::AnnualIlluminanceMap::AnnualIlluminanceMap(const openstudio::Path&);
+%ignore openstudio::radiance::AnnualIlluminanceMap::forEachTimeStep;
 
 %include <radiance/AnnualIlluminanceMap.hpp>
 
@@ -0,0 +1,189 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <radiance/BinaryAnnualIlluminanceMap.hpp>
+#include <radiance/AnnualIlluminanceMap.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+
+#include <QFile>
+
+#include <cstring>
+
+namespace openstudio{
+namespace radiance{
+
+  namespace {
+
+    // sizes of the fixed parts of the format, see AnnualIlluminanceMap::saveBinary
+    const size_t headerSize = 24;
+    const size_t dateTimeSize = 16;
+
+  }
+
+  BinaryAnnualIlluminanceMap::BinaryAnnualIlluminanceMap(const openstudio::path& path)
+    : m_data(0), m_M(0), m_N(0), m_T(0)
+  {
+    if (!isBinary(path)){
+      LOG(Error, "'" << toString(path) << "' is not a binary annual illuminance map.");
+      return;
+    }
+
+    boost::shared_ptr<QFile> file(new QFile(toQString(path)));
+    if (!file->open(QIODevice::ReadOnly)){
+      LOG(Error, "Unable to open '" << toString(path) << "'.");
+      return;
+    }
+
+    qint64 size = file->size();
+    if (size < static_cast<qint64>(headerSize)){
+      LOG(Error, "'" << toString(path) << "' is truncated.");
+      return;
+    }
+
+    const unsigned char* data = file->map(0, size);
+    if (!data){
+      LOG(Error, "Unable to map '" << toString(path) << "'.");
+      return;
+    }
+
+    boost::uint32_t M, N, T;
+    std::memcpy(&M, data + 8, sizeof(M));
+    std::memcpy(&N, data + 12, sizeof(N));
+    std::memcpy(&T, data + 16, sizeof(T));
+
+    qint64 expected = static_cast<qint64>(headerSize) 
+                    + static_cast<qint64>(sizeof(double))*(static_cast<qint64>(M) + N)
+                    + static_cast<qint64>(dateTimeSize)*T
+                    + static_cast<qint64>(sizeof(float))*M*N*T;
+    if (size != expected){
+      LOG(Error, "'" << toString(path) << "' has size " << size << ", expecting " << expected << ".");
+      return;
+    }
+
+    m_file = file;
+    m_data = data;
+    m_M = M;
+    m_N = N;
+    m_T = T;
+  }
+
+  bool BinaryAnnualIlluminanceMap::isBinary(const openstudio::path& path)
+  {
+    boost::filesystem::ifstream file(path, std::ios_base::in | std::ios_base::binary);
+    if (!file){
+      return false;
+    }
+    char magic[8];
+    file.read(magic, 8);
+    if (file.gcount() != 8){
+      return false;
+    }
+    return (std::memcmp(magic, AnnualIlluminanceMap::binaryMagic(), 8) == 0);
+  }
+
+  bool BinaryAnnualIlluminanceMap::isValid() const
+  {
+    return (m_data != 0);
+  }
+
+  openstudio::Vector BinaryAnnualIlluminanceMap::xVector() const
+  {
+    openstudio::Vector result(m_M);
+    const double* x = reinterpret_cast<const double*>(m_data + headerSize);
+    for (unsigned i = 0; i < m_M; ++i){
+      result[i] = x[i];
+    }
+    return result;
+  }
+
+  openstudio::Vector BinaryAnnualIlluminanceMap::yVector() const
+  {
+    openstudio::Vector result(m_N);
+    const double* y = reinterpret_cast<const double*>(m_data + headerSize) + m_M;
+    for (unsigned j = 0; j < m_N; ++j){
+      result[j] = y[j];
+    }
+    return result;
+  }
+
+  unsigned BinaryAnnualIlluminanceMap::numTimeSteps() const
+  {
+    return m_T;
+  }
+
+  unsigned BinaryAnnualIlluminanceMap::numPoints() const
+  {
+    return m_M*m_N;
+  }
+
+  openstudio::DateTime BinaryAnnualIlluminanceMap::dateTime(unsigned t) const
+  {
+    if (t >= m_T){
+      LOG_AND_THROW("Time step " << t << " is out of range, file has " << m_T << " time steps.");
+    }
+
+    const unsigned char* record = m_data + headerSize + sizeof(double)*(m_M + m_N) + dateTimeSize*t;
+    boost::int32_t month, day;
+    double hours;
+    std::memcpy(&month, record, sizeof(month));
+    std::memcpy(&day, record + 4, sizeof(day));
+    std::memcpy(&hours, record + 8, sizeof(hours));
+
+    return DateTime(Date(monthOfYear(month), day), Time(hours/24.0));
+  }
+
+  openstudio::DateTimeVector BinaryAnnualIlluminanceMap::dateTimes() const
+  {
+    DateTimeVector result;
+    result.reserve(m_T);
+    for (unsigned t = 0; t < m_T; ++t){
+      result.push_back(dateTime(t));
+    }
+    return result;
+  }
+
+  const float* BinaryAnnualIlluminanceMap::illuminance(unsigned t) const
+  {
+    if (t >= m_T){
+      return 0;
+    }
+    const unsigned char* values = m_data + headerSize + sizeof(double)*(m_M + m_N) + dateTimeSize*m_T;
+    return reinterpret_cast<const float*>(values) + static_cast<size_t>(m_M)*m_N*t;
+  }
+
+  openstudio::Matrix BinaryAnnualIlluminanceMap::illuminanceMap(unsigned t) const
+  {
+    const float* values = illuminance(t);
+    if (!values){
+      LOG_AND_THROW("Time step " << t << " is out of range, file has " << m_T << " time steps.");
+    }
+
+    openstudio::Matrix result(m_M, m_N);
+    for (unsigned j = 0; j < m_N; ++j){
+      for (unsigned i = 0; i < m_M; ++i){
+        result(i,j) = *values;
+        ++values;
+      }
+    }
+    return result;
+  }
+
+} // radiance
+} // openstudio
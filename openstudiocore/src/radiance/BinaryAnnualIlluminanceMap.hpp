@@ -0,0 +1,98 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef RADIANCE_BINARYANNUALILLUMINANCEMAP_HPP
+#define RADIANCE_BINARYANNUALILLUMINANCEMAP_HPP
+
+#include "RadianceAPI.hpp"
+
+#include <utilities/data/Matrix.hpp>
+#include <utilities/data/Vector.hpp>
+#include <utilities/time/DateTime.hpp>
+#include <utilities/core/Logger.hpp>
+#include <utilities/core/Path.hpp>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/cstdint.hpp>
+
+class QFile;
+
+namespace openstudio{
+namespace radiance{
+
+  /** BinaryAnnualIlluminanceMap is a read only view of an annual illuminance map written by 
+   *  AnnualIlluminanceMap::saveBinary. The file is memory mapped, so opening it does not read the 
+   *  illuminance values and illuminance(t) returns a pointer into the mapping rather than a copy. 
+   *  Copies share the same mapping, which stays open until the last copy is destroyed. */
+  class RADIANCE_API BinaryAnnualIlluminanceMap
+  {
+    public:
+
+      /// map the file at path, check isValid before use
+      BinaryAnnualIlluminanceMap(const openstudio::path& path);
+
+      /// virtual destructor
+      virtual ~BinaryAnnualIlluminanceMap() {}
+
+      /// true if path starts with the binary annual illuminance map header
+      static bool isBinary(const openstudio::path& path);
+
+      /// true if the file was mapped and its size agrees with the header
+      bool isValid() const;
+
+      /// the x points of the illuminance map in meters
+      openstudio::Vector xVector() const;
+
+      /// the y points of the illuminance map in meters
+      openstudio::Vector yVector() const;
+
+      unsigned numTimeSteps() const;
+
+      /// number of illuminance values per time step, xVector().size()*yVector().size()
+      unsigned numPoints() const;
+
+      /// date and time of time step t
+      openstudio::DateTime dateTime(unsigned t) const;
+
+      /// all dates and times in file order
+      openstudio::DateTimeVector dateTimes() const;
+
+      /** Illuminance in lux at time step t, ordered with the x index varying fastest. The pointer 
+       *  refers directly to the mapped file and is valid for the lifetime of this object. Returns 
+       *  0 if t is out of range. */
+      const float* illuminance(unsigned t) const;
+
+      /// copy time step t into a Matrix indexed (x,y), in lux
+      openstudio::Matrix illuminanceMap(unsigned t) const;
+
+    private:
+
+      REGISTER_LOGGER("radiance.BinaryAnnualIlluminanceMap");
+
+      boost::shared_ptr<QFile> m_file;
+      const unsigned char* m_data;
+      boost::uint32_t m_M;
+      boost::uint32_t m_N;
+      boost::uint32_t m_T;
+  };
+
+} // radiance
+} // openstudio
+
+#endif //RADIANCE_BINARYANNUALILLUMINANCEMAP_HPP
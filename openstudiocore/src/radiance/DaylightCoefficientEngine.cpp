@@ -0,0 +1,310 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <radiance/DaylightCoefficientEngine.hpp>
+#include <radiance/AnnualIlluminanceMap.hpp>
+
+#include <boost/foreach.hpp>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <boost/math/constants/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace openstudio{
+namespace radiance{
+
+  namespace {
+
+    // number of time steps evaluated together, so each row of coefficients is reused while the
+    // corresponding sky vectors are in cache
+    const unsigned timeStepBlockSize = 32;
+
+    // luminous efficacy and photopic weighting of RGB radiance, as in rcalc -e '$1=179*(...)'
+    const double rgbToLux[3] = {179.0*0.265, 179.0*0.67, 179.0*0.065};
+
+    // dot product with independent partial sums, which lets the compiler vectorize the loop
+    inline double dot(const double* a, const double* b, unsigned n)
+    {
+      double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+      unsigned i = 0;
+      for (; i + 4 <= n; i += 4){
+        s0 += a[i]*b[i];
+        s1 += a[i+1]*b[i+1];
+        s2 += a[i+2]*b[i+2];
+        s3 += a[i+3]*b[i+3];
+      }
+      for (; i < n; ++i){
+        s0 += a[i]*b[i];
+      }
+      return (s0 + s1) + (s2 + s3);
+    }
+
+  }
+
+  DaylightCoefficientEngine::DaylightCoefficientEngine(const openstudio::Vector& xVector, const openstudio::Vector& yVector)
+    : m_xVector(xVector), m_yVector(yVector), m_numSkyPatches(0)
+  {}
+
+  unsigned DaylightCoefficientEngine::numSensors() const
+  {
+    return m_xVector.size()*m_yVector.size();
+  }
+
+  unsigned DaylightCoefficientEngine::numSkyPatches() const
+  {
+    return m_numSkyPatches;
+  }
+
+  unsigned DaylightCoefficientEngine::numWindowGroups() const
+  {
+    return m_windowGroups.size();
+  }
+
+  unsigned DaylightCoefficientEngine::numStates(unsigned windowGroup) const
+  {
+    if (windowGroup < m_windowGroups.size()){
+      return m_windowGroups[windowGroup].size();
+    }
+    return 0;
+  }
+
+  bool DaylightCoefficientEngine::addWindowGroup(const RadianceMatrix& viewMatrix,
+                                                 const std::vector<RadianceMatrix>& transmissionMatrices,
+                                                 const RadianceMatrix& daylightMatrix)
+  {
+    unsigned nSensors = numSensors();
+    if (viewMatrix.nRows() != nSensors){
+      LOG(Error, "View matrix has " << viewMatrix.nRows() << " rows, expected one per sensor (" << nSensors << ").");
+      return false;
+    }
+    if (transmissionMatrices.empty()){
+      LOG(Error, "Window group requires at least one transmission matrix.");
+      return false;
+    }
+    if ((m_numSkyPatches > 0) && (daylightMatrix.nCols() != m_numSkyPatches)){
+      LOG(Error, "Daylight matrix has " << daylightMatrix.nCols() << " sky patches, previous window groups have " 
+          << m_numSkyPatches << ".");
+      return false;
+    }
+
+    unsigned nPatches = daylightMatrix.nCols();
+    StateCoefficients coefficients;
+    BOOST_FOREACH(const RadianceMatrix& transmissionMatrix, transmissionMatrices){
+      // V (T D), the inner product is the smaller one
+      RadianceMatrix td = RadianceMatrix::multiply(transmissionMatrix, daylightMatrix);
+      if (td.empty()){
+        return false;
+      }
+      RadianceMatrix vtd = RadianceMatrix::multiply(viewMatrix, td);
+      if (vtd.empty()){
+        return false;
+      }
+
+      // fold in the photopic weighting, one row of 3*nPatches coefficients per sensor
+      std::vector<double> stateCoefficients(static_cast<size_t>(nSensors)*3*nPatches);
+      for (unsigned s = 0; s < nSensors; ++s){
+        double* row = &stateCoefficients[static_cast<size_t>(s)*3*nPatches];
+        for (unsigned c = 0; c < 3; ++c){
+          unsigned vc = (vtd.nComp() == 1) ? 0 : c;
+          for (unsigned p = 0; p < nPatches; ++p){
+            row[c*nPatches + p] = rgbToLux[c]*vtd(s,p,vc);
+          }
+        }
+      }
+      coefficients.push_back(std::vector<double>());
+      coefficients.back().swap(stateCoefficients);
+    }
+
+    m_numSkyPatches = nPatches;
+    m_windowGroups.push_back(coefficients);
+    return true;
+  }
+
+  bool DaylightCoefficientEngine::addWindowGroup(const openstudio::path& viewMatrix,
+                                                 const std::vector<openstudio::path>& transmissionMatrices,
+                                                 const openstudio::path& daylightMatrix)
+  {
+    boost::optional<RadianceMatrix> v = RadianceMatrix::load(viewMatrix);
+    boost::optional<RadianceMatrix> d = RadianceMatrix::load(daylightMatrix);
+    if (!v || !d){
+      return false;
+    }
+    std::vector<RadianceMatrix> ts;
+    BOOST_FOREACH(const openstudio::path& transmissionMatrix, transmissionMatrices){
+      boost::optional<RadianceMatrix> t = RadianceMatrix::load(transmissionMatrix);
+      if (!t){
+        return false;
+      }
+      ts.push_back(*t);
+    }
+    return addWindowGroup(*v, ts, *d);
+  }
+
+  std::vector<float> DaylightCoefficientEngine::illuminance(const RadianceMatrix& skyMatrix,
+                                                            const std::vector<std::vector<unsigned> >& states,
+                                                            unsigned numThreads) const
+  {
+    std::vector<float> result;
+
+    if (m_windowGroups.empty()){
+      LOG(Error, "No window groups have been added.");
+      return result;
+    }
+    if (skyMatrix.nRows() != m_numSkyPatches){
+      LOG(Error, "Sky matrix has " << skyMatrix.nRows() << " patches, expected " << m_numSkyPatches << ".");
+      return result;
+    }
+    if (states.size() != m_windowGroups.size()){
+      LOG(Error, "Expected shade states for " << m_windowGroups.size() << " window groups, received " 
+          << states.size() << ".");
+      return result;
+    }
+
+    unsigned nTimeSteps = skyMatrix.nCols();
+    for (unsigned g = 0, n = states.size(); g < n; ++g){
+      if (states[g].empty()){
+        continue;
+      }
+      if (states[g].size() != nTimeSteps){
+        LOG(Error, "Window group " << g << " has " << states[g].size() << " shade states, expected one per time step (" 
+            << nTimeSteps << ").");
+        return result;
+      }
+      unsigned maxState = *std::max_element(states[g].begin(), states[g].end());
+      if (maxState >= m_windowGroups[g].size()){
+        LOG(Error, "Window group " << g << " has no shade state " << maxState << ".");
+        return result;
+      }
+    }
+
+    // transpose the sky matrix so each time step is a contiguous vector of 3*numSkyPatches
+    unsigned nPatches = m_numSkyPatches;
+    std::vector<double> skyVectors(static_cast<size_t>(nTimeSteps)*3*nPatches);
+    for (unsigned t = 0; t < nTimeSteps; ++t){
+      double* skyVector = &skyVectors[static_cast<size_t>(t)*3*nPatches];
+      for (unsigned c = 0; c < 3; ++c){
+        unsigned sc = (skyMatrix.nComp() == 1) ? 0 : c;
+        for (unsigned p = 0; p < nPatches; ++p){
+          skyVector[c*nPatches + p] = skyMatrix(p,t,sc);
+        }
+      }
+    }
+
+    result.resize(static_cast<size_t>(nTimeSteps)*numSensors(), 0.0f);
+    if (nTimeSteps == 0){
+      return result;
+    }
+
+    if (numThreads == 0){
+      numThreads = std::max(1u, boost::thread::hardware_concurrency());
+    }
+    numThreads = std::min(numThreads, nTimeSteps);
+
+    if (numThreads == 1){
+      computeTimeSteps(skyVectors, states, 0, nTimeSteps, &result[0]);
+    }else{
+      // each thread writes a disjoint range of time steps
+      boost::thread_group threads;
+      unsigned chunk = (nTimeSteps + numThreads - 1) / numThreads;
+      for (unsigned begin = 0; begin < nTimeSteps; begin += chunk){
+        unsigned end = std::min(begin + chunk, nTimeSteps);
+        threads.create_thread(boost::bind(&DaylightCoefficientEngine::computeTimeSteps, this,
+                                          boost::cref(skyVectors), boost::cref(states), begin, end, &result[0]));
+      }
+      threads.join_all();
+    }
+
+    return result;
+  }
+
+  bool DaylightCoefficientEngine::run(const RadianceMatrix& skyMatrix,
+                                      const openstudio::DateTimeVector& dateTimes,
+                                      const std::vector<std::vector<unsigned> >& states,
+                                      const openstudio::path& outPath,
+                                      unsigned numThreads) const
+  {
+    if (dateTimes.size() != skyMatrix.nCols()){
+      LOG(Error, "Received " << dateTimes.size() << " date times for " << skyMatrix.nCols() << " sky vectors.");
+      return false;
+    }
+
+    std::vector<float> values = illuminance(skyMatrix, states, numThreads);
+    if (values.empty() && !dateTimes.empty()){
+      return false;
+    }
+
+    return AnnualIlluminanceMap::saveBinary(outPath, m_xVector, m_yVector, dateTimes, values);
+  }
+
+  std::vector<unsigned> DaylightCoefficientEngine::shadeStates(double windowAzimuth, const std::vector<double>& solarAzimuths)
+  {
+    double windowVector = windowAzimuth*180.0/boost::math::constants::pi<double>() + 180.0;
+    std::vector<unsigned> result;
+    result.reserve(solarAzimuths.size());
+    BOOST_FOREACH(double solarAzimuth, solarAzimuths){
+      if ((solarAzimuth > windowVector + 90.0) || (solarAzimuth < windowVector - 90.0)){
+        result.push_back(0);
+      }else{
+        result.push_back(1);
+      }
+    }
+    return result;
+  }
+
+  void DaylightCoefficientEngine::computeTimeSteps(const std::vector<double>& skyVectors,
+                                                   const std::vector<std::vector<unsigned> >& states,
+                                                   unsigned begin,
+                                                   unsigned end,
+                                                   float* result) const
+  {
+    unsigned nSensors = numSensors();
+    unsigned n = 3*m_numSkyPatches;
+    std::vector<double> sums;
+
+    for (unsigned blockBegin = begin; blockBegin < end; blockBegin += timeStepBlockSize){
+      unsigned blockEnd = std::min(blockBegin + timeStepBlockSize, end);
+      unsigned blockSize = blockEnd - blockBegin;
+      sums.assign(static_cast<size_t>(blockSize)*nSensors, 0.0);
+
+      for (unsigned g = 0, nGroups = m_windowGroups.size(); g < nGroups; ++g){
+        const StateCoefficients& coefficients = m_windowGroups[g];
+        for (unsigned s = 0; s < nSensors; ++s){
+          for (unsigned t = blockBegin; t < blockEnd; ++t){
+            unsigned state = states[g].empty() ? 0 : states[g][t];
+            const double* row = &coefficients[state][static_cast<size_t>(s)*n];
+            const double* skyVector = &skyVectors[static_cast<size_t>(t)*n];
+            sums[static_cast<size_t>(t - blockBegin)*nSensors + s] += dot(row, skyVector, n);
+          }
+        }
+      }
+
+      for (unsigned t = blockBegin; t < blockEnd; ++t){
+        float* out = result + static_cast<size_t>(t)*nSensors;
+        const double* in = &sums[static_cast<size_t>(t - blockBegin)*nSensors];
+        for (unsigned s = 0; s < nSensors; ++s){
+          out[s] = static_cast<float>(in[s]);
+        }
+      }
+    }
+  }
+
+} // radiance
+} // openstudio
@@ -0,0 +1,127 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef RADIANCE_DAYLIGHTCOEFFICIENTENGINE_HPP
+#define RADIANCE_DAYLIGHTCOEFFICIENTENGINE_HPP
+
+#include "RadianceAPI.hpp"
+
+#include <radiance/RadianceMatrix.hpp>
+
+#include <utilities/data/Vector.hpp>
+#include <utilities/time/DateTime.hpp>
+#include <utilities/core/Logger.hpp>
+#include <utilities/core/Path.hpp>
+
+#include <vector>
+
+namespace openstudio{
+namespace radiance{
+
+  /** DaylightCoefficientEngine performs the three-phase daylight coefficient calculation 
+   *  E = V T D s for all sky vectors at once, in place of running dctimestep once per window 
+   *  group, BSDF state and time step. 
+   *
+   *  Each window group contributes a view matrix V (sensors x BSDF basis), one transmission 
+   *  matrix T per shade state (BSDF basis x BSDF basis) and a daylight matrix D (BSDF basis x 
+   *  sky patches). The products V T D are formed once when the window group is added and 
+   *  reduced to photopic illuminance coefficients, so evaluating a time step is a single 
+   *  dot product per sensor and window group. Sensors are the points of an illuminance map, 
+   *  ordered with the x index varying fastest. */
+  class RADIANCE_API DaylightCoefficientEngine
+  {
+    public:
+
+      /// construct for the illuminance map with the given x and y points, in meters
+      DaylightCoefficientEngine(const openstudio::Vector& xVector, const openstudio::Vector& yVector);
+
+      /// virtual destructor
+      virtual ~DaylightCoefficientEngine () {}
+
+      /// number of sensors, xVector().size()*yVector().size()
+      unsigned numSensors() const;
+
+      /// number of sky patches, zero until the first window group is added
+      unsigned numSkyPatches() const;
+
+      unsigned numWindowGroups() const;
+
+      /// number of shade states of window group
+      unsigned numStates(unsigned windowGroup) const;
+
+      /** Add a window group. transmissionMatrices holds one matrix per shade state. Returns false
+       *  if the matrix dimensions do not agree with each other or with the previous groups. */
+      bool addWindowGroup(const RadianceMatrix& viewMatrix,
+                          const std::vector<RadianceMatrix>& transmissionMatrices,
+                          const RadianceMatrix& daylightMatrix);
+
+      /// \\overload loads the matrices from file
+      bool addWindowGroup(const openstudio::path& viewMatrix,
+                          const std::vector<openstudio::path>& transmissionMatrices,
+                          const openstudio::path& daylightMatrix);
+
+      /** Compute illuminance in lux for every sensor and every column of skyMatrix (sky patches x 
+       *  time steps, as written by gendaymtx). states holds, for each window group, the shade 
+       *  state of each time step; an empty vector selects state 0 throughout. The result holds 
+       *  numSensors() values per time step. Work is split across numThreads threads, zero uses 
+       *  one thread per core. Returns an empty vector on error. */
+      std::vector<float> illuminance(const RadianceMatrix& skyMatrix,
+                                     const std::vector<std::vector<unsigned> >& states,
+                                     unsigned numThreads = 0) const;
+
+      /** Compute illuminance and save it as a binary annual illuminance map, see 
+       *  AnnualIlluminanceMap::saveBinary. dateTimes labels the columns of skyMatrix. */
+      bool run(const RadianceMatrix& skyMatrix,
+               const openstudio::DateTimeVector& dateTimes,
+               const std::vector<std::vector<unsigned> >& states,
+               const openstudio::path& outPath,
+               unsigned numThreads = 0) const;
+
+      /** Shade state of a window for each solar azimuth (degrees), following the control used by
+       *  DaylightSim.rb: state 1 (shaded) if the sun is within 90 degrees of the window normal, 
+       *  state 0 otherwise. windowAzimuth is in radians. */
+      static std::vector<unsigned> shadeStates(double windowAzimuth, const std::vector<double>& solarAzimuths);
+
+      const openstudio::Vector& xVector() const {return m_xVector;}
+
+      const openstudio::Vector& yVector() const {return m_yVector;}
+
+    private:
+
+      REGISTER_LOGGER("radiance.DaylightCoefficientEngine");
+
+      // illuminance coefficients for each shade state, each numSensors x (3*numSkyPatches)
+      typedef std::vector<std::vector<double> > StateCoefficients;
+
+      void computeTimeSteps(const std::vector<double>& skyVectors,
+                            const std::vector<std::vector<unsigned> >& states,
+                            unsigned begin,
+                            unsigned end,
+                            float* result) const;
+
+      openstudio::Vector m_xVector;
+      openstudio::Vector m_yVector;
+      unsigned m_numSkyPatches;
+      std::vector<StateCoefficients> m_windowGroups;
+  };
+
+} // radiance
+} // openstudio
+
+#endif //RADIANCE_DAYLIGHTCOEFFICIENTENGINE_HPP
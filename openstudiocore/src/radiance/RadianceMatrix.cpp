@@ -0,0 +1,259 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <radiance/RadianceMatrix.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+namespace openstudio{
+namespace radiance{
+
+  RadianceMatrix::RadianceMatrix()
+    : m_nRows(0), m_nCols(0), m_nComp(3)
+  {}
+
+  RadianceMatrix::RadianceMatrix(unsigned nRows, unsigned nCols, unsigned nComp)
+    : m_nRows(nRows), m_nCols(nCols), m_nComp(nComp), m_data(static_cast<size_t>(nRows)*nCols*nComp, 0.0)
+  {}
+
+  boost::optional<RadianceMatrix> RadianceMatrix::load(const openstudio::path& path)
+  {
+    boost::filesystem::ifstream file(path, std::ios_base::in | std::ios_base::binary);
+    if (!file){
+      LOG(Error, "Unable to open matrix file '" << toString(path) << "'.");
+      return boost::none;
+    }
+
+    // read the whole file, matrices are read once and then reused
+    std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    unsigned nRows = 0;
+    unsigned nCols = 0;
+    unsigned nComp = 3;
+    std::string format("ascii");
+
+    // parse the header, if any, which is terminated by an empty line
+    size_t pos = 0;
+    if (boost::starts_with(buffer, "#?RADIANCE")){
+      while (true){
+        size_t eol = buffer.find('\n', pos);
+        if (eol == std::string::npos){
+          LOG(Error, "Unterminated header in matrix file '" << toString(path) << "'.");
+          return boost::none;
+        }
+        std::string line = buffer.substr(pos, eol - pos);
+        pos = eol + 1;
+        boost::trim(line);
+        if (line.empty()){
+          break;
+        }
+        try {
+          if (boost::starts_with(line, "NROWS=")){
+            nRows = boost::lexical_cast<unsigned>(line.substr(6));
+          }else if (boost::starts_with(line, "NCOLS=")){
+            nCols = boost::lexical_cast<unsigned>(line.substr(6));
+          }else if (boost::starts_with(line, "NCOMP=")){
+            nComp = boost::lexical_cast<unsigned>(line.substr(6));
+          }else if (boost::starts_with(line, "FORMAT=")){
+            format = line.substr(7);
+          }
+        }catch (const boost::bad_lexical_cast&){
+          LOG(Error, "Unable to parse header line '" << line << "' in matrix file '" << toString(path) << "'.");
+          return boost::none;
+        }
+      }
+    }
+
+    if (nComp == 0){
+      LOG(Error, "Invalid number of components in matrix file '" << toString(path) << "'.");
+      return boost::none;
+    }
+
+    if ((format == "float") || (format == "double")){
+      if ((nRows == 0) || (nCols == 0)){
+        LOG(Error, "Binary matrix file '" << toString(path) << "' does not specify NROWS and NCOLS.");
+        return boost::none;
+      }
+      RadianceMatrix result(nRows, nCols, nComp);
+      size_t n = result.m_data.size();
+      size_t valueSize = (format == "float") ? sizeof(float) : sizeof(double);
+      if (buffer.size() - pos < n*valueSize){
+        LOG(Error, "Matrix file '" << toString(path) << "' is truncated.");
+        return boost::none;
+      }
+      const char* data = buffer.data() + pos;
+      if (format == "float"){
+        std::vector<float> values(n);
+        memcpy(&values[0], data, n*sizeof(float));
+        std::copy(values.begin(), values.end(), result.m_data.begin());
+      }else{
+        memcpy(&result.m_data[0], data, n*sizeof(double));
+      }
+      return result;
+    }
+
+    if (format != "ascii"){
+      LOG(Error, "Unsupported format '" << format << "' in matrix file '" << toString(path) << "'.");
+      return boost::none;
+    }
+
+    // ascii, parse numbers in place and keep track of the number of values on each line
+    std::vector<double> values;
+    if (nRows > 0 && nCols > 0){
+      values.reserve(static_cast<size_t>(nRows)*nCols*nComp);
+    }
+    unsigned numLines = 0;
+    size_t valuesPerLine = 0;
+    bool consistentLines = true;
+    const char* begin = buffer.c_str() + pos;
+    while (*begin != '\0'){
+      const char* eol = begin;
+      while ((*eol != '\0') && (*eol != '\n')){
+        ++eol;
+      }
+      size_t lineStart = values.size();
+      const char* p = begin;
+      while (p < eol){
+        // skip separators here, strtod would skip past the end of the line
+        if ((*p == ' ') || (*p == '\t') || (*p == '\r') || (*p == ',')){
+          ++p;
+          continue;
+        }
+        char* end = 0;
+        double value = std::strtod(p, &end);
+        if (end == p){
+          LOG(Error, "Unexpected character '" << *p << "' in matrix file '" << toString(path) << "'.");
+          return boost::none;
+        }
+        values.push_back(value);
+        p = end;
+      }
+      size_t lineValues = values.size() - lineStart;
+      if (lineValues > 0){
+        if (numLines == 0){
+          valuesPerLine = lineValues;
+        }else if (lineValues != valuesPerLine){
+          consistentLines = false;
+        }
+        ++numLines;
+      }
+      begin = (*eol == '\0') ? eol : eol + 1;
+    }
+
+    if ((nRows == 0) || (nCols == 0)){
+      if (!consistentLines || (valuesPerLine % nComp != 0)){
+        LOG(Error, "Unable to determine matrix dimensions of '" << toString(path) << "'.");
+        return boost::none;
+      }
+      nRows = numLines;
+      nCols = valuesPerLine / nComp;
+    }
+
+    RadianceMatrix result(nRows, nCols, nComp);
+    if (values.size() != result.m_data.size()){
+      LOG(Error, "Matrix file '" << toString(path) << "' contains " << values.size() 
+          << " values, expected " << result.m_data.size() << ".");
+      return boost::none;
+    }
+    result.m_data.swap(values);
+    return result;
+  }
+
+  bool RadianceMatrix::save(const openstudio::path& path) const
+  {
+    boost::filesystem::ofstream file(path);
+    if (!file){
+      LOG(Error, "Unable to open '" << toString(path) << "' for writing.");
+      return false;
+    }
+
+    file << "#?RADIANCE" << std::endl
+         << "NROWS=" << m_nRows << std::endl
+         << "NCOLS=" << m_nCols << std::endl
+         << "NCOMP=" << m_nComp << std::endl
+         << "FORMAT=ascii" << std::endl
+         << std::endl;
+    file << std::setprecision(9);
+    for (unsigned i = 0; i < m_nRows; ++i){
+      for (unsigned j = 0; j < m_nCols; ++j){
+        for (unsigned c = 0; c < m_nComp; ++c){
+          file << (*this)(i,j,c) << "\t";
+        }
+      }
+      file << std::endl;
+    }
+
+    bool result = file.good();
+    file.close();
+    return result;
+  }
+
+  RadianceMatrix RadianceMatrix::multiply(const RadianceMatrix& lhs, const RadianceMatrix& rhs)
+  {
+    if (lhs.nCols() != rhs.nRows()){
+      LOG(Error, "Cannot multiply " << lhs.nRows() << "x" << lhs.nCols() << " matrix by " 
+          << rhs.nRows() << "x" << rhs.nCols() << " matrix.");
+      return RadianceMatrix();
+    }
+    if ((lhs.nComp() != rhs.nComp()) && (lhs.nComp() != 1) && (rhs.nComp() != 1)){
+      LOG(Error, "Cannot multiply matrices with " << lhs.nComp() << " and " << rhs.nComp() << " components.");
+      return RadianceMatrix();
+    }
+
+    unsigned nComp = std::max(lhs.nComp(), rhs.nComp());
+    unsigned M = lhs.nRows();
+    unsigned K = lhs.nCols();
+    unsigned N = rhs.nCols();
+    RadianceMatrix result(M, N, nComp);
+
+    // i-k-j loop order so the innermost loop runs over contiguous memory in rhs and result
+    for (unsigned c = 0; c < nComp; ++c){
+      unsigned lc = (lhs.nComp() == 1) ? 0 : c;
+      unsigned rc = (rhs.nComp() == 1) ? 0 : c;
+      for (unsigned i = 0; i < M; ++i){
+        double* out = &result.m_data[static_cast<size_t>(i)*N*nComp + c];
+        for (unsigned k = 0; k < K; ++k){
+          double a = lhs(i,k,lc);
+          if (a == 0.0){
+            continue;
+          }
+          const double* b = &rhs.m_data[static_cast<size_t>(k)*N*rhs.nComp() + rc];
+          unsigned bStride = rhs.nComp();
+          for (unsigned j = 0; j < N; ++j){
+            out[j*nComp] += a*b[j*bStride];
+          }
+        }
+      }
+    }
+
+    return result;
+  }
+
+} // radiance
+} // openstudio
@@ -0,0 +1,101 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef RADIANCE_RADIANCEMATRIX_HPP
+#define RADIANCE_RADIANCEMATRIX_HPP
+
+#include "RadianceAPI.hpp"
+
+#include <utilities/core/Logger.hpp>
+#include <utilities/core/Path.hpp>
+
+#include <boost/optional.hpp>
+
+#include <vector>
+
+namespace openstudio{
+namespace radiance{
+
+  /** RadianceMatrix is a dense matrix of color (or gray) values as read and written by the 
+   *  Radiance matrix tools (rcontrib, gendaymtx, rmtxop, dctimestep). Values are stored row 
+   *  major, with the components of each element adjacent. */
+  class RADIANCE_API RadianceMatrix
+  {
+    public:
+
+      /// default constructor creates an empty matrix
+      RadianceMatrix();
+
+      /// construct a zero matrix
+      RadianceMatrix(unsigned nRows, unsigned nCols, unsigned nComp = 3);
+
+      /// virtual destructor
+      virtual ~RadianceMatrix () {}
+
+      /** Load a matrix file. Files with a Radiance header may be in ascii, float or double 
+       *  format; NROWS, NCOLS and NCOMP are read from the header. Files without a header (or 
+       *  without NROWS and NCOLS) must be ascii, with one row per line. XML BSDFs are not read 
+       *  directly, convert them with rmtxop first. */
+      static boost::optional<RadianceMatrix> load(const openstudio::path& path);
+
+      /// save in ascii format with a Radiance header
+      bool save(const openstudio::path& path) const;
+
+      unsigned nRows() const {return m_nRows;}
+
+      unsigned nCols() const {return m_nCols;}
+
+      unsigned nComp() const {return m_nComp;}
+
+      bool empty() const {return m_data.empty();}
+
+      /// get a single component of an element
+      double operator()(unsigned row, unsigned col, unsigned comp = 0) const 
+      {
+        return m_data[(static_cast<size_t>(row)*m_nCols + col)*m_nComp + comp];
+      }
+
+      /// get a single component of an element
+      double& operator()(unsigned row, unsigned col, unsigned comp = 0) 
+      {
+        return m_data[(static_cast<size_t>(row)*m_nCols + col)*m_nComp + comp];
+      }
+
+      /// all values
+      const std::vector<double>& data() const {return m_data;}
+
+      /** Component-wise matrix product, as computed by rmtxop and dctimestep. If one of the 
+       *  operands has a single component it is applied to all components of the other. 
+       *  Returns an empty matrix if the inner dimensions do not agree. */
+      static RadianceMatrix multiply(const RadianceMatrix& lhs, const RadianceMatrix& rhs);
+
+    private:
+
+      REGISTER_LOGGER("radiance.RadianceMatrix");
+
+      unsigned m_nRows;
+      unsigned m_nCols;
+      unsigned m_nComp;
+      std::vector<double> m_data;
+  };
+
+} // radiance
+} // openstudio
+
+#endif //RADIANCE_RADIANCEMATRIX_HPP
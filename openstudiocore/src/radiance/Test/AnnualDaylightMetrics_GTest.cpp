@@ -0,0 +1,176 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <radiance/AnnualDaylightMetrics.hpp>
+#include <radiance/AnnualIlluminanceMap.hpp>
+#include <radiance/BinaryAnnualIlluminanceMap.hpp>
+
+#include <utilities/core/Path.hpp>
+
+#include <resources.hxx>
+
+#include <boost/filesystem.hpp>
+#include <boost/foreach.hpp>
+
+using namespace openstudio;
+using namespace openstudio::radiance;
+
+namespace {
+
+  // write a 3 x 2 map with 4 time steps, value = 100*t + 10*j + i lux
+  openstudio::path writeTestMap(std::vector<float>& values)
+  {
+    openstudio::path path = toPath("./AnnualDaylightMetrics.bin");
+    if (boost::filesystem::exists(path)){
+      boost::filesystem::remove(path);
+    }
+
+    Vector xVector(3);
+    xVector[0] = 0.5; xVector[1] = 1.5; xVector[2] = 2.5;
+    Vector yVector(2);
+    yVector[0] = 0.25; yVector[1] = 0.75;
+
+    DateTimeVector dateTimes;
+    values.clear();
+    for (unsigned t = 0; t < 4; ++t){
+      dateTimes.push_back(DateTime(Date(MonthOfYear::Jun, 21), Time(0, 9 + t, 0, 0)));
+      for (unsigned j = 0; j < 2; ++j){
+        for (unsigned i = 0; i < 3; ++i){
+          values.push_back(static_cast<float>(100*t*t*t + 10*j + i));
+        }
+      }
+    }
+
+    EXPECT_TRUE(AnnualIlluminanceMap::saveBinary(path, xVector, yVector, dateTimes, values));
+    return path;
+  }
+
+  void checkClose(const Vector& lhs, const Vector& rhs)
+  {
+    ASSERT_EQ(lhs.size(), rhs.size());
+    for (unsigned i = 0; i < lhs.size(); ++i){
+      EXPECT_NEAR(lhs[i], rhs[i], 1.0e-6);
+    }
+  }
+
+  bool beforeNoon(const DateTime& dateTime)
+  {
+    return dateTime.time().totalHours() < 12.0;
+  }
+
+}
+
+TEST(AnnualDaylightMetrics, BinaryAnnualIlluminanceMap)
+{
+  std::vector<float> values;
+  openstudio::path path = writeTestMap(values);
+
+  EXPECT_TRUE(BinaryAnnualIlluminanceMap::isBinary(path));
+  BinaryAnnualIlluminanceMap binaryMap(path);
+  ASSERT_TRUE(binaryMap.isValid());
+  EXPECT_EQ(4u, binaryMap.numTimeSteps());
+  EXPECT_EQ(6u, binaryMap.numPoints());
+  ASSERT_EQ(3u, binaryMap.xVector().size());
+  ASSERT_EQ(2u, binaryMap.yVector().size());
+  EXPECT_DOUBLE_EQ(1.5, binaryMap.xVector()[1]);
+  EXPECT_DOUBLE_EQ(0.75, binaryMap.yVector()[1]);
+
+  EXPECT_EQ(DateTime(Date(MonthOfYear::Jun, 21), Time(0, 11, 0, 0)), binaryMap.dateTime(2));
+  EXPECT_EQ(4u, binaryMap.dateTimes().size());
+
+  for (unsigned t = 0; t < 4; ++t){
+    const float* slice = binaryMap.illuminance(t);
+    ASSERT_TRUE(slice);
+    for (unsigned k = 0; k < 6; ++k){
+      EXPECT_EQ(values[6*t + k], slice[k]);
+    }
+  }
+  EXPECT_FALSE(binaryMap.illuminance(4));
+
+  Matrix matrix = binaryMap.illuminanceMap(3);
+  EXPECT_DOUBLE_EQ(2700.0 + 10.0 + 2.0, matrix(2,1));
+
+  // the general reader accepts the binary format too
+  AnnualIlluminanceMap annualMap(path);
+  EXPECT_EQ(4u, annualMap.dateTimes().size());
+  EXPECT_DOUBLE_EQ(800.0 + 1.0, annualMap.illuminanceMap(binaryMap.dateTime(2))(1,0));
+
+  boost::filesystem::remove(path);
+}
+
+TEST(AnnualDaylightMetrics, Compute)
+{
+  std::vector<float> values;
+  openstudio::path path = writeTestMap(values);
+
+  // per point values over time are {p, 100 + p, 800 + p, 2700 + p} with p in 0..12
+  boost::optional<AnnualDaylightMetrics> metrics = AnnualDaylightMetrics::compute(path);
+  ASSERT_TRUE(metrics);
+  EXPECT_EQ(6u, metrics->numPoints());
+  EXPECT_EQ(4u, metrics->numTimeSteps());
+
+  checkClose(Vector(6, 0.5), metrics->daylightAutonomy());
+  checkClose(Vector(6, 0.25), metrics->udiFellShort());
+  checkClose(Vector(6, 0.5), metrics->udiUseful());
+  checkClose(Vector(6, 0.25), metrics->udiExceeded());
+  EXPECT_NEAR(900.0, metrics->meanIlluminance()[0], 1.0e-6);
+  EXPECT_NEAR(912.0, metrics->meanIlluminance()[5], 1.0e-6);
+
+  // only 9, 10 and 11 o'clock
+  metrics = AnnualDaylightMetrics::compute(path, beforeNoon, 500.0);
+  ASSERT_TRUE(metrics);
+  EXPECT_EQ(3u, metrics->numTimeSteps());
+  EXPECT_DOUBLE_EQ(500.0, metrics->daThreshold());
+  checkClose(Vector(6, 1.0/3.0), metrics->daylightAutonomy());
+  checkClose(Vector(6, 1.0/3.0), metrics->udiFellShort());
+  checkClose(Vector(6, 2.0/3.0), metrics->udiUseful());
+  checkClose(Vector(6, 0.0), metrics->udiExceeded());
+
+  EXPECT_FALSE(AnnualDaylightMetrics::compute(toPath("./DoesNotExist.bin")));
+
+  boost::filesystem::remove(path);
+}
+
+TEST(AnnualDaylightMetrics, TextMap)
+{
+  openstudio::path path = resourcesPath() / toPath("radiance/Daylighting/annual_day.ill");
+  AnnualIlluminanceMap annualMap(path);
+
+  boost::optional<AnnualDaylightMetrics> metrics = AnnualDaylightMetrics::compute(path);
+  ASSERT_TRUE(metrics);
+  EXPECT_EQ(annualMap.dateTimes().size(), metrics->numTimeSteps());
+  EXPECT_EQ(annualMap.xVector().size()*annualMap.yVector().size(), metrics->numPoints());
+
+  // same result as summing the materialized maps, text values are not rounded to float
+  unsigned M = annualMap.xVector().size();
+  Vector expected(metrics->numPoints(), 0.0);
+  BOOST_FOREACH(const DateTime& dateTime, annualMap.dateTimes()){
+    Matrix map = annualMap.illuminanceMap(dateTime);
+    for (unsigned k = 0; k < expected.size(); ++k){
+      expected[k] += map(k % M, k / M) / annualMap.dateTimes().size();
+    }
+  }
+  Vector mean = metrics->meanIlluminance();
+  ASSERT_EQ(expected.size(), mean.size());
+  for (unsigned k = 0; k < expected.size(); ++k){
+    EXPECT_NEAR(expected[k], mean[k], 1.0e-9*(1.0 + expected[k]));
+  }
+}
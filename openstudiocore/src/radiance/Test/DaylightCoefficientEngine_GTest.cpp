@@ -0,0 +1,158 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <radiance/DaylightCoefficientEngine.hpp>
+#include <radiance/RadianceMatrix.hpp>
+
+#include <utilities/core/Path.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/foreach.hpp>
+
+#include <cmath>
+
+using namespace openstudio;
+using namespace openstudio::radiance;
+
+RadianceMatrix testMatrix(unsigned nRows, unsigned nCols, unsigned seed)
+{
+  RadianceMatrix result(nRows, nCols, 3);
+  for (unsigned i = 0; i < nRows; ++i){
+    for (unsigned j = 0; j < nCols; ++j){
+      for (unsigned c = 0; c < 3; ++c){
+        result(i,j,c) = 0.1 + std::fmod(0.37*(i + 1) + 0.53*(j + 1) + 0.71*(c + 1)*seed, 1.0);
+      }
+    }
+  }
+  return result;
+}
+
+TEST(DaylightCoefficientEngine, RadianceMatrix)
+{
+  RadianceMatrix matrix = testMatrix(4, 5, 1);
+
+  openstudio::path path = toPath("./RadianceMatrix.mtx");
+  if (boost::filesystem::exists(path)){
+    boost::filesystem::remove(path);
+  }
+  ASSERT_TRUE(matrix.save(path));
+
+  boost::optional<RadianceMatrix> loaded = RadianceMatrix::load(path);
+  ASSERT_TRUE(loaded);
+  ASSERT_EQ(4u, loaded->nRows());
+  ASSERT_EQ(5u, loaded->nCols());
+  ASSERT_EQ(3u, loaded->nComp());
+  for (unsigned i = 0; i < 4; ++i){
+    for (unsigned j = 0; j < 5; ++j){
+      for (unsigned c = 0; c < 3; ++c){
+        EXPECT_NEAR(matrix(i,j,c), (*loaded)(i,j,c), 1.0E-6);
+      }
+    }
+  }
+
+  // dimensions do not agree
+  EXPECT_TRUE(RadianceMatrix::multiply(matrix, matrix).empty());
+  RadianceMatrix product = RadianceMatrix::multiply(matrix, testMatrix(5, 2, 2));
+  EXPECT_EQ(4u, product.nRows());
+  EXPECT_EQ(2u, product.nCols());
+}
+
+TEST(DaylightCoefficientEngine, Illuminance)
+{
+  Vector xVector(3);
+  Vector yVector(2);
+  for (unsigned i = 0; i < 3; ++i){
+    xVector[i] = i;
+  }
+  for (unsigned j = 0; j < 2; ++j){
+    yVector[j] = j;
+  }
+
+  unsigned nSensors = 6;
+  unsigned nBasis = 4;
+  unsigned nPatches = 5;
+  unsigned nTimeSteps = 50;
+
+  RadianceMatrix viewMatrix = testMatrix(nSensors, nBasis, 1);
+  RadianceMatrix daylightMatrix = testMatrix(nBasis, nPatches, 2);
+  std::vector<RadianceMatrix> transmissionMatrices;
+  transmissionMatrices.push_back(testMatrix(nBasis, nBasis, 3));
+  transmissionMatrices.push_back(testMatrix(nBasis, nBasis, 4));
+  RadianceMatrix skyMatrix = testMatrix(nPatches, nTimeSteps, 5);
+
+  DaylightCoefficientEngine engine(xVector, yVector);
+  EXPECT_EQ(nSensors, engine.numSensors());
+  EXPECT_FALSE(engine.addWindowGroup(testMatrix(nSensors + 1, nBasis, 1), transmissionMatrices, daylightMatrix));
+  ASSERT_TRUE(engine.addWindowGroup(viewMatrix, transmissionMatrices, daylightMatrix));
+  EXPECT_EQ(1u, engine.numWindowGroups());
+  EXPECT_EQ(2u, engine.numStates(0));
+  EXPECT_EQ(nPatches, engine.numSkyPatches());
+
+  std::vector<std::vector<unsigned> > states(1);
+  for (unsigned t = 0; t < nTimeSteps; ++t){
+    states[0].push_back(t % 2);
+  }
+
+  std::vector<float> result = engine.illuminance(skyMatrix, states, 4);
+  ASSERT_EQ(nSensors*nTimeSteps, result.size());
+
+  // compare to the matrix chain evaluated one time step at a time, as dctimestep does
+  const double rgbToLux[3] = {179.0*0.265, 179.0*0.67, 179.0*0.065};
+  for (unsigned t = 0; t < nTimeSteps; ++t){
+    const RadianceMatrix& transmissionMatrix = transmissionMatrices[states[0][t]];
+    for (unsigned s = 0; s < nSensors; ++s){
+      double expected = 0.0;
+      for (unsigned c = 0; c < 3; ++c){
+        for (unsigned a = 0; a < nBasis; ++a){
+          for (unsigned b = 0; b < nBasis; ++b){
+            for (unsigned p = 0; p < nPatches; ++p){
+              expected += rgbToLux[c]*viewMatrix(s,a,c)*transmissionMatrix(a,b,c)*daylightMatrix(b,p,c)*skyMatrix(p,t,c);
+            }
+          }
+        }
+      }
+      EXPECT_NEAR(expected, result[t*nSensors + s], 1.0E-5*expected);
+    }
+  }
+
+  // single threaded result is identical
+  std::vector<float> serialResult = engine.illuminance(skyMatrix, states, 1);
+  EXPECT_TRUE(result == serialResult);
+
+  // shade states out of range
+  states[0][0] = 2;
+  EXPECT_TRUE(engine.illuminance(skyMatrix, states).empty());
+}
+
+TEST(DaylightCoefficientEngine, ShadeStates)
+{
+  std::vector<double> solarAzimuths;
+  solarAzimuths.push_back(10.0);
+  solarAzimuths.push_back(200.0);
+  solarAzimuths.push_back(300.0);
+
+  // window facing north, normal points south
+  std::vector<unsigned> states = DaylightCoefficientEngine::shadeStates(0.0, solarAzimuths);
+  ASSERT_EQ(3u, states.size());
+  EXPECT_EQ(0u, states[0]);
+  EXPECT_EQ(1u, states[1]);
+  EXPECT_EQ(0u, states[2]);
+}
@@ -41,8 +41,10 @@ namespace resultsviewer{
 
 
   LinePlotCurve::LinePlotCurve(QString& title, openstudio::TimeSeriesLinePlotData& data)
+    : m_yScaledMin(0.0), m_yScaledMax(1.0)
   {
     setTitle(title);
+    setPyramid(data.pyramid());
     m_yType = resultsviewer::unScaledY;
     setLinePlotStyle(resultsviewer::smoothLinePlot);
     setLinePlotData(data);
@@ -70,10 +72,12 @@ namespace resultsviewer{
     switch (yType)
     {
     case resultsviewer::unScaledY:
+      resetYScale();
       setData(m_xValues, m_yUnscaled);
       m_yType = yType;
       break;
     case resultsviewer::scaledY:
+      setYScale(m_yScaledMin, m_yScaledMax);
       setData(m_xValues, m_yScaled);
       m_yType = yType;
       break;
@@ -1325,6 +1329,7 @@ namespace resultsviewer{
             }
             // reset data
             plotCurve->setTitle(plotCurve->title().text() + "[" + QString::number(plotCurve->minYValue()) + ", "  + QString::number(plotCurve->maxYValue()) + "]");
+            plotCurve->setYScaledRange(plotCurve->minYValue(), plotCurve->maxYValue());
             plotCurve->setYScaled(yData);
             plotCurve->setDataMode(resultsviewer::scaledY);
           }
@@ -78,7 +78,7 @@ namespace resultsviewer{
   and hold scaled and unscaled y-values
   and hold smooth and stair x-values
   */
-  class LinePlotCurve : public QwtPlotCurve
+  class LinePlotCurve : public openstudio::DecimatedPlotCurve
   {
   public:
     LinePlotCurve(QString& title, openstudio::TimeSeriesLinePlotData& data);
@@ -95,6 +95,8 @@ namespace resultsviewer{
     void setYUnscaled(QwtArray<double>& yUnscaled) {m_yUnscaled = yUnscaled;}
     double yScaled(int i) {return m_yScaled[i];}
     void setYScaled(QwtArray<double>& yScaled) {m_yScaled = yScaled;}
+    // range of unscaled y mapped to [0,1] in yScaled
+    void setYScaledRange(double minY, double maxY) {m_yScaledMin = minY; m_yScaledMax = maxY;}
     double xValues(int i) {return m_xValues[i];}
     void setXValues(QwtArray<double>& xValues) {m_xValues = xValues;}
 
@@ -114,6 +116,8 @@ namespace resultsviewer{
     QwtArray<double> m_yScaled;
     QwtArray<double> m_yUnscaled;
     QwtArray<double> m_xValues; // mid point
+    double m_yScaledMin;
+    double m_yScaledMax;
     YValueType m_yType;
     LinePlotStyleType m_linePlotStyle;
 
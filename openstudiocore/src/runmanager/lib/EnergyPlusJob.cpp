@@ -143,6 +143,15 @@ namespace detail {
   }
 
 
+  boost::optional<EarlyTerminationPolicy> EnergyPlusJob::energyPlusMonitorPolicy(const std::string &t_toolName) const
+  {
+    if (t_toolName != "energyplus") {
+      return boost::none;
+    }
+
+    return EarlyTerminationPolicy(params());
+  }
+
   void EnergyPlusJob::startHandlerImpl()
   {
     getFiles(allInputFiles(), params());
@@ -62,6 +62,8 @@ namespace detail {
       /// Actual execution implementation
       virtual void startHandlerImpl();
 
+      virtual boost::optional<EarlyTerminationPolicy> energyPlusMonitorPolicy(const std::string &t_toolName) const;
+
       virtual void basePathChanged();
 
     private:
@@ -0,0 +1,268 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include "EnergyPlusMonitor.hpp"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+
+namespace openstudio {
+namespace runmanager {
+
+  namespace {
+
+    // matches[1], warm up day
+    const boost::regex warmingUp("^\\s*Warming up \\{?(\\d+)\\}?.*$");
+
+    // matches[1], month/day, matches[2], environment
+    const boost::regex simulationAt("^\\s*(?:Starting|Continuing) Simulation at (\\d+/\\d+) for (.*)$");
+
+    // sizing and reporting phases
+    const boost::regex phase("^\\s*((?:Performing|Writing|Beginning|Initializing) .*)$");
+
+    bool paramIsTrue(const JobParams &t_params, const std::string &t_key)
+    {
+      return t_params.has(t_key) 
+        && !t_params.get(t_key).children.empty()
+        && boost::iequals(t_params.get(t_key).children[0].value, "true");
+    }
+
+  }
+
+  EarlyTerminationPolicy::EarlyTerminationPolicy()
+    : stopOnFatal(false), stopOnSevere(false)
+  {
+  }
+
+  EarlyTerminationPolicy::EarlyTerminationPolicy(const JobParams &t_params)
+    : stopOnFatal(paramIsTrue(t_params, "stopOnFatal")), 
+      stopOnSevere(paramIsTrue(t_params, "stopOnSevere"))
+  {
+    if (t_params.has("maxWarnings") && !t_params.get("maxWarnings").children.empty())
+    {
+      try {
+        maxWarnings = boost::lexical_cast<unsigned>(t_params.get("maxWarnings").children[0].value);
+      } catch (const boost::bad_lexical_cast &) {
+      }
+    }
+
+    if (t_params.has("stopPattern"))
+    {
+      std::vector<JobParam> patterns = t_params.get("stopPattern").children;
+      for (std::vector<JobParam>::const_iterator itr = patterns.begin();
+           itr != patterns.end();
+           ++itr)
+      {
+        stopPatterns.push_back(itr->value);
+      }
+    }
+  }
+
+  bool EarlyTerminationPolicy::empty() const
+  {
+    return !stopOnFatal && !stopOnSevere && !maxWarnings && stopPatterns.empty();
+  }
+
+  JobParams EarlyTerminationPolicy::toParams() const
+  {
+    JobParams params;
+
+    if (stopOnFatal)
+    {
+      params.append("stopOnFatal", "true");
+    }
+
+    if (stopOnSevere)
+    {
+      params.append("stopOnSevere", "true");
+    }
+
+    if (maxWarnings)
+    {
+      params.append("maxWarnings", boost::lexical_cast<std::string>(*maxWarnings));
+    }
+
+    if (!stopPatterns.empty())
+    {
+      JobParams patterns;
+      for (std::vector<std::string>::const_iterator itr = stopPatterns.begin();
+           itr != stopPatterns.end();
+           ++itr)
+      {
+        patterns.append(JobParam(*itr));
+      }
+      params.append("stopPattern", patterns);
+    }
+
+    return params;
+  }
+
+namespace detail {
+
+  EnergyPlusMonitor::EnergyPlusMonitor(const openstudio::path &t_errPath, const EarlyTerminationPolicy &t_policy)
+    : m_errPath(t_errPath), m_policy(t_policy), m_stopped(false),
+      m_checkedWarnings(0), m_checkedSevereErrors(0), m_checkedFatalErrors(0)
+  {
+    for (std::vector<std::string>::const_iterator itr = m_policy.stopPatterns.begin();
+         itr != m_policy.stopPatterns.end();
+         ++itr)
+    {
+      try {
+        m_patterns.push_back(boost::regex(*itr, boost::regex::perl | boost::regex::icase));
+      } catch (const boost::regex_error &e) {
+        LOG(Error, "Ignoring invalid stopPattern '" << *itr << "': " << e.what());
+      }
+    }
+  }
+
+  const openstudio::energyplus::ErrorFile &EnergyPlusMonitor::errorFile() const
+  {
+    return m_errorFile;
+  }
+
+  boost::optional<AdvancedStatus> EnergyPlusMonitor::standardOutDataAdded(const std::string &t_data)
+  {
+    boost::optional<AdvancedStatus> result;
+
+    m_partialLine += t_data;
+
+    std::string::size_type begin = 0;
+    std::string::size_type end;
+    while ((end = m_partialLine.find('\n', begin)) != std::string::npos)
+    {
+      boost::optional<AdvancedStatus> status = parseLine(boost::trim_right_copy(m_partialLine.substr(begin, end - begin)));
+      if (status)
+      {
+        result = status;
+      }
+      begin = end + 1;
+    }
+
+    m_partialLine.erase(0, begin);
+
+    return result;
+  }
+
+  boost::optional<AdvancedStatus> EnergyPlusMonitor::parseLine(const std::string &t_line)
+  {
+    boost::smatch matches;
+
+    if (boost::regex_match(t_line, matches, simulationAt))
+    {
+      m_environment = boost::trim_copy(std::string(matches[2].first, matches[2].second));
+      return AdvancedStatus(AdvancedStatusEnum::Processing, 
+          m_environment + " " + std::string(matches[1].first, matches[1].second));
+    } else if (boost::regex_match(t_line, matches, warmingUp)) {
+      std::string description = "Warming up, day " + std::string(matches[1].first, matches[1].second);
+      if (!m_environment.empty())
+      {
+        description = m_environment + " " + description;
+      }
+      return AdvancedStatus(AdvancedStatusEnum::Processing, description);
+    } else if (boost::regex_match(t_line, matches, phase)) {
+      if (boost::starts_with(std::string(matches[1].first, matches[1].second), "Initializing New Environment"))
+      {
+        m_environment.clear();
+      }
+      return AdvancedStatus(AdvancedStatusEnum::Processing, std::string(matches[1].first, matches[1].second));
+    }
+
+    return boost::none;
+  }
+
+  boost::optional<std::string> EnergyPlusMonitor::update()
+  {
+    if (!m_errorFile.tail(m_errPath) || m_stopped || m_policy.empty())
+    {
+      return boost::none;
+    }
+
+    boost::optional<std::string> reason = checkPolicy();
+    if (reason)
+    {
+      m_stopped = true;
+      LOG(Info, "Stopping EnergyPlus early: " << *reason);
+    }
+    return reason;
+  }
+
+  boost::optional<std::string> EnergyPlusMonitor::checkPolicy()
+  {
+    std::vector<std::string> fatalErrors = m_errorFile.fatalErrors();
+    if (m_policy.stopOnFatal && !fatalErrors.empty())
+    {
+      return "Fatal error: " + fatalErrors.front();
+    }
+
+    std::vector<std::string> severeErrors = m_errorFile.severeErrors();
+    if (m_policy.stopOnSevere && !severeErrors.empty())
+    {
+      return "Severe error: " + severeErrors.front();
+    }
+
+    std::vector<std::string> warnings = m_errorFile.warnings();
+    if (m_policy.maxWarnings && warnings.size() > *m_policy.maxWarnings)
+    {
+      return "More than " + boost::lexical_cast<std::string>(*m_policy.maxWarnings) + " warnings";
+    }
+
+    if (!m_patterns.empty())
+    {
+      // the last message may still have continuation lines coming, unless the file is complete
+      bool all = m_errorFile.completed();
+
+      boost::optional<std::string> reason = checkPatterns(fatalErrors, m_checkedFatalErrors, all);
+      if (!reason)
+      {
+        reason = checkPatterns(severeErrors, m_checkedSevereErrors, all);
+      }
+      if (!reason)
+      {
+        reason = checkPatterns(warnings, m_checkedWarnings, all);
+      }
+      return reason;
+    }
+
+    return boost::none;
+  }
+
+  boost::optional<std::string> EnergyPlusMonitor::checkPatterns(const std::vector<std::string> &t_messages, 
+      size_t &t_checked, bool t_all) const
+  {
+    size_t end = t_all ? t_messages.size() : (t_messages.empty() ? 0 : t_messages.size() - 1);
+
+    for (; t_checked < end; ++t_checked)
+    {
+      for (std::vector<boost::regex>::const_iterator itr = m_patterns.begin();
+           itr != m_patterns.end();
+           ++itr)
+      {
+        if (boost::regex_search(t_messages[t_checked], *itr))
+        {
+          return "Matched stop pattern '" + itr->str() + "': " + t_messages[t_checked];
+        }
+      }
+    }
+
+    return boost::none;
+  }
+
+}
+}
+}
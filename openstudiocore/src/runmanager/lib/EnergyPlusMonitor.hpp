@@ -0,0 +1,120 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef OPENSTUDIO_RUNMANAGER_ENERGYPLUSMONITOR_HPP
+#define OPENSTUDIO_RUNMANAGER_ENERGYPLUSMONITOR_HPP
+
+#include "RunManagerAPI.hpp"
+#include "AdvancedStatus.hpp"
+#include "JobParam.hpp"
+
+#include <energyplus/ErrorFile.hpp>
+
+#include <utilities/core/Path.hpp>
+#include <utilities/core/Logger.hpp>
+
+#include <boost/optional.hpp>
+#include <boost/regex.hpp>
+
+#include <string>
+#include <vector>
+
+namespace openstudio {
+namespace runmanager {
+
+  /// Conditions on which a running EnergyPlus job is stopped before EnergyPlus exits, so that
+  /// a doomed simulation frees its slot for the next job. The default policy never stops a job.
+  ///
+  /// The policy is passed to an EnergyPlus job through its JobParams:
+  /// - "stopOnFatal" with a child of "true"
+  /// - "stopOnSevere" with a child of "true"
+  /// - "maxWarnings" with a child holding the number of warnings allowed
+  /// - "stopPattern" with one child per regular expression; a warning or error whose text 
+  ///   matches any of them stops the job
+  struct RUNMANAGER_API EarlyTerminationPolicy
+  {
+    /// Creates a policy that never stops a job
+    EarlyTerminationPolicy();
+
+    /// Creates a policy from the params of a job
+    explicit EarlyTerminationPolicy(const JobParams &t_params);
+
+    /// \returns true if this policy never stops a job
+    bool empty() const;
+
+    /// \returns the params describing this policy, to be appended to the params of a job
+    JobParams toParams() const;
+
+    bool stopOnFatal;
+    bool stopOnSevere;
+    boost::optional<unsigned> maxWarnings;
+    std::vector<std::string> stopPatterns;
+  };
+
+namespace detail {
+
+  /// Follows a running EnergyPlus simulation. Standard output is parsed for progress and the
+  /// error file is read incrementally as it grows and checked against an EarlyTerminationPolicy.
+  /// Not thread safe, the owner serializes access.
+  class RUNMANAGER_API EnergyPlusMonitor
+  {
+    public:
+      /// \param[in] t_errPath eplusout.err of the simulation, it need not exist yet
+      /// \param[in] t_policy conditions on which the simulation should be stopped
+      EnergyPlusMonitor(const openstudio::path &t_errPath, const EarlyTerminationPolicy &t_policy);
+
+      /// Parses data written to standard output
+      /// \returns the new progress status if it changed
+      boost::optional<AdvancedStatus> standardOutDataAdded(const std::string &t_data);
+
+      /// Reads lines appended to the error file since the last call
+      /// \returns the reason the simulation should be stopped, only returned once
+      boost::optional<std::string> update();
+
+      /// \returns the error file as read so far
+      const openstudio::energyplus::ErrorFile &errorFile() const;
+
+    private:
+      REGISTER_LOGGER("openstudio.runmanager.EnergyPlusMonitor");
+
+      boost::optional<AdvancedStatus> parseLine(const std::string &t_line);
+      boost::optional<std::string> checkPolicy();
+      boost::optional<std::string> checkPatterns(const std::vector<std::string> &t_messages, size_t &t_checked, bool t_all) const;
+
+      openstudio::path m_errPath;
+      EarlyTerminationPolicy m_policy;
+      std::vector<boost::regex> m_patterns;
+
+      openstudio::energyplus::ErrorFile m_errorFile;
+      bool m_stopped;
+
+      // messages already checked against the patterns
+      size_t m_checkedWarnings;
+      size_t m_checkedSevereErrors;
+      size_t m_checkedFatalErrors;
+
+      std::string m_partialLine; ///< standard output not yet terminated by a newline
+      std::string m_environment; ///< environment currently being simulated
+  };
+
+}
+}
+}
+
+#endif
@@ -105,6 +105,11 @@ namespace runmanager {
     return m_impl->remoteRunnable();
   }
 
+  bool Job::workerRunnable(const std::set<std::string> &t_workerTools) const
+  {
+    return m_impl->workerRunnable(t_workerTools);
+  }
+
   bool Job::runnable() const
   {
     return m_impl->runnable();
@@ -131,6 +136,11 @@ namespace runmanager {
     return m_impl->errors();
   }
 
+  boost::optional<double> Job::peakMemoryMB() const
+  {
+    return m_impl->peakMemoryMB();
+  }
+
   AdvancedStatus Job::status() const
   {
     return m_impl->status();
@@ -32,6 +32,9 @@
 #include "JobErrors.hpp"
 #include "JobType.hpp"
 
+#include <set>
+#include <string>
+
 class QThread;
 
 namespace openstudio {
@@ -166,6 +169,10 @@ namespace detail {
       /// has generated
       JobErrors errors() const;
 
+      /// Return the peak resident memory, in MB, of the processes of the last run of the job,
+      /// if it was measured
+      boost::optional<double> peakMemoryMB() const;
+
       /// Cleanup the output generated by this job
       /// removing any output files that have been created
       void cleanup();
@@ -187,6 +194,10 @@ namespace detail {
       /// \returns true if the job can be run remotely
       bool remoteRunnable() const;
 
+      /// \returns true if the job can be run by a RemoteWorker offering t_workerTools: it needs no other tool
+      ///          and passes no absolute paths outside of its output directory, see RunManager::setRemoteWorkers
+      bool workerRunnable(const std::set<std::string> &t_workerTools) const;
+
       /// \returns details status information about the Job
       AdvancedStatus status() const;
 
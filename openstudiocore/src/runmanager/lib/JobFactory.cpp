@@ -25,6 +25,7 @@
 #include "ExpandObjectsJob.hpp"
 #include "PreviewIESJob.hpp"
 #include "ReadVarsJob.hpp"
+#include "ReadEsoJob.hpp"
 #include "XMLPreprocessorJob.hpp"
 #include "RubyJob.hpp"
 #include "RubyJobUtils.hpp"
@@ -85,6 +86,8 @@ namespace runmanager {
         return createCalculateEconomicsJob(t_tools, t_params, t_files, t_url_search_paths, t_loading, *t_uuid, t_lastRun, t_jobErrors, t_outputFiles);
       case JobType::ReadVars:
         return createReadVarsJob(t_tools, t_params, t_files, t_url_search_paths, t_loading, *t_uuid, t_lastRun, t_jobErrors, t_outputFiles);
+      case JobType::ReadEso:
+        return createReadEsoJob(t_tools, t_params, t_files, t_url_search_paths, t_loading, *t_uuid, t_lastRun, t_jobErrors, t_outputFiles);
       case JobType::PreviewIES:
         return createPreviewIESJob(t_tools, t_params, t_files, t_url_search_paths, t_loading, *t_uuid, t_lastRun, t_jobErrors, t_outputFiles);
       case JobType::Ruby:
@@ -585,6 +588,22 @@ namespace runmanager {
             t_tools, t_params, normalizeURLs(t_files, t_url_search_paths, t_loading, *t_uuid), detail::JobState(t_lastRun, t_jobErrors, t_outputFiles))));
   }
 
+  // Creates a job that reads an ESO or MTR file in process into a column file
+  Job JobFactory::createReadEsoJob(
+      const openstudio::runmanager::Tools &t_tools,
+      const openstudio::runmanager::JobParams &t_params,
+      const openstudio::runmanager::Files &t_files,
+      const std::vector<openstudio::URLSearchPath> &t_url_search_paths,
+      bool t_loading,
+      const boost::optional<openstudio::UUID> &t_uuid,
+      const boost::optional<openstudio::DateTime> &t_lastRun,
+      const JobErrors &t_jobErrors,
+      const openstudio::runmanager::Files &t_outputFiles
+      )
+  {
+    return Job(boost::shared_ptr<detail::Job_Impl>(new detail::ReadEsoJob(*t_uuid, t_tools, t_params, normalizeURLs(t_files, t_url_search_paths, t_loading, *t_uuid), detail::JobState(t_lastRun, t_jobErrors, t_outputFiles))));
+  }
+
   Job JobFactory::createParallelEnergyPlusSplitJob(
       const openstudio::runmanager::Tools &t_tools,
       const openstudio::runmanager::JobParams &t_params,
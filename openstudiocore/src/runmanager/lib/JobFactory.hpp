@@ -194,6 +194,28 @@ namespace runmanager {
           const Files &t_outputFiles = Files()
           );
 
+      /// Create a ReadEsoJob, generic version
+      ///
+      /// \param[in] t_tools Tools to pass in
+      /// \param[in] t_params JobParams to pass in, "variable" children limit the variables read
+      /// \param[in] t_files Files to pass in
+      /// \param[in] t_url_search_paths Vector of paths to search when fixing up URLs in an IDF or OSM
+      /// \param[in] t_loading If true, skip fixing up of URLs, used when loading RunManager database file.
+      /// \param[in] t_uuid Option to specify the UUID of the job.
+      ///
+      /// \sa \ref ReadEsoJobType
+      static Job createReadEsoJob(
+          const openstudio::runmanager::Tools &t_tools,
+          const openstudio::runmanager::JobParams &t_params,
+          const openstudio::runmanager::Files &t_files,
+          const std::vector<openstudio::URLSearchPath> &t_url_search_paths = std::vector<openstudio::URLSearchPath>(),
+          bool t_loading = false,
+          const boost::optional<openstudio::UUID> &t_uuid = createUUID(),
+          const boost::optional<openstudio::DateTime> &t_lastRun = boost::optional<openstudio::DateTime>(),
+          const JobErrors &t_jobErrors = JobErrors(),
+          const Files &t_outputFiles = Files()
+          );
+
       /// Create a ModelToIdfJob, generic version
       ///
       /// \param[in] t_tools Tools to pass in
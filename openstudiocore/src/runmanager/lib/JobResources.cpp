@@ -0,0 +1,514 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include "JobResources.hpp"
+
+#include <QtGlobal>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/thread.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#elif defined(Q_OS_MAC)
+#include <sys/types.h>
+#include <sys/sysctl.h>
+#endif
+
+namespace openstudio {
+namespace runmanager {
+
+  namespace {
+
+    boost::optional<std::string> paramValue(const JobParams &t_params, const std::string &t_key)
+    {
+      if (t_params.has(t_key) && !t_params.get(t_key).children.empty())
+      {
+        return t_params.get(t_key).children[0].value;
+      }
+
+      return boost::none;
+    }
+
+    /// \returns the first whitespace separated word of the file, if it could be read
+    boost::optional<std::string> readWord(const std::string &t_path)
+    {
+      std::ifstream ifs(t_path.c_str());
+      std::string word;
+      if (ifs >> word)
+      {
+        return word;
+      }
+      return boost::none;
+    }
+
+    boost::optional<double> readNumber(const std::string &t_path)
+    {
+      boost::optional<std::string> word = readWord(t_path);
+      if (word)
+      {
+        try {
+          return boost::lexical_cast<double>(*word);
+        } catch (const boost::bad_lexical_cast &) {
+          // "max", ie no limit
+        }
+      }
+      return boost::none;
+    }
+
+#if defined(Q_OS_LINUX)
+    /// \returns the path of this process's cgroup in the hierarchy holding t_controller, as listed
+    ///          in /proc/self/cgroup; an empty t_controller selects the unified cgroup v2 hierarchy
+    boost::optional<std::string> cgroupPath(const std::string &t_controller)
+    {
+      // each line is "<hierarchy id>:<comma separated controllers>:<path>"
+      std::ifstream ifs("/proc/self/cgroup");
+      std::string line;
+      while (std::getline(ifs, line))
+      {
+        std::string::size_type first = line.find(':');
+        std::string::size_type second = (first == std::string::npos) ? std::string::npos : line.find(':', first + 1);
+        if (second == std::string::npos)
+        {
+          continue;
+        }
+
+        std::string controllers = line.substr(first + 1, second - first - 1);
+        if (t_controller.empty())
+        {
+          if (line.substr(0, first) == "0" && controllers.empty())
+          {
+            return line.substr(second + 1);
+          }
+        } else {
+          std::vector<std::string> names;
+          boost::split(names, controllers, boost::is_any_of(","));
+          if (std::find(names.begin(), names.end(), t_controller) != names.end())
+          {
+            return line.substr(second + 1);
+          }
+        }
+      }
+      return boost::none;
+    }
+
+    /// \returns the smallest limit t_read finds in the directory of this process's cgroup under t_root
+    ///          or in any of its ancestors, each of which also constrains the process. The cgroup
+    ///          directory itself is not visible in containers that do not have their own cgroup
+    ///          namespace, in which case the limits found further up, at worst at t_root, are used.
+    boost::optional<double> cgroupLimit(const std::string &t_root, const std::string &t_controller,
+        boost::optional<double> (*t_read)(const std::string &))
+    {
+      boost::optional<std::string> path = cgroupPath(t_controller);
+      if (!path)
+      {
+        return boost::none;
+      }
+
+      std::string relative = boost::trim_right_copy_if(*path, boost::is_any_of("/"));
+      boost::optional<double> result;
+      while (true)
+      {
+        boost::optional<double> limit = t_read(t_root + relative);
+        if (limit && (!result || *limit < *result))
+        {
+          result = limit;
+        }
+
+        std::string::size_type slash = relative.rfind('/');
+        if (slash == std::string::npos)
+        {
+          break;
+        }
+        relative.erase(slash);
+      }
+
+      return result;
+    }
+
+    /// cgroup v2: "<quota> <period>" or "max <period>"
+    boost::optional<double> readCpuMax(const std::string &t_dir)
+    {
+      std::ifstream ifs((t_dir + "/cpu.max").c_str());
+      std::string quota;
+      double period = 0;
+      if (ifs >> quota >> period && quota != "max" && period > 0)
+      {
+        try {
+          return boost::lexical_cast<double>(quota) / period;
+        } catch (const boost::bad_lexical_cast &) {
+        }
+      }
+      return boost::none;
+    }
+
+    /// cgroup v1, a quota of -1 means no limit
+    boost::optional<double> readCfsQuota(const std::string &t_dir)
+    {
+      boost::optional<double> quota = readNumber(t_dir + "/cpu.cfs_quota_us");
+      boost::optional<double> period = readNumber(t_dir + "/cpu.cfs_period_us");
+      if (quota && period && *quota > 0 && *period > 0)
+      {
+        return *quota / *period;
+      }
+      return boost::none;
+    }
+
+    boost::optional<double> readMemoryMax(const std::string &t_dir)
+    {
+      boost::optional<double> limit = readNumber(t_dir + "/memory.max");
+      if (limit && *limit > 0)
+      {
+        return limit;
+      }
+      return boost::none;
+    }
+
+    boost::optional<double> readMemoryLimitInBytes(const std::string &t_dir)
+    {
+      boost::optional<double> limit = readNumber(t_dir + "/memory.limit_in_bytes");
+      if (limit && *limit > 0)
+      {
+        return limit;
+      }
+      return boost::none;
+    }
+
+    boost::optional<double> cgroupCores()
+    {
+      boost::optional<double> quota = cgroupLimit("/sys/fs/cgroup", "", &readCpuMax);
+      if (!quota)
+      {
+        quota = cgroupLimit("/sys/fs/cgroup/cpu", "cpu", &readCfsQuota);
+      }
+      return quota;
+    }
+
+    boost::optional<double> cgroupMemoryMB()
+    {
+      boost::optional<double> limit = cgroupLimit("/sys/fs/cgroup", "", &readMemoryMax);
+      if (!limit)
+      {
+        limit = cgroupLimit("/sys/fs/cgroup/memory", "memory", &readMemoryLimitInBytes);
+      }
+
+      if (limit)
+      {
+        return *limit / (1024 * 1024);
+      }
+
+      return boost::none;
+    }
+
+    double physicalMemoryMB()
+    {
+      std::ifstream ifs("/proc/meminfo");
+      std::string key;
+      double value;
+      std::string unit;
+      while (ifs >> key >> value >> unit)
+      {
+        if (key == "MemTotal:")
+        {
+          return value / 1024; // kB
+        }
+      }
+      return 0;
+    }
+#elif defined(Q_OS_WIN)
+    double physicalMemoryMB()
+    {
+      MEMORYSTATUSEX status;
+      status.dwLength = sizeof(status);
+      if (GlobalMemoryStatusEx(&status))
+      {
+        return static_cast<double>(status.ullTotalPhys) / (1024 * 1024);
+      }
+      return 0;
+    }
+#elif defined(Q_OS_MAC)
+    double physicalMemoryMB()
+    {
+      int64_t memsize = 0;
+      size_t len = sizeof(memsize);
+      if (sysctlbyname("hw.memsize", &memsize, &len, NULL, 0) == 0)
+      {
+        return static_cast<double>(memsize) / (1024 * 1024);
+      }
+      return 0;
+    }
+#else
+    double physicalMemoryMB()
+    {
+      return 0;
+    }
+#endif
+
+  }
+
+  JobResources::JobResources()
+    : cores(1), memoryMB(0), ioClass(JobIOClass::Normal)
+  {
+  }
+
+  JobResources::JobResources(unsigned int t_cores, double t_memoryMB, const JobIOClass &t_ioClass)
+    : cores(t_cores), memoryMB(t_memoryMB), ioClass(t_ioClass)
+  {
+  }
+
+  JobResources JobResources::fromParams(const JobParams &t_params, const JobResources &t_defaults)
+  {
+    JobResources result(t_defaults);
+
+    boost::optional<std::string> cores = paramValue(t_params, "jobCores");
+    if (cores)
+    {
+      try {
+        result.cores = boost::lexical_cast<unsigned int>(*cores);
+      } catch (const boost::bad_lexical_cast &) {
+      }
+    }
+
+    boost::optional<std::string> memoryMB = paramValue(t_params, "jobMemoryMB");
+    if (memoryMB)
+    {
+      try {
+        result.memoryMB = boost::lexical_cast<double>(*memoryMB);
+      } catch (const boost::bad_lexical_cast &) {
+      }
+    }
+
+    boost::optional<std::string> ioClass = paramValue(t_params, "jobIOClass");
+    if (ioClass)
+    {
+      try {
+        result.ioClass = JobIOClass(*ioClass);
+      } catch (const std::exception &) {
+      }
+    }
+
+    return result;
+  }
+
+  JobResources JobResources::defaults(const JobType &t_type)
+  {
+    switch (t_type.value())
+    {
+      case JobType::Workflow:
+      case JobType::Null:
+        return JobResources(0, 0, JobIOClass::Light);
+      case JobType::EnergyPlus:
+        // simulations are bound by the processor, each core runs one; only the short jobs
+        // reading and splitting up their output files are disk heavy
+        return JobResources(1, 1024, JobIOClass::Normal);
+      case JobType::ParallelEnergyPlusSplit:
+      case JobType::ParallelEnergyPlusJoin:
+      case JobType::ReadVars:
+      case JobType::ReadEso:
+        return JobResources(1, 256, JobIOClass::Heavy);
+      case JobType::Ruby:
+      case JobType::UserScript:
+      case JobType::ModelToIdf:
+      case JobType::IdfToModel:
+      case JobType::ModelObjectPerturbation:
+      case JobType::ModelToRad:
+      case JobType::ModelToRadPreProcess:
+      case JobType::EnergyPlusPreProcess:
+      case JobType::Dakota:
+        return JobResources(1, 512, JobIOClass::Normal);
+      default:
+        return JobResources(1, 256, JobIOClass::Normal);
+    }
+  }
+
+  JobParams JobResources::toParams() const
+  {
+    JobParams params;
+    params.append("jobCores", boost::lexical_cast<std::string>(cores));
+    params.append("jobMemoryMB", boost::lexical_cast<std::string>(memoryMB));
+    params.append("jobIOClass", ioClass.valueName());
+    return params;
+  }
+
+  MachineResources::MachineResources(unsigned int t_cores, double t_memoryMB)
+    : cores(t_cores), memoryMB(t_memoryMB)
+  {
+  }
+
+  MachineResources MachineResources::detect()
+  {
+    unsigned int cores = std::max(1u, boost::thread::hardware_concurrency());
+    double memoryMB = physicalMemoryMB();
+
+#if defined(Q_OS_LINUX)
+    boost::optional<double> quota = cgroupCores();
+    if (quota)
+    {
+      cores = std::max(1u, std::min(cores, static_cast<unsigned int>(std::ceil(*quota))));
+    }
+
+    boost::optional<double> limit = cgroupMemoryMB();
+    if (limit && (memoryMB == 0 || *limit < memoryMB))
+    {
+      memoryMB = *limit;
+    }
+#endif
+
+    return MachineResources(cores, memoryMB);
+  }
+
+namespace detail {
+
+  JobResourceHistory::JobResourceHistory()
+  {
+  }
+
+  JobResourceHistory::Entry JobResourceHistory::record(const JobType &t_type, double t_peakMemoryMB)
+  {
+    QMutexLocker l(&m_mutex);
+    Entry &entry = m_entries[t_type.valueName()];
+
+    if (entry.runs == 0 || t_peakMemoryMB >= entry.memoryMB)
+    {
+      entry.memoryMB = t_peakMemoryMB;
+    } else {
+      entry.memoryMB = 0.8 * entry.memoryMB + 0.2 * t_peakMemoryMB;
+    }
+    ++entry.runs;
+
+    return entry;
+  }
+
+  void JobResourceHistory::set(const std::string &t_type, const Entry &t_entry)
+  {
+    QMutexLocker l(&m_mutex);
+    m_entries[t_type] = t_entry;
+  }
+
+  boost::optional<double> JobResourceHistory::memoryMB(const JobType &t_type) const
+  {
+    QMutexLocker l(&m_mutex);
+    std::map<std::string, Entry>::const_iterator itr = m_entries.find(t_type.valueName());
+    if (itr != m_entries.end() && itr->second.runs > 0)
+    {
+      return itr->second.memoryMB;
+    }
+    return boost::none;
+  }
+
+  const double LocalJobScheduler::MemoryFraction = 0.9;
+
+  LocalJobScheduler::LocalJobScheduler(const MachineResources &t_budget, int t_maxJobs)
+    : m_budget(t_budget), m_maxJobs(t_maxJobs), m_running(0), m_cores(0), m_memoryMB(0), m_heavyIO(0),
+      m_blocked(false), m_reservedCores(0), m_reservedMemoryMB(0)
+  {
+  }
+
+  void LocalJobScheduler::addRunning(const JobResources &t_resources)
+  {
+    ++m_running;
+    m_cores += t_resources.cores;
+    m_memoryMB += t_resources.memoryMB;
+    if (t_resources.ioClass == JobIOClass::Heavy)
+    {
+      ++m_heavyIO;
+    }
+  }
+
+  bool LocalJobScheduler::tryStart(const JobResources &t_resources)
+  {
+    if (full())
+    {
+      return false;
+    }
+
+    if (idle() || fits(t_resources))
+    {
+      addRunning(t_resources);
+      return true;
+    }
+
+    if (!m_blocked)
+    {
+      LOG(Debug, "Holding room for a job needing " << t_resources.cores << " cores and " << t_resources.memoryMB << " MB");
+      m_blocked = true;
+      m_reservedCores = t_resources.cores;
+      m_reservedMemoryMB = t_resources.memoryMB;
+    }
+
+    return false;
+  }
+
+  bool LocalJobScheduler::full() const
+  {
+    return m_running >= m_maxJobs;
+  }
+
+  int LocalJobScheduler::running() const
+  {
+    return m_running;
+  }
+
+  bool LocalJobScheduler::idle() const
+  {
+    // workflow and other bookkeeping jobs count towards the job limit but use no resources
+    return m_cores == 0 && m_memoryMB == 0 && m_heavyIO == 0;
+  }
+
+  bool LocalJobScheduler::fits(const JobResources &t_resources) const
+  {
+    if (t_resources.cores == 0 && t_resources.memoryMB == 0 && t_resources.ioClass != JobIOClass::Heavy)
+    {
+      return true;
+    }
+
+    if (m_cores + m_reservedCores + t_resources.cores > m_budget.cores)
+    {
+      return false;
+    }
+
+    if (m_budget.memoryMB > 0 
+        && m_memoryMB + m_reservedMemoryMB + t_resources.memoryMB > m_budget.memoryMB * MemoryFraction)
+    {
+      return false;
+    }
+
+    if (t_resources.ioClass == JobIOClass::Heavy && m_heavyIO >= maxHeavyIO())
+    {
+      return false;
+    }
+
+    return true;
+  }
+
+  unsigned int LocalJobScheduler::maxHeavyIO() const
+  {
+    return std::max(1u, m_budget.cores / 2);
+  }
+
+}
+
+}
+}
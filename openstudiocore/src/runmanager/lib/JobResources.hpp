@@ -0,0 +1,172 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef OPENSTUDIO_RUNMANAGER_JOBRESOURCES_HPP
+#define OPENSTUDIO_RUNMANAGER_JOBRESOURCES_HPP
+
+#include "RunManagerAPI.hpp"
+#include "JobParam.hpp"
+#include "JobType.hpp"
+
+#include <utilities/core/Enum.hpp>
+#include <utilities/core/Logger.hpp>
+
+#include <QMutex>
+
+#include <boost/optional.hpp>
+
+#include <map>
+#include <string>
+
+namespace openstudio {
+namespace runmanager {
+
+  /// How hard a job works the disk, at most a few Heavy jobs are run at once
+  OPENSTUDIO_ENUM(JobIOClass,
+      ((Light))
+      ((Normal))
+      ((Heavy))
+    );
+
+  /// Resources a job needs while it runs, used to decide how many jobs can run side by side on
+  /// the local machine. 
+  ///
+  /// Each job type has defaults, see defaults(). The estimated memory of a job type is replaced
+  /// by what past runs of that type have actually used once the RunManager has seen one, and any
+  /// value can be declared for a particular job through its JobParams:
+  /// - "jobCores" with a child holding the number of cores
+  /// - "jobMemoryMB" with a child holding the estimated peak memory in MB
+  /// - "jobIOClass" with a child holding "Light", "Normal" or "Heavy"
+  struct RUNMANAGER_API JobResources
+  {
+    /// One core, unknown memory, Normal I/O
+    JobResources();
+
+    JobResources(unsigned int t_cores, double t_memoryMB, const JobIOClass &t_ioClass);
+
+    /// \returns the resources declared in t_params, with anything not declared taken from t_defaults
+    static JobResources fromParams(const JobParams &t_params, const JobResources &t_defaults);
+
+    /// \returns the resources assumed for a job of the given type when nothing else is known
+    static JobResources defaults(const JobType &t_type);
+
+    /// \returns the params declaring these resources, to be appended to the params of a job
+    JobParams toParams() const;
+
+    unsigned int cores;
+    double memoryMB; ///< 0 if unknown
+    JobIOClass ioClass;
+  };
+
+  /// The processor and memory budget local jobs are packed into
+  struct RUNMANAGER_API MachineResources
+  {
+    MachineResources(unsigned int t_cores, double t_memoryMB);
+
+    /// \returns the cores and physical memory of this machine, reduced to the cgroup cpu quota and 
+    ///          memory limit of the cgroup this process runs in, or of its ancestors, where those are set
+    static MachineResources detect();
+
+    unsigned int cores;
+    double memoryMB; ///< 0 if unknown, in which case memory does not limit the number of jobs
+  };
+
+namespace detail {
+
+  /// Peak memory of past runs, by job type. Rises immediately to a larger observation and
+  /// drifts down slowly as smaller ones come in. Thread safe.
+  class RUNMANAGER_API JobResourceHistory
+  {
+    public:
+      struct Entry
+      {
+        Entry() : runs(0), memoryMB(0) {}
+
+        int runs;
+        double memoryMB;
+      };
+
+      JobResourceHistory();
+
+      /// Records the peak memory of a run
+      /// \returns the updated entry for the job type
+      Entry record(const JobType &t_type, double t_peakMemoryMB);
+
+      /// Sets the entry for a job type, as loaded from the RunManager database
+      void set(const std::string &t_type, const Entry &t_entry);
+
+      /// \returns the learned peak memory of the job type, if any run of it has been recorded
+      boost::optional<double> memoryMB(const JobType &t_type) const;
+
+    private:
+      mutable QMutex m_mutex;
+      std::map<std::string, Entry> m_entries;
+  };
+
+  /// Decides, one queue pass at a time, which runnable jobs fit on the local machine alongside
+  /// the jobs already running. Jobs are never held back when nothing that uses resources is
+  /// running, so a job that asks for more than the machine has still runs, alone. The first job
+  /// that does not fit reserves its resources for the rest of the pass so that smaller jobs further
+  /// down the queue can only fill the room it leaves, rather than starving it.
+  class RUNMANAGER_API LocalJobScheduler
+  {
+    public:
+      /// \param[in] t_budget resources of the machine
+      /// \param[in] t_maxJobs upper bound on the number of local jobs, regardless of resources
+      LocalJobScheduler(const MachineResources &t_budget, int t_maxJobs);
+
+      /// Accounts for a job that is already running
+      void addRunning(const JobResources &t_resources);
+
+      /// \returns true, and accounts for the job, if a job with the given resources can start now
+      bool tryStart(const JobResources &t_resources);
+
+      /// \returns true if the job count limit has been reached
+      bool full() const;
+
+      /// \returns the number of jobs accounted for
+      int running() const;
+
+      /// Fraction of machine memory jobs are packed into, the rest is left to the system
+      static const double MemoryFraction;
+
+    private:
+      REGISTER_LOGGER("openstudio.runmanager.LocalJobScheduler");
+
+      bool idle() const;
+      bool fits(const JobResources &t_resources) const;
+      unsigned int maxHeavyIO() const;
+
+      MachineResources m_budget;
+      int m_maxJobs;
+      int m_running;
+      unsigned int m_cores;
+      double m_memoryMB;
+      unsigned int m_heavyIO;
+      bool m_blocked;
+      unsigned int m_reservedCores;
+      double m_reservedMemoryMB;
+  };
+
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,362 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include "JobStateJournal.hpp"
+
+#include <QDataStream>
+#include <QMutexLocker>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <cstring>
+#include <set>
+
+namespace openstudio {
+namespace runmanager {
+namespace detail {
+
+  namespace {
+    const char journalMagic[] = "OSRMJRNL";
+    const quint32 journalVersion = 1;
+
+    void writeHeader(QDataStream &t_stream)
+    {
+      t_stream.writeRawData(journalMagic, 8);
+      t_stream << journalVersion;
+    }
+
+    void writeFrame(QDataStream &t_stream, const QByteArray &t_bytes)
+    {
+      t_stream << quint32(t_bytes.size());
+      t_stream << quint16(qChecksum(t_bytes.constData(), t_bytes.size()));
+      t_stream.writeRawData(t_bytes.constData(), t_bytes.size());
+    }
+  }
+
+  JobStateJournal::JobStateJournal(const openstudio::path &t_path)
+    : m_path(t_path), m_file(toQString(t_path)), m_nextSequence(1)
+  {
+    load();
+  }
+
+  JobStateJournal::~JobStateJournal()
+  {
+    m_file.close();
+  }
+
+  openstudio::path JobStateJournal::path() const
+  {
+    return m_path;
+  }
+
+  void JobStateJournal::addJobs(const QVariantList &t_jobs)
+  {
+    if (t_jobs.empty()) return;
+
+    QMutexLocker l(&m_mutex);
+    add(Record::PersistJobs, openstudio::UUID(), t_jobs);
+    append(m_entries.back().bytes);
+  }
+
+  void JobStateJournal::addStatus(const openstudio::UUID &t_uuid, const QVariantMap &t_status)
+  {
+    QVariantMap status(t_status);
+    status["uuid"] = t_uuid.toString();
+
+    QMutexLocker l(&m_mutex);
+    add(Record::PersistStatus, t_uuid, status);
+    append(m_entries.back().bytes);
+  }
+
+  void JobStateJournal::addDeletes(const std::vector<openstudio::UUID> &t_uuids)
+  {
+    if (t_uuids.empty()) return;
+
+    QVariantList uuids;
+    for (std::vector<openstudio::UUID>::const_iterator itr = t_uuids.begin();
+         itr != t_uuids.end();
+         ++itr)
+    {
+      uuids.push_back(itr->toString());
+    }
+
+    QMutexLocker l(&m_mutex);
+    add(Record::DeleteJobs, openstudio::UUID(), uuids);
+    append(m_entries.back().bytes);
+  }
+
+  void JobStateJournal::addResourceUsage(const QVariantMap &t_usage)
+  {
+    QMutexLocker l(&m_mutex);
+    add(Record::PersistResourceUsage, openstudio::UUID(), t_usage);
+    append(m_entries.back().bytes);
+  }
+
+  bool JobStateJournal::empty() const
+  {
+    QMutexLocker l(&m_mutex);
+    return m_entries.empty();
+  }
+
+  size_t JobStateJournal::size() const
+  {
+    QMutexLocker l(&m_mutex);
+    return m_entries.size();
+  }
+
+  std::vector<JobStateJournal::Record> JobStateJournal::pending() const
+  {
+    QMutexLocker l(&m_mutex);
+    std::vector<Record> records;
+    records.reserve(m_entries.size());
+
+    for (std::deque<Entry>::const_iterator itr = m_entries.begin();
+         itr != m_entries.end();
+         ++itr)
+    {
+      records.push_back(itr->record);
+    }
+
+    return records;
+  }
+
+  void JobStateJournal::committed(unsigned long t_sequence)
+  {
+    QMutexLocker l(&m_mutex);
+
+    // records are kept in sequence order, coalescing only ever removes them
+    while (!m_entries.empty() && m_entries.front().record.sequence <= t_sequence)
+    {
+      m_entries.pop_front();
+    }
+
+    rewrite();
+  }
+
+  void JobStateJournal::add(Record::Type t_type, const openstudio::UUID &t_uuid, const QVariant &t_data)
+  {
+    if (t_type == Record::PersistStatus)
+    {
+      for (std::deque<Entry>::iterator itr = m_entries.begin();
+           itr != m_entries.end();
+           ++itr)
+      {
+        if (itr->record.type == Record::PersistStatus && itr->record.uuid == t_uuid)
+        {
+          m_entries.erase(itr);
+          break;
+        }
+      }
+    } else if (t_type == Record::DeleteJobs) {
+      QVariantList uuids = t_data.toList();
+      std::set<openstudio::UUID> deleted;
+      for (QVariantList::const_iterator itr = uuids.begin();
+           itr != uuids.end();
+           ++itr)
+      {
+        deleted.insert(openstudio::UUID(itr->toString()));
+      }
+
+      std::deque<Entry>::iterator itr = m_entries.begin();
+      while (itr != m_entries.end())
+      {
+        if (itr->record.type == Record::PersistStatus && deleted.count(itr->record.uuid))
+        {
+          itr = m_entries.erase(itr);
+        } else {
+          ++itr;
+        }
+      }
+    }
+
+    Entry entry;
+    entry.record.type = t_type;
+    entry.record.sequence = m_nextSequence++;
+    entry.record.uuid = t_uuid;
+    entry.record.data = t_data;
+    entry.bytes = serialize(t_type, t_data);
+    m_entries.push_back(entry);
+  }
+
+  QByteArray JobStateJournal::serialize(Record::Type t_type, const QVariant &t_data)
+  {
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_4_6);
+    stream << quint8(t_type) << t_data;
+    return bytes;
+  }
+
+  bool JobStateJournal::openForAppend()
+  {
+    if (m_file.isOpen()) return true;
+
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append))
+    {
+      LOG(Error, "Unable to open job state journal " << toString(m_path) << ": " << toString(m_file.errorString()));
+      return false;
+    }
+
+    if (m_file.size() == 0)
+    {
+      QDataStream stream(&m_file);
+      stream.setVersion(QDataStream::Qt_4_6);
+      writeHeader(stream);
+    }
+
+    return true;
+  }
+
+  void JobStateJournal::append(const QByteArray &t_bytes)
+  {
+    if (!openForAppend()) return;
+
+    QDataStream stream(&m_file);
+    stream.setVersion(QDataStream::Qt_4_6);
+    writeFrame(stream, t_bytes);
+    m_file.flush();
+  }
+
+  void JobStateJournal::rewrite()
+  {
+    m_file.close();
+
+    if (m_entries.empty())
+    {
+      QFile::remove(toQString(m_path));
+      return;
+    }
+
+    // write the remaining records next to the journal and swap it in, so that a crash part
+    // way through leaves the previous journal intact
+    openstudio::path tmpPath = toPath(toString(m_path) + ".tmp");
+    QFile tmp(toQString(tmpPath));
+    if (!tmp.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+      LOG(Error, "Unable to rewrite job state journal " << toString(m_path) << ": " << toString(tmp.errorString()));
+      return;
+    }
+
+    {
+      QDataStream stream(&tmp);
+      stream.setVersion(QDataStream::Qt_4_6);
+      writeHeader(stream);
+
+      for (std::deque<Entry>::const_iterator itr = m_entries.begin();
+           itr != m_entries.end();
+           ++itr)
+      {
+        writeFrame(stream, itr->bytes);
+      }
+    }
+
+    tmp.close();
+
+    try {
+      boost::filesystem::rename(tmpPath, m_path);
+    } catch (const std::exception &e) {
+      LOG(Error, "Unable to replace job state journal " << toString(m_path) << ": " << e.what());
+    }
+  }
+
+  void JobStateJournal::load()
+  {
+    QMutexLocker l(&m_mutex);
+
+    if (!m_file.exists()) return;
+
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+      LOG(Error, "Unable to read job state journal " << toString(m_path) << ": " << toString(m_file.errorString()));
+      return;
+    }
+
+    QByteArray contents = m_file.readAll();
+    m_file.close();
+
+    QDataStream stream(contents);
+    stream.setVersion(QDataStream::Qt_4_6);
+
+    char magic[8];
+    quint32 version = 0;
+    if (stream.readRawData(magic, 8) != 8 || memcmp(magic, journalMagic, 8) != 0)
+    {
+      LOG(Error, "Ignoring unrecognized job state journal " << toString(m_path));
+      rewrite();
+      return;
+    }
+
+    stream >> version;
+    if (version != journalVersion)
+    {
+      LOG(Error, "Ignoring job state journal " << toString(m_path) << " with unsupported version " << version);
+      rewrite();
+      return;
+    }
+
+    while (!stream.atEnd())
+    {
+      quint32 size = 0;
+      quint16 checksum = 0;
+      stream >> size >> checksum;
+
+      if (stream.status() != QDataStream::Ok || size > static_cast<quint32>(contents.size()))
+      {
+        LOG(Warn, "Discarding truncated record at the end of job state journal " << toString(m_path));
+        break;
+      }
+
+      QByteArray bytes(size, '\0');
+      if (stream.readRawData(bytes.data(), size) != static_cast<int>(size)
+          || qChecksum(bytes.constData(), bytes.size()) != checksum)
+      {
+        LOG(Warn, "Discarding incomplete record at the end of job state journal " << toString(m_path));
+        break;
+      }
+
+      QDataStream recordStream(bytes);
+      recordStream.setVersion(QDataStream::Qt_4_6);
+      quint8 type = 0;
+      QVariant data;
+      recordStream >> type >> data;
+
+      if (recordStream.status() != QDataStream::Ok || type > Record::PersistResourceUsage)
+      {
+        LOG(Warn, "Discarding unreadable record in job state journal " << toString(m_path));
+        continue;
+      }
+
+      openstudio::UUID uuid;
+      if (type == Record::PersistStatus)
+      {
+        uuid = openstudio::UUID(data.toMap()["uuid"].toString());
+      }
+
+      add(static_cast<Record::Type>(type), uuid, data);
+    }
+
+    LOG(Info, "Loaded " << m_entries.size() << " uncommitted records from job state journal " << toString(m_path));
+
+    // drop anything that could not be read and coalesced records
+    rewrite();
+  }
+
+}
+}
+}
@@ -0,0 +1,130 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef OPENSTUDIO_RUNMANAGER_LIB_JOBSTATEJOURNAL_HPP
+#define OPENSTUDIO_RUNMANAGER_LIB_JOBSTATEJOURNAL_HPP
+
+#include "RunManagerAPI.hpp"
+
+#include <utilities/core/Logger.hpp>
+#include <utilities/core/Path.hpp>
+#include <utilities/core/UUID.hpp>
+
+#include <QByteArray>
+#include <QFile>
+#include <QMutex>
+#include <QVariant>
+
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <vector>
+
+namespace openstudio {
+namespace runmanager {
+namespace detail {
+
+  /// Write-behind journal of job state changes that have not yet been committed to the
+  /// RunManager database.
+  ///
+  /// Every change is appended to a file on disk before it is queued, so changes that were
+  /// still pending when the process exited are loaded again (and can be replayed) the next
+  /// time the journal is opened. Pending status updates for the same job are coalesced, only
+  /// the newest one is kept. The journal file is removed once all records are committed.
+  class RUNMANAGER_API JobStateJournal : private boost::noncopyable
+  {
+    public:
+      /// A single journaled change
+      struct Record
+      {
+        enum Type
+        {
+          PersistJobs,   ///< data is a QVariantList of job rows to insert
+          PersistStatus, ///< data is a QVariantMap holding the status of job uuid
+          DeleteJobs,    ///< data is a QVariantList of job uuid strings
+          PersistResourceUsage ///< data is a QVariantMap holding the learned resource usage of a job type
+        };
+
+        Type type;
+        unsigned long sequence;
+        openstudio::UUID uuid;
+        QVariant data;
+      };
+
+      /// Opens the journal at t_path, loading any records left behind by a previous session
+      explicit JobStateJournal(const openstudio::path &t_path);
+      ~JobStateJournal();
+
+      /// \returns the path of the journal file
+      openstudio::path path() const;
+
+      /// Journals the rows of one or more job trees to be persisted
+      void addJobs(const QVariantList &t_jobs);
+
+      /// Journals the status of a job, replacing any status still pending for the same job
+      void addStatus(const openstudio::UUID &t_uuid, const QVariantMap &t_status);
+
+      /// Journals the deletion of jobs, dropping any status still pending for them
+      void addDeletes(const std::vector<openstudio::UUID> &t_uuids);
+
+      /// Journals the learned resource usage of a job type
+      void addResourceUsage(const QVariantMap &t_usage);
+
+      /// \returns true if no records are waiting to be committed
+      bool empty() const;
+
+      /// \returns the number of records waiting to be committed
+      size_t size() const;
+
+      /// \returns the records waiting to be committed, oldest first
+      std::vector<Record> pending() const;
+
+      /// Drops all records up to and including t_sequence, which have been committed to the
+      /// database, and rewrites the journal file with the records added since
+      void committed(unsigned long t_sequence);
+
+    private:
+      REGISTER_LOGGER("openstudio.runmanager.JobStateJournal");
+
+      struct Entry
+      {
+        Record record;
+        QByteArray bytes; ///< serialized form of record, as written to the journal file
+      };
+
+      void load();
+      void add(Record::Type t_type, const openstudio::UUID &t_uuid, const QVariant &t_data);
+      void append(const QByteArray &t_bytes);
+      void rewrite();
+      bool openForAppend();
+
+      static QByteArray serialize(Record::Type t_type, const QVariant &t_data);
+
+      mutable QMutex m_mutex;
+      openstudio::path m_path;
+      QFile m_file;
+      std::deque<Entry> m_entries;
+      unsigned long m_nextSequence;
+  };
+
+}
+}
+}
+
+#endif // OPENSTUDIO_RUNMANAGER_LIB_JOBSTATEJOURNAL_HPP
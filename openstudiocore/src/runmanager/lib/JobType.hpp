@@ -30,6 +30,7 @@ namespace runmanager {
       ((ModelToRadPreProcess))
       ((Dakota))
       ((UserScript))
+      ((ReadEso))
     );
 
 }
@@ -230,6 +230,7 @@ namespace detail {
     QWriteLocker l(&m_mutex);
     m_hasRunSinceLoading = true;
     m_lastRun = QDateTime::currentDateTime();
+    m_peakMemoryMB.reset();
     if (m_lastStartTime)
     {
       LOG(Info, "Starting previously run job: " << toString(m_id) << " index: " << m_index);
@@ -1169,6 +1170,21 @@ namespace detail {
     m_errors = t_e;
   }
 
+  boost::optional<double> Job_Impl::peakMemoryMB() const
+  {
+    QReadLocker l(&m_mutex);
+    return m_peakMemoryMB;
+  }
+
+  void Job_Impl::notePeakMemoryMB(double t_memoryMB)
+  {
+    QWriteLocker l(&m_mutex);
+    if (!m_peakMemoryMB || t_memoryMB > *m_peakMemoryMB)
+    {
+      m_peakMemoryMB = t_memoryMB;
+    }
+  }
+
   void Job_Impl::emitStarted()
   {
     QWriteLocker l(&m_mutex);
@@ -35,6 +35,8 @@
 #include <QReadWriteLock>
 #include <QDateTime>
 
+#include <set>
+
 Q_DECLARE_METATYPE(QProcess::ExitStatus);
 Q_DECLARE_METATYPE(QProcess::ProcessError);
 
@@ -117,6 +119,13 @@ namespace detail {
       /// Return true if the job can be run remotely
       virtual bool remoteRunnable() const = 0;
 
+      /// Return true if the job can be run by a RemoteWorker offering t_workerTools, only jobs that
+      /// run all of their work through tools can
+      virtual bool workerRunnable(const std::set<std::string> &/*t_workerTools*/) const
+      {
+        return false;
+      }
+
       /// Return true if the job is running remotely
       bool runningRemotely() const;
 
@@ -174,6 +183,10 @@ namespace detail {
       /// Returns the last set of generated errors/warnings from the Job execution
       JobErrors errors() const;
 
+      /// Returns the peak resident memory, in MB, of the processes of the current or last run
+      /// of the job, if it was measured
+      boost::optional<double> peakMemoryMB() const;
+
       /// Remove all output files generated by the job
       virtual void cleanup() = 0;
 
@@ -348,6 +361,9 @@ namespace detail {
       /// Update the errors object
       void setErrors(const JobErrors &t_e);
 
+      /// Raise the peak memory of this run to t_memoryMB if it is larger
+      void notePeakMemoryMB(double t_memoryMB);
+
       /// Emits the started() signal
       void emitStarted();
 
@@ -509,6 +525,8 @@ namespace detail {
 
       boost::optional<QDateTime> m_lastRun;
 
+      boost::optional<double> m_peakMemoryMB;
+
       std::vector<std::pair<boost::posix_time::ptime, AdvancedStatus> > m_history;
 
       openstudio::path m_basePath; //< Path from which relative paths in this job will be evaluated
@@ -18,25 +18,31 @@
 **********************************************************************/
 
 #include <cstring>
+#include <fstream>
 #include <sstream>
 #include <iterator>
 #include <algorithm>
 
 #include "LocalProcess.hpp"
+#include "RubyWorkerPool.hpp"
 #include "FileInfo.hpp"
 #include "JobOutputCleanup.hpp"
 #include "RunManager_Util.hpp"
 
 #include <utilities/time/DateTime.hpp>
 #include <utilities/core/ApplicationPathHelpers.hpp>
+#include <utilities/core/UUID.hpp>
 
 #include <QDir>
 #include <QDateTime>
 
 #include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/algorithm/string.hpp>
 
 #ifdef Q_WS_WIN
 #include <Windows.h>
+#include <Psapi.h>
 #else
 #include <signal.h>
 #endif
@@ -52,11 +58,16 @@ namespace detail {
           const openstudio::path &t_outdir,
           const std::vector<openstudio::path> &t_expectedOutputFiles,
           const std::string &t_stdin,
-          const openstudio::path &t_basePath)
+          const openstudio::path &t_basePath,
+          const boost::shared_ptr<RubyWorkerPool> &t_rubyWorkerPool)
     : m_tool(t_tool), m_requiredFiles(t_requiredFiles),
       m_parameters(t_parameters), m_outdir(t_outdir),
       m_expectedOutputFiles(t_expectedOutputFiles),
-      m_stdin(t_stdin)
+      m_stdin(t_stdin),
+      m_rubyWorkerPool(t_rubyWorkerPool),
+      m_rubyWorkerRunning(false),
+      m_rubyWorkerStdOutPos(0),
+      m_rubyWorkerStdErrPos(0)
   {
     LOG(Info, "Creating LocalProcess");
 
@@ -150,6 +161,15 @@ namespace detail {
          this, SLOT(processStateChanged(QProcess::ProcessState)));
 */
 
+    if (m_rubyWorkerPool)
+    {
+      // queued, the pool emits from its own thread
+      connect(m_rubyWorkerPool.get(), SIGNAL(requestStarted(int)),
+          this, SLOT(rubyWorkerRequestStarted(int)), Qt::QueuedConnection);
+      connect(m_rubyWorkerPool.get(), SIGNAL(requestFinished(int, int, bool, const std::string &)),
+          this, SLOT(rubyWorkerRequestFinished(int, int, bool, const std::string &)), Qt::QueuedConnection);
+    }
+
     LOG(Debug, "Setting working directory: " << toString(m_outdir));
     m_process.setWorkingDirectory(openstudio::toQString(m_outdir));
 
@@ -160,6 +180,12 @@ namespace detail {
   void LocalProcess::directoryChanged()
   {
     directoryChanged(openstudio::toQString(m_outdir));
+    sampleMemory();
+
+    if (m_rubyWorkerRunning)
+    {
+      readRubyWorkerOutput();
+    }
   }
 
   void LocalProcess::start()
@@ -203,12 +229,36 @@ namespace detail {
 
     m_process.setProcessEnvironment(env);
 
+    if (m_rubyWorkerPool)
+    {
+      // the script output is captured outside of m_outdir so it is not mistaken for an output file
+      std::string capture = "rubyworker-" + openstudio::toString(createUUID());
+      m_rubyWorkerStdOut = openstudio::toPath(QDir::tempPath()) / openstudio::toPath(capture + ".stdout");
+      m_rubyWorkerStdErr = openstudio::toPath(QDir::tempPath()) / openstudio::toPath(capture + ".stderr");
+
+      m_rubyWorkerRunning = true;
+      m_rubyWorkerRequest = m_rubyWorkerPool->submit(m_tool.localBinPath, m_parameters, m_outdir, 
+          m_rubyWorkerStdOut, m_rubyWorkerStdErr);
+      return;
+    }
    
     m_process.start(openstudio::toQString(m_tool.localBinPath), list, QIODevice::ReadWrite);
   }
 
   LocalProcess::~LocalProcess()
   {
+    if (m_rubyWorkerPool)
+    {
+      m_rubyWorkerPool->disconnect(this);
+      if (m_rubyWorkerRunning)
+      {
+        m_rubyWorkerPool->cancel(*m_rubyWorkerRequest);
+        m_rubyWorkerPool->waitForRequest(*m_rubyWorkerRequest);
+      }
+      QFile::remove(toQString(m_rubyWorkerStdOut));
+      QFile::remove(toQString(m_rubyWorkerStdErr));
+    }
+
     m_process.disconnect();
     kill(m_process, true);
     m_process.waitForFinished();
@@ -217,6 +267,11 @@ namespace detail {
 
   void LocalProcess::stopImpl()
   {
+    if (m_rubyWorkerRunning)
+    {
+      m_rubyWorkerPool->cancel(*m_rubyWorkerRequest);
+    }
+
     kill(m_process, true);
 
 //    if (!m_process.waitForFinished(100))
@@ -305,6 +360,11 @@ namespace detail {
 
   void LocalProcess::waitForFinished()
   {
+    if (m_rubyWorkerRequest)
+    {
+      m_rubyWorkerPool->waitForRequest(*m_rubyWorkerRequest);
+    }
+
     m_process.waitForFinished(-1);
   }
 
@@ -488,10 +548,118 @@ namespace detail {
 
   bool LocalProcess::running() const
   {
-    return m_process.state() == QProcess::Running
+    return m_rubyWorkerRunning
+      || m_process.state() == QProcess::Running
       || m_process.state() == QProcess::Starting;
   }
 
+  boost::optional<double> LocalProcess::peakMemoryMB() const
+  {
+    return m_peakMemoryMB;
+  }
+
+  void LocalProcess::sampleMemory()
+  {
+    if (m_process.state() != QProcess::Running)
+    {
+      return;
+    }
+
+    boost::optional<double> peak;
+
+#ifdef Q_WS_WIN
+    PROCESS_INFORMATION *pinfo = (PROCESS_INFORMATION*)m_process.pid();
+    PROCESS_MEMORY_COUNTERS counters;
+    if (pinfo && GetProcessMemoryInfo(pinfo->hProcess, &counters, sizeof(counters)))
+    {
+      peak = static_cast<double>(counters.PeakWorkingSetSize) / (1024 * 1024);
+    }
+#elif defined(Q_OS_LINUX)
+    // VmHWM is the peak resident set size, in kB
+    std::ifstream ifs(("/proc/" + boost::lexical_cast<std::string>(m_process.pid()) + "/status").c_str());
+    std::string line;
+    while (std::getline(ifs, line))
+    {
+      if (boost::starts_with(line, "VmHWM:"))
+      {
+        std::istringstream iss(line.substr(6));
+        double kb = 0;
+        if (iss >> kb)
+        {
+          peak = kb / 1024;
+        }
+        break;
+      }
+    }
+#endif
+
+    if (peak && (!m_peakMemoryMB || *peak > *m_peakMemoryMB))
+    {
+      m_peakMemoryMB = peak;
+    }
+  }
+
+  void LocalProcess::readRubyWorkerOutput()
+  {
+    if (stopped())
+    {
+      return;
+    }
+
+    QFile out(toQString(m_rubyWorkerStdOut));
+    if (out.open(QIODevice::ReadOnly) && out.seek(m_rubyWorkerStdOutPos))
+    {
+      QByteArray data = out.readAll();
+      m_rubyWorkerStdOutPos += data.size();
+      if (!data.isEmpty())
+      {
+        handleOutput(data, false);
+      }
+    }
+
+    QFile err(toQString(m_rubyWorkerStdErr));
+    if (err.open(QIODevice::ReadOnly) && err.seek(m_rubyWorkerStdErrPos))
+    {
+      QByteArray data = err.readAll();
+      m_rubyWorkerStdErrPos += data.size();
+      if (!data.isEmpty())
+      {
+        handleOutput(data, true);
+      }
+    }
+  }
+
+  void LocalProcess::rubyWorkerRequestStarted(int t_id)
+  {
+    if (m_rubyWorkerRequest && *m_rubyWorkerRequest == t_id)
+    {
+      processStarted();
+    }
+  }
+
+  void LocalProcess::rubyWorkerRequestFinished(int t_id, int t_exitCode, bool t_crashed, const std::string &t_description)
+  {
+    if (!m_rubyWorkerRequest || *m_rubyWorkerRequest != t_id)
+    {
+      return;
+    }
+
+    readRubyWorkerOutput();
+    m_rubyWorkerRunning = false;
+    QFile::remove(toQString(m_rubyWorkerStdOut));
+    QFile::remove(toQString(m_rubyWorkerStdErr));
+
+    // the same sequence of signals a crashed QProcess produces
+    if (t_crashed)
+    {
+      m_fileCheckTimer.stop();
+      LOG(Error, "LocalProcess ruby worker request failed: " << t_description);
+      emit error(QProcess::Crashed, t_description);
+    }
+
+    processFinished(t_crashed ? 0 : t_exitCode, t_crashed ? QProcess::CrashExit : QProcess::NormalExit);
+  }
+
 
 } // detail
 } // runmanager
@@ -21,6 +21,8 @@
 #define OPENSTUDIO_LOCALPROCESS_HPP__
 
 #include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
 #include <string>
 #include <utilities/core/Logger.hpp>
 #include <utilities/core/Path.hpp>
@@ -37,6 +39,8 @@ namespace openstudio {
 namespace runmanager {
 namespace detail {
 
+  class RubyWorkerPool;
+
   /**
    * A utility class for creating a Process object that runs on the local system
    * \sa openstudio::runmanager::detail::Process for details on what a Process performs
@@ -55,6 +59,8 @@ namespace detail {
       /// \param[in] t_stdin Input to send to the process over stdin after it has started
       /// \param[in] t_basePath Base path from which required files should be evaluated if the required file
       ///                       is a relative path and does not reside in the tool path
+      /// \param[in] t_rubyWorkerPool If set, the tool is run by a worker of this pool instead of a
+      ///                             QProcess of its own. \sa RubyWorkerPool::accepts
       LocalProcess(
           const openstudio::runmanager::ToolInfo &t_tool,
           const std::vector<std::pair<openstudio::path, openstudio::path> > &t_requiredFiles,
@@ -62,7 +68,8 @@ namespace detail {
           const openstudio::path &t_outdir,
           const std::vector<openstudio::path> &t_expectedOutputFiles,
           const std::string &t_stdin,
-          const openstudio::path &t_basePath);
+          const openstudio::path &t_basePath,
+          const boost::shared_ptr<RubyWorkerPool> &t_rubyWorkerPool = boost::shared_ptr<RubyWorkerPool>());
 
       virtual ~LocalProcess();
 
@@ -72,7 +79,9 @@ namespace detail {
       virtual void cleanup(const std::vector<std::string> &t_files);
       virtual std::vector<FileInfo> outputFiles() const;
       virtual std::vector<FileInfo> inputFiles() const;
+      virtual boost::optional<double> peakMemoryMB() const;
 
+      static void kill(QProcess &t_process, bool t_force); //< Does an appropriate process tree kill on Windows
 
     protected:
       virtual void stopImpl();
@@ -110,7 +119,11 @@ namespace detail {
         }
       }
 
-      static void kill(QProcess &t_process, bool t_force); //< Does an appropriate process tree kill on Windows
+      /// Updates m_peakMemoryMB from the operating system's figure for the running process
+      void sampleMemory();
+
+      /// Emit whatever the ruby worker has added to the captured stdout and stderr since the last call
+      void readRubyWorkerOutput();
 
       QTimer m_fileCheckTimer;
 
@@ -134,6 +147,16 @@ namespace detail {
       /// Set of files that have been copied into place because they were required and can be deleted after the process has completed
       std::set<openstudio::path> m_copiedRequiredFiles; 
 
+      boost::shared_ptr<RubyWorkerPool> m_rubyWorkerPool; //< Pool running the tool, if any
+      boost::optional<int> m_rubyWorkerRequest; //< Id of the request submitted to m_rubyWorkerPool
+      bool m_rubyWorkerRunning;
+      openstudio::path m_rubyWorkerStdOut; //< Files the worker writes the output of the script to
+      openstudio::path m_rubyWorkerStdErr;
+      qint64 m_rubyWorkerStdOutPos; //< Bytes of the captured output already emitted
+      qint64 m_rubyWorkerStdErrPos;
+
+      boost::optional<double> m_peakMemoryMB; //< Peak resident memory seen while sampling
+
     private slots:
       /// connected to QProcess::error
       void processError(QProcess::ProcessError t_e);
@@ -161,6 +184,12 @@ namespace detail {
 
       void emitUpdatedFileInfo(const FileInfo &fi);
 
+      /// connected to RubyWorkerPool::requestStarted
+      void rubyWorkerRequestStarted(int t_id);
+
+      /// connected to RubyWorkerPool::requestFinished
+      void rubyWorkerRequestFinished(int t_id, int t_exitCode, bool t_crashed, const std::string &t_description);
+
   }; 
 
 }
@@ -1,11 +1,13 @@
 
 #include "LocalProcessCreator.hpp"
 #include "LocalProcess.hpp"
+#include "RubyWorkerPool.hpp"
 
 namespace openstudio {
 namespace runmanager {
 
-  LocalProcessCreator::LocalProcessCreator()
+  LocalProcessCreator::LocalProcessCreator(const boost::shared_ptr<detail::RubyWorkerPool> &t_rubyWorkerPool)
+    : m_rubyWorkerPool(t_rubyWorkerPool)
   {
   }
 
@@ -21,6 +23,12 @@ namespace runmanager {
   {
     if (t_remoteId) { throw std::runtime_error("remote id set when creating local process"); }
 
+    boost::shared_ptr<detail::RubyWorkerPool> pool;
+    if (m_rubyWorkerPool && m_rubyWorkerPool->accepts(t_tool, t_parameters, t_stdin))
+    {
+      pool = m_rubyWorkerPool;
+    }
+
     return boost::shared_ptr<Process>(
         new detail::LocalProcess(
           t_tool,
@@ -29,7 +37,8 @@ namespace runmanager {
           t_outdir,
           t_expectedOutputFiles,
           t_stdin,
-          t_basePath));
+          t_basePath,
+          pool));
   }
 
 
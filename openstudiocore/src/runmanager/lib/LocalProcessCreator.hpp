@@ -10,6 +10,9 @@
 namespace openstudio {
 namespace runmanager {
 
+  namespace detail {
+    class RubyWorkerPool;
+  }
 
   /// Implements ProcessCreator interface to create a process locally.
   ///
@@ -19,7 +22,8 @@ namespace runmanager {
     Q_OBJECT;
 
     public:
-      LocalProcessCreator();
+      /// \param[in] t_rubyWorkerPool Pool used for the ruby processes it accepts, if set
+      LocalProcessCreator(const boost::shared_ptr<detail::RubyWorkerPool> &t_rubyWorkerPool = boost::shared_ptr<detail::RubyWorkerPool>());
 
       /// Creates a local process
       /// \param[in] t_tool The tool to execute locally
@@ -48,6 +52,9 @@ namespace runmanager {
         return false;
       }
 
+    private:
+      boost::shared_ptr<detail::RubyWorkerPool> m_rubyWorkerPool;
+
   };
 
 }
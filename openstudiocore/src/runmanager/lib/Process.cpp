@@ -27,6 +27,11 @@ namespace runmanager {
     return m_status;
   }
 
+  boost::optional<double> Process::peakMemoryMB() const
+  {
+    return boost::none;
+  }
+
   void Process::stop()
   {
     m_stopped = true;
@@ -5,6 +5,7 @@
 #include "FileInfo.hpp"
 #include "AdvancedStatus.hpp"
 #include <QProcess>
+#include <boost/optional.hpp>
 
 namespace openstudio {
 namespace runmanager {
@@ -39,6 +40,9 @@ namespace runmanager {
       /// \returns the current status of the Process
       openstudio::runmanager::AdvancedStatus status() const;
 
+      /// \returns the peak resident memory of the process in MB, if it has been measured
+      virtual boost::optional<double> peakMemoryMB() const;
+
       /// \returns True if stop() has been called;
       bool stopped() const;
 
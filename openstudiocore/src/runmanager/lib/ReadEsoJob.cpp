@@ -0,0 +1,221 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include "ReadEsoJob.hpp"
+#include "FileInfo.hpp"
+#include "RunManager_Util.hpp"
+
+#include <energyplus/EsoFile.hpp>
+
+#include <utilities/time/DateTime.hpp>
+
+namespace openstudio {
+namespace runmanager {
+namespace detail {
+
+  ReadEsoJob::ReadEsoJob(const UUID &t_uuid,
+          const Tools &tools,
+          const JobParams &params,
+          const Files &files,
+          const JobState &t_restoreData)
+    : Job_Impl(t_uuid, JobType::ReadEso, tools, params, files, t_restoreData)
+  {
+    try {
+      m_eso = esoFile();
+      resetFiles(m_files, m_eso);
+    } catch (const std::exception &) {
+    }
+
+    m_description = buildDescription("eso");
+  }
+
+  ReadEsoJob::~ReadEsoJob()
+  {
+    requestStop();
+    wait();
+    // disconnect any remaining slots
+    disconnect(this);
+  }
+
+  void ReadEsoJob::requestStop()
+  {
+  }
+
+  bool ReadEsoJob::outOfDateImpl(const boost::optional<QDateTime> &t_lastrun) const
+  {
+    if (!t_lastrun) {
+      return true;
+    } else {
+      QReadLocker l(&m_mutex);
+      if (m_eso) {
+        return filesChanged(m_files, *t_lastrun);
+      } else {
+        // must have an eso
+        return true;
+      }
+    }
+  }
+
+  void ReadEsoJob::cleanup()
+  {
+  }
+
+  std::string ReadEsoJob::description() const
+  {
+    QReadLocker l(&m_mutex);
+    return m_description;
+  }
+
+  void ReadEsoJob::startImpl(const boost::shared_ptr<ProcessCreator> &)
+  {
+    QWriteLocker l(&m_mutex);
+
+    JobErrors errors;
+    errors.result = ruleset::OSResultValue::Success;
+
+    try {
+      m_eso = esoFile();
+      resetFiles(m_files, m_eso);
+    } catch (const std::exception &e) {
+      JobErrors error;
+      error.result = ruleset::OSResultValue::Fail;
+      error.addError(ErrorType::Error, e.what());
+      errors = error;
+    }
+
+    if (m_eso)
+    {
+      LOG(Info, "ReadEso starting, filename: " << toString(m_eso->fullPath));
+    }
+
+    LOG(Info, "ReadEso starting, outdir: " << toString(outdir()));
+
+    std::vector<std::string> names = variableNames();
+    openstudio::path columnPath = columnFilePath();
+
+    l.unlock();
+
+    emitStatusChanged(AdvancedStatus(AdvancedStatusEnum::Starting));
+
+    emitStarted();
+    emitStatusChanged(AdvancedStatus(AdvancedStatusEnum::Processing));
+
+    if (errors.result == ruleset::OSResultValue::Fail)
+    {
+      setErrors(errors);
+      return;
+    }
+
+    try {
+      openstudio::energyplus::EsoFile eso(m_eso->fullPath, names);
+
+      if (!eso.completed())
+      {
+        errors.addError(ErrorType::Warning, "ESO file '" + toString(m_eso->fullPath) + "' did not end with 'End of Data'");
+      }
+
+      if (eso.variables().empty())
+      {
+        LOG(Warn, "No variables read from " << toString(m_eso->fullPath));
+      }
+
+      boost::filesystem::create_directories(outdir(true));
+
+      if (!eso.saveColumns(columnPath)){
+        LOG_AND_THROW("Failed to write " << toString(columnPath.filename()));
+      }
+
+    } catch (const std::exception &e) {
+      LOG(Error, "Error with ReadEsoJob: " + std::string(e.what()));
+      errors.addError(ErrorType::Error, "Error with ReadEsoJob: " + std::string(e.what()));
+      errors.result = ruleset::OSResultValue::Fail;
+    }
+
+    emitOutputFileChanged(RunManager_Util::dirFile(columnPath));
+    setErrors(errors);
+  }
+
+  std::string ReadEsoJob::getOutput() const
+  {
+    return "";
+  }
+
+  void ReadEsoJob::basePathChanged() 
+  {
+    m_eso.reset();
+    resetFiles(m_files);
+  }
+
+  FileInfo ReadEsoJob::esoFile() const
+  {
+    if (!m_eso)
+    {
+      Files files = allInputFiles();
+      try {
+        return files.getLastByExtension("eso");
+      } catch (const std::exception &) {
+        return files.getLastByExtension("mtr");
+      }
+    } else {
+      return *m_eso;
+    }
+  }
+
+  std::vector<std::string> ReadEsoJob::variableNames() const
+  {
+    std::vector<std::string> result;
+
+    JobParams p = params();
+    if (p.has("variable"))
+    {
+      std::vector<JobParam> variables = p.get("variable").children;
+      for (std::vector<JobParam>::const_iterator itr = variables.begin();
+           itr != variables.end();
+           ++itr)
+      {
+        result.push_back(itr->value);
+      }
+    }
+
+    return result;
+  }
+
+  openstudio::path ReadEsoJob::columnFilePath() const
+  {
+    std::string stem = m_eso ? toString(m_eso->fullPath.stem()) : "eplusout";
+    return outdir() / toPath(stem + ".esocol");
+  }
+
+  Files ReadEsoJob::outputFilesImpl() const
+  {
+    openstudio::path columnPath = columnFilePath();
+    if (!boost::filesystem::exists(columnPath))
+    {
+      // no output file has been generated yet
+      return Files();
+    }
+
+    Files f;
+    f.append(FileInfo(columnPath, "esocol"));
+    return f;
+  }
+
+} // detail
+} // runmanager
+} // openstudio
@@ -0,0 +1,100 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef OPENSTUDIO_RUNMANAGER_READESOJOB_HPP
+#define OPENSTUDIO_RUNMANAGER_READESOJOB_HPP
+
+#include <boost/filesystem.hpp>
+#include <string>
+#include <utilities/core/Logger.hpp>
+#include "Job_Impl.hpp"
+#include "JobParam.hpp"
+
+#include <QDateTime>
+
+namespace openstudio {
+namespace runmanager {
+namespace detail {
+
+  /**
+   * Job type that reads an EnergyPlus ESO or MTR file into a binary column file
+   * with openstudio::energyplus::EsoFile, without running ReadVarsESO.
+   *
+   * This job runs in process as a separate thread.
+   *
+   * \sa \ref ReadEsoJobType
+   */
+  class ReadEsoJob : public Job_Impl
+  {
+    Q_OBJECT;
+
+    public:
+      /// ReadEsoJob constructor. 
+      ReadEsoJob(const UUID &t_uuid,
+          const Tools &tools,
+          const JobParams &params,
+          const Files &files,
+          const JobState &t_restoreData);
+
+      virtual ~ReadEsoJob();
+
+      // Reimplemented virtual functions from Job_Impl
+      virtual bool outOfDateImpl(const boost::optional<QDateTime> &t_lastrun) const;
+      virtual std::string description() const;
+      virtual Files outputFilesImpl() const;
+      virtual std::string getOutput() const;
+      virtual void cleanup();
+
+      virtual bool remoteRunnable() const
+      {
+        return false;
+      }
+
+      virtual void requestStop();
+
+    protected:
+      virtual void startImpl(const boost::shared_ptr<ProcessCreator> &t_creator);
+
+      virtual void basePathChanged();
+      virtual void standardCleanImpl() { /* nothing to do for this job type */ }
+
+    private:
+      REGISTER_LOGGER("openstudio.runmanager.ReadEsoJob");
+
+      /// Returns the ESO file to read, or the MTR file if there is no ESO file
+      FileInfo esoFile() const;
+
+      /// Returns the variable names passed in the "variable" param, empty means all variables
+      std::vector<std::string> variableNames() const;
+
+      /// Returns the path of the column file written by this job
+      openstudio::path columnFilePath() const;
+
+      mutable QReadWriteLock m_mutex;
+
+      std::map<openstudio::path, FileTrack> m_files; //< Files tracked for outOfDate status
+      boost::optional<FileInfo> m_eso; //< EnergyPlus ESO or MTR file
+
+      std::string m_description; //< Description of job
+  }; 
+
+}
+}
+}
+#endif
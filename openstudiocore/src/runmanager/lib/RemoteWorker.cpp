@@ -0,0 +1,737 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include "RemoteWorker.hpp"
+#include "RemoteWorkerProtocol.hpp"
+#include "LocalProcess.hpp"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QProcessEnvironment>
+#include <QStringList>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace openstudio {
+namespace runmanager {
+
+  RemoteWorker::Job::Job()
+    : id(0), started(false), finished(false), killed(false)
+  {
+  }
+
+  RemoteWorker::RemoteWorker(const openstudio::path &t_workDir, int t_slots, const std::string &t_secret,
+      const std::map<std::string, openstudio::path> &t_tools)
+    : m_workDir(t_workDir), m_slots(std::max(1, t_slots)), m_secret(t_secret), m_tools(t_tools),
+      m_cache(new detail::RemoteWorkerFileCache(t_workDir / toPath("cache"))),
+      m_running(0), m_nextSerial(0)
+  {
+    if (m_secret.empty())
+    {
+      throw std::runtime_error("A remote worker requires a secret");
+    }
+
+    // run directories left behind by an earlier worker in this directory are of no further use
+    boost::filesystem::remove_all(m_workDir / toPath("jobs"));
+    boost::filesystem::create_directories(m_workDir / toPath("jobs"));
+  }
+
+  RemoteWorker::~RemoteWorker()
+  {
+    for (std::map<JobKey, Job>::iterator itr = m_jobs.begin(); itr != m_jobs.end(); ++itr)
+    {
+      if (itr->second.process)
+      {
+        itr->second.process->disconnect(this);
+        LocalProcess::kill(*itr->second.process, true);
+        itr->second.process->waitForFinished(1000);
+      }
+    }
+
+    for (std::map<QIODevice *, Connection>::iterator itr = m_connections.begin(); itr != m_connections.end(); ++itr)
+    {
+      itr->first->disconnect(this);
+    }
+  }
+
+  bool RemoteWorker::listen(const QHostAddress &t_address, quint16 t_port)
+  {
+    m_tcpServer = boost::shared_ptr<QTcpServer>(new QTcpServer());
+    connect(m_tcpServer.get(), SIGNAL(newConnection()), this, SLOT(newTcpConnection()));
+
+    if (!m_tcpServer->listen(t_address, t_port))
+    {
+      LOG(Error, "Unable to listen on " << toString(t_address.toString()) << ":" << t_port << ": " << toString(m_tcpServer->errorString()));
+      return false;
+    }
+
+    LOG(Info, "Remote worker listening on " << toString(t_address.toString()) << ":" << m_tcpServer->serverPort());
+    return true;
+  }
+
+  bool RemoteWorker::listen(const QString &t_socketName)
+  {
+    // a socket file left behind by a worker that did not shut down cleanly would block listen
+    QLocalServer::removeServer(t_socketName);
+
+    m_localServer = boost::shared_ptr<QLocalServer>(new QLocalServer());
+    connect(m_localServer.get(), SIGNAL(newConnection()), this, SLOT(newLocalConnection()));
+
+    if (!m_localServer->listen(t_socketName))
+    {
+      LOG(Error, "Unable to listen on " << toString(t_socketName) << ": " << toString(m_localServer->errorString()));
+      return false;
+    }
+
+    LOG(Info, "Remote worker listening on " << toString(m_localServer->fullServerName()));
+    return true;
+  }
+
+  quint16 RemoteWorker::port() const
+  {
+    return m_tcpServer ? m_tcpServer->serverPort() : 0;
+  }
+
+  int RemoteWorker::slotCount() const
+  {
+    return m_slots;
+  }
+
+  void RemoteWorker::newTcpConnection()
+  {
+    while (QTcpSocket *socket = m_tcpServer->nextPendingConnection())
+    {
+      addConnection(socket);
+    }
+  }
+
+  void RemoteWorker::newLocalConnection()
+  {
+    while (QLocalSocket *socket = m_localServer->nextPendingConnection())
+    {
+      addConnection(socket);
+    }
+  }
+
+  void RemoteWorker::addConnection(QIODevice *t_device)
+  {
+    LOG(Info, "Remote worker accepted a connection");
+
+    Connection c;
+    c.reader = boost::shared_ptr<detail::RemoteWorkerFrameReader>(new detail::RemoteWorkerFrameReader());
+    c.serial = ++m_nextSerial;
+    c.nonce = detail::remoteWorkerNonce();
+    c.authenticated = false;
+    m_connections[t_device] = c;
+
+    connect(t_device, SIGNAL(readyRead()), this, SLOT(connectionReadyRead()));
+    connect(t_device, SIGNAL(disconnected()), this, SLOT(connectionDisconnected()));
+
+    QVariantMap challenge;
+    challenge["protocol"] = detail::RemoteWorkerMessage::ProtocolVersion;
+    challenge["nonce"] = c.nonce;
+    send(t_device, detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::Challenge, challenge));
+  }
+
+  void RemoteWorker::authenticate(QIODevice *t_device, const QVariantMap &t_data)
+  {
+    Connection &c = m_connections[t_device];
+    QByteArray expected = detail::remoteWorkerResponse(m_secret, detail::RemoteWorkerManagerRole, c.nonce);
+    if (!detail::remoteWorkerResponseMatches(t_data["response"].toByteArray(), expected))
+    {
+      throw std::runtime_error("manager failed to authenticate");
+    }
+
+    QByteArray managerNonce = t_data["nonce"].toByteArray();
+    if (managerNonce.isEmpty())
+    {
+      throw std::runtime_error("manager sent no nonce to answer");
+    }
+
+    c.authenticated = true;
+    LOG(Info, "Remote worker connection authenticated");
+
+    QStringList tools;
+    for (std::map<std::string, openstudio::path>::const_iterator itr = m_tools.begin(); itr != m_tools.end(); ++itr)
+    {
+      tools.push_back(toQString(itr->first));
+    }
+
+    QVariantMap hello;
+    hello["protocol"] = detail::RemoteWorkerMessage::ProtocolVersion;
+    hello["slots"] = m_slots;
+    hello["name"] = toQString(m_workDir);
+    hello["tools"] = tools;
+    hello["response"] = detail::remoteWorkerResponse(m_secret, detail::RemoteWorkerWorkerRole, managerNonce);
+    send(t_device, detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::Hello, hello));
+  }
+
+  void RemoteWorker::connectionReadyRead()
+  {
+    QIODevice *device = qobject_cast<QIODevice *>(sender());
+    std::map<QIODevice *, Connection>::iterator itr = m_connections.find(device);
+    if (itr == m_connections.end())
+    {
+      return;
+    }
+
+    boost::shared_ptr<detail::RemoteWorkerFrameReader> reader = itr->second.reader;
+    reader->append(device->readAll());
+
+    try {
+      while (boost::optional<detail::RemoteWorkerMessage> message = reader->next())
+      {
+        handle(device, *message);
+      }
+    } catch (const std::exception &e) {
+      LOG(Error, "Closing remote worker connection: " << e.what());
+      device->close();
+      closeConnection(device);
+    }
+  }
+
+  void RemoteWorker::connectionDisconnected()
+  {
+    closeConnection(qobject_cast<QIODevice *>(sender()));
+  }
+
+  void RemoteWorker::closeConnection(QIODevice *t_device)
+  {
+    std::map<QIODevice *, Connection>::iterator conn = m_connections.find(t_device);
+    if (conn == m_connections.end())
+    {
+      return;
+    }
+
+    LOG(Info, "Remote worker connection closed");
+
+    t_device->disconnect(this);
+    t_device->deleteLater();
+    m_connections.erase(conn);
+
+    std::vector<JobKey> keys;
+    for (std::map<JobKey, Job>::const_iterator itr = m_jobs.begin(); itr != m_jobs.end(); ++itr)
+    {
+      if (itr->first.first == t_device)
+      {
+        keys.push_back(itr->first);
+      }
+    }
+
+    for (std::vector<JobKey>::const_iterator itr = keys.begin(); itr != keys.end(); ++itr)
+    {
+      release(*itr);
+    }
+
+    // files that were being received over this connection are requested again by the jobs of
+    // other connections still waiting for them
+    std::set<std::string> dropped;
+    for (std::map<std::string, QIODevice *>::iterator itr = m_requested.begin(); itr != m_requested.end(); )
+    {
+      if (itr->second == t_device)
+      {
+        m_cache->abandon(itr->first);
+        dropped.insert(itr->first);
+        m_requested.erase(itr++);
+      } else {
+        ++itr;
+      }
+    }
+
+    for (std::map<JobKey, Job>::iterator itr = m_jobs.begin(); itr != m_jobs.end(); ++itr)
+    {
+      QStringList hashes;
+      for (std::set<std::string>::const_iterator hash = itr->second.missing.begin(); hash != itr->second.missing.end(); ++hash)
+      {
+        if (dropped.count(*hash) && !m_requested.count(*hash))
+        {
+          m_requested[*hash] = itr->first.first;
+          hashes.push_back(toQString(*hash));
+        }
+      }
+
+      if (!hashes.isEmpty())
+      {
+        QVariantMap need;
+        need["job"] = itr->second.id;
+        need["hashes"] = hashes;
+        send(itr->first.first, detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::NeedFiles, need));
+      }
+    }
+  }
+
+  void RemoteWorker::handle(QIODevice *t_device, const detail::RemoteWorkerMessage &t_message)
+  {
+    // nothing but the answer to the challenge is accepted from a connection that has not given it
+    if (!m_connections[t_device].authenticated)
+    {
+      if (t_message.type != detail::RemoteWorkerMessage::Authenticate)
+      {
+        throw std::runtime_error("message received before authentication");
+      }
+
+      authenticate(t_device, t_message.data);
+      return;
+    }
+
+    switch (t_message.type)
+    {
+      case detail::RemoteWorkerMessage::Submit:
+        submit(t_device, t_message.data);
+        break;
+      case detail::RemoteWorkerMessage::FileData:
+        fileData(t_device, t_message.data);
+        break;
+      case detail::RemoteWorkerMessage::Fetch:
+        fetch(t_device, t_message.data);
+        break;
+      case detail::RemoteWorkerMessage::Release:
+        release(JobKey(t_device, t_message.data["job"].toInt()));
+        startJobs();
+        break;
+      case detail::RemoteWorkerMessage::Kill:
+        kill(JobKey(t_device, t_message.data["job"].toInt()));
+        break;
+      default:
+        LOG(Warn, "Ignoring unexpected remote worker message " << t_message.type);
+    }
+  }
+
+  void RemoteWorker::submit(QIODevice *t_device, const QVariantMap &t_data)
+  {
+    JobKey key(t_device, t_data["job"].toInt());
+    if (m_jobs.count(key))
+    {
+      LOG(Warn, "Ignoring resubmitted job " << key.second);
+      return;
+    }
+
+    Job &job = m_jobs[key];
+    job.id = key.second;
+    job.dir = m_workDir / toPath("jobs") 
+      / toPath(boost::lexical_cast<std::string>(m_connections[t_device].serial) + "-" + boost::lexical_cast<std::string>(key.second));
+    job.args = t_data["args"].toStringList();
+    job.stdinData = t_data["stdin"].toByteArray();
+
+    try {
+      job.exe = resolveTool(toString(t_data["tool"].toString()));
+    } catch (const std::exception &e) {
+      job.error = e.what();
+    }
+
+    QVariantList files = t_data["files"].toList();
+    for (QVariantList::const_iterator itr = files.begin(); itr != files.end() && job.error.empty(); ++itr)
+    {
+      QVariantMap file = itr->toMap();
+      QString path = file["path"].toString();
+      std::string hash = toString(file["hash"].toString());
+
+      if (!detail::isRemoteWorkerRelativePath(path) || !detail::isRemoteWorkerHash(hash))
+      {
+        job.error = "Invalid input file " + toString(path);
+      } else {
+        job.inputs[toString(path)] = hash;
+        if (!m_cache->has(hash))
+        {
+          job.missing.insert(hash);
+        }
+      }
+    }
+
+    LOG(Info, "Received job " << job.id << " for " << toString(job.exe) << " missing " << job.missing.size() << " of " << job.inputs.size() << " input files");
+
+    if (!job.error.empty())
+    {
+      finish(key, -1, true);
+      return;
+    }
+
+    // a file already on its way for another job is not asked for twice
+    QStringList hashes;
+    for (std::set<std::string>::const_iterator itr = job.missing.begin(); itr != job.missing.end(); ++itr)
+    {
+      if (!m_requested.count(*itr))
+      {
+        m_requested[*itr] = t_device;
+        hashes.push_back(toQString(*itr));
+      }
+    }
+
+    QVariantMap need;
+    need["job"] = job.id;
+    need["hashes"] = hashes;
+    send(t_device, detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::NeedFiles, need));
+
+    if (job.missing.empty())
+    {
+      filesReady(key);
+    }
+  }
+
+  void RemoteWorker::fileData(QIODevice *t_device, const QVariantMap &t_data)
+  {
+    std::string hash = toString(t_data["hash"].toString());
+    bool last = t_data["last"].toBool();
+
+    std::map<std::string, QIODevice *>::iterator requested = m_requested.find(hash);
+    if (requested == m_requested.end() || requested->second != t_device)
+    {
+      LOG(Warn, "Ignoring file data that was not asked for: " << hash);
+      return;
+    }
+
+    std::string error;
+    try {
+      m_cache->receive(hash, t_data["data"].toByteArray(), last);
+    } catch (const std::exception &e) {
+      LOG(Error, "Unable to receive input file: " << e.what());
+      error = e.what();
+      last = true;
+    }
+
+    if (!last)
+    {
+      return;
+    }
+
+    m_requested.erase(requested);
+
+    std::vector<JobKey> ready;
+    std::vector<JobKey> failed;
+    for (std::map<JobKey, Job>::iterator itr = m_jobs.begin(); itr != m_jobs.end(); ++itr)
+    {
+      if (itr->second.missing.erase(hash) && !itr->second.finished)
+      {
+        if (!error.empty())
+        {
+          itr->second.error = error;
+          failed.push_back(itr->first);
+        } else if (itr->second.missing.empty()) {
+          ready.push_back(itr->first);
+        }
+      }
+    }
+
+    for (std::vector<JobKey>::const_iterator itr = failed.begin(); itr != failed.end(); ++itr)
+    {
+      finish(*itr, -1, true);
+    }
+
+    for (std::vector<JobKey>::const_iterator itr = ready.begin(); itr != ready.end(); ++itr)
+    {
+      filesReady(*itr);
+    }
+  }
+
+  void RemoteWorker::filesReady(const JobKey &t_key)
+  {
+    Job &job = m_jobs[t_key];
+
+    try {
+      boost::filesystem::create_directories(job.dir);
+      for (std::map<std::string, std::string>::const_iterator itr = job.inputs.begin(); itr != job.inputs.end(); ++itr)
+      {
+        m_cache->install(itr->second, job.dir / toPath(itr->first));
+      }
+    } catch (const std::exception &e) {
+      job.error = std::string("Unable to set up run directory: ") + e.what();
+      finish(t_key, -1, true);
+      return;
+    }
+
+    m_waiting.push_back(t_key);
+    startJobs();
+  }
+
+  void RemoteWorker::startJobs()
+  {
+    while (m_running < m_slots && !m_waiting.empty())
+    {
+      JobKey key = m_waiting.front();
+      m_waiting.pop_front();
+
+      std::map<JobKey, Job>::iterator itr = m_jobs.find(key);
+      if (itr == m_jobs.end() || itr->second.finished || itr->second.process)
+      {
+        continue;
+      }
+
+      Job &job = itr->second;
+      job.process = boost::shared_ptr<QProcess>(new QProcess());
+      ++m_running;
+
+      connect(job.process.get(), SIGNAL(started()), this, SLOT(processStarted()));
+      connect(job.process.get(), SIGNAL(readyReadStandardOutput()), this, SLOT(processReadyReadStandardOutput()));
+      connect(job.process.get(), SIGNAL(readyReadStandardError()), this, SLOT(processReadyReadStandardError()));
+      connect(job.process.get(), SIGNAL(finished(int, QProcess::ExitStatus)), this, SLOT(processFinished(int, QProcess::ExitStatus)));
+      connect(job.process.get(), SIGNAL(error(QProcess::ProcessError)), this, SLOT(processError(QProcess::ProcessError)));
+
+      // set up path to be binary directory to catch ancillary tools, as for local processes
+      QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+#ifdef Q_WS_WIN
+      env.insert("PATH", toQString(job.exe.parent_path()) + ";" + env.value("PATH"));
+#else
+      env.insert("PATH", toQString(job.exe.parent_path()) + ":" + env.value("PATH"));
+#endif
+      job.process->setProcessEnvironment(env);
+      job.process->setWorkingDirectory(toQString(job.dir));
+
+      LOG(Info, "Starting job " << job.id << ": " << toString(job.exe));
+      job.process->start(toQString(job.exe), job.args, QIODevice::ReadWrite);
+    }
+  }
+
+  RemoteWorker::JobKey RemoteWorker::keyOf(QObject *t_process) const
+  {
+    for (std::map<JobKey, Job>::const_iterator itr = m_jobs.begin(); itr != m_jobs.end(); ++itr)
+    {
+      if (itr->second.process.get() == t_process)
+      {
+        return itr->first;
+      }
+    }
+
+    throw std::out_of_range("Unknown remote worker process");
+  }
+
+  void RemoteWorker::processStarted()
+  {
+    try {
+      JobKey key = keyOf(sender());
+      Job &job = m_jobs[key];
+      job.started = true;
+      job.process->write(job.stdinData);
+      job.process->closeWriteChannel();
+
+      QVariantMap started;
+      started["job"] = job.id;
+      send(key.first, detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::Started, started));
+    } catch (const std::out_of_range &) {
+    }
+  }
+
+  void RemoteWorker::processReadyReadStandardOutput()
+  {
+    try {
+      JobKey key = keyOf(sender());
+      QVariantMap data;
+      data["job"] = key.second;
+      data["data"] = m_jobs[key].process->readAllStandardOutput();
+      send(key.first, detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::StdOut, data));
+    } catch (const std::out_of_range &) {
+    }
+  }
+
+  void RemoteWorker::processReadyReadStandardError()
+  {
+    try {
+      JobKey key = keyOf(sender());
+      QVariantMap data;
+      data["job"] = key.second;
+      data["data"] = m_jobs[key].process->readAllStandardError();
+      send(key.first, detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::StdErr, data));
+    } catch (const std::out_of_range &) {
+    }
+  }
+
+  void RemoteWorker::processFinished(int t_exitCode, QProcess::ExitStatus t_exitStatus)
+  {
+    try {
+      JobKey key = keyOf(sender());
+      finish(key, t_exitCode, t_exitStatus == QProcess::CrashExit || m_jobs[key].killed);
+    } catch (const std::out_of_range &) {
+    }
+  }
+
+  void RemoteWorker::processError(QProcess::ProcessError t_error)
+  {
+    // other errors are followed by finished()
+    if (t_error != QProcess::FailedToStart)
+    {
+      return;
+    }
+
+    try {
+      JobKey key = keyOf(sender());
+      m_jobs[key].error = "Unable to start " + toString(m_jobs[key].exe);
+      finish(key, -1, true);
+    } catch (const std::out_of_range &) {
+    }
+  }
+
+  void RemoteWorker::finish(const JobKey &t_key, int t_exitCode, bool t_crashed)
+  {
+    Job &job = m_jobs[t_key];
+    if (job.finished)
+    {
+      return;
+    }
+
+    job.finished = true;
+    if (job.process)
+    {
+      --m_running;
+    }
+
+    LOG(Info, "Job " << job.id << " finished with exit code " << t_exitCode << " " << job.error);
+
+    // everything in the run directory but the unchanged inputs is an output
+    QVariantList outputs;
+    QDir dir(toQString(job.dir));
+    QDirIterator files(dir.path(), QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+    while (files.hasNext())
+    {
+      QString relative = dir.relativeFilePath(files.next());
+      try {
+        std::string hash = detail::RemoteWorkerFileCache::hashFile(job.dir / toPath(relative));
+        std::map<std::string, std::string>::const_iterator input = job.inputs.find(toString(relative));
+        if (input == job.inputs.end() || input->second != hash)
+        {
+          QVariantMap output;
+          output["path"] = relative;
+          output["hash"] = toQString(hash);
+          outputs.push_back(output);
+        }
+      } catch (const std::exception &e) {
+        LOG(Warn, "Unable to list output file: " << e.what());
+      }
+    }
+
+    QVariantMap finished;
+    finished["job"] = job.id;
+    finished["exitCode"] = t_exitCode;
+    finished["crashed"] = t_crashed;
+    finished["error"] = toQString(job.error);
+    finished["outputs"] = outputs;
+    send(t_key.first, detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::Finished, finished));
+
+    startJobs();
+  }
+
+  void RemoteWorker::fetch(QIODevice *t_device, const QVariantMap &t_data)
+  {
+    JobKey key(t_device, t_data["job"].toInt());
+    std::map<JobKey, Job>::const_iterator job = m_jobs.find(key);
+
+    if (job != m_jobs.end())
+    {
+      QStringList paths = t_data["paths"].toStringList();
+      for (QStringList::const_iterator itr = paths.begin(); itr != paths.end(); ++itr)
+      {
+        if (!detail::isRemoteWorkerRelativePath(*itr))
+        {
+          LOG(Warn, "Refusing to send " << toString(*itr));
+          continue;
+        }
+
+        QVariantMap data;
+        data["job"] = key.second;
+        data["path"] = *itr;
+        try {
+          detail::sendRemoteWorkerFile(*t_device, detail::RemoteWorkerMessage::OutputData, data, job->second.dir / toPath(*itr));
+        } catch (const std::exception &e) {
+          LOG(Warn, "Unable to send output file: " << e.what());
+        }
+      }
+    }
+
+    QVariantMap fetched;
+    fetched["job"] = key.second;
+    send(t_device, detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::Fetched, fetched));
+  }
+
+  void RemoteWorker::kill(const JobKey &t_key)
+  {
+    std::map<JobKey, Job>::iterator itr = m_jobs.find(t_key);
+    if (itr == m_jobs.end() || itr->second.finished)
+    {
+      return;
+    }
+
+    if (itr->second.process)
+    {
+      LOG(Info, "Killing job " << itr->second.id);
+      itr->second.killed = true;
+      LocalProcess::kill(*itr->second.process, true);
+    } else {
+      itr->second.error = "Stopped before it started";
+      finish(t_key, -1, true);
+    }
+  }
+
+  void RemoteWorker::release(const JobKey &t_key)
+  {
+    std::map<JobKey, Job>::iterator itr = m_jobs.find(t_key);
+    if (itr == m_jobs.end())
+    {
+      return;
+    }
+
+    Job &job = itr->second;
+    if (job.process)
+    {
+      job.process->disconnect(this);
+      if (!job.finished)
+      {
+        LocalProcess::kill(*job.process, true);
+        job.process->waitForFinished(1000);
+        --m_running;
+      }
+    }
+
+    try {
+      boost::filesystem::remove_all(job.dir);
+    } catch (const std::exception &e) {
+      LOG(Warn, "Unable to remove run directory " << toString(job.dir) << ": " << e.what());
+    }
+
+    m_waiting.erase(std::remove(m_waiting.begin(), m_waiting.end(), t_key), m_waiting.end());
+    m_jobs.erase(itr);
+  }
+
+  void RemoteWorker::send(QIODevice *t_device, const detail::RemoteWorkerMessage &t_message)
+  {
+    if (m_connections.count(t_device) && t_device->isOpen())
+    {
+      t_device->write(t_message.encode());
+    }
+  }
+
+  openstudio::path RemoteWorker::resolveTool(const std::string &t_name) const
+  {
+    std::map<std::string, openstudio::path>::const_iterator itr = m_tools.find(t_name);
+    if (itr != m_tools.end())
+    {
+      return itr->second;
+    }
+
+    throw std::runtime_error("Tool '" + t_name + "' is not available on this worker");
+  }
+
+}
+}
@@ -0,0 +1,180 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef OPENSTUDIO_RUNMANAGER_LIB_REMOTEWORKER_HPP
+#define OPENSTUDIO_RUNMANAGER_LIB_REMOTEWORKER_HPP
+
+#include "RunManagerAPI.hpp"
+
+#include <utilities/core/Logger.hpp>
+#include <utilities/core/Path.hpp>
+
+#include <QHostAddress>
+#include <QObject>
+#include <QProcess>
+#include <QVariant>
+
+#include <boost/shared_ptr.hpp>
+
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+
+class QIODevice;
+class QLocalServer;
+class QTcpServer;
+
+namespace openstudio {
+namespace runmanager {
+
+namespace detail {
+  class RemoteWorkerFileCache;
+  class RemoteWorkerFrameReader;
+  struct RemoteWorkerMessage;
+}
+
+  /// Worker daemon that runs the tools of remote jobs for a RemoteWorkerManager, see
+  /// RunManager::setRemoteWorkers. It listens on a TCP port or a local socket, keeps the input files
+  /// it receives in a content addressed cache so each distinct file is sent to it once, and pushes
+  /// the progress of each job back over the connection it was submitted on.
+  ///
+  /// Any number of workers may run on one host, each with its own work directory. The RunManagerWorker
+  /// executable wraps one worker; tests run workers in process on localhost.
+  ///
+  /// A manager must prove it knows the worker's secret before the worker accepts any job from it,
+  /// the worker proves the same in return, and only the tools the worker was configured with are
+  /// ever run.
+  class RUNMANAGER_API RemoteWorker : public QObject
+  {
+    Q_OBJECT;
+
+    public:
+      /// \param[in] t_workDir Directory holding the file cache and the run directories of jobs
+      /// \param[in] t_slots Number of jobs run at once, further jobs wait for a free slot
+      /// \param[in] t_secret Secret shared with the managers allowed to use the worker
+      /// \param[in] t_tools Executables by tool name ("energyplus", "ruby", ...), jobs for any other
+      ///                    tool are refused
+      /// \throws std::runtime_error if t_secret is empty
+      RemoteWorker(const openstudio::path &t_workDir, int t_slots, const std::string &t_secret,
+          const std::map<std::string, openstudio::path> &t_tools);
+      virtual ~RemoteWorker();
+
+      /// Starts listening for managers on a TCP port, 0 picks a free port
+      /// \returns true on success
+      bool listen(const QHostAddress &t_address, quint16 t_port);
+
+      /// Starts listening for managers on a local socket (a Unix domain socket or a named pipe)
+      /// \returns true on success
+      bool listen(const QString &t_socketName);
+
+      /// \returns the TCP port listened on, 0 if not listening on TCP
+      quint16 port() const;
+
+      /// \returns the number of jobs run at once
+      int slotCount() const;
+
+    private slots:
+      void newTcpConnection();
+      void newLocalConnection();
+      void connectionReadyRead();
+      void connectionDisconnected();
+
+      void processStarted();
+      void processReadyReadStandardOutput();
+      void processReadyReadStandardError();
+      void processFinished(int t_exitCode, QProcess::ExitStatus t_exitStatus);
+      void processError(QProcess::ProcessError t_error);
+
+    private:
+      REGISTER_LOGGER("openstudio.runmanager.RemoteWorker");
+
+      typedef std::pair<QIODevice *, int> JobKey;
+
+      struct Job
+      {
+        Job();
+
+        int id;
+        openstudio::path dir;
+        openstudio::path exe;
+        QStringList args;
+        QByteArray stdinData;
+        std::map<std::string, std::string> inputs; ///< relative path to hash
+        std::set<std::string> missing;             ///< hashes not yet received
+        boost::shared_ptr<QProcess> process;
+        bool started;
+        bool finished;
+        bool killed;
+        std::string error;
+      };
+
+      struct Connection
+      {
+        boost::shared_ptr<detail::RemoteWorkerFrameReader> reader;
+        int serial;
+        QByteArray nonce;   ///< challenge sent to the manager
+        bool authenticated; ///< true once the manager answered the challenge
+      };
+
+      void addConnection(QIODevice *t_device);
+      void closeConnection(QIODevice *t_device);
+      void handle(QIODevice *t_device, const detail::RemoteWorkerMessage &t_message);
+      void authenticate(QIODevice *t_device, const QVariantMap &t_data);
+      void submit(QIODevice *t_device, const QVariantMap &t_data);
+      void fileData(QIODevice *t_device, const QVariantMap &t_data);
+      void fetch(QIODevice *t_device, const QVariantMap &t_data);
+      void release(const JobKey &t_key);
+      void kill(const JobKey &t_key);
+
+      /// Moves a job whose files have all arrived to the queue of jobs waiting for a slot
+      void filesReady(const JobKey &t_key);
+
+      /// Starts waiting jobs while there are free slots
+      void startJobs();
+
+      /// Reports a finished job, listing the files it created or changed
+      void finish(const JobKey &t_key, int t_exitCode, bool t_crashed);
+
+      void send(QIODevice *t_device, const detail::RemoteWorkerMessage &t_message);
+
+      JobKey keyOf(QObject *t_process) const;
+
+      /// \throws std::runtime_error if the worker was not configured with the tool
+      openstudio::path resolveTool(const std::string &t_name) const;
+
+      openstudio::path m_workDir;
+      int m_slots;
+      std::string m_secret;
+      std::map<std::string, openstudio::path> m_tools;
+      boost::shared_ptr<detail::RemoteWorkerFileCache> m_cache;
+      boost::shared_ptr<QTcpServer> m_tcpServer;
+      boost::shared_ptr<QLocalServer> m_localServer;
+      std::map<QIODevice *, Connection> m_connections;
+      std::map<std::string, QIODevice *> m_requested; ///< hashes being received, by the connection sending them
+      std::map<JobKey, Job> m_jobs;
+      std::deque<JobKey> m_waiting;
+      int m_running;
+      int m_nextSerial;
+  };
+
+}
+}
+
+#endif // OPENSTUDIO_RUNMANAGER_LIB_REMOTEWORKER_HPP
@@ -0,0 +1,64 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef OPENSTUDIO_RUNMANAGER_REMOTEWORKERENDPOINT_HPP
+#define OPENSTUDIO_RUNMANAGER_REMOTEWORKERENDPOINT_HPP
+
+#include "RunManagerAPI.hpp"
+
+#include <string>
+
+namespace openstudio {
+namespace runmanager {
+
+  /// Address of a RemoteWorker, see RunManager::setRemoteWorkers. A worker listens either on a
+  /// TCP port or on a local socket; several workers may run on one host, each on its own port or socket.
+  /// The secret is the one the worker was started with, it is never sent over the connection.
+  struct RUNMANAGER_API RemoteWorkerEndpoint
+  {
+    /// A worker listening on a TCP port
+    RemoteWorkerEndpoint(const std::string &t_host, unsigned int t_port, const std::string &t_secret)
+      : host(t_host), port(t_port), secret(t_secret)
+    {
+    }
+
+    /// A worker listening on a local socket, a Unix domain socket or a named pipe on Windows
+    RemoteWorkerEndpoint(const std::string &t_socketName, const std::string &t_secret)
+      : port(0), socketName(t_socketName), secret(t_secret)
+    {
+    }
+
+    bool operator==(const RemoteWorkerEndpoint &t_rhs) const
+    {
+      return host == t_rhs.host && port == t_rhs.port && socketName == t_rhs.socketName && secret == t_rhs.secret;
+    }
+
+    /// \returns "host:port" or the socket name, for messages
+    std::string toString() const;
+
+    std::string host;       ///< empty for a local socket
+    unsigned int port;
+    std::string socketName; ///< empty for a TCP port
+    std::string secret;
+  };
+
+}
+}
+
+#endif
@@ -0,0 +1,849 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include "RemoteWorkerManager.hpp"
+#include "RemoteWorkerProtocol.hpp"
+#include "RunManager_Util.hpp"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include <boost/bind.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace openstudio {
+namespace runmanager {
+
+  std::string RemoteWorkerEndpoint::toString() const
+  {
+    if (!socketName.empty())
+    {
+      return socketName;
+    }
+
+    return host + ":" + boost::lexical_cast<std::string>(port);
+  }
+
+  const int RemoteWorkerManager::ReconnectMSecs = 5000;
+
+  RemoteWorkerManager::Worker::Worker(const RemoteWorkerEndpoint &t_endpoint)
+    : endpoint(t_endpoint), state(Connecting), slotCount(0)
+  {
+  }
+
+  RemoteWorkerManager::ProcessInfo::ProcessInfo()
+    : worker(-1), job(0), started(false), exitCode(-1), crashed(false)
+  {
+  }
+
+  RemoteWorkerManager::RemoteWorkerManager()
+    : m_mutex(QMutex::Recursive), m_nextWorker(0), m_nextJob(0), m_filesSent(0)
+  {
+  }
+
+  RemoteWorkerManager::~RemoteWorkerManager()
+  {
+    for (std::map<int, Worker>::iterator itr = m_workers.begin(); itr != m_workers.end(); ++itr)
+    {
+      if (itr->second.device)
+      {
+        itr->second.device->disconnect(this);
+        itr->second.device->close();
+      }
+    }
+  }
+
+  void RemoteWorkerManager::setWorkers(const std::vector<RemoteWorkerEndpoint> &t_workers)
+  {
+    {
+      QMutexLocker l(&m_mutex);
+      m_endpoints = t_workers;
+    }
+
+    QMetaObject::invokeMethod(this, "connectWorkers", Qt::QueuedConnection);
+  }
+
+  std::vector<RemoteWorkerEndpoint> RemoteWorkerManager::workers() const
+  {
+    QMutexLocker l(&m_mutex);
+    return m_endpoints;
+  }
+
+  int RemoteWorkerManager::freeSlots() const
+  {
+    QMutexLocker l(&m_mutex);
+
+    int free = 0;
+    for (std::map<int, Worker>::const_iterator itr = m_workers.begin(); itr != m_workers.end(); ++itr)
+    {
+      if (itr->second.state == Worker::Ready)
+      {
+        free += std::max(0, itr->second.slotCount - static_cast<int>(itr->second.processes.size()));
+      }
+    }
+
+    return std::max(0, free - static_cast<int>(m_waiting.size()));
+  }
+
+  std::set<std::string> RemoteWorkerManager::tools() const
+  {
+    QMutexLocker l(&m_mutex);
+
+    std::set<std::string> result;
+    for (std::map<int, Worker>::const_iterator itr = m_workers.begin(); itr != m_workers.end(); ++itr)
+    {
+      if (itr->second.state == Worker::Ready)
+      {
+        result.insert(itr->second.tools.begin(), itr->second.tools.end());
+      }
+    }
+
+    return result;
+  }
+
+  int RemoteWorkerManager::activeProcesses() const
+  {
+    QMutexLocker l(&m_mutex);
+    return m_processes.size();
+  }
+
+  int RemoteWorkerManager::filesSent() const
+  {
+    QMutexLocker l(&m_mutex);
+    return m_filesSent;
+  }
+
+  std::string RemoteWorkerManager::hashFile(const openstudio::path &t_file)
+  {
+    QFileInfo fi(toQString(t_file));
+
+    // modification times only have a resolution of a second, a file rewritten with the same size
+    // within that second looks unchanged, so recently modified files are always hashed again
+    bool settled = fi.lastModified().secsTo(QDateTime::currentDateTime()) > 2;
+
+    if (settled)
+    {
+      QMutexLocker l(&m_mutex);
+      std::map<openstudio::path, HashedFile>::const_iterator itr = m_hashes.find(t_file);
+      if (itr != m_hashes.end() && itr->second.lastModified == fi.lastModified() && itr->second.size == fi.size())
+      {
+        return itr->second.hash;
+      }
+    }
+
+    // hashed without holding the lock, large inputs take a while
+    HashedFile hashed;
+    hashed.lastModified = fi.lastModified();
+    hashed.size = fi.size();
+    hashed.hash = detail::RemoteWorkerFileCache::hashFile(t_file);
+
+    QMutexLocker l(&m_mutex);
+    m_hashes[t_file] = hashed;
+    return hashed.hash;
+  }
+
+  boost::shared_ptr<Process> RemoteWorkerManager::createProcess(
+      const openstudio::runmanager::ToolInfo &t_tool,
+      const std::vector<std::pair<openstudio::path, openstudio::path> > &t_requiredFiles,
+      const std::vector<std::string> &t_parameters,
+      const openstudio::path &t_outdir,
+      const std::vector<openstudio::path> & /*t_expectedOutputFiles*/,
+      const std::string &t_stdin,
+      const openstudio::path &t_basePath,
+      const boost::optional<std::pair<int,int> > &t_remoteId)
+  {
+    using namespace boost::filesystem;
+
+    if (t_remoteId)
+    {
+      LOG(Warn, "Remote worker processes cannot be reattached after a restart, the process is run again");
+    }
+
+    QDir outdir(toQString(t_outdir));
+
+    ProcessInfo info;
+    info.toolName = t_tool.name;
+    info.outdir = t_outdir;
+    info.stdinData = QByteArray(t_stdin.data(), t_stdin.size());
+
+    std::vector<FileInfo> inputFiles;
+
+    for (std::vector<std::pair<openstudio::path, openstudio::path> >::const_iterator itr = t_requiredFiles.begin();
+         itr != t_requiredFiles.end();
+         ++itr)
+    {
+      // relative required files are resolved as for local processes
+      openstudio::path frompath = itr->first;
+      if (!frompath.has_root_path())
+      {
+        openstudio::path baserelative = t_basePath / frompath;
+
+        if (exists(baserelative))
+        {
+          frompath = baserelative;
+        } else {
+          frompath = t_tool.localBinPath.parent_path() / frompath;
+        }
+      }
+
+      std::vector<std::pair<openstudio::path, openstudio::path> > files;
+      if (exists(frompath) && !is_directory(frompath))
+      {
+        files.push_back(std::make_pair(frompath, itr->second));
+      } else if (exists(frompath) && is_directory(frompath)) {
+        QFileInfoList entries = QDir(toQString(frompath)).entryInfoList(QDir::Files);
+        for (QFileInfoList::const_iterator entry = entries.begin(); entry != entries.end(); ++entry)
+        {
+          files.push_back(std::make_pair(toPath(entry->absoluteFilePath()), itr->second / toPath(entry->fileName())));
+        }
+      } else {
+        throw std::runtime_error("Unable to find required file while creating RemoteWorkerProcess: " + toString(itr->first) + ": " + toString(itr->second) + " basepath: " + toString(t_basePath));
+      }
+
+      for (std::vector<std::pair<openstudio::path, openstudio::path> >::const_iterator file = files.begin();
+           file != files.end();
+           ++file)
+      {
+        QString relative = outdir.relativeFilePath(toQString(file->second));
+        if (relative.startsWith("..") || QDir::isAbsolutePath(relative))
+        {
+          LOG(Warn, "Required file " << toString(file->second) << " is outside of the output directory, placing it in the run directory");
+          relative = QFileInfo(toQString(file->second)).fileName();
+        }
+
+        std::string hash = hashFile(file->first);
+
+        QVariantMap input;
+        input["path"] = relative;
+        input["hash"] = toQString(hash);
+        info.files.push_back(input);
+        info.sources[hash] = file->first;
+        inputFiles.push_back(RunManager_Util::dirFile(file->first));
+      }
+    }
+
+    // the run directory on the worker stands in for the output directory, other files named by
+    // absolute paths are sent along with the inputs
+    QString outprefix = outdir.absolutePath() + "/";
+    for (std::vector<std::string>::const_iterator itr = t_parameters.begin(); itr != t_parameters.end(); ++itr)
+    {
+      QString param = toQString(*itr);
+      if (QDir::fromNativeSeparators(param).startsWith(outprefix))
+      {
+        param = QDir::fromNativeSeparators(param).mid(outprefix.size());
+      } else if (QDir::isAbsolutePath(param)) {
+        QFileInfo fi(param);
+        if (fi.isDir())
+        {
+          throw std::runtime_error("Directory parameter " + *itr + " cannot be used on a remote worker");
+        } else if (fi.isFile()) {
+          openstudio::path file = toPath(fi.absoluteFilePath());
+          std::string hash = hashFile(file);
+
+          QString relative = "external/" + toQString(hash) + "/" + fi.fileName();
+          QVariantMap input;
+          input["path"] = relative;
+          input["hash"] = toQString(hash);
+          info.files.push_back(input);
+          info.sources[hash] = file;
+          param = relative;
+        }
+      }
+      info.args.push_back(param);
+    }
+
+    openstudio::UUID uuid = openstudio::UUID::createUuid();
+    info.process = boost::shared_ptr<RemoteWorkerProcess>(new RemoteWorkerProcess(uuid, inputFiles, t_outdir));
+
+    QObject::connect(info.process.get(), SIGNAL(requestStart(const openstudio::UUID &)),
+        this, SLOT(processRequestStart(const openstudio::UUID &)));
+
+    QObject::connect(info.process.get(), SIGNAL(requestStop(const openstudio::UUID &)),
+        this, SLOT(processRequestStop(const openstudio::UUID &)));
+
+    QMutexLocker l(&m_mutex);
+    m_processes[uuid] = info;
+    return info.process;
+  }
+
+  void RemoteWorkerManager::processRequestStart(const openstudio::UUID &t_uuid)
+  {
+    QMutexLocker l(&m_mutex);
+
+    std::map<openstudio::UUID, ProcessInfo>::iterator itr = m_processes.find(t_uuid);
+    if (itr == m_processes.end() || itr->second.worker >= 0
+        || std::find(m_waiting.begin(), m_waiting.end(), t_uuid) != m_waiting.end())
+    {
+      return;
+    }
+
+    itr->second.process->statusChangedNotice(AdvancedStatus(AdvancedStatusEnum::WaitingInQueue));
+    m_waiting.push_back(t_uuid);
+    assign();
+  }
+
+  void RemoteWorkerManager::processRequestStop(const openstudio::UUID &t_uuid)
+  {
+    QMutexLocker l(&m_mutex);
+
+    std::map<openstudio::UUID, ProcessInfo>::iterator itr = m_processes.find(t_uuid);
+    if (itr == m_processes.end())
+    {
+      return;
+    }
+
+    if (itr->second.worker >= 0)
+    {
+      // the worker reports the killed process as finished, its outputs are still copied back
+      QVariantMap kill;
+      kill["job"] = itr->second.job;
+      send(itr->second.worker, detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::Kill, kill));
+    } else {
+      boost::shared_ptr<RemoteWorkerProcess> process = itr->second.process;
+      m_waiting.erase(std::remove(m_waiting.begin(), m_waiting.end(), t_uuid), m_waiting.end());
+      m_processes.erase(itr);
+      process->finishedNotice(-1, QProcess::CrashExit);
+    }
+  }
+
+  void RemoteWorkerManager::assign()
+  {
+    for (std::deque<openstudio::UUID>::iterator waiting = m_waiting.begin(); waiting != m_waiting.end(); )
+    {
+      std::map<openstudio::UUID, ProcessInfo>::iterator itr = m_processes.find(*waiting);
+      if (itr == m_processes.end())
+      {
+        waiting = m_waiting.erase(waiting);
+        continue;
+      }
+
+      int best = -1;
+      int bestFree = 0;
+      for (std::map<int, Worker>::const_iterator worker = m_workers.begin(); worker != m_workers.end(); ++worker)
+      {
+        int free = worker->second.slotCount - static_cast<int>(worker->second.processes.size());
+        if (worker->second.state == Worker::Ready && free > bestFree && worker->second.tools.count(itr->second.toolName))
+        {
+          best = worker->first;
+          bestFree = free;
+        }
+      }
+
+      if (best < 0)
+      {
+        // no worker offering the tool has a free slot, later processes may still fit elsewhere
+        ++waiting;
+        continue;
+      }
+
+      openstudio::UUID uuid = *waiting;
+      waiting = m_waiting.erase(waiting);
+
+      ProcessInfo &info = itr->second;
+      info.worker = best;
+      info.job = ++m_nextJob;
+      m_jobs[info.job] = uuid;
+      m_workers.find(best)->second.processes.insert(uuid);
+
+      LOG(Info, "Submitting " << info.toolName << " to remote worker " << m_workers.find(best)->second.endpoint.toString());
+
+      QVariantMap submit;
+      submit["job"] = info.job;
+      submit["tool"] = toQString(info.toolName);
+      submit["args"] = info.args;
+      submit["stdin"] = info.stdinData;
+      submit["files"] = info.files;
+
+      info.process->statusChangedNotice(AdvancedStatus(AdvancedStatusEnum::CopyingRequiredFiles));
+      send(best, detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::Submit, submit));
+    }
+  }
+
+  void RemoteWorkerManager::connectWorkers()
+  {
+    QMutexLocker l(&m_mutex);
+
+    // drop the workers no longer listed
+    std::vector<int> removed;
+    for (std::map<int, Worker>::const_iterator itr = m_workers.begin(); itr != m_workers.end(); ++itr)
+    {
+      if (std::find(m_endpoints.begin(), m_endpoints.end(), itr->second.endpoint) == m_endpoints.end())
+      {
+        removed.push_back(itr->first);
+      }
+    }
+
+    for (std::vector<int>::const_iterator itr = removed.begin(); itr != removed.end(); ++itr)
+    {
+      dropWorker(*itr, "worker removed");
+      m_workers.erase(*itr);
+    }
+
+    for (std::vector<RemoteWorkerEndpoint>::const_iterator endpoint = m_endpoints.begin(); endpoint != m_endpoints.end(); ++endpoint)
+    {
+      bool known = false;
+      for (std::map<int, Worker>::const_iterator itr = m_workers.begin(); itr != m_workers.end(); ++itr)
+      {
+        if (itr->second.endpoint == *endpoint)
+        {
+          known = true;
+          break;
+        }
+      }
+
+      if (!known)
+      {
+        m_workers.insert(std::make_pair(++m_nextWorker, Worker(*endpoint)));
+      }
+    }
+
+    for (std::map<int, Worker>::iterator itr = m_workers.begin(); itr != m_workers.end(); ++itr)
+    {
+      Worker &worker = itr->second;
+      if (worker.device)
+      {
+        continue;
+      }
+
+      LOG(Info, "Connecting to remote worker " << worker.endpoint.toString());
+
+      worker.reader = boost::shared_ptr<detail::RemoteWorkerFrameReader>(new detail::RemoteWorkerFrameReader());
+
+      // sockets are deleted later, they may be dropped from within their own signals
+      if (worker.endpoint.socketName.empty())
+      {
+        QTcpSocket *socket = new QTcpSocket();
+        worker.device = boost::shared_ptr<QIODevice>(socket, boost::bind(&QObject::deleteLater, _1));
+        connect(socket, SIGNAL(readyRead()), this, SLOT(workerReadyRead()));
+        connect(socket, SIGNAL(disconnected()), this, SLOT(workerDisconnected()));
+        connect(socket, SIGNAL(error(QAbstractSocket::SocketError)), this, SLOT(workerTcpError(QAbstractSocket::SocketError)));
+        socket->connectToHost(toQString(worker.endpoint.host), worker.endpoint.port);
+      } else {
+        QLocalSocket *socket = new QLocalSocket();
+        worker.device = boost::shared_ptr<QIODevice>(socket, boost::bind(&QObject::deleteLater, _1));
+        connect(socket, SIGNAL(readyRead()), this, SLOT(workerReadyRead()));
+        connect(socket, SIGNAL(disconnected()), this, SLOT(workerDisconnected()));
+        connect(socket, SIGNAL(error(QLocalSocket::LocalSocketError)), this, SLOT(workerLocalError(QLocalSocket::LocalSocketError)));
+        socket->connectToServer(toQString(worker.endpoint.socketName));
+      }
+    }
+  }
+
+  int RemoteWorkerManager::workerOf(QObject *t_device) const
+  {
+    for (std::map<int, Worker>::const_iterator itr = m_workers.begin(); itr != m_workers.end(); ++itr)
+    {
+      if (itr->second.device && itr->second.device.get() == t_device)
+      {
+        return itr->first;
+      }
+    }
+
+    return -1;
+  }
+
+  RemoteWorkerManager::ProcessInfo *RemoteWorkerManager::processOfJob(int t_job)
+  {
+    std::map<int, openstudio::UUID>::const_iterator job = m_jobs.find(t_job);
+    if (job == m_jobs.end())
+    {
+      return 0;
+    }
+
+    std::map<openstudio::UUID, ProcessInfo>::iterator itr = m_processes.find(job->second);
+    return itr == m_processes.end() ? 0 : &itr->second;
+  }
+
+  void RemoteWorkerManager::workerReadyRead()
+  {
+    QMutexLocker l(&m_mutex);
+
+    int id = workerOf(sender());
+    if (id < 0)
+    {
+      return;
+    }
+
+    boost::shared_ptr<QIODevice> device = m_workers.find(id)->second.device;
+    boost::shared_ptr<detail::RemoteWorkerFrameReader> reader = m_workers.find(id)->second.reader;
+    reader->append(device->readAll());
+
+    try {
+      while (boost::optional<detail::RemoteWorkerMessage> message = reader->next())
+      {
+        handle(id, *message);
+
+        std::map<int, Worker>::const_iterator worker = m_workers.find(id);
+        if (worker == m_workers.end() || worker->second.device != device)
+        {
+          return;
+        }
+      }
+    } catch (const std::exception &e) {
+      dropWorker(id, e.what());
+    }
+  }
+
+  void RemoteWorkerManager::workerDisconnected()
+  {
+    QMutexLocker l(&m_mutex);
+
+    int id = workerOf(sender());
+    if (id >= 0)
+    {
+      dropWorker(id, "connection closed");
+    }
+  }
+
+  void RemoteWorkerManager::workerTcpError(QAbstractSocket::SocketError)
+  {
+    QMutexLocker l(&m_mutex);
+
+    QTcpSocket *socket = qobject_cast<QTcpSocket *>(sender());
+    int id = workerOf(sender());
+    if (id >= 0 && socket)
+    {
+      dropWorker(id, toString(socket->errorString()));
+    }
+  }
+
+  void RemoteWorkerManager::workerLocalError(QLocalSocket::LocalSocketError)
+  {
+    QMutexLocker l(&m_mutex);
+
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+    int id = workerOf(sender());
+    if (id >= 0 && socket)
+    {
+      dropWorker(id, toString(socket->errorString()));
+    }
+  }
+
+  void RemoteWorkerManager::dropWorker(int t_worker, const std::string &t_reason)
+  {
+    std::map<int, Worker>::iterator itr = m_workers.find(t_worker);
+    if (itr == m_workers.end() || !itr->second.device)
+    {
+      return;
+    }
+
+    Worker &worker = itr->second;
+    LOG(Warn, "Lost remote worker " << worker.endpoint.toString() << ": " << t_reason);
+
+    worker.device->disconnect(this);
+    worker.device->close();
+    worker.device.reset();
+    worker.reader.reset();
+    worker.state = Worker::Connecting;
+    worker.nonce.clear();
+
+    std::set<openstudio::UUID> processes;
+    processes.swap(worker.processes);
+
+    for (std::set<openstudio::UUID>::const_iterator uuid = processes.begin(); uuid != processes.end(); ++uuid)
+    {
+      std::map<openstudio::UUID, ProcessInfo>::iterator info = m_processes.find(*uuid);
+      if (info != m_processes.end())
+      {
+        boost::shared_ptr<RemoteWorkerProcess> process = info->second.process;
+        m_jobs.erase(info->second.job);
+        m_processes.erase(info);
+        process->errorNotice(QProcess::Crashed, "Lost connection to remote worker " + worker.endpoint.toString() + ": " + t_reason);
+      }
+    }
+
+    QTimer::singleShot(ReconnectMSecs, this, SLOT(connectWorkers()));
+  }
+
+  void RemoteWorkerManager::send(int t_worker, const detail::RemoteWorkerMessage &t_message)
+  {
+    std::map<int, Worker>::iterator itr = m_workers.find(t_worker);
+    if (itr != m_workers.end() && itr->second.device)
+    {
+      itr->second.device->write(t_message.encode());
+    }
+  }
+
+  void RemoteWorkerManager::handle(int t_worker, const detail::RemoteWorkerMessage &t_message)
+  {
+    const QVariantMap &data = t_message.data;
+    Worker &worker = m_workers.find(t_worker)->second;
+
+    // until the worker has answered our nonce nothing it says can be trusted, a connection that
+    // skips a step of the authentication is dropped
+    if ((t_message.type == detail::RemoteWorkerMessage::Challenge && worker.state != Worker::Connecting)
+        || (t_message.type == detail::RemoteWorkerMessage::Hello && worker.state != Worker::Authenticating)
+        || (t_message.type != detail::RemoteWorkerMessage::Challenge && t_message.type != detail::RemoteWorkerMessage::Hello
+            && worker.state != Worker::Ready))
+    {
+      throw std::runtime_error("remote worker sent message " + boost::lexical_cast<std::string>(t_message.type)
+          + " out of turn, it has not authenticated");
+    }
+
+    switch (t_message.type)
+    {
+      case detail::RemoteWorkerMessage::Challenge:
+        {
+          if (data["protocol"].toInt() != detail::RemoteWorkerMessage::ProtocolVersion)
+          {
+            throw std::runtime_error("remote worker speaks protocol version " + toString(data["protocol"].toString()));
+          }
+
+          worker.nonce = detail::remoteWorkerNonce();
+          worker.state = Worker::Authenticating;
+
+          QVariantMap authenticate;
+          authenticate["response"] = detail::remoteWorkerResponse(worker.endpoint.secret, detail::RemoteWorkerManagerRole,
+              data["nonce"].toByteArray());
+          authenticate["nonce"] = worker.nonce;
+          send(t_worker, detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::Authenticate, authenticate));
+        }
+        break;
+      case detail::RemoteWorkerMessage::Hello:
+        {
+          QByteArray expected = detail::remoteWorkerResponse(worker.endpoint.secret, detail::RemoteWorkerWorkerRole, worker.nonce);
+          if (!detail::remoteWorkerResponseMatches(data["response"].toByteArray(), expected))
+          {
+            throw std::runtime_error("remote worker failed to authenticate");
+          }
+
+          worker.slotCount = std::max(1, data["slots"].toInt());
+          worker.tools.clear();
+          QStringList tools = data["tools"].toStringList();
+          for (QStringList::const_iterator itr = tools.begin(); itr != tools.end(); ++itr)
+          {
+            worker.tools.insert(toString(*itr));
+          }
+          worker.state = Worker::Ready;
+          LOG(Info, "Remote worker " << worker.endpoint.toString() << " ready with " << worker.slotCount << " slots and tools " << toString(tools.join(", ")));
+          assign();
+        }
+        break;
+      case detail::RemoteWorkerMessage::NeedFiles:
+        needFiles(t_worker, data);
+        break;
+      case detail::RemoteWorkerMessage::Started:
+        if (ProcessInfo *info = processOfJob(data["job"].toInt()))
+        {
+          info->started = true;
+          info->process->startedNotice();
+        }
+        break;
+      case detail::RemoteWorkerMessage::StdOut:
+      case detail::RemoteWorkerMessage::StdErr:
+        if (ProcessInfo *info = processOfJob(data["job"].toInt()))
+        {
+          QByteArray bytes = data["data"].toByteArray();
+          std::string text(bytes.constData(), bytes.size());
+          if (t_message.type == detail::RemoteWorkerMessage::StdOut)
+          {
+            info->process->stdOutNotice(text);
+          } else {
+            info->process->stdErrNotice(text);
+          }
+        }
+        break;
+      case detail::RemoteWorkerMessage::Finished:
+        finished(t_worker, data);
+        break;
+      case detail::RemoteWorkerMessage::OutputData:
+        outputData(data);
+        break;
+      case detail::RemoteWorkerMessage::Fetched:
+        fetched(t_worker, data);
+        break;
+      default:
+        LOG(Warn, "Ignoring unexpected remote worker message " << t_message.type);
+    }
+  }
+
+  void RemoteWorkerManager::needFiles(int t_worker, const QVariantMap &t_data)
+  {
+    ProcessInfo *info = processOfJob(t_data["job"].toInt());
+    if (!info)
+    {
+      return;
+    }
+
+    std::map<int, Worker>::iterator worker = m_workers.find(t_worker);
+    QStringList hashes = t_data["hashes"].toStringList();
+
+    for (QStringList::const_iterator itr = hashes.begin(); itr != hashes.end(); ++itr)
+    {
+      std::map<std::string, openstudio::path>::const_iterator source = info->sources.find(toString(*itr));
+
+      try {
+        if (source == info->sources.end())
+        {
+          throw std::runtime_error("remote worker asked for an unknown file " + toString(*itr));
+        }
+
+        QVariantMap data;
+        data["hash"] = *itr;
+        detail::sendRemoteWorkerFile(*worker->second.device, detail::RemoteWorkerMessage::FileData, data, source->second);
+        ++m_filesSent;
+      } catch (const std::exception &e) {
+        LOG(Error, "Unable to send input file: " << e.what());
+
+        // the worker reports the job as failed
+        QVariantMap kill;
+        kill["job"] = info->job;
+        send(t_worker, detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::Kill, kill));
+        return;
+      }
+    }
+  }
+
+  void RemoteWorkerManager::finished(int t_worker, const QVariantMap &t_data)
+  {
+    ProcessInfo *info = processOfJob(t_data["job"].toInt());
+    if (!info)
+    {
+      return;
+    }
+
+    info->exitCode = t_data["exitCode"].toInt();
+    info->crashed = t_data["crashed"].toBool();
+    info->error = toString(t_data["error"].toString());
+
+    if (!info->error.empty())
+    {
+      LOG(Error, "Remote worker process failed: " << info->error);
+    }
+
+    // outputs already present locally with the same contents are not copied back
+    QStringList fetch;
+    QVariantList outputs = t_data["outputs"].toList();
+    for (QVariantList::const_iterator itr = outputs.begin(); itr != outputs.end(); ++itr)
+    {
+      QVariantMap output = itr->toMap();
+      QString path = output["path"].toString();
+      if (!detail::isRemoteWorkerRelativePath(path))
+      {
+        LOG(Warn, "Ignoring output file outside of the run directory: " << toString(path));
+        continue;
+      }
+
+      openstudio::path local = info->outdir / toPath(path);
+      info->outputs.push_back(path);
+
+      try {
+        if (!boost::filesystem::exists(local) || hashFile(local) != toString(output["hash"].toString()))
+        {
+          fetch.push_back(path);
+        }
+      } catch (const std::exception &) {
+        fetch.push_back(path);
+      }
+    }
+
+    info->process->statusChangedNotice(AdvancedStatus(AdvancedStatusEnum::CopyingResultFiles));
+
+    QVariantMap request;
+    request["job"] = info->job;
+    request["paths"] = fetch;
+    send(t_worker, detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::Fetch, request));
+  }
+
+  void RemoteWorkerManager::outputData(const QVariantMap &t_data)
+  {
+    ProcessInfo *info = processOfJob(t_data["job"].toInt());
+    if (!info)
+    {
+      return;
+    }
+
+    QString path = t_data["path"].toString();
+    if (!info->outputs.contains(path))
+    {
+      LOG(Warn, "Ignoring unexpected output file " << toString(path));
+      return;
+    }
+
+    openstudio::path local = info->outdir / toPath(path);
+    QIODevice::OpenMode mode = QIODevice::WriteOnly | QIODevice::Append;
+    if (!info->receiving.count(path))
+    {
+      boost::filesystem::create_directories(local.parent_path());
+      mode = QIODevice::WriteOnly | QIODevice::Truncate;
+      info->receiving.insert(path);
+    }
+
+    QFile file(toQString(local));
+    QByteArray bytes = t_data["data"].toByteArray();
+    if (!file.open(mode) || file.write(bytes) != bytes.size())
+    {
+      LOG(Error, "Unable to write output file " << toString(local));
+    }
+
+    if (t_data["last"].toBool())
+    {
+      info->receiving.erase(path);
+    }
+  }
+
+  void RemoteWorkerManager::fetched(int t_worker, const QVariantMap &t_data)
+  {
+    ProcessInfo *info = processOfJob(t_data["job"].toInt());
+    if (!info)
+    {
+      return;
+    }
+
+    QVariantMap release;
+    release["job"] = info->job;
+    send(t_worker, detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::Release, release));
+
+    std::vector<FileInfo> outputs;
+    for (QStringList::const_iterator itr = info->outputs.begin(); itr != info->outputs.end(); ++itr)
+    {
+      openstudio::path local = info->outdir / toPath(*itr);
+      if (boost::filesystem::exists(local))
+      {
+        outputs.push_back(RunManager_Util::dirFile(local));
+      }
+    }
+
+    ProcessInfo done = *info;
+    m_workers.find(t_worker)->second.processes.erase(done.process->procid());
+    m_jobs.erase(done.job);
+    m_processes.erase(done.process->procid());
+
+    done.process->outputFilesNotice(outputs);
+
+    if (!done.started && !done.error.empty())
+    {
+      done.process->errorNotice(QProcess::FailedToStart, done.error);
+    } else {
+      done.process->finishedNotice(done.exitCode, done.crashed ? QProcess::CrashExit : QProcess::NormalExit);
+    }
+
+    assign();
+  }
+
+}
+}
@@ -0,0 +1,212 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef OPENSTUDIO_RUNMANAGER_LIB_REMOTEWORKERMANAGER_HPP
+#define OPENSTUDIO_RUNMANAGER_LIB_REMOTEWORKERMANAGER_HPP
+
+#include "ProcessCreator.hpp"
+#include "RemoteWorkerEndpoint.hpp"
+#include "RemoteWorkerProcess.hpp"
+
+#include <utilities/core/Logger.hpp>
+#include <utilities/core/Path.hpp>
+#include <utilities/core/UUID.hpp>
+
+#include <QAbstractSocket>
+#include <QByteArray>
+#include <QDateTime>
+#include <QLocalSocket>
+#include <QMutex>
+#include <QStringList>
+#include <QVariant>
+
+#include <boost/shared_ptr.hpp>
+
+#include <deque>
+#include <map>
+#include <set>
+#include <vector>
+
+class QIODevice;
+
+namespace openstudio {
+namespace runmanager {
+
+namespace detail {
+  class RemoteWorkerFrameReader;
+  struct RemoteWorkerMessage;
+}
+
+  /// ProcessCreator implementation that runs tools on RemoteWorker daemons.
+  ///
+  /// Input files are identified by the SHA-1 hash of their contents, a worker is only sent the files
+  /// it does not already have. Workers push the progress of each process as it happens. Processes are
+  /// assigned to the connected worker with the most free slots, and wait in a queue while all slots
+  /// are taken. Connections are made, and remade after they are lost, from the thread the manager
+  /// lives in, which needs a running event loop.
+  ///
+  /// Parameters are passed to the tool verbatim, except that paths inside the output directory are
+  /// made relative to it and other absolute paths of files are sent to the worker with the inputs.
+  /// Directories outside of the output directory cannot be passed, see Job::workerRunnable.
+  class RUNMANAGER_API RemoteWorkerManager : public ProcessCreator
+  {
+    Q_OBJECT;
+
+    public:
+      RemoteWorkerManager();
+      virtual ~RemoteWorkerManager();
+
+      /// Sets the workers to use. Connections are made from the manager's thread, connections to
+      /// workers no longer listed are closed and their processes fail
+      void setWorkers(const std::vector<RemoteWorkerEndpoint> &t_workers);
+
+      /// \returns the workers in use
+      std::vector<RemoteWorkerEndpoint> workers() const;
+
+      /// \returns the number of slots of connected workers not taken by a process
+      int freeSlots() const;
+
+      /// \returns the names of the tools offered by the connected workers
+      std::set<std::string> tools() const;
+
+      /// \returns the number of processes started and not yet finished
+      int activeProcesses() const;
+
+      /// \returns the number of input files sent to workers so far
+      int filesSent() const;
+
+      virtual boost::shared_ptr<Process> createProcess(
+          const openstudio::runmanager::ToolInfo &t_tool,
+          const std::vector<std::pair<openstudio::path, openstudio::path> > &t_requiredFiles,
+          const std::vector<std::string> &t_parameters,
+          const openstudio::path &t_outdir,
+          const std::vector<openstudio::path> &t_expectedOutputFiles,
+          const std::string &t_stdin,
+          const openstudio::path &t_basePath,
+          const boost::optional<std::pair<int,int> > &t_remoteId);
+
+      /// \returns true
+      virtual bool isRemoteManager() const
+      {
+        return true;
+      }
+
+      /// Time to wait before reconnecting to a worker that could not be reached
+      static const int ReconnectMSecs;
+
+    private slots:
+      void connectWorkers();
+
+      void processRequestStart(const openstudio::UUID &t_uuid);
+      void processRequestStop(const openstudio::UUID &t_uuid);
+
+      void workerReadyRead();
+      void workerDisconnected();
+      void workerTcpError(QAbstractSocket::SocketError);
+      void workerLocalError(QLocalSocket::LocalSocketError);
+
+    private:
+      REGISTER_LOGGER("openstudio.runmanager.RemoteWorkerManager");
+
+      struct Worker
+      {
+        /// Progress of the authentication of a connection, nothing but the next step is accepted
+        enum State
+        {
+          Connecting,     ///< waiting for the worker's Challenge
+          Authenticating, ///< Authenticate sent, waiting for the worker's Hello answering our nonce
+          Ready           ///< both sides proved they know the secret, jobs may be submitted
+        };
+
+        Worker(const RemoteWorkerEndpoint &t_endpoint);
+
+        RemoteWorkerEndpoint endpoint;
+        boost::shared_ptr<QIODevice> device;
+        boost::shared_ptr<detail::RemoteWorkerFrameReader> reader;
+        State state;
+        QByteArray nonce;                     ///< nonce the worker has to answer in its Hello
+        int slotCount;
+        std::set<std::string> tools;          ///< tools the worker runs
+        std::set<openstudio::UUID> processes; ///< processes assigned to the worker
+      };
+
+      struct ProcessInfo
+      {
+        ProcessInfo();
+
+        boost::shared_ptr<RemoteWorkerProcess> process;
+        std::string toolName;
+        QStringList args;
+        QByteArray stdinData;
+        openstudio::path outdir;
+        QVariantList files;                             ///< "path" and "hash" of each input
+        std::map<std::string, openstudio::path> sources; ///< local file of each input hash
+        int worker;
+        int job;
+        bool started;
+        int exitCode;
+        bool crashed;
+        std::string error;
+        QStringList outputs;         ///< relative paths of all outputs
+        std::set<QString> receiving; ///< outputs being copied back
+      };
+
+      struct HashedFile
+      {
+        QDateTime lastModified;
+        qint64 size;
+        std::string hash;
+      };
+
+      /// \returns the hash of a local file, reusing the hash of an unchanged file
+      std::string hashFile(const openstudio::path &t_file);
+
+      /// Submits waiting processes to workers offering their tool with free slots
+      void assign();
+
+      void handle(int t_worker, const detail::RemoteWorkerMessage &t_message);
+      void needFiles(int t_worker, const QVariantMap &t_data);
+      void finished(int t_worker, const QVariantMap &t_data);
+      void outputData(const QVariantMap &t_data);
+      void fetched(int t_worker, const QVariantMap &t_data);
+
+      /// Closes the connection to a worker and fails its processes
+      void dropWorker(int t_worker, const std::string &t_reason);
+
+      void send(int t_worker, const detail::RemoteWorkerMessage &t_message);
+
+      int workerOf(QObject *t_device) const;
+      ProcessInfo *processOfJob(int t_job);
+
+      mutable QMutex m_mutex;
+      std::vector<RemoteWorkerEndpoint> m_endpoints;
+      std::map<int, Worker> m_workers;
+      std::map<openstudio::UUID, ProcessInfo> m_processes;
+      std::map<int, openstudio::UUID> m_jobs;
+      std::deque<openstudio::UUID> m_waiting;
+      std::map<openstudio::path, HashedFile> m_hashes;
+      int m_nextWorker;
+      int m_nextJob;
+      int m_filesSent;
+  };
+
+}
+}
+
+#endif // OPENSTUDIO_RUNMANAGER_LIB_REMOTEWORKERMANAGER_HPP
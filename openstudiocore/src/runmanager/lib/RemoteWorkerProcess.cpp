@@ -0,0 +1,167 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include "RemoteWorkerProcess.hpp"
+
+#include <QFile>
+#include <QMutexLocker>
+
+namespace openstudio {
+namespace runmanager {
+
+  RemoteWorkerProcess::RemoteWorkerProcess(const openstudio::UUID &t_procid, const std::vector<FileInfo> &t_inputFiles,
+      const openstudio::path &t_outdir)
+    : m_procid(t_procid), m_outdir(t_outdir), m_starting(false), m_running(false), m_inputFiles(t_inputFiles)
+  {
+  }
+
+  openstudio::UUID RemoteWorkerProcess::procid() const
+  {
+    return m_procid;
+  }
+
+  void RemoteWorkerProcess::waitForFinished()
+  {
+    QMutexLocker l(&m_mutex);
+
+    while (m_starting || m_running)
+    {
+      if (!m_done.wait(&m_mutex, 60000))
+      {
+        LOG(Warn, "Gave up waiting for remote process " << toString(m_procid) << " to finish");
+        return;
+      }
+    }
+  }
+
+  void RemoteWorkerProcess::start()
+  {
+    LOG(Debug, "Requesting remote worker process start");
+    {
+      QMutexLocker l(&m_mutex);
+      m_starting = true;
+    }
+    emit requestStart(m_procid);
+  }
+
+  void RemoteWorkerProcess::stopImpl()
+  {
+    emit requestStop(m_procid);
+  }
+
+  bool RemoteWorkerProcess::running() const
+  {
+    QMutexLocker l(&m_mutex);
+    return m_starting || m_running;
+  }
+
+  void RemoteWorkerProcess::cleanup(const std::vector<std::string> &t_filenames)
+  {
+    QMutexLocker l(&m_mutex);
+
+    for (size_t i = 0; i < t_filenames.size(); ++i)
+    {
+      QFile::remove(toQString(m_outdir / toPath(t_filenames[i])));
+
+      for (std::vector<FileInfo>::iterator itr = m_outputFiles.begin(); itr != m_outputFiles.end(); )
+      {
+        if (itr->filename == t_filenames[i])
+        {
+          itr = m_outputFiles.erase(itr);
+        } else {
+          ++itr;
+        }
+      }
+    }
+  }
+
+  std::vector<FileInfo> RemoteWorkerProcess::outputFiles() const
+  {
+    QMutexLocker l(&m_mutex);
+    return m_outputFiles;
+  }
+
+  std::vector<FileInfo> RemoteWorkerProcess::inputFiles() const
+  {
+    return m_inputFiles;
+  }
+
+  void RemoteWorkerProcess::startedNotice()
+  {
+    {
+      QMutexLocker l(&m_mutex);
+      m_starting = false;
+      m_running = true;
+    }
+    emitStatusChanged(AdvancedStatus(AdvancedStatusEnum::Processing));
+    emit started();
+  }
+
+  void RemoteWorkerProcess::stdOutNotice(const std::string &t_data)
+  {
+    emit standardOutDataAdded(t_data);
+  }
+
+  void RemoteWorkerProcess::stdErrNotice(const std::string &t_data)
+  {
+    emit standardErrDataAdded(t_data);
+  }
+
+  void RemoteWorkerProcess::statusChangedNotice(const openstudio::runmanager::AdvancedStatus &t_status)
+  {
+    emitStatusChanged(t_status);
+  }
+
+  void RemoteWorkerProcess::outputFilesNotice(const std::vector<FileInfo> &t_outputFiles)
+  {
+    {
+      QMutexLocker l(&m_mutex);
+      m_outputFiles = t_outputFiles;
+    }
+
+    for (std::vector<FileInfo>::const_iterator itr = t_outputFiles.begin();
+         itr != t_outputFiles.end();
+         ++itr)
+    {
+      emitOutputFileChanged(*itr);
+    }
+  }
+
+  void RemoteWorkerProcess::errorNotice(QProcess::ProcessError t_error, const std::string &t_description)
+  {
+    setDone();
+    emit error(t_error, t_description);
+  }
+
+  void RemoteWorkerProcess::finishedNotice(int t_exitCode, QProcess::ExitStatus t_exitStatus)
+  {
+    setDone();
+    emit finished(t_exitCode, t_exitStatus);
+  }
+
+  void RemoteWorkerProcess::setDone()
+  {
+    QMutexLocker l(&m_mutex);
+    m_starting = false;
+    m_running = false;
+    m_done.wakeAll();
+  }
+
+}
+}
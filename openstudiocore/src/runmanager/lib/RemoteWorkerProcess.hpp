@@ -0,0 +1,113 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef OPENSTUDIO_RUNMANAGER_LIB_REMOTEWORKERPROCESS_HPP
+#define OPENSTUDIO_RUNMANAGER_LIB_REMOTEWORKERPROCESS_HPP
+
+#include "Process.hpp"
+#include "FileInfo.hpp"
+
+#include <utilities/core/Logger.hpp>
+#include <utilities/core/Path.hpp>
+#include <utilities/core/UUID.hpp>
+
+#include <QMutex>
+#include <QWaitCondition>
+
+namespace openstudio {
+namespace runmanager {
+
+  /// A thin implementation of Process for a tool run by a RemoteWorker. The work is done by the
+  /// RemoteWorkerManager, which reports back through the notice functions.
+  class RUNMANAGER_API RemoteWorkerProcess : public Process
+  {
+    Q_OBJECT;
+
+    public:
+      /// \param[in] t_procid openstudio::UUID uniquely identifying this process
+      /// \param[in] t_inputFiles vector of FileInfo objects used for input to this process
+      /// \param[in] t_outdir Local directory the outputs of the process are copied back to
+      RemoteWorkerProcess(const openstudio::UUID &t_procid, const std::vector<FileInfo> &t_inputFiles,
+          const openstudio::path &t_outdir);
+      virtual ~RemoteWorkerProcess() {}
+
+      // Virtual overloads
+      /// Blocks until the process has finished, must not be called from the thread of the RemoteWorkerManager
+      virtual void waitForFinished();
+      virtual void start();
+      virtual bool running() const;
+      virtual void cleanup(const std::vector<std::string> &t_filenames);
+      virtual std::vector<FileInfo> outputFiles() const;
+      virtual std::vector<FileInfo> inputFiles() const;
+
+      /// Nothing to do, required files are only copied on the worker
+      virtual void cleanUpRequiredFiles() {}
+
+      /// \returns process uuid
+      openstudio::UUID procid() const;
+
+    protected:
+      virtual void stopImpl();
+
+    signals:
+      /// Emitted when the start() method is called
+      void requestStart(const openstudio::UUID &t_procid);
+
+      /// Emitted when the stop() method is called
+      void requestStop(const openstudio::UUID &t_procid);
+
+    private:
+      REGISTER_LOGGER("openstudio.runmanager.RemoteWorkerProcess");
+      friend class RemoteWorkerManager;
+
+      /// called when the worker has started the process
+      void startedNotice();
+
+      /// called with output of the process
+      void stdOutNotice(const std::string &t_data);
+      void stdErrNotice(const std::string &t_data);
+
+      /// called when the status of the remote run changes
+      void statusChangedNotice(const openstudio::runmanager::AdvancedStatus &t_status);
+
+      /// called when the outputs of the process have been copied back
+      void outputFilesNotice(const std::vector<FileInfo> &t_outputFiles);
+
+      /// called if the process could not be run to completion
+      void errorNotice(QProcess::ProcessError t_error, const std::string &t_description);
+
+      /// called when the process has completed and its outputs have been copied back
+      void finishedNotice(int t_exitCode, QProcess::ExitStatus t_exitStatus);
+
+      void setDone();
+
+      openstudio::UUID m_procid;
+      openstudio::path m_outdir;
+      mutable QMutex m_mutex;
+      QWaitCondition m_done;
+      bool m_starting; //< true if process is waiting for a worker
+      bool m_running;  //< true if process is currently running
+      std::vector<FileInfo> m_inputFiles;  //< vector of input files used
+      std::vector<FileInfo> m_outputFiles; //< vector of output files created
+  };
+
+}
+}
+
+#endif // OPENSTUDIO_RUNMANAGER_LIB_REMOTEWORKERPROCESS_HPP
@@ -0,0 +1,331 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include "RemoteWorkerProtocol.hpp"
+
+#include <utilities/core/UUID.hpp>
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QIODevice>
+#include <QRegExp>
+#include <QStringList>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <stdexcept>
+
+namespace openstudio {
+namespace runmanager {
+namespace detail {
+
+  const int RemoteWorkerMessage::ProtocolVersion = 3;
+  const int RemoteWorkerMessage::ChunkSize = 1024 * 1024;
+  const quint32 RemoteWorkerMessage::MaxFrameSize = 64 * 1024 * 1024;
+
+  RemoteWorkerMessage::RemoteWorkerMessage()
+    : type(Hello)
+  {
+  }
+
+  RemoteWorkerMessage::RemoteWorkerMessage(Type t_type, const QVariantMap &t_data)
+    : type(t_type), data(t_data)
+  {
+  }
+
+  QByteArray RemoteWorkerMessage::encode() const
+  {
+    QByteArray payload;
+    {
+      QDataStream stream(&payload, QIODevice::WriteOnly);
+      stream.setVersion(QDataStream::Qt_4_6);
+      stream << quint8(type) << data;
+    }
+
+    QByteArray frame;
+    QDataStream stream(&frame, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_4_6);
+    stream << quint32(payload.size());
+    stream.writeRawData(payload.constData(), payload.size());
+    return frame;
+  }
+
+  RemoteWorkerFrameReader::RemoteWorkerFrameReader()
+  {
+  }
+
+  void RemoteWorkerFrameReader::append(const QByteArray &t_data)
+  {
+    m_buffer.append(t_data);
+  }
+
+  boost::optional<RemoteWorkerMessage> RemoteWorkerFrameReader::next()
+  {
+    if (m_buffer.size() < 4)
+    {
+      return boost::none;
+    }
+
+    quint32 size = 0;
+    {
+      QDataStream stream(m_buffer);
+      stream.setVersion(QDataStream::Qt_4_6);
+      stream >> size;
+    }
+
+    if (size > RemoteWorkerMessage::MaxFrameSize)
+    {
+      throw std::runtime_error("Remote worker frame too large, the stream is corrupt");
+    }
+
+    if (quint32(m_buffer.size()) < 4 + size)
+    {
+      return boost::none;
+    }
+
+    QByteArray payload = m_buffer.mid(4, size);
+    m_buffer.remove(0, 4 + size);
+
+    QDataStream stream(payload);
+    stream.setVersion(QDataStream::Qt_4_6);
+    quint8 type = 0;
+    QVariantMap data;
+    stream >> type >> data;
+
+    if (stream.status() != QDataStream::Ok || type > RemoteWorkerMessage::Authenticate)
+    {
+      throw std::runtime_error("Unable to read remote worker message, the stream is corrupt");
+    }
+
+    return RemoteWorkerMessage(RemoteWorkerMessage::Type(type), data);
+  }
+
+  RemoteWorkerFileCache::RemoteWorkerFileCache(const openstudio::path &t_dir)
+    : m_dir(t_dir)
+  {
+    boost::filesystem::create_directories(m_dir);
+
+    // partial files left behind by a worker that did not shut down cleanly would be appended to
+    QStringList partials = QDir(toQString(m_dir)).entryList(QStringList("*.part"), QDir::Files);
+    for (QStringList::const_iterator itr = partials.begin(); itr != partials.end(); ++itr)
+    {
+      boost::filesystem::remove(m_dir / toPath(*itr));
+    }
+  }
+
+  openstudio::path RemoteWorkerFileCache::cachePath(const std::string &t_hash) const
+  {
+    if (!isRemoteWorkerHash(t_hash))
+    {
+      throw std::runtime_error("Invalid file hash: " + t_hash);
+    }
+
+    return m_dir / toPath(t_hash);
+  }
+
+  openstudio::path RemoteWorkerFileCache::partialPath(const std::string &t_hash) const
+  {
+    return m_dir / toPath(t_hash + ".part");
+  }
+
+  bool RemoteWorkerFileCache::has(const std::string &t_hash) const
+  {
+    return isRemoteWorkerHash(t_hash) && boost::filesystem::exists(cachePath(t_hash));
+  }
+
+  void RemoteWorkerFileCache::receive(const std::string &t_hash, const QByteArray &t_data, bool t_last)
+  {
+    openstudio::path dest = cachePath(t_hash);
+    openstudio::path partial = partialPath(t_hash);
+
+    QIODevice::OpenMode mode = QIODevice::WriteOnly | QIODevice::Append;
+    if (m_receiving.insert(t_hash).second)
+    {
+      mode = QIODevice::WriteOnly | QIODevice::Truncate;
+    }
+
+    {
+      QFile file(toQString(partial));
+      if (!file.open(mode) || file.write(t_data) != t_data.size())
+      {
+        file.close();
+        abandon(t_hash);
+        throw std::runtime_error("Unable to write to file cache: " + toString(partial));
+      }
+    }
+
+    if (t_last)
+    {
+      m_receiving.erase(t_hash);
+
+      if (hashFile(partial) != t_hash)
+      {
+        boost::filesystem::remove(partial);
+        throw std::runtime_error("Received file does not match its hash " + t_hash);
+      }
+
+      boost::filesystem::remove(dest);
+      boost::filesystem::rename(partial, dest);
+      LOG(Debug, "Cached file " << t_hash);
+    }
+  }
+
+  void RemoteWorkerFileCache::abandon(const std::string &t_hash)
+  {
+    m_receiving.erase(t_hash);
+    boost::filesystem::remove(partialPath(t_hash));
+  }
+
+  void RemoteWorkerFileCache::install(const std::string &t_hash, const openstudio::path &t_dest) const
+  {
+    boost::filesystem::create_directories(t_dest.parent_path());
+    boost::filesystem::remove(t_dest);
+    boost::filesystem::copy_file(cachePath(t_hash), t_dest);
+  }
+
+  std::string RemoteWorkerFileCache::hashFile(const openstudio::path &t_file)
+  {
+    QFile file(toQString(t_file));
+    if (!file.open(QIODevice::ReadOnly))
+    {
+      throw std::runtime_error("Unable to open file to hash: " + toString(t_file));
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    while (!file.atEnd())
+    {
+      hash.addData(file.read(RemoteWorkerMessage::ChunkSize));
+    }
+
+    return toString(QString(hash.result().toHex()));
+  }
+
+  QByteArray remoteWorkerHmac(const QByteArray &t_key, const QByteArray &t_message)
+  {
+    const int blockSize = 64; // of SHA-1
+
+    QByteArray key = t_key;
+    if (key.size() > blockSize)
+    {
+      key = QCryptographicHash::hash(key, QCryptographicHash::Sha1);
+    }
+    key.append(QByteArray(blockSize - key.size(), '\0'));
+
+    QByteArray innerPad(blockSize, '\x36');
+    QByteArray outerPad(blockSize, '\x5c');
+    for (int i = 0; i < blockSize; ++i)
+    {
+      innerPad[i] = innerPad[i] ^ key[i];
+      outerPad[i] = outerPad[i] ^ key[i];
+    }
+
+    QByteArray inner = QCryptographicHash::hash(innerPad + t_message, QCryptographicHash::Sha1);
+    return QCryptographicHash::hash(outerPad + inner, QCryptographicHash::Sha1);
+  }
+
+  QByteArray remoteWorkerResponse(const std::string &t_secret, RemoteWorkerRole t_role, const QByteArray &t_nonce)
+  {
+    QByteArray message(t_role == RemoteWorkerManagerRole ? "manager:" : "worker:");
+    message.append(t_nonce);
+    return remoteWorkerHmac(QByteArray(t_secret.data(), t_secret.size()), message).toHex();
+  }
+
+  bool remoteWorkerResponseMatches(const QByteArray &t_response, const QByteArray &t_expected)
+  {
+    // compare every byte so the time taken does not tell how much of the response was right
+    bool match = t_response.size() == t_expected.size();
+    for (int i = 0; i < t_expected.size() && i < t_response.size(); ++i)
+    {
+      match = (t_response[i] == t_expected[i]) && match;
+    }
+    return match;
+  }
+
+  QByteArray remoteWorkerNonce()
+  {
+    return (openstudio::createUUID().toString() + openstudio::createUUID().toString()).toUtf8();
+  }
+
+  bool isRemoteWorkerHash(const std::string &t_hash)
+  {
+    if (t_hash.size() != 40)
+    {
+      return false;
+    }
+
+    for (std::string::const_iterator itr = t_hash.begin(); itr != t_hash.end(); ++itr)
+    {
+      if (!((*itr >= '0' && *itr <= '9') || (*itr >= 'a' && *itr <= 'f')))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool isRemoteWorkerRelativePath(const QString &t_path)
+  {
+    if (t_path.isEmpty() || t_path.startsWith('/') || t_path.startsWith('\\') || t_path.contains(':'))
+    {
+      return false;
+    }
+
+    return !t_path.split(QRegExp("[/\\\\]")).contains("..");
+  }
+
+  bool isRemoteWorkerPortableParameter(const QString &t_param, const QString &t_outdir)
+  {
+    QString param = QDir::fromNativeSeparators(t_param);
+    if (param.startsWith("-I"))
+    {
+      param = param.mid(2);
+    }
+
+    if (param.isEmpty() || !QDir::isAbsolutePath(param))
+    {
+      return true;
+    }
+
+    QString outprefix = QDir::fromNativeSeparators(QDir(t_outdir).absolutePath()) + "/";
+    return param.startsWith(outprefix);
+  }
+
+  void sendRemoteWorkerFile(QIODevice &t_device, RemoteWorkerMessage::Type t_type,
+      const QVariantMap &t_data, const openstudio::path &t_file)
+  {
+    QFile file(toQString(t_file));
+    if (!file.open(QIODevice::ReadOnly))
+    {
+      throw std::runtime_error("Unable to open file to send: " + toString(t_file));
+    }
+
+    do {
+      QVariantMap chunk = t_data;
+      chunk["data"] = file.read(RemoteWorkerMessage::ChunkSize);
+      chunk["last"] = file.atEnd();
+      t_device.write(RemoteWorkerMessage(t_type, chunk).encode());
+    } while (!file.atEnd());
+  }
+
+}
+}
+}
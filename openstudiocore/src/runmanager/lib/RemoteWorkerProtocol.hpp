@@ -0,0 +1,187 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef OPENSTUDIO_RUNMANAGER_LIB_REMOTEWORKERPROTOCOL_HPP
+#define OPENSTUDIO_RUNMANAGER_LIB_REMOTEWORKERPROTOCOL_HPP
+
+#include "RunManagerAPI.hpp"
+
+#include <utilities/core/Logger.hpp>
+#include <utilities/core/Path.hpp>
+
+#include <QByteArray>
+#include <QVariant>
+
+#include <boost/optional.hpp>
+
+#include <set>
+#include <string>
+
+class QIODevice;
+
+namespace openstudio {
+namespace runmanager {
+namespace detail {
+
+  /// A message exchanged between a RemoteWorkerManager and a RemoteWorker.
+  ///
+  /// On the wire each message is a frame: a quint32 byte count followed by a QDataStream
+  /// holding the quint8 message type and a QVariantMap with the message data. Messages from
+  /// the worker are pushed as things happen, the manager never polls.
+  ///
+  /// A connection starts with the worker's Challenge, the manager answers with Authenticate,
+  /// proving it knows the shared secret and challenging the worker in turn, and the worker
+  /// proves the same in its Hello. Only then are jobs exchanged. The shared secret itself is never
+  /// sent, see remoteWorkerResponse.
+  struct RUNMANAGER_API RemoteWorkerMessage
+  {
+    enum Type
+    {
+      Hello,        ///< worker: "protocol", "slots", "name", "tools" the worker is configured to run,
+                    ///<         "response" to the manager's nonce
+      Submit,       ///< manager: "job", "tool", "args", "stdin", "files" (list of "path", "hash")
+      NeedFiles,    ///< worker: "job", "hashes" the worker does not have yet
+      FileData,     ///< manager: "hash", "data", "last", a chunk of a needed file
+      Started,      ///< worker: "job"
+      StdOut,       ///< worker: "job", "data"
+      StdErr,       ///< worker: "job", "data"
+      Finished,     ///< worker: "job", "exitCode", "crashed", "error", "outputs" (list of "path", "hash")
+      Fetch,        ///< manager: "job", "paths" of outputs to send back
+      OutputData,   ///< worker: "job", "path", "data", "last", a chunk of a fetched output
+      Fetched,      ///< worker: "job", all fetched outputs have been sent
+      Release,      ///< manager: "job", the worker may delete the run directory
+      Kill,         ///< manager: "job"
+      Challenge,    ///< worker: "protocol", "nonce", sent as soon as a connection is accepted
+      Authenticate  ///< manager: "response" to the challenge, "nonce" the worker has to answer
+    };
+
+    RemoteWorkerMessage();
+    RemoteWorkerMessage(Type t_type, const QVariantMap &t_data);
+
+    Type type;
+    QVariantMap data;
+
+    /// \returns the message as a complete frame
+    QByteArray encode() const;
+
+    /// Version of the protocol, sent in Hello
+    static const int ProtocolVersion;
+
+    /// Size of the data chunks files are sent in
+    static const int ChunkSize;
+
+    /// Frames larger than this are treated as a corrupt stream
+    static const quint32 MaxFrameSize;
+  };
+
+  /// Splits the byte stream of a connection back into messages
+  class RUNMANAGER_API RemoteWorkerFrameReader
+  {
+    public:
+      RemoteWorkerFrameReader();
+
+      /// Appends data read from the connection
+      void append(const QByteArray &t_data);
+
+      /// \returns the next complete message, if one has been received
+      /// \throws std::runtime_error if the stream is corrupt
+      boost::optional<RemoteWorkerMessage> next();
+
+    private:
+      QByteArray m_buffer;
+  };
+
+  /// Content addressed file store of a RemoteWorker, files are kept by their SHA-1 hash so
+  /// inputs shared by many jobs, weather files and the like, are transferred once per worker
+  class RUNMANAGER_API RemoteWorkerFileCache
+  {
+    public:
+      explicit RemoteWorkerFileCache(const openstudio::path &t_dir);
+
+      /// \returns true if the file with the given hash is in the cache
+      bool has(const std::string &t_hash) const;
+
+      /// Appends a chunk of a file being received, the file is verified against its hash and
+      /// added to the cache with the last chunk. The first chunk starts the file over.
+      /// \throws std::runtime_error if the chunk cannot be written or the received file does not
+      ///         match its hash, the partial file is discarded
+      void receive(const std::string &t_hash, const QByteArray &t_data, bool t_last);
+
+      /// Discards a partially received file, its sender went away
+      void abandon(const std::string &t_hash);
+
+      /// Copies a cached file to t_dest, creating its directory as needed
+      void install(const std::string &t_hash, const openstudio::path &t_dest) const;
+
+      /// \returns the hex SHA-1 hash of the contents of a file
+      static std::string hashFile(const openstudio::path &t_file);
+
+    private:
+      REGISTER_LOGGER("openstudio.runmanager.RemoteWorkerFileCache");
+
+      openstudio::path cachePath(const std::string &t_hash) const;
+      openstudio::path partialPath(const std::string &t_hash) const;
+
+      openstudio::path m_dir;
+      std::set<std::string> m_receiving; ///< hashes of files partially received
+  };
+
+  /// \returns the HMAC-SHA1 (RFC 2104) of t_message keyed with t_key
+  RUNMANAGER_API QByteArray remoteWorkerHmac(const QByteArray &t_key, const QByteArray &t_message);
+
+  /// Side of a connection answering a nonce, part of the response so that an answer given by one
+  /// side can never be replayed as the answer of the other
+  enum RemoteWorkerRole
+  {
+    RemoteWorkerManagerRole,
+    RemoteWorkerWorkerRole
+  };
+
+  /// \returns the answer to the other side's nonce: the hex HMAC-SHA1, keyed with the secret, of
+  ///          the answering role followed by the nonce
+  RUNMANAGER_API QByteArray remoteWorkerResponse(const std::string &t_secret, RemoteWorkerRole t_role,
+      const QByteArray &t_nonce);
+
+  /// \returns true if t_response matches t_expected, taking the same time however much of it matches
+  RUNMANAGER_API bool remoteWorkerResponseMatches(const QByteArray &t_response, const QByteArray &t_expected);
+
+  /// \returns a new random nonce to be answered with remoteWorkerResponse
+  RUNMANAGER_API QByteArray remoteWorkerNonce();
+
+  /// \returns true if t_hash is a well formed hex SHA-1 hash, hashes are used as file names
+  RUNMANAGER_API bool isRemoteWorkerHash(const std::string &t_hash);
+
+  /// \returns true if t_path names a file inside a run directory: it is not absolute and does not
+  ///          climb out of the directory
+  RUNMANAGER_API bool isRemoteWorkerRelativePath(const QString &t_path);
+
+  /// \returns true if a worker can make sense of the tool parameter t_param: it is not an absolute
+  ///          path, alone or after "-I", or it names something inside the output directory t_outdir
+  RUNMANAGER_API bool isRemoteWorkerPortableParameter(const QString &t_param, const QString &t_outdir);
+
+  /// Writes a file to t_device in FileData or OutputData chunks
+  /// \param[in] t_data message data common to every chunk, "data" and "last" are added to it
+  RUNMANAGER_API void sendRemoteWorkerFile(QIODevice &t_device, RemoteWorkerMessage::Type t_type,
+      const QVariantMap &t_data, const openstudio::path &t_file);
+
+}
+}
+}
+
+#endif // OPENSTUDIO_RUNMANAGER_LIB_REMOTEWORKERPROTOCOL_HPP
@@ -26,6 +26,7 @@
 #include "RubyJobUtils.hpp"
 #include "FileInfo.hpp"
 #include "JobOutputCleanup.hpp"
+#include "RemoteWorkerProtocol.hpp"
 
 #include <utilities/time/DateTime.hpp>
 
@@ -188,6 +189,27 @@ namespace detail {
 
   }
 
+  bool RubyJob::workerParametersPortable() const
+  {
+    RubyJobBuilder rjb(params());
+    std::vector<std::string> parameters = rjb.getToolParameters();
+    std::vector<std::string> scriptparams = rjb.getScriptParameters();
+    parameters.insert(parameters.end(), scriptparams.begin(), scriptparams.end());
+
+    QString theoutdir = toQString(outdir());
+    for (std::vector<std::string>::const_iterator itr = parameters.begin();
+         itr != parameters.end();
+         ++itr)
+    {
+      if (!detail::isRemoteWorkerPortableParameter(toQString(*itr), theoutdir))
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
   void RubyJob::getFiles(const RubyJobBuilder &t_rjb)
   {
     LOG(Info, "Getting files");
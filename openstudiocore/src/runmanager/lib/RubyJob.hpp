@@ -77,6 +77,9 @@ namespace detail {
 
       virtual void basePathChanged();
 
+      /// Include directories and script arguments are usually absolute paths on this machine
+      virtual bool workerParametersPortable() const;
+
     private:
       REGISTER_LOGGER("openstudio.runmanager.RubyJob");
 
@@ -0,0 +1,627 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include "RubyWorkerPool.hpp"
+#include "LocalProcess.hpp"
+
+#include <utilities/core/ApplicationPathHelpers.hpp>
+#include <utilities/core/String.hpp>
+
+#include <QProcessEnvironment>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+
+namespace openstudio {
+namespace runmanager {
+namespace detail {
+
+  RubyWorkerPool::RubyWorkerPool(const RubyWorkerPoolOptions &t_options)
+    : m_options(t_options), m_nextId(0), m_generation(0),
+      m_workerScript(openstudio::getSharedResourcesPath() / openstudio::toPath("runmanager") / openstudio::toPath("rubyworker.rb"))
+  {
+    if (!boost::filesystem::exists(m_workerScript))
+    {
+      LOG(Warn, "Ruby worker script " << openstudio::toString(m_workerScript) << " not found, ruby scripts will be run in their own processes");
+    }
+
+    m_thread.start();
+    moveToThread(&m_thread);
+  }
+
+  RubyWorkerPool::~RubyWorkerPool()
+  {
+    QMetaObject::invokeMethod(this, "shutdown", Qt::BlockingQueuedConnection);
+    m_thread.quit();
+    m_thread.wait();
+  }
+
+  RubyWorkerPoolOptions RubyWorkerPool::options() const
+  {
+    QMutexLocker l(&m_mutex);
+    return m_options;
+  }
+
+  void RubyWorkerPool::setOptions(const RubyWorkerPoolOptions &t_options)
+  {
+    QMutexLocker l(&m_mutex);
+    m_options = t_options;
+    ++m_generation;
+    l.unlock();
+
+    QMetaObject::invokeMethod(this, "processQueue", Qt::QueuedConnection);
+  }
+
+  bool RubyWorkerPool::accepts(const openstudio::runmanager::ToolInfo &t_tool,
+      const std::vector<std::string> &t_parameters,
+      const std::string &t_stdin) const
+  {
+    if (t_tool.name != "ruby" || !t_stdin.empty())
+    {
+      return false;
+    }
+
+    QMutexLocker l(&m_mutex);
+    if (m_options.numWorkers == 0)
+    {
+      return false;
+    }
+    l.unlock();
+
+    std::vector<std::string> includeDirs;
+    std::vector<std::string> scriptAndArgs;
+    return boost::filesystem::exists(m_workerScript) 
+      && splitParameters(t_parameters, includeDirs, scriptAndArgs);
+  }
+
+  bool RubyWorkerPool::splitParameters(const std::vector<std::string> &t_parameters,
+      std::vector<std::string> &t_includeDirs,
+      std::vector<std::string> &t_scriptAndArgs)
+  {
+    t_includeDirs.clear();
+    t_scriptAndArgs.clear();
+
+    for (size_t i = 0; i < t_parameters.size(); ++i)
+    {
+      const std::string &param = t_parameters[i];
+
+      if (!t_scriptAndArgs.empty())
+      {
+        t_scriptAndArgs.push_back(param);
+      } else if (param == "-I") {
+        if (++i == t_parameters.size())
+        {
+          return false;
+        }
+        t_includeDirs.push_back(t_parameters[i]);
+      } else if (boost::starts_with(param, "-I")) {
+        t_includeDirs.push_back(param.substr(2));
+      } else if (boost::starts_with(param, "-")) {
+        // any other interpreter option changes how the worker itself would have to be run
+        return false;
+      } else {
+        t_scriptAndArgs.push_back(param);
+      }
+    }
+
+    return !t_scriptAndArgs.empty();
+  }
+
+  int RubyWorkerPool::submit(const openstudio::path &t_ruby,
+      const std::vector<std::string> &t_parameters,
+      const openstudio::path &t_workingDir,
+      const openstudio::path &t_stdout,
+      const openstudio::path &t_stderr)
+  {
+    Request request;
+    std::vector<std::string> scriptAndArgs;
+    if (!splitParameters(t_parameters, request.includeDirs, scriptAndArgs))
+    {
+      throw std::runtime_error("Ruby parameters cannot be run by a ruby worker");
+    }
+    request.ruby = t_ruby;
+
+    // A ruby process started for this script would resolve relative include directories (such as
+    // the "-I." RubyJob adds on some platforms) against t_workingDir. The worker only enters that
+    // directory per request, so relative directories travel with the request and the worker 
+    // expands them there. Absolute ones are given to the worker itself, so preloads can use them.
+    std::vector<std::string> includeDirs;
+    std::vector<std::string> scriptIncludeDirs;
+    for (std::vector<std::string>::const_iterator itr = request.includeDirs.begin();
+         itr != request.includeDirs.end();
+         ++itr)
+    {
+      if (openstudio::toPath(*itr).is_complete())
+      {
+        includeDirs.push_back(*itr);
+      } else {
+        scriptIncludeDirs.push_back(*itr);
+      }
+    }
+    request.includeDirs = includeDirs;
+
+    QMutexLocker l(&m_mutex);
+    request.id = ++m_nextId;
+
+    request.command = "run\t" + boost::lexical_cast<std::string>(request.id)
+      + "\t" + encode(openstudio::toString(t_workingDir))
+      + "\t" + encode(openstudio::toString(t_stdout))
+      + "\t" + encode(openstudio::toString(t_stderr))
+      + "\t" + encode(boost::join(scriptIncludeDirs, "\n"));
+
+    for (std::vector<std::string>::const_iterator itr = scriptAndArgs.begin();
+         itr != scriptAndArgs.end();
+         ++itr)
+    {
+      request.command += "\t" + encode(*itr);
+    }
+    request.command += "\n";
+
+    m_queue.push_back(request);
+    m_active.insert(request.id);
+    l.unlock();
+
+    LOG(Debug, "Queued ruby worker request " << request.id << ": " << request.command);
+    QMetaObject::invokeMethod(this, "processQueue", Qt::QueuedConnection);
+    return request.id;
+  }
+
+  void RubyWorkerPool::cancel(int t_id)
+  {
+    QMutexLocker l(&m_mutex);
+    for (std::deque<Request>::iterator itr = m_queue.begin();
+         itr != m_queue.end();
+         ++itr)
+    {
+      if (itr->id == t_id)
+      {
+        m_queue.erase(itr);
+        l.unlock();
+        finishRequest(t_id, -1, true, "Stopped before a ruby worker was available");
+        return;
+      }
+    }
+    l.unlock();
+
+    QMetaObject::invokeMethod(this, "killRequest", Qt::QueuedConnection, Q_ARG(int, t_id));
+  }
+
+  void RubyWorkerPool::waitForRequest(int t_id)
+  {
+    QMutexLocker l(&m_mutex);
+    while (m_active.count(t_id))
+    {
+      m_requestFinished.wait(&m_mutex);
+    }
+  }
+
+  void RubyWorkerPool::finishRequest(int t_id, int t_exitCode, bool t_crashed, const std::string &t_description)
+  {
+    QMutexLocker l(&m_mutex);
+    if (!m_active.erase(t_id))
+    {
+      return;
+    }
+    m_requestFinished.wakeAll();
+    l.unlock();
+
+    LOG(Debug, "Ruby worker request " << t_id << " finished: " << t_exitCode << " " << t_crashed << " " << t_description);
+    emit requestFinished(t_id, t_exitCode, t_crashed, t_description);
+  }
+
+  std::string RubyWorkerPool::key(const openstudio::path &t_ruby, const std::vector<std::string> &t_includeDirs)
+  {
+    return openstudio::toString(t_ruby) + "\n" + boost::join(t_includeDirs, "\n");
+  }
+
+  std::string RubyWorkerPool::encode(const std::string &t_field)
+  {
+    std::string result;
+    for (std::string::const_iterator itr = t_field.begin();
+         itr != t_field.end();
+         ++itr)
+    {
+      switch (*itr)
+      {
+        case '%':
+          result += "%25";
+          break;
+        case '\t':
+          result += "%09";
+          break;
+        case '\r':
+          result += "%0D";
+          break;
+        case '\n':
+          result += "%0A";
+          break;
+        default:
+          result += *itr;
+      }
+    }
+    return result;
+  }
+
+  void RubyWorkerPool::processQueue()
+  {
+    QMutexLocker l(&m_mutex);
+    RubyWorkerPoolOptions options = m_options;
+    unsigned int generation = m_generation;
+    l.unlock();
+
+    // requests already queued are still served if the pool has been disabled since
+    size_t maxWorkers = std::max(options.numWorkers, 1u);
+
+    // let go of idle workers that no longer match the options
+    size_t numWorkers = 0;
+    for (std::vector<boost::shared_ptr<Worker> >::const_iterator itr = m_workers.begin();
+         itr != m_workers.end();
+         ++itr)
+    {
+      if (!(*itr)->retiring)
+      {
+        ++numWorkers;
+      }
+    }
+
+    for (std::vector<boost::shared_ptr<Worker> >::iterator itr = m_workers.begin();
+         itr != m_workers.end();
+         ++itr)
+    {
+      Worker &worker = **itr;
+      if (!worker.retiring && !worker.request && (worker.generation != generation || numWorkers > maxWorkers))
+      {
+        retire(worker);
+        --numWorkers;
+      }
+    }
+
+    while (true)
+    {
+      l.relock();
+      if (m_queue.empty())
+      {
+        return;
+      }
+      Request request = m_queue.front();
+      l.unlock();
+
+      std::string requestKey = key(request.ruby, request.includeDirs);
+      Worker *worker = 0;
+      Worker *idleOther = 0;
+
+      for (std::vector<boost::shared_ptr<Worker> >::iterator itr = m_workers.begin();
+           itr != m_workers.end();
+           ++itr)
+      {
+        if (!(*itr)->retiring && !(*itr)->request)
+        {
+          if ((*itr)->key == requestKey)
+          {
+            worker = itr->get();
+            break;
+          } else {
+            idleOther = itr->get();
+          }
+        }
+      }
+
+      if (!worker)
+      {
+        if (m_workers.size() < maxWorkers)
+        {
+          worker = startWorker(request, options, generation);
+        } else {
+          // make room for a worker with the right interpreter and include directories
+          if (idleOther)
+          {
+            retire(*idleOther);
+          }
+          return;
+        }
+      }
+
+      l.relock();
+      if (m_queue.empty() || m_queue.front().id != request.id)
+      {
+        // cancelled in the meantime
+        continue;
+      }
+      m_queue.pop_front();
+      l.unlock();
+
+      worker->request = request;
+      dispatch(*worker);
+    }
+  }
+
+  RubyWorkerPool::Worker *RubyWorkerPool::startWorker(const Request &t_request, const RubyWorkerPoolOptions &t_options, unsigned int t_generation)
+  {
+    boost::shared_ptr<Worker> worker(new Worker());
+    worker->key = key(t_request.ruby, t_request.includeDirs);
+    worker->generation = t_generation;
+    worker->process = new QProcess();
+
+    connect(worker->process, SIGNAL(readyReadStandardOutput()), this, SLOT(workerReadyReadStandardOutput()));
+    connect(worker->process, SIGNAL(readyReadStandardError()), this, SLOT(workerReadyReadStandardError()));
+    connect(worker->process, SIGNAL(error(QProcess::ProcessError)), this, SLOT(workerError(QProcess::ProcessError)));
+    connect(worker->process, SIGNAL(finished(int, QProcess::ExitStatus)), this, SLOT(workerFinished(int, QProcess::ExitStatus)));
+
+    QStringList args;
+    for (std::vector<std::string>::const_iterator itr = t_request.includeDirs.begin();
+         itr != t_request.includeDirs.end();
+         ++itr)
+    {
+      args << "-I" << toQString(*itr);
+    }
+
+    args << toQString(m_workerScript);
+
+    for (std::vector<std::string>::const_iterator itr = t_options.preloadLibraries.begin();
+         itr != t_options.preloadLibraries.end();
+         ++itr)
+    {
+      args << toQString(*itr);
+    }
+
+    // same environment a LocalProcess would give the interpreter
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+#ifdef Q_WS_WIN
+    env.insert("PATH", openstudio::toQString(t_request.ruby.parent_path()) + ";" + env.value("PATH"));
+#else
+    env.insert("PATH", openstudio::toQString(t_request.ruby.parent_path()) + ":" + env.value("PATH"));
+#endif
+    worker->process->setProcessEnvironment(env);
+
+    LOG(Info, "Starting ruby worker: " << openstudio::toString(t_request.ruby) << " " << toString(args.join(" ")));
+
+    m_workers.push_back(worker);
+    worker->process->start(openstudio::toQString(t_request.ruby), args);
+    return worker.get();
+  }
+
+  void RubyWorkerPool::dispatch(Worker &t_worker)
+  {
+    if (t_worker.ready && t_worker.request)
+    {
+      t_worker.process->write(t_worker.request->command.c_str(), t_worker.request->command.size());
+      emit requestStarted(t_worker.request->id);
+    }
+  }
+
+  void RubyWorkerPool::retire(Worker &t_worker)
+  {
+    LOG(Info, "Retiring ruby worker after " << t_worker.jobs << " scripts");
+    t_worker.retiring = true;
+    t_worker.process->write("quit\n");
+    t_worker.process->closeWriteChannel();
+  }
+
+  RubyWorkerPool::Worker *RubyWorkerPool::findWorker(QObject *t_process)
+  {
+    for (std::vector<boost::shared_ptr<Worker> >::iterator itr = m_workers.begin();
+         itr != m_workers.end();
+         ++itr)
+    {
+      if ((*itr)->process == t_process)
+      {
+        return itr->get();
+      }
+    }
+
+    return 0;
+  }
+
+  void RubyWorkerPool::removeWorker(QObject *t_process, const std::string &t_reason)
+  {
+    for (std::vector<boost::shared_ptr<Worker> >::iterator itr = m_workers.begin();
+         itr != m_workers.end();
+         ++itr)
+    {
+      if ((*itr)->process == t_process)
+      {
+        boost::shared_ptr<Worker> worker = *itr;
+        m_workers.erase(itr);
+
+        worker->process->disconnect(this);
+        worker->process->deleteLater();
+
+        if (worker->request)
+        {
+          std::string description = t_reason;
+          if (!worker->errors.empty())
+          {
+            description += ": " + worker->errors;
+          }
+          finishRequest(worker->request->id, -1, true, description);
+        }
+        break;
+      }
+    }
+
+    processQueue();
+  }
+
+  void RubyWorkerPool::handleReply(Worker &t_worker, const std::string &t_line)
+  {
+    std::vector<std::string> fields;
+    boost::split(fields, t_line, boost::is_any_of(" "), boost::token_compress_on);
+
+    if (fields.size() < 2 || fields[0] != "OSRUBYWORKER")
+    {
+      LOG(Debug, "Ruby worker output: " << t_line);
+      return;
+    }
+
+    try {
+      if (fields[1] == "ready" && fields.size() >= 4)
+      {
+        t_worker.ready = true;
+        t_worker.forking = (fields[3] == "fork");
+        dispatch(t_worker);
+      } else if (fields[1] == "done" && fields.size() >= 5) {
+        int id = boost::lexical_cast<int>(fields[2]);
+        int exitCode = boost::lexical_cast<int>(fields[3]);
+        unsigned long residentKB = boost::lexical_cast<unsigned long>(fields[4]);
+
+        ++t_worker.jobs;
+        t_worker.request.reset();
+        finishRequest(id, exitCode, exitCode == -1, exitCode == -1 ? "Ruby script was killed" : "");
+
+        RubyWorkerPoolOptions options = this->options();
+        if ((options.maxJobsPerWorker > 0 && t_worker.jobs >= options.maxJobsPerWorker)
+            || (options.maxMemoryMB > 0 && residentKB / 1024 >= options.maxMemoryMB))
+        {
+          retire(t_worker);
+        }
+      } else {
+        LOG(Warn, "Unexpected ruby worker reply: " << t_line);
+      }
+    } catch (const boost::bad_lexical_cast &) {
+      LOG(Warn, "Malformed ruby worker reply: " << t_line);
+    }
+  }
+
+  void RubyWorkerPool::workerReadyReadStandardOutput()
+  {
+    Worker *worker = findWorker(sender());
+    if (!worker)
+    {
+      return;
+    }
+
+    worker->buffer.append(worker->process->readAllStandardOutput());
+
+    int pos;
+    while ((pos = worker->buffer.indexOf('\n')) >= 0)
+    {
+      std::string line(worker->buffer.constData(), pos);
+      worker->buffer.remove(0, pos + 1);
+      boost::trim(line);
+      handleReply(*worker, line);
+    }
+
+    processQueue();
+  }
+
+  void RubyWorkerPool::workerReadyReadStandardError()
+  {
+    Worker *worker = findWorker(sender());
+    if (!worker)
+    {
+      return;
+    }
+
+    QByteArray data = worker->process->readAllStandardError();
+    LOG(Debug, "Ruby worker error output: " << std::string(data.constData(), data.size()));
+
+    // keep the start of it, that is where interpreter and preload failures show up
+    if (worker->errors.size() < 4096)
+    {
+      worker->errors.append(data.constData(), std::min(static_cast<size_t>(data.size()), 4096 - worker->errors.size()));
+    }
+  }
+
+  void RubyWorkerPool::workerError(QProcess::ProcessError t_error)
+  {
+    // every other error is followed by finished()
+    if (t_error == QProcess::FailedToStart)
+    {
+      removeWorker(sender(), "Unable to start ruby worker");
+    } else {
+      LOG(Warn, "Ruby worker process error: " << t_error);
+    }
+  }
+
+  void RubyWorkerPool::workerFinished(int t_exitCode, QProcess::ExitStatus t_exitStatus)
+  {
+    Worker *worker = findWorker(sender());
+    if (worker && !worker->retiring)
+    {
+      LOG(Warn, "Ruby worker exited unexpectedly: " << t_exitCode << " " << t_exitStatus);
+    }
+
+    removeWorker(sender(), "Ruby worker exited with code " + boost::lexical_cast<std::string>(t_exitCode));
+  }
+
+  void RubyWorkerPool::killRequest(int t_id)
+  {
+    for (std::vector<boost::shared_ptr<Worker> >::iterator itr = m_workers.begin();
+         itr != m_workers.end();
+         ++itr)
+    {
+      Worker &worker = **itr;
+      if (worker.request && worker.request->id == t_id)
+      {
+        if (worker.ready && worker.forking)
+        {
+          std::string command = "kill\t" + boost::lexical_cast<std::string>(t_id) + "\n";
+          worker.process->write(command.c_str(), command.size());
+        } else {
+          // the script is running inside the worker itself, the worker has to go
+          worker.retiring = true;
+          LocalProcess::kill(*worker.process, true);
+        }
+        return;
+      }
+    }
+  }
+
+  void RubyWorkerPool::shutdown()
+  {
+    while (!m_workers.empty())
+    {
+      boost::shared_ptr<Worker> worker = m_workers.back();
+      m_workers.pop_back();
+
+      worker->process->disconnect(this);
+      worker->process->write("quit\n");
+      worker->process->closeWriteChannel();
+      if (!worker->process->waitForFinished(5000))
+      {
+        LocalProcess::kill(*worker->process, true);
+        worker->process->waitForFinished();
+      }
+      delete worker->process;
+
+      if (worker->request)
+      {
+        finishRequest(worker->request->id, -1, true, "Ruby worker pool shut down");
+      }
+    }
+
+    QMutexLocker l(&m_mutex);
+    std::deque<Request> queue;
+    queue.swap(m_queue);
+    l.unlock();
+
+    for (std::deque<Request>::const_iterator itr = queue.begin();
+         itr != queue.end();
+         ++itr)
+    {
+      finishRequest(itr->id, -1, true, "Ruby worker pool shut down");
+    }
+  }
+
+}
+}
+}
@@ -0,0 +1,180 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef OPENSTUDIO_RUNMANAGER_RUBYWORKERPOOL_HPP
+#define OPENSTUDIO_RUNMANAGER_RUBYWORKERPOOL_HPP
+
+#include "RubyWorkerPoolOptions.hpp"
+#include "ToolInfo.hpp"
+
+#include <utilities/core/Path.hpp>
+#include <utilities/core/Logger.hpp>
+
+#include <QObject>
+#include <QProcess>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include <boost/optional.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <deque>
+#include <set>
+
+namespace openstudio {
+namespace runmanager {
+namespace detail {
+
+  /**
+   * Runs ruby scripts in a pool of long lived ruby processes started with the rubyworker.rb
+   * resource script. Workers preload the configured libraries once and are then fed requests over
+   * their stdin. Where the platform supports it each script runs in a process forked from the worker,
+   * otherwise in the worker itself; either way a worker is replaced after
+   * RubyWorkerPoolOptions::maxJobsPerWorker scripts or once it has grown past
+   * RubyWorkerPoolOptions::maxMemoryMB.
+   *
+   * The pool and its workers live in a thread of their own, submit(), cancel() and waitForRequest()
+   * may be called from any thread.
+   */
+  class RubyWorkerPool : public QObject
+  {
+    Q_OBJECT;
+
+    public:
+      RubyWorkerPool(const RubyWorkerPoolOptions &t_options = RubyWorkerPoolOptions());
+      virtual ~RubyWorkerPool();
+
+      RubyWorkerPoolOptions options() const;
+
+      /// Change the options, workers already running are replaced as they become idle
+      void setOptions(const RubyWorkerPoolOptions &t_options);
+
+      /// \returns true if the pool is enabled and can run the given tool with the given parameters.
+      ///          Only the "ruby" tool, with no parameters but -I include directories before the script
+      ///          and no stdin, is accepted. Relative include directories are resolved against the
+      ///          working directory of each script, as they would be for a ruby process started there.
+      bool accepts(const openstudio::runmanager::ToolInfo &t_tool, 
+          const std::vector<std::string> &t_parameters,
+          const std::string &t_stdin) const;
+
+      /// Queue a script for execution
+      /// \param[in] t_ruby The ruby binary the worker is run with
+      /// \param[in] t_parameters The parameters that would have been passed to t_ruby, see accepts()
+      /// \param[in] t_workingDir The directory the script is run in
+      /// \param[in] t_stdout File that receives the standard output of the script
+      /// \param[in] t_stderr File that receives the standard error of the script
+      /// \returns the id used by the requestStarted and requestFinished signals
+      int submit(const openstudio::path &t_ruby,
+          const std::vector<std::string> &t_parameters,
+          const openstudio::path &t_workingDir,
+          const openstudio::path &t_stdout,
+          const openstudio::path &t_stderr);
+
+      /// Stop a queued or running request, requestFinished is still emitted for it
+      void cancel(int t_id);
+
+      /// Block until requestFinished has been emitted for the given id
+      void waitForRequest(int t_id);
+
+      /// Split ruby parameters into include directories and the script with its arguments
+      /// \returns false if the parameters contain any other interpreter option or no script
+      static bool splitParameters(const std::vector<std::string> &t_parameters,
+          std::vector<std::string> &t_includeDirs,
+          std::vector<std::string> &t_scriptAndArgs);
+
+    signals:
+      /// Emitted when a worker has been handed the request
+      void requestStarted(int t_id);
+
+      /// Emitted when the request is complete. t_crashed is set if the script was killed, or its
+      /// worker died, in which case t_description says why.
+      void requestFinished(int t_id, int t_exitCode, bool t_crashed, const std::string &t_description);
+
+    private slots:
+      void processQueue();
+      void killRequest(int t_id);
+      void shutdown();
+
+      void workerReadyReadStandardOutput();
+      void workerReadyReadStandardError();
+      void workerError(QProcess::ProcessError t_error);
+      void workerFinished(int t_exitCode, QProcess::ExitStatus t_exitStatus);
+
+    private:
+      REGISTER_LOGGER("openstudio.runmanager.RubyWorkerPool");
+
+      struct Request
+      {
+        int id;
+        openstudio::path ruby;
+        std::vector<std::string> includeDirs; //< absolute include directories the worker is started with
+        std::string command; //< encoded run line sent to the worker, including relative include directories
+      };
+
+      struct Worker
+      {
+        Worker() : process(0), ready(false), forking(false), retiring(false), jobs(0), generation(0) {}
+
+        QProcess *process;
+        std::string key; //< ruby binary and include directories the worker was started with
+        bool ready;
+        bool forking;
+        bool retiring;
+        unsigned int jobs;
+        unsigned int generation; //< options generation the worker was started with
+        boost::optional<Request> request;
+        QByteArray buffer;
+        std::string errors; //< stderr of the worker itself, reported if it dies
+      };
+
+      static std::string key(const openstudio::path &t_ruby, const std::vector<std::string> &t_includeDirs);
+      static std::string encode(const std::string &t_field);
+
+      Worker *findWorker(QObject *t_process);
+      Worker *startWorker(const Request &t_request, const RubyWorkerPoolOptions &t_options, unsigned int t_generation);
+      void dispatch(Worker &t_worker);
+      void retire(Worker &t_worker);
+      void removeWorker(QObject *t_process, const std::string &t_reason);
+      void handleReply(Worker &t_worker, const std::string &t_line);
+      void finishRequest(int t_id, int t_exitCode, bool t_crashed, const std::string &t_description);
+
+      QThread m_thread;
+
+      mutable QMutex m_mutex;
+      QWaitCondition m_requestFinished;
+
+      // guarded by m_mutex
+      RubyWorkerPoolOptions m_options;
+      std::deque<Request> m_queue;
+      std::set<int> m_active;
+      int m_nextId;
+      unsigned int m_generation;
+
+      // only used from m_thread
+      std::vector<boost::shared_ptr<Worker> > m_workers;
+
+      openstudio::path m_workerScript;
+  };
+
+}
+}
+}
+
+#endif
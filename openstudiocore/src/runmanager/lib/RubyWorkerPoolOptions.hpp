@@ -0,0 +1,59 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef OPENSTUDIO_RUNMANAGER_RUBYWORKERPOOLOPTIONS_HPP
+#define OPENSTUDIO_RUNMANAGER_RUBYWORKERPOOLOPTIONS_HPP
+
+#include "RunManagerAPI.hpp"
+
+#include <string>
+#include <vector>
+
+namespace openstudio {
+namespace runmanager {
+
+  /// Settings for the pool of long lived ruby processes the RunManager can use to run the scripts
+  /// of RubyJob and UserScriptJob jobs without starting an interpreter and loading the OpenStudio
+  /// bindings for every job. The pool is disabled, numWorkers == 0, by default.
+  struct RUNMANAGER_API RubyWorkerPoolOptions
+  {
+    RubyWorkerPoolOptions()
+      : numWorkers(0), maxJobsPerWorker(50), maxMemoryMB(1024)
+    {
+      preloadLibraries.push_back("openstudio");
+    }
+
+    /// Maximum number of worker processes alive at once, 0 disables the pool
+    unsigned int numWorkers;
+
+    /// Number of scripts a worker runs before it is replaced by a fresh process
+    unsigned int maxJobsPerWorker;
+
+    /// Resident memory, in MB, above which a worker is replaced once its current script completes.
+    /// Only checked on platforms where the worker can report its memory use.
+    unsigned int maxMemoryMB;
+
+    /// Libraries each worker requires as it starts, before running any script
+    std::vector<std::string> preloadLibraries;
+  };
+
+}
+}
+
+#endif
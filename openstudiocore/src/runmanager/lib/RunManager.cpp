@@ -352,6 +352,26 @@ namespace runmanager {
     m_impl->setSLURMPassword(t_password);
   }
 
+  void RunManager::setRubyWorkerPoolOptions(const RubyWorkerPoolOptions &t_options)
+  {
+    m_impl->setRubyWorkerPoolOptions(t_options);
+  }
+
+  RubyWorkerPoolOptions RunManager::rubyWorkerPoolOptions() const
+  {
+    return m_impl->rubyWorkerPoolOptions();
+  }
+
+  void RunManager::setRemoteWorkers(const std::vector<RemoteWorkerEndpoint> &t_workers)
+  {
+    m_impl->setRemoteWorkers(t_workers);
+  }
+
+  std::vector<RemoteWorkerEndpoint> RunManager::remoteWorkers() const
+  {
+    return m_impl->remoteWorkers();
+  }
+
 
   std::map<std::string, double> RunManager::statistics() const
   {
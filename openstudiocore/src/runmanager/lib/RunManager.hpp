@@ -22,6 +22,8 @@
 
 #include <runmanager/lib/ConfigOptions.hpp>
 #include <runmanager/lib/RunManagerAPI.hpp>
+#include <runmanager/lib/RubyWorkerPoolOptions.hpp>
+#include <runmanager/lib/RemoteWorkerEndpoint.hpp>
 
 #include <utilities/core/Path.hpp>
 #include <utilities/core/UUID.hpp>
@@ -226,6 +228,21 @@ namespace detail {
       /// Passwords are not persisted.
       void setSLURMPassword(const std::string &t_pass);
 
+      /// Sets the options of the pool of long lived ruby processes used to run the scripts of
+      /// RubyJob and UserScriptJob jobs. The pool is disabled by default. Options are not persisted.
+      void setRubyWorkerPoolOptions(const RubyWorkerPoolOptions &t_options);
+
+      /// \returns the options of the ruby worker pool
+      RubyWorkerPoolOptions rubyWorkerPoolOptions() const;
+
+      /// Sets the RemoteWorker daemons jobs are handed to. A job whose tools a worker can run,
+      /// see Job::workerRunnable, goes to a worker with a free slot before it is run locally.
+      /// Connections are remade as workers go away and come back. Workers are not persisted.
+      void setRemoteWorkers(const std::vector<RemoteWorkerEndpoint> &t_workers);
+
+      /// \returns the RemoteWorker daemons jobs are handed to
+      std::vector<RemoteWorkerEndpoint> remoteWorkers() const;
+
       /// Persist a workflow to the database
       /// \returns the key the workflow is stored under
       std::string persistWorkflow(const Workflow &_wf);
@@ -22,6 +22,8 @@
   #include <runmanager/lib/JobType.hpp>
   #include <runmanager/lib/Job.hpp>
   #include <runmanager/lib/JobFactory.hpp>
+  #include <runmanager/lib/RubyWorkerPoolOptions.hpp>
+  #include <runmanager/lib/RemoteWorkerEndpoint.hpp>
   #include <runmanager/lib/RunManager.hpp>
   #include <runmanager/lib/FileInfo.hpp>
   #include <runmanager/lib/ConfigOptions.hpp>
@@ -119,6 +121,7 @@
 %template(FileInfoVector) std::vector<openstudio::runmanager::FileInfo>;
 %template(ToolInfoVector) std::vector<openstudio::runmanager::ToolInfo>;
 %template(JobParamList) std::vector<openstudio::runmanager::JobParam>;
+%template(RemoteWorkerEndpointVector) std::vector<openstudio::runmanager::RemoteWorkerEndpoint>;
 %template(WorkflowVector) std::vector<openstudio::runmanager::Workflow>;
 %template(WorkItemVector) std::vector<openstudio::runmanager::WorkItem>;
 %template(RubyJobBuilderVector) std::vector<openstudio::runmanager::RubyJobBuilder>;
@@ -137,6 +140,8 @@
 %include <runmanager/lib/AdvancedStatus.hpp>
 %include <runmanager/lib/Job.hpp>
 %include <runmanager/lib/JobFactory.hpp>
+%include <runmanager/lib/RubyWorkerPoolOptions.hpp>
+%include <runmanager/lib/RemoteWorkerEndpoint.hpp>
 %include <runmanager/lib/RunManager.hpp>
 %include <runmanager/lib/RubyJobUtils.hpp>
 %include <runmanager/lib/ConfigOptions.hpp>
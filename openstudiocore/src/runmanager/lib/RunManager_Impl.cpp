@@ -23,7 +23,10 @@
 #include <boost/bind.hpp>
 #include <runmanager/lib/runmanagerdatabase.hxx>
 #include "JobFactory.hpp"
+#include "JobStateJournal.hpp"
+#include "JSON.hpp"
 #include "Workflow.hpp"
+#include "RubyWorkerPool.hpp"
 #include <QFileInfo>
 #include <QDateTime>
 #include <QMessageBox>
@@ -33,6 +36,8 @@
 
 #include <OpenStudio.hxx>
 
+#include <algorithm>
+
 #include <boost/bind.hpp>
 
 namespace openstudio {
@@ -156,6 +161,12 @@ namespace detail {
 
 
 
+  /// Owns the RunManager database connection.
+  ///
+  /// Job trees, job status and job deletions are not written to the database directly. They are
+  /// appended to a JobStateJournal next to the database and written out in batched transactions
+  /// by a background thread. Anything still journaled when the process exits is replayed the next
+  /// time the database is opened. Reads flush the journal first.
   class RunManager_Impl::DBHolder
   {
     public:
@@ -164,9 +175,31 @@ namespace detail {
           m_config(initConfigOptions(m_db, DB)),
           m_loading(false),
           m_dbPath(DB),
-          m_configOptions(new ConfigOptions(toConfigOptions(m_db, m_config)))
+          m_configOptions(new ConfigOptions(toConfigOptions(m_db, m_config))),
+          m_journal(toPath(toString(DB) + ".journal")),
+          m_stopFlushing(false),
+          m_flushThread(*this)
       {
+        if (!m_journal.empty())
+        {
+          LOG(Info, "Replaying " << m_journal.size() << " journaled job state changes into " << toString(DB));
+          flushJournal(true);
+        }
 
+        m_flushThread.start();
+      }
+
+      ~DBHolder()
+      {
+        {
+          QMutexLocker l(&m_flushSignalMutex);
+          m_stopFlushing = true;
+          m_workAvailable.wakeAll();
+          m_stopRequested.wakeAll();
+        }
+
+        m_flushThread.wait();
+        flushJournal();
       }
 
       ConfigOptions getConfigOptions()
@@ -259,12 +292,14 @@ namespace detail {
 
       std::vector<openstudio::runmanager::Job> loadJobs()
       {
+        flushJournal();
         QMutexLocker l(&m_mutex);
         return loadJobsImpl(false, "");
       }
 
       std::vector<openstudio::runmanager::Workflow> loadWorkflows()
       {
+        flushJournal();
         QMutexLocker l(&m_mutex);
         std::vector<openstudio::runmanager::Job> jobs = loadJobsImpl(true, "");
 
@@ -279,6 +314,7 @@ namespace detail {
 
       openstudio::runmanager::Workflow loadWorkflowByName(const std::string &t_name)
       {
+        flushJournal();
         QMutexLocker l(&m_mutex);
         std::vector<openstudio::runmanager::Job> jobs = loadJobsImpl(true, "");
 
@@ -301,6 +337,7 @@ namespace detail {
 
       void deleteWorkflowByName(const std::string &t_name)
       {
+        flushJournal();
         QMutexLocker l(&m_mutex);
         m_db.begin();
         std::vector<openstudio::runmanager::Job> jobs = loadJobsImpl(true, "");
@@ -324,6 +361,7 @@ namespace detail {
       
       void deleteWorkflows()
       {
+        flushJournal();
         QMutexLocker l(&m_mutex);
         m_db.begin();
         std::vector<openstudio::runmanager::Job> jobs = loadJobsImpl(true, "");
@@ -354,11 +392,12 @@ namespace detail {
           deleteJobRecursiveInternal(*t_job.finishedJob());
         }
 
-        deleteJobInternal(t_job);
+        deleteJobInternal(t_job.uuid());
       }
 
       bool workflowExists(const std::string &t_key)
       {
+        flushJournal();
         QMutexLocker l(&m_mutex);
         std::vector<openstudio::runmanager::Job> jobs = loadJobsImpl(true, t_key);
 
@@ -377,6 +416,7 @@ namespace detail {
 
       openstudio::runmanager::Workflow loadWorkflow(const std::string &t_key)
       {
+        flushJournal();
         QMutexLocker l(&m_mutex);
         std::vector<openstudio::runmanager::Job> jobs = loadJobsImpl(true, t_key);
 
@@ -394,11 +434,11 @@ namespace detail {
       }
 
 
-      void deleteJobInternal(const openstudio::runmanager::Job &t_job)
+      void deleteJobDefinition(const std::string &t_uuid)
       {
         std::vector<RunManagerDB::Job> jobs
           = litesql::select<RunManagerDB::Job>(m_db,
-              RunManagerDB::Job::Uuid == toString(t_job.uuid())).all();
+              RunManagerDB::Job::Uuid == t_uuid).all();
         for (std::vector<RunManagerDB::Job>::iterator itr = jobs.begin();
             itr != jobs.end();
             ++itr)
@@ -406,50 +446,37 @@ namespace detail {
           itr->del();
         }
 
-        deleteJobFiles<RunManagerDB::JobFileInfo, RunManagerDB::RequiredFile>(t_job);
-        deleteJobFiles<RunManagerDB::OutputFileInfo, RunManagerDB::OutputRequiredFile>(t_job);
-        deleteJobTools(t_job);
-        deleteJobParams(t_job);
-        deleteJobStatus(t_job.uuid());
+        deleteJobFiles<RunManagerDB::JobFileInfo, RunManagerDB::RequiredFile>(t_uuid);
+        deleteJobTools(t_uuid);
+        deleteJobParams(t_uuid);
+      }
+
+      void deleteJobInternal(const openstudio::UUID &t_uuid)
+      {
+        deleteJobDefinition(toString(t_uuid));
+        deleteJobFiles<RunManagerDB::OutputFileInfo, RunManagerDB::OutputRequiredFile>(toString(t_uuid));
+        deleteJobStatus(t_uuid);
       }
 
 
       void deleteJob(const openstudio::runmanager::Job &t_job)
       {
-        QMutexLocker l(&m_mutex);
-        m_db.begin();
-        deleteJobInternal(t_job);
-        m_db.commit();
+        m_journal.addDeletes(std::vector<openstudio::UUID>(1, t_job.uuid()));
+        notifyFlusher();
       }
 
       template<typename Itr>
         void deleteJobs(Itr begin, const Itr &end)
         {
-          QMutexLocker l(&m_mutex);
-
-          m_db.begin();
+          std::vector<openstudio::UUID> uuids;
           while (begin != end)
           {
-            std::vector<RunManagerDB::Job> jobs
-              = litesql::select<RunManagerDB::Job>(m_db,
-                  RunManagerDB::Job::Uuid == toString(begin->uuid())).all();
-
-            for (std::vector<RunManagerDB::Job>::iterator itr = jobs.begin();
-                itr != jobs.end();
-                ++itr)
-            {
-              itr->del();
-            }
-
-            deleteJobFiles<RunManagerDB::JobFileInfo, RunManagerDB::RequiredFile>(*begin);
-            deleteJobFiles<RunManagerDB::OutputFileInfo, RunManagerDB::OutputRequiredFile>(*begin);
-            deleteJobTools(*begin);
-            deleteJobParams(*begin);
-            deleteJobStatus(begin->uuid());
+            uuids.push_back(begin->uuid());
             ++begin;
           }
 
-          m_db.commit();
+          m_journal.addDeletes(uuids);
+          notifyFlusher();
         }
 
       std::string persistWorkflow(openstudio::runmanager::Workflow t_workflow /*we want a copy*/)
@@ -458,45 +485,52 @@ namespace detail {
 
         std::string key = j.jobParams().get("workflowkey").children.at(0).value;
         
-        m_db.begin();
-        if (!workflowExists(key))
+        if (!isLoading() && !workflowExists(key))
         {
-          persistJobRecursive(j, true);
+          QVariantList rows;
+          collectJobRows(j, true, rows);
+
+          QMutexLocker l(&m_mutex);
+          m_db.begin();
+          persistJobRows(rows, false);
           // workflow did not exist, is now added
+          m_db.commit();
         }
-        m_db.commit();
 
         return key;
       }
 
       void persistJobTree(const openstudio::runmanager::Job &t_job)
       {
-        m_db.begin();
-        persistJobRecursive(t_job, false);
-        m_db.commit();
+        persistJobTrees(std::vector<openstudio::runmanager::Job>(1, t_job));
       }
 
       void persistJobTrees(const std::vector<openstudio::runmanager::Job> &t_jobs)
       {
-        m_db.begin();
+        if (isLoading()) return; // we are currently loading, don't persist that which we are loading
+
+        QVariantList rows;
 
         for (std::vector<openstudio::runmanager::Job>::const_iterator itr = t_jobs.begin();
              itr != t_jobs.end();
              ++itr)
         {
-          persistJobRecursive(*itr, false);
+          collectJobRows(*itr, false, rows);
         }
 
-        m_db.commit();
+        m_journal.addJobs(rows);
+        notifyFlusher();
       }
 
-      void persistJobRecursive(const openstudio::runmanager::Job &t_job, bool isWorkflow)
+      /// Flattens the job tree into the rows to be persisted for each job, so that the rows
+      /// can be journaled and written without touching the Job objects again
+      void collectJobRows(const openstudio::runmanager::Job &t_job, bool isWorkflow, QVariantList &t_rows) const
       {
-        persistJob(t_job, isWorkflow);
+        t_rows.push_back(toJobRow(t_job, isWorkflow));
         boost::optional<openstudio::runmanager::Job> fj = t_job.finishedJob();
         if (fj)
         {
-          persistJobRecursive(*fj, isWorkflow);
+          collectJobRows(*fj, isWorkflow, t_rows);
         }
 
         std::vector<openstudio::runmanager::Job> children = t_job.children();
@@ -504,41 +538,161 @@ namespace detail {
              itr != children.end();
              ++itr)
         {
-          persistJobRecursive(*itr, isWorkflow);
+          collectJobRows(*itr, isWorkflow, t_rows);
         }
 
       }
 
-      void persistJob(const openstudio::runmanager::Job &t_job, bool isWorkflow = false)
+      QVariantMap toJobRow(const openstudio::runmanager::Job &t_job, bool isWorkflow) const
       {
-        QMutexLocker l(&m_mutex);
-        if (m_loading) return; // we are currently loading, don't persist that which we are loading
+        QVariantMap row;
+        row["uuid"] = toQString(toString(t_job.uuid()));
+        row["isWorkflowJob"] = isWorkflow;
 
-        RunManagerDB::Job j(m_db);
-        j.uuid = toString(t_job.uuid());
-        j.isFinishedJob = false;
-        j.isWorkflowJob = isWorkflow;
+        bool isFinishedJob = false;
         if (t_job.parent())
         {
-          j.parentUuid = toString(t_job.parent()->uuid());
+          row["parentUuid"] = toQString(toString(t_job.parent()->uuid()));
           boost::optional<Job> finishedJob = t_job.parent()->finishedJob();
 
           if (finishedJob)
           {
             if (*finishedJob == t_job)
             {
-              j.isFinishedJob = true;
+              isFinishedJob = true;
             }
           }
         }
-        j.index = t_job.index();
-        j.jobType = t_job.jobType().valueName();
+        row["isFinishedJob"] = isFinishedJob;
+        row["index"] = t_job.index();
+        row["jobType"] = toQString(t_job.jobType().valueName());
+        row["files"] = toFileRows(t_job.rawInputFiles());
+        row["tools"] = toToolRows(t_job.tools());
+        row["params"] = JSON::toVariant(jobParamsToPersist(t_job));
+        return row;
+      }
+
+      /// \param[in] t_replace if true, any existing definition of the jobs is deleted first, which
+      ///                      makes replaying a journal that was already partly committed safe
+      void persistJobRows(const QVariantList &t_rows, bool t_replace)
+      {
+        for (QVariantList::const_iterator itr = t_rows.begin();
+             itr != t_rows.end();
+             ++itr)
+        {
+          persistJobRow(itr->toMap(), t_replace);
+        }
+      }
+
+      void persistJobRow(const QVariantMap &t_row, bool t_replace)
+      {
+        std::string uuid = toString(t_row["uuid"].toString());
+
+        if (t_replace)
+        {
+          deleteJobDefinition(uuid);
+        }
+
+        RunManagerDB::Job j(m_db);
+        j.uuid = uuid;
+        j.isFinishedJob = t_row["isFinishedJob"].toBool();
+        j.isWorkflowJob = t_row["isWorkflowJob"].toBool();
+        if (t_row.contains("parentUuid"))
+        {
+          j.parentUuid = toString(t_row["parentUuid"].toString());
+        }
+        j.index = t_row["index"].toInt();
+        j.jobType = toString(t_row["jobType"].toString());
         j.update();
 
 
-        persistJobFiles<RunManagerDB::JobFileInfo, RunManagerDB::RequiredFile>(t_job);
-        persistJobTools(t_job);
-        persistJobParams(t_job);
+        persistJobFiles<RunManagerDB::JobFileInfo, RunManagerDB::RequiredFile>(uuid, t_row["files"].toList());
+        persistJobTools(uuid, t_row["tools"].toList());
+        persistJobParams(uuid, JSON::toVectorOfJobParam(t_row["params"]));
+      }
+
+      void notifyFlusher()
+      {
+        QMutexLocker l(&m_flushSignalMutex);
+        m_workAvailable.wakeAll();
+      }
+
+      /// Writes all journaled changes to the database in a single transaction. If the transaction
+      /// fails the changes stay journaled and are retried on the next flush.
+      void flushJournal(bool t_replay = false)
+      {
+        QMutexLocker fl(&m_flushMutex);
+
+        std::vector<JobStateJournal::Record> records = m_journal.pending();
+        if (records.empty()) return;
+
+        LOG(Debug, "Writing " << records.size() << " journaled job state changes to the database");
+
+        QMutexLocker l(&m_mutex);
+        try {
+          m_db.begin();
+
+          for (std::vector<JobStateJournal::Record>::const_iterator itr = records.begin();
+               itr != records.end();
+               ++itr)
+          {
+            switch (itr->type)
+            {
+              case JobStateJournal::Record::PersistJobs:
+                persistJobRows(itr->data.toList(), t_replay);
+                break;
+              case JobStateJournal::Record::PersistStatus:
+                persistJobStatusRow(itr->uuid, itr->data.toMap());
+                break;
+              case JobStateJournal::Record::DeleteJobs:
+                {
+                  QVariantList uuids = itr->data.toList();
+                  for (QVariantList::const_iterator uuid = uuids.begin();
+                       uuid != uuids.end();
+                       ++uuid)
+                  {
+                    deleteJobInternal(openstudio::UUID(uuid->toString()));
+                  }
+                }
+                break;
+              case JobStateJournal::Record::PersistResourceUsage:
+                persistResourceUsageRow(itr->data.toMap());
+                break;
+            }
+          }
+
+          m_db.commit();
+        } catch (const std::exception &e) {
+          LOG(Error, "Unable to write journaled job state changes to " << toString(m_dbPath) << ", they will be retried: " << e.what());
+          m_db.rollback();
+          return;
+        }
+
+        l.unlock();
+        m_journal.committed(records.back().sequence);
+      }
+
+      /// Body of the flush thread, waits for journaled changes and writes them out in batches
+      void flushLoop()
+      {
+        QMutexLocker l(&m_flushSignalMutex);
+
+        while (!m_stopFlushing)
+        {
+          if (m_journal.empty())
+          {
+            m_workAvailable.wait(&m_flushSignalMutex);
+            continue;
+          }
+
+          // give further changes a moment to join this batch
+          m_stopRequested.wait(&m_flushSignalMutex, FlushDelayMSecs);
+          if (m_stopFlushing) break;
+
+          l.unlock();
+          flushJournal();
+          l.relock();
+        }
       }
 
 
@@ -597,51 +751,127 @@ namespace detail {
 
       void persistJobStatus(const openstudio::UUID &t_uuid, const JobErrors &t_errors, const boost::optional<openstudio::DateTime> &t_lastRun,
           const Files &t_files)
+      {
+        LOG(Debug, "Journaling job status for " << openstudio::toString(t_uuid));
+
+        QVariantMap status;
+        status["outputFiles"] = toFileRows(t_files.files());
+
+        if (t_lastRun)
+        {
+          status["lastRun"] = toQString(t_lastRun->toString());
+          status["result"] = static_cast<int>(t_errors.result.value());
+
+          QVariantList errors;
+          for (std::vector<std::pair<runmanager::ErrorType, std::string> >::const_iterator itr = t_errors.allErrors.begin();
+               itr != t_errors.allErrors.end();
+               ++itr)
+          {
+            QVariantMap error;
+            error["errorType"] = static_cast<int>(itr->first.value());
+            error["value"] = toQString(itr->second);
+            errors.push_back(error);
+          }
+          status["errors"] = errors;
+        }
+
+        m_journal.addStatus(t_uuid, status);
+        notifyFlusher();
+      }
+
+      void persistResourceUsage(const std::string &t_jobType, const detail::JobResourceHistory::Entry &t_entry)
+      {
+        LOG(Debug, "Journaling resource usage for " << t_jobType);
+
+        QVariantMap usage;
+        usage["jobType"] = toQString(t_jobType);
+        usage["runs"] = t_entry.runs;
+        usage["peakMemoryMB"] = t_entry.memoryMB;
+
+        m_journal.addResourceUsage(usage);
+        notifyFlusher();
+      }
+
+      void persistResourceUsageRow(const QVariantMap &t_usage)
+      {
+        std::string jobType = toString(t_usage["jobType"].toString());
+
+        std::vector<RunManagerDB::JobResourceUsage> existing
+          = litesql::select<RunManagerDB::JobResourceUsage>(m_db, RunManagerDB::JobResourceUsage::JobType == jobType).all();
+
+        for (std::vector<RunManagerDB::JobResourceUsage>::iterator itr = existing.begin();
+             itr != existing.end();
+             ++itr)
+        {
+          itr->del();
+        }
+
+        RunManagerDB::JobResourceUsage row(m_db);
+        row.jobType = jobType;
+        row.runs = t_usage["runs"].toInt();
+        row.peakMemoryMB = t_usage["peakMemoryMB"].toDouble();
+        row.update();
+      }
+
+      /// \returns the learned resource usage of each job type that has been run against this database
+      std::vector<std::pair<std::string, detail::JobResourceHistory::Entry> > loadResourceUsage()
+      {
+        flushJournal();
+        QMutexLocker l(&m_mutex);
+
+        std::vector<std::pair<std::string, detail::JobResourceHistory::Entry> > retval;
+        std::vector<RunManagerDB::JobResourceUsage> rows = litesql::select<RunManagerDB::JobResourceUsage>(m_db).all();
+
+        for (std::vector<RunManagerDB::JobResourceUsage>::const_iterator itr = rows.begin();
+             itr != rows.end();
+             ++itr)
+        {
+          detail::JobResourceHistory::Entry entry;
+          entry.runs = itr->runs;
+          entry.memoryMB = itr->peakMemoryMB;
+          retval.push_back(std::make_pair(std::string(itr->jobType), entry));
+        }
+
+        return retval;
+      }
+
+      void persistJobStatusRow(const openstudio::UUID &t_uuid, const QVariantMap &t_status)
       {
         LOG(Debug, "Persisting job status for " << openstudio::toString(t_uuid));
-        m_db.begin();
         deleteJobStatus(t_uuid);
-        deleteJobFiles<RunManagerDB::OutputFileInfo, RunManagerDB::OutputRequiredFile>(t_uuid);
+        deleteJobFiles<RunManagerDB::OutputFileInfo, RunManagerDB::OutputRequiredFile>(toString(t_uuid));
 
         LOG(Debug, "Deleted previous data job status for " << openstudio::toString(t_uuid));
 
-        persistJobFiles<RunManagerDB::OutputFileInfo, RunManagerDB::OutputRequiredFile>(t_uuid, t_files.files());
+        persistJobFiles<RunManagerDB::OutputFileInfo, RunManagerDB::OutputRequiredFile>(toString(t_uuid), t_status["outputFiles"].toList());
 
-        if (!t_lastRun)
+        if (!t_status.contains("lastRun"))
         {
           LOG(Debug, "Not persisting, job has not actually finished " << openstudio::toString(t_uuid));
           // Job has not been run, nothing to persist besides deleting the old one
-          m_db.commit();
           return;
         }
 
         RunManagerDB::JobStatus db_js = RunManagerDB::JobStatus(m_db);
         db_js.jobUuid = openstudio::toString(t_uuid);
-        db_js.result = static_cast<int>(t_errors.result.value());
-
-        if (t_lastRun)
-        {
-          db_js.lastRun = t_lastRun->toString();
-        }
-
+        db_js.result = t_status["result"].toInt();
+        db_js.lastRun = toString(t_status["lastRun"].toString());
         db_js.update();
 
 
-        std::vector<std::pair<runmanager::ErrorType, std::string> > errors = t_errors.allErrors;
+        QVariantList errors = t_status["errors"].toList();
 
-        for (std::vector<std::pair<runmanager::ErrorType, std::string> >::const_iterator itr = errors.begin();
+        for (QVariantList::const_iterator itr = errors.begin();
              itr != errors.end();
              ++itr)
         {
+          QVariantMap error = itr->toMap();
           RunManagerDB::JobErrors j(m_db);
           j.jobUuid = toString(t_uuid);
-          j.errorType = static_cast<int>(itr->first.value());
-          j.value = itr->second;
+          j.errorType = error["errorType"].toInt();
+          j.value = toString(error["value"].toString());
           j.update();
         }
-
-        LOG(Debug, "Done persisting job, committing " << openstudio::toString(t_uuid));
-        m_db.commit();
       }
 
       void persistJobStatus(const openstudio::runmanager::Job &t_job)
@@ -659,6 +889,36 @@ namespace detail {
       openstudio::path m_dbPath;
       boost::shared_ptr<openstudio::runmanager::ConfigOptions> m_configOptions;
 
+      /// Background thread writing the journal to the database
+      class FlushThread : public QThread
+      {
+        public:
+          FlushThread(DBHolder &t_holder)
+            : m_holder(t_holder)
+          {
+          }
+
+        protected:
+          virtual void run()
+          {
+            m_holder.flushLoop();
+          }
+
+        private:
+          DBHolder &m_holder;
+      };
+
+      /// How long the flush thread lets changes accumulate before writing a batch
+      enum { FlushDelayMSecs = 250 };
+
+      JobStateJournal m_journal;
+      QMutex m_flushMutex; //< serializes journal flushes
+      QMutex m_flushSignalMutex;
+      QWaitCondition m_workAvailable;
+      QWaitCondition m_stopRequested;
+      bool m_stopFlushing;
+      FlushThread m_flushThread;
+
       std::vector<openstudio::runmanager::Job> loadJobsImpl(bool isWorkflow, const std::string &workflowkey)
       {
         LOG(Trace, "Loading jobs with workflow key: " << workflowkey);
@@ -906,12 +1166,12 @@ namespace detail {
         return params;
       }
 
-      void deleteJobParams(const openstudio::runmanager::Job &t_job)
+      void deleteJobParams(const std::string &t_uuid)
       {
         // delete the old
         std::vector<RunManagerDB::JobParam> tools
           = litesql::select<RunManagerDB::JobParam>(m_db,
-              RunManagerDB::JobParam::JobUuid == toString(t_job.uuid())).all();
+              RunManagerDB::JobParam::JobUuid == t_uuid).all();
         for (std::vector<RunManagerDB::JobParam>::iterator itr = tools.begin();
             itr != tools.end();
             ++itr)
@@ -920,9 +1180,8 @@ namespace detail {
         }
       }
 
-      void persistJobParams(const openstudio::runmanager::Job &t_job)
+      std::vector<JobParam> jobParamsToPersist(const openstudio::runmanager::Job &t_job) const
       {
-        // add the new
         std::vector<JobParam> params = t_job.params();
 
         openstudio::path basePath = t_job.getBasePath();
@@ -936,20 +1195,26 @@ namespace detail {
           params = jps.params();
         }
 
-        for (std::vector<JobParam>::const_iterator itr = params.begin();
-            itr != params.end();
+        return params;
+      }
+
+      void persistJobParams(const std::string &t_uuid, const std::vector<JobParam> &t_params)
+      {
+        // add the new
+        for (std::vector<JobParam>::const_iterator itr = t_params.begin();
+            itr != t_params.end();
             ++itr)
         {
-          persistJobParamsImpl(t_job, *itr);
+          persistJobParamsImpl(t_uuid, *itr);
         }
       }
 
-      void persistJobParamsImpl(const openstudio::runmanager::Job &t_job,
+      void persistJobParamsImpl(const std::string &t_uuid,
           const openstudio::runmanager::JobParam &t_param,
           boost::optional<int> parentid = boost::optional<int>())
       {
         RunManagerDB::JobParam p(m_db);
-        p.jobUuid = toString(t_job.uuid());
+        p.jobUuid = t_uuid;
 
         if (parentid)
         {
@@ -964,7 +1229,7 @@ namespace detail {
              itr != t_param.children.end();
              ++itr)
         {
-          persistJobParamsImpl(t_job, *itr, boost::optional<int>(p.id));
+          persistJobParamsImpl(t_uuid, *itr, boost::optional<int>(p.id));
         }
       }
 
@@ -1018,12 +1283,12 @@ namespace detail {
         return ret;
       }
 
-      void deleteJobTools(const openstudio::runmanager::Job &t_job)
+      void deleteJobTools(const std::string &t_uuid)
       {
         // delete the old
         std::vector<RunManagerDB::JobToolInfo> tools
           = litesql::select<RunManagerDB::JobToolInfo>(m_db,
-              RunManagerDB::JobToolInfo::JobUuid == toString(t_job.uuid())).all();
+              RunManagerDB::JobToolInfo::JobUuid == t_uuid).all();
         for (std::vector<RunManagerDB::JobToolInfo>::iterator itr = tools.begin();
             itr != tools.end();
             ++itr)
@@ -1032,46 +1297,47 @@ namespace detail {
         }
       }
 
-      void persistJobTools(const openstudio::runmanager::Job &t_job)
+      static QVariantList toToolRows(const std::vector<ToolInfo> &t_tools)
       {
-        // Add the new
-        std::vector<ToolInfo> jobTools = t_job.tools();
+        QVariantList rows;
 
-        for (std::vector<ToolInfo>::const_iterator itr = jobTools.begin();
-             itr != jobTools.end();
+        for (std::vector<ToolInfo>::const_iterator itr = t_tools.begin();
+             itr != t_tools.end();
              ++itr)
         {
-          RunManagerDB::JobToolInfo j(m_db);
-          j.jobUuid = toString(t_job.uuid());
-          j.name = itr->name;
-          j.localBinPath = toString(itr->localBinPath);
-          j.remoteArchive = toString(itr->remoteArchive);
-          j.remoteExe = toString(itr->remoteExe);
-          j.outFileFilter = boost::lexical_cast<std::string>(itr->outFileFilter);
-
-          if (itr->version.getMajor())
-          {
-            j.majorVersion = *itr->version.getMajor();
-          } else {
-            j.majorVersion = -1;
-          }
-
-          if (itr->version.getMinor())
-          {
-            j.minorVersion = *itr->version.getMinor();
-          } else {
-            j.minorVersion = -1;
-          }
-
-
-          if (itr->version.getBuild())
-          {
-            j.buildVersion = *itr->version.getBuild();
-          } else {
-            j.buildVersion = -1;
-          }
+          QVariantMap row;
+          row["name"] = toQString(itr->name);
+          row["localBinPath"] = toQString(toString(itr->localBinPath));
+          row["remoteArchive"] = toQString(toString(itr->remoteArchive));
+          row["remoteExe"] = toQString(toString(itr->remoteExe));
+          row["outFileFilter"] = toQString(boost::lexical_cast<std::string>(itr->outFileFilter));
+          row["majorVersion"] = itr->version.getMajor() ? *itr->version.getMajor() : -1;
+          row["minorVersion"] = itr->version.getMinor() ? *itr->version.getMinor() : -1;
+          row["buildVersion"] = itr->version.getBuild() ? *itr->version.getBuild() : -1;
+          rows.push_back(row);
+        }
 
+        return rows;
+      }
 
+      void persistJobTools(const std::string &t_uuid, const QVariantList &t_tools)
+      {
+        // Add the new
+        for (QVariantList::const_iterator itr = t_tools.begin();
+             itr != t_tools.end();
+             ++itr)
+        {
+          QVariantMap row = itr->toMap();
+          RunManagerDB::JobToolInfo j(m_db);
+          j.jobUuid = t_uuid;
+          j.name = toString(row["name"].toString());
+          j.localBinPath = toString(row["localBinPath"].toString());
+          j.remoteArchive = toString(row["remoteArchive"].toString());
+          j.remoteExe = toString(row["remoteExe"].toString());
+          j.outFileFilter = toString(row["outFileFilter"].toString());
+          j.majorVersion = row["majorVersion"].toInt();
+          j.minorVersion = row["minorVersion"].toInt();
+          j.buildVersion = row["buildVersion"].toInt();
           j.update();
         }
       }
@@ -1129,18 +1395,12 @@ namespace detail {
       }
 
       template<typename JobFileType, typename RequiredFileType>
-      void deleteJobFiles(const openstudio::runmanager::Job &t_job)
-      {
-        deleteJobFiles<JobFileType, RequiredFileType>(t_job.uuid());
-      }
-
-      template<typename JobFileType, typename RequiredFileType>
-      void deleteJobFiles(const openstudio::UUID &t_uuid)
+      void deleteJobFiles(const std::string &t_uuid)
       {
         // delete the old
         std::vector<JobFileType> files
           = litesql::select<JobFileType>(m_db,
-              JobFileType::JobUuid == toString(t_uuid)).all();
+              JobFileType::JobUuid == t_uuid).all();
 
         for (typename std::vector<JobFileType>::iterator itr = files.begin();
             itr != files.end();
@@ -1160,45 +1420,75 @@ namespace detail {
         }
       }
 
-      template<typename JobFileType, typename RequiredFileType>
-      void persistJobFiles(const openstudio::runmanager::Job &t_job)
+      static QVariantList toFileRows(const std::vector<FileInfo> &t_files)
       {
-        persistJobFiles<JobFileType, RequiredFileType>(t_job.uuid(), t_job.rawInputFiles());
+        QVariantList rows;
+
+        for (std::vector<FileInfo>::const_iterator itr = t_files.begin();
+             itr != t_files.end();
+             ++itr)
+        {
+          QVariantMap row;
+          if (!itr->fullPath.empty())
+          {
+            row["fullPath"] = toQString(toString(itr->fullPath));
+          }
+          row["fileName"] = toQString(itr->filename);
+          row["lastModified"] = toQString(boost::lexical_cast<std::string>(itr->lastModified));
+          row["key"] = toQString(itr->key);
+
+          QVariantList requiredFiles;
+          for (std::vector<std::pair<QUrl, openstudio::path> >::const_iterator itr2 = itr->requiredFiles.begin();
+               itr2 != itr->requiredFiles.end();
+               ++itr2)
+          {
+            QVariantMap requiredFile;
+            requiredFile["from"] = itr2->first.toString();
+            requiredFile["to"] = toQString(toString(itr2->second));
+            requiredFiles.push_back(requiredFile);
+          }
+          row["requiredFiles"] = requiredFiles;
+
+          rows.push_back(row);
+        }
+
+        return rows;
       }
 
       template<typename JobFileType, typename RequiredFileType>
-      void persistJobFiles(const openstudio::UUID &t_uuid, const std::vector<FileInfo> &t_files)
+      void persistJobFiles(const std::string &t_uuid, const QVariantList &t_files)
       {
         // Add the new
-        for (std::vector<FileInfo>::const_iterator itr = t_files.begin();
+        for (QVariantList::const_iterator itr = t_files.begin();
              itr != t_files.end();
              ++itr)
         {
+          QVariantMap row = itr->toMap();
           JobFileType f(m_db);
-          LOG(Debug, "Persisting JobFile " << toString(itr->fullPath));
-          f.jobUuid = toString(t_uuid);
-          if (!itr->fullPath.empty())
+          LOG(Debug, "Persisting JobFile " << toString(row["fullPath"].toString()));
+          f.jobUuid = t_uuid;
+          if (row.contains("fullPath"))
           {
-            f.fullPath = toString(itr->fullPath);
+            f.fullPath = toString(row["fullPath"].toString());
           }
-          f.fileName = itr->filename;
-          f.lastModified = boost::lexical_cast<std::string>(itr->lastModified);
-          f.key = itr->key;
+          f.fileName = toString(row["fileName"].toString());
+          f.lastModified = toString(row["lastModified"].toString());
+          f.key = toString(row["key"].toString());
           f.update();
 
-          std::vector<std::pair<QUrl, openstudio::path> > jobRequiredFiles = itr->requiredFiles;
+          QVariantList requiredFiles = row["requiredFiles"].toList();
 
-          for (std::vector<std::pair<QUrl, openstudio::path> >::const_iterator itr2 =
-                   jobRequiredFiles.begin();
-               itr2 != jobRequiredFiles.end();
+          for (QVariantList::const_iterator itr2 = requiredFiles.begin();
+               itr2 != requiredFiles.end();
                ++itr2)
           {
-            LOG(Debug, "Persisting RequiredFile " << toString(itr2->first.toString()) << " to " << toString(itr2->second));
+            QVariantMap requiredFile = itr2->toMap();
+            LOG(Debug, "Persisting RequiredFile " << toString(requiredFile["from"].toString()) << " to " << toString(requiredFile["to"].toString()));
             RequiredFileType rf(m_db);
             int id = f.id;
             rf.parentId = id;
-            rf.from = toString(itr2->first.toString());
-            rf.to = toString(itr2->second);
+            rf.from = toString(requiredFile["from"].toString());
+            rf.to = toString(requiredFile["to"].toString());
             rf.update();
           }
         }
@@ -1354,8 +1644,11 @@ namespace detail {
       m_dbfile(DB),
       m_processingQueue(false),
       m_workPending(false), m_paused(t_paused), m_continue(true),
-      m_localProcessCreator(new LocalProcessCreator()),
+      m_machineResources(MachineResources::detect()),
+      m_rubyWorkerPool(new detail::RubyWorkerPool()),
+      m_localProcessCreator(new LocalProcessCreator(m_rubyWorkerPool)),
       m_remoteProcessCreator(new SLURMManager()),
+      m_remoteWorkerManager(new RemoteWorkerManager()),
       m_temporaryDB(t_temporaryDB),
       m_lastRunning(0),
       m_lastRunningRemotely(0),
@@ -1386,6 +1679,15 @@ namespace detail {
 
     m_model.setHorizontalHeaderLabels(WorkflowItem::columnHeaders());
 
+    LOG(Info, "Local jobs are packed into " << m_machineResources.cores << " cores and " << m_machineResources.memoryMB << " MB");
+    std::vector<std::pair<std::string, detail::JobResourceHistory::Entry> > usage = m_dbholder->loadResourceUsage();
+    for (std::vector<std::pair<std::string, detail::JobResourceHistory::Entry> >::const_iterator itr = usage.begin();
+         itr != usage.end();
+         ++itr)
+    {
+      m_resourceHistory.set(itr->first, itr->second);
+    }
+
     std::vector<Job> loadedjobs = m_dbholder->loadJobs();
     const std::map<openstudio::UUID, std::pair<int, int> > remotejobs = m_dbholder->loadRemoteJobs();
 
@@ -1762,6 +2064,31 @@ namespace detail {
       const openstudio::DateTime &t_lastRun, const std::vector<openstudio::runmanager::FileInfo> &t_files)
   {
     m_dbholder->persistJobStatus(t_uuid, t_errors, t_lastRun, runmanager::Files(t_files));
+
+    try {
+      Job job = getJob(t_uuid);
+      boost::optional<double> peakMemoryMB = job.peakMemoryMB();
+      if (peakMemoryMB)
+      {
+        detail::JobResourceHistory::Entry entry = m_resourceHistory.record(job.jobType(), *peakMemoryMB);
+        m_dbholder->persistResourceUsage(job.jobType().valueName(), entry);
+      }
+    } catch (const std::out_of_range &) {
+      // job has already been removed, nothing to learn from it
+    }
+  }
+
+  JobResources RunManager_Impl::resourcesFor(const openstudio::runmanager::Job &t_job) const
+  {
+    JobResources defaults = JobResources::defaults(t_job.jobType());
+
+    boost::optional<double> learned = m_resourceHistory.memoryMB(t_job.jobType());
+    if (learned)
+    {
+      defaults.memoryMB = *learned;
+    }
+
+    return JobResources::fromParams(t_job.jobParams(), defaults);
   }
 
   openstudio::path RunManager_Impl::dbPath() const
@@ -2295,6 +2622,26 @@ namespace detail {
     }
   }
 
+  void RunManager_Impl::setRubyWorkerPoolOptions(const RubyWorkerPoolOptions &t_options)
+  {
+    m_rubyWorkerPool->setOptions(t_options);
+  }
+
+  RubyWorkerPoolOptions RunManager_Impl::rubyWorkerPoolOptions() const
+  {
+    return m_rubyWorkerPool->options();
+  }
+
+  void RunManager_Impl::setRemoteWorkers(const std::vector<RemoteWorkerEndpoint> &t_workers)
+  {
+    m_remoteWorkerManager->setWorkers(t_workers);
+  }
+
+  std::vector<RemoteWorkerEndpoint> RunManager_Impl::remoteWorkers() const
+  {
+    return m_remoteWorkerManager->workers();
+  }
+
   std::string RunManager_Impl::persistWorkflow(const Workflow &t_wf)
   {
     return m_dbholder->persistWorkflow(t_wf);
@@ -2439,19 +2786,40 @@ namespace detail {
         const int maxremotejobs = config.getSLURMHost().empty()?0:config.getMaxSLURMJobs();
         const int maxlocaljobs = config.getMaxLocalJobs();
 
-        // Make sure we have as many running as we should have
-        while ((runningLocally < maxlocaljobs || runningRemotely < maxremotejobs) && itr != end)
+        detail::LocalJobScheduler scheduler(m_machineResources, maxlocaljobs);
+        for (std::deque<Job>::const_iterator job = queue.begin(); job != queue.end(); ++job)
+        {
+          if (job->running() && !job->runningRemotely())
+          {
+            scheduler.addRunning(resourcesFor(*job));
+          }
+        }
+
+        // jobs on remote workers run remotely too, but are limited by the worker slots rather than
+        // by the SLURM job limit
+        int runningSLURM = std::max(0, runningRemotely - m_remoteWorkerManager->activeProcesses());
+        int workerSlots = m_remoteWorkerManager->freeSlots();
+        std::set<std::string> workerTools = m_remoteWorkerManager->tools();
+
+        // Make sure we have as many running as we should have, and as the machine has room for
+        while ((!scheduler.full() || runningSLURM < maxremotejobs || workerSlots > 0) && itr != end)
         {
           boost::optional<Job> parent = itr->parent();
 
           if (itr->runnable())
           {
-            if (runningRemotely < maxremotejobs && m_remoteProcessCreator->hasConnection() && itr->remoteRunnable())
+            if (runningSLURM < maxremotejobs && m_remoteProcessCreator->hasConnection() && itr->remoteRunnable())
             {
               LOG(Info, "Starting job remotely: " << toString(itr->uuid()) << " " << itr->description() );
               itr->start(m_remoteProcessCreator);
+              ++runningSLURM;
+              ++runningRemotely;
+            } else if (workerSlots > 0 && itr->workerRunnable(workerTools)) {
+              LOG(Info, "Starting job on a remote worker: " << toString(itr->uuid()) << " " << itr->description() );
+              itr->start(m_remoteWorkerManager);
+              --workerSlots;
               ++runningRemotely;
-            } else if (runningLocally < maxlocaljobs) {
+            } else if (scheduler.tryStart(resourcesFor(*itr))) {
               LOG(Info, "Starting job locally: " << toString(itr->uuid()) << " " << itr->description() );
               itr->start(m_localProcessCreator);
               ++runningLocally;
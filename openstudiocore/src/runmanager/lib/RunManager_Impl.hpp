@@ -30,7 +30,10 @@
 #include <QDateTime>
 #include "Job.hpp"
 #include "ConfigOptions.hpp"
+#include "JobResources.hpp"
 #include "LocalProcessCreator.hpp"
+#include "RemoteWorkerManager.hpp"
+#include "RubyWorkerPoolOptions.hpp"
 #include "SLURMManager.hpp"
 #include "Workflow.hpp"
 #include "RunManagerStatus.hpp"
@@ -176,6 +179,19 @@ namespace detail {
       /// Passwords are not persisted.
       void setSLURMPassword(const std::string &t_pass);
 
+      /// Sets the options of the pool of long lived ruby processes used to run the scripts of
+      /// RubyJob and UserScriptJob jobs. The pool is disabled by default. Options are not persisted.
+      void setRubyWorkerPoolOptions(const RubyWorkerPoolOptions &t_options);
+
+      /// \returns the options of the ruby worker pool
+      RubyWorkerPoolOptions rubyWorkerPoolOptions() const;
+
+      /// Sets the RemoteWorker daemons jobs are handed to. Workers are not persisted.
+      void setRemoteWorkers(const std::vector<RemoteWorkerEndpoint> &t_workers);
+
+      /// \returns the RemoteWorker daemons jobs are handed to
+      std::vector<RemoteWorkerEndpoint> remoteWorkers() const;
+
       /// Persist a workflow to the database
       /// \returns the key the workflow is stored under
       std::string persistWorkflow(const Workflow &_wf);
@@ -255,6 +271,10 @@ namespace detail {
 
       bool enqueueImpl(openstudio::runmanager::Job t_job, bool force, const openstudio::path &t_path);
 
+      /// \returns the resources to plan for when running the job locally: the defaults of its type,
+      ///          the peak memory learned from earlier runs and any job parameter overrides
+      JobResources resourcesFor(const openstudio::runmanager::Job &t_job) const;
+
 
       mutable QMutex m_mutex;
       mutable QMutex m_activate_mutex;
@@ -276,8 +296,13 @@ namespace detail {
 
       std::string m_SLURMPassword;
 
+      MachineResources m_machineResources;
+      detail::JobResourceHistory m_resourceHistory;
+
+      boost::shared_ptr<detail::RubyWorkerPool> m_rubyWorkerPool;
       boost::shared_ptr<LocalProcessCreator> m_localProcessCreator;
       boost::shared_ptr<SLURMManager> m_remoteProcessCreator;
+      boost::shared_ptr<RemoteWorkerManager> m_remoteWorkerManager;
 
       boost::weak_ptr<runmanager::RunManagerStatus> m_statusUI;
 
@@ -0,0 +1,147 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+#include "RunManagerTestFixture.hpp"
+#include <runmanager/lib/EnergyPlusMonitor.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+using openstudio::runmanager::EarlyTerminationPolicy;
+using openstudio::runmanager::detail::EnergyPlusMonitor;
+
+namespace {
+
+  void appendErr(const openstudio::path &t_path, const std::string &t_text)
+  {
+    boost::filesystem::ofstream ofs(t_path, std::ios_base::out | std::ios_base::app);
+    ofs << t_text;
+  }
+
+  openstudio::path newErrFile(const std::string &t_name)
+  {
+    openstudio::path p = openstudio::toPath(t_name);
+    boost::filesystem::ofstream ofs(p, std::ios_base::out | std::ios_base::trunc);
+    ofs << "Program Version,EnergyPlus-Windows-32 8.0.0.008, YMD=2013.06.13 10:12,IDD_Version 8.0.0.008\n";
+    return p;
+  }
+
+}
+
+TEST_F(RunManagerTestFixture, EarlyTerminationPolicyParams)
+{
+  EarlyTerminationPolicy empty;
+  EXPECT_TRUE(empty.empty());
+  EXPECT_TRUE(EarlyTerminationPolicy(empty.toParams()).empty());
+
+  EarlyTerminationPolicy policy;
+  policy.stopOnSevere = true;
+  policy.maxWarnings = 100;
+  policy.stopPatterns.push_back("Node connection");
+  policy.stopPatterns.push_back("unbalanced exhaust");
+
+  EarlyTerminationPolicy roundTrip(policy.toParams());
+  EXPECT_FALSE(roundTrip.empty());
+  EXPECT_FALSE(roundTrip.stopOnFatal);
+  EXPECT_TRUE(roundTrip.stopOnSevere);
+  ASSERT_TRUE(roundTrip.maxWarnings);
+  EXPECT_EQ(100u, *roundTrip.maxWarnings);
+  EXPECT_EQ(policy.stopPatterns, roundTrip.stopPatterns);
+}
+
+TEST_F(RunManagerTestFixture, EnergyPlusMonitorProgress)
+{
+  EnergyPlusMonitor monitor(openstudio::toPath("EnergyPlusMonitorProgress.err"), EarlyTerminationPolicy());
+
+  EXPECT_FALSE(monitor.standardOutDataAdded(" EnergyPlus Starting\n"));
+
+  boost::optional<openstudio::runmanager::AdvancedStatus> status = monitor.standardOutDataAdded(" Warming up {1}\n Warming up {2}\n Start");
+  ASSERT_TRUE(status);
+  EXPECT_EQ("Warming up, day 2", status->description());
+
+  // the line is completed by the next chunk
+  status = monitor.standardOutDataAdded("ing Simulation at 01/21 for CHICAGO ANN HTG 99% CONDNS DB\n");
+  ASSERT_TRUE(status);
+  EXPECT_EQ(openstudio::runmanager::AdvancedStatusEnum::Processing, status->value().value());
+  EXPECT_EQ("CHICAGO ANN HTG 99% CONDNS DB 01/21", status->description());
+
+  // there is no error file, nothing to stop
+  EXPECT_FALSE(monitor.update());
+}
+
+TEST_F(RunManagerTestFixture, EnergyPlusMonitorStopOnSevere)
+{
+  openstudio::path err = newErrFile("EnergyPlusMonitorStopOnSevere.err");
+
+  EarlyTerminationPolicy policy;
+  policy.stopOnSevere = true;
+  EnergyPlusMonitor monitor(err, policy);
+
+  appendErr(err, "   ** Warning ** GetVertices: Distance between two vertices < .01, possibly coincident.\n");
+  EXPECT_FALSE(monitor.update());
+
+  appendErr(err, "   ** Severe  ** Node Connection Error, Node=\"AIR LOOP OUTLET\", Inlet node did not find an appropriate matching \"outlet\".\n");
+  boost::optional<std::string> reason = monitor.update();
+  ASSERT_TRUE(reason);
+  EXPECT_NE(std::string::npos, reason->find("Node Connection Error"));
+
+  // the reason is only reported once, but the error file is still followed
+  appendErr(err, "   ** Severe  ** Node Connection Error, Node=\"ZONE OUTLET\"\n");
+  EXPECT_FALSE(monitor.update());
+  EXPECT_EQ(2u, monitor.errorFile().severeErrors().size());
+  EXPECT_EQ(1u, monitor.errorFile().warnings().size());
+}
+
+TEST_F(RunManagerTestFixture, EnergyPlusMonitorWarningStorm)
+{
+  openstudio::path err = newErrFile("EnergyPlusMonitorWarningStorm.err");
+
+  EarlyTerminationPolicy policy;
+  policy.maxWarnings = 3;
+  EnergyPlusMonitor monitor(err, policy);
+
+  for (int i = 0; i < 3; ++i)
+  {
+    appendErr(err, "   ** Warning ** CalcDoe2DXCoil: Coil:Cooling:DX:SingleSpeed=\"DX COIL\" - Air volume flow rate per watt of rated total cooling capacity is out of range.\n");
+  }
+  EXPECT_FALSE(monitor.update());
+
+  appendErr(err, "   ** Warning ** CalcDoe2DXCoil: Coil:Cooling:DX:SingleSpeed=\"DX COIL\" - Air volume flow rate per watt of rated total cooling capacity is out of range.\n");
+  EXPECT_TRUE(monitor.update());
+}
+
+TEST_F(RunManagerTestFixture, EnergyPlusMonitorStopPattern)
+{
+  openstudio::path err = newErrFile("EnergyPlusMonitorStopPattern.err");
+
+  EarlyTerminationPolicy policy;
+  policy.stopPatterns.push_back("unbalanced exhaust");
+  EnergyPlusMonitor monitor(err, policy);
+
+  appendErr(err, "   ** Warning ** In AirLoopHVAC RTU9_CAV there is unbalanced\n");
+  EXPECT_FALSE(monitor.update());
+
+  // the pattern spans the continuation line, it is checked once the message is complete
+  appendErr(err, "   **   ~~~   ** exhaust air flow.\n");
+  EXPECT_FALSE(monitor.update());
+
+  appendErr(err, "   ** Warning ** GetVertices: Distance between two vertices < .01, possibly coincident.\n");
+  boost::optional<std::string> reason = monitor.update();
+  ASSERT_TRUE(reason);
+  EXPECT_NE(std::string::npos, reason->find("RTU9_CAV"));
+}
@@ -0,0 +1,168 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+#include "RunManagerTestFixture.hpp"
+#include <runmanager/lib/JobResources.hpp>
+
+using namespace openstudio;
+using namespace openstudio::runmanager;
+
+TEST_F(RunManagerTestFixture, JobResources_Params)
+{
+  JobResources declared(4, 2048, JobIOClass::Light);
+  JobParams params = declared.toParams();
+  params.append("someOtherParam", "value");
+
+  JobResources loaded = JobResources::fromParams(params, JobResources());
+  EXPECT_EQ(4u, loaded.cores);
+  EXPECT_DOUBLE_EQ(2048, loaded.memoryMB);
+  EXPECT_EQ(JobIOClass(JobIOClass::Light), loaded.ioClass);
+
+  // anything not declared, or not readable, comes from the defaults
+  JobParams partial;
+  partial.append("jobMemoryMB", "100");
+  partial.append("jobIOClass", "NotAClass");
+  JobResources defaults(2, 500, JobIOClass::Heavy);
+  JobResources merged = JobResources::fromParams(partial, defaults);
+  EXPECT_EQ(2u, merged.cores);
+  EXPECT_DOUBLE_EQ(100, merged.memoryMB);
+  EXPECT_EQ(JobIOClass(JobIOClass::Heavy), merged.ioClass);
+
+  // an unreadable value only falls back for that value
+  JobParams unreadable;
+  unreadable.append("jobCores", "many");
+  unreadable.append("jobMemoryMB", "300");
+  JobResources mixed = JobResources::fromParams(unreadable, defaults);
+  EXPECT_EQ(2u, mixed.cores);
+  EXPECT_DOUBLE_EQ(300, mixed.memoryMB);
+}
+
+TEST_F(RunManagerTestFixture, JobResources_Defaults)
+{
+  JobResources workflow = JobResources::defaults(JobType::Workflow);
+  EXPECT_EQ(0u, workflow.cores);
+  EXPECT_DOUBLE_EQ(0, workflow.memoryMB);
+
+  JobResources energyplus = JobResources::defaults(JobType::EnergyPlus);
+  EXPECT_EQ(1u, energyplus.cores);
+  EXPECT_LT(0, energyplus.memoryMB);
+  EXPECT_EQ(JobIOClass(JobIOClass::Normal), energyplus.ioClass);
+
+  MachineResources machine = MachineResources::detect();
+  EXPECT_LE(1u, machine.cores);
+  EXPECT_LE(0, machine.memoryMB);
+}
+
+TEST_F(RunManagerTestFixture, JobResources_Scheduler)
+{
+  JobResources small(1, 1000, JobIOClass::Normal);
+  JobResources large(1, 5000, JobIOClass::Normal);
+  JobResources heavy(1, 100, JobIOClass::Heavy);
+  JobResources bookkeeping(0, 0, JobIOClass::Light);
+
+  // memory limits the number of jobs before the cores do
+  {
+    detail::LocalJobScheduler scheduler(MachineResources(8, 4000), 10);
+    EXPECT_TRUE(scheduler.tryStart(small));
+    EXPECT_TRUE(scheduler.tryStart(small));
+    EXPECT_TRUE(scheduler.tryStart(small));
+    EXPECT_FALSE(scheduler.tryStart(small));
+    EXPECT_EQ(3, scheduler.running());
+  }
+
+  // cores
+  {
+    detail::LocalJobScheduler scheduler(MachineResources(2, 0), 10);
+    EXPECT_TRUE(scheduler.tryStart(small));
+    EXPECT_TRUE(scheduler.tryStart(small));
+    EXPECT_FALSE(scheduler.tryStart(small));
+  }
+
+  // job count
+  {
+    detail::LocalJobScheduler scheduler(MachineResources(8, 0), 2);
+    EXPECT_TRUE(scheduler.tryStart(small));
+    EXPECT_TRUE(scheduler.tryStart(small));
+    EXPECT_TRUE(scheduler.full());
+    EXPECT_FALSE(scheduler.tryStart(bookkeeping));
+  }
+
+  // at most half the cores run disk heavy jobs
+  {
+    detail::LocalJobScheduler scheduler(MachineResources(4, 0), 10);
+    EXPECT_TRUE(scheduler.tryStart(heavy));
+    EXPECT_TRUE(scheduler.tryStart(heavy));
+    EXPECT_FALSE(scheduler.tryStart(heavy));
+    EXPECT_TRUE(scheduler.tryStart(small));
+  }
+
+  // a parametric run of simulations with default resources uses every core it is allowed to,
+  // the default job limit is one less than the number of cores
+  {
+    detail::LocalJobScheduler scheduler(MachineResources(8, 0), 7);
+    JobResources energyplus = JobResources::defaults(JobType::EnergyPlus);
+    for (int i = 0; i < 7; ++i)
+    {
+      EXPECT_TRUE(scheduler.tryStart(energyplus)) << i;
+    }
+    EXPECT_EQ(7, scheduler.running());
+    EXPECT_TRUE(scheduler.full());
+  }
+
+  // a job larger than the machine still runs when nothing else that uses resources is
+  {
+    detail::LocalJobScheduler scheduler(MachineResources(8, 4000), 10);
+    scheduler.addRunning(bookkeeping);
+    EXPECT_TRUE(scheduler.tryStart(large));
+    EXPECT_FALSE(scheduler.tryStart(small));
+  }
+
+  // a blocked job keeps its room, smaller jobs behind it only fill what is left
+  {
+    detail::LocalJobScheduler scheduler(MachineResources(8, 4000), 10);
+    scheduler.addRunning(JobResources(1, 1500, JobIOClass::Normal));
+    EXPECT_FALSE(scheduler.tryStart(JobResources(1, 2500, JobIOClass::Normal)));
+    EXPECT_FALSE(scheduler.tryStart(small));
+    EXPECT_TRUE(scheduler.tryStart(bookkeeping));
+  }
+}
+
+TEST_F(RunManagerTestFixture, JobResources_History)
+{
+  detail::JobResourceHistory history;
+  EXPECT_FALSE(history.memoryMB(JobType::EnergyPlus));
+
+  detail::JobResourceHistory::Entry entry = history.record(JobType::EnergyPlus, 500);
+  EXPECT_EQ(1, entry.runs);
+  EXPECT_DOUBLE_EQ(500, *history.memoryMB(JobType::EnergyPlus));
+
+  // larger runs are taken immediately
+  history.record(JobType::EnergyPlus, 1000);
+  EXPECT_DOUBLE_EQ(1000, *history.memoryMB(JobType::EnergyPlus));
+
+  // smaller runs pull the estimate down slowly
+  entry = history.record(JobType::EnergyPlus, 500);
+  EXPECT_EQ(3, entry.runs);
+  EXPECT_DOUBLE_EQ(900, *history.memoryMB(JobType::EnergyPlus));
+
+  EXPECT_FALSE(history.memoryMB(JobType::ReadVars));
+  history.set(JobType(JobType::ReadVars).valueName(), entry);
+  EXPECT_DOUBLE_EQ(900, *history.memoryMB(JobType::ReadVars));
+}
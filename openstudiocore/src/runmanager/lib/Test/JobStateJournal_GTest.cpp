@@ -0,0 +1,176 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+#include "RunManagerTestFixture.hpp"
+#include <runmanager/lib/JobStateJournal.hpp>
+
+#include <utilities/core/Path.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <QFile>
+
+using namespace openstudio;
+using openstudio::runmanager::detail::JobStateJournal;
+
+namespace {
+  openstudio::path journalPath(const std::string &t_name)
+  {
+    openstudio::path outdir = openstudio::tempDir() / openstudio::toPath("JobStateJournal");
+    boost::filesystem::create_directories(outdir);
+    openstudio::path p = outdir / openstudio::toPath(t_name + ".journal");
+    boost::filesystem::remove(p);
+    return p;
+  }
+
+  QVariantList jobRows(const openstudio::UUID &t_uuid)
+  {
+    QVariantMap row;
+    row["uuid"] = t_uuid.toString();
+    row["index"] = 3;
+    QVariantList rows;
+    rows.push_back(row);
+    return rows;
+  }
+
+  QVariantMap status(const QString &t_lastRun)
+  {
+    QVariantMap s;
+    s["lastRun"] = t_lastRun;
+    return s;
+  }
+}
+
+TEST_F(RunManagerTestFixture, JobStateJournal_Replay)
+{
+  openstudio::path p = journalPath("Replay");
+  openstudio::UUID job = createUUID();
+
+  {
+    JobStateJournal journal(p);
+    EXPECT_TRUE(journal.empty());
+    EXPECT_FALSE(boost::filesystem::exists(p));
+
+    journal.addJobs(jobRows(job));
+    journal.addStatus(job, status("first"));
+    journal.addStatus(job, status("second"));
+
+    // the second status replaces the first
+    EXPECT_EQ(2u, journal.size());
+    EXPECT_TRUE(boost::filesystem::exists(p));
+
+    // nothing committed, as if the process had exited before the flush
+  }
+
+  {
+    JobStateJournal journal(p);
+    std::vector<JobStateJournal::Record> records = journal.pending();
+    ASSERT_EQ(2u, records.size());
+
+    EXPECT_EQ(JobStateJournal::Record::PersistJobs, records[0].type);
+    ASSERT_EQ(1, records[0].data.toList().size());
+    EXPECT_EQ(job, openstudio::UUID(records[0].data.toList()[0].toMap()["uuid"].toString()));
+    EXPECT_EQ(3, records[0].data.toList()[0].toMap()["index"].toInt());
+
+    EXPECT_EQ(JobStateJournal::Record::PersistStatus, records[1].type);
+    EXPECT_EQ(job, records[1].uuid);
+    EXPECT_EQ("second", toString(records[1].data.toMap()["lastRun"].toString()));
+    EXPECT_LT(records[0].sequence, records[1].sequence);
+
+    journal.committed(records.back().sequence);
+    EXPECT_TRUE(journal.empty());
+    EXPECT_FALSE(boost::filesystem::exists(p));
+  }
+
+  {
+    JobStateJournal journal(p);
+    EXPECT_TRUE(journal.empty());
+  }
+}
+
+TEST_F(RunManagerTestFixture, JobStateJournal_PartialCommit)
+{
+  openstudio::path p = journalPath("PartialCommit");
+  openstudio::UUID job1 = createUUID();
+  openstudio::UUID job2 = createUUID();
+
+  {
+    JobStateJournal journal(p);
+    journal.addStatus(job1, status("1"));
+    std::vector<JobStateJournal::Record> flushed = journal.pending();
+
+    // changes keep arriving while the batch is written
+    journal.addStatus(job2, status("2"));
+    journal.committed(flushed.back().sequence);
+
+    ASSERT_EQ(1u, journal.size());
+    EXPECT_EQ(job2, journal.pending()[0].uuid);
+  }
+
+  {
+    JobStateJournal journal(p);
+    ASSERT_EQ(1u, journal.size());
+    EXPECT_EQ(job2, journal.pending()[0].uuid);
+  }
+}
+
+TEST_F(RunManagerTestFixture, JobStateJournal_DeleteDropsStatus)
+{
+  openstudio::path p = journalPath("DeleteDropsStatus");
+  openstudio::UUID job1 = createUUID();
+  openstudio::UUID job2 = createUUID();
+
+  JobStateJournal journal(p);
+  journal.addStatus(job1, status("1"));
+  journal.addStatus(job2, status("2"));
+  journal.addDeletes(std::vector<openstudio::UUID>(1, job1));
+
+  std::vector<JobStateJournal::Record> records = journal.pending();
+  ASSERT_EQ(2u, records.size());
+  EXPECT_EQ(JobStateJournal::Record::PersistStatus, records[0].type);
+  EXPECT_EQ(job2, records[0].uuid);
+  EXPECT_EQ(JobStateJournal::Record::DeleteJobs, records[1].type);
+  ASSERT_EQ(1, records[1].data.toList().size());
+  EXPECT_EQ(job1, openstudio::UUID(records[1].data.toList()[0].toString()));
+}
+
+TEST_F(RunManagerTestFixture, JobStateJournal_TruncatedRecord)
+{
+  openstudio::path p = journalPath("TruncatedRecord");
+  openstudio::UUID job = createUUID();
+
+  {
+    JobStateJournal journal(p);
+    journal.addStatus(job, status("complete"));
+  }
+
+  {
+    // simulate a record cut off part way through being written
+    QFile f(toQString(p));
+    ASSERT_TRUE(f.open(QIODevice::WriteOnly | QIODevice::Append));
+    const char partial[] = { 0, 0, 1, 0, 0x12, 0x34, 'x' };
+    f.write(partial, sizeof(partial));
+  }
+
+  JobStateJournal journal(p);
+  ASSERT_EQ(1u, journal.size());
+  EXPECT_EQ(job, journal.pending()[0].uuid);
+  EXPECT_EQ("complete", toString(journal.pending()[0].data.toMap()["lastRun"].toString()));
+}
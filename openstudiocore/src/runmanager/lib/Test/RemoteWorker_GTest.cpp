@@ -0,0 +1,593 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+#include "RunManagerTestFixture.hpp"
+#include <runmanager/Test/ToolBin.hxx>
+#include <runmanager/lib/RunManager.hpp>
+#include <runmanager/lib/RubyJobUtils.hpp>
+#include <runmanager/lib/RemoteWorker.hpp>
+#include <runmanager/lib/RemoteWorkerManager.hpp>
+#include <runmanager/lib/RemoteWorkerProtocol.hpp>
+
+#include <utilities/core/Application.hpp>
+
+#include <QCoreApplication>
+#include <QDirIterator>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTime>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <map>
+#include <set>
+#include <stdexcept>
+
+using namespace openstudio;
+using namespace openstudio::runmanager;
+
+namespace {
+
+  openstudio::path testDir()
+  {
+    return openstudio::tempDir() / openstudio::toPath("RemoteWorkerTest");
+  }
+
+  const std::string secret("remote worker test secret");
+
+  std::map<std::string, openstudio::path> rubyTool()
+  {
+    std::map<std::string, openstudio::path> tools;
+    tools["ruby"] = rubyExePath();
+    return tools;
+  }
+
+  void writeFile(const openstudio::path &t_path, const std::string &t_contents)
+  {
+    boost::filesystem::create_directories(t_path.parent_path());
+    boost::filesystem::ofstream ofs(t_path, std::ios_base::binary | std::ios_base::trunc);
+    ofs << t_contents;
+  }
+
+  std::string readFile(const openstudio::path &t_path)
+  {
+    boost::filesystem::ifstream ifs(t_path, std::ios_base::binary);
+    return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  }
+
+  // workers and manager live in this thread, so events are processed while waiting
+  void waitForFreeSlots(const RemoteWorkerManager &t_manager, int t_slots)
+  {
+    QTime timer;
+    timer.start();
+    while (t_manager.freeSlots() < t_slots && timer.elapsed() < 30000)
+    {
+      openstudio::Application::instance().processEvents(100);
+    }
+  }
+
+  void waitForJob(const Job &t_job)
+  {
+    QTime timer;
+    timer.start();
+    while (t_job.running() && timer.elapsed() < 120000)
+    {
+      openstudio::Application::instance().processEvents(100);
+    }
+  }
+
+  // waits for a file the script creates in its run directory on the worker
+  bool waitForWorkerFile(const openstudio::path &t_workDir, const QString &t_name)
+  {
+    QTime timer;
+    timer.start();
+    while (timer.elapsed() < 60000)
+    {
+      QDirIterator itr(toQString(t_workDir / openstudio::toPath("jobs")), QStringList(t_name), QDir::Files, QDirIterator::Subdirectories);
+      if (itr.hasNext())
+      {
+        return true;
+      }
+      openstudio::Application::instance().processEvents(100);
+    }
+    return false;
+  }
+
+  Job createScriptJob(const openstudio::path &t_script, const std::string &t_outdir)
+  {
+    Workflow wf;
+    openstudio::path outdir = testDir() / openstudio::toPath(t_outdir);
+
+    RubyJobBuilder rubyjobbuilder;
+    rubyjobbuilder.setScriptFile(t_script);
+    rubyjobbuilder.addToWorkflow(wf);
+
+    wf.add(ConfigOptions::makeTools(openstudio::path(), openstudio::path(), openstudio::path(),
+          rubyExePath().parent_path(), openstudio::path(),
+          openstudio::path(), openstudio::path(), openstudio::path(), openstudio::path(), openstudio::path()));
+
+    boost::filesystem::remove_all(outdir);
+
+    return wf.create(outdir);
+  }
+
+  Job runScript(const boost::shared_ptr<RemoteWorkerManager> &t_manager, const openstudio::path &t_script,
+      const std::string &t_outdir)
+  {
+    Job j = createScriptJob(t_script, t_outdir);
+    j.start(t_manager);
+    waitForJob(j);
+    return j;
+  }
+
+  // plays a worker that does not know the secret for t_msecs: every connection to t_server is
+  // answered with a Hello offering ruby, right away or after the Challenge and the manager's
+  // Authenticate if t_challenge is set
+  // \returns the messages the manager sent
+  std::vector<detail::RemoteWorkerMessage> runFakeWorker(QTcpServer &t_server, bool t_challenge, int t_msecs)
+  {
+    QVariantMap hello;
+    hello["protocol"] = detail::RemoteWorkerMessage::ProtocolVersion;
+    hello["slots"] = 1;
+    hello["name"] = "fake";
+    hello["tools"] = QStringList("ruby");
+
+    std::vector<boost::shared_ptr<QTcpSocket> > sockets;
+    std::vector<boost::shared_ptr<detail::RemoteWorkerFrameReader> > readers;
+    std::vector<detail::RemoteWorkerMessage> received;
+
+    QTime timer;
+    timer.start();
+    while (timer.elapsed() < t_msecs)
+    {
+      openstudio::Application::instance().processEvents(100);
+
+      while (t_server.hasPendingConnections())
+      {
+        boost::shared_ptr<QTcpSocket> socket(t_server.nextPendingConnection());
+        socket->setParent(0);
+        sockets.push_back(socket);
+        readers.push_back(boost::shared_ptr<detail::RemoteWorkerFrameReader>(new detail::RemoteWorkerFrameReader()));
+
+        if (t_challenge)
+        {
+          QVariantMap challenge;
+          challenge["protocol"] = detail::RemoteWorkerMessage::ProtocolVersion;
+          challenge["nonce"] = detail::remoteWorkerNonce();
+          socket->write(detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::Challenge, challenge).encode());
+        } else {
+          socket->write(detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::Hello, hello).encode());
+        }
+      }
+
+      for (unsigned i = 0; i < sockets.size(); ++i)
+      {
+        readers[i]->append(sockets[i]->readAll());
+        while (boost::optional<detail::RemoteWorkerMessage> message = readers[i]->next())
+        {
+          received.push_back(*message);
+
+          if (message->type == detail::RemoteWorkerMessage::Authenticate)
+          {
+            // answers the manager's nonce, but with the wrong secret
+            QVariantMap answer = hello;
+            answer["response"] = detail::remoteWorkerResponse("wrong secret", detail::RemoteWorkerWorkerRole,
+                message->data["nonce"].toByteArray());
+            sockets[i]->write(detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::Hello, answer).encode());
+          }
+        }
+      }
+    }
+
+    return received;
+  }
+
+  bool containsMessage(const std::vector<detail::RemoteWorkerMessage> &t_messages, detail::RemoteWorkerMessage::Type t_type)
+  {
+    for (std::vector<detail::RemoteWorkerMessage>::const_iterator itr = t_messages.begin(); itr != t_messages.end(); ++itr)
+    {
+      if (itr->type == t_type)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+}
+
+TEST_F(RunManagerTestFixture, RemoteWorker_Frames)
+{
+  QVariantMap data;
+  data["job"] = 7;
+  data["data"] = QByteArray(1000, 'x');
+  QByteArray frames = detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::StdOut, data).encode()
+    + detail::RemoteWorkerMessage(detail::RemoteWorkerMessage::Release, QVariantMap()).encode();
+
+  // messages arrive split at arbitrary byte boundaries
+  detail::RemoteWorkerFrameReader reader;
+  std::vector<detail::RemoteWorkerMessage> messages;
+  for (int i = 0; i < frames.size(); ++i)
+  {
+    reader.append(frames.mid(i, 1));
+    boost::optional<detail::RemoteWorkerMessage> message = reader.next();
+    if (message)
+    {
+      messages.push_back(*message);
+    }
+  }
+  EXPECT_FALSE(reader.next());
+
+  ASSERT_EQ(2u, messages.size());
+  EXPECT_EQ(detail::RemoteWorkerMessage::StdOut, messages[0].type);
+  EXPECT_EQ(7, messages[0].data["job"].toInt());
+  EXPECT_EQ(QByteArray(1000, 'x'), messages[0].data["data"].toByteArray());
+  EXPECT_EQ(detail::RemoteWorkerMessage::Release, messages[1].type);
+  EXPECT_TRUE(messages[1].data.isEmpty());
+
+  // a frame longer than any message is a corrupt stream
+  detail::RemoteWorkerFrameReader corrupt;
+  corrupt.append(QByteArray(4, '\xff'));
+  EXPECT_THROW(corrupt.next(), std::runtime_error);
+
+  // HMAC-SHA1 test case 2 of RFC 2202
+  EXPECT_EQ(QByteArray("effcdf6ae5eb2fa2d27416d5f184df9c259a7c79"),
+      detail::remoteWorkerHmac("Jefe", "what do ya want for nothing?").toHex());
+
+  // the response depends on the secret, the nonce and the side answering
+  QByteArray response = detail::remoteWorkerResponse("secret", detail::RemoteWorkerManagerRole, "nonce");
+  EXPECT_EQ(40, response.size());
+  EXPECT_EQ(response, detail::remoteWorkerResponse("secret", detail::RemoteWorkerManagerRole, "nonce"));
+  EXPECT_NE(response, detail::remoteWorkerResponse("secret", detail::RemoteWorkerManagerRole, "other nonce"));
+  EXPECT_NE(response, detail::remoteWorkerResponse("other secret", detail::RemoteWorkerManagerRole, "nonce"));
+  EXPECT_NE(response, detail::remoteWorkerResponse("secret", detail::RemoteWorkerWorkerRole, "nonce"));
+  EXPECT_TRUE(detail::remoteWorkerResponseMatches(response, response));
+  EXPECT_FALSE(detail::remoteWorkerResponseMatches(response.left(39), response));
+  EXPECT_NE(detail::remoteWorkerNonce(), detail::remoteWorkerNonce());
+
+  EXPECT_TRUE(detail::isRemoteWorkerPortableParameter("in.rb", "/runs/1"));
+  EXPECT_TRUE(detail::isRemoteWorkerPortableParameter("-I.", "/runs/1"));
+  EXPECT_TRUE(detail::isRemoteWorkerPortableParameter("/runs/1/in.idf", "/runs/1"));
+  EXPECT_FALSE(detail::isRemoteWorkerPortableParameter("/runs/10/in.idf", "/runs/1"));
+  EXPECT_FALSE(detail::isRemoteWorkerPortableParameter("/usr/lib/ruby", "/runs/1"));
+  EXPECT_FALSE(detail::isRemoteWorkerPortableParameter("-I/usr/lib/ruby", "/runs/1"));
+
+  EXPECT_TRUE(detail::isRemoteWorkerRelativePath("out/eplusout.sql"));
+  EXPECT_FALSE(detail::isRemoteWorkerRelativePath("../eplusout.sql"));
+  EXPECT_FALSE(detail::isRemoteWorkerRelativePath("out/../../eplusout.sql"));
+  EXPECT_FALSE(detail::isRemoteWorkerRelativePath("/etc/passwd"));
+}
+
+TEST_F(RunManagerTestFixture, RemoteWorker_FileCache)
+{
+  openstudio::path dir = testDir() / openstudio::toPath("FileCache");
+  boost::filesystem::remove_all(dir);
+
+  openstudio::path source = dir / openstudio::toPath("source.txt");
+  writeFile(source, "some input file");
+  std::string hash = detail::RemoteWorkerFileCache::hashFile(source);
+  EXPECT_TRUE(detail::isRemoteWorkerHash(hash));
+  EXPECT_FALSE(detail::isRemoteWorkerHash("../" + hash.substr(3)));
+
+  detail::RemoteWorkerFileCache cache(dir / openstudio::toPath("cache"));
+  EXPECT_FALSE(cache.has(hash));
+
+  cache.receive(hash, QByteArray("some input "), false);
+  EXPECT_FALSE(cache.has(hash));
+  cache.receive(hash, QByteArray("file"), true);
+  EXPECT_TRUE(cache.has(hash));
+
+  openstudio::path dest = dir / openstudio::toPath("run/sub/in.txt");
+  cache.install(hash, dest);
+  EXPECT_EQ("some input file", readFile(dest));
+
+  // a file that does not match its hash is not cached
+  std::string otherHash = std::string(hash.rbegin(), hash.rend());
+  EXPECT_THROW(cache.receive(otherHash, QByteArray("some input file"), true), std::runtime_error);
+  EXPECT_FALSE(cache.has(otherHash));
+
+  // a stale partial file is cleared when the cache is opened
+  openstudio::path cacheDir = dir / openstudio::toPath("cache2");
+  writeFile(cacheDir / openstudio::toPath(hash + ".part"), "stale data");
+  detail::RemoteWorkerFileCache cache2(cacheDir);
+  EXPECT_FALSE(boost::filesystem::exists(cacheDir / openstudio::toPath(hash + ".part")));
+
+  // an abandoned transfer starts over with its next first chunk
+  cache2.receive(hash, QByteArray("garbage "), false);
+  cache2.abandon(hash);
+  EXPECT_FALSE(boost::filesystem::exists(cacheDir / openstudio::toPath(hash + ".part")));
+  writeFile(cacheDir / openstudio::toPath(hash + ".part"), "stale data");
+  cache2.receive(hash, QByteArray("some input "), false);
+  cache2.receive(hash, QByteArray("file"), true);
+  EXPECT_TRUE(cache2.has(hash));
+}
+
+TEST_F(RunManagerTestFixture, RemoteWorker_RunRuby)
+{
+  boost::filesystem::remove_all(testDir() / openstudio::toPath("Run"));
+
+  openstudio::path script = testDir() / openstudio::toPath("Run/script.rb");
+  writeFile(script, "File.open('out.txt', 'w') { |f| f << 'ran remotely' }\n");
+
+  RemoteWorker worker(testDir() / openstudio::toPath("Run/worker"), 1, secret, rubyTool());
+  ASSERT_TRUE(worker.listen(QHostAddress(QHostAddress::LocalHost), 0));
+  EXPECT_NE(0, worker.port());
+  EXPECT_EQ(1, worker.slotCount());
+
+  boost::shared_ptr<RemoteWorkerManager> manager(new RemoteWorkerManager());
+  manager->setWorkers(std::vector<RemoteWorkerEndpoint>(1, RemoteWorkerEndpoint("127.0.0.1", worker.port(), secret)));
+  waitForFreeSlots(*manager, 1);
+  ASSERT_EQ(1, manager->freeSlots());
+  EXPECT_EQ(1u, manager->tools().count("ruby"));
+
+  Job j = runScript(manager, script, "Run/first");
+  EXPECT_FALSE(j.running());
+  EXPECT_TRUE(j.errors().succeeded());
+  EXPECT_EQ("ran remotely", readFile(j.outdir() / openstudio::toPath("out.txt")));
+  EXPECT_EQ(0, manager->activeProcesses());
+
+  int filesSent = manager->filesSent();
+  EXPECT_LT(0, filesSent);
+
+  // the worker already has the script, nothing is sent again
+  Job j2 = runScript(manager, script, "Run/second");
+  EXPECT_TRUE(j2.errors().succeeded());
+  EXPECT_EQ("ran remotely", readFile(j2.outdir() / openstudio::toPath("out.txt")));
+  EXPECT_EQ(filesSent, manager->filesSent());
+}
+
+TEST_F(RunManagerTestFixture, RemoteWorker_LocalSocket)
+{
+  boost::filesystem::remove_all(testDir() / openstudio::toPath("LocalSocket"));
+
+  openstudio::path script = testDir() / openstudio::toPath("LocalSocket/script.rb");
+  writeFile(script, "File.open('out.txt', 'w') { |f| f << 'ran locally' }\n");
+
+  QString socketName = QString("RemoteWorkerTest%1").arg(QCoreApplication::applicationPid());
+  RemoteWorker worker(testDir() / openstudio::toPath("LocalSocket/worker"), 2, secret, rubyTool());
+  ASSERT_TRUE(worker.listen(socketName));
+
+  boost::shared_ptr<RemoteWorkerManager> manager(new RemoteWorkerManager());
+  manager->setWorkers(std::vector<RemoteWorkerEndpoint>(1, RemoteWorkerEndpoint(toString(socketName), secret)));
+  waitForFreeSlots(*manager, 2);
+  ASSERT_EQ(2, manager->freeSlots());
+
+  Job j = runScript(manager, script, "LocalSocket/run");
+  EXPECT_TRUE(j.errors().succeeded());
+  EXPECT_EQ("ran locally", readFile(j.outdir() / openstudio::toPath("out.txt")));
+
+  // workers are dropped when no longer listed
+  manager->setWorkers(std::vector<RemoteWorkerEndpoint>());
+  openstudio::Application::instance().processEvents(100);
+  EXPECT_TRUE(manager->workers().empty());
+  EXPECT_EQ(0, manager->freeSlots());
+}
+
+TEST_F(RunManagerTestFixture, RemoteWorker_Authentication)
+{
+  EXPECT_THROW(RemoteWorker(testDir() / openstudio::toPath("Authentication/noSecret"), 1, "", rubyTool()), std::runtime_error);
+
+  RemoteWorker worker(testDir() / openstudio::toPath("Authentication/worker"), 1, secret, rubyTool());
+  ASSERT_TRUE(worker.listen(QHostAddress(QHostAddress::LocalHost), 0));
+
+  // a manager that does not know the secret never sees a free slot
+  boost::shared_ptr<RemoteWorkerManager> manager(new RemoteWorkerManager());
+  manager->setWorkers(std::vector<RemoteWorkerEndpoint>(1, RemoteWorkerEndpoint("127.0.0.1", worker.port(), "wrong secret")));
+
+  QTime timer;
+  timer.start();
+  while (timer.elapsed() < 2000)
+  {
+    openstudio::Application::instance().processEvents(100);
+  }
+  EXPECT_EQ(0, manager->freeSlots());
+  EXPECT_TRUE(manager->tools().empty());
+
+  manager->setWorkers(std::vector<RemoteWorkerEndpoint>(1, RemoteWorkerEndpoint("127.0.0.1", worker.port(), secret)));
+  waitForFreeSlots(*manager, 1);
+  ASSERT_EQ(1, manager->freeSlots());
+
+  // only jobs whose tools the workers were configured with are handed to them
+  openstudio::path script = testDir() / openstudio::toPath("Authentication/script.rb");
+  writeFile(script, "puts 'hello'\n");
+
+  Workflow wf;
+  RubyJobBuilder rubyjobbuilder;
+  rubyjobbuilder.setScriptFile(script);
+  rubyjobbuilder.addToWorkflow(wf);
+  wf.add(ConfigOptions::makeTools(openstudio::path(), openstudio::path(), openstudio::path(),
+        rubyExePath().parent_path(), openstudio::path(),
+        openstudio::path(), openstudio::path(), openstudio::path(), openstudio::path(), openstudio::path()));
+  Job j = wf.create(testDir() / openstudio::toPath("Authentication/run"));
+
+  std::set<std::string> otherTools;
+  otherTools.insert("energyplus");
+  EXPECT_TRUE(j.workerRunnable(manager->tools()));
+  EXPECT_FALSE(j.workerRunnable(otherTools));
+
+  // include directories on this machine would not resolve on a worker
+  Workflow wfInclude;
+  RubyJobBuilder includeBuilder;
+  includeBuilder.setScriptFile(script);
+  includeBuilder.setIncludeDir(rubyExePath().parent_path());
+  includeBuilder.addToWorkflow(wfInclude);
+  wfInclude.add(ConfigOptions::makeTools(openstudio::path(), openstudio::path(), openstudio::path(),
+        rubyExePath().parent_path(), openstudio::path(),
+        openstudio::path(), openstudio::path(), openstudio::path(), openstudio::path(), openstudio::path()));
+  Job jInclude = wfInclude.create(testDir() / openstudio::toPath("Authentication/include"));
+  EXPECT_FALSE(jInclude.workerRunnable(manager->tools()));
+}
+
+TEST_F(RunManagerTestFixture, RemoteWorker_WorkerAuthentication)
+{
+  boost::filesystem::remove_all(testDir() / openstudio::toPath("WorkerAuthentication"));
+
+  openstudio::path script = testDir() / openstudio::toPath("WorkerAuthentication/script.rb");
+  writeFile(script, "puts 'hello'\n");
+
+  for (int challenge = 0; challenge < 2; ++challenge)
+  {
+    // something answering at a worker's endpoint without knowing the secret is never sent a job
+    QTcpServer server;
+    ASSERT_TRUE(server.listen(QHostAddress(QHostAddress::LocalHost), 0));
+
+    boost::shared_ptr<RemoteWorkerManager> manager(new RemoteWorkerManager());
+    manager->setWorkers(std::vector<RemoteWorkerEndpoint>(1, RemoteWorkerEndpoint("127.0.0.1", server.serverPort(), secret)));
+
+    Job j = createScriptJob(script, challenge ? "WorkerAuthentication/challenge" : "WorkerAuthentication/hello");
+    j.start(manager);
+
+    std::vector<detail::RemoteWorkerMessage> received = runFakeWorker(server, challenge != 0, 3000);
+    EXPECT_EQ(challenge != 0, containsMessage(received, detail::RemoteWorkerMessage::Authenticate));
+    EXPECT_FALSE(containsMessage(received, detail::RemoteWorkerMessage::Submit));
+    EXPECT_EQ(0, manager->freeSlots());
+    EXPECT_TRUE(manager->tools().empty());
+
+    j.requestStop();
+    waitForJob(j);
+    EXPECT_FALSE(j.running());
+  }
+}
+
+TEST_F(RunManagerTestFixture, RemoteWorker_RunManagerQueue)
+{
+  boost::filesystem::remove_all(testDir() / openstudio::toPath("Queue"));
+
+  // the script reports where it ran
+  openstudio::path script = testDir() / openstudio::toPath("Queue/script.rb");
+  writeFile(script, "File.open('out.txt', 'w') { |f| f << Dir.pwd }\n");
+
+  RemoteWorker worker(testDir() / openstudio::toPath("Queue/queueworker"), 1, secret, rubyTool());
+  ASSERT_TRUE(worker.listen(QHostAddress(QHostAddress::LocalHost), 0));
+
+  RunManager rm(true);
+  rm.setRemoteWorkers(std::vector<RemoteWorkerEndpoint>(1, RemoteWorkerEndpoint("127.0.0.1", worker.port(), secret)));
+
+  // let the connection be made before the queue is processed
+  QTime timer;
+  timer.start();
+  while (timer.elapsed() < 2000)
+  {
+    openstudio::Application::instance().processEvents(100);
+  }
+
+  Job j = createScriptJob(script, "Queue/run");
+  rm.enqueue(j, true);
+  rm.setPaused(false);
+
+  timer.start();
+  while (rm.workPending() && timer.elapsed() < 120000)
+  {
+    openstudio::Application::instance().processEvents(100);
+  }
+
+  EXPECT_FALSE(j.running());
+  EXPECT_TRUE(j.errors().succeeded());
+
+  std::string ranIn = readFile(j.outdir() / openstudio::toPath("out.txt"));
+  EXPECT_NE(std::string::npos, ranIn.find("queueworker")) << ranIn;
+}
+
+TEST_F(RunManagerTestFixture, RemoteWorker_Kill)
+{
+  boost::filesystem::remove_all(testDir() / openstudio::toPath("Kill"));
+
+  openstudio::path script = testDir() / openstudio::toPath("Kill/script.rb");
+  writeFile(script, "File.open('started.txt', 'w') { |f| f << 'started' }\nsleep 600\n");
+
+  openstudio::path workDir = testDir() / openstudio::toPath("Kill/worker");
+  RemoteWorker worker(workDir, 1, secret, rubyTool());
+  ASSERT_TRUE(worker.listen(QHostAddress(QHostAddress::LocalHost), 0));
+
+  boost::shared_ptr<RemoteWorkerManager> manager(new RemoteWorkerManager());
+  manager->setWorkers(std::vector<RemoteWorkerEndpoint>(1, RemoteWorkerEndpoint("127.0.0.1", worker.port(), secret)));
+  waitForFreeSlots(*manager, 1);
+  ASSERT_EQ(1, manager->freeSlots());
+
+  Job j = createScriptJob(script, "Kill/run");
+  j.start(manager);
+  ASSERT_TRUE(waitForWorkerFile(workDir, "started.txt"));
+
+  QTime timer;
+  timer.start();
+  j.requestStop();
+  waitForJob(j);
+
+  EXPECT_FALSE(j.running());
+  EXPECT_LT(timer.elapsed(), 60000);
+  EXPECT_FALSE(j.errors().succeeded());
+  EXPECT_EQ(0, manager->activeProcesses());
+
+  // the slot is free again
+  waitForFreeSlots(*manager, 1);
+  EXPECT_EQ(1, manager->freeSlots());
+}
+
+TEST_F(RunManagerTestFixture, RemoteWorker_LostWorker)
+{
+  boost::filesystem::remove_all(testDir() / openstudio::toPath("LostWorker"));
+
+  openstudio::path script = testDir() / openstudio::toPath("LostWorker/script.rb");
+  writeFile(script, "File.open('started.txt', 'w') { |f| f << 'started' }\nsleep 600\n");
+
+  openstudio::path workDir = testDir() / openstudio::toPath("LostWorker/worker");
+  boost::shared_ptr<RemoteWorker> worker(new RemoteWorker(workDir, 1, secret, rubyTool()));
+  ASSERT_TRUE(worker->listen(QHostAddress(QHostAddress::LocalHost), 0));
+
+  boost::shared_ptr<RemoteWorkerManager> manager(new RemoteWorkerManager());
+  manager->setWorkers(std::vector<RemoteWorkerEndpoint>(1, RemoteWorkerEndpoint("127.0.0.1", worker->port(), secret)));
+  waitForFreeSlots(*manager, 1);
+  ASSERT_EQ(1, manager->freeSlots());
+
+  Job j = createScriptJob(script, "LostWorker/run");
+  j.start(manager);
+  ASSERT_TRUE(waitForWorkerFile(workDir, "started.txt"));
+
+  // the worker goes away mid job, the job fails instead of waiting forever
+  worker.reset();
+  waitForJob(j);
+
+  EXPECT_FALSE(j.running());
+  EXPECT_FALSE(j.errors().succeeded());
+  EXPECT_EQ(0, manager->activeProcesses());
+  EXPECT_EQ(0, manager->freeSlots());
+}
+
+TEST_F(RunManagerTestFixture, RemoteWorker_RunManagerWorkers)
+{
+  RunManager rm;
+  EXPECT_TRUE(rm.remoteWorkers().empty());
+
+  std::vector<RemoteWorkerEndpoint> workers;
+  workers.push_back(RemoteWorkerEndpoint("localhost", 4400, secret));
+  workers.push_back(RemoteWorkerEndpoint("worker-socket", secret));
+  rm.setRemoteWorkers(workers);
+
+  std::vector<RemoteWorkerEndpoint> current = rm.remoteWorkers();
+  ASSERT_EQ(2u, current.size());
+  EXPECT_TRUE(current[0] == workers[0]);
+  EXPECT_TRUE(current[1] == workers[1]);
+  EXPECT_EQ("localhost:4400", current[0].toString());
+  EXPECT_EQ("worker-socket", current[1].toString());
+
+  rm.setRemoteWorkers(std::vector<RemoteWorkerEndpoint>());
+  EXPECT_TRUE(rm.remoteWorkers().empty());
+}
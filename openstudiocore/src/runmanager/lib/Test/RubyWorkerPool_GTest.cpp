@@ -0,0 +1,159 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+#include "RunManagerTestFixture.hpp"
+#include <runmanager/Test/ToolBin.hxx>
+#include <runmanager/lib/RunManager.hpp>
+#include <runmanager/lib/RubyJobUtils.hpp>
+#include <runmanager/lib/RubyWorkerPool.hpp>
+
+#include <utilities/core/ApplicationPathHelpers.hpp>
+
+#include <ruleset/OSResult.hpp>
+
+#include <boost/filesystem/path.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <resources.hxx>
+
+using namespace openstudio;
+
+namespace {
+
+  openstudio::runmanager::JobErrors runScript(openstudio::runmanager::RunManager &t_rm, 
+      const std::string &t_script, const std::string &t_outdir)
+  {
+    openstudio::runmanager::Workflow wf;
+    openstudio::path outdir = openstudio::tempDir() / openstudio::toPath("RubyWorkerPoolTest") / openstudio::toPath(t_outdir);
+
+    openstudio::runmanager::RubyJobBuilder rubyjobbuilder;
+    rubyjobbuilder.setScriptFile(resourcesPath() / openstudio::toPath("runmanager") / openstudio::toPath(t_script));
+    rubyjobbuilder.setIncludeDir(getOpenStudioRubyIncludePath());
+    rubyjobbuilder.addToWorkflow(wf);
+
+    wf.add(openstudio::runmanager::ConfigOptions::makeTools(energyPlusExePath().parent_path(), openstudio::path(), openstudio::path(), 
+          rubyExePath().parent_path(), openstudio::path(),
+          openstudio::path(), openstudio::path(), openstudio::path(), openstudio::path(), openstudio::path()));
+
+    boost::filesystem::remove_all(outdir); // Clean up test dir before starting
+
+    openstudio::runmanager::Job j = wf.create(outdir);
+    t_rm.enqueue(j, true);
+    t_rm.waitForFinished();
+
+    return j.errors();
+  }
+
+}
+
+TEST_F(RunManagerTestFixture, RubyWorkerPool_SplitParameters)
+{
+  std::vector<std::string> params;
+  params.push_back("-I");
+  params.push_back("/a");
+  params.push_back("-I.");
+  params.push_back("in.rb");
+  params.push_back("-I");
+  params.push_back("arg");
+
+  std::vector<std::string> includeDirs;
+  std::vector<std::string> scriptAndArgs;
+  ASSERT_TRUE(openstudio::runmanager::detail::RubyWorkerPool::splitParameters(params, includeDirs, scriptAndArgs));
+
+  ASSERT_EQ(2u, includeDirs.size());
+  EXPECT_EQ("/a", includeDirs[0]);
+  EXPECT_EQ(".", includeDirs[1]);
+
+  // everything after the script belongs to the script
+  ASSERT_EQ(3u, scriptAndArgs.size());
+  EXPECT_EQ("in.rb", scriptAndArgs[0]);
+  EXPECT_EQ("-I", scriptAndArgs[1]);
+  EXPECT_EQ("arg", scriptAndArgs[2]);
+
+  // other interpreter options are left to a process of their own
+  params.insert(params.begin(), "-w");
+  EXPECT_FALSE(openstudio::runmanager::detail::RubyWorkerPool::splitParameters(params, includeDirs, scriptAndArgs));
+
+  std::vector<std::string> noScript(1, "-I");
+  EXPECT_FALSE(openstudio::runmanager::detail::RubyWorkerPool::splitParameters(noScript, includeDirs, scriptAndArgs));
+}
+
+TEST_F(RunManagerTestFixture, RubyWorkerPool_RelativeIncludeDir)
+{
+  // a relative include directory is relative to the script's working directory, not the worker's
+  openstudio::path workingDir = openstudio::tempDir() / openstudio::toPath("RubyWorkerPoolTest") / openstudio::toPath("relativeinclude");
+  boost::filesystem::remove_all(workingDir);
+  boost::filesystem::create_directories(workingDir / openstudio::toPath("lib"));
+
+  {
+    boost::filesystem::ofstream helper(workingDir / openstudio::toPath("lib") / openstudio::toPath("relative_include_helper.rb"));
+    helper << "RELATIVE_INCLUDE_VALUE = 42" << std::endl;
+    boost::filesystem::ofstream script(workingDir / openstudio::toPath("main.rb"));
+    script << "require 'relative_include_helper'" << std::endl;
+    script << "puts RELATIVE_INCLUDE_VALUE" << std::endl;
+  }
+
+  openstudio::runmanager::RubyWorkerPoolOptions options;
+  options.numWorkers = 1;
+  openstudio::runmanager::detail::RubyWorkerPool pool(options);
+
+  std::vector<std::string> params;
+  params.push_back("-Ilib");
+  params.push_back(openstudio::toString(workingDir / openstudio::toPath("main.rb")));
+
+  openstudio::path out = workingDir / openstudio::toPath("stdout");
+  openstudio::path err = workingDir / openstudio::toPath("stderr");
+  int id = pool.submit(rubyExePath(), params, workingDir, out, err);
+  pool.waitForRequest(id);
+
+  boost::filesystem::ifstream result(out);
+  std::string line;
+  std::getline(result, line);
+  EXPECT_EQ("42", line);
+}
+
+TEST_F(RunManagerTestFixture, RubyWorkerPool_OSResultLoading)
+{
+  openstudio::runmanager::RunManager rm;
+
+  openstudio::runmanager::RubyWorkerPoolOptions options;
+  options.numWorkers = 1;
+  options.maxJobsPerWorker = 2; // the third script runs in a recycled worker
+  rm.setRubyWorkerPoolOptions(options);
+  EXPECT_EQ(1u, rm.rubyWorkerPoolOptions().numWorkers);
+
+  for (int i = 0; i < 3; ++i)
+  {
+    openstudio::runmanager::JobErrors e = runScript(rm, "create_os_result.rb", "fail" + boost::lexical_cast<std::string>(i));
+
+    EXPECT_EQ(openstudio::ruleset::OSResultValue(openstudio::ruleset::OSResultValue::Fail), e.result);
+    ASSERT_EQ(2u, e.allErrors.size());
+    EXPECT_EQ(openstudio::runmanager::ErrorType(openstudio::runmanager::ErrorType::Error), e.allErrors[0].first);
+    EXPECT_EQ("Error1", e.allErrors[0].second);
+    EXPECT_EQ(openstudio::runmanager::ErrorType(openstudio::runmanager::ErrorType::Warning), e.allErrors[1].first);
+    EXPECT_EQ("Warning1", e.allErrors[1].second);
+
+    e = runScript(rm, "create_os_result_success.rb", "success" + boost::lexical_cast<std::string>(i));
+    EXPECT_EQ(openstudio::ruleset::OSResultValue(openstudio::ruleset::OSResultValue::Success), e.result);
+    EXPECT_EQ(0u, e.allErrors.size());
+  }
+}
@@ -74,6 +74,11 @@ namespace detail {
     m_osresult = r;
   }
 
+  void ToolBasedJob::ErrorInfo::earlyTermination(const std::string &t_reason)
+  {
+    m_early_termination = t_reason;
+  }
+
   void ToolBasedJob::ErrorInfo::addLogMessages(openstudio::runmanager::ErrorType t_type, 
       const std::vector<openstudio::LogMessage> &t_msgs, std::vector<std::pair<ErrorType, std::string> > &t_errors)
   {
@@ -163,6 +168,12 @@ namespace detail {
       }
     }
 
+    if (m_early_termination)
+    {
+      result = ruleset::OSResultValue::Fail;
+      errors.push_back(std::make_pair(ErrorType::Error, "Process stopped early. " + *m_early_termination));
+    }
+
     if (m_osresult)
     {
       if (result != ruleset::OSResultValue::Fail)
@@ -547,6 +558,8 @@ namespace detail {
 
     openstudio::path outpath = outdir();
 
+    boost::optional<EarlyTerminationPolicy> policy = energyPlusMonitorPolicy(t_toolName);
+
     QWriteLocker l(&m_mutex);
     boost::shared_ptr<Process> process = m_process_creator->createProcess(ti,
         acquireRequiredFiles(complete_required_files()), m_parameters[t_toolName],
@@ -562,6 +575,13 @@ namespace detail {
     m_currentprocess = process;
     m_processes[ti] = process;
 
+    if (policy)
+    {
+      m_monitor = boost::shared_ptr<EnergyPlusMonitor>(new EnergyPlusMonitor(outpath / toPath("eplusout.err"), *policy));
+    } else {
+      m_monitor.reset();
+    }
+
     connect(process.get(), SIGNAL(started()), 
         this, SLOT(processStarted()));
     connect(process.get(), SIGNAL(outputFileChanged(const openstudio::runmanager::FileInfo &)), 
@@ -639,6 +659,7 @@ namespace detail {
     m_currentprocess.reset();
     m_process_creator.reset();
     m_processes.clear();
+    m_monitor.reset();
 
     /*
     if (!runnable())
@@ -910,6 +931,13 @@ namespace detail {
 
   void ToolBasedJob::processFinished(int t_exitCode, QProcess::ExitStatus t_exitStatus)
   {
+    Process *process = qobject_cast<Process *>(sender());
+    boost::optional<double> peakMemoryMB = process ? process->peakMemoryMB() : boost::optional<double>();
+    if (peakMemoryMB)
+    {
+      notePeakMemoryMB(*peakMemoryMB);
+    }
+
     Files outfiles = outputFiles();
     openstudio::path outpath = outdir();
 
@@ -922,7 +950,16 @@ namespace detail {
     m_error_info.exitStatus(t_exitStatus);
     // If an eplusout.err file was created, let's parse it
     openstudio::path errpath = outpath / toPath("eplusout.err");
-    if (boost::filesystem::exists(errpath))
+    if (m_monitor)
+    {
+      // read what is left of the error file the monitor has been following
+      m_monitor->update();
+    }
+
+    if (m_monitor && m_monitor->errorFile().completed())
+    {
+      m_error_info.errorFile(m_monitor->errorFile());
+    } else if (boost::filesystem::exists(errpath))
     {
       LOG(Debug, "Setting error file: " << openstudio::toString(errpath));
       m_error_info.errorFile(openstudio::energyplus::ErrorFile(errpath));
@@ -998,11 +1035,39 @@ namespace detail {
     std::ofstream ofs(toString(outdir() / toPath("stdout")).c_str(), std::ios_base::out | std::ios_base::app);
     ofs << data;
 
+    boost::optional<AdvancedStatus> status;
+    boost::shared_ptr<Process> stopProcess;
+
     QWriteLocker l(&m_mutex);
     m_output += data;
+
+    if (m_monitor)
+    {
+      status = m_monitor->standardOutDataAdded(data);
+
+      // EnergyPlus writes to standard output at least once per warm up day and simulated month,
+      // which is often enough to catch up on the error file
+      boost::optional<std::string> stopReason = m_monitor->update();
+      if (stopReason)
+      {
+        LOG(Warn, "ToolBasedJob stopping process early: " << toString(uuid()) << " " << *stopReason);
+        m_error_info.earlyTermination(*stopReason);
+        stopProcess = m_currentprocess;
+      }
+    }
     l.unlock();
 
     emitOutputDataAdded(data);
+
+    if (status)
+    {
+      emitStatusChanged(*status);
+    }
+
+    if (stopProcess)
+    {
+      stopProcess->stop();
+    }
   }
 
   void ToolBasedJob::processStatusChanged(const AdvancedStatus &t_stat)
@@ -26,6 +26,7 @@
 #include <utilities/core/Logger.hpp>
 #include "Job_Impl.hpp"
 #include "ToolInfo.hpp"
+#include "EnergyPlusMonitor.hpp"
 #include <boost/optional.hpp>
 
 #include <QProcess>
@@ -117,11 +118,42 @@ namespace detail {
         }
       }
 
+      /// \returns true if all of the required tools can be found and the workers offer them,
+      ///          workers locate tools by name
+      virtual bool workerRunnable(const std::set<std::string> &t_workerTools) const
+      {
+        if (!runnable())
+        {
+          return false;
+        } else {
+          try {
+            for (size_t i = 0; i < m_toolNames.size(); ++i)
+            {
+              if (!t_workerTools.count(getTool(m_toolNames[i]).name))
+              {
+                return false;
+              }
+            }
+            return workerParametersPortable();
+          } catch (const std::exception &) {
+            // we couldn't find the required tool
+            return false;
+          }
+        }
+      }
+
       /// Requests that the tool stop execution
       virtual void requestStop();
 
     protected:
 
+      /// \returns false if the job passes its tools absolute paths outside of the output directory,
+      ///          a RemoteWorker without a shared file system could not resolve them
+      virtual bool workerParametersPortable() const
+      {
+        return true;
+      }
+
       bool stopRequested() const;
 
       /// Ensures run thread has completed before returning
@@ -176,6 +208,14 @@ namespace detail {
       /// Returns outputFiles provided explicitly by the subclass
       virtual Files outputFilesHandlerImpl() const { return Files(); }
 
+      /// Returns the policy to follow the named tool with if it runs an EnergyPlus simulation.
+      /// The error file and standard output of the tool are then followed while it runs, progress
+      /// is reported through statusChanged and the tool is stopped early if the policy says so.
+      virtual boost::optional<EarlyTerminationPolicy> energyPlusMonitorPolicy(const std::string &/*t_toolName*/) const
+      {
+        return boost::none;
+      }
+
       virtual void standardCleanImpl();
 
      private:
@@ -192,6 +232,7 @@ namespace detail {
           void processError(QProcess::ProcessError, const std::string &t_description);
           void errorFile(const openstudio::energyplus::ErrorFile &);
           void osResult(const openstudio::ruleset::OSResult &);
+          void earlyTermination(const std::string &t_reason);
 
           /// Return a JobErrors object that represents all currently collected error information
           JobErrors errors();
@@ -211,6 +252,7 @@ namespace detail {
           boost::optional<openstudio::ruleset::OSResult> m_osresult;
           boost::optional<QProcess::ExitStatus> m_exit_status;
           boost::optional<std::pair<QProcess::ProcessError, std::string> > m_process_error;
+          boost::optional<std::string> m_early_termination;
       };
 
       /// Called internally when the job is in a runnable state and we are ready to get
@@ -279,6 +321,9 @@ namespace detail {
 
       std::set<std::pair<openstudio::path, openstudio::path> > m_addedRequiredFiles;
 
+      /// Follows the currently running tool if it is an EnergyPlus simulation
+      boost::shared_ptr<EnergyPlusMonitor> m_monitor;
+
       /// Current collected error information for the running job
       ErrorInfo m_error_info;
 
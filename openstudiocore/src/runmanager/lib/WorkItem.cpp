@@ -114,6 +114,7 @@ namespace runmanager {
       // job types that I am unsure about
       case JobType::CalculateEconomics :
       case JobType::ReadVars :
+      case JobType::ReadEso :
       case JobType::PreviewIES :
         break;
       default:
@@ -174,6 +175,7 @@ namespace runmanager {
       // job types that I am unsure about
       case JobType::CalculateEconomics :
       case JobType::ReadVars :
+      case JobType::ReadEso :
       case JobType::PreviewIES :
         break;
       default:
@@ -45,6 +45,18 @@ namespace openstudio {
  *   //Do some other work
  * }
  * \endcode
+ *
+ * Jobs may also be handed to RunManagerWorker daemons on other machines, or on this one, with
+ * \c setRemoteWorkers(). Each worker listens on a TCP port or a local socket and runs as many jobs at
+ * once as it has slots. A worker only runs the tools it was started with, and only for a RunManager
+ * that knows its secret. Connections to workers are made from the thread that created the RunManager,
+ * which needs a running event loop.
+ *
+ * \code
+ * std::vector<openstudio::runmanager::RemoteWorkerEndpoint> workers;
+ * workers.push_back(openstudio::runmanager::RemoteWorkerEndpoint("buildhost", 4400, secret)); // RunManagerWorker --listen 0.0.0.0:4400 --secret-file ...
+ * rm.setRemoteWorkers(workers);
+ * \endcode
  *  
  * <hr>
  * \section RunManagerWorkflow Creating Jobs with Workflow Object
@@ -192,6 +204,11 @@ namespace openstudio {
  /// The Job also opens the IDF to determine the version of EnergyPlus required to run the simulation.
  /// If the appropriate version has not been provided in the list of Tools, the job execution fails.
  ///
+ /// While EnergyPlus runs, the job follows eplusout.err and standard output, reporting the environment
+ /// and day being simulated through statusChanged. The stopOnFatal, stopOnSevere, maxWarnings and 
+ /// stopPattern params stop the simulation as soon as the error file shows it is not worth finishing,
+ /// see openstudio::runmanager::EarlyTerminationPolicy.
+ ///
  /// If a "filename" param is passed to the Job, the value of the param is used to determine which 
  /// file to pass to the simulation.
  ///
@@ -293,9 +310,21 @@ namespace openstudio {
  ///
  /// \sa openstudio::runmanager::JobFactory::createReadVarsJob
  ///
+ /// \section ReadEsoJobType ReadEso Job
+ /// Reads the most recent ESO (or MTR) file in process with openstudio::energyplus::EsoFile and
+ /// writes the values to a binary column file that EsoFile::loadColumns can read. Variables may
+ /// be limited with "variable" params; ReadVarsESO is not run.
+ ///
+ /// \sa openstudio::runmanager::JobFactory::createReadEsoJob
+ ///
  /// \section RubyJobType Ruby Job
  /// Executes ruby, passing in the most recently provided rb file.
  ///
+ /// When the RunManager's ruby worker pool is enabled, scripts that need nothing but include directories
+ /// from the interpreter are handed to a long lived ruby worker that has already loaded the OpenStudio
+ /// bindings, see openstudio::runmanager::RubyWorkerPoolOptions. Results are reported exactly as for
+ /// a script run by its own interpreter.
+ ///
  /// \sa openstudio::runmanager::RubyJobBuilder
  /// \sa openstudio::runmanager::JobFactory::createRubyJob
  ///
@@ -0,0 +1,163 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <runmanager/lib/RemoteWorker.hpp>
+
+#include <utilities/core/Application.hpp>
+#include <utilities/core/String.hpp>
+
+#include <QCoreApplication>
+#include <QHostAddress>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/program_options.hpp>
+
+#include <iostream>
+#include <map>
+#include <vector>
+
+int main(int argc, char *argv[])
+{
+  using namespace openstudio;
+  namespace po = boost::program_options;
+
+  po::options_description desc("Runs the jobs handed to it by a RunManager, see RunManager::setRemoteWorkers");
+  desc.add_options()
+    ("help", "Print help message")
+    ("listen", po::value<std::string>(), "TCP port to listen on, on localhost unless an address is given, example: \"4400\" or \"0.0.0.0:4400\"")
+    ("socket", po::value<std::string>(), "Name of the local socket to listen on instead of a TCP port")
+    ("slots", po::value<int>()->default_value(1), "Number of jobs to run at once")
+    ("workdir", po::value<std::string>(), "Directory holding the file cache and the job run directories")
+    ("secret", po::value<std::string>(), "Secret a RunManager must know to use the worker")
+    ("secret-file", po::value<std::string>(), "File holding the secret, keeps it off the command line")
+    ("tool", po::value<std::vector<std::string> >(), "Executable to run for a tool, example: \"energyplus=/usr/local/EnergyPlus/energyplus\". Only these tools are run")
+    ;
+
+  po::variables_map vm;
+  try {
+    po::store(po::command_line_parser(argc, argv).options(desc).run(), vm);
+    po::notify(vm);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl << desc << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (vm.count("help") || !vm.count("workdir") || (vm.count("listen") == vm.count("socket")))
+  {
+    std::cout << desc << std::endl;
+    return vm.count("help")?EXIT_SUCCESS:EXIT_FAILURE;
+  }
+
+  std::string secret;
+  if (vm.count("secret-file"))
+  {
+    boost::filesystem::ifstream ifs(toPath(vm["secret-file"].as<std::string>()));
+    std::getline(ifs, secret);
+    if (!secret.empty() && secret[secret.size() - 1] == '\r')
+    {
+      secret.erase(secret.size() - 1);
+    }
+  } else if (vm.count("secret")) {
+    secret = vm["secret"].as<std::string>();
+  }
+
+  if (secret.empty())
+  {
+    std::cerr << "A secret is required, use --secret or --secret-file" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  int slotCount = vm["slots"].as<int>();
+  if (slotCount < 1)
+  {
+    std::cerr << "--slots must be at least 1" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::map<std::string, openstudio::path> tools;
+  if (vm.count("tool"))
+  {
+    std::vector<std::string> specs = vm["tool"].as<std::vector<std::string> >();
+    for (std::vector<std::string>::const_iterator itr = specs.begin();
+         itr != specs.end();
+         ++itr)
+    {
+      std::string::size_type eq = itr->find('=');
+      if (eq == std::string::npos || eq == 0 || eq + 1 == itr->size())
+      {
+        std::cerr << "Invalid --tool \"" << *itr << "\", expected name=path" << std::endl;
+        return EXIT_FAILURE;
+      }
+      tools[itr->substr(0, eq)] = toPath(itr->substr(eq + 1));
+    }
+  }
+
+  if (tools.empty())
+  {
+    std::cerr << "No --tool given, the worker would not be able to run any job" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  QCoreApplication app(argc, argv);
+  openstudio::Application::instance().setApplication(&app);
+
+  runmanager::RemoteWorker worker(toPath(vm["workdir"].as<std::string>()), slotCount, secret, tools);
+
+  bool listening = false;
+  if (vm.count("socket"))
+  {
+    listening = worker.listen(toQString(vm["socket"].as<std::string>()));
+  } else {
+    std::string address = vm["listen"].as<std::string>();
+    std::string::size_type colon = address.rfind(':');
+    QHostAddress host(QHostAddress::LocalHost);
+    std::string portstr = address;
+    if (colon != std::string::npos)
+    {
+      if (colon > 0)
+      {
+        host = QHostAddress(toQString(address.substr(0, colon)));
+      }
+      portstr = address.substr(colon + 1);
+    }
+
+    bool ok = false;
+    unsigned int port = toQString(portstr).toUInt(&ok);
+    if (!ok || port > 65535 || host.isNull())
+    {
+      std::cerr << "Invalid --listen \"" << address << "\", expected [host:]port" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    listening = worker.listen(host, static_cast<quint16>(port));
+  }
+
+  if (!listening)
+  {
+    std::cerr << "Unable to listen for connections" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!vm.count("socket"))
+  {
+    std::cout << "Listening on port " << worker.port() << " with " << worker.slotCount() << " slots" << std::endl;
+  }
+
+  return app.exec();
+}
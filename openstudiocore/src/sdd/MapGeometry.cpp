@@ -86,6 +86,7 @@
 #include <utilities/units/TemperatureUnit_Impl.hpp>
 #include <utilities/plot/ProgressBar.hpp>
 #include <utilities/core/Assert.hpp>
+#include <utilities/core/XMLFragmentReader.hpp>
 
 #include <QFile>
 #include <QDomDocument>
@@ -104,9 +105,7 @@ namespace sdd {
 
     QDomElement nameElement = element.firstChildElement("Name");
     QDomElement northAngleElement = element.firstChildElement("NAng");
-    QDomNodeList spaceElements = element.elementsByTagName("Spc");
     QDomNodeList thermalZoneElements = element.elementsByTagName("ThrmlZn");
-    QDomNodeList buildingStoryElements = element.elementsByTagName("Story");
 
     BOOST_ASSERT(!nameElement.isNull());
     building.setName(escapeName(nameElement.text()));
@@ -116,13 +115,6 @@ namespace sdd {
       building.setNorthAxis(northAngle);
     }
 
-    // create all spaces
-    for (int i = 0; i < spaceElements.count(); i++){
-      QDomElement spaceElement = spaceElements.at(i).toElement();
-      boost::optional<model::ModelObject> space = createSpace(spaceElement, doc, model);
-      BOOST_ASSERT(space); // what type of error handling do we want?
-    }
-
     // create all thermal zones
     for (int i = 0; i < thermalZoneElements.count(); i++){
 
@@ -140,20 +132,44 @@ namespace sdd {
     if (m_progressBar){
       m_progressBar->setWindowTitle(toString("Translating Storys"));
       m_progressBar->setMinimum(0);
-      m_progressBar->setMaximum(buildingStoryElements.count());
+      m_progressBar->setMaximum(100);
       m_progressBar->setValue(0);
     }
 
-    for (int i = 0; i < buildingStoryElements.count(); i++){
-      QDomElement buildingStoryElement = buildingStoryElements.at(i).toElement();
-      boost::optional<model::ModelObject> buildingStory = translateBuildingStory(buildingStoryElement, doc, model);
+    // building stories are not in doc, see loadModel, read them from the file one at a time. 
+    // spaces are created story by story, createSpace and translateSurface take care of spaces 
+    // referenced before their story is read
+    m_placeholderSpaceNames.clear();
+    QStringList buildingStoryNames = QStringList() << "Story";
+    XMLFragmentReader reader(m_path);
+    QDomDocument buildingStoryDoc = reader.readNextElement(buildingStoryNames);
+    while (!buildingStoryDoc.isNull()){
+      QDomNodeList spaceElements = buildingStoryDoc.documentElement().elementsByTagName("Spc");
+      for (int i = 0; i < spaceElements.count(); i++){
+        QDomElement spaceElement = spaceElements.at(i).toElement();
+        boost::optional<model::ModelObject> space = createSpace(spaceElement, buildingStoryDoc, model);
+        BOOST_ASSERT(space); // what type of error handling do we want?
+      }
+
+      boost::optional<model::ModelObject> buildingStory = translateBuildingStory(buildingStoryDoc.documentElement(), buildingStoryDoc, model);
       BOOST_ASSERT(buildingStory); // what type of error handling do we want?
 
       if (m_progressBar){
-        m_progressBar->setValue(m_progressBar->value() + 1);
+        m_progressBar->setValue(reader.percentComplete());
       }
+
+      buildingStoryDoc = reader.readNextElement(buildingStoryNames);
     }
 
+    // remove spaces referenced by an AdjacentSpcRef that no story defines
+    BOOST_FOREACH(const std::string& placeholderSpaceName, m_placeholderSpaceNames){
+      LOG(Error, "Space '" << placeholderSpaceName << "' is referenced by an AdjacentSpcRef but is not defined on any story, removing it");
+      if (boost::optional<model::Space> placeholderSpace = model.getModelObjectByName<model::Space>(placeholderSpaceName)){
+        placeholderSpace->remove();
+      }
+    }
+    m_placeholderSpaceNames.clear();
+
     // remove unused CFactor constructions
     BOOST_FOREACH(model::CFactorUndergroundWallConstruction cFactorConstruction, model.getModelObjects<model::CFactorUndergroundWallConstruction>()){
       if (cFactorConstruction.directUseCount() == 0){
@@ -206,10 +222,17 @@ namespace sdd {
   {
     QDomElement nameElement = element.firstChildElement("Name");
 
-    model::Space space(model);
-
     BOOST_ASSERT(!nameElement.isNull());
-    space.setName(escapeName(nameElement.text()));
+    std::string spaceName = escapeName(nameElement.text());
+
+    // already created as the adjacent space of a surface on an earlier story
+    if (boost::optional<model::Space> existingSpace = model.getModelObjectByName<model::Space>(spaceName)){
+      m_placeholderSpaceNames.erase(spaceName);
+      return *existingSpace;
+    }
+
+    model::Space space(model);
+    space.setName(spaceName);
 
     return space;
   }
@@ -1083,7 +1106,12 @@ namespace sdd {
     if (!adjacentSpaceElement.isNull()){
       std::string adjacentSpaceName = escapeName(adjacentSpaceElement.text());
       boost::optional<model::Space> otherSpace = space.model().getModelObjectByName<model::Space>(adjacentSpaceName);
-      BOOST_ASSERT(otherSpace); // what type of error handling do we want?
+      if (!otherSpace){
+        // on a story not read yet, translateSpace fills it in when its story is read
+        otherSpace = model::Space(space.model());
+        otherSpace->setName(adjacentSpaceName);
+        m_placeholderSpaceNames.insert(adjacentSpaceName);
+      }
 
       // clone the surface and sub surfaces with reverse vertices
       boost::optional<model::Surface> otherSurface = surface.createAdjacentSurface(*otherSpace);
@@ -69,10 +69,12 @@
 #include <utilities/time/Time.hpp>
 #include <utilities/units/UnitFactory.hpp>
 #include <utilities/units/Unit.hpp>
+#include <utilities/core/XMLFragmentReader.hpp>
 
 #include <QFile>
 #include <QDomDocument>
 #include <QDomElement>
+#include <QStringList>
 #include <QThread>
 
 namespace openstudio {
@@ -114,12 +116,11 @@ namespace sdd {
 
     if (boost::filesystem::exists(path)){
 
-      QFile file(toQString(path));
-      if (file.open(QFile::ReadOnly)){
-        QDomDocument doc;
-        doc.setContent(&file);
-        file.close();
-
+      // building stories hold the geometry, which is most of the file, they are left out here and 
+      // streamed from m_path one at a time by translateBuilding
+      XMLFragmentReader reader(path);
+      QDomDocument doc = reader.readNextElement(QStringList() << "SDDXML", QStringList(), QStringList() << "Story");
+      if (!doc.isNull()){
         result = this->convert(doc);
       }
     }
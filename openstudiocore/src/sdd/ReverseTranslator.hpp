@@ -29,6 +29,8 @@
 
 #include <model/Schedule.hpp>
 
+#include <set>
+
 class QDomDocument;
 class QDomElement;
 class QDomNodeList;
@@ -151,6 +153,9 @@ namespace sdd {
 
     openstudio::path m_path;
 
+    // spaces created for an AdjacentSpcRef before the story defining them is read
+    std::set<std::string> m_placeholderSpaceNames;
+
     ProgressBar* m_progressBar;
 
     REGISTER_LOGGER("openstudio.sdd.ReverseTranslator");
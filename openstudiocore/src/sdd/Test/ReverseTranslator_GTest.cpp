@@ -30,6 +30,8 @@
 #include <model/Facility_Impl.hpp>
 #include <model/Building.hpp>
 #include <model/Building_Impl.hpp>
+#include <model/BuildingStory.hpp>
+#include <model/BuildingStory_Impl.hpp>
 #include <model/ThermalZone.hpp>
 #include <model/ThermalZone_Impl.hpp>
 #include <model/Space.hpp>
@@ -51,9 +53,77 @@
 
 #include <resources.hxx>
 
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/foreach.hpp>
+
 #include <sstream>
 
 using namespace openstudio::model;
 using namespace openstudio;
 
 
+
+TEST_F(SDDFixture, ReverseTranslator_AdjacentSpaceOnLaterStory)
+{
+  openstudio::path p = toPath("./ReverseTranslator_AdjacentSpaceOnLaterStory.xml");
+  if (boost::filesystem::exists(p)){
+    boost::filesystem::remove(p);
+  }
+
+  {
+    std::string polyLoop = "<PolyLp>"
+      "<CartesianPt><Coord>0</Coord><Coord>0</Coord><Coord>10</Coord></CartesianPt>"
+      "<CartesianPt><Coord>0</Coord><Coord>0</Coord><Coord>0</Coord></CartesianPt>"
+      "<CartesianPt><Coord>10</Coord><Coord>0</Coord><Coord>0</Coord></CartesianPt>"
+      "<CartesianPt><Coord>10</Coord><Coord>0</Coord><Coord>10</Coord></CartesianPt>"
+      "</PolyLp>";
+
+    boost::filesystem::ofstream file(p);
+    file << "<?xml version=\"1.0\"?>\n";
+    file << "<SDDXML>\n";
+    file << "  <Proj>\n";
+    file << "    <Lat>38.58</Lat><Long>-121.49</Long><Elevation>839.9</Elevation>\n";
+    file << "    <Bldg>\n";
+    file << "      <Name>Building</Name>\n";
+    file << "      <ThrmlZn><Name>Zone</Name><Type>Unconditioned</Type></ThrmlZn>\n";
+    file << "      <Story>\n";
+    file << "        <Name>Story 1</Name>\n";
+    file << "        <Spc>\n";
+    file << "          <Name>Space 1</Name><ThrmlZnRef>Zone</ThrmlZnRef>\n";
+    file << "          <IntWall><Name>Wall 1</Name>" << polyLoop << "<AdjacentSpcRef>Space 2</AdjacentSpcRef></IntWall>\n";
+    file << "          <IntWall><Name>Wall 2</Name>" << polyLoop << "<AdjacentSpcRef>Missing Space</AdjacentSpcRef></IntWall>\n";
+    file << "        </Spc>\n";
+    file << "      </Story>\n";
+    file << "      <Story>\n";
+    file << "        <Name>Story 2</Name>\n";
+    file << "        <Spc><Name>Space 2</Name><ThrmlZnRef>Zone</ThrmlZnRef></Spc>\n";
+    file << "      </Story>\n";
+    file << "    </Bldg>\n";
+    file << "  </Proj>\n";
+    file << "</SDDXML>\n";
+  }
+
+  openstudio::sdd::ReverseTranslator reverseTranslator;
+  boost::optional<Model> model = reverseTranslator.loadModel(p);
+  ASSERT_TRUE(model);
+
+  // placeholder created for Wall 1 is filled in by the second story
+  boost::optional<Space> space2 = model->getModelObjectByName<Space>("Space 2");
+  ASSERT_TRUE(space2);
+  ASSERT_TRUE(space2->buildingStory());
+  EXPECT_EQ("Story 2", space2->buildingStory()->name().get());
+  EXPECT_EQ(1u, space2->surfaces().size());
+
+  // placeholder created for Wall 2 is never defined, it is removed with an error
+  EXPECT_FALSE(model->getModelObjectByName<Space>("Missing Space"));
+  EXPECT_EQ(2u, model->getModelObjects<Space>().size());
+
+  bool found = false;
+  BOOST_FOREACH(const LogMessage& logMessage, reverseTranslator.errors()){
+    if (logMessage.logMessage().find("Missing Space") != std::string::npos){
+      found = true;
+    }
+  }
+  EXPECT_TRUE(found);
+}
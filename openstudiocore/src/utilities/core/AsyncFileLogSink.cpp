@@ -0,0 +1,300 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+
+#include <utilities/core/AsyncFileLogSink.hpp>
+#include <utilities/core/AsyncFileLogSink_Impl.hpp>
+
+#include <utilities/core/Assert.hpp>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/bind.hpp>
+
+#include <algorithm>
+#include <streambuf>
+#include <vector>
+
+#include <QReadWriteLock>
+#include <QWriteLocker>
+#include <QAtomicInt>
+
+namespace openstudio{
+
+  namespace detail{
+
+    /// Single producer, single consumer ring buffer exposed as a streambuf. The producer is the
+    /// boost.log synchronous sink frontend, which serializes writes to the stream, and the
+    /// consumer is a background thread that writes to the file. Positions only ever increase
+    /// and are taken modulo the capacity, so head - tail is the number of unwritten bytes.
+    class LogRingBuffer : public std::streambuf
+    {
+      public:
+
+      LogRingBuffer(const openstudio::path& path, unsigned bufferSize)
+        : m_ofs(path, std::ios_base::out | std::ios_base::binary), m_head(0), m_tail(0), m_flushed(0), m_stopping(0), m_stopped(0)
+      {
+        unsigned capacity = 1024;
+        while (capacity < bufferSize){
+          capacity <<= 1;
+        }
+        m_buffer.resize(capacity);
+        m_mask = capacity - 1;
+
+        m_thread = boost::thread(boost::bind(&LogRingBuffer::run, this));
+      }
+
+      virtual ~LogRingBuffer()
+      {
+        stop();
+      }
+
+      /// block until everything written so far is in the file
+      void flush()
+      {
+        if (load(m_stopped)){
+          return;
+        }
+
+        unsigned head = load(m_head);
+        boost::unique_lock<boost::mutex> l(m_mutex);
+        while (static_cast<int>(load(m_flushed) - head) < 0){
+          m_condition.notify_one();
+          m_flushedCondition.wait(l);
+        }
+      }
+
+      /// write everything in the buffer and join the writer thread, later writes go straight to the file
+      void stop()
+      {
+        if (load(m_stopped)){
+          return;
+        }
+
+        m_stopping.fetchAndStoreOrdered(1);
+        wake();
+        m_thread.join();
+        m_stopped.fetchAndStoreOrdered(1);
+      }
+
+      protected:
+
+      virtual std::streamsize xsputn(const char* s, std::streamsize n)
+      {
+        if (load(m_stopped)){
+          m_ofs.write(s, n);
+          return n;
+        }
+
+        const unsigned capacity = m_mask + 1;
+        std::streamsize written = 0;
+        while (written < n){
+          // only this thread writes m_head
+          unsigned head = static_cast<unsigned>(static_cast<int>(m_head));
+          unsigned available = capacity - (head - load(m_tail));
+          if (available == 0){
+            // full, wait for the writer to catch up
+            boost::unique_lock<boost::mutex> l(m_mutex);
+            while (capacity - (head - load(m_tail)) == 0){
+              m_condition.notify_one();
+              m_spaceCondition.wait(l);
+            }
+            continue;
+          }
+
+          unsigned count = static_cast<unsigned>(std::min<std::streamsize>(available, n - written));
+          unsigned begin = head & m_mask;
+          unsigned first = std::min(count, capacity - begin);
+          std::copy(s + written, s + written + first, m_buffer.begin() + begin);
+          std::copy(s + written + first, s + written + count, m_buffer.begin());
+
+          m_head.fetchAndStoreRelease(static_cast<int>(head + count));
+          written += count;
+        }
+        return n;
+      }
+
+      virtual int_type overflow(int_type c)
+      {
+        if (!traits_type::eq_int_type(c, traits_type::eof())){
+          char ch = traits_type::to_char_type(c);
+          xsputn(&ch, 1);
+        }
+        return traits_type::not_eof(c);
+      }
+
+      virtual int sync()
+      {
+        if (load(m_stopped)){
+          m_ofs.flush();
+        }else{
+          wake();
+        }
+        return 0;
+      }
+
+      private:
+
+      static unsigned load(QAtomicInt& value)
+      {
+        return static_cast<unsigned>(value.fetchAndAddAcquire(0));
+      }
+
+      void wake()
+      {
+        m_condition.notify_one();
+      }
+
+      void run()
+      {
+        const unsigned capacity = m_mask + 1;
+        while (true){
+          // only this thread writes m_tail
+          unsigned tail = static_cast<unsigned>(static_cast<int>(m_tail));
+          unsigned head = load(m_head);
+
+          if (head == tail){
+            if (load(m_stopping)){
+              break;
+            }
+            boost::unique_lock<boost::mutex> l(m_mutex);
+            if (load(m_head) == tail){
+              m_condition.timed_wait(l, boost::posix_time::milliseconds(50));
+            }
+            continue;
+          }
+
+          unsigned count = head - tail;
+          unsigned begin = tail & m_mask;
+          unsigned first = std::min(count, capacity - begin);
+          m_ofs.write(&m_buffer[begin], first);
+          if (first < count){
+            m_ofs.write(&m_buffer[0], count - first);
+          }
+
+          m_ofs.flush();
+          m_tail.fetchAndStoreRelease(static_cast<int>(head));
+
+          // publish after every batch so flush() does not wait for producers to go quiet
+          {
+            boost::unique_lock<boost::mutex> l(m_mutex);
+            m_flushed.fetchAndStoreRelease(static_cast<int>(head));
+          }
+          m_flushedCondition.notify_all();
+          m_spaceCondition.notify_all();
+        }
+      }
+
+      boost::filesystem::ofstream m_ofs;
+      std::vector<char> m_buffer;
+      unsigned m_mask;
+      QAtomicInt m_head;
+      QAtomicInt m_tail;
+      QAtomicInt m_flushed;
+      QAtomicInt m_stopping;
+      QAtomicInt m_stopped;
+      boost::mutex m_mutex;
+      boost::condition_variable m_condition;        // writer waits for data
+      boost::condition_variable m_flushedCondition; // flush() waits for the writer
+      boost::condition_variable m_spaceCondition;   // producers wait for room in a full buffer
+      boost::thread m_thread;
+    };
+
+    // the stream is shared with the boost.log backend, keep the buffer alive as long as it is
+    struct LogRingBufferStreamDeleter
+    {
+      LogRingBufferStreamDeleter(const boost::shared_ptr<LogRingBuffer>& t_buffer)
+        : buffer(t_buffer)
+      {}
+
+      void operator()(std::ostream* os) const
+      {
+        delete os;
+      }
+
+      boost::shared_ptr<LogRingBuffer> buffer;
+    };
+
+    AsyncFileLogSink_Impl::AsyncFileLogSink_Impl(const openstudio::path& path, unsigned bufferSize)
+      : m_path(path), m_buffer(new LogRingBuffer(path, bufferSize))
+    {
+      boost::shared_ptr<std::ostream> os(new std::ostream(m_buffer.get()), LogRingBufferStreamDeleter(m_buffer));
+      this->setStream(os);
+      this->enable();
+    }
+
+    AsyncFileLogSink_Impl::~AsyncFileLogSink_Impl()
+    {
+      this->disable();
+
+      m_buffer->stop();
+    }
+
+    openstudio::path AsyncFileLogSink_Impl::path() const
+    {
+      QReadLocker l(m_mutex);
+
+      return m_path;
+    }
+
+    void AsyncFileLogSink_Impl::flush()
+    {
+      m_buffer->flush();
+    }
+
+    std::vector<LogMessage> AsyncFileLogSink_Impl::logMessages() const
+    {
+      m_buffer->flush();
+
+      boost::filesystem::ifstream ifs(m_path);
+      std::string line;
+      std::string text;
+      while(std::getline(ifs, line)){
+        text += line + "\n";
+      }
+      return LogMessage::parseLogText(text);
+    }
+
+  } // detail
+
+  AsyncFileLogSink::AsyncFileLogSink(const openstudio::path& path, unsigned bufferSize)
+    : LogSink(boost::shared_ptr<detail::AsyncFileLogSink_Impl>(new detail::AsyncFileLogSink_Impl(path, bufferSize)))
+  {
+    BOOST_ASSERT(getImpl<detail::AsyncFileLogSink_Impl>());
+  }
+
+  openstudio::path AsyncFileLogSink::path() const
+  {
+    return this->getImpl<detail::AsyncFileLogSink_Impl>()->path();
+  }
+
+  void AsyncFileLogSink::flush()
+  {
+    this->getImpl<detail::AsyncFileLogSink_Impl>()->flush();
+  }
+
+  std::vector<LogMessage> AsyncFileLogSink::logMessages() const
+  {
+    return this->getImpl<detail::AsyncFileLogSink_Impl>()->logMessages();
+  }
+
+} // openstudio
@@ -0,0 +1,55 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+
+#ifndef UTILITIES_CORE_ASYNCFILELOGSINK_HPP
+#define UTILITIES_CORE_ASYNCFILELOGSINK_HPP
+
+#include <utilities/UtilitiesAPI.hpp>
+
+#include <utilities/core/LogSink.hpp>
+#include <utilities/core/Path.hpp>
+
+namespace openstudio{
+
+  /// AsyncFileLogSink writes log messages to a file from a background thread. Messages are
+  /// copied into a lock-free ring buffer by the logging thread, so logging does not wait on
+  /// file io unless the buffer is full.
+  class UTILITIES_API AsyncFileLogSink : public LogSink
+  {
+    public:
+
+    /// constructor takes path of file, opens in write mode positioned at file beginning
+    /// and registers in the global logger, bufferSize is rounded up to a power of two
+    AsyncFileLogSink(const openstudio::path& path, unsigned bufferSize = 65536);
+
+    /// returns the path that log messages are written to
+    openstudio::path path() const;
+
+    /// block until all messages logged so far have been written to the file
+    void flush();
+
+    /// get messages out of the file content, flushes first
+    std::vector<LogMessage> logMessages() const;
+
+  };
+
+} // openstudio
+
+#endif // UTILITIES_CORE_ASYNCFILELOGSINK_HPP
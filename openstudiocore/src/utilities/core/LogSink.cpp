@@ -63,6 +63,8 @@ namespace openstudio{
     void LogSink_Impl::enable()
     {
       Logger::instance().addSink(m_sink);
+
+      this->updateLoggerFilter();
     }
 
     void LogSink_Impl::disable()
@@ -196,6 +198,13 @@ namespace openstudio{
       return m_sink;
     }
 
+    void LogSink_Impl::updateLoggerFilter() const
+    {
+      QReadLocker l(m_mutex);
+
+      Logger::instance().setSinkFilter(m_sink, m_logLevel, m_channelRegex);
+    }
+
     void LogSink_Impl::updateFilter(const QWriteLocker& l)
     {
       m_sink->reset_filter();
@@ -253,11 +262,13 @@ namespace openstudio{
   void LogSink::setLogLevel(LogLevel logLevel)
   {
     m_impl->setLogLevel(logLevel);
+    m_impl->updateLoggerFilter();
   }
 
   void LogSink::resetLogLevel()
   {
     m_impl->resetLogLevel();
+    m_impl->updateLoggerFilter();
   }
 
   boost::optional<boost::regex> LogSink::channelRegex() const
@@ -268,11 +279,13 @@ namespace openstudio{
   void LogSink::setChannelRegex(const boost::regex& channelRegex)
   {
     m_impl->setChannelRegex(channelRegex);
+    m_impl->updateLoggerFilter();
   }
 
   void LogSink::resetChannelRegex()
   {
     m_impl->resetChannelRegex();
+    m_impl->updateLoggerFilter();
   }
 
   bool LogSink::autoFlush() const
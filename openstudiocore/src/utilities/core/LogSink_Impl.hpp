@@ -99,6 +99,9 @@ namespace openstudio{
       // for adding cout and cerr sinks to logger
       boost::shared_ptr<LogSinkBackend> sink() const;
 
+      // pass the level and channel filter to the logger so it can skip formatting messages
+      void updateLoggerFilter() const;
+
       mutable QReadWriteLock* m_mutex;
 
     private:
@@ -18,6 +18,7 @@
 **********************************************************************/
 
 #include <utilities/core/Logger.hpp>
+#include <utilities/core/LogSink_Impl.hpp>
 
 #include <boost/log/common.hpp>
 #include <boost/log/core/record.hpp>
@@ -40,12 +41,14 @@
 
 #include <boost/foreach.hpp>
 
+#include <algorithm>
 #include <sstream>
 #include <stdio.h>
 #include <stdlib.h>
 
 #include <QReadWriteLock>
 #include <QWriteLocker>
+#include <QAtomicInt>
 #include <QApplication>
 #include <QThread>
 
@@ -85,9 +88,49 @@ namespace openstudio{
   /// convienience function for SWIG, prefer macros in C++
   void logFree(LogLevel level, const std::string& channel, const std::string& message)
   {
-    BOOST_LOG_SEV(openstudio::Logger::instance().loggerFromChannel(channel), level) << message;
+    openstudio::Logger::instance().logMessage(level, channel, message);
   }
 
+  bool logLevelEnabled(LogLevel level)
+  {
+    return openstudio::Logger::instance().isEnabled(level);
+  }
+
+  bool logEnabled(LogLevel level, const std::string& channel)
+  {
+    return openstudio::Logger::instance().isEnabled(level, channel);
+  }
+
+  // level above Fatal, nothing is logged at or above it
+  static const int noLogLevel = Fatal + 1;
+
+  // number of distinct LogLevels
+  static const int numLogLevels = Fatal - Trace + 1;
+
+  struct LoggerSingleton::ChannelState
+  {
+    ChannelState(const LogChannel& t_logChannel)
+      : logChannel(t_logChannel),
+        logger(keywords::channel = t_logChannel),
+        filterGeneration(-1),
+        logLevel(Trace)
+    {}
+
+    LogChannel logChannel;
+    LoggerType logger;
+
+    // lowest level any sink accepts on this channel, valid if filterGeneration is current
+    int filterGeneration;
+    int logLevel;
+
+    // number of messages passed to the sinks, by level
+    QAtomicInt counts[numLogLevels];
+  };
+
+  LoggerSingleton::SinkFilter::SinkFilter()
+    : logLevel(Trace)
+  {}
+
   // Custom class to extract QThread::currentThread
   class QThreadAttribute : public boost::log::attribute
   {
@@ -103,7 +146,7 @@ namespace openstudio{
   };
 
   LoggerSingleton::LoggerSingleton()
-    : m_mutex(new QReadWriteLock())
+    : m_mutex(new QReadWriteLock()), m_minLogLevel(new QAtomicInt(noLogLevel)), m_filterGeneration(0)
   {
     // Make QThread attribute available to logging
     boost::log::core::get()->add_global_attribute("QThread", boost::make_shared< QThreadAttribute >());
@@ -111,13 +154,15 @@ namespace openstudio{
     // We have to provide an empty deleter to avoid destroying the global stream
     boost::shared_ptr<std::ostream> stdOut(&std::cout, boost::log::empty_deleter());
     m_standardOutLogger.setStream(stdOut);
-    m_standardOutLogger.setLogLevel(Warn);
+    // set on the impl, the LogSink wrapper would call back into this singleton
+    m_standardOutLogger.getImpl<detail::LogSink_Impl>()->setLogLevel(Warn);
     this->addSink(m_standardOutLogger.sink());
+    this->setSinkFilter(m_standardOutLogger.sink(), Warn, boost::none);
 
     // We have to provide an empty deleter to avoid destroying the global stream
     boost::shared_ptr<std::ostream> stdErr(&std::cerr, boost::log::empty_deleter());
     m_standardErrLogger.setStream(stdErr);
-    m_standardErrLogger.setLogLevel(Warn);
+    m_standardErrLogger.getImpl<detail::LogSink_Impl>()->setLogLevel(Warn);
     //this->addSink(m_standardErrLogger.sink());
 
     // register Qt message handler
@@ -130,6 +175,7 @@ namespace openstudio{
     qInstallMsgHandler(consoleLogQtMessage);
 
     delete m_mutex;
+    delete m_minLogLevel;
   }
 
   LogSink LoggerSingleton::standardOutLogger() const
@@ -147,30 +193,144 @@ namespace openstudio{
   }
 
   LoggerType& LoggerSingleton::loggerFromChannel(const LogChannel& logChannel)
+  {
+    return channelState(logChannel)->logger;
+  }
+
+  void LoggerSingleton::logMessage(LogLevel logLevel, const LogChannel& logChannel, const std::string& message)
+  {
+    boost::shared_ptr<ChannelState> state = channelState(logChannel);
+
+    int index = static_cast<int>(logLevel) - Trace;
+    if ((index >= 0) && (index < numLogLevels)){
+      state->counts[index].ref();
+    }
+
+    BOOST_LOG_SEV(state->logger, logLevel) << message;
+  }
+
+  bool LoggerSingleton::isEnabled(LogLevel logLevel) const
+  {
+    return (static_cast<int>(logLevel) >= static_cast<int>(*m_minLogLevel));
+  }
+
+  bool LoggerSingleton::isEnabled(LogLevel logLevel, const LogChannel& logChannel)
+  {
+    if (!isEnabled(logLevel)){
+      return false;
+    }
+
+    {
+      QReadLocker l(m_mutex);
+
+      LoggerMapType::const_iterator it = m_loggerMap.find(logChannel);
+      if ((it != m_loggerMap.end()) && (it->second->filterGeneration == m_filterGeneration)){
+        return (static_cast<int>(logLevel) >= it->second->logLevel);
+      }
+    }
+
+    boost::shared_ptr<ChannelState> state = channelState(logChannel);
+
+    QWriteLocker l(m_mutex);
+
+    return (static_cast<int>(logLevel) >= channelLogLevel(*state));
+  }
+
+  std::vector<LogChannel> LoggerSingleton::logChannels() const
+  {
+    QReadLocker l(m_mutex);
+
+    std::vector<LogChannel> result;
+    BOOST_FOREACH(const LoggerMapType::value_type& channel, m_loggerMap){
+      result.push_back(channel.second->logChannel);
+    }
+    return result;
+  }
+
+  unsigned LoggerSingleton::logMessageCount(const LogChannel& logChannel, LogLevel logLevel) const
+  {
+    QReadLocker l(m_mutex);
+
+    int index = static_cast<int>(logLevel) - Trace;
+    LoggerMapType::const_iterator it = m_loggerMap.find(logChannel);
+    if ((it == m_loggerMap.end()) || (index < 0) || (index >= numLogLevels)){
+      return 0;
+    }
+    return static_cast<unsigned>(static_cast<int>(it->second->counts[index]));
+  }
+
+  unsigned LoggerSingleton::logMessageCount(const LogChannel& logChannel) const
+  {
+    QReadLocker l(m_mutex);
+
+    unsigned result = 0;
+    LoggerMapType::const_iterator it = m_loggerMap.find(logChannel);
+    if (it != m_loggerMap.end()){
+      for (int i = 0; i < numLogLevels; ++i){
+        result += static_cast<unsigned>(static_cast<int>(it->second->counts[i]));
+      }
+    }
+    return result;
+  }
+
+  void LoggerSingleton::resetLogMessageCounts()
+  {
+    QWriteLocker l(m_mutex);
+
+    BOOST_FOREACH(const LoggerMapType::value_type& channel, m_loggerMap){
+      for (int i = 0; i < numLogLevels; ++i){
+        channel.second->counts[i].fetchAndStoreOrdered(0);
+      }
+    }
+  }
+
+  boost::shared_ptr<LoggerSingleton::ChannelState> LoggerSingleton::channelState(const LogChannel& logChannel)
   {
     QReadLocker l(m_mutex);
 
     LoggerMapType::iterator it = m_loggerMap.find(logChannel);
     if (it == m_loggerMap.end()){
-      //LoggerType newLogger(keywords::channel = logChannel, keywords::severity = Debug);
-      LoggerType newLogger(keywords::channel = logChannel);
-
-      std::pair<LogChannel, LoggerType> newPair(logChannel,newLogger);
+      boost::shared_ptr<ChannelState> newState(new ChannelState(logChannel));
 
       // Drop the read lock and grab a write lock - we need to add the new file to the map
       // this will reduce contention when multiple threads trying to log at once.
       l.unlock();
       QWriteLocker l2(m_mutex);
 
-      std::pair<LoggerMapType::iterator, bool> inserted = m_loggerMap.insert(newPair);
+      std::pair<LoggerMapType::iterator, bool> inserted = m_loggerMap.insert(std::make_pair(logChannel, newState));
 
       return inserted.first->second;
-
     }
 
     return it->second;
   }
 
+  int LoggerSingleton::channelLogLevel(ChannelState& state) const
+  {
+    if (state.filterGeneration != m_filterGeneration){
+      int logLevel = noLogLevel;
+      BOOST_FOREACH(const SinkSetType::value_type& sink, m_sinks){
+        if (sink.second.channelRegex && !boost::regex_match(state.logChannel, *sink.second.channelRegex)){
+          continue;
+        }
+        logLevel = std::min(logLevel, static_cast<int>(sink.second.logLevel));
+      }
+      state.logLevel = logLevel;
+      state.filterGeneration = m_filterGeneration;
+    }
+    return state.logLevel;
+  }
+
+  void LoggerSingleton::updateLogLevels()
+  {
+    int minLogLevel = noLogLevel;
+    BOOST_FOREACH(const SinkSetType::value_type& sink, m_sinks){
+      minLogLevel = std::min(minLogLevel, static_cast<int>(sink.second.logLevel));
+    }
+    m_minLogLevel->fetchAndStoreOrdered(minLogLevel);
+    ++m_filterGeneration;
+  }
+
   bool LoggerSingleton::findSink(boost::shared_ptr<LogSinkBackend> sink)
   {
     QWriteLocker l(m_mutex);
@@ -192,7 +352,8 @@ namespace openstudio{
       l.unlock();
       QWriteLocker l2(m_mutex);
 
-      m_sinks.insert(sink);
+      m_sinks.insert(std::make_pair(sink, SinkFilter()));
+      updateLogLevels();
 
       // Register the sink in the logging core
       boost::log::core::get()->add_sink(sink);
@@ -212,10 +373,25 @@ namespace openstudio{
       QWriteLocker l2(m_mutex);
 
       m_sinks.erase(it);
+      updateLogLevels();
 
       // Register the sink in the logging core
       boost::log::core::get()->remove_sink(sink);
     }
   }
 
+  void LoggerSingleton::setSinkFilter(boost::shared_ptr<LogSinkBackend> sink,
+                                      const boost::optional<LogLevel>& logLevel,
+                                      const boost::optional<boost::regex>& channelRegex)
+  {
+    QWriteLocker l(m_mutex);
+
+    SinkSetType::iterator it = m_sinks.find(sink);
+    if (it != m_sinks.end()){
+      it->second.logLevel = logLevel ? *logLevel : Trace;
+      it->second.channelRegex = channelRegex;
+      updateLogLevels();
+    }
+  }
+
 } // openstudio
@@ -28,13 +28,16 @@
 #include <utilities/core/LogSink.hpp>
 
 #include <boost/shared_ptr.hpp>
+#include <boost/optional.hpp>
 
 #include <sstream>
 #include <set>
 #include <map>
+#include <vector>
 
 class QReadWriteLock;
 class QWriteLocker;
+class QAtomicInt;
 
 /// defines method logChannel() to get a logger for a class
 #define REGISTER_LOGGER(__logChannel__) \
@@ -48,12 +51,15 @@ class QWriteLocker;
 #define LOG_AND_THROW(__message__) \
   LOG_FREE_AND_THROW(logChannel(), __message__);
 
-/// log a message from outside a registered class
+/// log a message from outside a registered class, the message is only formatted if some
+/// enabled sink will accept it
 #define LOG_FREE(__level__, __channel__, __message__) \
   { \
-    std::stringstream _ss1; \
-    _ss1 << __message__; \
-    openstudio::logFree(__level__, __channel__, _ss1.str()); \
+    if (openstudio::logLevelEnabled(__level__) && openstudio::logEnabled(__level__, __channel__)) { \
+      std::stringstream _ss1; \
+      _ss1 << __message__; \
+      openstudio::logFree(__level__, __channel__, _ss1.str()); \
+    } \
   }
 
 /// log a message from outside a registered class and throw an exception
@@ -70,6 +76,12 @@ namespace openstudio{
   /// convienience function for SWIG, prefer macros in C++
   UTILITIES_API void logFree(LogLevel level, const std::string& channel, const std::string& message);
 
+  /// returns false if no enabled sink accepts messages at level, does not lock
+  UTILITIES_API bool logLevelEnabled(LogLevel level);
+
+  /// returns false if no enabled sink accepts messages at level on channel
+  UTILITIES_API bool logEnabled(LogLevel level, const std::string& channel);
+
   /** Singleton logger class.  Singleton Logger object maintains logging state throughout
    *   program execution.
    */
@@ -93,6 +105,28 @@ namespace openstudio{
     /// exist a new logger will be set up at the default level
     LoggerType& loggerFromChannel(const LogChannel& logChannel);
 
+    /// counts a message and passes it to the sinks, prefer the LOG macros
+    void logMessage(LogLevel logLevel, const LogChannel& logChannel, const std::string& message);
+
+    /// returns false if no enabled sink accepts messages at logLevel, does not lock
+    bool isEnabled(LogLevel logLevel) const;
+
+    /// returns false if no enabled sink accepts messages at logLevel on logChannel, the
+    /// answer is cached per channel until a sink is added, removed or refiltered
+    bool isEnabled(LogLevel logLevel, const LogChannel& logChannel);
+
+    /// get all channels that have been logged to or checked
+    std::vector<LogChannel> logChannels() const;
+
+    /// get the number of messages at logLevel passed to the sinks on logChannel
+    unsigned logMessageCount(const LogChannel& logChannel, LogLevel logLevel) const;
+
+    /// get the number of messages at all levels passed to the sinks on logChannel
+    unsigned logMessageCount(const LogChannel& logChannel) const;
+
+    /// reset all message counts to zero
+    void resetLogMessageCounts();
+
     protected:
 
     friend class detail::LogSink_Impl;
@@ -106,25 +140,54 @@ namespace openstudio{
     /// removes a sink to the logging core, equivalent to logSink.disable()
     void removeSink(boost::shared_ptr<LogSinkBackend> sink);
 
+    /// records the level and channel filter of a sink so that messages no sink accepts can be
+    /// discarded before they are formatted, does nothing if the sink is not in the logging core
+    void setSinkFilter(boost::shared_ptr<LogSinkBackend> sink,
+                       const boost::optional<LogLevel>& logLevel,
+                       const boost::optional<boost::regex>& channelRegex);
+
     private:
 
+    struct ChannelState;
+
+    struct SinkFilter {
+      SinkFilter();
+      LogLevel logLevel;
+      boost::optional<boost::regex> channelRegex;
+    };
+
     /// private constructor
     LoggerSingleton();
 
+    /// get the state for a channel, creating it if needed
+    boost::shared_ptr<ChannelState> channelState(const LogChannel& logChannel);
+
+    /// lowest level accepted on channel, requires m_mutex to be held
+    int channelLogLevel(ChannelState& state) const;
+
+    /// recompute m_minLogLevel and invalidate cached channel levels, requires write lock
+    void updateLogLevels();
+
     mutable QReadWriteLock* m_mutex;
 
+    /// lowest level accepted by any enabled sink, read without locking
+    QAtomicInt* m_minLogLevel;
+
+    /// incremented whenever sinks or their filters change
+    int m_filterGeneration;
+
     /// standard out logger
     LogSink m_standardOutLogger;
 
     /// standard err logger
     LogSink m_standardErrLogger;
 
-    /// map of std::string to logger
-    typedef std::map<std::string, LoggerType, openstudio::IstringCompare> LoggerMapType;
+    /// map of std::string to logger, cached level and counts
+    typedef std::map<std::string, boost::shared_ptr<ChannelState>, openstudio::IstringCompare> LoggerMapType;
     LoggerMapType m_loggerMap;
 
     /// current sinks, kept here so don't destruct when LogSink wrapper goes out of scope
-    typedef std::set<boost::shared_ptr<LogSinkBackend> > SinkSetType;
+    typedef std::map<boost::shared_ptr<LogSinkBackend>, SinkFilter> SinkSetType;
     SinkSetType m_sinks;
   };
 
@@ -6,6 +6,7 @@
   #include <utilities/core/LogSink.hpp>
   #include <utilities/core/FileLogSink.hpp>
   #include <utilities/core/StringStreamLogSink.hpp>
+  #include <utilities/core/AsyncFileLogSink.hpp>
   #include <utilities/core/Logger.hpp>
 %}
 
@@ -15,6 +16,7 @@
 %ignore std::vector<openstudio::LogMessage>::vector(size_type);
 %ignore std::vector<openstudio::LogMessage>::resize(size_type);
 %ignore openstudio::LoggerSingleton::loggerFromChannel;
+%ignore openstudio::LoggerSingleton::logMessage;
 
 %template(LogMessageVector) std::vector<openstudio::LogMessage>;
 %template(OptionalLogMessage) boost::optional<openstudio::LogMessage>;
@@ -25,6 +27,7 @@
 %include <utilities/core/LogSink.hpp>
 %include <utilities/core/FileLogSink.hpp>
 %include <utilities/core/StringStreamLogSink.hpp>
+%include <utilities/core/AsyncFileLogSink.hpp>
 %include <utilities/core/Logger.hpp>
 
 #endif //UTILITIES_CORE_LOGGER_I
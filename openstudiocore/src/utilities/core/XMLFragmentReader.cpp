@@ -0,0 +1,144 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <utilities/core/XMLFragmentReader.hpp>
+
+#include <utilities/core/String.hpp>
+
+#include <QFile>
+#include <QXmlStreamReader>
+
+namespace openstudio {
+
+XMLFragmentReader::XMLFragmentReader(const openstudio::path& path)
+  : m_file(new QFile(toQString(path)))
+{
+  if (m_file->open(QFile::ReadOnly)){
+    m_reader = boost::shared_ptr<QXmlStreamReader>(new QXmlStreamReader(m_file.get()));
+    m_reader->setNamespaceProcessing(false);
+  }else{
+    m_errorString = "Could not open '" + toString(path) + "' for reading.";
+    LOG(Error, m_errorString);
+  }
+}
+
+XMLFragmentReader::~XMLFragmentReader()
+{
+  // reader refers to the file
+  m_reader.reset();
+  m_file.reset();
+}
+
+bool XMLFragmentReader::isValid() const
+{
+  return m_reader && !m_reader->hasError();
+}
+
+std::string XMLFragmentReader::errorString() const
+{
+  return m_errorString;
+}
+
+int XMLFragmentReader::percentComplete() const
+{
+  qint64 size = m_file->size();
+  if (!m_reader || (size <= 0)){
+    return 100;
+  }
+  return int((100 * m_file->pos()) / size);
+}
+
+QDomDocument XMLFragmentReader::readNextElement(const QStringList& elementNames,
+                                                const QStringList& startElementNames,
+                                                const QStringList& excludedNames)
+{
+  if (!isValid()){
+    return QDomDocument();
+  }
+
+  while (!m_reader->atEnd()){
+    if (m_reader->readNext() != QXmlStreamReader::StartElement){
+      continue;
+    }
+
+    QString name = m_reader->qualifiedName().toString();
+    if (elementNames.contains(name)){
+      QDomDocument doc;
+      QDomElement element = createElement(doc);
+      doc.appendChild(element);
+      readChildren(doc, element, excludedNames);
+      if (m_reader->hasError()){
+        break;
+      }
+      return doc;
+    }else if (startElementNames.contains(name)){
+      QDomDocument doc;
+      doc.appendChild(createElement(doc));
+      return doc;
+    }
+  }
+
+  if (m_reader->hasError()){
+    m_errorString = toString(m_reader->errorString()) + " at line " + 
+                    toString(QString::number(m_reader->lineNumber())) + ".";
+    LOG(Error, m_errorString);
+  }
+
+  return QDomDocument();
+}
+
+QDomElement XMLFragmentReader::createElement(QDomDocument& doc) const
+{
+  QDomElement result = doc.createElement(m_reader->qualifiedName().toString());
+  Q_FOREACH(const QXmlStreamAttribute& attribute, m_reader->attributes()){
+    result.setAttribute(attribute.qualifiedName().toString(), attribute.value().toString());
+  }
+  return result;
+}
+
+void XMLFragmentReader::readChildren(QDomDocument& doc, QDomElement& element, const QStringList& excludedNames)
+{
+  while (!m_reader->atEnd()){
+    switch (m_reader->readNext()){
+      case QXmlStreamReader::StartElement :
+        if (excludedNames.contains(m_reader->qualifiedName().toString())){
+          m_reader->skipCurrentElement();
+        }else{
+          QDomElement child = createElement(doc);
+          element.appendChild(child);
+          readChildren(doc, child, excludedNames);
+        }
+        break;
+      case QXmlStreamReader::EndElement :
+        return;
+      case QXmlStreamReader::Characters :
+        if (m_reader->isCDATA()){
+          element.appendChild(doc.createCDATASection(m_reader->text().toString()));
+        }else if (!m_reader->isWhitespace()){
+          element.appendChild(doc.createTextNode(m_reader->text().toString()));
+        }
+        break;
+      default :
+        // comments, processing instructions, and DTD content are not needed by translators
+        break;
+    }
+  }
+}
+
+} // openstudio
@@ -0,0 +1,89 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef UTILITIES_CORE_XMLFRAGMENTREADER_HPP
+#define UTILITIES_CORE_XMLFRAGMENTREADER_HPP
+
+#include <utilities/UtilitiesAPI.hpp>
+
+#include <utilities/core/Path.hpp>
+#include <utilities/core/Logger.hpp>
+
+#include <boost/shared_ptr.hpp>
+
+#include <QDomDocument>
+#include <QStringList>
+
+class QFile;
+class QXmlStreamReader;
+
+namespace openstudio {
+
+/** XMLFragmentReader streams an XML file and materializes selected elements, one at a time, as 
+ *  standalone QDomDocuments. Translators written against QDomElement can use it to process 
+ *  files too large to load with QDomDocument::setContent, since only the current fragment is 
+ *  held in memory. Tag names are matched and created as qualified names without namespace 
+ *  processing, and whitespace-only text is dropped, as with QDomDocument::setContent. */
+class UTILITIES_API XMLFragmentReader {
+ public:
+
+  /** Opens path for reading. Check isValid() before use. */
+  explicit XMLFragmentReader(const openstudio::path& path);
+
+  ~XMLFragmentReader();
+
+  /** Returns true if the file was opened and no parse error has been encountered. */
+  bool isValid() const;
+
+  /** Returns a description of the last error, or the empty string. */
+  std::string errorString() const;
+
+  /** Returns the percentage of the file read so far. */
+  int percentComplete() const;
+
+  /** Reads forward to the next element named in elementNames or startElementNames and returns 
+   *  it as the document element of a new QDomDocument. Elements named in elementNames are read 
+   *  with their whole subtree, less any descendants named in excludedNames. Elements named in 
+   *  startElementNames are returned with their attributes only, and reading continues with 
+   *  their children. Returns a null document at the end of the file or on a parse error. */
+  QDomDocument readNextElement(const QStringList& elementNames,
+                               const QStringList& startElementNames = QStringList(),
+                               const QStringList& excludedNames = QStringList());
+
+ private:
+  REGISTER_LOGGER("openstudio.XMLFragmentReader");
+
+  // noncopyable
+  XMLFragmentReader(const XMLFragmentReader& other);
+  XMLFragmentReader& operator=(const XMLFragmentReader& other);
+
+  // creates an element for the current start element, with its attributes
+  QDomElement createElement(QDomDocument& doc) const;
+
+  // appends the children of the current start element to element, returns at its end element
+  void readChildren(QDomDocument& doc, QDomElement& element, const QStringList& excludedNames);
+
+  boost::shared_ptr<QFile> m_file;
+  boost::shared_ptr<QXmlStreamReader> m_reader;
+  std::string m_errorString;
+};
+
+} // openstudio
+
+#endif // UTILITIES_CORE_XMLFRAGMENTREADER_HPP
@@ -22,13 +22,19 @@
 #include <utilities/core/Logger.hpp>
 #include <utilities/core/FileLogSink.hpp>
 #include <utilities/core/StringStreamLogSink.hpp>
+#include <utilities/core/AsyncFileLogSink.hpp>
 
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+
+#include <algorithm>
 #include <sstream>
 
 using openstudio::toPath;
 using openstudio::Logger;
 using openstudio::FileLogSink;
 using openstudio::StringStreamLogSink;
+using openstudio::AsyncFileLogSink;
 using openstudio::LogMessage;
 
 namespace
@@ -50,6 +56,17 @@ namespace
       REGISTER_LOGGER("goodbye.channel");
   };
 
+  void logUntilInterrupted()
+  {
+    try {
+      for (int i = 0; ; ++i){
+        LOG_FREE(Info, "async.busy", "Busy Info " << i);
+        boost::this_thread::interruption_point();
+      }
+    } catch (const boost::thread_interrupted&) {
+    }
+  }
+
   void freeLogging()
   {
     // this works
@@ -73,6 +90,14 @@ namespace
     LOG_FREE(Error, "free.channel", "Free Error");
   }
 
+  int numFormatted = 0;
+
+  std::string formatted(const std::string& message)
+  {
+    ++numFormatted;
+    return message;
+  }
+
   void classLogging()
   {
     Hello h;
@@ -333,4 +358,121 @@ namespace
 
     EXPECT_NO_THROW(boost::filesystem::remove(path));
   }
+
+  TEST(LoggerTest, level_gate)
+  {
+    openstudio::Logger::instance().standardOutLogger().disable();
+
+    StringStreamLogSink sink;
+    sink.setLogLevel(Error);
+    sink.setChannelRegex(boost::regex("gate\\..*"));
+
+    EXPECT_FALSE(openstudio::logEnabled(Debug, "gate.channel"));
+    EXPECT_TRUE(openstudio::logEnabled(Error, "gate.channel"));
+    EXPECT_FALSE(openstudio::logEnabled(Error, "other.gate.channel"));
+
+    // messages nothing accepts are not formatted
+    numFormatted = 0;
+    LOG_FREE(Debug, "gate.channel", formatted("Gate Debug"));
+    LOG_FREE(Error, "other.gate.channel", formatted("Other Gate Error"));
+    EXPECT_EQ(0, numFormatted);
+    LOG_FREE(Error, "gate.channel", formatted("Gate Error"));
+    EXPECT_EQ(1, numFormatted);
+    ASSERT_EQ(1u, sink.logMessages().size());
+    EXPECT_EQ("Gate Error", sink.logMessages()[0].logMessage());
+
+    // cached levels follow changes to the sinks
+    sink.setLogLevel(Debug);
+    EXPECT_TRUE(openstudio::logEnabled(Debug, "gate.channel"));
+    sink.resetChannelRegex();
+    EXPECT_TRUE(openstudio::logEnabled(Debug, "other.gate.channel"));
+    sink.disable();
+    EXPECT_FALSE(openstudio::logEnabled(Debug, "gate.channel"));
+    sink.enable();
+    EXPECT_TRUE(openstudio::logEnabled(Debug, "gate.channel"));
+  }
+
+  TEST(LoggerTest, message_counts)
+  {
+    openstudio::Logger::instance().standardOutLogger().disable();
+
+    StringStreamLogSink sink;
+    sink.setLogLevel(Info);
+    Logger::instance().resetLogMessageCounts();
+
+    LOG_FREE(Debug, "count.channel", "Count Debug");
+    LOG_FREE(Info, "count.channel", "Count Info");
+    LOG_FREE(Error, "count.channel", "Count Error");
+    LOG_FREE(Error, "count.channel", "Count Error");
+
+    EXPECT_EQ(0u, Logger::instance().logMessageCount("count.channel", Debug));
+    EXPECT_EQ(1u, Logger::instance().logMessageCount("count.channel", Info));
+    EXPECT_EQ(2u, Logger::instance().logMessageCount("count.channel", Error));
+    EXPECT_EQ(3u, Logger::instance().logMessageCount("count.channel"));
+    EXPECT_EQ(0u, Logger::instance().logMessageCount("never.logged.channel"));
+
+    std::vector<std::string> channels = Logger::instance().logChannels();
+    EXPECT_TRUE(std::find(channels.begin(), channels.end(), "count.channel") != channels.end());
+
+    Logger::instance().resetLogMessageCounts();
+    EXPECT_EQ(0u, Logger::instance().logMessageCount("count.channel"));
+  }
+
+  TEST(LoggerTest, async_file_logger)
+  {
+    openstudio::Logger::instance().standardOutLogger().disable();
+
+    openstudio::path path = toPath("./async_file_logger.log");
+    boost::filesystem::remove(path);
+    ASSERT_FALSE(boost::filesystem::exists(path));
+
+    {
+      // small buffer so that the writer thread has to keep up
+      AsyncFileLogSink sink(path, 1024);
+      sink.setChannelRegex(boost::regex("async\\..*"));
+      ASSERT_TRUE(boost::filesystem::exists(path));
+
+      for (int i = 0; i < 1000; ++i){
+        LOG_FREE(Info, "async.channel", "Async Info " << i);
+      }
+
+      std::vector<LogMessage> logMessages = sink.logMessages();
+      ASSERT_EQ(1000u, logMessages.size());
+      EXPECT_EQ(Info, logMessages[0].logLevel());
+      EXPECT_EQ("async.channel", logMessages[0].logChannel());
+      EXPECT_EQ("Async Info 0", logMessages[0].logMessage());
+      EXPECT_EQ("Async Info 999", logMessages[999].logMessage());
+    }
+
+    EXPECT_NO_THROW(boost::filesystem::remove(path));
+  }
+
+  TEST(LoggerTest, async_file_logger_flush_while_logging)
+  {
+    openstudio::Logger::instance().standardOutLogger().disable();
+
+    openstudio::path path = toPath("./async_file_logger_busy.log");
+    boost::filesystem::remove(path);
+
+    {
+      AsyncFileLogSink sink(path, 1024);
+      sink.setChannelRegex(boost::regex("async\\.busy"));
+
+      LOG_FREE(Info, "async.busy", "First");
+
+      // flush returns even though another thread never stops logging
+      boost::thread producer(&logUntilInterrupted);
+      for (int i = 0; i < 20; ++i){
+        sink.flush();
+      }
+      producer.interrupt();
+      producer.join();
+
+      std::vector<LogMessage> logMessages = sink.logMessages();
+      ASSERT_FALSE(logMessages.empty());
+      EXPECT_EQ("First", logMessages[0].logMessage());
+    }
+
+    EXPECT_NO_THROW(boost::filesystem::remove(path));
+  }
 }
@@ -0,0 +1,102 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <utilities/core/test/CoreFixture.hpp>
+#include <utilities/core/XMLFragmentReader.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+using openstudio::XMLFragmentReader;
+using openstudio::toPath;
+
+TEST_F(CoreFixture, XMLFragmentReader_NonExistent)
+{
+  XMLFragmentReader reader(toPath("./XMLFragmentReader_NotAFile.xml"));
+  EXPECT_FALSE(reader.isValid());
+  EXPECT_FALSE(reader.errorString().empty());
+  EXPECT_TRUE(reader.readNextElement(QStringList() << "Any").isNull());
+}
+
+TEST_F(CoreFixture, XMLFragmentReader_Fragments)
+{
+  openstudio::path p = toPath("./XMLFragmentReader.xml");
+  if (boost::filesystem::exists(p)){
+    boost::filesystem::remove(p);
+  }
+
+  {
+    boost::filesystem::ofstream file(p);
+    file << "<?xml version=\"1.0\"?>\n";
+    file << "<Root version=\"1\">\n";
+    file << "  <!-- comment -->\n";
+    file << "  <Group id=\"g1\">\n";
+    file << "    <Item id=\"i1\"><Name>First</Name><Detail><Value>1</Value></Detail></Item>\n";
+    file << "    <Item id=\"i2\"><Name>Second</Name><Detail><Value>2</Value></Detail></Item>\n";
+    file << "  </Group>\n";
+    file << "  <Other>Ignored</Other>\n";
+    file << "  <Item id=\"i3\"><Name>Third</Name></Item>\n";
+    file << "</Root>\n";
+  }
+
+  XMLFragmentReader reader(p);
+  ASSERT_TRUE(reader.isValid());
+  EXPECT_EQ(0, reader.percentComplete());
+
+  QStringList elementNames = QStringList() << "Item";
+  QStringList startElementNames = QStringList() << "Root" << "Group";
+  QStringList excludedNames = QStringList() << "Detail";
+
+  // start elements have attributes but no children
+  QDomDocument doc = reader.readNextElement(elementNames, startElementNames, excludedNames);
+  ASSERT_FALSE(doc.isNull());
+  EXPECT_EQ("Root", doc.documentElement().tagName().toStdString());
+  EXPECT_EQ("1", doc.documentElement().attribute("version").toStdString());
+  EXPECT_FALSE(doc.documentElement().hasChildNodes());
+
+  doc = reader.readNextElement(elementNames, startElementNames, excludedNames);
+  ASSERT_FALSE(doc.isNull());
+  EXPECT_EQ("Group", doc.documentElement().tagName().toStdString());
+  EXPECT_EQ("g1", doc.documentElement().attribute("id").toStdString());
+
+  // elements have their subtree, less excluded elements
+  doc = reader.readNextElement(elementNames, startElementNames, excludedNames);
+  ASSERT_FALSE(doc.isNull());
+  EXPECT_EQ("i1", doc.documentElement().attribute("id").toStdString());
+  EXPECT_EQ("First", doc.documentElement().firstChildElement("Name").text().toStdString());
+  EXPECT_TRUE(doc.documentElement().firstChildElement("Detail").isNull());
+
+  // without exclusions the whole subtree is read
+  doc = reader.readNextElement(elementNames, startElementNames);
+  ASSERT_FALSE(doc.isNull());
+  EXPECT_EQ("i2", doc.documentElement().attribute("id").toStdString());
+  EXPECT_EQ("2", doc.documentElement().firstChildElement("Detail").firstChildElement("Value").text().toStdString());
+
+  doc = reader.readNextElement(elementNames, startElementNames, excludedNames);
+  ASSERT_FALSE(doc.isNull());
+  EXPECT_EQ("i3", doc.documentElement().attribute("id").toStdString());
+  EXPECT_EQ(1, doc.documentElement().childNodes().count());
+
+  doc = reader.readNextElement(elementNames, startElementNames, excludedNames);
+  EXPECT_TRUE(doc.isNull());
+  EXPECT_TRUE(reader.isValid());
+  EXPECT_EQ(100, reader.percentComplete());
+}
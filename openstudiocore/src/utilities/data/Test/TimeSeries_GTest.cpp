@@ -21,6 +21,7 @@
 #include <utilities/data/Test/DataFixture.hpp>
 
 #include <utilities/data/TimeSeries.hpp>
+#include <utilities/units/QuantityConverter.hpp>
 #include <utilities/time/Date.hpp>
 #include <utilities/time/Time.hpp>
 
@@ -295,3 +296,41 @@ TEST_F(DataFixture,TimeSeries_AddSubtractSameTimePeriod)
   // 2:30
   EXPECT_DOUBLE_EQ(6.75, ans.value(Time(0,1,30,0)));
 }
+
+TEST_F(DataFixture,TimeSeries_Convert)
+{
+  Vector values(3);
+  for (unsigned i = 0; i < 3; ++i){
+    values(i) = 10.0*i;
+  }
+  Date startDate(MonthOfYear(MonthOfYear::Feb), 21);
+  Time interval = Time(0,1,0,0);
+  TimeSeries celcius(startDate, interval, values, "C");
+  celcius.setOutOfRangeValue(-40.0);
+
+  OptionalTimeSeries fahrenheit = convert(celcius, "F");
+  ASSERT_TRUE(fahrenheit);
+  EXPECT_EQ("F", fahrenheit->units());
+  ASSERT_EQ(3u, fahrenheit->values().size());
+  EXPECT_NEAR(32.0, fahrenheit->values()(0), 1.0E-10);
+  EXPECT_NEAR(50.0, fahrenheit->values()(1), 1.0E-10);
+  EXPECT_NEAR(68.0, fahrenheit->values()(2), 1.0E-10);
+  EXPECT_NEAR(-40.0, fahrenheit->outOfRangeValue(), 1.0E-10);
+  EXPECT_EQ(celcius.firstReportDateTime(), fahrenheit->firstReportDateTime());
+  ASSERT_TRUE(fahrenheit->intervalLength());
+  EXPECT_EQ(interval, *fahrenheit->intervalLength());
+  // original is untouched
+  EXPECT_EQ("C", celcius.units());
+  EXPECT_DOUBLE_EQ(10.0, celcius.values()(1));
+
+  TimeSeries watts(startDate, interval, values, "W");
+  OptionalTimeSeries btuh = convert(watts, "Btu/h");
+  ASSERT_TRUE(btuh);
+  for (unsigned i = 0; i < 3; ++i) {
+    boost::optional<double> expected = convert(watts.values()(i), "W", "Btu/h");
+    ASSERT_TRUE(expected);
+    EXPECT_NEAR(*expected, btuh->values()(i), 1.0E-10);
+  }
+
+  EXPECT_FALSE(convert(watts, "m"));
+}
@@ -19,6 +19,8 @@
 
 #include <utilities/data/TimeSeries.hpp>
 
+#include <utilities/units/QuantityConverter.hpp>
+
 #include <exception>
 #include <set>
 
@@ -464,6 +466,34 @@ namespace openstudio{
     return series*d;
   }
 
+  boost::optional<TimeSeries> convert(const TimeSeries& series, const std::string& finalUnits) {
+    std::string units = series.units();
+    if (units == finalUnits) {
+      return series;
+    }
+
+    boost::optional<std::pair<double,double> > affine = 
+        QuantityConverter::instance().affineConversion(units,finalUnits);
+    if (!affine) {
+      return boost::none;
+    }
+    double factor = affine->first;
+    double offset = affine->second;
+
+    Vector values = series.values();
+    for (unsigned i = 0, n = values.size(); i < n; ++i) {
+      values[i] = factor * values[i] + offset;
+    }
+
+    // rebuild through the interval constructor where possible so the interval length is kept
+    OptionalTime intervalLength = series.intervalLength();
+    TimeSeries result = intervalLength ? 
+        TimeSeries(series.firstReportDateTime(),*intervalLength,values,finalUnits) :
+        TimeSeries(series.firstReportDateTime(),series.daysFromFirstReport(),values,finalUnits);
+    result.setOutOfRangeValue(factor * series.outOfRangeValue() + offset);
+    return result;
+  }
+
   TimeSeries sum(const std::vector<TimeSeries>& timeSeriesVector) {
     TimeSeries result;
     bool first = true;
@@ -253,6 +253,12 @@ namespace openstudio{
   // We should be able to tackle double/TimeSeries after adding get/setQuantity to 
   // IdfObject.
 
+  /** Converts series to finalUnits. The conversion is looked up once for the pair of unit 
+   *  strings and applied to every value (and to the out of range value) as factor * value + 
+   *  offset. Report times and interval length are unchanged. Returns boost::none if the units
+   *  cannot be converted. */
+  UTILITIES_API boost::optional<TimeSeries> convert(const TimeSeries& series, const std::string& finalUnits);
+
   // Helper function to add up all the TimeSeries in timeSeriesVector.
   UTILITIES_API TimeSeries sum(const std::vector<TimeSeries>& timeSeriesVector);
 
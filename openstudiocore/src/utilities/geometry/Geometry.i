@@ -6,9 +6,11 @@
   using namespace openstudio;
   #include <utilities/geometry/Vector3d.hpp>
   #include <utilities/geometry/Point3d.hpp>
+  #include <utilities/geometry/Point3dBuffer.hpp>
   #include <utilities/geometry/Plane.hpp>
   #include <utilities/geometry/EulerAngles.hpp>
   #include <utilities/geometry/Geometry.hpp>
+  #include <utilities/geometry/Intersection.hpp>
   #include <utilities/geometry/Transformation.hpp>
   #include <utilities/geometry/BoundingBox.hpp>
   
@@ -33,6 +35,7 @@
 %template(OptionalPlane) boost::optional<openstudio::Plane>;
 %template(OptionalEulerAngles) boost::optional<openstudio::EulerAngles>;
 %template(OptionalBoundingBox) boost::optional<openstudio::BoundingBox>;
+%template(OptionalIntersectionResult) boost::optional<openstudio::IntersectionResult>;
 
 // create an instantiation of the vector classes
 %template(Point3dVector) std::vector<openstudio::Point3d>;
@@ -51,7 +54,9 @@
 %include <utilities/geometry/Plane.hpp>
 %include <utilities/geometry/EulerAngles.hpp>
 %include <utilities/geometry/Geometry.hpp>
+%include <utilities/geometry/Intersection.hpp>
 %include <utilities/geometry/Transformation.hpp>
 %include <utilities/geometry/BoundingBox.hpp>
+%include <utilities/geometry/Point3dBuffer.hpp>
 
 #endif //UTILITIES_GEOMETRY_GEOMETRY_I 
@@ -0,0 +1,247 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+
+#include <utilities/geometry/Intersection.hpp>
+#include <utilities/geometry/Geometry.hpp>
+#include <utilities/geometry/Vector3d.hpp>
+
+#include <utilities/core/Assert.hpp>
+
+#include <boost/foreach.hpp>
+#include <boost/geometry/geometry.hpp>
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/geometries/polygon.hpp>
+#include <boost/geometry/geometries/ring.hpp>
+#include <boost/geometry/multi/geometries/multi_polygon.hpp>
+
+#include <limits>
+
+namespace openstudio{
+
+  namespace {
+
+    // counterclockwise, closed polygons
+    typedef boost::geometry::model::d2::point_xy<double> BoostPoint;
+    typedef boost::geometry::model::polygon<BoostPoint, false> BoostPolygon;
+    typedef boost::geometry::model::ring<BoostPoint, false> BoostRing;
+    typedef boost::geometry::model::multi_polygon<BoostPolygon> BoostMultiPolygon;
+
+    // removes consecutive points within tol of each other, including last to first
+    std::vector<Point3d> removeDuplicates(const std::vector<Point3d>& points, double tol)
+    {
+      std::vector<Point3d> result;
+      BOOST_FOREACH(const Point3d& point, points){
+        if (result.empty() || (getDistance(result.back(), point) > tol)){
+          result.push_back(point);
+        }
+      }
+      while ((result.size() > 1) && (getDistance(result.back(), result.front()) <= tol)){
+        result.pop_back();
+      }
+      return result;
+    }
+
+    // flattens to z = 0 and removes duplicates
+    std::vector<Point3d> prepareInput(const std::vector<Point3d>& points, double tol)
+    {
+      std::vector<Point3d> result;
+      result.reserve(points.size());
+      BOOST_FOREACH(const Point3d& point, points){
+        result.push_back(Point3d(point.x(), point.y(), 0.0));
+      }
+      return removeDuplicates(result, tol);
+    }
+
+    BoostPolygon toBoostPolygon(const std::vector<Point3d>& points)
+    {
+      BoostPolygon result;
+      BOOST_FOREACH(const Point3d& point, points){
+        boost::geometry::append(result, BoostPoint(point.x(), point.y()));
+      }
+      // fixes orientation and closes the ring
+      boost::geometry::correct(result);
+      return result;
+    }
+
+    // converts a ring, snapping to nearby input vertices so that shared corners are exact
+    std::vector<Point3d> fromBoostRing(const BoostRing& ring,
+                                       const std::vector<Point3d>& snapPoints,
+                                       double tol)
+    {
+      std::vector<Point3d> result;
+      BOOST_FOREACH(const BoostPoint& boostPoint, ring){
+        Point3d point(boostPoint.x(), boostPoint.y(), 0.0);
+        BOOST_FOREACH(const Point3d& snapPoint, snapPoints){
+          if (getDistance(point, snapPoint) <= tol){
+            point = snapPoint;
+            break;
+          }
+        }
+        result.push_back(point);
+      }
+      result = removeDuplicates(result, tol);
+      result = removeColinear(result);
+      return result;
+    }
+
+    // a piece is a sliver if its average width, area divided by half its perimeter, is within tol
+    bool isSliver(const std::vector<Point3d>& points, double tol)
+    {
+      if (points.size() < 3){
+        return true;
+      }
+      boost::optional<double> area = getArea(points);
+      if (!area){
+        return true;
+      }
+      double perimeter = 0;
+      for (unsigned i = 0, n = points.size(); i < n; ++i){
+        perimeter += getDistance(points[i], points[(i + 1) % n]);
+      }
+      return (*area <= 0.5 * perimeter * tol);
+    }
+
+    // joins the hole to outer with a zero width cut between their closest vertices
+    std::vector<Point3d> mergeHole(const std::vector<Point3d>& outer, const std::vector<Point3d>& hole)
+    {
+      unsigned bestOuter = 0;
+      unsigned bestHole = 0;
+      double bestDistance = std::numeric_limits<double>::max();
+      for (unsigned i = 0; i < outer.size(); ++i){
+        for (unsigned j = 0; j < hole.size(); ++j){
+          double distance = getDistance(outer[i], hole[j]);
+          if (distance < bestDistance){
+            bestDistance = distance;
+            bestOuter = i;
+            bestHole = j;
+          }
+        }
+      }
+
+      std::vector<Point3d> result;
+      result.reserve(outer.size() + hole.size() + 2);
+      result.insert(result.end(), outer.begin(), outer.begin() + bestOuter + 1);
+      for (unsigned j = 0; j <= hole.size(); ++j){
+        result.push_back(hole[(bestHole + j) % hole.size()]);
+      }
+      result.insert(result.end(), outer.begin() + bestOuter, outer.end());
+      return result;
+    }
+
+    std::vector<std::vector<Point3d> > fromBoostMultiPolygon(const BoostMultiPolygon& multiPolygon,
+                                                             const std::vector<Point3d>& snapPoints,
+                                                             double tol)
+    {
+      std::vector<std::vector<Point3d> > result;
+      BOOST_FOREACH(const BoostPolygon& boostPolygon, multiPolygon){
+        std::vector<Point3d> outer = fromBoostRing(boostPolygon.outer(), snapPoints, tol);
+        if (isSliver(outer, tol)){
+          continue;
+        }
+        BOOST_FOREACH(const BoostRing& boostInner, boostPolygon.inners()){
+          std::vector<Point3d> hole = fromBoostRing(boostInner, snapPoints, tol);
+          if (isSliver(hole, tol)){
+            continue;
+          }
+          outer = mergeHole(outer, hole);
+        }
+        result.push_back(outer);
+      }
+      return result;
+    }
+
+  }
+
+  IntersectionResult::IntersectionResult(const std::vector<std::vector<Point3d> >& intersections,
+                                         const std::vector<std::vector<Point3d> >& newPolygons1,
+                                         const std::vector<std::vector<Point3d> >& newPolygons2)
+    : m_intersections(intersections), m_newPolygons1(newPolygons1), m_newPolygons2(newPolygons2)
+  {}
+
+  std::vector<std::vector<Point3d> > IntersectionResult::intersections() const
+  {
+    return m_intersections;
+  }
+
+  std::vector<std::vector<Point3d> > IntersectionResult::newPolygons1() const
+  {
+    return m_newPolygons1;
+  }
+
+  std::vector<std::vector<Point3d> > IntersectionResult::newPolygons2() const
+  {
+    return m_newPolygons2;
+  }
+
+  boost::optional<IntersectionResult> intersect(const std::vector<Point3d>& polygon1,
+                                                const std::vector<Point3d>& polygon2,
+                                                double tol)
+  {
+    std::vector<Point3d> points1 = prepareInput(polygon1, tol);
+    std::vector<Point3d> points2 = prepareInput(polygon2, tol);
+    if ((points1.size() < 3) || (points2.size() < 3)){
+      return boost::none;
+    }
+
+    BoostPolygon boostPolygon1 = toBoostPolygon(points1);
+    BoostPolygon boostPolygon2 = toBoostPolygon(points2);
+
+    // quick rejection on bounding boxes
+    boost::geometry::model::box<BoostPoint> box1;
+    boost::geometry::model::box<BoostPoint> box2;
+    boost::geometry::envelope(boostPolygon1, box1);
+    boost::geometry::envelope(boostPolygon2, box2);
+    if ((box1.min_corner().x() >= box2.max_corner().x() - tol) ||
+        (box2.min_corner().x() >= box1.max_corner().x() - tol) ||
+        (box1.min_corner().y() >= box2.max_corner().y() - tol) ||
+        (box2.min_corner().y() >= box1.max_corner().y() - tol))
+    {
+      return boost::none;
+    }
+
+    BoostMultiPolygon boostIntersection;
+    BoostMultiPolygon boostDifference1;
+    BoostMultiPolygon boostDifference2;
+    try{
+      boost::geometry::intersection(boostPolygon1, boostPolygon2, boostIntersection);
+      if (boostIntersection.empty()){
+        return boost::none;
+      }
+      boost::geometry::difference(boostPolygon1, boostPolygon2, boostDifference1);
+      boost::geometry::difference(boostPolygon2, boostPolygon1, boostDifference2);
+    }catch(const std::exception& e){
+      LOG_FREE(Error, "utilities.geometry.intersect", e.what());
+      return boost::none;
+    }
+
+    std::vector<Point3d> snapPoints(points1);
+    snapPoints.insert(snapPoints.end(), points2.begin(), points2.end());
+
+    std::vector<std::vector<Point3d> > intersections = fromBoostMultiPolygon(boostIntersection, snapPoints, tol);
+    if (intersections.empty()){
+      return boost::none;
+    }
+
+    return IntersectionResult(intersections,
+                              fromBoostMultiPolygon(boostDifference1, snapPoints, tol),
+                              fromBoostMultiPolygon(boostDifference2, snapPoints, tol));
+  }
+
+} // openstudio
@@ -0,0 +1,78 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+
+#ifndef UTILITIES_GEOMETRY_INTERSECTION_HPP
+#define UTILITIES_GEOMETRY_INTERSECTION_HPP
+
+#include <utilities/UtilitiesAPI.hpp>
+#include <utilities/geometry/Point3d.hpp>
+#include <utilities/core/Logger.hpp>
+
+#include <vector>
+#include <boost/optional.hpp>
+
+namespace openstudio{
+
+  /** IntersectionResult holds the result of intersecting two polygons with intersect. All
+   *  polygons are in the z = 0 plane, counterclockwise when viewed from +z, not explicitly
+   *  closed, and have no holes. */
+  class UTILITIES_API IntersectionResult{
+  public:
+
+    IntersectionResult(const std::vector<std::vector<Point3d> >& intersections,
+                       const std::vector<std::vector<Point3d> >& newPolygons1,
+                       const std::vector<std::vector<Point3d> >& newPolygons2);
+
+    /// the regions common to both polygons, never empty
+    std::vector<std::vector<Point3d> > intersections() const;
+
+    /// what remains of the first polygon once the intersections are removed, empty if the first
+    /// polygon lies entirely within the second
+    std::vector<std::vector<Point3d> > newPolygons1() const;
+
+    /// what remains of the second polygon once the intersections are removed, empty if the second
+    /// polygon lies entirely within the first
+    std::vector<std::vector<Point3d> > newPolygons2() const;
+
+  private:
+
+    REGISTER_LOGGER("utilities.IntersectionResult");
+
+    std::vector<std::vector<Point3d> > m_intersections;
+    std::vector<std::vector<Point3d> > m_newPolygons1;
+    std::vector<std::vector<Point3d> > m_newPolygons2;
+  };
+
+  // optional IntersectionResult
+  typedef boost::optional<IntersectionResult> OptionalIntersectionResult;
+
+  /// Intersect two polygons in the z = 0 plane (e.g. face coordinates), z values are ignored.
+  /// Input polygons may have either orientation. Output vertices within tol of an input vertex
+  /// are snapped to that vertex so that adjacent results compare equal with circularEqual,
+  /// duplicate and colinear vertices are removed, and pieces narrower than tol are dropped.
+  /// Pieces with holes are returned as a single polygon with a zero width cut to each hole.
+  /// Returns an empty optional if the polygons do not overlap by more than tol.
+  UTILITIES_API boost::optional<IntersectionResult> intersect(const std::vector<Point3d>& polygon1,
+                                                              const std::vector<Point3d>& polygon2,
+                                                              double tol = 0.001);
+
+} // openstudio
+
+#endif //UTILITIES_GEOMETRY_INTERSECTION_HPP
@@ -68,7 +68,11 @@ namespace openstudio{
   private:
 
     REGISTER_LOGGER("utilities.Point3d");
-    Vector m_storage;
+
+    // stored directly rather than in a Vector so that points do not allocate
+    double m_x;
+    double m_y;
+    double m_z;
 
   };
 
@@ -0,0 +1,263 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+
+#include <utilities/geometry/Point3dBuffer.hpp>
+#include <utilities/geometry/Transformation.hpp>
+
+#include <utilities/core/Assert.hpp>
+
+#include <boost/foreach.hpp>
+
+#include <cmath>
+
+namespace openstudio{
+
+  Point3dBuffer::Point3dBuffer()
+    : m_offsets(1, 0)
+  {}
+
+  Point3dBuffer::Point3dBuffer(const std::vector<Point3d>& points)
+    : m_offsets(1, 0)
+  {
+    addPolygon(points);
+  }
+
+  Point3dBuffer::Point3dBuffer(const std::vector<std::vector<Point3d> >& polygons)
+    : m_offsets(1, 0)
+  {
+    unsigned n = 0;
+    BOOST_FOREACH(const std::vector<Point3d>& polygon, polygons){
+      n += polygon.size();
+    }
+    reserve(n);
+    m_offsets.reserve(polygons.size() + 1);
+    BOOST_FOREACH(const std::vector<Point3d>& polygon, polygons){
+      addPolygon(polygon);
+    }
+  }
+
+  unsigned Point3dBuffer::numPoints() const
+  {
+    return m_x.size();
+  }
+
+  unsigned Point3dBuffer::numPolygons() const
+  {
+    return m_offsets.size() - 1;
+  }
+
+  void Point3dBuffer::reserve(unsigned numPoints)
+  {
+    m_x.reserve(numPoints);
+    m_y.reserve(numPoints);
+    m_z.reserve(numPoints);
+  }
+
+  void Point3dBuffer::clear()
+  {
+    m_x.clear();
+    m_y.clear();
+    m_z.clear();
+    m_offsets.assign(1, 0);
+  }
+
+  unsigned Point3dBuffer::addPolygon(const std::vector<Point3d>& points)
+  {
+    BOOST_FOREACH(const Point3d& point, points){
+      m_x.push_back(point.x());
+      m_y.push_back(point.y());
+      m_z.push_back(point.z());
+    }
+    m_offsets.push_back(m_x.size());
+    return numPolygons() - 1;
+  }
+
+  Point3d Point3dBuffer::point(unsigned index) const
+  {
+    BOOST_ASSERT(index < m_x.size());
+    return Point3d(m_x[index], m_y[index], m_z[index]);
+  }
+
+  std::vector<Point3d> Point3dBuffer::points() const
+  {
+    std::vector<Point3d> result;
+    result.reserve(m_x.size());
+    for (unsigned i = 0, n = m_x.size(); i < n; ++i){
+      result.push_back(Point3d(m_x[i], m_y[i], m_z[i]));
+    }
+    return result;
+  }
+
+  std::vector<Point3d> Point3dBuffer::polygon(unsigned polygonIndex) const
+  {
+    BOOST_ASSERT(polygonIndex < numPolygons());
+    std::vector<Point3d> result;
+    unsigned begin = m_offsets[polygonIndex];
+    unsigned end = m_offsets[polygonIndex + 1];
+    result.reserve(end - begin);
+    for (unsigned i = begin; i < end; ++i){
+      result.push_back(Point3d(m_x[i], m_y[i], m_z[i]));
+    }
+    return result;
+  }
+
+  std::vector<std::vector<Point3d> > Point3dBuffer::polygons() const
+  {
+    std::vector<std::vector<Point3d> > result;
+    result.reserve(numPolygons());
+    for (unsigned i = 0, n = numPolygons(); i < n; ++i){
+      result.push_back(polygon(i));
+    }
+    return result;
+  }
+
+  void Point3dBuffer::transform(const Transformation& transformation)
+  {
+    Matrix m = transformation.matrix();
+    const double a00 = m(0,0), a01 = m(0,1), a02 = m(0,2), a03 = m(0,3);
+    const double a10 = m(1,0), a11 = m(1,1), a12 = m(1,2), a13 = m(1,3);
+    const double a20 = m(2,0), a21 = m(2,1), a22 = m(2,2), a23 = m(2,3);
+
+    unsigned n = m_x.size();
+    if (n == 0){
+      return;
+    }
+
+    // independent iterations over contiguous arrays, vectorized by the compiler
+    double* x = &m_x[0];
+    double* y = &m_y[0];
+    double* z = &m_z[0];
+    for (unsigned i = 0; i < n; ++i){
+      double xi = x[i];
+      double yi = y[i];
+      double zi = z[i];
+      x[i] = a00*xi + a01*yi + a02*zi + a03;
+      y[i] = a10*xi + a11*yi + a12*zi + a13;
+      z[i] = a20*xi + a21*yi + a22*zi + a23;
+    }
+  }
+
+  std::vector<Vector3d> Point3dBuffer::newallVectors() const
+  {
+    std::vector<Vector3d> result;
+    result.reserve(numPolygons());
+    for (unsigned p = 0, np = numPolygons(); p < np; ++p){
+      unsigned begin = m_offsets[p];
+      unsigned end = m_offsets[p + 1];
+      double nx = 0;
+      double ny = 0;
+      double nz = 0;
+      if (end - begin >= 3){
+        // same fan decomposition about the first point as getNewallVector
+        double x0 = m_x[begin];
+        double y0 = m_y[begin];
+        double z0 = m_z[begin];
+        for (unsigned i = begin + 1; i < end - 1; ++i){
+          double x1 = m_x[i] - x0;
+          double y1 = m_y[i] - y0;
+          double z1 = m_z[i] - z0;
+          double x2 = m_x[i+1] - x0;
+          double y2 = m_y[i+1] - y0;
+          double z2 = m_z[i+1] - z0;
+          nx += y1*z2 - z1*y2;
+          ny += z1*x2 - x1*z2;
+          nz += x1*y2 - y1*x2;
+        }
+      }
+      result.push_back(Vector3d(nx, ny, nz));
+    }
+    return result;
+  }
+
+  std::vector<double> Point3dBuffer::areas() const
+  {
+    std::vector<Vector3d> newallVectors = this->newallVectors();
+    std::vector<double> result;
+    result.reserve(newallVectors.size());
+    BOOST_FOREACH(const Vector3d& newall, newallVectors){
+      result.push_back(newall.length() / 2.0);
+    }
+    return result;
+  }
+
+  std::vector<boost::optional<Vector3d> > Point3dBuffer::outwardNormals() const
+  {
+    std::vector<Vector3d> newallVectors = this->newallVectors();
+    std::vector<boost::optional<Vector3d> > result;
+    result.reserve(newallVectors.size());
+    BOOST_FOREACH(Vector3d& newall, newallVectors){
+      if (newall.normalize()){
+        result.push_back(newall);
+      }else{
+        result.push_back(boost::none);
+      }
+    }
+    return result;
+  }
+
+  std::vector<boost::optional<Point3d> > Point3dBuffer::centroids() const
+  {
+    std::vector<Vector3d> newallVectors = this->newallVectors();
+    std::vector<boost::optional<Point3d> > result;
+    result.reserve(newallVectors.size());
+    for (unsigned p = 0, np = numPolygons(); p < np; ++p){
+      Vector3d normal = newallVectors[p];
+      if (!normal.normalize()){
+        result.push_back(boost::none);
+        continue;
+      }
+
+      // area weighted centroids of the fan triangles, each signed by its projection on the
+      // polygon normal so that concave polygons are handled
+      unsigned begin = m_offsets[p];
+      unsigned end = m_offsets[p + 1];
+      double x0 = m_x[begin];
+      double y0 = m_y[begin];
+      double z0 = m_z[begin];
+      double totalWeight = 0;
+      double cx = 0;
+      double cy = 0;
+      double cz = 0;
+      for (unsigned i = begin + 1; i < end - 1; ++i){
+        double x1 = m_x[i] - x0;
+        double y1 = m_y[i] - y0;
+        double z1 = m_z[i] - z0;
+        double x2 = m_x[i+1] - x0;
+        double y2 = m_y[i+1] - y0;
+        double z2 = m_z[i+1] - z0;
+        double weight = (y1*z2 - z1*y2)*normal.x() + (z1*x2 - x1*z2)*normal.y() + (x1*y2 - y1*x2)*normal.z();
+        totalWeight += weight;
+        cx += weight*(x1 + x2);
+        cy += weight*(y1 + y2);
+        cz += weight*(z1 + z2);
+      }
+
+      if (totalWeight > 0){
+        result.push_back(Point3d(x0 + cx/(3.0*totalWeight),
+                                 y0 + cy/(3.0*totalWeight),
+                                 z0 + cz/(3.0*totalWeight)));
+      }else{
+        result.push_back(boost::none);
+      }
+    }
+    return result;
+  }
+
+} // openstudio
@@ -0,0 +1,114 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+
+#ifndef UTILITIES_GEOMETRY_POINT3DBUFFER_HPP
+#define UTILITIES_GEOMETRY_POINT3DBUFFER_HPP
+
+#include <utilities/UtilitiesAPI.hpp>
+#include <utilities/geometry/Point3d.hpp>
+#include <utilities/geometry/Vector3d.hpp>
+#include <utilities/core/Logger.hpp>
+
+#include <vector>
+#include <boost/optional.hpp>
+
+namespace openstudio{
+
+  // forward declaration
+  class Transformation;
+
+  /** Point3dBuffer holds the vertices of one or more polygons as separate, contiguous x, y and z
+   *  arrays. Batch operations over all points or all polygons run as plain loops over these
+   *  arrays, which the compiler can vectorize, and do not create a Point3d per vertex. Use it in
+   *  place of a std::vector<Point3dVector> when transforming or measuring many surfaces at once.
+   */
+  class UTILITIES_API Point3dBuffer{
+  public:
+
+    /// default constructor creates empty buffer
+    Point3dBuffer();
+
+    /// constructor from a single polygon
+    explicit Point3dBuffer(const std::vector<Point3d>& points);
+
+    /// constructor from a vector of polygons
+    explicit Point3dBuffer(const std::vector<std::vector<Point3d> >& polygons);
+
+    /// total number of points
+    unsigned numPoints() const;
+
+    /// number of polygons
+    unsigned numPolygons() const;
+
+    /// reserve space for numPoints points
+    void reserve(unsigned numPoints);
+
+    /// remove all points and polygons
+    void clear();
+
+    /// add a polygon, returns its index
+    unsigned addPolygon(const std::vector<Point3d>& points);
+
+    /// get point by index over all polygons
+    Point3d point(unsigned index) const;
+
+    /// get all points
+    std::vector<Point3d> points() const;
+
+    /// get the points of one polygon
+    std::vector<Point3d> polygon(unsigned polygonIndex) const;
+
+    /// get all polygons
+    std::vector<std::vector<Point3d> > polygons() const;
+
+    /// apply the transformation to all points in place
+    void transform(const Transformation& transformation);
+
+    /// compute Newall vector of each polygon, see getNewallVector, zero vector for
+    /// polygons with fewer than three points
+    std::vector<Vector3d> newallVectors() const;
+
+    /// compute area of each polygon, see getArea, zero for polygons with fewer than three points
+    std::vector<double> areas() const;
+
+    /// compute outward normal of each polygon, see getOutwardNormal
+    std::vector<boost::optional<Vector3d> > outwardNormals() const;
+
+    /// compute centroid of each polygon, see getCentroid, polygons are assumed to be planar
+    std::vector<boost::optional<Point3d> > centroids() const;
+
+  private:
+
+    REGISTER_LOGGER("utilities.Point3dBuffer");
+
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_z;
+
+    // polygon i is [m_offsets[i], m_offsets[i+1])
+    std::vector<unsigned> m_offsets;
+  };
+
+  // optional Point3dBuffer
+  typedef boost::optional<Point3dBuffer> OptionalPoint3dBuffer;
+
+} // openstudio
+
+#endif //UTILITIES_GEOMETRY_POINT3DBUFFER_HPP
@@ -0,0 +1,153 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+
+#include <gtest/gtest.h>
+#include <utilities/geometry/Test/GeometryFixture.hpp>
+
+#include <utilities/geometry/Intersection.hpp>
+#include <utilities/geometry/Geometry.hpp>
+#include <utilities/geometry/Point3d.hpp>
+
+#include <boost/foreach.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace openstudio;
+
+namespace {
+
+  Point3dVector rectangle(double x0, double y0, double x1, double y1)
+  {
+    Point3dVector result;
+    result.push_back(Point3d(x0, y1, 0));
+    result.push_back(Point3d(x0, y0, 0));
+    result.push_back(Point3d(x1, y0, 0));
+    result.push_back(Point3d(x1, y1, 0));
+    return result;
+  }
+
+  double totalArea(const std::vector<Point3dVector>& polygons)
+  {
+    double result = 0;
+    BOOST_FOREACH(const Point3dVector& polygon, polygons){
+      result += getArea(polygon).get();
+    }
+    return result;
+  }
+
+}
+
+TEST_F(GeometryFixture, Intersect_Same)
+{
+  Point3dVector points1 = rectangle(0, 0, 10, 10);
+  Point3dVector points2(points1.rbegin(), points1.rend());
+
+  boost::optional<IntersectionResult> result = intersect(points1, points2);
+  ASSERT_TRUE(result);
+  ASSERT_EQ(1u, result->intersections().size());
+  EXPECT_TRUE(circularEqual(points1, result->intersections()[0]));
+  EXPECT_TRUE(result->newPolygons1().empty());
+  EXPECT_TRUE(result->newPolygons2().empty());
+}
+
+TEST_F(GeometryFixture, Intersect_NoOverlap)
+{
+  // disjoint
+  EXPECT_FALSE(intersect(rectangle(0, 0, 10, 10), rectangle(20, 0, 30, 10)));
+
+  // sharing an edge
+  EXPECT_FALSE(intersect(rectangle(0, 0, 10, 10), rectangle(10, 0, 20, 10)));
+
+  // overlapping by less than the tolerance
+  EXPECT_FALSE(intersect(rectangle(0, 0, 10, 10), rectangle(9.9995, 0, 20, 10)));
+}
+
+TEST_F(GeometryFixture, Intersect_Partial)
+{
+  Point3dVector points1 = rectangle(0, 0, 10, 10);
+  Point3dVector points2 = rectangle(5, 0, 15, 10);
+
+  boost::optional<IntersectionResult> result = intersect(points1, points2);
+  ASSERT_TRUE(result);
+  ASSERT_EQ(1u, result->intersections().size());
+  EXPECT_TRUE(circularEqual(rectangle(5, 0, 10, 10), result->intersections()[0]));
+  ASSERT_EQ(1u, result->newPolygons1().size());
+  EXPECT_TRUE(circularEqual(rectangle(0, 0, 5, 10), result->newPolygons1()[0]));
+  ASSERT_EQ(1u, result->newPolygons2().size());
+  EXPECT_TRUE(circularEqual(rectangle(10, 0, 15, 10), result->newPolygons2()[0]));
+
+  // shared corners are snapped exactly to the input vertices
+  Point3dVector intersection = result->intersections()[0];
+  BOOST_FOREACH(const Point3d& point, intersection){
+    bool found = false;
+    BOOST_FOREACH(const Point3d& input, points1){
+      found = found || (point == input);
+    }
+    BOOST_FOREACH(const Point3d& input, points2){
+      found = found || (point == input);
+    }
+    EXPECT_TRUE(found) << point;
+  }
+}
+
+TEST_F(GeometryFixture, Intersect_Cross)
+{
+  Point3dVector points1 = rectangle(0, 4, 10, 6);
+  Point3dVector points2 = rectangle(4, 0, 6, 10);
+
+  boost::optional<IntersectionResult> result = intersect(points1, points2);
+  ASSERT_TRUE(result);
+  ASSERT_EQ(1u, result->intersections().size());
+  EXPECT_TRUE(circularEqual(rectangle(4, 4, 6, 6), result->intersections()[0]));
+  EXPECT_EQ(2u, result->newPolygons1().size());
+  EXPECT_EQ(2u, result->newPolygons2().size());
+  EXPECT_DOUBLE_EQ(16.0, totalArea(result->newPolygons1()));
+  EXPECT_DOUBLE_EQ(16.0, totalArea(result->newPolygons2()));
+}
+
+TEST_F(GeometryFixture, Intersect_Inside)
+{
+  Point3dVector points1 = rectangle(0, 0, 10, 10);
+  Point3dVector points2 = rectangle(2, 2, 4, 4);
+
+  boost::optional<IntersectionResult> result = intersect(points1, points2);
+  ASSERT_TRUE(result);
+  ASSERT_EQ(1u, result->intersections().size());
+  EXPECT_TRUE(circularEqual(points2, result->intersections()[0]));
+  EXPECT_TRUE(result->newPolygons2().empty());
+
+  // remainder of the larger polygon is cut to its hole
+  ASSERT_EQ(1u, result->newPolygons1().size());
+  EXPECT_EQ(10u, result->newPolygons1()[0].size());
+  EXPECT_NEAR(96.0, getArea(result->newPolygons1()[0]).get(), 1.0E-9);
+}
+
+TEST_F(GeometryFixture, Intersect_Sliver)
+{
+  // differs by a sliver narrower than the tolerance, treated as the same polygon
+  Point3dVector points1 = rectangle(0, 0, 10, 10);
+  Point3dVector points2 = rectangle(0, 0, 10.0005, 10);
+
+  boost::optional<IntersectionResult> result = intersect(points1, points2);
+  ASSERT_TRUE(result);
+  ASSERT_EQ(1u, result->intersections().size());
+  EXPECT_TRUE(result->newPolygons1().empty());
+  EXPECT_TRUE(result->newPolygons2().empty());
+}
@@ -0,0 +1,143 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+
+#include <gtest/gtest.h>
+#include <utilities/geometry/Test/GeometryFixture.hpp>
+
+#include <utilities/geometry/Point3dBuffer.hpp>
+#include <utilities/geometry/Geometry.hpp>
+#include <utilities/geometry/Transformation.hpp>
+#include <utilities/geometry/Point3d.hpp>
+#include <utilities/geometry/Vector3d.hpp>
+
+#include <boost/math/constants/constants.hpp>
+
+using namespace std;
+using namespace boost;
+using namespace openstudio;
+
+TEST_F(GeometryFixture, Point3dBuffer_Polygons)
+{
+  Point3dVector square;
+  square.push_back(Point3d(0, 1, 0));
+  square.push_back(Point3d(0, 0, 0));
+  square.push_back(Point3d(1, 0, 0));
+  square.push_back(Point3d(1, 1, 0));
+
+  Point3dVector triangle;
+  triangle.push_back(Point3d(0, 0, 2));
+  triangle.push_back(Point3d(2, 0, 2));
+  triangle.push_back(Point3d(0, 2, 2));
+
+  Point3dBuffer buffer;
+  EXPECT_EQ(0u, buffer.numPoints());
+  EXPECT_EQ(0u, buffer.numPolygons());
+  EXPECT_EQ(0u, buffer.addPolygon(square));
+  EXPECT_EQ(1u, buffer.addPolygon(Point3dVector()));
+  EXPECT_EQ(2u, buffer.addPolygon(triangle));
+  EXPECT_EQ(7u, buffer.numPoints());
+  ASSERT_EQ(3u, buffer.numPolygons());
+
+  EXPECT_TRUE(square == buffer.polygon(0));
+  EXPECT_TRUE(buffer.polygon(1).empty());
+  EXPECT_TRUE(triangle == buffer.polygon(2));
+  EXPECT_TRUE(Point3d(2, 0, 2) == buffer.point(5));
+
+  std::vector<double> areas = buffer.areas();
+  ASSERT_EQ(3u, areas.size());
+  EXPECT_DOUBLE_EQ(1.0, areas[0]);
+  EXPECT_DOUBLE_EQ(0.0, areas[1]);
+  EXPECT_DOUBLE_EQ(2.0, areas[2]);
+
+  std::vector<OptionalVector3d> normals = buffer.outwardNormals();
+  ASSERT_EQ(3u, normals.size());
+  ASSERT_TRUE(normals[0]);
+  EXPECT_TRUE(vectorEqual(Vector3d(0, 0, 1), *normals[0]));
+  EXPECT_FALSE(normals[1]);
+  ASSERT_TRUE(normals[2]);
+  EXPECT_TRUE(vectorEqual(Vector3d(0, 0, 1), *normals[2]));
+
+  std::vector<OptionalPoint3d> centroids = buffer.centroids();
+  ASSERT_EQ(3u, centroids.size());
+  ASSERT_TRUE(centroids[0]);
+  EXPECT_TRUE(pointEqual(Point3d(0.5, 0.5, 0), *centroids[0]));
+  EXPECT_FALSE(centroids[1]);
+  ASSERT_TRUE(centroids[2]);
+  EXPECT_TRUE(pointEqual(Point3d(2.0/3.0, 2.0/3.0, 2), *centroids[2]));
+
+  buffer.clear();
+  EXPECT_EQ(0u, buffer.numPoints());
+  EXPECT_EQ(0u, buffer.numPolygons());
+}
+
+TEST_F(GeometryFixture, Point3dBuffer_MatchesGeometry)
+{
+  // concave L shaped polygon, rotated out of the xy plane
+  Point3dVector lShape;
+  lShape.push_back(Point3d(0, 0, 0));
+  lShape.push_back(Point3d(3, 0, 0));
+  lShape.push_back(Point3d(3, 1, 0));
+  lShape.push_back(Point3d(1, 1, 0));
+  lShape.push_back(Point3d(1, 3, 0));
+  lShape.push_back(Point3d(0, 3, 0));
+
+  Transformation t = Transformation::translation(Vector3d(1, 2, 3)) *
+                     Transformation::rotation(Vector3d(1, 1, 0), boost::math::constants::pi<double>()/3.0);
+  Point3dVector points = t*lShape;
+
+  std::vector<Point3dVector> polygons;
+  polygons.push_back(lShape);
+  polygons.push_back(points);
+  Point3dBuffer buffer(polygons);
+
+  std::vector<Vector3d> newallVectors = buffer.newallVectors();
+  std::vector<double> areas = buffer.areas();
+  std::vector<OptionalVector3d> normals = buffer.outwardNormals();
+  std::vector<OptionalPoint3d> centroids = buffer.centroids();
+  for (unsigned i = 0; i < polygons.size(); ++i){
+    OptionalVector3d newall = getNewallVector(polygons[i]);
+    ASSERT_TRUE(newall);
+    EXPECT_TRUE(vectorEqual(*newall, newallVectors[i]));
+
+    boost::optional<double> area = getArea(polygons[i]);
+    ASSERT_TRUE(area);
+    EXPECT_DOUBLE_EQ(5.0, *area);
+    EXPECT_DOUBLE_EQ(*area, areas[i]);
+
+    OptionalVector3d normal = getOutwardNormal(polygons[i]);
+    ASSERT_TRUE(normal);
+    ASSERT_TRUE(normals[i]);
+    EXPECT_TRUE(vectorEqual(*normal, *normals[i]));
+
+    OptionalPoint3d centroid = getCentroid(polygons[i]);
+    ASSERT_TRUE(centroid);
+    ASSERT_TRUE(centroids[i]);
+    EXPECT_TRUE(pointEqual(*centroid, *centroids[i]));
+  }
+
+  // batch transform matches point by point transform
+  Point3dBuffer transformed(lShape);
+  transformed.transform(t);
+  Point3dVector result = transformed.points();
+  ASSERT_EQ(points.size(), result.size());
+  for (unsigned i = 0; i < points.size(); ++i){
+    EXPECT_TRUE(pointEqual(points[i], result[i]));
+  }
+}
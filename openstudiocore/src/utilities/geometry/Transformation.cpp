@@ -312,25 +312,26 @@ namespace openstudio{
   /// apply the transformation to the point
   Point3d Transformation::operator*(const Point3d& point) const
   {
-    Vector temp(4);
-    temp(0) = point.x();
-    temp(1) = point.y();
-    temp(2) = point.z();
-    temp(3) = 1.0;
-    temp = prod(m_storage, temp);
-    return Point3d(temp[0], temp[1], temp[2]);
+    // expanded product with (x, y, z, 1), avoids allocating a temporary Vector
+    const Matrix& m = m_storage;
+    double x = point.x();
+    double y = point.y();
+    double z = point.z();
+    return Point3d(m(0,0)*x + m(0,1)*y + m(0,2)*z + m(0,3),
+                   m(1,0)*x + m(1,1)*y + m(1,2)*z + m(1,3),
+                   m(2,0)*x + m(2,1)*y + m(2,2)*z + m(2,3));
   }
 
   /// apply the transformation to the vector
   Vector3d Transformation::operator*(const Vector3d& vector) const
   {
-    Vector temp(4);
-    temp(0) = vector.x();
-    temp(1) = vector.y();
-    temp(2) = vector.z();
-    temp(3) = 1.0;
-    temp = prod(m_storage, temp);
-    return Vector3d(temp[0], temp[1], temp[2]);
+    const Matrix& m = m_storage;
+    double x = vector.x();
+    double y = vector.y();
+    double z = vector.z();
+    return Vector3d(m(0,0)*x + m(0,1)*y + m(0,2)*z + m(0,3),
+                    m(1,0)*x + m(1,1)*y + m(1,2)*z + m(1,3),
+                    m(2,0)*x + m(2,1)*y + m(2,2)*z + m(2,3));
   }
 
   /// apply the transformation to the BoundingBox
@@ -363,9 +364,10 @@ namespace openstudio{
   /// apply the transformation to a vector of points
   std::vector<Point3d> Transformation::operator*(const std::vector<Point3d>& points) const
   {
-    std::vector<Point3d> result(points.size());
+    std::vector<Point3d> result;
+    result.reserve(points.size());
     for(unsigned i = 0; i < points.size(); ++i){
-      result[i] = (*this)*points[i];
+      result.push_back((*this)*points[i]);
     }
     return result;
   }
@@ -373,9 +375,10 @@ namespace openstudio{
   /// apply the transformation to a vector of vector
   std::vector<Vector3d> Transformation::operator*(const std::vector<Vector3d>& vectors) const
   {
-    std::vector<Vector3d> result(vectors.size());
+    std::vector<Vector3d> result;
+    result.reserve(vectors.size());
     for(unsigned i = 0; i < vectors.size(); ++i){
-      result[i] = (*this)*vectors[i];
+      result.push_back((*this)*vectors[i]);
     }
     return result;
   }
@@ -19,43 +19,41 @@
 
 #include <utilities/geometry/Vector3d.hpp>
 
+#include <cmath>
+
 namespace openstudio{
 
   /// default constructor creates vector with 0, 0, 0
   Vector3d::Vector3d()
-    : m_storage(3, 0.0)
+    : m_x(0.0), m_y(0.0), m_z(0.0)
   {}
 
   /// constructor with x, y, z
   Vector3d::Vector3d(double x, double y, double z)
-    : m_storage(3)
-  {
-    m_storage[0] = x;
-    m_storage[1] = y;
-    m_storage[2] = z;
-  }
+    : m_x(x), m_y(y), m_z(z)
+  {}
 
   /// copy constructor
   Vector3d::Vector3d(const Vector3d& other)
-    : m_storage(other.m_storage)
+    : m_x(other.m_x), m_y(other.m_y), m_z(other.m_z)
   {}
 
   /// get x
   double Vector3d::x() const
   {
-    return m_storage[0];
+    return m_x;
   }
 
   /// get y
   double Vector3d::y() const
   {
-    return m_storage[1];
+    return m_y;
   }
 
   /// get z
   double Vector3d::z() const
   {
-    return m_storage[2];
+    return m_z;
   }
 
   /// addition
@@ -70,9 +68,9 @@ namespace openstudio{
   /// addition
   Vector3d& Vector3d::operator+=(const Vector3d& other)
   {
-    m_storage[0] += other.x();
-    m_storage[1] += other.y();
-    m_storage[2] += other.z();
+    m_x += other.x();
+    m_y += other.y();
+    m_z += other.z();
     return *this;
   }
 
@@ -88,16 +86,16 @@ namespace openstudio{
   /// subtraction
   Vector3d& Vector3d::operator-=(const Vector3d& other)
   {
-    m_storage[0] -= other.x();
-    m_storage[1] -= other.y();
-    m_storage[2] -= other.z();
+    m_x -= other.x();
+    m_y -= other.y();
+    m_z -= other.z();
     return *this;
   }
 
   /// check equality
   bool Vector3d::operator==(const Vector3d& other) const
   {
-    return (m_storage == other.m_storage);
+    return ((m_x == other.m_x) && (m_y == other.m_y) && (m_z == other.m_z));
   }
 
   /// ostream operator
@@ -142,13 +140,13 @@ namespace openstudio{
   /// get a vector which is the reverse of this
   Vector3d Vector3d::reverseVector() const
   {
-    return Vector3d(-m_storage[0], -m_storage[1], -m_storage[2]);
+    return Vector3d(-m_x, -m_y, -m_z);
   }
 
   /// get length
   double Vector3d::length() const
   {
-    return norm_2(m_storage);
+    return std::sqrt(m_x*m_x + m_y*m_y + m_z*m_z);
   }
 
   /// set length
@@ -158,9 +156,9 @@ namespace openstudio{
     double currentLength = length();
     if (currentLength > 0){
       double mult = newLength/currentLength;
-      m_storage[0] *= mult;
-      m_storage[1] *= mult;
-      m_storage[2] *= mult;
+      m_x *= mult;
+      m_y *= mult;
+      m_z *= mult;
       result = true;
     }
     return result;
@@ -169,7 +167,7 @@ namespace openstudio{
   /// dot product with another Vector3d
   double Vector3d::dot(const Vector3d& other) const
   {
-    return inner_prod(m_storage, other.m_storage);
+    return m_x*other.m_x + m_y*other.m_y + m_z*other.m_z;
   }
 
   /// cross product with another Vector3d
@@ -184,7 +182,11 @@ namespace openstudio{
   /// get the Vector directly
   Vector Vector3d::vector() const
   {
-    return m_storage;
+    Vector result(3);
+    result[0] = m_x;
+    result[1] = m_y;
+    result[2] = m_z;
+    return result;
   }
 
 } // openstudio
@@ -90,7 +90,10 @@ namespace openstudio{
 
     REGISTER_LOGGER("utilities.Vector3d");
 
-    Vector m_storage;
+    // stored directly rather than in a Vector so that vectors do not allocate
+    double m_x;
+    double m_y;
+    double m_z;
 
   };
 
@@ -57,6 +57,11 @@
 // ignore detail namespace
 %ignore openstudio::detail;
 
+// ignore loading from precompiled tables, which are only used by the IddFactory
+%ignore openstudio::IddKey::load(openstudio::detail::IddKeyTable const &);
+%ignore openstudio::IddField::load(openstudio::detail::IddFieldTable const &,std::string const &);
+%ignore openstudio::IddObject::load(openstudio::detail::IddObjectTable const &,openstudio::IddObjectType);
+
 // ignore ostream related functions
 %ignore print(std::ostream&, bool) const;
 
@@ -21,6 +21,7 @@
 #include <utilities/idd/IddField_Impl.hpp>
 
 #include <utilities/idd/IddRegex.hpp>
+#include <utilities/idd/IddTables.hpp>
 #include <utilities/idd/CommentRegex.hpp>
 #include <utilities/idd/IddFactory.hxx>
 
@@ -252,6 +253,47 @@ namespace detail {
     return result;
   }
 
+  boost::shared_ptr<IddField_Impl> IddField_Impl::load(const IddFieldTable& table,
+                                                       const std::string& objectName) 
+  {
+    boost::shared_ptr<IddField_Impl> result(new IddField_Impl(table.name,objectName));
+    result->m_fieldId = table.fieldId;
+
+    IddFieldProperties& properties = result->m_properties;
+    properties.type = IddFieldType(table.type);
+    properties.note = table.note;
+    properties.required = table.required;
+    properties.autosizable = table.autosizable;
+    properties.autocalculatable = table.autocalculatable;
+    properties.retaincase = table.retaincase;
+    properties.deprecated = table.deprecated;
+    properties.beginExtensible = table.beginExtensible;
+    if (table.units) { properties.units = std::string(table.units); }
+    if (table.ipUnits) { properties.ipUnits = std::string(table.ipUnits); }
+    properties.minBoundType = static_cast<IddFieldProperties::BoundTypes>(table.minBoundType);
+    if (properties.minBoundType != IddFieldProperties::Unbounded) {
+      properties.minBoundValue = table.minBoundValue;
+      properties.minBoundText = std::string(table.minBoundText);
+    }
+    properties.maxBoundType = static_cast<IddFieldProperties::BoundTypes>(table.maxBoundType);
+    if (properties.maxBoundType != IddFieldProperties::Unbounded) {
+      properties.maxBoundValue = table.maxBoundValue;
+      properties.maxBoundText = std::string(table.maxBoundText);
+    }
+    if (table.stringDefault) { properties.stringDefault = std::string(table.stringDefault); }
+    if (table.hasNumericDefault) { properties.numericDefault = table.numericDefault; }
+    properties.objectLists.assign(table.objectLists, table.objectLists + table.numObjectLists);
+    properties.references.assign(table.references, table.references + table.numReferences);
+    properties.externalLists.assign(table.externalLists, table.externalLists + table.numExternalLists);
+
+    result->m_keys.reserve(table.numKeys);
+    for (unsigned i = 0; i < table.numKeys; ++i) {
+      result->m_keys.push_back(IddKey::load(table.keys[i]));
+    }
+
+    return result;
+  }
+
   std::ostream& IddField_Impl::print(std::ostream& os, bool lastField) const
   {
     std::string seperator = (lastField ? std::string(";") : std::string(","));
@@ -717,6 +759,10 @@ OptionalIddField IddField::load(const std::string& name,
   else { return boost::none; }
 }
 
+IddField IddField::load(const detail::IddFieldTable& table, const std::string& objectName) {
+  return IddField(detail::IddField_Impl::load(table,objectName));
+}
+
 std::ostream& IddField::print(std::ostream& os, bool lastField) const
 {
   return m_impl->print(os, lastField);
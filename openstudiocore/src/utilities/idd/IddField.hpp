@@ -39,6 +39,7 @@ class IddKey;
 // forward declarations
 namespace detail {
   class IddField_Impl; 
+  struct IddFieldTable;
 }
 
 /** IddField represents a field in an IddObject, that is, the schema for a single piece of 
@@ -128,6 +129,10 @@ class UTILITIES_API IddField {
                                         const std::string& text, 
                                         const std::string& objectName);
 
+  /** Load the IddField from precompiled data, as generated by GenerateIddFactory. Not for 
+   *  general use. */
+  static IddField load(const detail::IddFieldTable& table, const std::string& objectName);
+
   /** Print the IddField to an output stream. Field slash codes are indented to produce pretty 
    *  output. If lastField, then the field id will be followed by a semi-colon; otherwise, a 
    *  comma will be used (consistent with IDD formatting). */
@@ -36,6 +36,8 @@ namespace openstudio {
 class Unit;
 
 namespace detail {
+
+  struct IddFieldTable;
     
   // implementation of IddField
   class UTILITIES_API IddField_Impl {
@@ -121,6 +123,10 @@ namespace detail {
                                                  const std::string& text, 
                                                  const std::string& objectName);
 
+    /** Load the IddField from precompiled data. No parsing is required. */
+    static boost::shared_ptr<IddField_Impl> load(const IddFieldTable& table, 
+                                                 const std::string& objectName);
+
     /** Print the IddField to an output stream. Field slash codes are indented to produce pretty 
      *  output. If lastField, then the field id will be followed by a semi-colon; otherwise, a 
      *  comma will be used (consistent with IDD formatting). */
@@ -22,6 +22,7 @@
 
 #include <utilities/idd/IddKeyProperties.hpp>
 #include <utilities/idd/IddRegex.hpp>
+#include <utilities/idd/IddTables.hpp>
 
 #include <boost/algorithm/string.hpp>
 
@@ -63,6 +64,12 @@ namespace detail {
     return result;
   }
 
+  boost::shared_ptr<IddKey_Impl> IddKey_Impl::load(const IddKeyTable& table) {
+    boost::shared_ptr<IddKey_Impl> result(new IddKey_Impl(table.name));
+    result->m_properties.note = table.note;
+    return result;
+  }
+
   std::ostream& IddKey_Impl::print(std::ostream& os) const
   {
     os << "       \\key " << m_name << std::endl;
@@ -125,6 +132,10 @@ OptionalIddKey IddKey::load(const std::string& name, const std::string& text) {
   else { return boost::none; }
 }
 
+IddKey IddKey::load(const detail::IddKeyTable& table) {
+  return IddKey(detail::IddKey_Impl::load(table));
+}
+
 std::ostream& IddKey::print(std::ostream& os) const
 {
   return m_impl->print(os);
@@ -36,6 +36,7 @@ class IddKeyProperties;
 
 namespace detail{
   class IddKey_Impl;
+  struct IddKeyTable;
 }
 
 /** IddKey represents an enumeration value for an IDD field of type choice. */
@@ -77,6 +78,9 @@ class UTILITIES_API IddKey {
   /** Load from text. */
   static boost::optional<IddKey> load(const std::string& name, const std::string& text);
 
+  /** Load from precompiled data, as generated by GenerateIddFactory. Not for general use. */
+  static IddKey load(const detail::IddKeyTable& table);
+
   /** Print to os in standard IDD format */
   std::ostream& print(std::ostream& os) const;
 
@@ -34,6 +34,8 @@ namespace openstudio {
 // private namespace
 namespace detail {
 
+  struct IddKeyTable;
+
   /** Implementation class for IddKey. */
   class UTILITIES_API IddKey_Impl {
    public:
@@ -53,6 +55,9 @@ namespace detail {
     /// load by parsing text
     static boost::shared_ptr<IddKey_Impl> load(const std::string& name, const std::string& text);
 
+    /// load from precompiled data
+    static boost::shared_ptr<IddKey_Impl> load(const IddKeyTable& table);
+
     /// print idd 
     std::ostream& print(std::ostream& os) const;
 
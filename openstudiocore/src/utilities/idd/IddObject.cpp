@@ -22,6 +22,7 @@
 
 #include <utilities/idd/ExtensibleIndex.hpp>
 #include <utilities/idd/IddRegex.hpp>
+#include <utilities/idd/IddTables.hpp>
 #include <utilities/idd/IddFactory.hxx>
 #include <utilities/idd/IddKey.hpp>
 #include <utilities/idd/CommentRegex.hpp>
@@ -416,6 +417,36 @@ namespace detail {
     return result;
   }
 
+  boost::shared_ptr<IddObject_Impl> IddObject_Impl::load(const IddObjectTable& table, 
+                                                         IddObjectType type) 
+  {
+    boost::shared_ptr<IddObject_Impl> result(new IddObject_Impl(table.name,table.group,type));
+
+    IddObjectProperties& properties = result->m_properties;
+    properties.memo = table.memo;
+    properties.unique = table.unique;
+    properties.required = table.required;
+    properties.obsolete = table.obsolete;
+    properties.hasURL = table.hasURL;
+    properties.extensible = table.extensible;
+    properties.numExtensible = table.numExtensible;
+    properties.numExtensibleGroupsRequired = table.numExtensibleGroupsRequired;
+    properties.format = table.format;
+    properties.minFields = table.minFields;
+    if (table.hasMaxFields) { properties.maxFields = table.maxFields; }
+
+    result->m_fields.reserve(table.numFields);
+    for (unsigned i = 0; i < table.numFields; ++i) {
+      result->m_fields.push_back(IddField::load(table.fields[i],result->m_name));
+    }
+    result->m_extensibleFields.reserve(table.numExtensibleFields);
+    for (unsigned i = 0; i < table.numExtensibleFields; ++i) {
+      result->m_extensibleFields.push_back(IddField::load(table.extensibleFields[i],result->m_name));
+    }
+
+    return result;
+  }
+
   /// print
   std::ostream& IddObject_Impl::print(std::ostream& os) const
   {
@@ -820,6 +851,10 @@ boost::optional<IddObject> IddObject::load(const std::string& name,
   return load(name,group,text,IddObjectType(IddObjectType::UserCustom));
 }
 
+IddObject IddObject::load(const detail::IddObjectTable& table, IddObjectType type) {
+  return IddObject(detail::IddObject_Impl::load(table,type));
+}
+
 std::ostream& IddObject::print(std::ostream& os) const
 {
   return m_impl->print(os);
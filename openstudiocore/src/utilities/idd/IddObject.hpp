@@ -40,6 +40,7 @@ class IddObjectType;
 
 namespace detail {
   class IddObject_Impl;
+  struct IddObjectTable;
 } // detail
 
 /** IddObject represents an object in the Idd.  IddObject is a shared object. */
@@ -196,6 +197,10 @@ class UTILITIES_API IddObject {
                                          const std::string& group,
                                          const std::string& text);
 
+  /** Load from precompiled data, as generated by GenerateIddFactory. Used by the IddFactory to
+   *  construct its objects without parsing any text. Not for general use. */
+  static IddObject load(const detail::IddObjectTable& table, IddObjectType type);
+
   /** Print this object to os, in standard IDD format. */
   std::ostream& print(std::ostream& os) const;
 
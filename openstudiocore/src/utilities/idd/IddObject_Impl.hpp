@@ -40,6 +40,8 @@ class ExtensibleIndex;
 
 namespace detail {
 
+  struct IddObjectTable;
+
   /** Implementation of IddObject */
   class UTILITIES_API IddObject_Impl {
    public:
@@ -168,6 +170,9 @@ namespace detail {
                                                   const std::string& text, 
                                                   IddObjectType type);
 
+    /** Load from precompiled data. No parsing is required. */
+    static boost::shared_ptr<IddObject_Impl> load(const IddObjectTable& table, IddObjectType type);
+
     // print
     std::ostream& print(std::ostream& os) const;
 
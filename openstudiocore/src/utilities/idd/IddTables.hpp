@@ -0,0 +1,99 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.  
+*  All rights reserved.
+*  
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*  
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*  
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef UTILITIES_IDD_IDDTABLES_HPP
+#define UTILITIES_IDD_IDDTABLES_HPP
+
+/** \file IddTables.hpp
+ *
+ *  Plain-old-data descriptions of IddObjects, IddFields and IddKeys. GenerateIddFactory parses
+ *  the EnergyPlus and OpenStudio IDD files at build time and emits static const instances of
+ *  these structs, so the IddFactory can construct its IddObjects without any regex parsing.
+ *  All of the structs are aggregates, and so are initialized before any dynamic initialization
+ *  takes place. Optional strings are represented by null pointers. */
+
+namespace openstudio {
+namespace detail {
+
+  /** Precompiled IddKey data. */
+  struct IddKeyTable {
+    const char* name;
+    const char* note;
+  };
+
+  /** Precompiled IddField data. Mirrors IddFieldProperties. */
+  struct IddFieldTable {
+    const char* name;
+    const char* fieldId;
+    int type;                        // IddFieldType::domain value
+    const char* note;
+    bool required;
+    bool autosizable;
+    bool autocalculatable;
+    bool retaincase;
+    bool deprecated;
+    bool beginExtensible;
+    const char* units;
+    const char* ipUnits;
+    int minBoundType;                // IddFieldProperties::BoundTypes value
+    double minBoundValue;            // only meaningful if minBoundType != Unbounded
+    const char* minBoundText;
+    int maxBoundType;                // IddFieldProperties::BoundTypes value
+    double maxBoundValue;            // only meaningful if maxBoundType != Unbounded
+    const char* maxBoundText;
+    const char* stringDefault;
+    bool hasNumericDefault;
+    double numericDefault;
+    const char* const* objectLists;
+    unsigned numObjectLists;
+    const char* const* references;
+    unsigned numReferences;
+    const char* const* externalLists;
+    unsigned numExternalLists;
+    const IddKeyTable* keys;
+    unsigned numKeys;
+  };
+
+  /** Precompiled IddObject data. Mirrors IddObjectProperties. The extensible fields are already
+   *  separated from the regular fields, and their names are stripped of group numbers. */
+  struct IddObjectTable {
+    const char* name;
+    const char* group;
+    const char* memo;
+    bool unique;
+    bool required;
+    bool obsolete;
+    bool hasURL;
+    bool extensible;
+    unsigned numExtensible;
+    unsigned numExtensibleGroupsRequired;
+    const char* format;
+    unsigned minFields;
+    bool hasMaxFields;
+    unsigned maxFields;
+    const IddFieldTable* fields;
+    unsigned numFields;
+    const IddFieldTable* extensibleFields;
+    unsigned numExtensibleFields;
+  };
+
+} // detail
+} // openstudio
+
+#endif // UTILITIES_IDD_IDDTABLES_HPP
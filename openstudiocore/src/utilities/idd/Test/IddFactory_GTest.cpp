@@ -23,6 +23,7 @@
 #include <utilities/idd/IddFactory.hxx>
 #include <utilities/idd/IddFieldProperties.hpp>
 #include <utilities/idd/IddKey.hpp>
+#include <utilities/idd/IddRegex.hpp>
 
 #include <utilities/units/QuantityConverter.hpp>
 #include <utilities/units/Quantity.hpp>
@@ -33,6 +34,7 @@
 #include <OpenStudio.hxx>
 
 #include <boost/foreach.hpp>
+#include <boost/filesystem/fstream.hpp>
 
 using namespace openstudio;
 
@@ -397,3 +399,52 @@ TEST_F(IddFixture,IddFactory_OpenStudioUnits_SubTest3) {
   }
   EXPECT_TRUE(found);
 }
+
+void compareToTextParse(const IddFile& factoryFile, const path& iddPath) {
+  boost::filesystem::ifstream inFile(iddPath); ASSERT_TRUE(inFile);
+  OptionalIddFile textFile = IddFile::load(inFile);
+  ASSERT_TRUE(textFile); inFile.close();
+
+  // objects constructed from the precompiled tables should match the ones parsed from text
+  BOOST_FOREACH(const IddObject& textObject,textFile->objects()) {
+    if (textObject.name() == iddRegex::commentOnlyObjectName()) {
+      continue;
+    }
+    OptionalIddObject factoryObject = factoryFile.getObject(textObject.name());
+    ASSERT_TRUE(factoryObject) << textObject.name();
+    EXPECT_EQ(textObject.group(),factoryObject->group()) << textObject.name();
+    EXPECT_TRUE(textObject.properties() == factoryObject->properties()) << textObject.name();
+    EXPECT_TRUE(textObject.nonextensibleFields() == factoryObject->nonextensibleFields()) << textObject.name();
+    EXPECT_TRUE(textObject.extensibleGroup() == factoryObject->extensibleGroup()) << textObject.name();
+  }
+}
+
+TEST_F(IddFixture,IddFactory_PrecompiledTables) {
+  {
+    SCOPED_TRACE("EnergyPlus");
+    compareToTextParse(epIddFile,resourcesPath()/toPath("energyplus/ProposedEnergy+.idd"));
+  }
+  {
+    SCOPED_TRACE("OpenStudio");
+    compareToTextParse(osIddFile,resourcesPath()/toPath("model/OpenStudio.idd"));
+  }
+}
+
+TEST_F(IddFixture,Profile_IddFactory_StartupTime) {
+  // IddFactory load times were recorded by SetUpTestCase, before any other test touched the
+  // factory. Compare them to parsing the same files from text.
+  path epIddPath = resourcesPath()/toPath("energyplus/ProposedEnergy+.idd");
+  Time start = Time::currentTime();
+  EXPECT_TRUE(IddFile::load(epIddPath));
+  Time epTextLoadTime = Time::currentTime() - start;
+
+  path osIddPath = resourcesPath()/toPath("model/OpenStudio.idd");
+  start = Time::currentTime();
+  EXPECT_TRUE(IddFile::load(osIddPath));
+  Time osTextLoadTime = Time::currentTime() - start;
+
+  LOG(Info,"EnergyPlus IddFile load time: " << epIddLoadTime << " (IddFactory), " 
+      << epTextLoadTime << " (text).");
+  LOG(Info,"OpenStudio IddFile load time: " << osIddLoadTime << " (IddFactory), " 
+      << osTextLoadTime << " (text).");
+}
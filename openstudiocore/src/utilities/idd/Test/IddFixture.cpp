@@ -32,12 +32,14 @@ void IddFixture::SetUpTestCase()
   openstudio::Time start = openstudio::Time::currentTime();
   epIddFile = openstudio::IddFactory::instance().getIddFile(openstudio::IddFileType::EnergyPlus);
   iddLoadTime = openstudio::Time::currentTime() - start;
+  epIddLoadTime = iddLoadTime;
 
   LOG(Info, "EnergyPlus IddFile load time (from IddFactory) = " << iddLoadTime);
 
   start = openstudio::Time::currentTime();
   osIddFile = openstudio::IddFactory::instance().getIddFile(openstudio::IddFileType::OpenStudio);
   iddLoadTime = openstudio::Time::currentTime() - start;
+  osIddLoadTime = iddLoadTime;
 
   LOG(Info, "OpenStudio IddFile load time (from IddFactory) = " << iddLoadTime);
 }
@@ -49,4 +51,6 @@ void IddFixture::TearDownTestCase() {
 openstudio::IddFile IddFixture::epIddFile;
 openstudio::IddFile IddFixture::osIddFile;
 openstudio::Time IddFixture::iddLoadTime;
+openstudio::Time IddFixture::epIddLoadTime;
+openstudio::Time IddFixture::osIddLoadTime;
 boost::optional<openstudio::FileLogSink> IddFixture::logFile;
@@ -57,6 +57,8 @@ public:
   static openstudio::IddFile epIddFile;
   static openstudio::IddFile osIddFile;
   static openstudio::Time iddLoadTime;
+  static openstudio::Time epIddLoadTime;
+  static openstudio::Time osIddLoadTime;
   static boost::optional<openstudio::FileLogSink> logFile;
 };
 
@@ -1972,6 +1972,17 @@ IdfObject IdfObject::clone(bool keepHandle) const
   return copy;
 }
 
+IdfObject IdfObject::clone(const IddObject& iddObject) const
+{
+  IdfObject copy(boost::shared_ptr<detail::IdfObject_Impl>(new detail::IdfObject_Impl(
+      m_impl->handle(),
+      m_impl->comment(),
+      iddObject,
+      m_impl->fields(),
+      m_impl->fieldComments())));
+  return copy;
+}
+
 // GETTERS
 
 Handle IdfObject::handle() const {
@@ -99,6 +99,12 @@ class UTILITIES_API IdfObject {
   /** Creates a deep copy of this object. This object and the newly created object do not share
    *  data, and the new object is always unlocked. */
   IdfObject clone(bool keepHandle=false) const;
+
+  /** Creates a deep copy of this object that is described by iddObject rather than by 
+   *  this->iddObject(). The handle, comments, and field data are copied verbatim, so iddObject
+   *  should have the same field layout as this->iddObject(). Used to move objects between IDD 
+   *  versions without printing and reparsing them. */
+  IdfObject clone(const IddObject& iddObject) const;
  
   //@}
   /** @name Getters */
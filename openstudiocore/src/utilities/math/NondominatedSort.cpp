@@ -0,0 +1,236 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <utilities/math/NondominatedSort.hpp>
+
+#include <utilities/core/Assert.hpp>
+
+#include <boost/foreach.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace openstudio {
+
+namespace {
+
+  struct LexicographicLess {
+    LexicographicLess(const std::vector< std::vector<double> >& values)
+      : m_values(values)
+    {}
+
+    bool operator()(unsigned left, unsigned right) const {
+      if (m_values[left] == m_values[right]) {
+        return left < right;
+      }
+      return m_values[left] < m_values[right];
+    }
+
+    const std::vector< std::vector<double> >& m_values;
+  };
+
+  struct ValueLess {
+    ValueLess(const std::vector<double>& values)
+      : m_values(values)
+    {}
+
+    bool operator()(unsigned left, unsigned right) const {
+      return m_values[left] < m_values[right];
+    }
+
+    const std::vector<double>& m_values;
+  };
+
+}
+
+NondominatedSort::NondominatedSort(unsigned numObjectives)
+  : m_numObjectives(numObjectives), m_sorted(true)
+{
+  BOOST_ASSERT(m_numObjectives > 0u);
+}
+
+unsigned NondominatedSort::numObjectives() const {
+  return m_numObjectives;
+}
+
+unsigned NondominatedSort::numPoints() const {
+  return m_values.size();
+}
+
+const std::vector<double>& NondominatedSort::values(unsigned index) const {
+  BOOST_ASSERT(index < m_values.size());
+  return m_values[index];
+}
+
+unsigned NondominatedSort::addPoint(const std::vector<double>& values) {
+  BOOST_ASSERT(values.size() == m_numObjectives);
+
+  unsigned result = m_values.size();
+  m_values.push_back(values);
+  m_sorted = false;
+
+  // update the Pareto front
+  BOOST_FOREACH(unsigned index, m_paretoFront) {
+    if (dominates(m_values[index],values)) {
+      return result;
+    }
+  }
+  std::vector<unsigned>::iterator it = m_paretoFront.begin();
+  while (it != m_paretoFront.end()) {
+    if (dominates(values,m_values[*it])) {
+      it = m_paretoFront.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+  m_paretoFront.push_back(result);
+
+  return result;
+}
+
+void NondominatedSort::clear() {
+  m_values.clear();
+  m_paretoFront.clear();
+  m_fronts.clear();
+  m_ranks.clear();
+  m_sorted = true;
+}
+
+std::vector<unsigned> NondominatedSort::paretoFront() const {
+  return m_paretoFront;
+}
+
+std::vector< std::vector<unsigned> > NondominatedSort::fronts() const {
+  sort();
+  return m_fronts;
+}
+
+unsigned NondominatedSort::rank(unsigned index) const {
+  BOOST_ASSERT(index < m_values.size());
+  sort();
+  return m_ranks[index];
+}
+
+std::vector<double> NondominatedSort::crowdingDistances(const std::vector<unsigned>& front) const {
+  unsigned n = front.size();
+  std::vector<double> result(n,0.0);
+  if (n < 3u) {
+    std::fill(result.begin(),result.end(),std::numeric_limits<double>::infinity());
+    return result;
+  }
+
+  // positions into front, sorted by each objective in turn
+  std::vector<unsigned> order(n);
+  std::vector<double> objectiveValues(n);
+  for (unsigned obj = 0; obj < m_numObjectives; ++obj) {
+    for (unsigned i = 0; i < n; ++i) {
+      BOOST_ASSERT(front[i] < m_values.size());
+      order[i] = i;
+      objectiveValues[i] = m_values[front[i]][obj];
+    }
+    std::sort(order.begin(),order.end(),ValueLess(objectiveValues));
+
+    double minValue = objectiveValues[order.front()];
+    double maxValue = objectiveValues[order.back()];
+    result[order.front()] = std::numeric_limits<double>::infinity();
+    result[order.back()] = std::numeric_limits<double>::infinity();
+    if (maxValue <= minValue) {
+      continue;
+    }
+    for (unsigned i = 1; i < n - 1; ++i) {
+      result[order[i]] += (objectiveValues[order[i + 1]] - objectiveValues[order[i - 1]]) / (maxValue - minValue);
+    }
+  }
+
+  return result;
+}
+
+bool NondominatedSort::dominates(const std::vector<double>& left, const std::vector<double>& right) {
+  BOOST_ASSERT(left.size() == right.size());
+  bool better(false);
+  for (unsigned i = 0, n = left.size(); i < n; ++i) {
+    if (right[i] < left[i]) {
+      return false;
+    }
+    if (left[i] < right[i]) {
+      better = true;
+    }
+  }
+  return better;
+}
+
+void NondominatedSort::sort() const {
+  if (m_sorted) {
+    return;
+  }
+
+  unsigned n = m_values.size();
+  std::vector<unsigned> order(n);
+  for (unsigned i = 0; i < n; ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(),order.end(),LexicographicLess(m_values));
+
+  // in lexicographic order a point can only be dominated by points that precede it, so each
+  // point can be placed as soon as it is reached. if front k dominates a point then so does
+  // front k-1, so the point's front can be found by binary search.
+  m_fronts.clear();
+  m_ranks.assign(n,0u);
+  BOOST_FOREACH(unsigned index, order) {
+    unsigned lo(0), hi(m_fronts.size());
+    while (lo < hi) {
+      unsigned mid = lo + (hi - lo) / 2u;
+      if (frontDominates(mid,index)) {
+        lo = mid + 1u;
+      }
+      else {
+        hi = mid;
+      }
+    }
+    if (lo == m_fronts.size()) {
+      m_fronts.push_back(std::vector<unsigned>());
+    }
+    m_fronts[lo].push_back(index);
+    m_ranks[index] = lo;
+  }
+
+  m_sorted = true;
+}
+
+bool NondominatedSort::frontDominates(unsigned front, unsigned index) const {
+  const std::vector<unsigned>& members = m_fronts[front];
+  const std::vector<double>& values = m_values[index];
+
+  // with one or two objectives, the last point added to the front has the smallest value of the
+  // last objective in that front, so if any member dominates the point, it does
+  if (m_numObjectives <= 2u) {
+    return dominates(m_values[members.back()],values);
+  }
+
+  // otherwise, check the most recently added (most likely dominating) members first
+  for (std::vector<unsigned>::const_reverse_iterator it = members.rbegin(); it != members.rend(); ++it) {
+    if (dominates(m_values[*it],values)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // openstudio
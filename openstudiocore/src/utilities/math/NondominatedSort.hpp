@@ -0,0 +1,89 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef UTILITIES_MATH_NONDOMINATEDSORT_HPP
+#define UTILITIES_MATH_NONDOMINATEDSORT_HPP
+
+#include <utilities/UtilitiesAPI.hpp>
+
+#include <vector>
+
+namespace openstudio {
+
+/** NondominatedSort ranks points in objective space into Pareto fronts, with all objectives 
+ *  to be minimized. Points are added one at a time, for instance as data points complete. The 
+ *  Pareto front (front 0) is updated as each point is added; the remaining fronts are computed 
+ *  when first requested using efficient non-dominated sorting with binary search, which is 
+ *  O(N log N) for one or two objectives. Points are referred to by the index returned from 
+ *  addPoint. */
+class UTILITIES_API NondominatedSort {
+ public:
+  /** Construct an empty sort for points with numObjectives objective values. */
+  explicit NondominatedSort(unsigned numObjectives);
+
+  unsigned numObjectives() const;
+
+  unsigned numPoints() const;
+
+  /** Returns the objective values of point index. */
+  const std::vector<double>& values(unsigned index) const;
+
+  /** Adds a point and returns its index. values.size() must equal numObjectives(). */
+  unsigned addPoint(const std::vector<double>& values);
+
+  /** Removes all points. */
+  void clear();
+
+  /** Returns the indices of the non-dominated points, in the order they were added. */
+  std::vector<unsigned> paretoFront() const;
+
+  /** Returns the indices of the points in each front. Front 0 is the Pareto front, the points 
+   *  in front k are dominated only by points in fronts 0 through k-1. Within a front, points 
+   *  are in lexicographic order of their objective values. */
+  std::vector< std::vector<unsigned> > fronts() const;
+
+  /** Returns the front to which point index belongs. */
+  unsigned rank(unsigned index) const;
+
+  /** Returns the crowding distance of each point in front, as defined for NSGA-II. Boundary 
+   *  points in any objective are assigned std::numeric_limits<double>::infinity(). */
+  std::vector<double> crowdingDistances(const std::vector<unsigned>& front) const;
+
+  /** Returns true if left is no worse than right in every objective and better in at least 
+   *  one. */
+  static bool dominates(const std::vector<double>& left, const std::vector<double>& right);
+
+ private:
+  unsigned m_numObjectives;
+  std::vector< std::vector<double> > m_values;
+  std::vector<unsigned> m_paretoFront;
+
+  // computed on demand
+  mutable bool m_sorted;
+  mutable std::vector< std::vector<unsigned> > m_fronts;
+  mutable std::vector<unsigned> m_ranks;
+
+  void sort() const;
+
+  bool frontDominates(unsigned front, unsigned index) const;
+};
+
+} // openstudio
+
+#endif // UTILITIES_MATH_NONDOMINATEDSORT_HPP
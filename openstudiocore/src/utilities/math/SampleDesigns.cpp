@@ -0,0 +1,203 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <utilities/math/SampleDesigns.hpp>
+
+#include <utilities/core/Assert.hpp>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <QAtomicInt>
+#include <QCoreApplication>
+#include <QDateTime>
+
+#include <algorithm>
+#include <limits>
+
+namespace openstudio {
+
+namespace {
+
+  // primitive polynomials and initial direction numbers for Sobol dimensions 2 and up, from 
+  // S. Joe and F. Y. Kuo, "Constructing Sobol sequences with better two-dimensional projections", 
+  // SIAM J. Sci. Comput. 30, 2635-2654 (2008). the polynomial of degree s is 
+  // x^s + a_1 x^(s-1) + ... + a_(s-1) x + 1, with a = a_1 ... a_(s-1) read as binary digits.
+  struct SobolPolynomial {
+    unsigned s;
+    unsigned a;
+    unsigned m[7];
+  };
+
+  const SobolPolynomial sobolPolynomials[] = {
+    {1,  0, {1}},
+    {2,  1, {1,3}},
+    {3,  1, {1,3,1}},
+    {3,  2, {1,1,1}},
+    {4,  1, {1,1,3,3}},
+    {4,  4, {1,3,5,13}},
+    {5,  2, {1,1,5,5,17}},
+    {5,  4, {1,1,5,5,5}},
+    {5,  7, {1,1,7,11,19}},
+    {5, 11, {1,1,5,1,1}},
+    {5, 13, {1,1,1,3,11}},
+    {5, 14, {1,3,5,5,31}},
+    {6,  1, {1,3,3,9,7,49}},
+    {6, 13, {1,1,1,15,21,21}},
+    {6, 16, {1,3,1,13,27,49}},
+    {6, 19, {1,1,1,15,7,5}},
+    {6, 22, {1,3,1,15,13,25}},
+    {6, 25, {1,1,5,5,19,61}},
+    {7,  1, {1,3,7,11,23,15,103}},
+    {7,  4, {1,3,7,13,13,15,69}}
+  };
+
+  const unsigned numSobolBits = 32u;
+
+  // direction numbers v[k] = m_(k+1) / 2^(k+1), scaled by 2^32
+  std::vector<boost::uint32_t> sobolDirections(unsigned dimension) {
+    std::vector<boost::uint32_t> result(numSobolBits);
+    if (dimension == 0u) {
+      for (unsigned k = 0; k < numSobolBits; ++k) {
+        result[k] = boost::uint32_t(1) << (numSobolBits - 1u - k);
+      }
+      return result;
+    }
+
+    const SobolPolynomial& polynomial = sobolPolynomials[dimension - 1u];
+    unsigned s = polynomial.s;
+    for (unsigned k = 0; (k < s) && (k < numSobolBits); ++k) {
+      result[k] = boost::uint32_t(polynomial.m[k]) << (numSobolBits - 1u - k);
+    }
+    for (unsigned k = s; k < numSobolBits; ++k) {
+      result[k] = result[k - s] ^ (result[k - s] >> s);
+      for (unsigned j = 1; j < s; ++j) {
+        if ((polynomial.a >> (s - 1u - j)) & 1u) {
+          result[k] ^= result[k - j];
+        }
+      }
+    }
+    return result;
+  }
+
+}
+
+std::vector< std::vector<double> > randomDesign(unsigned numSamples,
+                                                unsigned numDimensions,
+                                                unsigned seed)
+{
+  boost::mt19937 generator(seed);
+  boost::uniform_real<> distribution(0.0,1.0);
+  boost::variate_generator<boost::mt19937&, boost::uniform_real<> > random(generator,distribution);
+
+  std::vector< std::vector<double> > result(numSamples,std::vector<double>(numDimensions));
+  for (unsigned i = 0; i < numSamples; ++i) {
+    for (unsigned j = 0; j < numDimensions; ++j) {
+      result[i][j] = random();
+    }
+  }
+  return result;
+}
+
+std::vector< std::vector<double> > latinHypercubeDesign(unsigned numSamples,
+                                                        unsigned numDimensions,
+                                                        unsigned seed)
+{
+  boost::mt19937 generator(seed);
+  boost::uniform_real<> distribution(0.0,1.0);
+  boost::variate_generator<boost::mt19937&, boost::uniform_real<> > random(generator,distribution);
+
+  std::vector< std::vector<double> > result(numSamples,std::vector<double>(numDimensions));
+  std::vector<unsigned> strata(numSamples);
+  for (unsigned j = 0; j < numDimensions; ++j) {
+    // Fisher-Yates shuffle, written out so designs do not depend on the standard library
+    for (unsigned i = 0; i < numSamples; ++i) {
+      strata[i] = i;
+    }
+    for (unsigned i = numSamples; i > 1u; --i) {
+      boost::uniform_int<unsigned> pick(0u,i - 1u);
+      std::swap(strata[i - 1u],strata[pick(generator)]);
+    }
+    for (unsigned i = 0; i < numSamples; ++i) {
+      result[i][j] = (static_cast<double>(strata[i]) + random()) / static_cast<double>(numSamples);
+    }
+  }
+  return result;
+}
+
+std::vector< std::vector<double> > sobolDesign(unsigned numSamples,
+                                               unsigned numDimensions,
+                                               boost::optional<unsigned> seed)
+{
+  BOOST_ASSERT(numDimensions <= maxSobolDimensions());
+
+  std::vector< std::vector<boost::uint32_t> > directions;
+  for (unsigned j = 0; j < numDimensions; ++j) {
+    directions.push_back(sobolDirections(j));
+  }
+
+  std::vector<boost::uint32_t> x(numDimensions,0u);
+  if (seed) {
+    boost::mt19937 generator(*seed);
+    for (unsigned j = 0; j < numDimensions; ++j) {
+      x[j] = generator();
+    }
+  }
+
+  // Gray code ordering: point i differs from point i-1 by the direction number indexed by the 
+  // lowest zero bit of i-1. point 0 (the origin, or the shift) is skipped.
+  const double scale = 1.0 / 4294967296.0;
+  std::vector< std::vector<double> > result(numSamples,std::vector<double>(numDimensions));
+  for (unsigned i = 0; i < numSamples; ++i) {
+    unsigned c = 0;
+    for (unsigned value = i; value & 1u; value >>= 1) {
+      ++c;
+    }
+    BOOST_ASSERT(c < numSobolBits);
+    for (unsigned j = 0; j < numDimensions; ++j) {
+      x[j] ^= directions[j][c];
+      result[i][j] = static_cast<double>(x[j]) * scale;
+    }
+  }
+  return result;
+}
+
+unsigned maxSobolDimensions() {
+  return 1u + sizeof(sobolPolynomials) / sizeof(sobolPolynomials[0]);
+}
+
+namespace {
+  QAtomicInt randomSeedCounter;
+}
+
+int randomSeed() {
+  // mix the sources, then let the generator spread them over the whole range
+  boost::uint32_t entropy = static_cast<boost::uint32_t>(QDateTime::currentMSecsSinceEpoch());
+  entropy ^= static_cast<boost::uint32_t>(QCoreApplication::applicationPid()) << 16;
+  entropy ^= static_cast<boost::uint32_t>(randomSeedCounter.fetchAndAddRelaxed(1)) * 2654435761u;
+  boost::mt19937 generator(entropy);
+  boost::uniform_int<int> distribution(1,std::numeric_limits<int>::max());
+  return distribution(generator);
+}
+
+} // openstudio
@@ -0,0 +1,67 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef UTILITIES_MATH_SAMPLEDESIGNS_HPP
+#define UTILITIES_MATH_SAMPLEDESIGNS_HPP
+
+#include <utilities/UtilitiesAPI.hpp>
+
+#include <boost/optional.hpp>
+
+#include <vector>
+
+namespace openstudio {
+
+/** Each function returns numSamples points in the unit hypercube [0,1)^numDimensions, 
+ *  result[i][j] being the jth coordinate of the ith sample. Designs that take a seed are 
+ *  reproducible: the same arguments always give the same design. */
+//@{
+
+/** Returns independent uniformly distributed samples. */
+UTILITIES_API std::vector< std::vector<double> > randomDesign(unsigned numSamples,
+                                                              unsigned numDimensions,
+                                                              unsigned seed);
+
+/** Returns a Latin hypercube design, in which each dimension is divided into numSamples equal 
+ *  strata and each stratum contains exactly one sample. Points are placed randomly within 
+ *  their strata. */
+UTILITIES_API std::vector< std::vector<double> > latinHypercubeDesign(unsigned numSamples,
+                                                                      unsigned numDimensions,
+                                                                      unsigned seed);
+
+/** Returns the first numSamples points of the Sobol low-discrepancy sequence, skipping the 
+ *  initial point at the origin. Direction numbers are those of Joe and Kuo. If seed is 
+ *  specified, each dimension is scrambled with a random digital shift, which preserves the 
+ *  uniformity properties of the sequence. numDimensions must not exceed maxSobolDimensions(). */
+UTILITIES_API std::vector< std::vector<double> > sobolDesign(unsigned numSamples,
+                                                             unsigned numDimensions,
+                                                             boost::optional<unsigned> seed = boost::none);
+
+/** Returns the maximum number of dimensions supported by sobolDesign. */
+UTILITIES_API unsigned maxSobolDimensions();
+
+/** Returns a positive seed for the designs above, drawn from the clock, the process id and a 
+ *  call counter, so that seeds differ between calls and between runs. */
+UTILITIES_API int randomSeed();
+
+//@}
+
+} // openstudio
+
+#endif // UTILITIES_MATH_SAMPLEDESIGNS_HPP
@@ -0,0 +1,169 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <utilities/math/NondominatedSort.hpp>
+
+#include <boost/foreach.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int.hpp>
+#include <boost/random/variate_generator.hpp>
+
+#include <algorithm>
+#include <limits>
+
+using openstudio::NondominatedSort;
+
+namespace {
+
+  std::vector<double> makePoint(double f0, double f1) {
+    std::vector<double> result;
+    result.push_back(f0);
+    result.push_back(f1);
+    return result;
+  }
+
+  // reference ranking, O(N^2) per front
+  std::vector<unsigned> bruteForceRanks(const NondominatedSort& sort) {
+    unsigned n = sort.numPoints();
+    std::vector<unsigned> result(n,0u);
+    std::vector<bool> assigned(n,false);
+    unsigned numAssigned(0), rank(0);
+    while (numAssigned < n) {
+      std::vector<unsigned> front;
+      for (unsigned i = 0; i < n; ++i) {
+        if (assigned[i]) { continue; }
+        bool dominated(false);
+        for (unsigned j = 0; j < n; ++j) {
+          if (!assigned[j] && NondominatedSort::dominates(sort.values(j),sort.values(i))) {
+            dominated = true;
+            break;
+          }
+        }
+        if (!dominated) {
+          front.push_back(i);
+        }
+      }
+      BOOST_FOREACH(unsigned i, front) {
+        result[i] = rank;
+        assigned[i] = true;
+        ++numAssigned;
+      }
+      ++rank;
+    }
+    return result;
+  }
+
+}
+
+TEST(NondominatedSort, TwoObjectives)
+{
+  NondominatedSort sort(2u);
+  EXPECT_EQ(2u,sort.numObjectives());
+  EXPECT_TRUE(sort.paretoFront().empty());
+  EXPECT_TRUE(sort.fronts().empty());
+
+  EXPECT_EQ(0u,sort.addPoint(makePoint(4.0,1.0)));
+  EXPECT_EQ(1u,sort.addPoint(makePoint(1.0,4.0)));
+  EXPECT_EQ(2u,sort.addPoint(makePoint(3.0,3.0)));
+  EXPECT_EQ(3u,sort.addPoint(makePoint(2.0,2.0))); // dominates 2
+  EXPECT_EQ(4u,sort.addPoint(makePoint(5.0,5.0)));
+  EXPECT_EQ(5u,sort.addPoint(makePoint(2.0,2.0))); // duplicate of 3
+
+  std::vector<unsigned> paretoFront = sort.paretoFront();
+  ASSERT_EQ(4u,paretoFront.size());
+  EXPECT_EQ(0u,paretoFront[0]);
+  EXPECT_EQ(1u,paretoFront[1]);
+  EXPECT_EQ(3u,paretoFront[2]);
+  EXPECT_EQ(5u,paretoFront[3]);
+
+  std::vector< std::vector<unsigned> > fronts = sort.fronts();
+  ASSERT_EQ(3u,fronts.size());
+  ASSERT_EQ(4u,fronts[0].size());
+  EXPECT_EQ(1u,fronts[0][0]);
+  EXPECT_EQ(3u,fronts[0][1]);
+  EXPECT_EQ(5u,fronts[0][2]);
+  EXPECT_EQ(0u,fronts[0][3]);
+  ASSERT_EQ(1u,fronts[1].size());
+  EXPECT_EQ(2u,fronts[1][0]);
+  ASSERT_EQ(1u,fronts[2].size());
+  EXPECT_EQ(4u,fronts[2][0]);
+  EXPECT_EQ(1u,sort.rank(2u));
+
+  // adding a point updates the Pareto front immediately and the other fronts on request
+  EXPECT_EQ(6u,sort.addPoint(makePoint(0.5,0.5)));
+  paretoFront = sort.paretoFront();
+  ASSERT_EQ(1u,paretoFront.size());
+  EXPECT_EQ(6u,paretoFront[0]);
+  EXPECT_EQ(4u,sort.fronts().size());
+  EXPECT_EQ(1u,sort.rank(0u));
+  EXPECT_EQ(3u,sort.rank(4u));
+
+  sort.clear();
+  EXPECT_EQ(0u,sort.numPoints());
+  EXPECT_TRUE(sort.fronts().empty());
+}
+
+TEST(NondominatedSort, CrowdingDistances)
+{
+  NondominatedSort sort(2u);
+  sort.addPoint(makePoint(0.0,4.0));
+  sort.addPoint(makePoint(1.0,2.0));
+  sort.addPoint(makePoint(3.0,1.0));
+  sort.addPoint(makePoint(4.0,0.0));
+
+  std::vector<unsigned> front = sort.fronts()[0];
+  ASSERT_EQ(4u,front.size());
+  std::vector<double> distances = sort.crowdingDistances(front);
+  ASSERT_EQ(4u,distances.size());
+  EXPECT_EQ(std::numeric_limits<double>::infinity(),distances[0]);
+  EXPECT_DOUBLE_EQ(3.0/4.0 + 3.0/4.0,distances[1]);
+  EXPECT_DOUBLE_EQ(3.0/4.0 + 2.0/4.0,distances[2]);
+  EXPECT_EQ(std::numeric_limits<double>::infinity(),distances[3]);
+}
+
+TEST(NondominatedSort, MatchesBruteForce)
+{
+  boost::mt19937 generator(1234u);
+  // small range of integer values produces many ties and duplicates
+  boost::uniform_int<> distribution(0,9);
+  boost::variate_generator<boost::mt19937&, boost::uniform_int<> > random(generator,distribution);
+
+  for (unsigned numObjectives = 1; numObjectives <= 4; ++numObjectives) {
+    NondominatedSort sort(numObjectives);
+    for (unsigned i = 0; i < 300; ++i) {
+      std::vector<double> values;
+      for (unsigned j = 0; j < numObjectives; ++j) {
+        values.push_back(random());
+      }
+      sort.addPoint(values);
+    }
+
+    std::vector<unsigned> expected = bruteForceRanks(sort);
+    for (unsigned i = 0, n = sort.numPoints(); i < n; ++i) {
+      EXPECT_EQ(expected[i],sort.rank(i)) << "point " << i << " with " << numObjectives << " objectives";
+    }
+
+    std::vector<unsigned> paretoFront = sort.paretoFront();
+    std::vector<unsigned> front0 = sort.fronts()[0];
+    std::sort(front0.begin(),front0.end());
+    EXPECT_TRUE(paretoFront == front0);
+  }
+}
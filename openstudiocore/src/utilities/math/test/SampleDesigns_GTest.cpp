@@ -0,0 +1,102 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <utilities/math/SampleDesigns.hpp>
+
+#include <cmath>
+#include <set>
+
+using openstudio::randomDesign;
+using openstudio::latinHypercubeDesign;
+using openstudio::sobolDesign;
+using openstudio::maxSobolDimensions;
+
+TEST(SampleDesigns, Random)
+{
+  std::vector< std::vector<double> > design = randomDesign(50u,3u,7u);
+  ASSERT_EQ(50u,design.size());
+  for (unsigned i = 0; i < design.size(); ++i) {
+    ASSERT_EQ(3u,design[i].size());
+    for (unsigned j = 0; j < 3u; ++j) {
+      EXPECT_GE(design[i][j],0.0);
+      EXPECT_LT(design[i][j],1.0);
+    }
+  }
+
+  // reproducible
+  EXPECT_TRUE(design == randomDesign(50u,3u,7u));
+  EXPECT_FALSE(design == randomDesign(50u,3u,8u));
+}
+
+TEST(SampleDesigns, LatinHypercube)
+{
+  unsigned n = 20u;
+  std::vector< std::vector<double> > design = latinHypercubeDesign(n,4u,1u);
+  ASSERT_EQ(n,design.size());
+
+  // exactly one sample per stratum in each dimension
+  for (unsigned j = 0; j < 4u; ++j) {
+    std::set<int> strata;
+    for (unsigned i = 0; i < n; ++i) {
+      EXPECT_GE(design[i][j],0.0);
+      EXPECT_LT(design[i][j],1.0);
+      strata.insert(static_cast<int>(std::floor(design[i][j] * n)));
+    }
+    EXPECT_EQ(n,strata.size());
+  }
+
+  EXPECT_TRUE(design == latinHypercubeDesign(n,4u,1u));
+  EXPECT_FALSE(design == latinHypercubeDesign(n,4u,2u));
+}
+
+TEST(SampleDesigns, Sobol)
+{
+  EXPECT_EQ(21u,maxSobolDimensions());
+
+  std::vector< std::vector<double> > design = sobolDesign(7u,3u);
+  ASSERT_EQ(7u,design.size());
+  double expected[7][3] = { {0.5,   0.5,   0.5  },
+                            {0.75,  0.25,  0.25 },
+                            {0.25,  0.75,  0.75 },
+                            {0.375, 0.375, 0.625},
+                            {0.875, 0.875, 0.125},
+                            {0.625, 0.125, 0.875},
+                            {0.125, 0.625, 0.375} };
+  for (unsigned i = 0; i < 7u; ++i) {
+    for (unsigned j = 0; j < 3u; ++j) {
+      EXPECT_DOUBLE_EQ(expected[i][j],design[i][j]) << "point " << i << ", dimension " << j;
+    }
+  }
+
+  // 2^m points (with the origin) are stratified in every dimension
+  unsigned n = 64u;
+  design = sobolDesign(n - 1u,maxSobolDimensions(),5u);
+  for (unsigned j = 0; j < maxSobolDimensions(); ++j) {
+    std::set<int> strata;
+    for (unsigned i = 0; i < n - 1u; ++i) {
+      EXPECT_GE(design[i][j],0.0);
+      EXPECT_LT(design[i][j],1.0);
+      strata.insert(static_cast<int>(std::floor(design[i][j] * n)));
+    }
+    EXPECT_EQ(n - 1u,strata.size());
+  }
+  EXPECT_TRUE(design == sobolDesign(n - 1u,maxSobolDimensions(),5u));
+}
@@ -173,7 +173,10 @@ TimeSeriesFloodPlotData::TimeSeriesFloodPlotData(TimeSeries timeSeries)
   m_maxX(ceil(timeSeries.daysFromFirstReport()[timeSeries.daysFromFirstReport().size()-1]+timeSeries.firstReportDateTime().date().dayOfYear()+timeSeries.firstReportDateTime().time().totalDays())), // end day
   m_minY(0), // start hour
   m_maxY(24), // end hour
-  m_startFractionalDay(timeSeries.firstReportDateTime().date().dayOfYear()+timeSeries.firstReportDateTime().time().totalDays())
+  m_startFractionalDay(timeSeries.firstReportDateTime().date().dayOfYear()+timeSeries.firstReportDateTime().time().totalDays()),
+  m_raster(FloodPlotRaster::create(timeSeries)),
+  m_rasterReady(false),
+  m_rasterLevel(0)
 {
   // data range
   setBoundingRect(QwtDoubleRect(m_minX, m_minY, m_maxX-m_minX, m_maxY-m_minY));
@@ -190,7 +193,10 @@ TimeSeriesFloodPlotData::TimeSeriesFloodPlotData(TimeSeries timeSeries,  QwtDoub
   m_minY(0), // start hour
   m_maxY(24), // end hour
   m_startFractionalDay(timeSeries.firstReportDateTime().date().dayOfYear()+timeSeries.firstReportDateTime().time().totalDays()),
-  m_colorMapRange(colorMapRange)
+  m_colorMapRange(colorMapRange),
+  m_raster(FloodPlotRaster::create(timeSeries)),
+  m_rasterReady(false),
+  m_rasterLevel(0)
 {
   // data range
   setBoundingRect(QwtDoubleRect(m_minX, m_minY, m_maxX-m_minX, m_maxY-m_minY));
@@ -198,9 +204,8 @@ TimeSeriesFloodPlotData::TimeSeriesFloodPlotData(TimeSeries timeSeries,  QwtDoub
 
 TimeSeriesFloodPlotData* TimeSeriesFloodPlotData::copy() const
 {
-  TimeSeriesFloodPlotData* result = new TimeSeriesFloodPlotData(m_timeSeries);
-  result->colorMapRange(m_colorMapRange);
-  return result;
+  // shares the raster rather than building another one
+  return new TimeSeriesFloodPlotData(*this);
 }
 
 QwtDoubleRect TimeSeriesFloodPlotData::boundingRect() const
@@ -208,8 +213,27 @@ QwtDoubleRect TimeSeriesFloodPlotData::boundingRect() const
   return QwtDoubleRect(m_minX, m_minY, m_maxX-m_minX, m_maxY-m_minY);
 }
 
+void TimeSeriesFloodPlotData::initRaster(const QwtDoubleRect& rect, const QSize& raster)
+{
+  // checked once per repaint rather than once per pixel
+  m_rasterReady = m_raster->isReady();
+  if (m_rasterReady){
+    m_rasterLevel = m_raster->levelFor(rect, raster);
+  }
+}
+
+void TimeSeriesFloodPlotData::discardRaster()
+{
+  m_rasterReady = false;
+  m_rasterLevel = 0;
+}
+
 double TimeSeriesFloodPlotData::value(double fractionalDay, double hourOfDay) const
 {
+  if (m_rasterReady){
+    return m_raster->value(fractionalDay, hourOfDay, m_rasterLevel);
+  }
+
   double fracDays = floor(fractionalDay) + hourOfDay/24.0;
   return m_timeSeries.value(fracDays-m_startFractionalDay);
 }
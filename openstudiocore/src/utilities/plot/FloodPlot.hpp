@@ -23,6 +23,7 @@
 #include <utilities/UtilitiesAPI.hpp>
 
 #include <utilities/plot/Plot2D.hpp>
+#include <utilities/plot/PlotDecimation.hpp>
 #include <utilities/data/TimeSeries.hpp>
 #include <utilities/data/Vector.hpp>
 #include <utilities/data/Matrix.hpp>
@@ -168,9 +169,18 @@ namespace openstudio{
       /// provide boundingRect overload for speed - default implementation slow!!!
       QwtDoubleRect boundingRect() const;
 
+      /// selects the raster level of detail for the coming value calls
+      virtual void initRaster(const QwtDoubleRect& rect, const QSize& raster);
+
+      /// reverts value to sampling the time series
+      virtual void discardRaster();
+
       ///  value at point fractionalDay and hourOfDay
       double value(double fractionalDay, double hourOfDay) const;
 
+      /// raster of the time series, shared between copies and built in the background
+      FloodPlotRaster::Ptr raster() const {return m_raster;}
+
       /// minX
       double minX() const {return m_minX;};
 
@@ -224,6 +234,9 @@ namespace openstudio{
       double m_startFractionalDay;
       QwtDoubleInterval m_colorMapRange;
       std::string m_units;
+      FloodPlotRaster::Ptr m_raster;
+      bool m_rasterReady;
+      unsigned m_rasterLevel;
   };
 
   /** MatrixFloodPlotData converts a Matrix into flood plot data
@@ -17,6 +17,9 @@
 %template(MatrixFloodPlotDataVector) std::vector< boost::shared_ptr<openstudio::MatrixFloodPlotData> >;
 %template(FloodPlotVector) std::vector< boost::shared_ptr<openstudio::FloodPlot> >;
 
+// decimation is internal to plotting
+%ignore openstudio::TimeSeriesFloodPlotData::raster;
+
 %include <utilities/plot/FloodPlot.hpp>
 
 // DLM@20090803: extremely lame hack because we are not able to automatically convert
@@ -21,6 +21,9 @@
 #include <cfloat>
 #include <utilities/core/Application.hpp>
 #include <qwt/qwt_painter.h>
+#include <qwt/qwt_scale_map.h>
+
+#include <QPainter>
 
 
 using namespace std;
@@ -43,6 +46,7 @@ TimeSeriesLinePlotData::TimeSeriesLinePlotData(TimeSeries timeSeries)
   m_fracDaysOffset = 0.0;
   m_x = m_timeSeries.daysFromFirstReport();
   m_y = m_timeSeries.values();
+  m_pyramid = LinePlotPyramid::create(m_x, m_y, m_fracDaysOffset + m_minX);
 }
 
 TimeSeriesLinePlotData::TimeSeriesLinePlotData(TimeSeries timeSeries, double fracDaysOffset)
@@ -60,12 +64,14 @@ TimeSeriesLinePlotData::TimeSeriesLinePlotData(TimeSeries timeSeries, double fra
   m_fracDaysOffset = fracDaysOffset; // note updating in xValue does not affect scaled axis
   m_x = m_timeSeries.daysFromFirstReport();
   m_y = m_timeSeries.values();
+  m_pyramid = LinePlotPyramid::create(m_x, m_y, m_fracDaysOffset + m_minX);
 }
 
 
 TimeSeriesLinePlotData* TimeSeriesLinePlotData::copy() const
 {
-  return (new TimeSeriesLinePlotData(m_timeSeries, m_fracDaysOffset));
+  // shares the pyramid rather than building another one
+  return (new TimeSeriesLinePlotData(*this));
 }
 
 
@@ -99,6 +105,52 @@ double TimeSeriesLinePlotData::stdDevValue() const
 }
 
 
+DecimatedPlotCurve::DecimatedPlotCurve(const QString& title)
+  : QwtPlotCurve(title), m_yScale(1.0), m_yOffset(0.0)
+{
+}
+
+void DecimatedPlotCurve::setPyramid(LinePlotPyramid::Ptr pyramid)
+{
+  m_pyramid = pyramid;
+}
+
+void DecimatedPlotCurve::setYScale(double minY, double maxY)
+{
+  if (maxY != minY){
+    m_yScale = 1.0 / (maxY - minY);
+    m_yOffset = -minY / (maxY - minY);
+  }
+}
+
+void DecimatedPlotCurve::resetYScale()
+{
+  m_yScale = 1.0;
+  m_yOffset = 0.0;
+}
+
+void DecimatedPlotCurve::draw(QPainter *p, const QwtScaleMap &xMap, const QwtScaleMap &yMap, const QRect &rect) const
+{
+  unsigned numPixels = static_cast<unsigned>(std::abs(xMap.p2() - xMap.p1())) + 1;
+  if (!p || !m_pyramid || (style() != QwtPlotCurve::Lines) || 
+      (m_pyramid->numPoints(xMap.s1(), xMap.s2()) <= 2*numPixels)){
+    QwtPlotCurve::draw(p, xMap, yMap, rect);
+    return;
+  }
+
+  std::vector<double> x;
+  std::vector<double> y;
+  m_pyramid->decimate(xMap.s1(), xMap.s2(), numPixels, x, y);
+
+  QwtPolygon polyline(x.size());
+  for (unsigned i = 0; i < x.size(); ++i){
+    polyline.setPoint(i, xMap.transform(x[i]), yMap.transform(m_yScale*y[i] + m_yOffset));
+  }
+
+  p->setPen(pen());
+  QwtPainter::drawPolyline(p, polyline);
+}
+
 VectorLinePlotData::VectorLinePlotData(const Vector& xVector,
                                          const Vector& yVector)
 : m_xVector(xVector),
@@ -371,7 +423,12 @@ void LinePlot::linePlotData(LinePlotData::Ptr data,  const std::string& name, QC
 
 
   /// todo - curve collection - shared pointers
-  QwtPlotCurve * curve = new QwtPlotCurve(toQString(name));
+  DecimatedPlotCurve * curve = new DecimatedPlotCurve(toQString(name));
+  TimeSeriesLinePlotData::Ptr timeSeriesData = boost::dynamic_pointer_cast<TimeSeriesLinePlotData>(data);
+  if (timeSeriesData)
+  {
+    curve->setPyramid(timeSeriesData->pyramid());
+  }
   if (color == Qt::color0) 
   { // generate new color from color map
     color = curveColor(m_lastColor);
@@ -511,6 +568,11 @@ void LinePlot::scaleCurves(QwtPlotCurve *curve)
             }
             // reset data
             plotCurve->setTitle(plotCurve->title().text() + "[" + QString::number(plotCurve->minYValue()) + ", "  + QString::number(plotCurve->maxYValue()) + "]");
+            DecimatedPlotCurve* decimatedCurve = dynamic_cast<DecimatedPlotCurve*>(plotCurve);
+            if (decimatedCurve)
+            {
+              decimatedCurve->setYScale(plotCurve->minYValue(), plotCurve->maxYValue());
+            }
             plotCurve->setData(xData,yData);
           }
         }
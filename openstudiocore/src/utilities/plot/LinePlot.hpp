@@ -23,6 +23,7 @@
 #include <utilities/UtilitiesAPI.hpp>
 
 #include <utilities/plot/Plot2D.hpp>
+#include <utilities/plot/PlotDecimation.hpp>
 #include <utilities/data/TimeSeries.hpp>
 #include <utilities/data/Vector.hpp>
 #include <utilities/data/Matrix.hpp>
@@ -178,6 +179,9 @@ public:
   /// units for plotting on axes or scaling
   std::string units() const {return m_units;};
 
+  /// min/max/mean pyramid of the plotted points, shared between copies and built in the background
+  LinePlotPyramid::Ptr pyramid() const {return m_pyramid;};
+
 private:
   TimeSeries m_timeSeries;
   double m_minValue;
@@ -193,6 +197,7 @@ private:
   // testing Vector class
   Vector m_x;
   Vector m_y;
+  LinePlotPyramid::Ptr m_pyramid;
 };
 
 /** VectorLinePlotData converts two Vectors into Line plot data
@@ -290,6 +295,43 @@ private:
 
 
 
+/** DecimatedPlotCurve draws a LinePlotPyramid reduced to the visible x range and the width of 
+ *  the canvas instead of every sample, when the curve style is Lines. Other styles, and curves 
+ *  without a pyramid, are drawn by QwtPlotCurve.
+ */
+class UTILITIES_API DecimatedPlotCurve : public QwtPlotCurve
+{
+public:
+
+  /// constructor
+  explicit DecimatedPlotCurve(const QString& title = QString());
+
+  /// virtual destructor
+  virtual ~DecimatedPlotCurve() {}
+
+  /// pyramid of the curve data
+  void setPyramid(LinePlotPyramid::Ptr pyramid);
+
+  /// pyramid of the curve data
+  LinePlotPyramid::Ptr pyramid() const {return m_pyramid;};
+
+  /// curve data y is pyramid y scaled to [0,1] over [minY, maxY], as done by scaleCurves
+  void setYScale(double minY, double maxY);
+
+  /// curve data y is pyramid y
+  void resetYScale();
+
+  using QwtPlotCurve::draw;
+
+  /// reimplemented to draw the decimated pyramid
+  virtual void draw(QPainter *p, const QwtScaleMap &xMap, const QwtScaleMap &yMap, const QRect &rect) const;
+
+private:
+  LinePlotPyramid::Ptr m_pyramid;
+  double m_yScale;
+  double m_yOffset;
+};
+
 /** line plots data in a nice image 
 */
 class UTILITIES_API LinePlot : public Plot2D
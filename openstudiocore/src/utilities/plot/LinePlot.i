@@ -17,6 +17,10 @@
 %template(VectorLinePlotDataVector) std::vector< boost::shared_ptr<openstudio::VectorLinePlotData> >;
 %template(LinePlotVector) std::vector< boost::shared_ptr<openstudio::LinePlot> >;
 
+// decimation is internal to plotting
+%ignore openstudio::DecimatedPlotCurve;
+%ignore openstudio::TimeSeriesLinePlotData::pyramid;
+
 %include <utilities/plot/LinePlot.hpp>
 
 // DLM@20090803: extremely lame hack because we are not able to automatically convert
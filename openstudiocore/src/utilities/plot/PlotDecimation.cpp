@@ -0,0 +1,453 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <utilities/plot/PlotDecimation.hpp>
+
+#include <utilities/core/Assert.hpp>
+#include <utilities/time/Date.hpp>
+#include <utilities/time/Time.hpp>
+#include <utilities/time/DateTime.hpp>
+
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace openstudio{
+
+/// LinePlotPyramid
+
+LinePlotPyramid::Ptr LinePlotPyramid::create(const Vector& x, const Vector& y, double xOffset)
+{
+  Ptr result(new LinePlotPyramid(x, y, xOffset));
+
+  // the thread holds a reference so the pyramid outlives it even if the plot is closed
+  boost::thread buildThread(boost::bind(&LinePlotPyramid::build, result));
+  buildThread.detach();
+
+  return result;
+}
+
+LinePlotPyramid::LinePlotPyramid(const Vector& x, const Vector& y, double xOffset)
+  : m_x(x.size()), m_y(y.begin(), y.end()), m_xOffset(xOffset), m_ready(false)
+{
+  BOOST_ASSERT(x.size() == y.size());
+  for (unsigned i = 0; i < x.size(); ++i){
+    m_x[i] = x(i) + xOffset;
+  }
+}
+
+unsigned LinePlotPyramid::size() const
+{
+  return m_x.size();
+}
+
+bool LinePlotPyramid::isReady() const
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  return m_ready;
+}
+
+void LinePlotPyramid::waitForReady() const
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  while (!m_ready){
+    m_readyCondition.wait(lock);
+  }
+}
+
+unsigned LinePlotPyramid::numLevels() const
+{
+  if (!isReady()){
+    return 0;
+  }
+  return m_levels.size();
+}
+
+unsigned LinePlotPyramid::numPoints(double xMin, double xMax) const
+{
+  unsigned begin, end;
+  indexRange(xMin, xMax, begin, end);
+  return end - begin;
+}
+
+void LinePlotPyramid::decimate(double xMin, double xMax, unsigned numPixels, std::vector<double>& x, std::vector<double>& y) const
+{
+  x.clear();
+  y.clear();
+
+  unsigned begin, end;
+  indexRange(xMin, xMax, begin, end);
+  unsigned n = end - begin;
+  if (n == 0){
+    return;
+  }
+
+  if ((numPixels == 0) || (n <= 2*numPixels)){
+    x.assign(m_x.begin() + begin, m_x.begin() + end);
+    y.assign(m_y.begin() + begin, m_y.begin() + end);
+    return;
+  }
+
+  const Level* level = levelFor(n, numPixels);
+  if (!level){
+    // not built yet, take every n-th sample so the plot stays responsive
+    unsigned step = (n + 2*numPixels - 1) / (2*numPixels);
+    for (unsigned i = begin; i < end; i += step){
+      x.push_back(m_x[i]);
+      y.push_back(m_y[i]);
+    }
+    if (x.back() != m_x[end - 1]){
+      x.push_back(m_x[end - 1]);
+      y.push_back(m_y[end - 1]);
+    }
+    return;
+  }
+
+  unsigned firstBucket = begin / level->bucketSize;
+  unsigned lastBucket = (end - 1) / level->bucketSize;
+  x.reserve(2*(lastBucket - firstBucket + 1));
+  y.reserve(2*(lastBucket - firstBucket + 1));
+  for (unsigned b = firstBucket; b <= lastBucket; ++b){
+    if (level->xAtMin[b] <= level->xAtMax[b]){
+      x.push_back(level->xAtMin[b]);
+      y.push_back(level->yMin[b]);
+      x.push_back(level->xAtMax[b]);
+      y.push_back(level->yMax[b]);
+    }else{
+      x.push_back(level->xAtMax[b]);
+      y.push_back(level->yMax[b]);
+      x.push_back(level->xAtMin[b]);
+      y.push_back(level->yMin[b]);
+    }
+  }
+}
+
+void LinePlotPyramid::decimateMean(double xMin, double xMax, unsigned numPixels, std::vector<double>& x, std::vector<double>& y) const
+{
+  x.clear();
+  y.clear();
+
+  unsigned begin, end;
+  indexRange(xMin, xMax, begin, end);
+  unsigned n = end - begin;
+  if (n == 0){
+    return;
+  }
+
+  const Level* level = NULL;
+  if ((numPixels > 0) && (n > numPixels)){
+    level = levelFor(n, numPixels);
+  }
+
+  if (!level){
+    unsigned step = 1;
+    if ((numPixels > 0) && (n > numPixels)){
+      step = (n + numPixels - 1) / numPixels;
+    }
+    for (unsigned i = begin; i < end; i += step){
+      x.push_back(m_x[i]);
+      y.push_back(m_y[i]);
+    }
+    return;
+  }
+
+  unsigned N = m_x.size();
+  unsigned firstBucket = begin / level->bucketSize;
+  unsigned lastBucket = (end - 1) / level->bucketSize;
+  x.reserve(lastBucket - firstBucket + 1);
+  y.reserve(lastBucket - firstBucket + 1);
+  for (unsigned b = firstBucket; b <= lastBucket; ++b){
+    unsigned first = b*level->bucketSize;
+    unsigned last = std::min(first + level->bucketSize, N) - 1;
+    x.push_back(0.5*(m_x[first] + m_x[last]));
+    y.push_back(level->yMean[b]);
+  }
+}
+
+void LinePlotPyramid::build()
+{
+  std::vector<Level> levels;
+
+  unsigned N = m_x.size();
+  unsigned bucketSize = 4;
+  while (N > bucketSize / 4){
+    Level level;
+    level.bucketSize = bucketSize;
+    unsigned numBuckets = (N + bucketSize - 1) / bucketSize;
+    level.xAtMin.resize(numBuckets);
+    level.yMin.resize(numBuckets);
+    level.xAtMax.resize(numBuckets);
+    level.yMax.resize(numBuckets);
+    level.yMean.resize(numBuckets);
+
+    if (levels.empty()){
+      // from the raw samples
+      for (unsigned b = 0; b < numBuckets; ++b){
+        unsigned first = b*bucketSize;
+        unsigned last = std::min(first + bucketSize, N);
+        unsigned iMin = first;
+        unsigned iMax = first;
+        double sum = 0;
+        for (unsigned i = first; i < last; ++i){
+          if (m_y[i] < m_y[iMin]){
+            iMin = i;
+          }
+          if (m_y[i] > m_y[iMax]){
+            iMax = i;
+          }
+          sum += m_y[i];
+        }
+        level.xAtMin[b] = m_x[iMin];
+        level.yMin[b] = m_y[iMin];
+        level.xAtMax[b] = m_x[iMax];
+        level.yMax[b] = m_y[iMax];
+        level.yMean[b] = sum / (last - first);
+      }
+    }else{
+      // from four buckets of the level below
+      const Level& below = levels.back();
+      unsigned numBelow = below.yMin.size();
+      for (unsigned b = 0; b < numBuckets; ++b){
+        unsigned first = 4*b;
+        unsigned last = std::min(first + 4, numBelow);
+        unsigned jMin = first;
+        unsigned jMax = first;
+        double sum = 0;
+        unsigned count = 0;
+        for (unsigned j = first; j < last; ++j){
+          if (below.yMin[j] < below.yMin[jMin]){
+            jMin = j;
+          }
+          if (below.yMax[j] > below.yMax[jMax]){
+            jMax = j;
+          }
+          unsigned n = std::min(below.bucketSize, N - j*below.bucketSize);
+          sum += below.yMean[j]*n;
+          count += n;
+        }
+        level.xAtMin[b] = below.xAtMin[jMin];
+        level.yMin[b] = below.yMin[jMin];
+        level.xAtMax[b] = below.xAtMax[jMax];
+        level.yMax[b] = below.yMax[jMax];
+        level.yMean[b] = sum / count;
+      }
+    }
+
+    levels.push_back(level);
+    if (numBuckets <= 1){
+      break;
+    }
+    bucketSize *= 4;
+  }
+
+  boost::mutex::scoped_lock lock(m_mutex);
+  m_levels.swap(levels);
+  m_ready = true;
+  m_readyCondition.notify_all();
+}
+
+void LinePlotPyramid::indexRange(double xMin, double xMax, unsigned& begin, unsigned& end) const
+{
+  if (xMax < xMin){
+    std::swap(xMin, xMax);
+  }
+
+  begin = std::lower_bound(m_x.begin(), m_x.end(), xMin) - m_x.begin();
+  end = std::upper_bound(m_x.begin(), m_x.end(), xMax) - m_x.begin();
+
+  // include the samples just outside the range so lines run to the edge of the plot
+  if (begin > 0){
+    --begin;
+  }
+  if (end < m_x.size()){
+    ++end;
+  }
+}
+
+const LinePlotPyramid::Level* LinePlotPyramid::levelFor(unsigned n, unsigned numPixels) const
+{
+  if (!isReady()){
+    return NULL;
+  }
+
+  BOOST_FOREACH(const Level& level, m_levels){
+    if (n <= numPixels*level.bucketSize){
+      return &level;
+    }
+  }
+
+  if (m_levels.empty()){
+    return NULL;
+  }
+  return &m_levels.back();
+}
+
+/// FloodPlotRaster
+
+FloodPlotRaster::Ptr FloodPlotRaster::create(const TimeSeries& timeSeries)
+{
+  Ptr result(new FloodPlotRaster(timeSeries));
+
+  // the thread holds a reference so the raster outlives it even if the plot is closed
+  boost::thread buildThread(boost::bind(&FloodPlotRaster::build, result));
+  buildThread.detach();
+
+  return result;
+}
+
+FloodPlotRaster::FloodPlotRaster(const TimeSeries& timeSeries)
+  : m_timeSeries(timeSeries), m_numColumns(24), m_ready(false)
+{
+  // same extent as TimeSeriesFloodPlotData
+  m_startDay = timeSeries.firstReportDateTime().date().dayOfYear();
+  m_startFractionalDay = m_startDay + timeSeries.firstReportDateTime().time().totalDays();
+  Vector daysFromFirstReport = timeSeries.daysFromFirstReport();
+  double endDay = ceil(daysFromFirstReport[daysFromFirstReport.size()-1] + m_startFractionalDay);
+  m_numDays = std::max(1, static_cast<int>(endDay) - m_startDay);
+
+  // one column per reporting interval, no finer than one minute
+  OptionalTime intervalLength = timeSeries.intervalLength();
+  if (intervalLength && (intervalLength->totalDays() > 0)){
+    double columns = floor(1.0 / intervalLength->totalDays() + 0.5);
+    m_numColumns = static_cast<unsigned>(std::max(1.0, std::min(1440.0, columns)));
+  }
+}
+
+bool FloodPlotRaster::isReady() const
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  return m_ready;
+}
+
+void FloodPlotRaster::waitForReady() const
+{
+  boost::mutex::scoped_lock lock(m_mutex);
+  while (!m_ready){
+    m_readyCondition.wait(lock);
+  }
+}
+
+int FloodPlotRaster::startDay() const
+{
+  return m_startDay;
+}
+
+unsigned FloodPlotRaster::numDays() const
+{
+  return m_numDays;
+}
+
+unsigned FloodPlotRaster::numColumns() const
+{
+  return m_numColumns;
+}
+
+unsigned FloodPlotRaster::numLevels() const
+{
+  if (!isReady()){
+    return 0;
+  }
+  return m_levels.size();
+}
+
+unsigned FloodPlotRaster::levelFor(const QwtDoubleRect& rect, const QSize& raster) const
+{
+  unsigned numLevels = this->numLevels();
+  if ((numLevels == 0) || (raster.width() <= 0) || (raster.height() <= 0)){
+    return 0;
+  }
+
+  double rowsPerPixel = rect.width() / raster.width();
+  double columnsPerPixel = (rect.height() / 24.0) * m_numColumns / raster.height();
+  double cellsPerPixel = std::min(std::abs(rowsPerPixel), std::abs(columnsPerPixel));
+
+  unsigned level = 0;
+  while ((cellsPerPixel >= 2.0) && (level + 1 < numLevels)){
+    cellsPerPixel /= 2.0;
+    ++level;
+  }
+  return level;
+}
+
+double FloodPlotRaster::value(double fractionalDay, double hourOfDay, unsigned level) const
+{
+  BOOST_ASSERT(level < m_levels.size());
+
+  int row = static_cast<int>(floor(fractionalDay)) - m_startDay;
+  if ((row < 0) || (row >= static_cast<int>(m_numDays))){
+    return m_timeSeries.outOfRangeValue();
+  }
+
+  int column = static_cast<int>(floor(hourOfDay / 24.0 * m_numColumns));
+  column = std::max(0, std::min(column, static_cast<int>(m_numColumns) - 1));
+
+  const Level& l = m_levels[level];
+  return l.values[(row >> level)*l.numColumns + (column >> level)];
+}
+
+void FloodPlotRaster::build()
+{
+  std::vector<Level> levels(1);
+
+  // level 0 samples the time series at the center of each cell
+  Level& base = levels[0];
+  base.numRows = m_numDays;
+  base.numColumns = m_numColumns;
+  base.values.resize(base.numRows*base.numColumns);
+  for (unsigned row = 0; row < base.numRows; ++row){
+    for (unsigned column = 0; column < base.numColumns; ++column){
+      double fracDays = m_startDay + row + (column + 0.5) / base.numColumns;
+      base.values[row*base.numColumns + column] = m_timeSeries.value(fracDays - m_startFractionalDay);
+    }
+  }
+
+  // each coarser level averages 2x2 blocks of the one below
+  while ((levels.back().numRows > 1) || (levels.back().numColumns > 1)){
+    // copied since push_back below may reallocate
+    const Level below = levels.back();
+    Level level;
+    level.numRows = (below.numRows + 1) / 2;
+    level.numColumns = (below.numColumns + 1) / 2;
+    level.values.resize(level.numRows*level.numColumns);
+    for (unsigned row = 0; row < level.numRows; ++row){
+      for (unsigned column = 0; column < level.numColumns; ++column){
+        double sum = 0;
+        unsigned count = 0;
+        for (unsigned i = 2*row; i < std::min(2*row + 2, below.numRows); ++i){
+          for (unsigned j = 2*column; j < std::min(2*column + 2, below.numColumns); ++j){
+            sum += below.values[i*below.numColumns + j];
+            ++count;
+          }
+        }
+        level.values[row*level.numColumns + column] = sum / count;
+      }
+    }
+    levels.push_back(level);
+  }
+
+  boost::mutex::scoped_lock lock(m_mutex);
+  m_levels.swap(levels);
+  m_ready = true;
+  m_readyCondition.notify_all();
+}
+
+} // openstudio
@@ -0,0 +1,175 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#ifndef UTILITIES_PLOT_PLOTDECIMATION_HPP
+#define UTILITIES_PLOT_PLOTDECIMATION_HPP
+
+#include <utilities/UtilitiesAPI.hpp>
+
+#include <utilities/core/Macro.hpp>
+#include <utilities/data/TimeSeries.hpp>
+#include <utilities/data/Vector.hpp>
+
+#include <qwt/qwt_double_rect.h>
+
+#include <QSize>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <vector>
+
+namespace openstudio{
+
+  /** LinePlotPyramid holds min, max and mean values of a line plot series over buckets of 
+   *  4, 16, 64, ... consecutive samples. The pyramid is built once in a background thread, 
+   *  after which a view of any x range can be reduced to O(pixels) points without visiting 
+   *  every sample.
+   */
+  class UTILITIES_API LinePlotPyramid
+  {
+    public:
+
+      COMMON_PTR_TYPEDEFS(LinePlotPyramid)
+
+      /// x must be non-decreasing, xOffset is added to every x value
+      static Ptr create(const Vector& x, const Vector& y, double xOffset = 0.0);
+
+      /// number of samples in the series
+      unsigned size() const;
+
+      /// true once the background build has finished
+      bool isReady() const;
+
+      /// blocks until the background build has finished
+      void waitForReady() const;
+
+      /// number of levels above the raw samples, zero until ready
+      unsigned numLevels() const;
+
+      /// number of raw samples with x in [xMin, xMax], plus one on either side
+      unsigned numPoints(double xMin, double xMax) const;
+
+      /** Reduces the samples with x in [xMin, xMax] to at most about 2*numPixels points. Each 
+       *  bucket contributes its min and max in the order they occur, so the drawn line keeps the
+       *  envelope of the raw series. If the pyramid is not ready yet every n-th sample is 
+       *  returned instead. */
+      void decimate(double xMin, double xMax, unsigned numPixels, std::vector<double>& x, std::vector<double>& y) const;
+
+      /// as decimate but each bucket contributes its mean at the bucket center
+      void decimateMean(double xMin, double xMax, unsigned numPixels, std::vector<double>& x, std::vector<double>& y) const;
+
+    private:
+
+      LinePlotPyramid(const Vector& x, const Vector& y, double xOffset);
+
+      void build();
+
+      struct Level
+      {
+        unsigned bucketSize;
+        std::vector<double> xAtMin;
+        std::vector<double> yMin;
+        std::vector<double> xAtMax;
+        std::vector<double> yMax;
+        std::vector<double> yMean;
+      };
+
+      // returns the raw index range [begin, end) to draw for [xMin, xMax]
+      void indexRange(double xMin, double xMax, unsigned& begin, unsigned& end) const;
+
+      // returns the finest level with at most numPixels buckets over n samples, if any
+      const Level* levelFor(unsigned n, unsigned numPixels) const;
+
+      std::vector<double> m_x;
+      std::vector<double> m_y;
+      double m_xOffset;
+      std::vector<Level> m_levels;
+
+      mutable boost::mutex m_mutex;
+      mutable boost::condition_variable m_readyCondition;
+      bool m_ready;
+  };
+
+  /** FloodPlotRaster resamples a time series onto a day by time of day matrix with one column 
+   *  per reporting interval, plus coarser levels that average 2x2 blocks of the level below. 
+   *  The raster is built once in a background thread, after which a flood plot pixel is a 
+   *  single lookup at the level that matches the plot resolution.
+   */
+  class UTILITIES_API FloodPlotRaster
+  {
+    public:
+
+      COMMON_PTR_TYPEDEFS(FloodPlotRaster)
+
+      static Ptr create(const TimeSeries& timeSeries);
+
+      /// true once the background build has finished
+      bool isReady() const;
+
+      /// blocks until the background build has finished
+      void waitForReady() const;
+
+      /// first day of year in the raster
+      int startDay() const;
+
+      /// number of days, the rows of level 0
+      unsigned numDays() const;
+
+      /// number of columns per day at level 0
+      unsigned numColumns() const;
+
+      /// number of levels including level 0, zero until ready
+      unsigned numLevels() const;
+
+      /// returns the coarsest level with no more than one raster cell per pixel when drawing rect into raster
+      unsigned levelFor(const QwtDoubleRect& rect, const QSize& raster) const;
+
+      /// value at fractionalDay (day of year) and hourOfDay at level, must be ready
+      double value(double fractionalDay, double hourOfDay, unsigned level = 0) const;
+
+    private:
+
+      explicit FloodPlotRaster(const TimeSeries& timeSeries);
+
+      void build();
+
+      struct Level
+      {
+        unsigned numRows;
+        unsigned numColumns;
+        std::vector<double> values;
+      };
+
+      TimeSeries m_timeSeries;
+      int m_startDay;
+      unsigned m_numDays;
+      unsigned m_numColumns;
+      double m_startFractionalDay;
+      std::vector<Level> m_levels;
+
+      mutable boost::mutex m_mutex;
+      mutable boost::condition_variable m_readyCondition;
+      bool m_ready;
+  };
+
+} // openstudio
+
+#endif // UTILITIES_PLOT_PLOTDECIMATION_HPP
@@ -0,0 +1,123 @@
+/**********************************************************************
+*  Copyright (c) 2008-2013, Alliance for Sustainable Energy.
+*  All rights reserved.
+*
+*  This library is free software; you can redistribute it and/or
+*  modify it under the terms of the GNU Lesser General Public
+*  License as published by the Free Software Foundation; either
+*  version 2.1 of the License, or (at your option) any later version.
+*
+*  This library is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+*  Lesser General Public License for more details.
+*
+*  You should have received a copy of the GNU Lesser General Public
+*  License along with this library; if not, write to the Free Software
+*  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+**********************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <utilities/plot/PlotDecimation.hpp>
+
+#include <utilities/data/TimeSeries.hpp>
+#include <utilities/data/Vector.hpp>
+#include <utilities/time/Date.hpp>
+#include <utilities/time/Time.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+using namespace boost;
+using namespace openstudio;
+
+TEST(PlotDecimation, LinePlotPyramid)
+{
+  unsigned N = 100000;
+  Vector x(N);
+  Vector y(N);
+  for (unsigned i = 0; i < N; ++i){
+    x(i) = i;
+    y(i) = sin(i/100.0);
+  }
+  y(54321) = 1000;
+  y(12345) = -1000;
+
+  LinePlotPyramid::Ptr pyramid = LinePlotPyramid::create(x, y, 10.0);
+  pyramid->waitForReady();
+  EXPECT_TRUE(pyramid->isReady());
+  EXPECT_EQ(N, pyramid->size());
+  EXPECT_LT(0u, pyramid->numLevels());
+
+  // whole series into 500 pixels keeps the spikes
+  std::vector<double> dx;
+  std::vector<double> dy;
+  pyramid->decimate(10.0, N + 9.0, 500, dx, dy);
+  EXPECT_GE(2u*(500 + 2), dx.size());
+  ASSERT_EQ(dx.size(), dy.size());
+  EXPECT_DOUBLE_EQ(1000, *std::max_element(dy.begin(), dy.end()));
+  EXPECT_DOUBLE_EQ(-1000, *std::min_element(dy.begin(), dy.end()));
+  EXPECT_TRUE(std::find(dx.begin(), dx.end(), 54331.0) != dx.end());
+  EXPECT_TRUE(std::find(dx.begin(), dx.end(), 12355.0) != dx.end());
+  for (unsigned i = 1; i < dx.size(); ++i){
+    EXPECT_LE(dx[i-1], dx[i]);
+  }
+
+  // a narrow range is returned as is, including one sample either side
+  pyramid->decimate(110.0, 210.0, 1000, dx, dy);
+  ASSERT_EQ(103u, dx.size());
+  EXPECT_DOUBLE_EQ(109.0, dx.front());
+  EXPECT_DOUBLE_EQ(211.0, dx.back());
+  EXPECT_DOUBLE_EQ(y(100), dy[1]);
+  EXPECT_EQ(103u, pyramid->numPoints(110.0, 210.0));
+
+  // means of the coarsest buckets match the raw mean
+  pyramid->decimateMean(10.0, N + 9.0, 1, dx, dy);
+  ASSERT_EQ(1u, dy.size());
+  double sum = 0;
+  for (unsigned i = 0; i < N; ++i){
+    sum += y(i);
+  }
+  EXPECT_NEAR(sum / N, dy[0], 1.0e-9);
+}
+
+TEST(PlotDecimation, FloodPlotRaster)
+{
+  Date startDate(MonthOfYear(MonthOfYear::Jan), 1);
+  Time interval(0,1,0,0);
+  Vector values(8760);
+  for (unsigned i = 0; i < 8760; ++i){
+    values(i) = i % 24;
+  }
+  TimeSeries timeSeries(startDate, interval, values, "W");
+
+  FloodPlotRaster::Ptr raster = FloodPlotRaster::create(timeSeries);
+  raster->waitForReady();
+  EXPECT_TRUE(raster->isReady());
+  EXPECT_EQ(1, raster->startDay());
+  EXPECT_LE(365u, raster->numDays());
+  EXPECT_EQ(24u, raster->numColumns());
+  EXPECT_LT(1u, raster->numLevels());
+
+  // level 0 matches sampling the time series
+  double startFractionalDay = 1.0 + 1.0/24.0;
+  for (unsigned day = 1; day < 365; day += 37){
+    for (unsigned hour = 0; hour < 24; ++hour){
+      double hourOfDay = hour + 0.5;
+      EXPECT_DOUBLE_EQ(hour, raster->value(day + 0.25, hourOfDay));
+      EXPECT_DOUBLE_EQ(timeSeries.value(day + hourOfDay/24.0 - startFractionalDay), raster->value(day, hourOfDay));
+    }
+  }
+
+  // level 1 averages pairs of hours
+  EXPECT_DOUBLE_EQ(4.5, raster->value(10, 4.5, 1));
+  EXPECT_DOUBLE_EQ(4.5, raster->value(11, 5.5, 1));
+
+  // one level per halving of the cells per pixel
+  QwtDoubleRect rect(1, 0, 365, 24);
+  EXPECT_EQ(0u, raster->levelFor(rect, QSize(800, 400)));
+  EXPECT_EQ(1u, raster->levelFor(rect, QSize(50, 10)));
+  EXPECT_EQ(2u, raster->levelFor(rect, QSize(50, 5)));
+}
@@ -34,6 +34,10 @@
 #include <utilities/units/ThermUnit.hpp>
 #include <utilities/units/WhUnit.hpp>
 
+#include <QReadWriteLock>
+
+#include <sstream>
+
 namespace openstudio {
 
 boost::optional<Quantity> QuantityConverterSingleton::convert(const Quantity &q,
@@ -47,29 +51,12 @@ boost::optional<Quantity> QuantityConverterSingleton::convert(const Quantity &q,
     return boost::none;
   }
 
-  Quantity working;
-  Quantity converted;
-  OptionalQuantity candidate;
-
-  // All conversions go through SI, so convert to SI if not already there,
-  if( (q.system() != UnitSystem::SI) ) {
-    // If not already SI or NA, go through SI
-    candidate = m_convertToSI(q);
-    if (!candidate) {
-      return boost::none;
-    }
-    working = *candidate;
-  }else {
-    // Otherwise we are already in SI
-    working = q;
+  ConversionPlanPtr plan = m_conversionPlan(q,sys);
+  if (!plan) {
+    return boost::none;
   }
 
-  if( (sys == UnitSystem::SI) ) {
-    converted = working;
-  }
-  else {
-    converted = m_convertFromSI(working, sys);
-  }
+  Quantity converted(plan->apply(q.value()),plan->units);
 
   if (q.isTemperature() && converted.isTemperature()) {
     if (q.isRelative()) {
@@ -84,7 +71,6 @@ boost::optional<Quantity> QuantityConverterSingleton::convert(const Quantity &or
                                                               const Unit& targetUnits) const
 {
   Quantity working(original);
-  OptionalQuantity candidate;
 
   // See if nothing to be done. (Check for equality of system and base units + exponents.)
   if ((working.system() == targetUnits.system()) && (working.units() == targetUnits))
@@ -94,28 +80,63 @@ boost::optional<Quantity> QuantityConverterSingleton::convert(const Quantity &or
     return working;
   }
 
-  // All conversions go through SI
-  if (working.system() != UnitSystem::SI) {
-    candidate = m_convertToSI(working);
-    if (!candidate) {
-      return boost::none;
-    }
-    working = *candidate;
+  ConversionPlanPtr plan = m_conversionPlan(original,targetUnits);
+  if (!plan) {
+    return boost::none;
   }
 
-  // Retain pretty string
-  OptionalQuantity result = m_convertToTargetFromSI(working,targetUnits);
-  if (result && 
-      result->prettyUnitsString(false).empty() && 
-      !targetUnits.prettyString(false).empty()) 
-  {
-    result->setPrettyUnitsString(targetUnits.prettyString(false));
+  return Quantity(plan->apply(original.value()),plan->units);
+}
+
+boost::optional<double> QuantityConverterSingleton::convert(double value,
+                                                           const std::string& originalUnits,
+                                                           const std::string& finalUnits) const
+{
+  ConversionPlanPtr plan = m_conversionPlan(originalUnits,finalUnits);
+  if (!plan) {
+    return boost::none;
   }
+  return plan->apply(value);
+}
 
-  return result;
+boost::optional<std::pair<double,double> > QuantityConverterSingleton::affineConversion(
+    const std::string& originalUnits,const std::string& finalUnits) const
+{
+  ConversionPlanPtr plan = m_conversionPlan(originalUnits,finalUnits);
+  if (!plan) {
+    return boost::none;
+  }
+  return std::make_pair(plan->factor,plan->offset);
+}
+
+QuantityConverterSingleton::ConversionPlan::ConversionPlan(const std::vector<ConversionStep>& t_steps,
+                                                           const Unit& t_units)
+  : steps(t_steps), units(t_units.clone()), factor(1.0), offset(0.0)
+{
+  offset = apply(0.0);
+  factor = apply(1.0) - offset;
+}
+
+double QuantityConverterSingleton::ConversionPlan::apply(double value) const {
+  std::vector<ConversionStep>::const_iterator it = steps.begin(), itEnd = steps.end();
+  for (; it != itEnd; ++it) {
+    switch (it->operation) {
+      case ConversionStep::Multiply :
+        value = value * it->operand;
+        break;
+      case ConversionStep::Divide :
+        value = value / it->operand;
+        break;
+      case ConversionStep::Add :
+        value = value + it->operand;
+        break;
+    }
+  }
+  return value;
 }
 
 QuantityConverterSingleton::QuantityConverterSingleton()
+  : m_conversionPlansMutex(new QReadWriteLock())
 {
   // initialize the quantity converter maps here
 
@@ -268,15 +289,203 @@ QuantityConverterSingleton::QuantityConverterSingleton()
   }
 }
 
+QuantityConverterSingleton::~QuantityConverterSingleton() {
+  delete m_conversionPlansMutex;
+}
 
-boost::optional<Quantity> QuantityConverterSingleton::m_convertToSI(const Quantity &original) const
+namespace {
+
+  // identifies units down to the order of their base units, which determines the order in 
+  // which conversion factors are applied
+  std::string conversionKey(const Unit& units) {
+    std::stringstream ss;
+    ss << units.system().valueName() << ":" << units.scale().exponent;
+    std::vector<std::string> baseUnits = units.baseUnits();
+    for (std::vector<std::string>::const_iterator it = baseUnits.begin(), itEnd = baseUnits.end();
+         it != itEnd; ++it)
+    {
+      ss << " " << *it << "^" << units.baseUnitExponent(*it);
+    }
+    return ss.str();
+  }
+
+}
+
+QuantityConverterSingleton::ConversionPlanPtr QuantityConverterSingleton::m_conversionPlan(
+    const Quantity& original,UnitSystem sys) const
+{
+  std::string key = conversionKey(original.units()) + " to system " + sys.valueName();
+  ConversionPlanPtr result = m_cachedConversionPlan(key);
+  if (result) {
+    return result;
+  }
+
+  std::vector<ConversionStep> steps;
+  Quantity working;
+  Quantity converted;
+  OptionalQuantity candidate;
+
+  // All conversions go through SI, so convert to SI if not already there,
+  if( (original.system() != UnitSystem::SI) ) {
+    // If not already SI or NA, go through SI
+    candidate = m_convertToSI(original,steps);
+    if (!candidate) {
+      return result;
+    }
+    working = *candidate;
+  }else {
+    // Otherwise we are already in SI
+    working = original;
+  }
+
+  if( (sys == UnitSystem::SI) ) {
+    converted = working;
+  }
+  else {
+    converted = m_convertFromSI(working,sys,steps);
+  }
+
+  result = ConversionPlanPtr(new ConversionPlan(steps,converted.units()));
+  m_cacheConversionPlan(key,result);
+  return result;
+}
+
+QuantityConverterSingleton::ConversionPlanPtr QuantityConverterSingleton::m_conversionPlan(
+    const Quantity& original,const Unit& targetUnits) const
+{
+  std::string key = conversionKey(original.units()) + " to units " + conversionKey(targetUnits) 
+                  + " (" + targetUnits.prettyString(false) + ")";
+  ConversionPlanPtr result = m_cachedConversionPlan(key);
+  if (result) {
+    return result;
+  }
+
+  std::vector<ConversionStep> steps;
+  Quantity working(original);
+  OptionalQuantity candidate;
+
+  // All conversions go through SI
+  if (working.system() != UnitSystem::SI) {
+    candidate = m_convertToSI(working,steps);
+    if (!candidate) {
+      return result;
+    }
+    working = *candidate;
+  }
+
+  candidate = m_convertToTargetFromSI(working,targetUnits,steps);
+  if (!candidate) {
+    return result;
+  }
+
+  // Retain pretty string
+  if (candidate->prettyUnitsString(false).empty() && 
+      !targetUnits.prettyString(false).empty()) 
+  {
+    candidate->setPrettyUnitsString(targetUnits.prettyString(false));
+  }
+
+  result = ConversionPlanPtr(new ConversionPlan(steps,candidate->units()));
+  m_cacheConversionPlan(key,result);
+  return result;
+}
+
+QuantityConverterSingleton::ConversionPlanPtr QuantityConverterSingleton::m_conversionPlan(
+    const std::string& originalUnits,const std::string& finalUnits) const
+{
+  std::string key = "'" + originalUnits + "' to '" + finalUnits + "'";
+  ConversionPlanPtr result = m_cachedConversionPlan(key);
+  if (result) {
+    return result;
+  }
+
+  //create the units from the strings
+  OptionalUnit originalUnit = UnitFactory::instance().createUnit(originalUnits);
+  OptionalUnit finalUnit = UnitFactory::instance().createUnit(finalUnits);
+
+  //make sure both unit strings were valid
+  if (!originalUnit || !finalUnit) {
+    return result;
+  }
+
+  Quantity original(0.0,*originalUnit);
+  if ((original.system() == finalUnit->system()) && (original.units() == *finalUnit)) {
+    // mirrors the early return in convert(const Quantity&,const Unit&)
+    std::vector<ConversionStep> steps;
+    m_setScale(original,finalUnit->scale().exponent,steps);
+    result = ConversionPlanPtr(new ConversionPlan(steps,original.units()));
+  }
+  else {
+    result = m_conversionPlan(original,*finalUnit);
+    if (!result) {
+      return result;
+    }
+  }
+
+  m_cacheConversionPlan(key,result);
+  return result;
+}
+
+QuantityConverterSingleton::ConversionPlanPtr QuantityConverterSingleton::m_cachedConversionPlan(
+    const std::string& key) const
+{
+  QReadLocker l(m_conversionPlansMutex);
+  ConversionPlanMap::const_iterator it = m_conversionPlans.find(key);
+  if (it != m_conversionPlans.end()) {
+    return it->second;
+  }
+  return ConversionPlanPtr();
+}
+
+void QuantityConverterSingleton::m_cacheConversionPlan(const std::string& key,
+                                                       const ConversionPlanPtr& plan) const
+{
+  QWriteLocker l(m_conversionPlansMutex);
+  m_conversionPlans[key] = plan;
+}
+
+void QuantityConverterSingleton::m_applyStep(Quantity& q,
+                                             ConversionStep::Operation operation,
+                                             double operand,
+                                             std::vector<ConversionStep>& steps)
+{
+  ConversionStep step = { operation, operand };
+  steps.push_back(step);
+  switch (operation) {
+    case ConversionStep::Multiply :
+      q.setValue(q.value() * operand);
+      break;
+    case ConversionStep::Divide :
+      q.setValue(q.value() / operand);
+      break;
+    case ConversionStep::Add :
+      q.setValue(q.value() + operand);
+      break;
+  }
+}
+
+void QuantityConverterSingleton::m_setScale(Quantity& q,
+                                            int scaleExponent,
+                                            std::vector<ConversionStep>& steps)
+{
+  // same ratio Quantity::setScale applies to the value
+  double ratio = q.scale().value / ScaleFactory::instance().createScale(scaleExponent)().value;
+  if (q.setScale(scaleExponent)) {
+    ConversionStep step = { ConversionStep::Multiply, ratio };
+    steps.push_back(step);
+  }
+}
+
+
+boost::optional<Quantity> QuantityConverterSingleton::m_convertToSI(
+    const Quantity &original,std::vector<ConversionStep>& steps) const
 {
   // create a working copy of the original
   Quantity working(original);
   // Make sure to work unscaled: 10^0
   int scaleExponent = working.scale().exponent;
   if (working.scale().exponent != 0) {
-    working.setScale(0);
+    m_setScale(working,0,steps);
   }
   // build a result quantity with SI units and value equal to original
   Quantity result(working.value(), UnitSystem(UnitSystem::SI));
@@ -299,14 +508,15 @@ boost::optional<Quantity> QuantityConverterSingleton::m_convertToSI(const Quanti
     if (factor.offset != 0.0) {
       for( int i = 0; i < std::abs(baseExponent); ++i) {
         if( baseExponent > 0 ){
-          result.setValue( (result.value() * factor.factor) + factor.offset);
+          m_applyStep(result,ConversionStep::Multiply,factor.factor,steps);
         }else {
-          result.setValue( (result.value() / factor.factor) + factor.offset);
+          m_applyStep(result,ConversionStep::Divide,factor.factor,steps);
         }
+        m_applyStep(result,ConversionStep::Add,factor.offset,steps);
       }
     }
-    else {
-      result.setValue( result.value() * std::pow(factor.factor,baseExponent) );
+    else if (baseExponent != 0) {
+      m_applyStep(result,ConversionStep::Multiply,std::pow(factor.factor,baseExponent),steps);
     }
     // Parse the conversion string in case the original converts to more than one SI base unit
     Unit targetBase = parseUnitString(factor.targetUnit);
@@ -326,7 +536,7 @@ boost::optional<Quantity> QuantityConverterSingleton::m_convertToSI(const Quanti
 
   // Set result scale to match original scale
   if( scaleExponent != 0 ) {
-    result.setScale(scaleExponent);
+    m_setScale(result,scaleExponent,steps);
   }
 
   // Check if there is a pretty string for the result
@@ -340,14 +550,15 @@ boost::optional<Quantity> QuantityConverterSingleton::m_convertToSI(const Quanti
 }
 
 Quantity QuantityConverterSingleton::m_convertFromSI(const Quantity &original,
-                                                     const UnitSystem targetSys) const
+                                                     const UnitSystem targetSys,
+                                                     std::vector<ConversionStep>& steps) const
 {
   Quantity working(original);
 
   // Make sure to work unscaled: 10^0
   int scaleExponent = working.scale().exponent;
   if (working.scale().exponent != 0) {
-    working.setScale(0);
+    m_setScale(working,0,steps);
   }
   Quantity converted(working.value(),targetSys);
 
@@ -361,15 +572,16 @@ Quantity QuantityConverterSingleton::m_convertFromSI(const Quantity &original,
     if (fromFactor.offset != 0.0) {
       for( int i=0; i < std::abs(workingExp); ++i ) {
         if( workingExp > 0 ) {
-          converted.setValue( (converted.value() * fromFactor.factor) + fromFactor.offset );
+          m_applyStep(converted,ConversionStep::Multiply,fromFactor.factor,steps);
         }
         else {
-          converted.setValue( (converted.value() / fromFactor.factor) + fromFactor.offset );
+          m_applyStep(converted,ConversionStep::Divide,fromFactor.factor,steps);
         }
+        m_applyStep(converted,ConversionStep::Add,fromFactor.offset,steps);
       }
     }
-    else {
-      converted.setValue(converted.value() * std::pow(fromFactor.factor,workingExp) );
+    else if (workingExp != 0) {
+      m_applyStep(converted,ConversionStep::Multiply,std::pow(fromFactor.factor,workingExp),steps);
     }
     // Parse the conversion string incase the SI unit converts to more than one target base unit
     Unit targetBase = parseUnitString(fromFactor.targetUnit);
@@ -388,7 +600,7 @@ Quantity QuantityConverterSingleton::m_convertFromSI(const Quantity &original,
 
   // Set result scale to match original scale
   if( scaleExponent != 0 ) {
-    converted.setScale(scaleExponent);
+    m_setScale(converted,scaleExponent,steps);
   }
 
   // Check if there is a pretty string for the result
@@ -402,13 +614,13 @@ Quantity QuantityConverterSingleton::m_convertFromSI(const Quantity &original,
 }
 
 boost::optional<Quantity> QuantityConverterSingleton::m_convertToTargetFromSI(
-    const Quantity& original,const Unit& targetUnits) const
+    const Quantity& original,const Unit& targetUnits,std::vector<ConversionStep>& steps) const
 {
   Quantity working(original);
 
   // Make sure to work unscaled: 10^0
   if (working.scale().exponent != 0) {
-    working.setScale(0);
+    m_setScale(working,0,steps);
   }
   Quantity converted(working.value(),targetUnits.system());
 
@@ -435,15 +647,16 @@ boost::optional<Quantity> QuantityConverterSingleton::m_convertToTargetFromSI(
       baseUnitConversionFactor factor = m_toSImap.find(*it)->second;
       if (factor.offset != 0.0) {
         for( int i = 0; i < std::abs(baseExponent); ++i) {
+          m_applyStep(converted,ConversionStep::Add,-factor.offset,steps);
           if( baseExponent > 0 ){
-            converted.setValue( (converted.value() - factor.offset) / factor.factor);
+            m_applyStep(converted,ConversionStep::Divide,factor.factor,steps);
           }else {
-            converted.setValue( (converted.value() - factor.offset) * factor.factor);
+            m_applyStep(converted,ConversionStep::Multiply,factor.factor,steps);
           }
         }
       }
-      else {
-        converted.setValue( converted.value() * std::pow(factor.factor,-baseExponent) );
+      else if (baseExponent != 0) {
+        m_applyStep(converted,ConversionStep::Multiply,std::pow(factor.factor,-baseExponent),steps);
       }
       // Set units in converted
       converted.setBaseUnitExponent(*it,
@@ -474,7 +687,7 @@ boost::optional<Quantity> QuantityConverterSingleton::m_convertToTargetFromSI(
 
   // Set result scale to match targetUnits scale
   if (targetUnits.scale().exponent != 0) {
-    converted.setScale(targetUnits.scale().exponent);
+    m_setScale(converted,targetUnits.scale().exponent,steps);
   }
 
   // Check if there is a pretty string for the result
@@ -493,30 +706,24 @@ boost::optional<double> convert(double original, const std::string& originalUnit
     return original;
   }
 
-  //create the units from the strings
-  boost::optional<Unit> originalUnit = UnitFactory::instance().createUnit(originalUnits);
-  boost::optional<Unit> finalUnit = UnitFactory::instance().createUnit(finalUnits);
+  return QuantityConverter::instance().convert(original,originalUnits,finalUnits);
+}
 
-  //make sure both unit strings were valid
-  if (originalUnit && finalUnit) {
+boost::optional<Quantity> convert(const Quantity &q, UnitSystem sys) {
+  return QuantityConverter::instance().convert(q,sys);
+}
 
-    //make the original quantity
-    Quantity originalQuant = Quantity(original, *originalUnit);
+namespace {
 
-    //convert to final units
-    boost::optional<Quantity> finalQuant = QuantityConverter::instance().convert(originalQuant, *finalUnit);
-  
-    //if the conversion 
-    if (finalQuant) {
-      return finalQuant->value();
+  // result = factor * values + offset, in one pass
+  std::vector<double> affineTransform(const std::vector<double>& values, double factor, double offset) {
+    std::vector<double> result(values.size());
+    for (unsigned i = 0, n = values.size(); i < n; ++i) {
+      result[i] = factor * values[i] + offset;
     }
+    return result;
   }
 
-  return boost::none;
-}
-
-boost::optional<Quantity> convert(const Quantity &q, UnitSystem sys) {
-  return QuantityConverter::instance().convert(q,sys);
 }
 
 OSQuantityVector convert(const OSQuantityVector& original, UnitSystem sys) {
@@ -530,8 +737,10 @@ OSQuantityVector convert(const OSQuantityVector& original, UnitSystem sys) {
   OptionalQuantity factorPlusOffset = convert(testQuantity,sys);
   BOOST_ASSERT(factorPlusOffset);
   BOOST_ASSERT(offset->units() == factorPlusOffset->units());
-  result = OSQuantityVector(offset->units(),original.values());
-  result = result * (factorPlusOffset->value() - offset->value()) + offset.get();
+  result = OSQuantityVector(offset->units(),
+                            affineTransform(original.values(),
+                                            factorPlusOffset->value() - offset->value(),
+                                            offset->value()));
   return result;
 }
 
@@ -550,8 +759,10 @@ OSQuantityVector convert(const OSQuantityVector& original, const Unit& targetUni
   OptionalQuantity factorPlusOffset = convert(testQuantity,targetUnits);
   BOOST_ASSERT(factorPlusOffset);
   BOOST_ASSERT(offset->units() == factorPlusOffset->units());
-  result = OSQuantityVector(offset->units(),original.values());
-  result = result * (factorPlusOffset->value() - offset->value()) + offset.get();
+  result = OSQuantityVector(offset->units(),
+                            affineTransform(original.values(),
+                                            factorPlusOffset->value() - offset->value(),
+                                            offset->value()));
   return result;
 }
 
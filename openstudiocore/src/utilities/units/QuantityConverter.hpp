@@ -24,10 +24,15 @@
 #include <utilities/core/Logger.hpp>
 
 #include <utilities/units/Unit.hpp>
+
+#include <boost/shared_ptr.hpp>
+
 #include <string>
 #include <map>
+#include <vector>
 
 class QDomElement;
+class QReadWriteLock;
 
 namespace openstudio {
 
@@ -74,7 +79,12 @@ struct baseUnitConversionFactor {
 };
 
 /** Singleton for converting quantities to different \link UnitSystem unit systems \endlink or
- *  to targeted \link Unit units \endlink */
+ *  to targeted \link Unit units \endlink. 
+ *
+ *  The first conversion between a given pair of units is worked out base unit by base unit, 
+ *  and the sequence of value operations it applies is saved as a conversion plan. Later 
+ *  conversions between the same units replay the plan, skipping unit parsing and the conversion 
+ *  map lookups. Plans are shared across threads. */
 class UTILITIES_API QuantityConverterSingleton {
 
   friend class Singleton<QuantityConverterSingleton>;
@@ -85,9 +95,21 @@ class UTILITIES_API QuantityConverterSingleton {
 
   boost::optional<Quantity> convert(const Quantity &original, const Unit& targetUnits) const;
 
+  /** Converts value from originalUnits to finalUnits. The unit strings are only parsed the 
+   *  first time a pair is seen. */
+  boost::optional<double> convert(double value, 
+                                  const std::string& originalUnits, 
+                                  const std::string& finalUnits) const;
+
+  /** Returns (factor, offset) such that factor * value + offset converts value from 
+   *  originalUnits to finalUnits. For converting many values at once. */
+  boost::optional<std::pair<double,double> > affineConversion(const std::string& originalUnits,
+                                                              const std::string& finalUnits) const;
+
  private:
   REGISTER_LOGGER("openstudio.units.QuantityConverter");
   QuantityConverterSingleton();
+  ~QuantityConverterSingleton();
 
   typedef std::map<std::string, baseUnitConversionFactor> BaseUnitConversionMap;
   typedef std::multimap<UnitSystem, baseUnitConversionFactor> UnitSystemConversionMultiMap;
@@ -95,12 +117,62 @@ class UTILITIES_API QuantityConverterSingleton {
   BaseUnitConversionMap m_toSImap;
   UnitSystemConversionMultiMap m_fromSIBySystemMap;
 
-  boost::optional<Quantity> m_convertToSI(const Quantity& original) const;
+  /** One operation applied to the value during a conversion. */
+  struct ConversionStep {
+    enum Operation { Multiply, Divide, Add };
+    Operation operation;
+    double operand;
+  };
+
+  /** The value operations of a conversion, in order, and the units they produce. factor and 
+   *  offset collapse the steps into a single affine map. */
+  struct ConversionPlan {
+    ConversionPlan(const std::vector<ConversionStep>& t_steps, const Unit& t_units);
+
+    double apply(double value) const;
+
+    std::vector<ConversionStep> steps;
+    Unit units;
+    double factor;
+    double offset;
+  };
+
+  typedef boost::shared_ptr<const ConversionPlan> ConversionPlanPtr;
+  typedef std::map<std::string, ConversionPlanPtr> ConversionPlanMap;
+
+  mutable ConversionPlanMap m_conversionPlans;
+  mutable QReadWriteLock* m_conversionPlansMutex;
 
-  Quantity m_convertFromSI(const Quantity& original, const UnitSystem targetSys) const;
+  ConversionPlanPtr m_conversionPlan(const Quantity& original, UnitSystem sys) const;
+
+  ConversionPlanPtr m_conversionPlan(const Quantity& original, const Unit& targetUnits) const;
+
+  ConversionPlanPtr m_conversionPlan(const std::string& originalUnits, 
+                                     const std::string& finalUnits) const;
+
+  ConversionPlanPtr m_cachedConversionPlan(const std::string& key) const;
+
+  void m_cacheConversionPlan(const std::string& key, const ConversionPlanPtr& plan) const;
+
+  boost::optional<Quantity> m_convertToSI(const Quantity& original, 
+                                          std::vector<ConversionStep>& steps) const;
+
+  Quantity m_convertFromSI(const Quantity& original, 
+                           const UnitSystem targetSys,
+                           std::vector<ConversionStep>& steps) const;
 
   boost::optional<Quantity> m_convertToTargetFromSI(const Quantity& original,
-                                                    const Unit& targetUnits) const;
+                                                    const Unit& targetUnits,
+                                                    std::vector<ConversionStep>& steps) const;
+
+  // applies the operation to q's value and records it in steps
+  static void m_applyStep(Quantity& q, 
+                          ConversionStep::Operation operation, 
+                          double operand, 
+                          std::vector<ConversionStep>& steps);
+
+  // Quantity::setScale, recording the value rescaling in steps
+  static void m_setScale(Quantity& q, int scaleExponent, std::vector<ConversionStep>& steps);
 
 };
 
@@ -114,14 +186,16 @@ UTILITIES_API boost::optional<double> convert(double original, const std::string
 UTILITIES_API boost::optional<Quantity> convert(const Quantity& original, UnitSystem sys);
 
 /** Non-member function that uses just two calls to QuantityConverter to convert an entire 
- *  OSQuantityVector. \relates QuantityConverterSingleton \relates OSQuantityVector */
+ *  OSQuantityVector. The values are then mapped in a single factor * value + offset pass. 
+ *  \relates QuantityConverterSingleton \relates OSQuantityVector */
 UTILITIES_API OSQuantityVector convert(const OSQuantityVector& original, UnitSystem sys);
 
 /** Non-member function to simplify interface for users. \relates QuantityConverterSingleton */
 UTILITIES_API boost::optional<Quantity> convert(const Quantity& original, const Unit& targetUnits);
 
 /** Non-member function that uses just two calls to QuantityConverter to convert an entire 
- *  OSQuantityVector. \relates QuantityConverterSingleton \relates OSQuantityVector */
+ *  OSQuantityVector. The values are then mapped in a single factor * value + offset pass. 
+ *  \relates QuantityConverterSingleton \relates OSQuantityVector */
 UTILITIES_API OSQuantityVector convert(const OSQuantityVector& original, const Unit& targetUnits);
 
 }// namespace openstudio
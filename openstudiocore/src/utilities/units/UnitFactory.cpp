@@ -51,6 +51,8 @@
 #include <boost/pointer_cast.hpp>
 #include <boost/foreach.hpp>
 
+#include <QReadWriteLock>
+
 #include <map>
 #include <vector>
 
@@ -152,20 +154,40 @@ boost::optional<Unit> UnitFactorySingleton::createUnit(const std::string& unitSt
   }
 
   std::string resultCacheKey = unitString + " in unit system " + system.valueName();
-  ResultCacheMap::const_iterator findIt = m_resultCacheMap.find(resultCacheKey);
-  if (findIt != m_resultCacheMap.end()){
-    return findIt->second;
+  {
+    QReadLocker l(m_resultCacheMutex);
+    ResultCacheMap::const_iterator findIt = m_resultCacheMap.find(resultCacheKey);
+    if (findIt != m_resultCacheMap.end()){
+      // Unit copies share their implementation, so hand out a clone
+      if (findIt->second) {
+        return findIt->second->clone();
+      }
+      return boost::none;
+    }
+  }
+
+  OptionalUnit result = createUnitUncached(unitString,system);
+
+  QWriteLocker l(m_resultCacheMutex);
+  if (result) {
+    m_resultCacheMap[resultCacheKey] = result->clone();
+  }
+  else {
+    m_resultCacheMap[resultCacheKey] = boost::none;
   }
+  return result;
+}
 
+boost::optional<Unit> UnitFactorySingleton::createUnitUncached(const std::string& unitString,
+                                                               UnitSystem system) const
+{
   if (!unitString.empty() && !isUnit(unitString)) {
     LOG(Error,unitString << " is not properly formatted.");
-    m_resultCacheMap[resultCacheKey] = boost::none;
     return boost::none;
   }
 
   OptionalUnit result = createUnitSimple(unitString,system);
   if (result) {
-    m_resultCacheMap[resultCacheKey] = result;
     return *result;
   }
 
@@ -179,7 +201,6 @@ boost::optional<Unit> UnitFactorySingleton::createUnit(const std::string& unitSt
     if (scale().value == 0.0) {
       LOG(Error,"Scaled unit string " << wUnitString << " uses invalid scale abbreviation "
           << scaleAndUnit.first << ".");
-      m_resultCacheMap[resultCacheKey] = boost::none;
       return boost::none;
     }
     wUnitString = scaleAndUnit.second;
@@ -266,7 +287,6 @@ boost::optional<Unit> UnitFactorySingleton::createUnit(const std::string& unitSt
     result->setScale(resultScale.first().exponent);
   }
 
-  m_resultCacheMap[resultCacheKey] = result;
   return result;
 }
 
@@ -362,7 +382,9 @@ std::string UnitFactorySingleton::lookupPrettyString(const std::string& standard
 
 }
 
-UnitFactorySingleton::UnitFactorySingleton() {
+UnitFactorySingleton::UnitFactorySingleton()
+  : m_resultCacheMutex(new QReadWriteLock())
+{
 
   // Celcius Base Units ========================================================
   registerUnit(createCelciusTemperature);
@@ -583,6 +605,10 @@ UnitFactorySingleton::UnitFactorySingleton() {
   registerEquivalentString("hrs","h");
 }
 
+UnitFactorySingleton::~UnitFactorySingleton() {
+  delete m_resultCacheMutex;
+}
+
 UnitSystem getSystem(const std::string& unitString) {
 
   OptionalUnit unit;
@@ -33,6 +33,8 @@
 #include <set>
 #include <map>
 
+class QReadWriteLock;
+
 namespace openstudio{
 
 /** Singleton that creates units based on std::string representation. 
@@ -76,7 +78,11 @@ class UTILITIES_API UnitFactorySingleton {
   /** Parses unitStr to create a unit based on the internal factory maps. The maps are populated
    *  using the functions registerUnit and registerEquivalentString. Specify system to alert the 
    *  factory of your preferred unit system. The returned pointer is not guaranteed to be from 
-   *  that system, but if there is a conflict, it will be preferred. */
+   *  that system, but if there is a conflict, it will be preferred. 
+   *
+   *  Parse results are cached by (unitString, system), so repeated requests for the same unit 
+   *  string only pay for a map lookup. Each call returns its own copy of the cached unit, and 
+   *  the cache may be used from multiple threads. */
   boost::optional<Unit> createUnit(const std::string& unitString,
                                    UnitSystem system=UnitSystem::Mixed) const;
 
@@ -87,10 +93,12 @@ class UTILITIES_API UnitFactorySingleton {
  private:
   REGISTER_LOGGER("openstudio.units.UnitFactory");
   UnitFactorySingleton();
+  ~UnitFactorySingleton();
 
   typedef std::map<std::string,boost::optional<Unit> > ResultCacheMap;
 
   mutable ResultCacheMap m_resultCacheMap;
+  mutable QReadWriteLock* m_resultCacheMutex;
 
   typedef std::map<std::string,CreateUnitCallback> StandardStringCallbackMap;
   typedef std::map<UnitSystem,StandardStringCallbackMap> CallbackMapMap;
@@ -103,6 +111,10 @@ class UTILITIES_API UnitFactorySingleton {
   StandardStringLookupMap m_standardStringLookupMap; // look up alias, get back standardString
   PrettyStringLookupMap m_prettyStringLookupMap;   // look up standardString, get back prettyString
 
+  // parses unitString without consulting m_resultCacheMap
+  boost::optional<Unit> createUnitUncached(const std::string& unitString,
+                                           UnitSystem system) const;
+
   // helper create function--does simple lookups
   boost::optional<Unit> createUnitSimple(const std::string& unitString,
                                          UnitSystem system=UnitSystem::Mixed) const;
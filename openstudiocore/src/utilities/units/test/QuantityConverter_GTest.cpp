@@ -258,3 +258,48 @@ TEST_F(UnitsFixture,QuantityConverter_Profiling_QuantityVectorBaseCase) {
 TEST_F(UnitsFixture,QuantityConverter_Profiling_OSQuantityVector) {
   OSQuantityVector result = convert(testOSQuantityVector,UnitSystem(UnitSystem::Wh));
 }
+
+TEST_F(UnitsFixture,QuantityConverter_ConversionPlanReuse) {
+  // repeated conversions replay the cached plan and give identical results
+  Quantity ipq(37.5,createIPEnergy());
+  OptionalQuantity first = convert(ipq,UnitSystem(UnitSystem::SI));
+  OptionalQuantity second = convert(ipq,UnitSystem(UnitSystem::SI));
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  EXPECT_DOUBLE_EQ(first->value(),second->value());
+  EXPECT_EQ(first->units(),second->units());
+  EXPECT_EQ(first->prettyUnitsString(),second->prettyUnitsString());
+
+  // results do not alias the cached units
+  second->setScale(3);
+  OptionalQuantity third = convert(ipq,UnitSystem(UnitSystem::SI));
+  ASSERT_TRUE(third);
+  EXPECT_EQ(first->scale().exponent,third->scale().exponent);
+  EXPECT_DOUBLE_EQ(first->value(),third->value());
+
+  // string interface agrees with the Quantity interface
+  Unit kBtuPerHour = createUnit("kBtu/h").get();
+  Quantity watts(1500.0,createUnit("W").get());
+  OptionalQuantity q = convert(watts,kBtuPerHour);
+  boost::optional<double> d = convert(1500.0,"W","kBtu/h");
+  ASSERT_TRUE(q);
+  ASSERT_TRUE(d);
+  EXPECT_NEAR(q->value(),*d,tol);
+  boost::optional<double> d2 = convert(1500.0,"W","kBtu/h");
+  ASSERT_TRUE(d2);
+  EXPECT_DOUBLE_EQ(*d,*d2);
+
+  d = convert(20.0,"C","F");
+  ASSERT_TRUE(d);
+  EXPECT_NEAR(68.0,*d,tol);
+
+  // failures are not cached as successes
+  EXPECT_FALSE(convert(1.0,"m","kg"));
+  EXPECT_FALSE(convert(1.0,"m","kg"));
+
+  // affine form of a cached plan
+  boost::optional<std::pair<double,double> > affine = QuantityConverter::instance().affineConversion("C","F");
+  ASSERT_TRUE(affine);
+  EXPECT_NEAR(1.8,affine->first,tol);
+  EXPECT_NEAR(32.0,affine->second,tol);
+}